@@ -0,0 +1,1309 @@
+/* ************************************************************************** */
+/* *             For conditions of distribution and use,                    * */
+/* *                see copyright notice in libmng.h                        * */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * project   : mngcheck                                                   * */
+/* * file      : mngbench.c                                                 * */
+/* * version   : 1.0.11                                                     * */
+/* *                                                                        * */
+/* * purpose   : throughput figures for the 1.0.11 speed-ups                * */
+/* *                                                                        * */
+/* * comment   : each benchmark is a function below; "mngbench name ..."    * */
+/* *             runs the named ones, no names runs them all; the input is  * */
+/* *             generated (deterministically) by the library itself        * */
+/* *                                                                        * */
+/* *             the figures are wall-clock; run on an idle machine and     * */
+/* *             compare runs on the same machine only                      * */
+/* *                                                                        * */
+/* * changes   : 1.0.11 - 10/17/2026                                        * */
+/* *             - initial version                                          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <zlib.h>
+
+#include "../../../libmng.h"
+#include "../../../libmng_data.h"
+#include "../../../libmng_filter.h"
+#include "../../../libmng_chunk_io.h"
+
+/* ************************************************************************** */
+
+#define MAXW        1024               /* largest generated image */
+#define MAXH        1024
+#define MINTIME     0.5                /* seconds per measurement */
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * timing & pseudo-random numbers                                         * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+static double now (void)
+{
+  struct timespec sTime;
+
+  clock_gettime (CLOCK_MONOTONIC, &sTime);
+
+  return (double)sTime.tv_sec + (double)sTime.tv_nsec * 1e-9;
+}
+
+static mng_uint32 iSeed = 1;
+
+static mng_uint32 rnd (mng_uint32 iRange)
+{
+  iSeed = iSeed * 1103515245UL + 12345UL;
+  return ((iSeed >> 8) & 0xFFFFFF) % iRange;
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * callbacks                                                              * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+typedef struct {
+          mng_uint8p  pOut;            /* stream being written */
+          mng_uint32  iOutlen;
+          mng_uint32  iOutsize;
+          mng_uint8p  pCanvas;         /* app canvas */
+          mng_uint32  iRowsize;
+          mng_uint32  iTicks;          /* the fake clock */
+          int         iFrames;
+        } userdata;
+
+static mng_ptr MNG_DECL cb_alloc (mng_size_t iLen)
+{
+  return calloc (1, iLen);
+}
+
+static void MNG_DECL cb_free (mng_ptr pPtr, mng_size_t iLen)
+{
+  free (pPtr);
+}
+
+/* the same behind one lock, like an application allocator that is shared
+   between threads or keeps track of its blocks */
+static pthread_mutex_t hAllocmutex = PTHREAD_MUTEX_INITIALIZER;
+static mng_uint32      iAllocs     = 0;
+
+static mng_ptr MNG_DECL cb_alloc_locked (mng_size_t iLen)
+{
+  mng_ptr pPtr;
+
+  pthread_mutex_lock (&hAllocmutex);
+  pPtr = calloc (1, iLen);
+  iAllocs++;
+  pthread_mutex_unlock (&hAllocmutex);
+
+  return pPtr;
+}
+
+static void MNG_DECL cb_free_locked (mng_ptr pPtr, mng_size_t iLen)
+{
+  pthread_mutex_lock (&hAllocmutex);
+  free (pPtr);
+  pthread_mutex_unlock (&hAllocmutex);
+}
+
+static mng_bool MNG_DECL cb_openstream (mng_handle hMNG)
+{
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_closestream (mng_handle hMNG)
+{
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_writedata (mng_handle  hMNG,
+                                       mng_ptr     pBuf,
+                                       mng_uint32  iSize,
+                                       mng_uint32p iWritten)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  if (pUser->iOutlen + iSize > pUser->iOutsize)
+  {
+    pUser->iOutsize = (pUser->iOutlen + iSize) * 2;
+    pUser->pOut     = (mng_uint8p)realloc (pUser->pOut, pUser->iOutsize);
+  }
+
+  memcpy (pUser->pOut + pUser->iOutlen, pBuf, iSize);
+  pUser->iOutlen += iSize;
+  *iWritten       = iSize;
+
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_processheader (mng_handle hMNG,
+                                           mng_uint32 iWidth,
+                                           mng_uint32 iHeight)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  pUser->iRowsize = iWidth * 4;
+  pUser->pCanvas  = (mng_uint8p)calloc (iHeight, pUser->iRowsize);
+
+  return MNG_TRUE;
+}
+
+static mng_ptr MNG_DECL cb_getcanvasline (mng_handle hMNG,
+                                          mng_uint32 iLinenr)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  return (mng_ptr)(pUser->pCanvas + iLinenr * pUser->iRowsize);
+}
+
+static mng_bool MNG_DECL cb_refresh (mng_handle hMNG,
+                                     mng_uint32 iX,
+                                     mng_uint32 iY,
+                                     mng_uint32 iWidth,
+                                     mng_uint32 iHeight)
+{
+  return MNG_TRUE;
+}
+
+static mng_uint32 MNG_DECL cb_gettickcount (mng_handle hMNG)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  return pUser->iTicks;
+}
+
+static mng_bool MNG_DECL cb_settimer (mng_handle hMNG,
+                                      mng_uint32 iMsecs)
+{                                      /* the wait is over right away */
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  pUser->iTicks += iMsecs;
+
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_renderframe (mng_handle hMNG,
+                                         mng_ptr    pCanvas,
+                                         mng_uint32 iRowsize,
+                                         mng_uint32 iDelay,
+                                         mng_uint32 iX,
+                                         mng_uint32 iY,
+                                         mng_uint32 iWidth,
+                                         mng_uint32 iHeight)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  pUser->iFrames++;
+
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_errorproc (mng_handle  hMNG,
+                                       mng_int32   iErrorcode,
+                                       mng_int8    iSeverity,
+                                       mng_chunkid iChunkname,
+                                       mng_uint32  iChunkseq,
+                                       mng_int32   iExtra1,
+                                       mng_int32   iExtra2,
+                                       mng_pchar   zErrortext)
+{
+  fprintf (stderr, "mngbench: error %d (%s)\n", (int)iErrorcode,
+           zErrortext ? zErrortext : "");
+
+  return MNG_FALSE;
+}
+
+/* a handle for writing into sUser */
+static mng_handle create_begin (userdata *pUser)
+{
+  mng_handle hMNG = mng_initialize ((mng_ptr)pUser, cb_alloc, cb_free, MNG_NULL);
+
+  memset (pUser, 0, sizeof (userdata));
+
+  mng_setcb_openstream  (hMNG, cb_openstream );
+  mng_setcb_closestream (hMNG, cb_closestream);
+  mng_setcb_writedata   (hMNG, cb_writedata  );
+  mng_setcb_errorproc   (hMNG, cb_errorproc  );
+
+  return hMNG;
+}
+
+/* a handle for reading & displaying with the canvas in sUser */
+static mng_handle read_begin (userdata *pUser)
+{
+  mng_handle hMNG = mng_initialize ((mng_ptr)pUser, cb_alloc, cb_free, MNG_NULL);
+
+  memset (pUser, 0, sizeof (userdata));
+
+  mng_setcb_errorproc     (hMNG, cb_errorproc    );
+  mng_setcb_processheader (hMNG, cb_processheader);
+  mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+  mng_setcb_refresh       (hMNG, cb_refresh      );
+  mng_setcb_gettickcount  (hMNG, cb_gettickcount );
+  mng_setcb_settimer      (hMNG, cb_settimer     );
+  mng_set_canvasstyle     (hMNG, MNG_CANVAS_RGBA8);
+
+  return hMNG;
+}
+
+static void read_end (mng_handle hMNG,
+                      userdata  *pUser)
+{
+  mng_cleanup (&hMNG);
+  free (pUser->pCanvas);
+  pUser->pCanvas = MNG_NULL;
+}
+
+static mng_uint32 count_chunks (mng_uint8p pData,
+                                mng_uint32 iLen)
+{
+  mng_uint32 iPos   = 8;
+  mng_uint32 iCount = 0;
+
+  while (iPos + 12 <= iLen)
+  {
+    iPos += (((mng_uint32)pData [iPos    ] << 24) |
+             ((mng_uint32)pData [iPos + 1] << 16) |
+             ((mng_uint32)pData [iPos + 2] <<  8) |
+              (mng_uint32)pData [iPos + 3]) + 12;
+    iCount++;
+  }
+
+  return iCount;
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * source images                                                          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+static mng_uint8  aSource [MAXW * MAXH * 8];
+static mng_uint32 iSourcerow;
+
+static mng_ptr MNG_DECL cb_getsourceline (mng_handle hMNG,
+                                          mng_uint32 iLinenr)
+{
+  return (mng_ptr)(aSource + iLinenr * iSourcerow);
+}
+
+/* something photograph-like in RGBA8 or RGBA16: smooth gradients with a
+   little noise, a few hard edges and an alpha-channel that is mostly opaque;
+   the low bytes of RGBA16 are noise, like a 16-bit scan */
+static void fill_photo (mng_uint32 iWidth,
+                        mng_uint32 iHeight,
+                        int        b16)
+{
+  mng_uint32 iX, iY, iC, iV;
+  mng_uint8p pOut = aSource;
+
+  iSourcerow = iWidth * (b16 ? 8 : 4);
+
+  for (iY = 0; iY < iHeight; iY++)
+    for (iX = 0; iX < iWidth; iX++)
+    {
+      mng_uint32 iEdge = ((iX / 97 + iY / 61) & 1) * 40;
+
+      for (iC = 0; iC < 4; iC++)
+      {
+        if (iC < 3)
+          iV = (iX * (iC + 1) / 5 + iY * (3 - iC) / 4 + iEdge + rnd (6)) & 0xFF;
+        else
+          iV = (iX < iWidth / 8 ? (iX * 255) / (iWidth / 8) : 255);
+
+        *pOut++ = (mng_uint8)iV;
+        if (b16)
+          *pOut++ = (mng_uint8)(iV == 255 ? 255 : rnd (256));
+      }
+    }
+}
+
+/* one PNG through mng_putimgdata_ihdr; returns the stream (malloc'ed) */
+static mng_uint8p encode_png (mng_uint32  iWidth,
+                              mng_uint32  iHeight,
+                              mng_uint8   iColortype,
+                              mng_uint8   iBitdepth,
+                              mng_uint8   iFiltersel,
+                              mng_int32   iLevel,
+                              mng_uint32 *iLen)
+{
+  userdata   sUser;
+  mng_handle hMNG = create_begin (&sUser);
+
+#ifdef MNG_ACCESS_ZLIB
+  mng_set_zlib_level      (hMNG, iLevel        );
+  mng_set_filterselection (hMNG, iFiltersel    );
+#endif
+  mng_create              (hMNG);
+
+  mng_putchunk_ihdr   (hMNG, iWidth, iHeight, iBitdepth, iColortype, 0, 0, 0);
+  mng_putimgdata_ihdr (hMNG, iWidth, iHeight, iColortype, iBitdepth, 0, 0, 0,
+                       (iBitdepth == 16 ? MNG_CANVAS_RGBA16 : MNG_CANVAS_RGBA8),
+                       cb_getsourceline);
+  mng_putchunk_iend   (hMNG);
+  mng_write           (hMNG);
+  mng_cleanup         (&hMNG);
+
+  *iLen = sUser.iOutlen;
+
+  return sUser.pOut;
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * encode: mng_putimgdata_ihdr per filter-selection & zlib level          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+static void bench_encode (void)
+{
+  static const char *aSelname [3] = {"none", "fast", "full"};
+  static const mng_int32 aLevels [3] = {1, 6, 9};
+  static const mng_uint8 aTypes  [2] = {2, 6};
+  mng_uint32 iW = 512, iH = 512;
+  int        iType, iSel, iLevel, iRuns;
+  double     fStart, fTime;
+
+  printf ("encode: %ux%u photo-like image through mng_putimgdata_ihdr\n", iW, iH);
+#ifndef MNG_ACCESS_ZLIB
+  printf ("  (no MNG_ACCESS_ZLIB; every line uses the default settings)\n");
+#endif
+  printf ("  %-5s %-5s %5s %10s %10s\n", "ct", "sel", "level", "MB/s", "bytes");
+
+  iSeed = 20261017;
+  fill_photo (iW, iH, 0);
+
+  for (iType = 0; iType < 2; iType++)
+    for (iSel = 0; iSel < 3; iSel++)
+      for (iLevel = 0; iLevel < 3; iLevel++)
+      {
+        mng_uint32 iLen = 0;
+        mng_uint32 iRaw = iW * iH * (aTypes [iType] == 6 ? 4 : 3);
+
+        fStart = now ();
+        iRuns  = 0;
+
+        do
+        {
+          free (encode_png (iW, iH, aTypes [iType], 8, (mng_uint8)iSel,
+                            aLevels [iLevel], &iLen));
+          iRuns++;
+          fTime = now () - fStart;
+        }
+        while (fTime < MINTIME);
+
+        printf ("  %-5s %-5s %5d %10.1f %10u\n",
+                (aTypes [iType] == 6 ? "rgba8" : "rgb8"), aSelname [iSel],
+                (int)aLevels [iLevel], (double)iRaw * iRuns / fTime / 1e6, iLen);
+      }
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * unfilter: real IDAT rows through mng_unfilter_row, portable & SIMD     * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_PARALLEL
+/* the filtered rows of a PNG stream: the inflated IDAT's */
+static mng_uint8p inflate_idats (mng_uint8p pPNG,
+                                 mng_uint32 iLen,
+                                 mng_uint32 iRawlen)
+{
+  mng_uint8p pZip = (mng_uint8p)malloc (iLen);
+  mng_uint8p pRaw = (mng_uint8p)malloc (iRawlen);
+  mng_uint32 iZiplen = 0;
+  mng_uint32 iPos    = 8;
+  uLongf     iOutlen = iRawlen;
+
+  while (iPos + 12 <= iLen)
+  {
+    mng_uint32 iChunklen = ((mng_uint32)pPNG [iPos    ] << 24) |
+                           ((mng_uint32)pPNG [iPos + 1] << 16) |
+                           ((mng_uint32)pPNG [iPos + 2] <<  8) |
+                            (mng_uint32)pPNG [iPos + 3];
+
+    if (!memcmp (pPNG + iPos + 4, "IDAT", 4))
+    {
+      memcpy (pZip + iZiplen, pPNG + iPos + 8, iChunklen);
+      iZiplen += iChunklen;
+    }
+
+    iPos += iChunklen + 12;
+  }
+
+  if ((uncompress (pRaw, &iOutlen, pZip, iZiplen) != Z_OK) || (iOutlen != iRawlen))
+    fprintf (stderr, "mngbench: bad IDAT data\n");
+
+  free (pZip);
+
+  return pRaw;
+}
+
+/* filter every row of an unfiltered image with one filter-type */
+static void filter_rows (mng_uint8p pDst,
+                         mng_uint8p pSrc,
+                         mng_uint32 iRows,
+                         mng_int32  iRowsize,
+                         mng_int32  iBpp,
+                         mng_uint8  iFilter)
+{
+  mng_uint32 iRow;
+  mng_int32  iX, iA, iB, iC, iP, iPa, iPb, iPc;
+
+  for (iRow = 0; iRow < iRows; iRow++)
+  {
+    mng_uint8p pRaw   = pSrc + iRow * (iRowsize + 1) + 1;
+    mng_uint8p pPrior = (iRow ? pRaw - iRowsize - 1 : MNG_NULL);
+    mng_uint8p pOut   = pDst + iRow * (iRowsize + 1);
+
+    *pOut++ = iFilter;
+
+    for (iX = 0; iX < iRowsize; iX++)
+    {
+      iA = (iX >= iBpp ? pRaw [iX - iBpp] : 0);
+      iB = (pPrior ? pPrior [iX] : 0);
+      iC = ((pPrior) && (iX >= iBpp) ? pPrior [iX - iBpp] : 0);
+
+      switch (iFilter)
+      {
+        case 1  : { iP = iA;             break; }
+        case 2  : { iP = iB;             break; }
+        case 3  : { iP = (iA + iB) >> 1; break; }
+        default : { iPa = abs (iB - iC);
+                    iPb = abs (iA - iC);
+                    iPc = abs (iA + iB - iC - iC);
+                    iP  = ((iPa <= iPb) && (iPa <= iPc) ? iA : (iPb <= iPc ? iB : iC));
+                    break; }
+      }
+
+      pOut [iX] = (mng_uint8)(pRaw [iX] - iP);
+    }
+  }
+}
+
+/* unfilter all rows in place; returns MB/s of pixel-data */
+static double time_unfilter (mng_uint8p pFiltered,
+                             mng_uint8p pWork,
+                             mng_uint32 iRows,
+                             mng_int32  iRowsize,
+                             mng_int32  iBpp,
+                             mng_uint32 iSIMDflags)
+{
+  static mng_uint8 aZero [MAXW * 8];
+  mng_uint32 iSize = iRows * (iRowsize + 1);
+  mng_uint32 iRow;
+  int        iRuns = 0;
+  double     fStart, fTime, fCopy;
+
+  fStart = now ();                     /* the copy isn't part of it */
+  do
+  {
+    memcpy (pWork, pFiltered, iSize);
+    iRuns++;
+    fTime = now () - fStart;
+  }
+  while (fTime < MINTIME / 4);
+  fCopy = fTime / iRuns;
+
+  fStart = now ();
+  iRuns  = 0;
+
+  do
+  {
+    memcpy (pWork, pFiltered, iSize);
+
+    for (iRow = 0; iRow < iRows; iRow++)
+    {
+      mng_uint8p pRow = pWork + iRow * (iRowsize + 1);
+
+      mng_unfilter_row (*pRow, pRow + 1, (iRow ? pRow - iRowsize : aZero),
+                        iRowsize, iBpp, iSIMDflags);
+    }
+
+    iRuns++;
+    fTime = now () - fStart;
+  }
+  while (fTime < MINTIME);
+
+  return (double)iRows * iRowsize / (fTime / iRuns - fCopy) / 1e6;
+}
+#endif /* MNG_SUPPORT_PARALLEL */
+
+static void bench_unfilter (void)
+{
+#ifdef MNG_SUPPORT_PARALLEL
+  static const char *aFiltername [5] = {"mixed", "sub", "up", "average", "paeth"};
+  static const mng_uint8 aTypes [4] = {2, 6, 2, 6};
+  static const mng_uint8 aDepth [4] = {8, 8, 16, 16};
+  mng_uint32 iW = 512, iH = 256;
+  mng_uint32 iSIMD;
+  mng_handle hMNG;
+  int        iFmt, iFilter;
+
+  hMNG  = mng_initialize (MNG_NULL, cb_alloc, cb_free, MNG_NULL);
+  iSIMD = mng_get_simd (hMNG);         /* what this cpu has */
+  mng_cleanup (&hMNG);
+
+  printf ("unfilter: rows of %ux%u photo-like PNG's through mng_unfilter_row\n",
+          iW, iH);
+  printf ("  %-3s %-8s %12s %12s %8s\n", "bpp", "filter", "portable MB/s",
+          "simd MB/s", "ratio");
+
+  iSeed = 20261017;
+
+  for (iFmt = 0; iFmt < 4; iFmt++)
+  {
+    mng_int32  iBpp     = (aTypes [iFmt] == 6 ? 4 : 3) * (aDepth [iFmt] >> 3);
+    mng_int32  iRowsize = iW * iBpp;
+    mng_uint32 iRawlen  = iH * (iRowsize + 1);
+    mng_uint32 iLen;
+    mng_uint8p pPNG, pMixed, pPlain, pRows, pWork, pCheck;
+
+    fill_photo (iW, iH, aDepth [iFmt] == 16);
+    pPNG   = encode_png (iW, iH, aTypes [iFmt], aDepth [iFmt],
+                         MNG_FILTERSEL_FULL, 6, &iLen);
+    pMixed = inflate_idats (pPNG, iLen, iRawlen);
+    pPlain = (mng_uint8p)malloc (iRawlen);
+    pRows  = (mng_uint8p)malloc (iRawlen);
+    pWork  = (mng_uint8p)malloc (iRawlen);
+    pCheck = (mng_uint8p)malloc (iRawlen);
+                                       /* the image itself, for the others */
+    time_unfilter (pMixed, pPlain, iH, iRowsize, iBpp, MNG_SIMD_NONE);
+
+    for (iFilter = 0; iFilter < 5; iFilter++)
+    {
+      double fPortable, fSIMD = 0;
+
+      if (iFilter)
+        filter_rows (pRows, pPlain, iH, iRowsize, iBpp, (mng_uint8)iFilter);
+      else
+        memcpy (pRows, pMixed, iRawlen);
+
+      fPortable = time_unfilter (pRows, pCheck, iH, iRowsize, iBpp, MNG_SIMD_NONE);
+
+      if (iSIMD)
+      {
+        fSIMD = time_unfilter (pRows, pWork, iH, iRowsize, iBpp, iSIMD);
+
+        if (memcmp (pWork, pCheck, iRawlen))
+          printf ("  FAIL: the SIMD result differs\n");
+      }
+
+      printf ("  %-3d %-8s %12.0f %12.0f %8.2f\n", (int)iBpp, aFiltername [iFilter],
+              fPortable, fSIMD, fSIMD / fPortable);
+    }
+
+    free (pPNG);
+    free (pMixed);
+    free (pPlain);
+    free (pRows);
+    free (pWork);
+    free (pCheck);
+  }
+#else
+  printf ("unfilter: needs MNG_SUPPORT_PARALLEL (mng_unfilter_row)\n");
+#endif
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * chunks: reading & writing a stream of many small chunks                * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+/* sprite-style animation: tiny IDAT's, then thousands of FRAM's & MOVE's */
+static void put_chunky (mng_handle hMNG,
+                        int        iFrames)
+{
+  int iFrame;
+
+  mng_putchunk_mhdr (hMNG, 64, 64, 1000, 0, 0, 0, 0);
+  mng_putchunk_defi (hMNG, 1, 0, 1, MNG_TRUE, 0, 0, MNG_FALSE, 0, 0, 0, 0);
+  fill_photo (48, 48, 0);
+#ifdef MNG_ACCESS_ZLIB
+  mng_set_zlib_maxidat (hMNG, 64);
+#endif
+  mng_putchunk_ihdr   (hMNG, 48, 48, 8, 6, 0, 0, 0);
+  mng_putimgdata_ihdr (hMNG, 48, 48, 6, 8, 0, 0, 0, MNG_CANVAS_RGBA8,
+                       cb_getsourceline);
+  mng_putchunk_iend   (hMNG);
+
+  for (iFrame = 0; iFrame < iFrames; iFrame++)
+  {
+    mng_putchunk_fram (hMNG, (mng_bool)(iFrame & 1), 1, 0, MNG_NULL,
+                       (mng_uint8)(iFrame & 1 ? 0 : 2), 0, 0, 0, 1, 0,
+                       0, 0, 0, 0, 0, 0, MNG_NULL);
+    mng_putchunk_move (hMNG, 1, 1, 1, (iFrame % 5) - 2, (iFrame % 3) - 1);
+  }
+
+  mng_putchunk_mend (hMNG);
+}
+
+static void bench_chunks (void)
+{
+  userdata    sUser;
+  mng_handle  hMNG;
+  mng_uint8p  pStream;
+  mng_uint32  iLen, iChunks;
+  mng_retcode iRetcode = MNG_NOERROR;
+  int         iRuns;
+  double      fStart, fTime;
+
+  iSeed = 20261017;
+                                       /* writing */
+  fStart = now ();
+  iRuns  = 0;
+
+  do
+  {
+    hMNG = create_begin (&sUser);
+    mng_create (hMNG);
+    put_chunky (hMNG, 5000);
+    mng_write   (hMNG);
+    mng_cleanup (&hMNG);
+
+    if (iRuns)                         /* keep the first one */
+      free (sUser.pOut);
+    else
+    {
+      pStream = sUser.pOut;
+      iLen    = sUser.iOutlen;
+    }
+
+    iRuns++;
+    fTime = now () - fStart;
+  }
+  while (fTime < MINTIME);
+
+  iChunks = count_chunks (pStream, iLen);
+
+  printf ("chunks: an MNG of %u chunks (%u bytes; IDAT, FRAM & MOVE)\n",
+          iChunks, iLen);
+  printf ("  %-30s %10.0f chunks/s\n", "putchunk_xxxx + mng_write",
+          (double)iChunks * iRuns / fTime);
+                                       /* reading */
+  fStart = now ();
+  iRuns  = 0;
+
+  do
+  {
+    hMNG     = read_begin (&sUser);
+    iRetcode = mng_read_memory (hMNG, pStream, iLen);
+    read_end (hMNG, &sUser);
+    iRuns++;
+    fTime = now () - fStart;
+  }
+  while (fTime < MINTIME);
+
+  if (iRetcode)
+    printf ("  FAIL: mng_read_memory returned %d\n", (int)iRetcode);
+
+  printf ("  %-30s %10.0f chunks/s\n", "mng_read_memory",
+          (double)iChunks * iRuns / fTime);
+
+#if defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+  fStart = now ();                     /* reading & storing */
+  iRuns  = 0;
+
+  do
+  {
+    hMNG = read_begin (&sUser);
+    mng_set_storechunks (hMNG, MNG_TRUE);
+    iRetcode = mng_read_memory (hMNG, pStream, iLen);
+    read_end (hMNG, &sUser);
+    iRuns++;
+    fTime = now () - fStart;
+  }
+  while (fTime < MINTIME);
+
+  printf ("  %-30s %10.0f chunks/s\n", "mng_read_memory (storechunks)",
+          (double)iChunks * iRuns / fTime);
+#endif
+
+  free (pStream);
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * objects: SHOW & MOVE over many image-objects                           * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+/* iObjects 4x4 sprites, then iPasses frames that move & show all of them */
+static mng_uint8p make_sprites (mng_uint32  iObjects,
+                                int         iPasses,
+                                mng_uint32 *iLen)
+{
+  userdata   sUser;
+  mng_handle hMNG = create_begin (&sUser);
+  mng_uint32 iId;
+  int        iPass;
+
+  mng_create (hMNG);
+  mng_putchunk_mhdr (hMNG, 256, 256, 1000, 0, 0, 0, 0);
+  mng_putchunk_back (hMNG, 0x8080, 0x8080, 0x8080, 1, 0, 0);
+  mng_putchunk_fram (hMNG, MNG_FALSE, 1, 0, MNG_NULL, 2, 0, 0, 0, 1, 0,
+                     0, 0, 0, 0, 0, 0, MNG_NULL);
+
+  for (iId = 1; iId <= iObjects; iId++)
+  {
+    mng_putchunk_defi (hMNG, (mng_uint16)iId, 0, 1, MNG_TRUE,
+                       (iId * 7) % 252, (iId * 13) % 252, MNG_FALSE, 0, 0, 0, 0);
+    fill_photo (4, 4, 0);
+    mng_putchunk_ihdr   (hMNG, 4, 4, 8, 6, 0, 0, 0);
+    mng_putimgdata_ihdr (hMNG, 4, 4, 6, 8, 0, 0, 0, MNG_CANVAS_RGBA8,
+                         cb_getsourceline);
+    mng_putchunk_iend   (hMNG);
+  }
+
+  for (iPass = 0; iPass < iPasses; iPass++)
+  {
+    mng_putchunk_move (hMNG, 1, (mng_uint16)iObjects, 1, 1, -1);
+    mng_putchunk_show (hMNG, MNG_FALSE, 1, (mng_uint16)iObjects, 0);
+  }
+
+  mng_putchunk_mend (hMNG);
+  mng_write   (hMNG);
+  mng_cleanup (&hMNG);
+
+  *iLen = sUser.iOutlen;
+
+  return sUser.pOut;
+}
+
+static void bench_objects (void)
+{
+  static const mng_uint32 aCounts [4] = {100, 500, 2000, 8000};
+  userdata    sUser;
+  mng_handle  hMNG;
+  mng_retcode iRetcode = MNG_NOERROR;
+  int         iCount, iRuns;
+  double      fStart, fTime;
+
+  printf ("objects: 4x4 sprites; 20 frames of MOVE & SHOW over all of them\n");
+  printf ("  %-8s %12s %16s\n", "objects", "ms/stream", "sprite-frames/s");
+
+  iSeed = 20261017;
+
+  for (iCount = 0; iCount < 4; iCount++)
+  {
+    mng_uint32 iLen;
+    mng_uint8p pStream = make_sprites (aCounts [iCount], 20, &iLen);
+
+    fStart = now ();
+    iRuns  = 0;
+
+    do
+    {
+      hMNG     = read_begin (&sUser);
+      iRetcode = mng_read_memory (hMNG, pStream, iLen);
+      if (!iRetcode)
+        iRetcode = mng_render_frames (hMNG, cb_renderframe);
+      read_end (hMNG, &sUser);
+      iRuns++;
+      fTime = now () - fStart;
+    }
+    while (fTime < MINTIME);
+
+    if ((iRetcode) && (iRetcode != MNG_NEEDTIMERWAIT))
+      printf ("  FAIL: returned %d\n", (int)iRetcode);
+                                       /* reading & decoding included */
+    printf ("  %-8u %12.2f %16.0f\n", aCounts [iCount], fTime * 1000 / iRuns,
+            (double)aCounts [iCount] * 20 * iRuns / fTime);
+
+    free (pStream);
+  }
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * mempool: reading & cleaning up with & without the pool                 * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_MEMPOOL
+typedef struct {
+          mng_uint8p     pStream;
+          mng_uint32     iLen;
+          mng_bool       bMempool;
+          mng_bool       bStore;
+          mng_memalloc   fAlloc;
+          mng_memfree    fFree;
+          double         fEnd;
+          int            iRuns;
+          mng_uint32     iPeak;
+        } poolrun;
+
+static void *pool_worker (void *pArg)
+{
+  poolrun    *pRun = (poolrun *)pArg;
+  userdata    sUser;
+  mng_handle  hMNG;
+  mng_retcode iRetcode;
+
+  do
+  {
+    hMNG = mng_initialize ((mng_ptr)&sUser, pRun->fAlloc, pRun->fFree, MNG_NULL);
+    memset (&sUser, 0, sizeof (sUser));
+    mng_setcb_errorproc     (hMNG, cb_errorproc    );
+    mng_setcb_processheader (hMNG, cb_processheader);
+    mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+    mng_setcb_refresh       (hMNG, cb_refresh      );
+    mng_setcb_gettickcount  (hMNG, cb_gettickcount );
+    mng_setcb_settimer      (hMNG, cb_settimer     );
+    mng_set_mempool         (hMNG, pRun->bMempool  );
+    mng_set_storechunks     (hMNG, pRun->bStore    );
+
+    iRetcode = mng_read_memory (hMNG, pRun->pStream, pRun->iLen);
+
+    if (iRetcode)
+      fprintf (stderr, "mngbench: mng_read_memory returned %d\n", (int)iRetcode);
+
+    pRun->iPeak = mng_get_mempoolpeak (hMNG);
+    read_end (hMNG, &sUser);           /* the cleanup counts too */
+    pRun->iRuns++;
+  }
+  while (now () < pRun->fEnd);
+
+  return NULL;
+}
+
+/* streams/s on iThreads threads, each with its own handle */
+static double time_pool (poolrun *pRun,
+                         int      iThreads)
+{
+  pthread_t aThreads [4];
+  poolrun   aRuns    [4];
+  double    fStart = now ();
+  int       iX, iRuns = 0;
+
+  for (iX = 0; iX < iThreads; iX++)
+  {
+    aRuns [iX]       = *pRun;
+    aRuns [iX].fEnd  = fStart + MINTIME;
+    aRuns [iX].iRuns = 0;
+    pthread_create (&aThreads [iX], NULL, pool_worker, &aRuns [iX]);
+  }
+
+  for (iX = 0; iX < iThreads; iX++)
+  {
+    pthread_join (aThreads [iX], NULL);
+    iRuns += aRuns [iX].iRuns;
+  }
+
+  pRun->iPeak = aRuns [0].iPeak;
+
+  return (double)iRuns / (now () - fStart);
+}
+#endif /* MNG_SUPPORT_MEMPOOL */
+
+static void bench_mempool (void)
+{
+#ifdef MNG_SUPPORT_MEMPOOL
+  userdata   sUser;
+  mng_handle hMNG;
+  poolrun    sRun;
+  int        iStore, iLocked, iThreads;
+  mng_uint32 iCalls [2];
+
+  iSeed = 20261017;
+  hMNG  = create_begin (&sUser);
+  mng_create (hMNG);
+  put_chunky (hMNG, 5000);
+  mng_write   (hMNG);
+  mng_cleanup (&hMNG);
+
+  sRun.pStream = sUser.pOut;
+  sRun.iLen    = sUser.iOutlen;
+
+  printf ("mempool: mng_read_memory & mng_cleanup of an MNG of %u chunks\n",
+          count_chunks (sRun.pStream, sRun.iLen));
+  printf ("  %-11s %-7s %-7s %10s %10s %10s %10s\n", "chunks", "alloc", "threads",
+          "no pool/s", "pool/s", "ratio", "calls");
+
+  for (iStore = 0; iStore < 2; iStore++)
+    for (iLocked = 0; iLocked < 2; iLocked++)
+      for (iThreads = 1; iThreads <= 4; iThreads += 3)
+      {
+        double fPlain, fPool;
+
+        sRun.bStore = (mng_bool)iStore;
+        sRun.fAlloc = (iLocked ? cb_alloc_locked : cb_alloc);
+        sRun.fFree  = (iLocked ? cb_free_locked  : cb_free );
+
+        for (sRun.bMempool = 0; sRun.bMempool < 2; sRun.bMempool++)
+        {                              /* count the allocator calls once */
+          sRun.fAlloc = cb_alloc_locked;
+          sRun.fFree  = cb_free_locked;
+          sRun.fEnd   = 0;
+          sRun.iRuns  = 0;
+          iAllocs     = 0;
+          pool_worker (&sRun);
+          iCalls [sRun.bMempool] = iAllocs;
+        }
+
+        sRun.fAlloc   = (iLocked ? cb_alloc_locked : cb_alloc);
+        sRun.fFree    = (iLocked ? cb_free_locked  : cb_free );
+        sRun.bMempool = MNG_FALSE;
+        fPlain        = time_pool (&sRun, iThreads);
+        sRun.bMempool = MNG_TRUE;
+        fPool         = time_pool (&sRun, iThreads);
+
+        printf ("  %-11s %-7s %-7d %10.0f %10.0f %10.2f %5u/%-5u\n",
+                (iStore ? "stored" : "processed"), (iLocked ? "locked" : "calloc"),
+                iThreads, fPlain, fPool, fPool / fPlain, iCalls [0], iCalls [1]);
+      }
+
+  printf ("  (calls: allocator calls per stream without/with the pool;"
+          " pool peak %u bytes)\n", sRun.iPeak);
+
+  free (sRun.pStream);
+#else
+  printf ("mempool: the library has MNG_NO_MEMPOOL\n");
+#endif
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * crc: the chunk crc engine against the old loop & zlib                  * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+/* the byte-at-a-time loop from the PNG specification, as libmng had it */
+static mng_uint32 aSpectable [256];
+
+static mng_uint32 spec_crc (mng_uint8p pBuf,
+                            mng_uint32 iLen)
+{
+  mng_uint32 iC = 0xffffffffUL;
+
+  while (iLen--)
+    iC = aSpectable [(iC ^ *pBuf++) & 0xff] ^ (iC >> 8);
+
+  return iC ^ 0xffffffffUL;
+}
+
+#define CRC_SPEC     0
+#define CRC_ZLIB     1
+#define CRC_LIBMNG   2
+
+static double time_crc (int        iKind,
+                        mng_handle hMNG,
+                        mng_uint8p pBuf,
+                        mng_uint32 iLen,
+                        mng_uint32 iTotal,
+                        mng_uint32 *iResult)
+{
+  mng_uint32 iPos;
+  int        iRuns = 0;
+  double     fStart = now (), fTime;
+
+  do
+  {
+    for (iPos = 0; iPos + iLen <= iTotal; iPos += iLen)
+    {
+      switch (iKind)
+      {
+        case CRC_SPEC : { *iResult = spec_crc (pBuf + iPos, iLen); break; }
+        case CRC_ZLIB : { *iResult = (mng_uint32)crc32 (0, pBuf + iPos, iLen); break; }
+        default       : { *iResult = mng_crc ((mng_datap)hMNG, pBuf + iPos, iLen); }
+      }
+    }
+
+    iRuns++;
+    fTime = now () - fStart;
+  }
+  while (fTime < MINTIME / 2);
+
+  return (double)(iTotal - iTotal % iLen) * iRuns / fTime / 1e6;
+}
+
+static void bench_crc (void)
+{
+  static const mng_uint32 aLens [4] = {13, 64, 8192, 1048576};
+  mng_uint32 iTotal = 4 * 1048576;
+  mng_uint8p pBuf   = (mng_uint8p)malloc (iTotal);
+  mng_uint32 iSIMD, iX, iK;
+  mng_handle hMNG;
+  int        iLen;
+
+  for (iX = 0; iX < 256; iX++)
+  {
+    mng_uint32 iC = iX;
+
+    for (iK = 0; iK < 8; iK++)
+      iC = (iC & 1 ? 0xedb88320UL ^ (iC >> 1) : iC >> 1);
+
+    aSpectable [iX] = iC;
+  }
+
+  iSeed = 20261017;
+  for (iX = 0; iX < iTotal; iX++)
+    pBuf [iX] = (mng_uint8)rnd (256);
+
+  hMNG  = mng_initialize (MNG_NULL, cb_alloc, cb_free, MNG_NULL);
+  iSIMD = mng_get_simd (hMNG);
+
+  printf ("crc: MB/s over 4MB of random data in pieces of the given size\n");
+  printf ("  %-8s %10s %10s %10s %10s\n", "bytes", "old loop", "zlib",
+          "libmng", "libmng+simd");
+
+  for (iLen = 0; iLen < 4; iLen++)
+  {
+    mng_uint32 iOld, iZlib, iNew, iFast = 0;
+    double     fOld, fZlib, fNew, fFast = 0;
+
+    fOld  = time_crc (CRC_SPEC, hMNG, pBuf, aLens [iLen], iTotal, &iOld );
+    fZlib = time_crc (CRC_ZLIB, hMNG, pBuf, aLens [iLen], iTotal, &iZlib);
+    mng_set_simd (hMNG, MNG_SIMD_NONE);
+    fNew  = time_crc (CRC_LIBMNG, hMNG, pBuf, aLens [iLen], iTotal, &iNew);
+
+    if (iSIMD & (MNG_SIMD_PCLMUL | MNG_SIMD_CRC32))
+    {
+      mng_set_simd (hMNG, iSIMD);
+      fFast = time_crc (CRC_LIBMNG, hMNG, pBuf, aLens [iLen], iTotal, &iFast);
+    }
+    else
+      iFast = iOld;
+
+    if ((iZlib != iOld) || (iNew != iOld) || (iFast != iOld))
+      printf ("  FAIL: the crc's differ\n");
+
+    printf ("  %-8u %10.0f %10.0f %10.0f %10.0f\n", aLens [iLen],
+            fOld, fZlib, fNew, fFast);
+  }
+
+  mng_cleanup (&hMNG);
+  free (pBuf);
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * frames: headless rendering on the virtual clock & on a fake timer      * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+/* iFrames frames of iSize x iSize through mng_putframe: a moving block on
+   a photo with a little noise, so every frame is a small delta */
+static mng_uint8p make_anim (mng_uint32  iSize,
+                             int         iFrames,
+                             mng_uint32 *iLen)
+{
+  static mng_uint8 aBase [256 * 256 * 4];
+  userdata   sUser;
+  mng_handle hMNG = create_begin (&sUser);
+  mng_uint32 iX, iY;
+  int        iFrame;
+
+  mng_create (hMNG);
+  mng_putchunk_mhdr (hMNG, iSize, iSize, 1000, 0, 0, 0, 0);
+
+  fill_photo (iSize, iSize, 0);
+  memcpy (aBase, aSource, iSize * iSize * 4);
+
+  for (iFrame = 0; iFrame < iFrames; iFrame++)
+  {
+    memcpy (aSource, aBase, iSize * iSize * 4);
+
+    for (iY = iSize / 4; iY < iSize / 2; iY++)
+      for (iX = iFrame % (iSize - 32); iX < iFrame % (iSize - 32) + 32; iX++)
+        aSource [(iY * iSize + iX) * 4] = (mng_uint8)(iFrame * 4);
+
+    for (iX = 0; iX < 20; iX++)
+      aSource [rnd (iSize * iSize * 4)] = (mng_uint8)rnd (256);
+
+    mng_putframe (hMNG, 40, MNG_CANVAS_RGBA8, cb_getsourceline);
+  }
+
+  mng_putchunk_mend (hMNG);
+  mng_write   (hMNG);
+  mng_cleanup (&hMNG);
+
+  *iLen = sUser.iOutlen;
+
+  return sUser.pOut;
+}
+
+/* a 64x64 sprite going round a 128x128 background in a LOOP */
+static mng_uint8p make_loop (int         iFrames,
+                             mng_uint32 *iLen)
+{
+  userdata   sUser;
+  mng_handle hMNG = create_begin (&sUser);
+
+  mng_create (hMNG);
+  mng_putchunk_mhdr (hMNG, 128, 128, 1000, 0, 0, 0, 0);
+  mng_putchunk_back (hMNG, 0x2020, 0x4040, 0x6060, 1, 0, 0);
+  mng_putchunk_fram (hMNG, MNG_FALSE, 3, 0, MNG_NULL, 2, 0, 0, 0, 40, 0,
+                     0, 0, 0, 0, 0, 0, MNG_NULL);
+  mng_putchunk_defi (hMNG, 1, 0, 1, MNG_TRUE, 0, 0, MNG_FALSE, 0, 0, 0, 0);
+  fill_photo (64, 64, 0);
+  mng_putchunk_ihdr   (hMNG, 64, 64, 8, 6, 0, 0, 0);
+  mng_putimgdata_ihdr (hMNG, 64, 64, 6, 8, 0, 0, 0, MNG_CANVAS_RGBA8,
+                       cb_getsourceline);
+  mng_putchunk_iend   (hMNG);
+  mng_putchunk_loop (hMNG, 0, (mng_uint32)iFrames, 0, 0, 0, 0, MNG_NULL);
+  mng_putchunk_move (hMNG, 1, 1, 1, 1, 1);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 1, 0);
+  mng_putchunk_endl (hMNG, 0);
+  mng_putchunk_mend (hMNG);
+  mng_write   (hMNG);
+  mng_cleanup (&hMNG);
+
+  *iLen = sUser.iOutlen;
+
+  return sUser.pOut;
+}
+
+/* read & render a stream; returns the number of frames */
+static int render_stream (mng_uint8p pStream,
+                          mng_uint32 iLen,
+                          int        bVirtual)
+{
+  userdata    sUser;
+  mng_handle  hMNG = read_begin (&sUser);
+  mng_retcode iRetcode;
+  int         iFrames;
+
+  iRetcode = mng_read_memory (hMNG, pStream, iLen);
+
+  if (iRetcode)
+    fprintf (stderr, "mngbench: mng_read_memory returned %d\n", (int)iRetcode);
+
+  if (bVirtual)
+  {
+    iRetcode = mng_render_frames (hMNG, cb_renderframe);
+    iFrames  = sUser.iFrames;
+  }
+  else
+  {                                    /* the way before mng_render_frames:
+                                          every frame is a timer round trip */
+    iRetcode = mng_display (hMNG);
+    iFrames  = 0;
+
+    while (iRetcode == MNG_NEEDTIMERWAIT)
+    {                                  /* one wait after each frame */
+      iRetcode = mng_display_resume (hMNG);
+      iFrames++;
+    }
+  }
+
+  if (iRetcode)
+    fprintf (stderr, "mngbench: rendering returned %d\n", (int)iRetcode);
+
+  read_end (hMNG, &sUser);
+
+  return iFrames;
+}
+
+static void bench_frames (void)
+{
+  static const char *aNames [4] = {"putframe 64", "putframe 256", "sprites", "loop"};
+  mng_uint8p pStreams [4];
+  mng_uint32 iLens    [4];
+  int        iStream, iMode, iRuns, aFrames [2];
+  double     fStart, fTime, aRates [2];
+
+  iSeed = 20261017;
+  pStreams [0] = make_anim    (64,  100,    &iLens [0]);
+  pStreams [1] = make_anim    (256, 100,    &iLens [1]);
+  pStreams [2] = make_sprites (200, 100,    &iLens [2]);
+  pStreams [3] = make_loop    (100,         &iLens [3]);
+
+  printf ("frames: frames/s reading & rendering, with mng_render_frames and\n"
+          "        with mng_display & mng_display_resume on a fake timer\n");
+  printf ("  %-13s %6s %12s %12s %8s\n", "stream", "frames", "render/s",
+          "resume/s", "ratio");
+
+  for (iStream = 0; iStream < 4; iStream++)
+  {
+    for (iMode = 0; iMode < 2; iMode++)
+    {
+      fStart = now ();
+      iRuns  = 0;
+
+      do
+      {
+        aFrames [iMode] = render_stream (pStreams [iStream], iLens [iStream], !iMode);
+        iRuns++;
+        fTime = now () - fStart;
+      }
+      while (fTime < MINTIME);
+
+      aRates [iMode] = (double)aFrames [iMode] * iRuns / fTime;
+    }
+
+    if (aFrames [0] != aFrames [1])
+      printf ("  FAIL: %d frames rendered, %d displayed\n", aFrames [0], aFrames [1]);
+
+    printf ("  %-13s %6d %12.0f %12.0f %8.2f\n", aNames [iStream], aFrames [0],
+            aRates [0], aRates [1], aRates [0] / aRates [1]);
+
+    free (pStreams [iStream]);
+  }
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * driver                                                                 * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+typedef struct {
+          const char *zName;
+          void       (*fBench) (void);
+        } benchmark;
+
+static const benchmark aBenchmarks [] =
+  {
+    {"encode",   bench_encode  },
+    {"unfilter", bench_unfilter},
+    {"chunks",   bench_chunks  },
+    {"objects",  bench_objects },
+    {"mempool",  bench_mempool },
+    {"crc",      bench_crc     },
+    {"frames",   bench_frames  },
+  };
+
+#define BENCHCOUNT (int)(sizeof (aBenchmarks) / sizeof (aBenchmarks [0]))
+
+int main (int argc, char *argv[])
+{
+  int iArg, iX;
+
+  if (argc < 2)
+  {
+    for (iX = 0; iX < BENCHCOUNT; iX++)
+      aBenchmarks [iX].fBench ();
+
+    return 0;
+  }
+
+  for (iArg = 1; iArg < argc; iArg++)
+  {
+    for (iX = 0; iX < BENCHCOUNT; iX++)
+      if (!strcmp (argv [iArg], aBenchmarks [iX].zName))
+        break;
+
+    if (iX >= BENCHCOUNT)
+    {
+      fprintf (stderr, "mngbench: unknown benchmark %s\n", argv [iArg]);
+      return 2;
+    }
+
+    aBenchmarks [iX].fBench ();
+  }
+
+  return 0;
+}
+
+/* ************************************************************************** */
+/* * end of file                                                            * */
+/* ************************************************************************** */
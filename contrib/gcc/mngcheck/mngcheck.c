@@ -0,0 +1,2082 @@
+/* ************************************************************************** */
+/* *             For conditions of distribution and use,                    * */
+/* *                see copyright notice in libmng.h                        * */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * project   : mngcheck                                                   * */
+/* * file      : mngcheck.c                                                 * */
+/* * version   : 1.0.11                                                     * */
+/* *                                                                        * */
+/* * purpose   : regression check for the decoder & display routines        * */
+/* *                                                                        * */
+/* * comment   : mngcheck builds a small corpus of PNG & MNG streams with   * */
+/* *             the library itself (deterministic pseudo-random contents), * */
+/* *             adds the files given on the command-line, renders every    * */
+/* *             stream in each canvas style and prints a hash & the frame- * */
+/* *             count for each stream & style; "make -f makefile.linux     * */
+/* *             check" compares the output with mngcheck.ref               * */
+/* *                                                                        * */
+/* *             each stream is rendered with & without the vectorized      * */
+/* *             routines, through mng_read as well as mng_read_memory, in  * */
+/* *             small pushed pieces with suspension-mode on, with the      * */
+/* *             memory-pool and (where the library has them) with decode-  * */
+/* *             threads and lazy magnification; any difference between     * */
+/* *             those is reported as FAIL, whatever the reference says     * */
+/* *                                                                        * */
+/* *             with -j N every stream is rendered again in every style on * */
+/* *             N threads at once, one handle per rendering, and compared  * */
+/* *             with the single-threaded result ("make stress" runs that   * */
+/* *             under ThreadSanitizer)                                     * */
+/* *                                                                        * */
+/* *             16-bit gamma-correction is also compared with the formula, * */
+/* *             for every sample value                                     * */
+/* *                                                                        * */
+/* *             the animations are seeked with goframe, golayer & gotime   * */
+/* *             with & without the keyframe-cache, with a thinned cache    * */
+/* *             and with allocations failing in the middle of a seek       * */
+/* *                                                                        * */
+/* *             at every refresh the changed pixels are compared with the  * */
+/* *             dirty-rectangles, and mng_getimgdata_seq is compared with  * */
+/* *             the rendered canvas for the single PNGs                    * */
+/* *                                                                        * */
+/* *             built with MNG_FULL_CMS the lcms transform-cache is        * */
+/* *             checked as well (same frames, expected hits & misses)      * */
+/* *                                                                        * */
+/* *             -w DIR writes the generated streams to DIR instead, so     * */
+/* *             mngref can render them with another libmng                 * */
+/* *                                                                        * */
+/* * changes   : 1.0.11 - 10/17/2026                                        * */
+/* *             - initial version                                          * */
+/* *             - added -j for the multi-threaded stress-run               * */
+/* *             - one line per stream & style; added -w for mngref         * */
+/* *             - added 16-bit gAMA streams & the exact gamma16 check      * */
+/* *             - added the mng_read_pushdata pass                         * */
+/* *             - added the keyframe-cache seek check                      * */
+/* *             - added the getimgdata check                               * */
+/* *             - added the memory-pool pass                               * */
+/* *             - added the dirty-rectangle check                          * */
+/* *             - added the transform-cache check (MNG_FULL_CMS)           * */
+/* *             - added the PAST stream at the target's edges              * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+#include <zlib.h>
+
+#include "../../../libmng.h"
+
+/* ************************************************************************** */
+
+#define MAXW        128                /* largest generated image */
+#define MAXH        128
+#define MAXSTREAMS  64
+#define MAXFRAMES   200                /* stop runaway animations */
+#define MAXTHREADS  64
+
+typedef unsigned long long hashval;
+
+typedef struct {
+          const char *zName;
+          mng_uint8p  pData;
+          mng_uint32  iLen;
+          int         bMagn;           /* also compare lazy magnification */
+        } stream;
+
+typedef struct {
+          const char *zName;
+          mng_uint32  iStyle;
+          mng_uint32  iPixelsize;
+        } canvasstyle;
+
+static const canvasstyle aStyles [] =
+  {
+    {"rgb8",     MNG_CANVAS_RGB8,     3},
+    {"bgr8",     MNG_CANVAS_BGR8,     3},
+    {"rgba8",    MNG_CANVAS_RGBA8,    4},
+    {"rgba8pm",  MNG_CANVAS_RGBA8_PM, 4},
+    {"argb8",    MNG_CANVAS_ARGB8,    4},
+    {"argb8pm",  MNG_CANVAS_ARGB8_PM, 4},
+    {"bgra8",    MNG_CANVAS_BGRA8,    4},
+    {"bgra8pm",  MNG_CANVAS_BGRA8_PM, 4},
+    {"abgr8",    MNG_CANVAS_ABGR8,    4},
+    {"abgr8pm",  MNG_CANVAS_ABGR8_PM, 4},
+    {"bgrx8",    MNG_CANVAS_BGRX8,    4},
+    {"rgb16",    MNG_CANVAS_RGB16,    6},
+    {"rgba16",   MNG_CANVAS_RGBA16,   8},
+    {"argb16",   MNG_CANVAS_ARGB16,   8},
+    {"bgr16",    MNG_CANVAS_BGR16,    6},
+    {"bgra16",   MNG_CANVAS_BGRA16,   8},
+    {"abgr16",   MNG_CANVAS_ABGR16,   8},
+    {"gray8",    MNG_CANVAS_GRAY8,    1},
+    {"graya8",   MNG_CANVAS_GRAYA8,   2},
+    {"rgb565",   MNG_CANVAS_RGB565,   2},
+    {"rgba565",  MNG_CANVAS_RGBA565,  3},
+  };
+
+#define STYLECOUNT (int)(sizeof (aStyles) / sizeof (aStyles [0]))
+
+static stream aStreams [MAXSTREAMS];
+static int    iStreamcount = 0;
+static int    iFiles       = 0;        /* streams from the command-line */
+static int    iFailures    = 0;
+static int    iThreads     = 0;
+
+static hashval aRefhash   [MAXSTREAMS] [STYLECOUNT];
+static int     aRefframes [MAXSTREAMS] [STYLECOUNT];
+
+static pthread_mutex_t hFailmutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * pseudo-random numbers; rand() differs per C-library                    * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+static mng_uint32 iSeed = 1;
+
+static mng_uint32 rnd (mng_uint32 iRange)
+{
+  iSeed = iSeed * 1103515245UL + 12345UL;
+  return ((iSeed >> 8) & 0xFFFFFF) % iRange;
+}
+
+static mng_uint8 rnd_alpha (void)     /* transparent, opaque & partial alike */
+{
+  switch (rnd (3))
+  {
+    case 0  : return 0;
+    case 1  : return 255;
+    default : return (mng_uint8)(1 + rnd (254));
+  }
+}
+
+/* ************************************************************************** */
+
+static hashval hash_bytes (hashval iHash, const mng_uint8 *pBuf, mng_uint32 iLen)
+{                                      /* FNV-1a */
+  while (iLen--)
+  {
+    iHash ^= *pBuf++;
+    iHash *= 1099511628211ULL;
+  }
+
+  return iHash;
+}
+
+static hashval hash_uint (hashval iHash, mng_uint32 iValue)
+{
+  mng_uint8 aBuf [4];
+
+  aBuf [0] = (mng_uint8)(iValue >> 24);
+  aBuf [1] = (mng_uint8)(iValue >> 16);
+  aBuf [2] = (mng_uint8)(iValue >>  8);
+  aBuf [3] = (mng_uint8)(iValue      );
+
+  return hash_bytes (iHash, aBuf, 4);
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * callbacks shared by the writer & the renderer                          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+typedef struct {
+          mng_uint8p  pOut;            /* stream being written */
+          mng_uint32  iOutlen;
+          mng_uint32  iOutsize;
+          mng_uint8p  pIn;             /* stream being read (mng_read) */
+          mng_uint32  iInlen;
+          mng_uint32  iInpos;
+          mng_uint8p  pCanvas;         /* app canvas */
+          mng_uint32  iRowsize;
+          mng_uint32  iWidth;
+          mng_uint32  iHeight;
+          mng_uint32  iPixelsize;
+          hashval     iHash;
+          int         iFrames;
+          int         iStop;           /* last frame to render (0 = MAXFRAMES) */
+          mng_uint8p  pShadow;         /* canvas at the previous refresh */
+          mng_uint32  iMissed;         /* changed pixels outside the rects */
+          mng_uint32  iStray;          /* rects outside the refresh region */
+          mng_retcode iError;
+        } userdata;
+
+static mng_ptr MNG_DECL cb_alloc (mng_size_t iLen)
+{
+  return calloc (1, iLen);
+}
+
+/* an allocator that fails the iFailat'th call (single-threaded use only) */
+static mng_uint32 iAllocs = 0;
+static mng_uint32 iFailat = 0;
+
+static mng_ptr MNG_DECL cb_failalloc (mng_size_t iLen)
+{
+  if ((iFailat) && (++iAllocs == iFailat))
+    return MNG_NULL;
+
+  return calloc (1, iLen);
+}
+
+static void MNG_DECL cb_free (mng_ptr pPtr, mng_size_t iLen)
+{
+  free (pPtr);
+}
+
+static mng_bool MNG_DECL cb_openstream (mng_handle hMNG)
+{
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_closestream (mng_handle hMNG)
+{
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_writedata (mng_handle  hMNG,
+                                       mng_ptr     pBuf,
+                                       mng_uint32  iSize,
+                                       mng_uint32p iWritten)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  if (pUser->iOutlen + iSize > pUser->iOutsize)
+  {
+    pUser->iOutsize = (pUser->iOutlen + iSize) * 2;
+    pUser->pOut     = (mng_uint8p)realloc (pUser->pOut, pUser->iOutsize);
+  }
+
+  memcpy (pUser->pOut + pUser->iOutlen, pBuf, iSize);
+  pUser->iOutlen += iSize;
+  *iWritten       = iSize;
+
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_readdata (mng_handle  hMNG,
+                                      mng_ptr     pBuf,
+                                      mng_uint32  iSize,
+                                      mng_uint32p iRead)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  if (iSize > pUser->iInlen - pUser->iInpos)
+    iSize = pUser->iInlen - pUser->iInpos;
+
+  memcpy (pBuf, pUser->pIn + pUser->iInpos, iSize);
+  pUser->iInpos += iSize;
+  *iRead         = iSize;
+
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_readnothing (mng_handle  hMNG,
+                                         mng_ptr     pBuf,
+                                         mng_uint32  iSize,
+                                         mng_uint32p iRead)
+{                                      /* everything comes through the push */
+  *iRead = 0;
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_errorproc (mng_handle  hMNG,
+                                       mng_int32   iErrorcode,
+                                       mng_int8    iSeverity,
+                                       mng_chunkid iChunkname,
+                                       mng_uint32  iChunkseq,
+                                       mng_int32   iExtra1,
+                                       mng_int32   iExtra2,
+                                       mng_pchar   zErrortext)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  if (pUser)
+    pUser->iError = iErrorcode;
+
+  return MNG_FALSE;
+}
+
+static mng_bool MNG_DECL cb_processheader (mng_handle hMNG,
+                                           mng_uint32 iWidth,
+                                           mng_uint32 iHeight)
+{
+  return MNG_TRUE;
+}
+
+static mng_ptr MNG_DECL cb_getcanvasline (mng_handle hMNG,
+                                          mng_uint32 iLinenr)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  return (mng_ptr)(pUser->pCanvas + iLinenr * pUser->iRowsize);
+}
+
+static mng_bool MNG_DECL cb_refresh (mng_handle hMNG,
+                                     mng_uint32 iX,
+                                     mng_uint32 iY,
+                                     mng_uint32 iWidth,
+                                     mng_uint32 iHeight)
+{
+  return MNG_TRUE;
+}
+
+static mng_uint32 MNG_DECL cb_gettickcount (mng_handle hMNG)
+{
+  return 0;
+}
+
+static mng_bool MNG_DECL cb_settimer (mng_handle hMNG,
+                                      mng_uint32 iMsecs)
+{
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_renderframe (mng_handle hMNG,
+                                         mng_ptr    pCanvas,
+                                         mng_uint32 iRowsize,
+                                         mng_uint32 iDelay,
+                                         mng_uint32 iX,
+                                         mng_uint32 iY,
+                                         mng_uint32 iWidth,
+                                         mng_uint32 iHeight)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  pUser->iHash = hash_uint  (pUser->iHash, iDelay);
+  pUser->iHash = hash_bytes (pUser->iHash, pUser->pCanvas,
+                             pUser->iRowsize * pUser->iHeight);
+  pUser->iFrames++;
+
+  return (mng_bool)(pUser->iFrames < (pUser->iStop ? pUser->iStop : MAXFRAMES));
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * stream generation                                                      * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+static userdata   sWriter;
+static mng_uint8  aSource [MAXW * MAXH * 8];
+static mng_uint32 iSourcerow;
+
+static mng_ptr MNG_DECL cb_getsourceline (mng_handle hMNG,
+                                          mng_uint32 iLinenr)
+{
+  return (mng_ptr)(aSource + iLinenr * iSourcerow);
+}
+
+static mng_handle create_begin (void)
+{
+  mng_handle hMNG = mng_initialize ((mng_ptr)&sWriter, cb_alloc, cb_free, MNG_NULL);
+
+  sWriter.pOut     = MNG_NULL;
+  sWriter.iOutlen  = 0;
+  sWriter.iOutsize = 0;
+
+  mng_setcb_openstream  (hMNG, cb_openstream );
+  mng_setcb_closestream (hMNG, cb_closestream);
+  mng_setcb_writedata   (hMNG, cb_writedata  );
+  mng_setcb_errorproc   (hMNG, cb_errorproc  );
+  mng_create            (hMNG);
+
+  return hMNG;
+}
+
+static void create_end (mng_handle  hMNG,
+                        const char *zName,
+                        int         bMagn)
+{
+  mng_retcode iRetcode = mng_write (hMNG);
+
+  mng_cleanup (&hMNG);
+
+  if (iRetcode)
+  {
+    printf ("FAIL %s: writing returned %d\n", zName, (int)iRetcode);
+    iFailures++;
+    free (sWriter.pOut);
+    return;
+  }
+
+  aStreams [iStreamcount].zName = zName;
+  aStreams [iStreamcount].pData = sWriter.pOut;
+  aStreams [iStreamcount].iLen  = sWriter.iOutlen;
+  aStreams [iStreamcount].bMagn = bMagn;
+  iStreamcount++;
+}
+
+/* fill the source with a noisy gradient in RGBA8 or RGBA16 layout */
+static void fill_source (mng_uint32 iWidth,
+                         mng_uint32 iHeight,
+                         int        b16)
+{
+  mng_uint32 iX, iY, iC;
+  mng_uint8p pOut;
+
+  iSourcerow = iWidth * (b16 ? 8 : 4);
+
+  for (iY = 0; iY < iHeight; iY++)
+  {
+    pOut = aSource + iY * iSourcerow;
+
+    for (iX = 0; iX < iWidth; iX++)
+    {
+      for (iC = 0; iC < 3; iC++)
+      {
+        mng_uint32 iV = (iX * (iC + 3) + iY * (5 - iC) * 2 + rnd (24)) & 0xFF;
+
+        if (b16)
+        {
+          *pOut++ = (mng_uint8)iV;
+          *pOut++ = (mng_uint8)rnd (256);
+        }
+        else
+          *pOut++ = (mng_uint8)iV;
+      }
+
+      iC      = rnd_alpha ();
+      *pOut++ = (mng_uint8)iC;
+      if (b16)                         /* keep 0 & 65535 exact */
+        *pOut++ = (mng_uint8)(iC == 255 ? 255 : (iC ? rnd (256) : 0));
+    }
+  }
+}
+
+/* an image through mng_putimgdata_ihdr (filtered & compressed by libmng);
+   delta-blocks have no IHDR and take the colortype of their target */
+static void put_pixels (mng_handle hMNG,
+                        mng_uint32 iWidth,
+                        mng_uint32 iHeight,
+                        mng_uint8  iColortype,
+                        mng_uint8  iBitdepth,
+                        int        bIHDR)
+{
+  mng_uint32 iStyle = (iBitdepth == 16 ? MNG_CANVAS_RGBA16 : MNG_CANVAS_RGBA8);
+
+  if (bIHDR)
+    mng_putchunk_ihdr (hMNG, iWidth, iHeight, iBitdepth, iColortype, 0, 0, 0);
+
+  if ((iColortype == 3) && (bIHDR))                 /* indices come from a gray canvas */
+  {
+    mng_palette8 aPal;
+    mng_uint8    aAlpha [256];
+    mng_uint32   iCount = (iBitdepth < 8 ? (1u << iBitdepth) : 200);
+    mng_uint32   iX;
+
+    for (iX = 0; iX < 256; iX++)
+    {
+      aPal [iX].iRed   = (mng_uint8)rnd (256);
+      aPal [iX].iGreen = (mng_uint8)rnd (256);
+      aPal [iX].iBlue  = (mng_uint8)rnd (256);
+      aAlpha [iX]      = rnd_alpha ();
+    }
+
+    mng_putchunk_plte (hMNG, iCount, aPal);
+    mng_putchunk_trns (hMNG, MNG_FALSE, MNG_FALSE, 3, iCount / 2, aAlpha,
+                       0, 0, 0, 0, 0, aAlpha);
+
+    iSourcerow = iWidth;
+
+    for (iX = 0; iX < iWidth * iHeight; iX++)
+      aSource [iX] = (mng_uint8)rnd (iCount);
+
+    iStyle = MNG_CANVAS_GRAY8;
+  }
+  else
+    fill_source (iWidth, iHeight, iBitdepth == 16);
+
+  if (mng_putimgdata_ihdr (hMNG, iWidth, iHeight, iColortype, iBitdepth, 0, 0, 0,
+                           iStyle, cb_getsourceline))
+  {
+    printf ("FAIL putimgdata %ux%u ct=%d bd=%d\n", iWidth, iHeight,
+            iColortype, iBitdepth);
+    iFailures++;
+  }
+
+  mng_putchunk_iend (hMNG);
+}
+
+static void put_image (mng_handle hMNG,
+                       mng_uint32 iWidth,
+                       mng_uint32 iHeight,
+                       mng_uint8  iColortype,
+                       mng_uint8  iBitdepth)
+{
+  put_pixels (hMNG, iWidth, iHeight, iColortype, iBitdepth, 1);
+}
+
+static void put_block (mng_handle hMNG,
+                       mng_uint32 iWidth,
+                       mng_uint32 iHeight,
+                       mng_uint8  iColortype,
+                       mng_uint8  iBitdepth)
+{
+  put_pixels (hMNG, iWidth, iHeight, iColortype, iBitdepth, 0);
+}
+
+/* an image with random filter-bytes & random (filtered) data; every
+   filter-type and pixel-size goes through the unfilter routines, and
+   interlaced images through the Adam7 code; a gAMA is added when iGamma
+   isn't 0 */
+static void put_raw_image (mng_handle hMNG,
+                           mng_uint32 iWidth,
+                           mng_uint32 iHeight,
+                           mng_uint8  iColortype,
+                           mng_uint8  iBitdepth,
+                           mng_uint8  iInterlace,
+                           mng_uint32 iGamma)
+{
+  static const mng_uint32 aStartx [7] = {0, 4, 0, 2, 0, 1, 0};
+  static const mng_uint32 aStarty [7] = {0, 0, 4, 0, 2, 0, 1};
+  static const mng_uint32 aIncx   [7] = {8, 8, 4, 4, 2, 2, 1};
+  static const mng_uint32 aIncy   [7] = {8, 8, 8, 4, 4, 2, 2};
+  static mng_uint8 aRaw [MAXW * MAXH * 8 + MAXH * 16];
+  static mng_uint8 aZip [MAXW * MAXH * 9 + MAXH * 16];
+  mng_uint32 iSamples;
+  mng_uint32 iPass, iX, iY, iLen, iW, iH, iRowbytes, iPos;
+  uLongf     iZiplen = sizeof (aZip);
+
+  switch (iColortype)
+  {
+    case 2  : { iSamples = 3; break; }
+    case 4  : { iSamples = 2; break; }
+    case 6  : { iSamples = 4; break; }
+    default : { iSamples = 1; break; }
+  }
+
+  mng_putchunk_ihdr (hMNG, iWidth, iHeight, iBitdepth, iColortype, 0, 0, iInterlace);
+
+  if (iGamma)
+    mng_putchunk_gama (hMNG, MNG_FALSE, iGamma);
+
+  if (iColortype == 3)                 /* every index must be valid */
+  {
+    mng_palette8 aPal;
+    mng_uint8    aAlpha [256];
+
+    for (iX = 0; iX < 256; iX++)
+    {
+      aPal [iX].iRed   = (mng_uint8)rnd (256);
+      aPal [iX].iGreen = (mng_uint8)rnd (256);
+      aPal [iX].iBlue  = (mng_uint8)rnd (256);
+      aAlpha [iX]      = rnd_alpha ();
+    }
+
+    mng_putchunk_plte (hMNG, 1u << iBitdepth, aPal);
+    mng_putchunk_trns (hMNG, MNG_FALSE, MNG_FALSE, 3, (1u << iBitdepth) / 2, aAlpha,
+                       0, 0, 0, 0, 0, aAlpha);
+  }
+  else
+  if ((iColortype == 2) && (iBitdepth == 8))
+  {                                    /* the arrays are always copied */
+    mng_uint8arr aNone;
+
+    memset (aNone, 0, sizeof (aNone));
+    mng_putchunk_trns (hMNG, MNG_FALSE, MNG_FALSE, 2, 0, aNone,
+                       0, 17, 34, 51, 0, aNone);
+  }
+
+  iLen = 0;
+
+  for (iPass = 0; iPass < (iInterlace ? 7u : 1u); iPass++)
+  {
+    if (iInterlace)
+    {
+      iW = (iWidth  + aIncx [iPass] - 1 - aStartx [iPass]) / aIncx [iPass];
+      iH = (iHeight + aIncy [iPass] - 1 - aStarty [iPass]) / aIncy [iPass];
+      if ((iWidth <= aStartx [iPass]) || (iHeight <= aStarty [iPass]))
+        iW = iH = 0;
+    }
+    else
+    {
+      iW = iWidth;
+      iH = iHeight;
+    }
+
+    if (!iW)
+      continue;
+
+    iRowbytes = (iW * iSamples * iBitdepth + 7) >> 3;
+
+    for (iY = 0; iY < iH; iY++)
+    {
+      aRaw [iLen++] = (mng_uint8)rnd (5);
+
+      for (iPos = 0; iPos < iRowbytes; iPos++)
+        aRaw [iLen++] = (mng_uint8)(rnd (4) ? rnd (7) : rnd (256));
+    }
+  }
+
+  compress2 (aZip, &iZiplen, aRaw, iLen, 6);
+                                       /* in a few IDATs */
+  for (iPos = 0; iPos < iZiplen; iPos += 97)
+    mng_putchunk_idat (hMNG, (iZiplen - iPos < 97 ? iZiplen - iPos : 97), aZip + iPos);
+
+  mng_putchunk_iend (hMNG);
+}
+
+/* ************************************************************************** */
+
+static void gen_png_raw (const char *zName,
+                         mng_uint32  iWidth,
+                         mng_uint32  iHeight,
+                         mng_uint8   iColortype,
+                         mng_uint8   iBitdepth,
+                         mng_uint8   iInterlace)
+{
+  mng_handle hMNG = create_begin ();
+
+  put_raw_image (hMNG, iWidth, iHeight, iColortype, iBitdepth, iInterlace, 0);
+  create_end (hMNG, zName, 0);
+}
+
+static void gen_png_gama (const char *zName,
+                          mng_uint8   iColortype,
+                          mng_uint8   iBitdepth,
+                          mng_uint32  iGamma)
+{
+  mng_handle hMNG = create_begin ();
+
+  put_raw_image (hMNG, 37, 29, iColortype, iBitdepth, 0, iGamma);
+  create_end (hMNG, zName, 0);
+}
+
+static void gen_png (const char *zName,
+                     mng_uint32  iWidth,
+                     mng_uint32  iHeight,
+                     mng_uint8   iColortype,
+                     mng_uint8   iBitdepth)
+{
+  mng_handle hMNG = create_begin ();
+
+  put_image (hMNG, iWidth, iHeight, iColortype, iBitdepth);
+  create_end (hMNG, zName, 0);
+}
+
+/* overlapping objects of every kind, on a background and without one */
+static void gen_layers (const char *zName,
+                        int         bBack)
+{
+  mng_handle hMNG = create_begin ();
+
+  mng_putchunk_mhdr (hMNG, 97, 83, 100, 0, 0, 0, 0);
+  if (bBack)
+    mng_putchunk_back (hMNG, 0x2020, 0x8080, 0xC0C0, 1, 0, 0);
+  mng_putchunk_fram (hMNG, MNG_FALSE, 1, 0, MNG_NULL, 2, 0, 0, 0, 10, 0,
+                     0, 0, 0, 0, 0, 0, MNG_NULL);
+
+  mng_putchunk_defi (hMNG, 1, 0, 1, MNG_TRUE,   5,   7, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 70, 50, 6, 8);
+  mng_putchunk_defi (hMNG, 2, 0, 1, MNG_TRUE, -11,  30, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 80, 40, 3, 8);
+  mng_putchunk_defi (hMNG, 3, 0, 1, MNG_TRUE,  40,  -5, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 61, 33, 4, 8);
+  mng_putchunk_defi (hMNG, 4, 0, 1, MNG_TRUE,  20,  20, MNG_TRUE, 22, 90, 25, 70);
+  put_image (hMNG, 55, 55, 6, 16);
+  mng_putchunk_defi (hMNG, 5, 0, 1, MNG_TRUE,  60,  50, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 30, 30, 2, 8);
+  mng_putchunk_defi (hMNG, 6, 0, 1, MNG_TRUE,   0,  60, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 90, 20, 0, 8);
+
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 6, 0);
+  mng_putchunk_move (hMNG, 1, 3, 1, 7, -3);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 6, 0);
+  mng_putchunk_clip (hMNG, 2, 4, 0, 10, 60, 10, 60);
+  mng_putchunk_show (hMNG, MNG_FALSE, 2, 5, 0);
+  mng_putchunk_mend (hMNG);
+
+  create_end (hMNG, zName, 0);
+}
+
+/* an animation through the frame encoder (delta-PNG's & CLIP) */
+static void gen_anim (const char *zName)
+{
+  mng_handle hMNG = create_begin ();
+  mng_uint32 iFrame, iX, iY;
+  mng_uint8  aBase [MAXW * MAXH * 4];
+
+  mng_putchunk_mhdr (hMNG, 64, 48, 100, 0, 0, 0, 0);
+
+  fill_source (64, 48, 0);
+  memcpy (aBase, aSource, 64 * 48 * 4);
+
+  for (iFrame = 0; iFrame < 10; iFrame++)
+  {
+    memcpy (aSource, aBase, 64 * 48 * 4);
+                                       /* a moving block ... */
+    for (iY = 10; iY < 26; iY++)
+      for (iX = iFrame * 4; iX < iFrame * 4 + 12; iX++)
+      {
+        aSource [(iY * 64 + iX) * 4    ] = (mng_uint8)(iFrame * 25);
+        aSource [(iY * 64 + iX) * 4 + 3] = (mng_uint8)(iFrame & 1 ? 255 : 128);
+      }
+                                       /* ... some noise ... */
+    for (iX = 0; iX < 20; iX++)
+      aSource [rnd (64 * 48 * 4)] = (mng_uint8)rnd (256);
+                                       /* ... and a repeated frame */
+    if (iFrame == 6)
+      memcpy (aBase, aSource, 64 * 48 * 4);
+
+    mng_putframe (hMNG, 10 + iFrame, MNG_CANVAS_RGBA8, cb_getsourceline);
+
+    if (iFrame == 6)
+      mng_putframe (hMNG, 5, MNG_CANVAS_RGBA8, cb_getsourceline);
+  }
+
+  mng_putchunk_mend (hMNG);
+  create_end (hMNG, zName, 0);
+}
+
+/* delta-images of the RGBA & gray kind */
+static void gen_delta (const char *zName,
+                       mng_uint8   iBitdepth)
+{
+  mng_handle hMNG = create_begin ();
+
+  mng_putchunk_mhdr (hMNG, 64, 64, 100, 0, 0, 0, 0);
+  mng_putchunk_fram (hMNG, MNG_FALSE, 1, 0, MNG_NULL, 2, 0, 0, 0, 10, 0,
+                     0, 0, 0, 0, 0, 0, MNG_NULL);
+  mng_putchunk_defi (hMNG, 1, 0, 1, MNG_TRUE, 3, 2, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 48, 40, 6, iBitdepth);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 1, 0);
+                                       /* full-width block-pixel-add */
+  mng_putchunk_dhdr (hMNG, 1, 1, 1, 48, 12, 0, 5);
+  put_block (hMNG, 48, 12, 6, iBitdepth);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 1, 0);
+                                       /* block-pixel-replace */
+  mng_putchunk_dhdr (hMNG, 1, 1, 4, 17, 9, 11, 20);
+  put_block (hMNG, 17, 9, 6, iBitdepth);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 1, 0);
+                                       /* block-pixel-add */
+  mng_putchunk_dhdr (hMNG, 1, 1, 1, 30, 21, 18, 19);
+  put_block (hMNG, 30, 21, 6, iBitdepth);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 1, 0);
+                                       /* full-width block-pixel-replace */
+  mng_putchunk_dhdr (hMNG, 1, 1, 4, 48, 40, 0, 0);
+  put_block (hMNG, 48, 40, 6, iBitdepth);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 1, 0);
+                                       /* the same for a gray object */
+  mng_putchunk_defi (hMNG, 2, 0, 1, MNG_TRUE, 30, 30, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 31, 27, 0, iBitdepth);
+  mng_putchunk_show (hMNG, MNG_FALSE, 2, 2, 0);
+  mng_putchunk_dhdr (hMNG, 2, 1, 1, 31, 10, 0, 3);
+  put_block (hMNG, 31, 10, 0, iBitdepth);
+  mng_putchunk_show (hMNG, MNG_FALSE, 2, 2, 0);
+  mng_putchunk_dhdr (hMNG, 2, 1, 4, 7, 8, 9, 10);
+  put_block (hMNG, 7, 8, 0, iBitdepth);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 2, 0);
+  mng_putchunk_mend (hMNG);
+
+  create_end (hMNG, zName, 0);
+}
+
+/* MAGN with different left/right/top/bottom factors, so the first & last
+   intervals are distinguishable */
+static void gen_magn (const char *zName,
+                      mng_uint16  iMethodX,
+                      mng_uint16  iMethodY,
+                      mng_uint8   iColortype)
+{
+  mng_handle hMNG = create_begin ();
+
+  mng_putchunk_mhdr (hMNG, 100, 90, 100, 0, 0, 0, 0);
+  mng_putchunk_back (hMNG, 0x4040, 0x4040, 0x4040, 1, 0, 0);
+  mng_putchunk_defi (hMNG, 1, 0, 1, MNG_TRUE, 2, 3, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 9, 7, iColortype, 8);
+  mng_putchunk_defi (hMNG, 2, 0, 1, MNG_TRUE, 50, 40, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 6, 5, iColortype, 8);
+  mng_putchunk_magn (hMNG, 1, 1, iMethodX, 3, 4, 2, 5, 1, 6, iMethodY);
+  mng_putchunk_magn (hMNG, 2, 2, iMethodX, 5, 2, 5, 1, 3, 2, iMethodY);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 2, 0);
+  mng_putchunk_mend (hMNG);
+
+  create_end (hMNG, zName, 1);
+}
+
+/* PAST with every composition, orientation & offset-type */
+static void gen_past (const char *zName)
+{
+  mng_handle hMNG = create_begin ();
+  int        iFrame;
+
+  mng_putchunk_mhdr (hMNG, 80, 80, 100, 0, 0, 0, 0);
+  mng_putchunk_fram (hMNG, MNG_FALSE, 1, 0, MNG_NULL, 2, 0, 0, 0, 10, 0,
+                     0, 0, 0, 0, 0, 0, MNG_NULL);
+  mng_putchunk_defi (hMNG, 1, 1, 1, MNG_FALSE, 0, 0, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 23, 17, 6, 8);
+  mng_putchunk_defi (hMNG, 2, 1, 1, MNG_FALSE, 0, 0, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 19, 25, 2, 8);
+  mng_putchunk_defi (hMNG, 3, 1, 1, MNG_FALSE, 0, 0, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 11, 13, 4, 8);
+
+  for (iFrame = 0; iFrame < 5; iFrame++)
+  {
+    mng_putchunk_defi (hMNG, 10, 0, 0, MNG_TRUE, 4, 4, MNG_FALSE, 0, 0, 0, 0);
+    put_image (hMNG, 70, 66, 6, 8);
+    mng_putchunk_past (hMNG, 10, 0, iFrame - 3, 2 * iFrame - 5, 4);
+    mng_putchunk_past_src (hMNG, 0, 1, 0, (mng_uint8)(iFrame * 2), 0,
+                           3, 4, 0, 0, 0, 0, 0);
+    mng_putchunk_past_src (hMNG, 1, 2, 1, (mng_uint8)((iFrame * 2 + 2) % 10), 0,
+                           30, 7, 1, 25, 60, 0, 40);
+    mng_putchunk_past_src (hMNG, 2, 3, 2, (mng_uint8)((iFrame * 2 + 4) % 10), 1,
+                           2, 3, 0, 0, 0, 0, 0);
+    mng_putchunk_past_src (hMNG, 3, 1, (mng_uint8)(iFrame % 3), 0, 0,
+                           -7, 45, 0, 0, 0, 0, 0);
+    mng_putchunk_show (hMNG, MNG_FALSE, 10, 10, 0);
+  }
+
+  mng_putchunk_mend (hMNG);
+  create_end (hMNG, zName, 0);
+}
+
+/* PAST at the edges: destinations left of & above the target that no
+   boundary clips, sources much wider than the pasted area, and tiles whose
+   boundary starts several source heights into the source */
+static void gen_pastclip (const char *zName)
+{
+  mng_handle hMNG = create_begin ();
+  int        iFrame;
+
+  mng_putchunk_mhdr (hMNG, 80, 80, 100, 0, 0, 0, 0);
+  mng_putchunk_fram (hMNG, MNG_FALSE, 1, 0, MNG_NULL, 2, 0, 0, 0, 10, 0,
+                     0, 0, 0, 0, 0, 0, MNG_NULL);
+  mng_putchunk_defi (hMNG, 1, 1, 1, MNG_FALSE, 0, 0, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 41, 13, 2, 8);
+  mng_putchunk_defi (hMNG, 2, 1, 1, MNG_FALSE, 0, 0, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 9, 7, 0, 8);
+  mng_putchunk_defi (hMNG, 3, 1, 1, MNG_FALSE, 0, 0, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 30, 10, 4, 16);
+
+  for (iFrame = 0; iFrame < 4; iFrame++)
+  {
+    mng_putchunk_defi (hMNG, 10, 0, 0, MNG_TRUE, 4, 4, MNG_FALSE, 0, 0, 0, 0);
+    put_image (hMNG, 70, 66, 6, 8);
+    mng_putchunk_past (hMNG, 10, 1, -9, -6, 3);
+    mng_putchunk_past_src (hMNG, 0, 1, (mng_uint8)(iFrame & 1), 0, 0,
+                           iFrame * 22 - 7, iFrame * 13 - 4,
+                           0, -100, 1000, -100, 1000);
+    mng_putchunk_past_src (hMNG, 1, 2, 0, 8, 0, 0, 0,
+                           0, 3, 60, 50 + iFrame * 9, 64);
+    mng_putchunk_past_src (hMNG, 2, 3, 1, (mng_uint8)(iFrame * 2), 1,
+                           -5, 60 - iFrame * 20,
+                           1, -50, 40, -50, 80);
+    mng_putchunk_show (hMNG, MNG_FALSE, 10, 10, 0);
+  }
+
+  mng_putchunk_mend (hMNG);
+  create_end (hMNG, zName, 0);
+}
+
+/* 16-bit images whose gamma changes from frame to frame, with more
+   different values than the library keeps gamma-tables for */
+static void gen_gama (const char *zName)
+{
+  static const mng_uint32 aGamma [] =
+    {100000, 45455, 30000, 100000, 70000, 55000, 45455, 30000, 100000};
+  mng_handle hMNG = create_begin ();
+  mng_uint32 iX;
+
+  mng_putchunk_mhdr (hMNG, 40, 32, 100, 0, 0, 0, 0);
+  mng_putchunk_fram (hMNG, MNG_FALSE, 1, 0, MNG_NULL, 2, 0, 0, 0, 10, 0,
+                     0, 0, 0, 0, 0, 0, MNG_NULL);
+
+  for (iX = 0; iX < sizeof (aGamma) / sizeof (aGamma [0]); iX++)
+  {
+    mng_putchunk_defi (hMNG, 1, 0, 0, MNG_TRUE, (mng_int32)(iX & 3),
+                       (mng_int32)(iX % 3), MNG_FALSE, 0, 0, 0, 0);
+    put_raw_image (hMNG, 36, 29, (mng_uint8)(iX & 1 ? 4 : 6), 16, 0, aGamma [iX]);
+  }
+
+  mng_putchunk_mend (hMNG);
+  create_end (hMNG, zName, 0);
+}
+
+/* LOOP, TERM & relative MOVE */
+static void gen_loop (const char *zName)
+{
+  mng_handle hMNG = create_begin ();
+
+  mng_putchunk_mhdr (hMNG, 60, 40, 100, 0, 0, 0, 0);
+  mng_putchunk_term (hMNG, 3, 0, 20, 2);
+  mng_putchunk_back (hMNG, 0xFFFF, 0, 0, 1, 0, 0);
+  mng_putchunk_fram (hMNG, MNG_FALSE, 3, 0, MNG_NULL, 2, 0, 0, 0, 7, 0,
+                     0, 0, 0, 0, 0, 0, MNG_NULL);
+  mng_putchunk_defi (hMNG, 1, 0, 1, MNG_TRUE, 0, 0, MNG_FALSE, 0, 0, 0, 0);
+  put_image (hMNG, 15, 12, 6, 8);
+  mng_putchunk_loop (hMNG, 0, 4, 0, 0, 0, 0, MNG_NULL);
+  mng_putchunk_move (hMNG, 1, 1, 1, 9, 6);
+  mng_putchunk_show (hMNG, MNG_FALSE, 1, 1, 0);
+  mng_putchunk_endl (hMNG, 0);
+  mng_putchunk_mend (hMNG);
+
+  create_end (hMNG, zName, 0);
+}
+
+/* ************************************************************************** */
+
+static void generate (void)
+{
+  iSeed = 20261017;
+
+  gen_png_raw ("png-g1",       37, 29, 0,  1, 0);
+  gen_png_raw ("png-g2",       37, 29, 0,  2, 0);
+  gen_png_raw ("png-g4",       37, 29, 0,  4, 0);
+  gen_png_raw ("png-g8",       37, 29, 0,  8, 0);
+  gen_png_raw ("png-g16",      37, 29, 0, 16, 0);
+  gen_png_raw ("png-rgb8",     37, 29, 2,  8, 0);
+  gen_png_raw ("png-rgb16",    37, 29, 2, 16, 0);
+  gen_png_raw ("png-i1",       37, 29, 3,  1, 0);
+  gen_png_raw ("png-i2",       37, 29, 3,  2, 0);
+  gen_png_raw ("png-i4",       37, 29, 3,  4, 0);
+  gen_png_raw ("png-i8",       37, 29, 3,  8, 0);
+  gen_png_raw ("png-ga8",      37, 29, 4,  8, 0);
+  gen_png_raw ("png-ga16",     37, 29, 4, 16, 0);
+  gen_png_raw ("png-rgba8",    37, 29, 6,  8, 0);
+  gen_png_raw ("png-rgba16",   37, 29, 6, 16, 0);
+  gen_png_raw ("png-g2-i",     37, 29, 0,  2, 1);
+  gen_png_raw ("png-rgb16-i",  37, 29, 2, 16, 1);
+  gen_png_raw ("png-i4-i",     37, 29, 3,  4, 1);
+  gen_png_raw ("png-rgba8-i",  37, 29, 6,  8, 1);
+  gen_png_raw ("png-wide",    128,  3, 6,  8, 0);
+  gen_png     ("png-put-rgba8", 45, 31, 6,  8);
+  gen_png     ("png-put-idx8",  45, 31, 3,  8);
+  gen_png     ("png-put-ga16",  45, 31, 4, 16);
+  gen_layers  ("mng-layers",   1);
+  gen_layers  ("mng-blend",    0);
+  gen_anim    ("mng-anim");
+  gen_delta   ("mng-delta8",   8);
+  gen_delta   ("mng-delta16", 16);
+  gen_magn    ("mng-magn11", 1, 1, 6);
+  gen_magn    ("mng-magn22", 2, 2, 6);
+  gen_magn    ("mng-magn33", 3, 3, 6);
+  gen_magn    ("mng-magn44", 4, 4, 6);
+  gen_magn    ("mng-magn55", 5, 5, 6);
+  gen_magn    ("mng-magn24", 2, 4, 6);
+  gen_magn    ("mng-magn53", 5, 3, 6);
+  gen_magn    ("mng-magn22g",  2, 2, 0);
+  gen_magn    ("mng-magn45ga", 4, 5, 4);
+  gen_magn    ("mng-magn31rgb", 3, 1, 2);
+  gen_past    ("mng-past");
+  gen_loop    ("mng-loop");
+  gen_png_gama ("png-rgb16-gama",  2, 16, 100000);
+  gen_png_gama ("png-ga16-gama",   4, 16,  30000);
+  gen_png_gama ("png-rgba16-gama", 6, 16,  70000);
+  gen_png_gama ("png-rgba8-gama",  6,  8,  70000);
+  gen_gama     ("mng-gama16");
+  gen_pastclip ("mng-pastclip");
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * rendering                                                              * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#define RENDER_MEMORY   0
+#define RENDER_STREAM   1
+#define RENDER_THREADS  2
+#define RENDER_LAZY     3
+#define RENDER_PUSH     4
+#define RENDER_POOL     5
+
+/* read a stream with suspension-mode on, pushing it in pieces of 1 to 150
+   bytes, one to three of them each time the library runs out of data;
+   every other piece is handed over (bTakeownership), the others copied */
+static mng_retcode read_pushed (mng_handle    hMNG,
+                                const stream *pStream)
+{
+  mng_uint32  iPos   = 0;
+  mng_uint32  iPiece = 0;
+  mng_uint32  iLen, iX;
+  mng_uint8p  pCopy;
+  mng_retcode iRetcode;
+
+  mng_set_suspensionmode (hMNG, MNG_TRUE);
+  mng_setcb_openstream   (hMNG, cb_openstream );
+  mng_setcb_closestream  (hMNG, cb_closestream);
+  mng_setcb_readdata     (hMNG, cb_readnothing);
+
+  iRetcode = mng_read (hMNG);
+
+  while (iRetcode == MNG_NEEDMOREDATA)
+  {
+    if (iPos >= pStream->iLen)         /* wants more than there is */
+      return MNG_UNEXPECTEDEOF;
+
+    for (iX = 0; (iX <= iPiece % 3) && (iPos < pStream->iLen); iX++, iPiece++)
+    {
+      iLen = 1 + (iPiece * 37 + iPos) % 150;
+      if (iLen > pStream->iLen - iPos)
+        iLen = pStream->iLen - iPos;
+
+      if (iPiece & 1)
+      {
+        pCopy = (mng_uint8p)malloc (iLen);
+        memcpy (pCopy, pStream->pData + iPos, iLen);
+        iRetcode = mng_read_pushdata (hMNG, pCopy, iLen, MNG_TRUE);
+      }
+      else
+        iRetcode = mng_read_pushdata (hMNG, pStream->pData + iPos, iLen, MNG_FALSE);
+
+      if (iRetcode)
+        return iRetcode;
+
+      iPos += iLen;
+    }
+
+    iRetcode = mng_read_resume (hMNG);
+  }
+
+  return iRetcode;
+}
+
+/* render one stream in one canvas style; returns the hash of all frames */
+static hashval render (const stream      *pStream,
+                       const canvasstyle *pStyle,
+                       int                bSIMD,
+                       int                iMode,
+                       int               *iFrames)
+{
+  userdata    sUser;
+  mng_handle  hMNG;
+  mng_retcode iRetcode;
+  mng_uint32  iX;
+
+  memset (&sUser, 0, sizeof (sUser));
+  sUser.iHash = 14695981039346656037ULL;
+
+  hMNG = mng_initialize ((mng_ptr)&sUser, cb_alloc, cb_free, MNG_NULL);
+
+  mng_setcb_errorproc     (hMNG, cb_errorproc    );
+  mng_setcb_processheader (hMNG, cb_processheader);
+  mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+  mng_setcb_refresh       (hMNG, cb_refresh      );
+  mng_setcb_gettickcount  (hMNG, cb_gettickcount );
+  mng_setcb_settimer      (hMNG, cb_settimer     );
+  mng_set_canvasstyle     (hMNG, pStyle->iStyle  );
+#ifdef MNG_SUPPORT_SIMD
+  if (!bSIMD)
+    mng_set_simd (hMNG, MNG_SIMD_NONE);
+#endif
+#ifdef MNG_SUPPORT_PARALLEL
+  if (iMode == RENDER_THREADS)
+    mng_set_decodethreads (hMNG, 2);
+#endif
+#ifndef MNG_SKIPCHUNK_MAGN
+  if (iMode == RENDER_LAZY)
+    mng_set_lazymagnify (hMNG, MNG_TRUE);
+#endif
+#ifdef MNG_SUPPORT_MEMPOOL
+  if (iMode == RENDER_POOL)
+    mng_set_mempool (hMNG, MNG_TRUE);
+#endif
+
+  if (iMode == RENDER_STREAM)
+  {
+    sUser.pIn    = pStream->pData;
+    sUser.iInlen = pStream->iLen;
+    mng_setcb_openstream  (hMNG, cb_openstream );
+    mng_setcb_closestream (hMNG, cb_closestream);
+    mng_setcb_readdata    (hMNG, cb_readdata   );
+    iRetcode = mng_read (hMNG);
+  }
+  else
+  if (iMode == RENDER_PUSH)
+    iRetcode = read_pushed (hMNG, pStream);
+  else
+    iRetcode = mng_read_memory (hMNG, pStream->pData, pStream->iLen);
+
+  if (!iRetcode)
+  {                                    /* a canvas that isn't empty, so the
+                                          blending code has something to do */
+    sUser.iWidth     = mng_get_imagewidth  (hMNG);
+    sUser.iHeight    = mng_get_imageheight (hMNG);
+    sUser.iPixelsize = pStyle->iPixelsize;
+    sUser.iRowsize   = sUser.iWidth * sUser.iPixelsize;
+    sUser.pCanvas    = (mng_uint8p)malloc (sUser.iRowsize * sUser.iHeight + 1);
+
+    for (iX = 0; iX < sUser.iRowsize * sUser.iHeight; iX++)
+      sUser.pCanvas [iX] = (mng_uint8)((iX * 37 + (iX / sUser.iRowsize) * 11) & 0xFF);
+
+    iRetcode = mng_render_frames (hMNG, cb_renderframe);
+                                       /* and the final canvas */
+    sUser.iHash = hash_bytes (sUser.iHash, sUser.pCanvas,
+                              sUser.iRowsize * sUser.iHeight);
+    free (sUser.pCanvas);
+  }
+
+#ifdef MNG_SUPPORT_MEMPOOL
+  if (iMode == RENDER_POOL)            /* everything pooled must be back */
+  {
+    mng_reset (hMNG);
+
+    if (mng_get_mempoolcurrent (hMNG))
+      sUser.iHash = hash_uint (sUser.iHash, mng_get_mempoolcurrent (hMNG));
+  }
+#endif
+
+  mng_cleanup (&hMNG);
+
+  if ((iRetcode) && (iRetcode != MNG_NEEDTIMERWAIT))
+    sUser.iHash = hash_uint (sUser.iHash, 0x80000000UL | (mng_uint32)iRetcode);
+
+  *iFrames = sUser.iFrames;
+
+  return sUser.iHash;
+}
+
+/* ************************************************************************** */
+
+static void check_stream (int iStream)
+{
+  const stream *pStream = &aStreams [iStream];
+  hashval iHash, iOther;
+  int     iFrames, iOtherframes, iStyle;
+
+  for (iStyle = 0; iStyle < STYLECOUNT; iStyle++)
+  {
+    const canvasstyle *pStyle = &aStyles [iStyle];
+
+    iHash = render (pStream, pStyle, 1, RENDER_MEMORY, &iFrames);
+
+    aRefhash   [iStream] [iStyle] = iHash;
+    aRefframes [iStream] [iStyle] = iFrames;
+
+    printf ("%-16s %-8s %3d %016llx\n", pStream->zName, pStyle->zName,
+            iFrames, iHash);
+
+#ifdef MNG_SUPPORT_SIMD
+    iOther = render (pStream, pStyle, 0, RENDER_MEMORY, &iOtherframes);
+
+    if ((iOther != iHash) || (iOtherframes != iFrames))
+    {
+      printf ("FAIL %s %s: the portable routines give a different canvas\n",
+              pStream->zName, pStyle->zName);
+      iFailures++;
+    }
+#endif
+
+    if (pStyle->iStyle != MNG_CANVAS_RGBA8)
+      continue;                        /* the rest is the same for each style */
+
+    iOther = render (pStream, pStyle, 1, RENDER_STREAM, &iOtherframes);
+
+    if ((iOther != iHash) || (iOtherframes != iFrames))
+    {
+      printf ("FAIL %s: mng_read gives a different canvas than mng_read_memory\n",
+              pStream->zName);
+      iFailures++;
+    }
+
+    iOther = render (pStream, pStyle, 1, RENDER_PUSH, &iOtherframes);
+
+    if ((iOther != iHash) || (iOtherframes != iFrames))
+    {
+      printf ("FAIL %s: mng_read_pushdata in pieces gives a different canvas\n",
+              pStream->zName);
+      iFailures++;
+    }
+
+#ifdef MNG_SUPPORT_MEMPOOL
+    iOther = render (pStream, pStyle, 1, RENDER_POOL, &iOtherframes);
+
+    if ((iOther != iHash) || (iOtherframes != iFrames))
+    {
+      printf ("FAIL %s: the memory-pool gives a different canvas or keeps blocks\n",
+              pStream->zName);
+      iFailures++;
+    }
+#endif
+
+#ifdef MNG_SUPPORT_PARALLEL
+    iOther = render (pStream, pStyle, 1, RENDER_THREADS, &iOtherframes);
+
+    if ((iOther != iHash) || (iOtherframes != iFrames))
+    {
+      printf ("FAIL %s: decode-threads give a different canvas\n",
+              pStream->zName);
+      iFailures++;
+    }
+#endif
+
+#ifndef MNG_SKIPCHUNK_MAGN
+    if (pStream->bMagn)
+    {
+      iOther = render (pStream, pStyle, 1, RENDER_LAZY, &iOtherframes);
+
+      if ((iOther != iHash) || (iOtherframes != iFrames))
+      {
+        printf ("FAIL %s: lazy magnification gives a different canvas\n",
+                pStream->zName);
+        iFailures++;
+      }
+    }
+#endif
+  }
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * 16-bit gamma: every sample value through the gamma-table, compared     * */
+/* * with the formula                                                       * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+/* a 256x256 gray 16-bit PNG holding each value once, with the given gAMA;
+   on a 16-bit canvas every sample must be pow (v, 1 / (gamma * 2.2)) (the
+   default view & display gamma), rounded, and the high byte of that on an
+   8-bit canvas */
+static void check_gamma16 (mng_uint32 iGamma)
+{
+  static mng_uint8 aRaw [256 * 513];
+  static mng_uint8 aZip [256 * 513 + 1024];
+  uLongf      iZiplen = sizeof (aZip);
+  mng_handle  hMNG;
+  mng_retcode iRetcode;
+  userdata    sUser;
+  double      dExp = 1.0 / ((double)iGamma / 100000 * 2.2);
+  mng_uint32  iX, iY, iV, iExp, iGot, iBad16 = 0, iBad8 = 0;
+  int         b16;
+
+  for (iY = 0; iY < 256; iY++)
+  {
+    aRaw [iY * 513] = 0;               /* filter-type none */
+
+    for (iX = 0; iX < 256; iX++)
+    {
+      aRaw [iY * 513 + 1 + iX * 2    ] = (mng_uint8)iY;
+      aRaw [iY * 513 + 1 + iX * 2 + 1] = (mng_uint8)iX;
+    }
+  }
+
+  compress2 (aZip, &iZiplen, aRaw, sizeof (aRaw), 6);
+
+  hMNG = create_begin ();
+  mng_putchunk_ihdr (hMNG, 256, 256, 16, 0, 0, 0, 0);
+  mng_putchunk_gama (hMNG, MNG_FALSE, iGamma);
+  mng_putchunk_idat (hMNG, (mng_uint32)iZiplen, aZip);
+  mng_putchunk_iend (hMNG);
+  mng_write (hMNG);
+  mng_cleanup (&hMNG);
+
+  for (b16 = 0; b16 < 2; b16++)
+  {
+    memset (&sUser, 0, sizeof (sUser));
+    sUser.iRowsize = 256 * (b16 ? 6 : 3);
+    sUser.pCanvas  = (mng_uint8p)calloc (256, sUser.iRowsize);
+
+    hMNG = mng_initialize ((mng_ptr)&sUser, cb_alloc, cb_free, MNG_NULL);
+    mng_setcb_errorproc     (hMNG, cb_errorproc    );
+    mng_setcb_processheader (hMNG, cb_processheader);
+    mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+    mng_setcb_refresh       (hMNG, cb_refresh      );
+    mng_setcb_gettickcount  (hMNG, cb_gettickcount );
+    mng_setcb_settimer      (hMNG, cb_settimer     );
+    mng_set_canvasstyle     (hMNG, (b16 ? MNG_CANVAS_RGB16 : MNG_CANVAS_RGB8));
+
+    iRetcode = mng_read_memory (hMNG, sWriter.pOut, sWriter.iOutlen);
+    if (!iRetcode)                     /* the image is in after the first */
+      iRetcode = mng_display (hMNG);   /* (timer) break */
+
+    if ((iRetcode) && (iRetcode != MNG_NEEDTIMERWAIT))
+      iBad16 = iBad8 = 65536;
+    else
+    for (iV = 0; iV < 65536; iV++)
+    {
+      iExp = (mng_uint32)(pow (iV / 65535.0, dExp) * 65535 + 0.5);
+
+      if (b16)
+      {
+        iGot = ((mng_uint32)sUser.pCanvas [iV * 6] << 8) | sUser.pCanvas [iV * 6 + 1];
+        if ((iGot != iExp) || (memcmp (sUser.pCanvas + iV * 6, sUser.pCanvas + iV * 6 + 2, 2)) ||
+                              (memcmp (sUser.pCanvas + iV * 6, sUser.pCanvas + iV * 6 + 4, 2))   )
+          iBad16++;
+      }
+      else
+      {
+        iGot = sUser.pCanvas [iV * 3];
+        if ((iGot != (iExp >> 8)) || (sUser.pCanvas [iV * 3 + 1] != iGot) ||
+                                     (sUser.pCanvas [iV * 3 + 2] != iGot)   )
+          iBad8++;
+      }
+    }
+
+    mng_cleanup (&hMNG);
+    free (sUser.pCanvas);
+  }
+
+  free (sWriter.pOut);
+
+  if ((iBad16) || (iBad8))
+  {
+    printf ("FAIL gamma16 %u: %u (rgb16) & %u (rgb8) samples not as calculated\n",
+            iGamma, iBad16, iBad8);
+    iFailures++;
+  }
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * transform-cache (full cms only): the same MNG rendered with the cache  * */
+/* * off, with room for a single transform & with the default size          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifdef MNG_FULL_CMS
+/* the color-chunks of each image: sRGB perceptual (0), sRGB relative (1),
+   cHRM & gAMA (2); in 8- & 16-bit, so the layout is part of the key too */
+typedef struct {
+          mng_uint8   iKind;
+          mng_uint8   iBitdepth;
+        } cmsimage;
+
+static const cmsimage aCmsimages [] =
+  {{0, 8}, {1, 8}, {2, 8}, {0, 16}, {0, 8}, {1, 8}, {2, 8}, {0, 16}, {0, 8}, {0, 8}};
+
+#define CMSIMAGES  (sizeof (aCmsimages) / sizeof (aCmsimages [0]))
+#define CMSKEYS    4                   /* different ones in aCmsimages */
+
+static void put_cms_image (mng_handle      hMNG,
+                           const cmsimage *pImage)
+{
+  static mng_uint8 aRaw [29 * (1 + 36 * 8)];
+  static mng_uint8 aZip [29 * (1 + 36 * 8) + 1024];
+  uLongf     iZiplen   = sizeof (aZip);
+  mng_uint32 iRowbytes = 36 * pImage->iBitdepth / 2;
+  mng_uint32 iY, iX;
+
+  mng_putchunk_ihdr (hMNG, 36, 29, pImage->iBitdepth, 6, 0, 0, 0);
+
+  if (pImage->iKind == 2)
+  {
+    mng_putchunk_chrm (hMNG, MNG_FALSE, 31270, 32900, 64000, 33000,
+                       30000, 60000, 15000, 6000);
+    mng_putchunk_gama (hMNG, MNG_FALSE, 45455);
+  }
+  else
+    mng_putchunk_srgb (hMNG, MNG_FALSE, pImage->iKind);
+
+  for (iY = 0; iY < 29; iY++)
+  {
+    aRaw [iY * (1 + iRowbytes)] = 0;   /* filter-type none */
+
+    for (iX = 0; iX < iRowbytes; iX++)
+      aRaw [iY * (1 + iRowbytes) + 1 + iX] = (mng_uint8)rnd (256);
+  }
+
+  compress2 (aZip, &iZiplen, aRaw, 29 * (1 + iRowbytes), 6);
+  mng_putchunk_idat (hMNG, (mng_uint32)iZiplen, aZip);
+  mng_putchunk_iend (hMNG);
+}
+
+/* every rendering must give the same frames, whatever the cache holds; with
+   a single entry only the last image repeats its predecessor, and with the
+   default size every key misses just once */
+static void check_cmscache (void)
+{
+  static const mng_uint32 aSize   [3] = {0, 1, MNG_CMSCACHESIZE};
+  static const mng_uint32 aMisses [3] = {0, CMSIMAGES - 1, CMSKEYS};
+  mng_handle  hMNG;
+  mng_retcode iRetcode;
+  userdata    sUser;
+  hashval     iFirst = 0;
+  mng_uint32  iX, iHits, iMisses;
+
+  hMNG = create_begin ();
+  mng_putchunk_mhdr (hMNG, 40, 32, 100, 0, 0, 0, 0);
+  mng_putchunk_fram (hMNG, MNG_FALSE, 1, 0, MNG_NULL, 2, 0, 0, 0, 10, 0,
+                     0, 0, 0, 0, 0, 0, MNG_NULL);
+
+  for (iX = 0; iX < CMSIMAGES; iX++)
+  {
+    mng_putchunk_defi (hMNG, 1, 0, 0, MNG_TRUE, (mng_int32)(iX & 3),
+                       (mng_int32)(iX % 3), MNG_FALSE, 0, 0, 0, 0);
+    put_cms_image (hMNG, &aCmsimages [iX]);
+  }
+
+  mng_putchunk_mend (hMNG);
+  mng_write (hMNG);
+  mng_cleanup (&hMNG);
+
+  for (iX = 0; iX < 3; iX++)
+  {
+    memset (&sUser, 0, sizeof (sUser));
+    sUser.iHash = 14695981039346656037ULL;
+
+    hMNG = mng_initialize ((mng_ptr)&sUser, cb_alloc, cb_free, MNG_NULL);
+    mng_setcb_errorproc     (hMNG, cb_errorproc    );
+    mng_setcb_processheader (hMNG, cb_processheader);
+    mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+    mng_setcb_refresh       (hMNG, cb_refresh      );
+    mng_setcb_gettickcount  (hMNG, cb_gettickcount );
+    mng_setcb_settimer      (hMNG, cb_settimer     );
+    mng_set_canvasstyle     (hMNG, MNG_CANVAS_RGBA8);
+    mng_set_srgb            (hMNG, MNG_FALSE);  /* or sRGB isn't converted */
+    mng_set_outputsrgb      (hMNG);
+    mng_set_cmscache        (hMNG, aSize [iX]);
+
+    iRetcode = mng_read_memory (hMNG, sWriter.pOut, sWriter.iOutlen);
+
+    if (!iRetcode)
+    {
+      sUser.iWidth     = mng_get_imagewidth  (hMNG);
+      sUser.iHeight    = mng_get_imageheight (hMNG);
+      sUser.iPixelsize = 4;
+      sUser.iRowsize   = sUser.iWidth * 4;
+      sUser.pCanvas    = (mng_uint8p)calloc (sUser.iHeight, sUser.iRowsize);
+
+      iRetcode = mng_render_frames (hMNG, cb_renderframe);
+
+      free (sUser.pCanvas);
+    }
+
+    iHits   = mng_get_cmscachehits   (hMNG);
+    iMisses = mng_get_cmscachemisses (hMNG);
+
+    mng_cleanup (&hMNG);
+
+    if (!iX)
+      iFirst = sUser.iHash;
+
+    if (((iRetcode) && (iRetcode != MNG_NEEDTIMERWAIT)) ||
+        (sUser.iFrames != (int)CMSIMAGES) || (sUser.iHash != iFirst))
+    {
+      printf ("FAIL cmscache %u: the frames differ from those without the cache\n",
+              aSize [iX]);
+      iFailures++;
+    }
+
+    if ((iMisses != aMisses [iX]) ||
+        (iHits != (aSize [iX] ? CMSIMAGES - aMisses [iX] : 0)))
+    {
+      printf ("FAIL cmscache %u: %u hits & %u misses\n", aSize [iX], iHits, iMisses);
+      iFailures++;
+    }
+  }
+
+  free (sWriter.pOut);
+}
+#endif /* MNG_FULL_CMS */
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * dirty-rectangles: every changed pixel must be in a reported rectangle  * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+/* compares the canvas with the copy taken at the previous refresh; each
+   changed pixel must lie in one of the published dirty-rectangles, and
+   each of those within the refresh region */
+static mng_bool MNG_DECL cb_dirtyrefresh (mng_handle hMNG,
+                                          mng_uint32 iX,
+                                          mng_uint32 iY,
+                                          mng_uint32 iWidth,
+                                          mng_uint32 iHeight)
+{
+  userdata  *pUser  = (userdata *)mng_get_userdata (hMNG);
+  mng_uint32 iCount = mng_get_dirtyrectcount (hMNG);
+  mng_uint32 aL [MNG_DIRTYRECTS], aT [MNG_DIRTYRECTS];
+  mng_uint32 aW [MNG_DIRTYRECTS], aH [MNG_DIRTYRECTS];
+  mng_uint32 iR, iRow, iCol, iOfs;
+
+  if (iCount > MNG_DIRTYRECTS)
+    iCount = MNG_DIRTYRECTS;
+
+  for (iR = 0; iR < iCount; iR++)
+  {
+    mng_get_dirtyrect (hMNG, iR, &aL [iR], &aT [iR], &aW [iR], &aH [iR]);
+
+    if ((aL [iR] < iX) || (aT [iR] < iY) ||
+        (aL [iR] + aW [iR] > iX + iWidth) || (aT [iR] + aH [iR] > iY + iHeight))
+      pUser->iStray++;
+  }
+
+  for (iRow = 0; iRow < pUser->iHeight; iRow++)
+    for (iCol = 0; iCol < pUser->iWidth; iCol++)
+    {
+      iOfs = iRow * pUser->iRowsize + iCol * pUser->iPixelsize;
+
+      if (memcmp (pUser->pCanvas + iOfs, pUser->pShadow + iOfs, pUser->iPixelsize))
+      {
+        for (iR = 0; iR < iCount; iR++)
+          if ((iCol >= aL [iR]) && (iCol < aL [iR] + aW [iR]) &&
+              (iRow >= aT [iR]) && (iRow < aT [iR] + aH [iR]))
+            break;
+
+        if (iR >= iCount)
+          pUser->iMissed++;
+      }
+    }
+
+  memcpy (pUser->pShadow, pUser->pCanvas, pUser->iRowsize * pUser->iHeight);
+
+  return MNG_TRUE;
+}
+
+static void check_dirtyrects (int iStream)
+{
+  const stream *pStream = &aStreams [iStream];
+  userdata      sUser;
+  mng_handle    hMNG;
+  mng_retcode   iRetcode;
+  mng_uint32    iX, iSize;
+
+  memset (&sUser, 0, sizeof (sUser));
+
+  hMNG = mng_initialize ((mng_ptr)&sUser, cb_alloc, cb_free, MNG_NULL);
+
+  mng_setcb_errorproc     (hMNG, cb_errorproc    );
+  mng_setcb_processheader (hMNG, cb_processheader);
+  mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+  mng_setcb_refresh       (hMNG, cb_dirtyrefresh );
+  mng_setcb_gettickcount  (hMNG, cb_gettickcount );
+  mng_setcb_settimer      (hMNG, cb_settimer     );
+  mng_set_canvasstyle     (hMNG, MNG_CANVAS_RGBA8);
+
+  iRetcode = mng_read_memory (hMNG, pStream->pData, pStream->iLen);
+
+  if (!iRetcode)
+  {                                    /* the same patterned canvas as render */
+    sUser.iWidth     = mng_get_imagewidth  (hMNG);
+    sUser.iHeight    = mng_get_imageheight (hMNG);
+    sUser.iPixelsize = 4;
+    sUser.iRowsize   = sUser.iWidth * 4;
+    iSize            = sUser.iRowsize * sUser.iHeight;
+    sUser.pCanvas    = (mng_uint8p)malloc (iSize + 1);
+    sUser.pShadow    = (mng_uint8p)malloc (iSize + 1);
+
+    for (iX = 0; iX < iSize; iX++)
+      sUser.pCanvas [iX] = (mng_uint8)((iX * 37 + (iX / sUser.iRowsize) * 11) & 0xFF);
+
+    memcpy (sUser.pShadow, sUser.pCanvas, iSize);
+
+    iRetcode = mng_render_frames (hMNG, cb_renderframe);
+                                       /* nothing may change unrefreshed */
+    if (memcmp (sUser.pShadow, sUser.pCanvas, iSize))
+      sUser.iMissed++;
+
+    free (sUser.pShadow);
+    free (sUser.pCanvas);
+  }
+
+  mng_cleanup (&hMNG);
+
+  if ((iRetcode) && (iRetcode != MNG_NEEDTIMERWAIT))
+  {
+    printf ("FAIL %s: rendering with dirty-rectangles returns %d\n",
+            pStream->zName, (int)iRetcode);
+    iFailures++;
+  }
+  else
+  if ((sUser.iMissed) || (sUser.iStray))
+  {
+    printf ("FAIL %s: %u changed pixels outside the dirty-rectangles, "
+            "%u rectangles outside the refresh\n",
+            pStream->zName, sUser.iMissed, sUser.iStray);
+    iFailures++;
+  }
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * getimgdata: the raw image-data against the rendered canvas             * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+/* a PNG rendered in RGBA8 onto a transparent canvas, without gamma-
+   correction (view & display gamma 1.0, image gamma 1.0 unless the stream
+   has gAMA), must give the same pixels as mng_getimgdata_seq gives for its
+   one image; streams with gAMA are corrected anyway, so they're skipped */
+static void check_getimgdata (int iStream)
+{
+  const stream *pStream = &aStreams [iStream];
+  userdata      sUser, sRaw;
+  mng_handle    hMNG;
+  mng_retcode   iRetcode;
+  mng_uint32    iX, iSize, iBad = 0;
+
+  if ((pStream->iLen < 8) || (pStream->pData [1] != 'P'))
+    return;                            /* single PNGs only */
+
+  for (iX = 12; iX + 4 <= pStream->iLen; iX++)
+    if (!memcmp (pStream->pData + iX, "gAMA", 4))
+      return;                          /* always corrected; see above */
+
+  memset (&sUser, 0, sizeof (sUser));
+  memset (&sRaw,  0, sizeof (sRaw ));
+
+  hMNG = mng_initialize ((mng_ptr)&sUser, cb_alloc, cb_free, MNG_NULL);
+
+  mng_setcb_errorproc     (hMNG, cb_errorproc    );
+  mng_setcb_processheader (hMNG, cb_processheader);
+  mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+  mng_setcb_refresh       (hMNG, cb_refresh      );
+  mng_setcb_gettickcount  (hMNG, cb_gettickcount );
+  mng_setcb_settimer      (hMNG, cb_settimer     );
+  mng_set_canvasstyle     (hMNG, MNG_CANVAS_RGBA8);
+  mng_set_storechunks     (hMNG, MNG_TRUE        );
+  mng_set_viewgamma       (hMNG, 1.0             );
+  mng_set_displaygamma    (hMNG, 1.0             );
+  mng_set_dfltimggamma    (hMNG, 1.0             );
+
+  iRetcode = mng_read_memory (hMNG, pStream->pData, pStream->iLen);
+
+  if (!iRetcode)
+  {
+    sUser.iWidth     = mng_get_imagewidth  (hMNG);
+    sUser.iHeight    = mng_get_imageheight (hMNG);
+    sUser.iPixelsize = 4;
+    sUser.iRowsize   = sUser.iWidth * 4;
+    iSize            = sUser.iRowsize * sUser.iHeight;
+    sUser.pCanvas    = (mng_uint8p)calloc (1, iSize + 1);
+    sRaw             = sUser;
+    sRaw.pCanvas     = (mng_uint8p)calloc (1, iSize + 1);
+
+    iRetcode = mng_render_frames (hMNG, cb_renderframe);
+
+    if ((!iRetcode) || (iRetcode == MNG_NEEDTIMERWAIT))
+    {                                  /* the callback finds its canvas
+                                          through the userdata */
+      mng_set_userdata (hMNG, (mng_ptr)&sRaw);
+      iRetcode = mng_getimgdata_seq (hMNG, 0, MNG_CANVAS_RGBA8, cb_getcanvasline);
+      mng_set_userdata (hMNG, (mng_ptr)&sUser);
+    }
+
+    if (!iRetcode)                     /* the display leaves fully
+                                          transparent pixels alone */
+      for (iX = 0; iX < iSize; iX += 4)
+        if ((sRaw.pCanvas [iX+3]) || (sUser.pCanvas [iX+3]))
+          if (memcmp (sRaw.pCanvas + iX, sUser.pCanvas + iX, 4))
+            iBad++;
+
+    free (sRaw.pCanvas);
+    free (sUser.pCanvas);
+  }
+
+  mng_cleanup (&hMNG);
+
+  if (iRetcode)
+  {
+    printf ("FAIL %s: mng_getimgdata_seq returns %d\n", pStream->zName, (int)iRetcode);
+    iFailures++;
+  }
+  else
+  if (iBad)
+  {
+    printf ("FAIL %s: mng_getimgdata_seq differs from the canvas in %u samples\n",
+            pStream->zName, iBad);
+    iFailures++;
+  }
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * seeking: goframe, golayer & gotime with & without the keyframe-cache   * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#define SEEK_FRAME  0
+#define SEEK_LAYER  1
+#define SEEK_TIME   2
+
+typedef struct {
+          int        iKind;
+          mng_uint32 iPercent;         /* of the total frames, layers or time */
+        } seekstep;
+
+/* each seek goes back from where the previous one (& its two frames) left
+   off, so it is a replay from the start without the cache and from a
+   snapshot with it; the same frame twice and beyond the end; and at last
+   forwards, where the cache skips ahead to a snapshot (by layer, since not
+   every stream has frames) */
+static const seekstep aSeeks [] =
+  {
+    {SEEK_FRAME, 85}, {SEEK_TIME,  70}, {SEEK_LAYER, 60}, {SEEK_FRAME, 50},
+    {SEEK_FRAME, 50}, {SEEK_TIME,  40}, {SEEK_LAYER, 30}, {SEEK_FRAME, 20},
+    {SEEK_FRAME,  1}, {SEEK_FRAME,150}, {SEEK_LAYER, 85},
+  };
+
+#define SEEKCOUNT  (int)(sizeof (aSeeks) / sizeof (aSeeks [0]))
+#define FAULTSTEP  2                   /* gets the failures; back in any stream */
+
+static mng_retcode go (mng_handle      hMNG,
+                       const seekstep *pSeek)
+{
+  mng_uint32 iTotal;
+
+  switch (pSeek->iKind)
+  {
+    case SEEK_FRAME : { iTotal = mng_get_totalframes    (hMNG); break; }
+    case SEEK_LAYER : { iTotal = mng_get_totallayers    (hMNG); break; }
+    default         : { iTotal = mng_get_totalplaytime  (hMNG); break; }
+  }
+
+  iTotal = iTotal * pSeek->iPercent / 100 + (pSeek->iPercent > 100 ? 1 : 0);
+  if (!iTotal)
+    iTotal = 1;
+
+  switch (pSeek->iKind)
+  {
+    case SEEK_FRAME : return mng_display_goframe (hMNG, iTotal);
+    case SEEK_LAYER : return mng_display_golayer (hMNG, iTotal);
+    default         : return mng_display_gotime  (hMNG, iTotal);
+  }
+}
+
+/* play the stream through once in RGBA8, which fills the cache, then do
+   the seeks iFirst upto iLast and render the two frames after each; the
+   hash of the canvas after each seek & its frames goes to aHash; the count
+   & size of the snapshots at the end go to iCount & iMemory; with iFault
+   the iFault'th allocation of seek FAULTSTEP fails, after which that seek
+   is repeated (bFaulted tells if there was such an allocation) */
+static void seek (const stream *pStream,
+                  mng_uint32    iInterval,
+                  mng_uint32    iMaxmemory,
+                  int           iFirst,
+                  int           iLast,
+                  mng_uint32    iFault,
+                  hashval      *aHash,
+                  mng_uint32   *iCount,
+                  mng_uint32   *iMemory,
+                  int          *bFaulted)
+{
+  userdata    sUser;
+  mng_handle  hMNG;
+  mng_retcode iRetcode;
+  hashval     iHash;
+  mng_uint32  iX;
+  int         iStep;
+
+  memset (&sUser, 0, sizeof (sUser));
+  *bFaulted = 0;
+
+  for (iStep = iFirst; iStep < iLast; iStep++)
+    aHash [iStep] = 0;                 /* (seeks that weren't reached) */
+
+  hMNG = mng_initialize ((mng_ptr)&sUser, cb_failalloc, cb_free, MNG_NULL);
+
+  mng_setcb_errorproc     (hMNG, cb_errorproc    );
+  mng_setcb_processheader (hMNG, cb_processheader);
+  mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+  mng_setcb_refresh       (hMNG, cb_refresh      );
+  mng_setcb_gettickcount  (hMNG, cb_gettickcount );
+  mng_setcb_settimer      (hMNG, cb_settimer     );
+  mng_set_canvasstyle     (hMNG, MNG_CANVAS_RGBA8);
+  mng_set_keyframecache   (hMNG, iInterval, iMaxmemory);
+
+  iRetcode = mng_read_memory (hMNG, pStream->pData, pStream->iLen);
+
+  if (!iRetcode)
+  {
+    sUser.iWidth     = mng_get_imagewidth  (hMNG);
+    sUser.iHeight    = mng_get_imageheight (hMNG);
+    sUser.iPixelsize = 4;
+    sUser.iRowsize   = sUser.iWidth * 4;
+    sUser.pCanvas    = (mng_uint8p)malloc (sUser.iRowsize * sUser.iHeight + 1);
+
+    for (iX = 0; iX < sUser.iRowsize * sUser.iHeight; iX++)
+      sUser.pCanvas [iX] = (mng_uint8)((iX * 37 + (iX / sUser.iRowsize) * 11) & 0xFF);
+
+    iRetcode = mng_render_frames (hMNG, cb_renderframe);
+
+    for (iStep = iFirst; iStep < iLast; iStep++)
+    {                                  /* stopped halfway ? */
+      if (iRetcode == MNG_NEEDTIMERWAIT)
+        iRetcode = mng_display_freeze (hMNG);
+
+      if (iRetcode)
+        break;
+
+      if ((iStep == FAULTSTEP) && (iFault))
+      {
+        iAllocs  = 0;
+        iFailat  = iFault;
+        iRetcode = go (hMNG, &aSeeks [iStep]);
+        iFailat  = 0;
+
+        *bFaulted = (iAllocs >= iFault);
+
+        if (iRetcode)                  /* must still be the same handle */
+          iRetcode = go (hMNG, &aSeeks [iStep]);
+      }
+      else
+        iRetcode = go (hMNG, &aSeeks [iStep]);
+                                       /* eg. beyond the end */
+      iHash       = hash_uint  (14695981039346656037ULL, (mng_uint32)iRetcode);
+      iHash       = hash_bytes (iHash, sUser.pCanvas, sUser.iRowsize * sUser.iHeight);
+      sUser.iStop = sUser.iFrames + 2;
+      iRetcode    = mng_render_frames (hMNG, cb_renderframe);
+      iHash       = hash_bytes (iHash, sUser.pCanvas, sUser.iRowsize * sUser.iHeight);
+
+      if ((iRetcode) && (iRetcode != MNG_NEEDTIMERWAIT))
+        iHash = hash_uint (iHash, 0x80000000UL | (mng_uint32)iRetcode);
+
+      aHash [iStep] = iHash;
+    }
+
+    free (sUser.pCanvas);
+  }
+
+  *iCount  = mng_get_keyframecount  (hMNG);
+  *iMemory = mng_get_keyframememory (hMNG);
+
+  mng_cleanup (&hMNG);
+}
+
+/* report the first seek that gives a different canvas than aRef */
+static int seek_differs (const stream  *pStream,
+                         const hashval *aRef,
+                         const hashval *aHash,
+                         int            iLast,
+                         const char    *zHow)
+{
+  int iStep;
+
+  for (iStep = 0; iStep < iLast; iStep++)
+    if (aHash [iStep] != aRef [iStep])
+    {
+      printf ("FAIL %s: seek %d gives a different canvas %s\n",
+              pStream->zName, iStep + 1, zHow);
+      iFailures++;
+      return 1;
+    }
+
+  return 0;
+}
+
+/* the series of seeks without the cache is the reference; it must give
+   the same with a snapshot of every frame, with so little memory for them
+   that the cache gets thinned, and after a failing allocation in the
+   middle of a seek that is then repeated; the last one, forwards, goes
+   back from the end without the cache instead, and it only counts with
+   more than a few snapshots: otherwise there may be none to skip ahead to,
+   and a plain search onwards doesn't redraw the canvas as a replay does */
+static void check_seek (int iStream)
+{
+  const stream *pStream = &aStreams [iStream];
+  hashval    aRef [SEEKCOUNT], aHash [SEEKCOUNT];
+  mng_uint32 iCount, iMemory, iTightcount, iTightmemory, iLimit, iFault;
+  int        bFaulted, iLast;
+
+  if ((pStream->iLen < 8) || (pStream->pData [1] != 'M'))
+    return;                            /* animations only */
+
+  seek (pStream, 0, 0, 0, SEEKCOUNT, 0, aRef, &iCount, &iMemory, &bFaulted);
+  seek (pStream, 0, 0, SEEKCOUNT - 1, SEEKCOUNT, 0, aRef, &iCount, &iMemory, &bFaulted);
+
+  seek (pStream, 1, 0, 0, SEEKCOUNT, 0, aHash, &iCount, &iMemory, &bFaulted);
+
+  iLast = (iCount > 3 ? SEEKCOUNT : SEEKCOUNT - 1);
+  seek_differs (pStream, aRef, aHash, iLast, "with the keyframe-cache");
+
+  if (iCount > 3)                      /* room for about three */
+  {
+    iLimit = iMemory / iCount * 3;
+
+    seek (pStream, 1, iLimit, 0, SEEKCOUNT, 0, aHash,
+          &iTightcount, &iTightmemory, &bFaulted);
+    seek_differs (pStream, aRef, aHash, iLast, "with a thinned keyframe-cache");
+
+    if ((iTightmemory > iLimit) || (iTightcount >= iCount))
+    {
+      printf ("FAIL %s: the keyframe-cache holds %u bytes in %u snapshots, the limit is %u\n",
+              pStream->zName, iTightmemory, iTightcount, iLimit);
+      iFailures++;
+    }
+  }
+
+  for (iFault = 1, bFaulted = 1; (bFaulted) && (iFault < 10000); iFault++)
+  {
+    seek (pStream, 1, 0, 0, SEEKCOUNT, iFault, aHash, &iTightcount, &iTightmemory, &bFaulted);
+
+    if (seek_differs (pStream, aRef, aHash, iLast, "after a failed allocation"))
+      break;
+  }
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * stress-run: the same renderings on many threads at once                * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+/* each thread does every stream & style, starting at a different one, so
+   different streams are decoded at the same time; odd threads use the
+   decode-workers as well */
+static void *stress_worker (void *pArg)
+{
+  int iThread = (int)(size_t)pArg;
+  int iCount  = iStreamcount * STYLECOUNT;
+  int iX, iStream, iStyle, iFrames, iMode;
+
+  iMode = RENDER_MEMORY;
+#ifdef MNG_SUPPORT_PARALLEL
+  if (iThread & 1)
+    iMode = RENDER_THREADS;
+#endif
+
+  for (iX = 0; iX < iCount; iX++)
+  {
+    int     iPair = (iX + iThread * iCount / iThreads) % iCount;
+    hashval iHash;
+
+    iStream = iPair / STYLECOUNT;
+    iStyle  = iPair % STYLECOUNT;
+    iHash   = render (&aStreams [iStream], &aStyles [iStyle], 1, iMode, &iFrames);
+
+    if ((iHash != aRefhash [iStream] [iStyle]) ||
+        (iFrames != aRefframes [iStream] [iStyle]))
+    {
+      pthread_mutex_lock (&hFailmutex);
+      printf ("FAIL %s %s: thread %d gives a different canvas\n",
+              aStreams [iStream].zName, aStyles [iStyle].zName, iThread);
+      iFailures++;
+      pthread_mutex_unlock (&hFailmutex);
+    }
+  }
+
+  return NULL;
+}
+
+static void stress (void)
+{
+  pthread_t aThreads [MAXTHREADS];
+  int       iX;
+
+  for (iX = 0; iX < iThreads; iX++)
+    pthread_create (&aThreads [iX], NULL, stress_worker, (void *)(size_t)iX);
+
+  for (iX = 0; iX < iThreads; iX++)
+    pthread_join (aThreads [iX], NULL);
+}
+
+/* ************************************************************************** */
+
+static int add_file (const char *zFilename)
+{
+  FILE       *hFile = fopen (zFilename, "rb");
+  const char *zBase = strrchr (zFilename, '/');
+  long        iLen;
+
+  if (!hFile)
+  {
+    fprintf (stderr, "mngcheck: can't open %s\n", zFilename);
+    return 1;
+  }
+
+  fseek (hFile, 0, SEEK_END);
+  iLen = ftell (hFile);
+  fseek (hFile, 0, SEEK_SET);
+
+  aStreams [iStreamcount].zName = (zBase ? zBase + 1 : zFilename);
+  aStreams [iStreamcount].pData = (mng_uint8p)malloc (iLen);
+  aStreams [iStreamcount].iLen  = (mng_uint32)fread (aStreams [iStreamcount].pData,
+                                                     1, iLen, hFile);
+  aStreams [iStreamcount].bMagn = 0;
+  iStreamcount++;
+
+  fclose (hFile);
+
+  return 0;
+}
+
+/* ************************************************************************** */
+
+/* the generated streams as files, for mngref; their names go to stdout in
+   the order mngcheck checks them */
+static int write_streams (const char *zDir)
+{
+  char  zFilename [1024];
+  FILE *hFile;
+  int   iX;
+
+  for (iX = iFiles; iX < iStreamcount; iX++)
+  {
+    snprintf (zFilename, sizeof (zFilename), "%s/%s", zDir, aStreams [iX].zName);
+
+    hFile = fopen (zFilename, "wb");
+
+    if ((!hFile) ||
+        (fwrite (aStreams [iX].pData, 1, aStreams [iX].iLen, hFile) != aStreams [iX].iLen))
+    {
+      fprintf (stderr, "mngcheck: can't write %s\n", zFilename);
+      return 2;
+    }
+
+    fclose (hFile);
+    printf ("%s\n", zFilename);
+  }
+
+  return 0;
+}
+
+/* ************************************************************************** */
+
+int main (int argc, char *argv[])
+{
+  const char *zWritedir = MNG_NULL;
+  int         iArg, iX;
+
+  for (iArg = 1; iArg < argc; iArg++)
+  {
+    if ((!strcmp (argv [iArg], "-w")) && (iArg + 1 < argc))
+      zWritedir = argv [++iArg];
+    else
+    if ((!strcmp (argv [iArg], "-j")) && (iArg + 1 < argc))
+    {
+      iThreads = atoi (argv [++iArg]);
+      if ((iThreads < 1) || (iThreads > MAXTHREADS))
+        return 2;
+    }
+    else
+    if ((iStreamcount >= MAXSTREAMS / 2) || (add_file (argv [iArg])))
+      return 2;
+  }
+
+  iFiles = iStreamcount;
+  generate ();
+
+  if (zWritedir)
+    return write_streams (zWritedir);
+
+  for (iX = 0; iX < iStreamcount; iX++)
+    check_stream (iX);
+
+  for (iX = 0; iX < iStreamcount; iX++)
+    check_seek (iX);
+
+  for (iX = 0; iX < iStreamcount; iX++)
+    check_dirtyrects (iX);
+
+  for (iX = 0; iX < iStreamcount; iX++)
+    check_getimgdata (iX);
+
+  check_gamma16 (100000);
+  check_gamma16 ( 45455);
+  check_gamma16 ( 30000);
+
+#ifdef MNG_FULL_CMS
+  check_cmscache ();
+#endif
+
+  if (iThreads)
+    stress ();
+
+  for (iX = 0; iX < iStreamcount; iX++)
+    free (aStreams [iX].pData);
+
+  if (iFailures)
+    fprintf (stderr, "mngcheck: %d failure(s)\n", iFailures);
+
+  return (iFailures ? 1 : 0);
+}
+
+/* ************************************************************************** */
+/* * end of file                                                            * */
+/* ************************************************************************** */
@@ -0,0 +1,350 @@
+/* ************************************************************************** */
+/* *             For conditions of distribution and use,                    * */
+/* *                see copyright notice in libmng.h                        * */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * project   : mngcheck                                                   * */
+/* * file      : mngref.c                                                   * */
+/* * version   : 1.0.11                                                     * */
+/* *                                                                        * */
+/* * purpose   : reference hashes from an older libmng                      * */
+/* *                                                                        * */
+/* * comment   : mngref renders the given files the way mngcheck does, but  * */
+/* *             only through the 1.0.10 API (mng_read, mng_display and an  * */
+/* *             app-timer that runs as fast as the frames come), and only  * */
+/* *             in the canvas styles 1.0.10 can display; it prints the     * */
+/* *             same lines as mngcheck, so "make -f makefile.linux         * */
+/* *             baseref BASEDIR=..." can compare the reference with what   * */
+/* *             the 1.0.10 library in BASEDIR makes of the same streams    * */
+/* *                                                                        * */
+/* *             every rendering runs in a child process; where the older   * */
+/* *             library crashes the line says so instead of giving a hash  * */
+/* *                                                                        * */
+/* * changes   : 1.0.11 - 10/17/2026                                        * */
+/* *             - initial version                                          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "libmng.h"
+
+/* ************************************************************************** */
+
+#define MAXFRAMES   200                /* same as mngcheck */
+
+typedef unsigned long long hashval;
+
+typedef struct {
+          const char *zName;
+          mng_uint32  iStyle;
+          mng_uint32  iPixelsize;
+        } canvasstyle;
+
+static const canvasstyle aStyles [] =  /* mngcheck's, in mngcheck's order */
+  {
+    {"rgb8",     MNG_CANVAS_RGB8,     3},
+    {"bgr8",     MNG_CANVAS_BGR8,     3},
+    {"rgba8",    MNG_CANVAS_RGBA8,    4},
+    {"rgba8pm",  MNG_CANVAS_RGBA8_PM, 4},
+    {"argb8",    MNG_CANVAS_ARGB8,    4},
+    {"argb8pm",  MNG_CANVAS_ARGB8_PM, 4},
+    {"bgra8",    MNG_CANVAS_BGRA8,    4},
+    {"bgra8pm",  MNG_CANVAS_BGRA8_PM, 4},
+    {"abgr8",    MNG_CANVAS_ABGR8,    4},
+    {"abgr8pm",  MNG_CANVAS_ABGR8_PM, 4},
+    {"bgrx8",    MNG_CANVAS_BGRX8,    4},
+    {"rgb565",   MNG_CANVAS_RGB565,   2},
+    {"rgba565",  MNG_CANVAS_RGBA565,  3},
+  };
+
+#define STYLECOUNT (int)(sizeof (aStyles) / sizeof (aStyles [0]))
+
+/* ************************************************************************** */
+
+static hashval hash_bytes (hashval iHash, const mng_uint8 *pBuf, mng_uint32 iLen)
+{                                      /* FNV-1a */
+  while (iLen--)
+  {
+    iHash ^= *pBuf++;
+    iHash *= 1099511628211ULL;
+  }
+
+  return iHash;
+}
+
+static hashval hash_uint (hashval iHash, mng_uint32 iValue)
+{
+  mng_uint8 aBuf [4];
+
+  aBuf [0] = (mng_uint8)(iValue >> 24);
+  aBuf [1] = (mng_uint8)(iValue >> 16);
+  aBuf [2] = (mng_uint8)(iValue >>  8);
+  aBuf [3] = (mng_uint8)(iValue      );
+
+  return hash_bytes (iHash, aBuf, 4);
+}
+
+/* ************************************************************************** */
+
+typedef struct {
+          mng_uint8p  pIn;
+          mng_uint32  iInlen;
+          mng_uint32  iInpos;
+          mng_uint8p  pCanvas;
+          mng_uint32  iRowsize;
+          mng_uint32  iTicks;          /* the app's clock ... */
+          mng_uint32  iDelay;          /* ... and the last timer asked for */
+        } userdata;
+
+static mng_ptr MNG_DECL cb_alloc (mng_size_t iLen)
+{
+  return calloc (1, iLen);
+}
+
+static void MNG_DECL cb_free (mng_ptr pPtr, mng_size_t iLen)
+{
+  free (pPtr);
+}
+
+static mng_bool MNG_DECL cb_openstream (mng_handle hMNG)
+{
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_closestream (mng_handle hMNG)
+{
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_readdata (mng_handle  hMNG,
+                                      mng_ptr     pBuf,
+                                      mng_uint32  iSize,
+                                      mng_uint32p iRead)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  if (iSize > pUser->iInlen - pUser->iInpos)
+    iSize = pUser->iInlen - pUser->iInpos;
+
+  memcpy (pBuf, pUser->pIn + pUser->iInpos, iSize);
+  pUser->iInpos += iSize;
+  *iRead         = iSize;
+
+  return MNG_TRUE;
+}
+
+static mng_bool MNG_DECL cb_errorproc (mng_handle  hMNG,
+                                       mng_int32   iErrorcode,
+                                       mng_int8    iSeverity,
+                                       mng_chunkid iChunkname,
+                                       mng_uint32  iChunkseq,
+                                       mng_int32   iExtra1,
+                                       mng_int32   iExtra2,
+                                       mng_pchar   zErrortext)
+{
+  return MNG_FALSE;
+}
+
+static mng_bool MNG_DECL cb_processheader (mng_handle hMNG,
+                                           mng_uint32 iWidth,
+                                           mng_uint32 iHeight)
+{
+  return MNG_TRUE;
+}
+
+static mng_ptr MNG_DECL cb_getcanvasline (mng_handle hMNG,
+                                          mng_uint32 iLinenr)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  return (mng_ptr)(pUser->pCanvas + iLinenr * pUser->iRowsize);
+}
+
+static mng_bool MNG_DECL cb_refresh (mng_handle hMNG,
+                                     mng_uint32 iX,
+                                     mng_uint32 iY,
+                                     mng_uint32 iWidth,
+                                     mng_uint32 iHeight)
+{
+  return MNG_TRUE;
+}
+
+static mng_uint32 MNG_DECL cb_gettickcount (mng_handle hMNG)
+{
+  return ((userdata *)mng_get_userdata (hMNG))->iTicks;
+}
+
+/* the timer expires at once; that's what mng_render_frames's virtual clock
+   does as well */
+static mng_bool MNG_DECL cb_settimer (mng_handle hMNG,
+                                      mng_uint32 iMsecs)
+{
+  userdata *pUser = (userdata *)mng_get_userdata (hMNG);
+
+  pUser->iTicks += iMsecs;
+  pUser->iDelay  = iMsecs;
+
+  return MNG_TRUE;
+}
+
+/* ************************************************************************** */
+
+static hashval render (mng_uint8p         pData,
+                       mng_uint32         iLen,
+                       const canvasstyle *pStyle,
+                       int               *iFrames)
+{
+  userdata    sUser;
+  mng_handle  hMNG;
+  mng_retcode iRetcode;
+  mng_uint32  iX, iWidth, iHeight;
+  hashval     iHash = 14695981039346656037ULL;
+
+  memset (&sUser, 0, sizeof (sUser));
+  sUser.pIn    = pData;
+  sUser.iInlen = iLen;
+  *iFrames     = 0;
+
+  hMNG = mng_initialize ((mng_ptr)&sUser, cb_alloc, cb_free, MNG_NULL);
+
+  mng_setcb_errorproc     (hMNG, cb_errorproc    );
+  mng_setcb_openstream    (hMNG, cb_openstream   );
+  mng_setcb_closestream   (hMNG, cb_closestream  );
+  mng_setcb_readdata      (hMNG, cb_readdata     );
+  mng_setcb_processheader (hMNG, cb_processheader);
+  mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+  mng_setcb_refresh       (hMNG, cb_refresh      );
+  mng_setcb_gettickcount  (hMNG, cb_gettickcount );
+  mng_setcb_settimer      (hMNG, cb_settimer     );
+  mng_set_canvasstyle     (hMNG, pStyle->iStyle  );
+
+  iRetcode = mng_read (hMNG);
+
+  if (!iRetcode)
+  {                                    /* the same canvas as mngcheck's */
+    iWidth         = mng_get_imagewidth  (hMNG);
+    iHeight        = mng_get_imageheight (hMNG);
+    sUser.iRowsize = iWidth * pStyle->iPixelsize;
+    sUser.pCanvas  = (mng_uint8p)malloc (sUser.iRowsize * iHeight + 1);
+
+    for (iX = 0; iX < sUser.iRowsize * iHeight; iX++)
+      sUser.pCanvas [iX] = (mng_uint8)((iX * 37 + (iX / sUser.iRowsize) * 11) & 0xFF);
+
+    iRetcode = mng_display (hMNG);
+                                       /* each timer-break ends a frame */
+    while ((iRetcode == MNG_NEEDTIMERWAIT) || (iRetcode == MNG_NEEDSECTIONWAIT))
+    {
+      if (iRetcode == MNG_NEEDTIMERWAIT)
+      {
+        iHash = hash_uint  (iHash, sUser.iDelay);
+        iHash = hash_bytes (iHash, sUser.pCanvas, sUser.iRowsize * iHeight);
+        (*iFrames)++;
+
+        if (*iFrames >= MAXFRAMES)
+          break;
+      }
+
+      iRetcode = mng_display_resume (hMNG);
+    }
+                                       /* and the final canvas */
+    iHash = hash_bytes (iHash, sUser.pCanvas, sUser.iRowsize * iHeight);
+    free (sUser.pCanvas);
+  }
+
+  mng_cleanup (&hMNG);
+
+  if ((iRetcode) && (iRetcode != MNG_NEEDTIMERWAIT))
+    iHash = hash_uint (iHash, 0x80000000UL | (mng_uint32)iRetcode);
+
+  return iHash;
+}
+
+/* ************************************************************************** */
+
+/* render in a child, so a crash of the library only costs that line */
+static void render_line (const char        *zName,
+                         mng_uint8p         pData,
+                         mng_uint32         iLen,
+                         const canvasstyle *pStyle)
+{
+  int     aPipe [2];
+  int     iStatus, iFrames;
+  hashval iHash;
+  pid_t   iPid;
+
+  fflush (stdout);
+
+  if ((pipe (aPipe)) || ((iPid = fork ()) < 0))
+  {
+    perror ("mngref");
+    exit (2);
+  }
+
+  if (!iPid)
+  {
+    close (aPipe [0]);
+    iHash = render (pData, iLen, pStyle, &iFrames);
+
+    if ((write (aPipe [1], &iHash,   sizeof (iHash  )) != sizeof (iHash  )) ||
+        (write (aPipe [1], &iFrames, sizeof (iFrames)) != sizeof (iFrames))   )
+      _exit (2);
+
+    _exit (0);
+  }
+
+  close (aPipe [1]);
+
+  if ((read (aPipe [0], &iHash,   sizeof (iHash  )) == sizeof (iHash  )) &&
+      (read (aPipe [0], &iFrames, sizeof (iFrames)) == sizeof (iFrames))   )
+    printf ("%-16s %-8s %3d %016llx\n", zName, pStyle->zName, iFrames, iHash);
+  else
+    printf ("%-16s %-8s   - crashed\n", zName, pStyle->zName);
+
+  close (aPipe [0]);
+  waitpid (iPid, &iStatus, 0);
+}
+
+/* ************************************************************************** */
+
+int main (int argc, char *argv[])
+{
+  int iArg, iStyle;
+
+  for (iArg = 1; iArg < argc; iArg++)
+  {
+    FILE       *hFile = fopen (argv [iArg], "rb");
+    const char *zBase = strrchr (argv [iArg], '/');
+    mng_uint8p  pData;
+    mng_uint32  iLen;
+
+    if (!hFile)
+    {
+      fprintf (stderr, "mngref: can't open %s\n", argv [iArg]);
+      return 2;
+    }
+
+    fseek (hFile, 0, SEEK_END);
+    iLen  = (mng_uint32)ftell (hFile);
+    fseek (hFile, 0, SEEK_SET);
+    pData = (mng_uint8p)malloc (iLen);
+    iLen  = (mng_uint32)fread (pData, 1, iLen, hFile);
+    fclose (hFile);
+
+    for (iStyle = 0; iStyle < STYLECOUNT; iStyle++)
+      render_line ((zBase ? zBase + 1 : argv [iArg]), pData, iLen,
+                   &aStyles [iStyle]);
+
+    free (pData);
+  }
+
+  return 0;
+}
+
+/* ************************************************************************** */
+/* * end of file                                                            * */
+/* ************************************************************************** */
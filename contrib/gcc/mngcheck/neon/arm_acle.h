@@ -0,0 +1,45 @@
+/* ************************************************************************** */
+/* *             For conditions of distribution and use,                    * */
+/* *                see copyright notice in libmng.h                        * */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * project   : mngcheck                                                   * */
+/* * file      : neon/arm_acle.h                                            * */
+/* * version   : 1.0.11                                                     * */
+/* *                                                                        * */
+/* * purpose   : scalar stand-in for the ARMv8 crc32 intrinsics             * */
+/* *                                                                        * */
+/* * comment   : see arm_neon.h in this directory                           * */
+/* *                                                                        * */
+/* * changes   : 1.0.11 - 10/17/2026                                        * */
+/* *             - initial version                                          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifndef _arm_acle_h_emulated_
+#define _arm_acle_h_emulated_
+
+#include <stdint.h>
+
+static inline uint32_t __crc32b (uint32_t iCrc, uint8_t iData)
+{                                      /* reflected 0x04C11DB7, no inversion */
+  int i;
+
+  iCrc ^= iData;
+  for (i = 0; i < 8; i++)
+    iCrc = (iCrc >> 1) ^ (0xEDB88320UL & (0 - (iCrc & 1)));
+
+  return iCrc;
+}
+
+static inline uint32_t __crc32d (uint32_t iCrc, uint64_t iData)
+{
+  int i;
+
+  for (i = 0; i < 8; i++)              /* little-endian byte order */
+    iCrc = __crc32b (iCrc, (uint8_t)(iData >> (8 * i)));
+
+  return iCrc;
+}
+
+#endif /* _arm_acle_h_emulated_ */
@@ -0,0 +1,181 @@
+/* ************************************************************************** */
+/* *             For conditions of distribution and use,                    * */
+/* *                see copyright notice in libmng.h                        * */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * project   : mngcheck                                                   * */
+/* * file      : neon/arm_neon.h                                            * */
+/* * version   : 1.0.11                                                     * */
+/* *                                                                        * */
+/* * purpose   : scalar stand-in for the NEON intrinsics used by libmng     * */
+/* *                                                                        * */
+/* * comment   : lets the NEON code-paths be built & checked on a machine   * */
+/* *             without an aarch64 compiler (see makefile.linux, target    * */
+/* *             neoncheck); every vector type is a distinct struct, so     * */
+/* *             mixing up lane types fails to compile as it would with the * */
+/* *             real header; only the intrinsics libmng uses are here      * */
+/* *                                                                        * */
+/* *             this checks the arithmetic, not the code generation;       * */
+/* *             immediates aren't checked to be constants                  * */
+/* *                                                                        * */
+/* * changes   : 1.0.11 - 10/17/2026                                        * */
+/* *             - initial version                                          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifndef _arm_neon_h_emulated_
+#define _arm_neon_h_emulated_
+
+#include <stdint.h>
+#include <string.h>
+
+typedef struct { uint8_t  v [16]; } uint8x16_t;
+typedef struct { uint8_t  v [ 8]; } uint8x8_t;
+typedef struct { uint16_t v [ 8]; } uint16x8_t;
+typedef struct { uint16_t v [ 4]; } uint16x4_t;
+typedef struct { uint32_t v [ 4]; } uint32x4_t;
+typedef struct { uint64_t v [ 2]; } uint64x2_t;
+typedef struct { uint64_t v [ 1]; } uint64x1_t;
+typedef struct { int16_t  v [ 8]; } int16x8_t;
+typedef struct { uint8x8_t val [2]; } uint8x8x2_t;
+
+#define NEON_FN static inline
+#define NEON_MAP(T,N,E) { T r; int i; for (i = 0; i < N; i++) r.v [i] = (E); return r; }
+
+/* ************************************************************************** */
+/* * load, store, duplicate                                                 * */
+/* ************************************************************************** */
+
+NEON_FN uint8x16_t vld1q_u8  (const uint8_t  *p) { uint8x16_t r; memcpy (r.v, p, 16); return r; }
+NEON_FN uint8x8_t  vld1_u8   (const uint8_t  *p) { uint8x8_t  r; memcpy (r.v, p,  8); return r; }
+NEON_FN uint16x8_t vld1q_u16 (const uint16_t *p) { uint16x8_t r; memcpy (r.v, p, 16); return r; }
+NEON_FN uint32x4_t vld1q_u32 (const uint32_t *p) { uint32x4_t r; memcpy (r.v, p, 16); return r; }
+NEON_FN void vst1q_u8  (uint8_t  *p, uint8x16_t a) { memcpy (p, a.v, 16); }
+NEON_FN void vst1q_u32 (uint32_t *p, uint32x4_t a) { memcpy (p, a.v, 16); }
+
+NEON_FN uint8x16_t vdupq_n_u8  (uint8_t  x) NEON_MAP (uint8x16_t, 16, x)
+NEON_FN uint8x8_t  vdup_n_u8   (uint8_t  x) NEON_MAP (uint8x8_t,   8, x)
+NEON_FN uint16x8_t vdupq_n_u16 (uint16_t x) NEON_MAP (uint16x8_t,  8, x)
+NEON_FN uint32x4_t vdupq_n_u32 (uint32_t x) NEON_MAP (uint32x4_t,  4, x)
+NEON_FN uint64x2_t vdupq_n_u64 (uint64_t x) NEON_MAP (uint64x2_t,  2, x)
+NEON_FN int16x8_t  vdupq_n_s16 (int16_t  x) NEON_MAP (int16x8_t,   8, x)
+
+NEON_FN uint8x8_t vcreate_u8 (uint64_t x)
+{
+  uint8x8_t r; int i;
+  for (i = 0; i < 8; i++) r.v [i] = (uint8_t)(x >> (8 * i));
+  return r;
+}
+
+/* ************************************************************************** */
+/* * halves & lanes                                                         * */
+/* ************************************************************************** */
+
+NEON_FN uint8x8_t  vget_low_u8   (uint8x16_t a) NEON_MAP (uint8x8_t,  8, a.v [i])
+NEON_FN uint8x8_t  vget_high_u8  (uint8x16_t a) NEON_MAP (uint8x8_t,  8, a.v [i + 8])
+NEON_FN uint16x4_t vget_low_u16  (uint16x8_t a) NEON_MAP (uint16x4_t, 4, a.v [i])
+NEON_FN uint16x4_t vget_high_u16 (uint16x8_t a) NEON_MAP (uint16x4_t, 4, a.v [i + 4])
+NEON_FN uint8x16_t vcombine_u8  (uint8x8_t  a, uint8x8_t  b) NEON_MAP (uint8x16_t, 16, (i < 8 ? a.v [i] : b.v [i - 8]))
+NEON_FN uint16x8_t vcombine_u16 (uint16x4_t a, uint16x4_t b) NEON_MAP (uint16x8_t,  8, (i < 4 ? a.v [i] : b.v [i - 4]))
+
+NEON_FN uint16_t vgetq_lane_u16 (uint16x8_t a, int n) { return a.v [n]; }
+NEON_FN uint64_t vget_lane_u64  (uint64x1_t a, int n) { return a.v [n]; }
+
+NEON_FN uint32x4_t vextq_u32 (uint32x4_t a, uint32x4_t b, int n)
+  NEON_MAP (uint32x4_t, 4, (i + n < 4 ? a.v [i + n] : b.v [i + n - 4]))
+
+NEON_FN uint8x8x2_t vzip_u8 (uint8x8_t a, uint8x8_t b)
+{
+  uint8x8x2_t r; int i;
+  for (i = 0; i < 8; i++)
+  {
+    r.val [i >> 2].v [(i & 3) * 2    ] = a.v [i];
+    r.val [i >> 2].v [(i & 3) * 2 + 1] = b.v [i];
+  }
+  return r;
+}
+
+/* ************************************************************************** */
+/* * reinterpret (little-endian lanes)                                      * */
+/* ************************************************************************** */
+
+#define NEON_CAST(N,TO,FROM) \
+  NEON_FN TO N (FROM a) { TO r; memcpy (&r, &a, sizeof (r)); return r; }
+
+NEON_CAST (vreinterpretq_u16_u8,  uint16x8_t, uint8x16_t)
+NEON_CAST (vreinterpretq_u8_u16,  uint8x16_t, uint16x8_t)
+NEON_CAST (vreinterpretq_u8_u32,  uint8x16_t, uint32x4_t)
+NEON_CAST (vreinterpretq_u16_u64, uint16x8_t, uint64x2_t)
+NEON_CAST (vreinterpret_u64_u8,   uint64x1_t, uint8x8_t )
+
+/* ************************************************************************** */
+/* * arithmetic                                                             * */
+/* ************************************************************************** */
+
+NEON_FN uint8x16_t vaddq_u8  (uint8x16_t a, uint8x16_t b) NEON_MAP (uint8x16_t, 16, (uint8_t)(a.v [i] + b.v [i]))
+NEON_FN uint8x8_t  vadd_u8   (uint8x8_t  a, uint8x8_t  b) NEON_MAP (uint8x8_t,   8, (uint8_t)(a.v [i] + b.v [i]))
+NEON_FN uint16x8_t vaddq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, (uint16_t)(a.v [i] + b.v [i]))
+NEON_FN uint32x4_t vaddq_u32 (uint32x4_t a, uint32x4_t b) NEON_MAP (uint32x4_t,  4, a.v [i] + b.v [i])
+NEON_FN uint16x8_t vsubq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, (uint16_t)(a.v [i] - b.v [i]))
+NEON_FN uint16x8_t vqsubq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t, 8, (a.v [i] > b.v [i] ? a.v [i] - b.v [i] : 0))
+NEON_FN uint8x8_t  vhadd_u8  (uint8x8_t  a, uint8x8_t  b) NEON_MAP (uint8x8_t,   8, (uint8_t)((a.v [i] + b.v [i]) >> 1))
+NEON_FN uint16x8_t vabdq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, (a.v [i] > b.v [i] ? a.v [i] - b.v [i] : b.v [i] - a.v [i]))
+NEON_FN uint16x8_t vminq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, (a.v [i] < b.v [i] ? a.v [i] : b.v [i]))
+
+NEON_FN uint16x8_t vmull_u8  (uint8x8_t  a, uint8x8_t  b) NEON_MAP (uint16x8_t, 8, (uint16_t)(a.v [i] * b.v [i]))
+NEON_FN uint32x4_t vmull_u16 (uint16x4_t a, uint16x4_t b) NEON_MAP (uint32x4_t, 4, (uint32_t)a.v [i] * b.v [i])
+NEON_FN uint16x8_t vmlal_u8  (uint16x8_t c, uint8x8_t  a, uint8x8_t  b) NEON_MAP (uint16x8_t, 8, (uint16_t)(c.v [i] + a.v [i] * b.v [i]))
+NEON_FN uint32x4_t vmlal_u16 (uint32x4_t c, uint16x4_t a, uint16x4_t b) NEON_MAP (uint32x4_t, 4, c.v [i] + (uint32_t)a.v [i] * b.v [i])
+NEON_FN uint16x8_t vmlaq_u16 (uint16x8_t c, uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t, 8, (uint16_t)(c.v [i] + a.v [i] * b.v [i]))
+
+NEON_FN uint16x8_t vmovl_u8  (uint8x8_t  a) NEON_MAP (uint16x8_t, 8, a.v [i])
+NEON_FN uint8x8_t  vmovn_u16 (uint16x8_t a) NEON_MAP (uint8x8_t,  8, (uint8_t)a.v [i])
+
+NEON_FN uint8_t vmaxvq_u8 (uint8x16_t a)
+{
+  uint8_t r = 0; int i;
+  for (i = 0; i < 16; i++) if (a.v [i] > r) r = a.v [i];
+  return r;
+}
+
+/* ************************************************************************** */
+/* * shifts                                                                 * */
+/* ************************************************************************** */
+
+NEON_FN uint16x8_t vshrq_n_u16 (uint16x8_t a, int n) NEON_MAP (uint16x8_t, 8, (uint16_t)(a.v [i] >> n))
+NEON_FN uint32x4_t vshrq_n_u32 (uint32x4_t a, int n) NEON_MAP (uint32x4_t, 4, a.v [i] >> n)
+NEON_FN uint8x8_t  vshrn_n_u16 (uint16x8_t a, int n) NEON_MAP (uint8x8_t,  8, (uint8_t)(a.v [i] >> n))
+NEON_FN uint16x4_t vshrn_n_u32 (uint32x4_t a, int n) NEON_MAP (uint16x4_t, 4, (uint16_t)(a.v [i] >> n))
+
+NEON_FN uint16x8_t vshlq_u16 (uint16x8_t a, int16x8_t n)  /* negative is right */
+  NEON_MAP (uint16x8_t, 8, (uint16_t)((n.v [i] >= 16) || (n.v [i] <= -16) ? 0 :
+                                      (n.v [i] >= 0 ? a.v [i] << n.v [i] : a.v [i] >> -n.v [i])))
+
+/* ************************************************************************** */
+/* * logic, compare & select                                                * */
+/* ************************************************************************** */
+
+NEON_FN uint8x16_t vorrq_u8  (uint8x16_t a, uint8x16_t b) NEON_MAP (uint8x16_t, 16, a.v [i] | b.v [i])
+NEON_FN uint16x8_t vorrq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, a.v [i] | b.v [i])
+NEON_FN uint8x16_t vbicq_u8  (uint8x16_t a, uint8x16_t b) NEON_MAP (uint8x16_t, 16, (uint8_t)(a.v [i] & ~b.v [i]))
+NEON_FN uint16x8_t vbicq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, (uint16_t)(a.v [i] & ~b.v [i]))
+NEON_FN uint8x16_t vmvnq_u8  (uint8x16_t a) NEON_MAP (uint8x16_t, 16, (uint8_t)~a.v [i])
+NEON_FN uint16x8_t vmvnq_u16 (uint16x8_t a) NEON_MAP (uint16x8_t,  8, (uint16_t)~a.v [i])
+
+NEON_FN uint8x16_t vceqq_u8  (uint8x16_t a, uint8x16_t b) NEON_MAP (uint8x16_t, 16, (a.v [i] == b.v [i] ? 0xFF : 0))
+NEON_FN uint16x8_t vceqq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, (a.v [i] == b.v [i] ? 0xFFFF : 0))
+NEON_FN uint16x8_t vcltq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, (a.v [i] <  b.v [i] ? 0xFFFF : 0))
+NEON_FN uint16x8_t vcgtq_u16 (uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, (a.v [i] >  b.v [i] ? 0xFFFF : 0))
+
+NEON_FN uint8x16_t vbslq_u8  (uint8x16_t m, uint8x16_t a, uint8x16_t b) NEON_MAP (uint8x16_t, 16, (uint8_t)((m.v [i] & a.v [i]) | (~m.v [i] & b.v [i])))
+NEON_FN uint16x8_t vbslq_u16 (uint16x8_t m, uint16x8_t a, uint16x8_t b) NEON_MAP (uint16x8_t,  8, (uint16_t)((m.v [i] & a.v [i]) | (~m.v [i] & b.v [i])))
+
+/* ************************************************************************** */
+/* * permutes                                                               * */
+/* ************************************************************************** */
+
+NEON_FN uint8x16_t vqtbl1q_u8 (uint8x16_t t, uint8x16_t x) NEON_MAP (uint8x16_t, 16, (x.v [i] < 16 ? t.v [x.v [i]] : 0))
+NEON_FN uint8x16_t vrev16q_u8 (uint8x16_t a) NEON_MAP (uint8x16_t, 16, a.v [i ^ 1])
+NEON_FN uint32x4_t vrev64q_u32 (uint32x4_t a) NEON_MAP (uint32x4_t, 4, a.v [i ^ 1])
+
+#endif /* _arm_neon_h_emulated_ */
@@ -0,0 +1,660 @@
+/* ************************************************************************** */
+/* *             For conditions of distribution and use,                    * */
+/* *                see copyright notice in libmng.h                        * */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * project   : mngcheck                                                   * */
+/* * file      : simdcheck.c                                                * */
+/* * version   : 1.0.11                                                     * */
+/* *                                                                        * */
+/* * purpose   : compare the vectorized pixel routines with the portable    * */
+/* *             ones                                                       * */
+/* *                                                                        * */
+/* * comment   : every _simd display, magnify, compose & flip routine (and  * */
+/* *             the delta-image adds) is run next to its portable twin on  * */
+/* *             random rows, for each vector unit the cpu has; the rows    * */
+/* *             mix transparent, opaque & partial alpha, and so does the   * */
+/* *             canvas (the MNG_BLEND8 paths); the outputs must be         * */
+/* *             identical byte for byte                                    * */
+/* *                                                                        * */
+/* *             this uses the library internals, so it must be built with  * */
+/* *             exactly the same flags as the library                      * */
+/* *                                                                        * */
+/* * changes   : 1.0.11 - 10/17/2026                                        * */
+/* *             - initial version                                          * */
+/* *             - added the delta-image span & part adds                   * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../../libmng.h"
+#include "../../../libmng_data.h"
+#include "../../../libmng_objects.h"
+#include "../../../libmng_pixels.h"
+
+/* ************************************************************************** */
+
+#define MAXPIXELS   77                 /* enough for a few vectors & a tail */
+#define MAXMAGN     6
+#define TRIALS      400
+
+static int iFailures = 0;
+static int iChecks   = 0;
+
+/* ************************************************************************** */
+
+static mng_uint32 iSeed = 20261017;
+
+static mng_uint32 rnd (mng_uint32 iRange)
+{
+  iSeed = iSeed * 1103515245UL + 12345UL;
+  return ((iSeed >> 8) & 0xFFFFFF) % iRange;
+}
+
+static mng_uint8 rnd_alpha (void)     /* transparent, opaque & partial alike */
+{
+  switch (rnd (3))
+  {
+    case 0  : return 0;
+    case 1  : return 255;
+    default : return (mng_uint8)(1 + rnd (254));
+  }
+}
+
+static void rnd_fill (mng_uint8p pBuf, mng_uint32 iLen)
+{
+  while (iLen--)
+    *pBuf++ = (mng_uint8)rnd (256);
+}
+
+/* ************************************************************************** */
+
+static mng_ptr MNG_DECL cb_alloc (mng_size_t iLen)
+{
+  return calloc (1, iLen);
+}
+
+static void MNG_DECL cb_free (mng_ptr pPtr, mng_size_t iLen)
+{
+  free (pPtr);
+}
+
+#ifdef MNG_SUPPORT_SIMD
+
+static mng_uint8p pCanvasrow;          /* the row the display routines see */
+static mng_uint8p pAlpharow;
+
+static mng_ptr MNG_DECL cb_getcanvasline (mng_handle hMNG,
+                                          mng_uint32 iLinenr)
+{
+  return (mng_ptr)pCanvasrow;
+}
+
+static mng_ptr MNG_DECL cb_getalphaline (mng_handle hMNG,
+                                         mng_uint32 iLinenr)
+{
+  return (mng_ptr)pAlpharow;
+}
+
+static void report (const char *zName,
+                    mng_uint32  iSIMD,
+                    int         iTrial,
+                    const char *zDetail)
+{
+  if (iFailures < 20)
+    printf ("FAIL %s (simd 0x%02x, trial %d): %s\n",
+            zName, (unsigned)iSIMD, iTrial, zDetail);
+  iFailures++;
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * display routines                                                       * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+typedef struct {
+          const char       *zName;
+          mng_displayrow    fSIMD;
+          mng_displayrow    fPortable;
+          mng_uint32        iPixelsize;  /* canvas bytes per pixel */
+          int               b16;         /* 16-bit canvas (takes RGBA16 rows) */
+          int               bAlphaline;  /* separate alpha-plane */
+          int               iAlphapos;   /* alpha offset in the canvas pixel */
+        } displayroutine;
+
+static const displayroutine aDisplay [] =
+  {
+#ifndef MNG_SKIPCANVAS_RGBA8
+    {"display_rgba8",    mng_display_rgba8_simd,    mng_display_rgba8,    4, 0, 0,  3},
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA8_PM
+    {"display_rgba8_pm", mng_display_rgba8_pm_simd, mng_display_rgba8_pm, 4, 0, 0,  3},
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB8
+    {"display_argb8",    mng_display_argb8_simd,    mng_display_argb8,    4, 0, 0,  0},
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB8_PM
+    {"display_argb8_pm", mng_display_argb8_pm_simd, mng_display_argb8_pm, 4, 0, 0,  0},
+#endif
+#ifndef MNG_SKIPCANVAS_RGB8_A8
+    {"display_rgb8_a8",  mng_display_rgb8_a8_simd,  mng_display_rgb8_a8,  3, 0, 1, -1},
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA8
+    {"display_bgra8",    mng_display_bgra8_simd,    mng_display_bgra8,    4, 0, 0,  3},
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA8_PM
+    {"display_bgra8_pm", mng_display_bgra8_pm_simd, mng_display_bgra8_pm, 4, 0, 0,  3},
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR8
+    {"display_abgr8",    mng_display_abgr8_simd,    mng_display_abgr8,    4, 0, 0,  0},
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR8_PM
+    {"display_abgr8_pm", mng_display_abgr8_pm_simd, mng_display_abgr8_pm, 4, 0, 0,  0},
+#endif
+#ifndef MNG_NO_16BIT_SUPPORT
+#ifndef MNG_SKIPCANVAS_RGB16
+    {"display_rgb16",    mng_display_rgb16_simd,    mng_display_rgb16,    6, 1, 0, -1},
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA16
+    {"display_rgba16",   mng_display_rgba16_simd,   mng_display_rgba16,   8, 1, 0,  6},
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB16
+    {"display_argb16",   mng_display_argb16_simd,   mng_display_argb16,   8, 1, 0,  0},
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA16
+    {"display_bgra16",   mng_display_bgra16_simd,   mng_display_bgra16,   8, 1, 0,  6},
+#endif
+#ifndef MNG_SKIPCANVAS_BGR16
+    {"display_bgr16",    mng_display_bgr16_simd,    mng_display_bgr16,    6, 1, 0, -1},
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR16
+    {"display_abgr16",   mng_display_abgr16_simd,   mng_display_abgr16,   8, 1, 0,  0},
+#endif
+#endif /* MNG_NO_16BIT_SUPPORT */
+  };
+
+#define DISPLAYCOUNT (int)(sizeof (aDisplay) / sizeof (aDisplay [0]))
+
+/* ************************************************************************** */
+
+static void check_display (mng_datap             pData,
+                           const displayroutine *pRoutine,
+                           mng_uint32            iSIMD)
+{
+  static mng_uint8 aRow      [MAXPIXELS * 8];
+  static mng_uint8 aCanvas   [2][(MAXPIXELS + 8) * 8];
+  static mng_uint8 aAlpha    [2][MAXPIXELS + 8];
+  mng_uint32       iCanvaslen = (MAXPIXELS + 8) * pRoutine->iPixelsize;
+  mng_uint32       iX;
+  int              iTrial, iPass;
+  mng_bool         bRGBA16, bOpaque;
+
+  for (iTrial = 0; iTrial < TRIALS; iTrial++)
+  {                                    /* 16-bit canvases take both row kinds */
+    bRGBA16 = (mng_bool)(pRoutine->b16 ? rnd (4) != 0 : MNG_FALSE);
+    bOpaque = (mng_bool)(rnd (5) == 0);
+
+    pData->iRow      = 0;
+    pData->iSourcet  = 0;
+    pData->iSourceb  = 1;
+    pData->iDestt    = 0;
+    pData->iSourcel  = rnd (5);
+    pData->iSourcer  = pData->iSourcel + 1 + rnd (MAXPIXELS - 5);
+    pData->iCol      = (rnd (4) ? 0 : rnd (3));
+    pData->iColinc   = (rnd (10) ? 1 : 2);
+    pData->iDestl    = rnd (7);
+    pData->bIsRGBA16 = bRGBA16;
+    pData->bIsOpaque = bOpaque;
+    pData->pRGBArow  = aRow;
+                                       /* the source row */
+    rnd_fill (aRow, sizeof (aRow));
+
+    for (iX = 0; iX < MAXPIXELS; iX++)
+    {
+      if (bRGBA16)
+      {
+        mng_uint8 iA = (bOpaque ? 255 : rnd_alpha ());
+
+        aRow [iX * 8 + 6] = iA;
+        aRow [iX * 8 + 7] = (mng_uint8)((iA == 0) || (iA == 255) ? iA : rnd (256));
+      }
+      else
+        aRow [iX * 4 + 3] = (bOpaque ? 255 : rnd_alpha ());
+    }
+                                       /* the canvas, with some alpha as well */
+    rnd_fill (aCanvas [0], iCanvaslen);
+    rnd_fill (aAlpha  [0], sizeof (aAlpha [0]));
+
+    if (pRoutine->iAlphapos >= 0)
+    {
+      for (iX = 0; iX < MAXPIXELS + 8; iX++)
+      {
+        mng_uint8p pA = aCanvas [0] + iX * pRoutine->iPixelsize + pRoutine->iAlphapos;
+
+        *pA = rnd_alpha ();
+        if (pRoutine->b16)
+          *(pA+1) = (mng_uint8)((*pA == 0) || (*pA == 255) ? *pA : rnd (256));
+      }
+    }
+
+    for (iX = 0; iX < MAXPIXELS + 8; iX++)
+      aAlpha [0][iX] = rnd_alpha ();
+
+    memcpy (aCanvas [1], aCanvas [0], iCanvaslen);
+    memcpy (aAlpha  [1], aAlpha  [0], sizeof (aAlpha [0]));
+
+    for (iPass = 0; iPass < 2; iPass++)
+    {
+      pCanvasrow = aCanvas [iPass];
+      pAlpharow  = aAlpha  [iPass];
+
+      if (iPass)
+        pRoutine->fSIMD     (pData);
+      else
+        pRoutine->fPortable (pData);
+    }
+
+    iChecks++;
+
+    if (memcmp (aCanvas [0], aCanvas [1], iCanvaslen))
+      report (pRoutine->zName, iSIMD, iTrial, "canvas differs");
+    else
+    if ((pRoutine->bAlphaline) &&
+        (memcmp (aAlpha [0], aAlpha [1], sizeof (aAlpha [0]))))
+      report (pRoutine->zName, iSIMD, iTrial, "alpha-plane differs");
+  }
+}
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * magnification                                                          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#if defined(MNG_INCLUDE_SIMD_MAGN) && !defined(MNG_OPTIMIZE_FOOTPRINT_MAGN)
+
+typedef mng_retcode (*magnifyx) (mng_datap, mng_uint16, mng_uint16, mng_uint16,
+                                 mng_uint32, mng_uint8p, mng_uint8p);
+typedef mng_retcode (*magnifyy) (mng_datap, mng_int32, mng_int32, mng_uint32,
+                                 mng_uint8p, mng_uint8p, mng_uint8p);
+
+typedef struct {
+          const char *zName;
+          magnifyx    fSIMD;
+          magnifyx    fPortable;
+          mng_uint32  iPixelsize;
+        } magnifyxroutine;
+
+typedef struct {
+          const char *zName;
+          magnifyy    fSIMD;
+          magnifyy    fPortable;
+          mng_uint32  iPixelsize;
+        } magnifyyroutine;
+
+static const magnifyxroutine aMagnifyx [] =
+  {
+#ifndef MNG_NO_GRAY_SUPPORT
+    {"magnify_g8_x1",    mng_magnify_g8_x1_simd,    mng_magnify_g8_x1,    1},
+    {"magnify_g8_x2",    mng_magnify_g8_x2_simd,    mng_magnify_g8_x2,    1},
+    {"magnify_g8_x3",    mng_magnify_g8_x3_simd,    mng_magnify_g8_x3,    1},
+    {"magnify_ga8_x1",   mng_magnify_ga8_x1_simd,   mng_magnify_ga8_x1,   2},
+    {"magnify_ga8_x2",   mng_magnify_ga8_x2_simd,   mng_magnify_ga8_x2,   2},
+    {"magnify_ga8_x3",   mng_magnify_ga8_x3_simd,   mng_magnify_ga8_x3,   2},
+    {"magnify_ga8_x4",   mng_magnify_ga8_x4_simd,   mng_magnify_ga8_x4,   2},
+    {"magnify_ga8_x5",   mng_magnify_ga8_x5_simd,   mng_magnify_ga8_x5,   2},
+#endif
+    {"magnify_rgba8_x1", mng_magnify_rgba8_x1_simd, mng_magnify_rgba8_x1, 4},
+    {"magnify_rgba8_x2", mng_magnify_rgba8_x2_simd, mng_magnify_rgba8_x2, 4},
+    {"magnify_rgba8_x3", mng_magnify_rgba8_x3_simd, mng_magnify_rgba8_x3, 4},
+    {"magnify_rgba8_x4", mng_magnify_rgba8_x4_simd, mng_magnify_rgba8_x4, 4},
+    {"magnify_rgba8_x5", mng_magnify_rgba8_x5_simd, mng_magnify_rgba8_x5, 4},
+  };
+
+static const magnifyyroutine aMagnifyy [] =
+  {
+#ifndef MNG_NO_GRAY_SUPPORT
+    {"magnify_g8_y2",    mng_magnify_g8_y2_simd,    mng_magnify_g8_y2,    1},
+    {"magnify_ga8_y2",   mng_magnify_ga8_y2_simd,   mng_magnify_ga8_y2,   2},
+    {"magnify_ga8_y4",   mng_magnify_ga8_y4_simd,   mng_magnify_ga8_y4,   2},
+    {"magnify_ga8_y5",   mng_magnify_ga8_y5_simd,   mng_magnify_ga8_y5,   2},
+#endif
+    {"magnify_rgba8_y2", mng_magnify_rgba8_y2_simd, mng_magnify_rgba8_y2, 4},
+    {"magnify_rgba8_y4", mng_magnify_rgba8_y4_simd, mng_magnify_rgba8_y4, 4},
+    {"magnify_rgba8_y5", mng_magnify_rgba8_y5_simd, mng_magnify_rgba8_y5, 4},
+  };
+
+#define MAGNIFYXCOUNT (int)(sizeof (aMagnifyx) / sizeof (aMagnifyx [0]))
+#define MAGNIFYYCOUNT (int)(sizeof (aMagnifyy) / sizeof (aMagnifyy [0]))
+
+/* ************************************************************************** */
+
+static void check_magnifyx (mng_datap              pData,
+                            const magnifyxroutine *pRoutine,
+                            mng_uint32             iSIMD)
+{
+  static mng_uint8 aSrc [MAXPIXELS * 4];
+  static mng_uint8 aDst [2][(MAXPIXELS * MAXMAGN + 16) * 4];
+  mng_uint32       iWidth;
+  mng_uint16       iMX, iML, iMR;
+  int              iTrial;
+
+  for (iTrial = 0; iTrial < TRIALS; iTrial++)
+  {
+    iWidth = 1 + rnd (MAXPIXELS);
+    iMX    = (mng_uint16)(1 + rnd (MAXMAGN));
+    iML    = (mng_uint16)(1 + rnd (MAXMAGN));
+    iMR    = (mng_uint16)(1 + rnd (MAXMAGN));
+
+    rnd_fill (aSrc, iWidth * pRoutine->iPixelsize);
+    memset (aDst [0], 0xCD, sizeof (aDst [0]));
+    memset (aDst [1], 0xCD, sizeof (aDst [1]));
+
+    pRoutine->fPortable (pData, iMX, iML, iMR, iWidth, aSrc, aDst [0]);
+    pRoutine->fSIMD     (pData, iMX, iML, iMR, iWidth, aSrc, aDst [1]);
+
+    iChecks++;
+
+    if (memcmp (aDst [0], aDst [1], sizeof (aDst [0])))
+      report (pRoutine->zName, iSIMD, iTrial, "row differs");
+  }
+}
+
+/* ************************************************************************** */
+
+static void check_magnifyy (mng_datap              pData,
+                            const magnifyyroutine *pRoutine,
+                            mng_uint32             iSIMD)
+{
+  static mng_uint8 aSrc1 [MAXPIXELS * MAXMAGN * 4];
+  static mng_uint8 aSrc2 [MAXPIXELS * MAXMAGN * 4];
+  static mng_uint8 aDst  [2][MAXPIXELS * MAXMAGN * 4 + 64];
+  mng_uint32       iWidth;
+  mng_int32        iM, iS;
+  mng_uint8p       pSrc2;
+  int              iTrial;
+
+  for (iTrial = 0; iTrial < TRIALS; iTrial++)
+  {                                    /* rows are magnified in X already */
+    iWidth = 1 + rnd (MAXPIXELS * MAXMAGN);
+    iM     = 2 + rnd (MAXMAGN - 1);
+    iS     = rnd (iM);
+    pSrc2  = (rnd (8) ? aSrc2 : MNG_NULL);
+
+    rnd_fill (aSrc1, sizeof (aSrc1));
+    rnd_fill (aSrc2, sizeof (aSrc2));
+
+    if (pRoutine->iPixelsize > 1)      /* make sure the alpha-specials occur */
+    {
+      mng_uint32 iX;
+
+      for (iX = 0; iX < iWidth; iX++)
+      {
+        aSrc1 [iX * pRoutine->iPixelsize + pRoutine->iPixelsize - 1] = rnd_alpha ();
+        aSrc2 [iX * pRoutine->iPixelsize + pRoutine->iPixelsize - 1] = rnd_alpha ();
+      }
+    }
+
+    memset (aDst [0], 0xCD, sizeof (aDst [0]));
+    memset (aDst [1], 0xCD, sizeof (aDst [1]));
+
+    pRoutine->fPortable (pData, iS, iM, iWidth, aSrc1, pSrc2, aDst [0]);
+    pRoutine->fSIMD     (pData, iS, iM, iWidth, aSrc1, pSrc2, aDst [1]);
+
+    iChecks++;
+
+    if (memcmp (aDst [0], aDst [1], sizeof (aDst [0])))
+      report (pRoutine->zName, iSIMD, iTrial, "row differs");
+  }
+}
+
+#endif /* MNG_INCLUDE_SIMD_MAGN && !MNG_OPTIMIZE_FOOTPRINT_MAGN */
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * PAST compose & flip                                                    * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_PAST
+
+static void check_past (mng_datap      pData,
+                        const char    *zName,
+                        mng_displayrow fSIMD,
+                        mng_displayrow fPortable,
+                        int            bFlip,
+                        mng_uint32     iSIMD)
+{
+  static mng_uint8 aRow    [2][MAXPIXELS * 4];
+  static mng_uint8 aWork   [2][MAXPIXELS * 4];
+  static mng_uint8 aTarget [2][MAXPIXELS * 4 + 16];
+  mng_image        sImage;
+  mng_imagedata    sImgbuf;
+  mng_uint32       iX;
+  int              iTrial, iPass;
+
+  memset (&sImage,  0, sizeof (sImage));
+  memset (&sImgbuf, 0, sizeof (sImgbuf));
+
+  sImage.pImgbuf      = &sImgbuf;
+  sImgbuf.iSamplesize = 4;
+  sImgbuf.iRowsize    = sizeof (aTarget [0]);
+
+  for (iTrial = 0; iTrial < TRIALS; iTrial++)
+  {
+    pData->iRow        = 0;
+    pData->iCol        = rnd (4);
+    pData->iRowsamples = 1 + rnd (MAXPIXELS - 4);
+    pData->pStoreobj   = (mng_objectp)&sImage;
+    pData->bIsOpaque   = (mng_bool)(rnd (5) == 0);
+
+    rnd_fill (aRow [0], sizeof (aRow [0]));
+    rnd_fill (aTarget [0], sizeof (aTarget [0]));
+
+    for (iX = 0; iX < MAXPIXELS; iX++)
+    {
+      aRow    [0][iX * 4 + 3] = (pData->bIsOpaque ? 255 : rnd_alpha ());
+      aTarget [0][iX * 4 + 3] = rnd_alpha ();
+    }
+
+    memcpy (aRow    [1], aRow    [0], sizeof (aRow    [0]));
+    memcpy (aTarget [1], aTarget [0], sizeof (aTarget [0]));
+    memset (aWork, 0xCD, sizeof (aWork));
+
+    for (iPass = 0; iPass < 2; iPass++)
+    {
+      pData->pRGBArow  = aRow  [iPass];
+      pData->pWorkrow  = aWork [iPass];
+      sImgbuf.pImgdata = aTarget [iPass];
+
+      if (iPass)
+        fSIMD     (pData);
+      else
+        fPortable (pData);
+    }
+
+    iChecks++;
+
+    if (bFlip)                         /* the flipped row is in the work-row */
+    {
+      if (memcmp (aWork [0], aWork [1], pData->iRowsamples * 4))
+        report (zName, iSIMD, iTrial, "row differs");
+    }
+    else
+    if (memcmp (aTarget [0], aTarget [1], sizeof (aTarget [0])))
+      report (zName, iSIMD, iTrial, "target differs");
+  }
+}
+
+#endif /* MNG_SKIPCHUNK_PAST */
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * delta-image adds                                                       * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+/* iPart is one of MNG_ADDPART_xxx, or -1 for the whole-pixel span adds;
+   the same rows are added with the vector unit and with iSIMDflags 0 */
+static void check_add (mng_datap  pData,
+                       const char *zName,
+                       int         iPart,
+                       int         b16,
+                       mng_uint32  iSIMD)
+{
+  static mng_uint8 aWork   [MAXPIXELS * 8 + 4];
+  static mng_uint8 aTarget [2][MAXPIXELS * 8 + 8];
+  mng_uint32       iFlags = pData->iSIMDflags;
+  mng_uint32       iCount, iOfs;
+  int              iTrial, iPass;
+
+  for (iTrial = 0; iTrial < TRIALS; iTrial++)
+  {                                    /* pixels (or samples for the spans) */
+    iCount = 1 + rnd (MAXPIXELS);
+    iOfs   = rnd (4);                  /* unaligned rows as well */
+
+    rnd_fill (aWork, sizeof (aWork));
+    rnd_fill (aTarget [0], sizeof (aTarget [0]));
+    memcpy (aTarget [1], aTarget [0], sizeof (aTarget [0]));
+
+    for (iPass = 0; iPass < 2; iPass++)
+    {
+      pData->iSIMDflags = (iPass ? iFlags : 0);
+
+#ifndef MNG_NO_DELTA_PNG
+      if (iPart >= 0)
+      {
+#ifndef MNG_NO_16BIT_SUPPORT
+        if (b16)
+          mng_add_part16 (pData, aTarget [iPass] + iOfs, aWork + iOfs, iCount,
+                          (mng_uint8)iPart);
+        else
+#endif
+          mng_add_part8  (pData, aTarget [iPass] + iOfs, aWork + iOfs, iCount,
+                          (mng_uint8)iPart);
+      }
+      else
+#endif
+#ifndef MNG_NO_16BIT_SUPPORT
+      if (b16)
+        mng_add_span16 (pData, aTarget [iPass] + iOfs, aWork + iOfs, iCount);
+      else
+#endif
+        mng_add_span8  (pData, aTarget [iPass] + iOfs, aWork + iOfs, iCount);
+    }
+
+    pData->iSIMDflags = iFlags;
+    iChecks++;
+
+    if (memcmp (aTarget [0], aTarget [1], sizeof (aTarget [0])))
+      report (zName, iSIMD, iTrial, "target differs");
+  }
+}
+
+/* ************************************************************************** */
+
+static void check_all (mng_handle hMNG,
+                       mng_uint32 iSIMD)
+{
+  mng_datap pData = (mng_datap)hMNG;
+  int       iX;
+
+  for (iX = 0; iX < DISPLAYCOUNT; iX++)
+    check_display (pData, &aDisplay [iX], iSIMD);
+
+#if defined(MNG_INCLUDE_SIMD_MAGN) && !defined(MNG_OPTIMIZE_FOOTPRINT_MAGN)
+  for (iX = 0; iX < MAGNIFYXCOUNT; iX++)
+    check_magnifyx (pData, &aMagnifyx [iX], iSIMD);
+
+  for (iX = 0; iX < MAGNIFYYCOUNT; iX++)
+    check_magnifyy (pData, &aMagnifyy [iX], iSIMD);
+#endif
+
+  check_add (pData, "add_span8",  -1, 0, iSIMD);
+#ifndef MNG_NO_16BIT_SUPPORT
+  check_add (pData, "add_span16", -1, 1, iSIMD);
+#endif
+#ifndef MNG_NO_DELTA_PNG
+  check_add (pData, "add_part8 ga_g",     MNG_ADDPART_GA_G,     0, iSIMD);
+  check_add (pData, "add_part8 ga_a",     MNG_ADDPART_GA_A,     0, iSIMD);
+  check_add (pData, "add_part8 rgba_rgb", MNG_ADDPART_RGBA_RGB, 0, iSIMD);
+  check_add (pData, "add_part8 rgba_a",   MNG_ADDPART_RGBA_A,   0, iSIMD);
+#ifndef MNG_NO_16BIT_SUPPORT
+  check_add (pData, "add_part16 ga_g",     MNG_ADDPART_GA_G,     1, iSIMD);
+  check_add (pData, "add_part16 ga_a",     MNG_ADDPART_GA_A,     1, iSIMD);
+  check_add (pData, "add_part16 rgba_rgb", MNG_ADDPART_RGBA_RGB, 1, iSIMD);
+  check_add (pData, "add_part16 rgba_a",   MNG_ADDPART_RGBA_A,   1, iSIMD);
+#endif
+#endif
+
+#ifndef MNG_SKIPCHUNK_PAST
+  check_past (pData, "composeover_rgba8", mng_composeover_rgba8_simd,
+              mng_composeover_rgba8, 0, iSIMD);
+  check_past (pData, "composeunder_rgba8", mng_composeunder_rgba8_simd,
+              mng_composeunder_rgba8, 0, iSIMD);
+  check_past (pData, "flip_rgba8", mng_flip_rgba8_simd,
+              mng_flip_rgba8, 1, iSIMD);
+#endif
+}
+
+#endif /* MNG_SUPPORT_SIMD */
+
+/* ************************************************************************** */
+
+int main (int argc, char *argv[])
+{
+#ifdef MNG_SUPPORT_SIMD
+  static const mng_uint32 aMasks [] =
+    { MNG_SIMD_SSE2, MNG_SIMD_SSE2 | MNG_SIMD_AVX2, MNG_SIMD_NEON };
+  mng_handle hMNG;
+  mng_datap  pData;
+  mng_uint8p pSavedRGBArow, pSavedWorkrow;
+  mng_objectp pSavedStoreobj;
+  int        iX, iUnits = 0;
+
+  hMNG  = mng_initialize (MNG_NULL, cb_alloc, cb_free, MNG_NULL);
+  pData = (mng_datap)hMNG;
+
+  mng_setcb_getcanvasline (hMNG, cb_getcanvasline);
+  mng_setcb_getalphaline  (hMNG, cb_getalphaline );
+                                       /* these get pointed at local rows */
+  pSavedRGBArow  = pData->pRGBArow;
+  pSavedWorkrow  = pData->pWorkrow;
+  pSavedStoreobj = pData->pStoreobj;
+
+  for (iX = 0; iX < (int)(sizeof (aMasks) / sizeof (aMasks [0])); iX++)
+  {
+    mng_set_simd (hMNG, aMasks [iX]);
+
+    if (mng_get_simd (hMNG) != aMasks [iX])
+      continue;                        /* not on this cpu */
+
+    iUnits++;
+    check_all (hMNG, aMasks [iX]);
+  }
+
+  pData->pRGBArow  = pSavedRGBArow;
+  pData->pWorkrow  = pSavedWorkrow;
+  pData->pStoreobj = pSavedStoreobj;
+
+  mng_cleanup (&hMNG);
+
+  if (!iUnits)
+    printf ("simdcheck: no vector unit available\n");
+  else
+    printf ("simdcheck: %d comparisons, %d failure(s)\n", iChecks, iFailures);
+
+  return (iFailures ? 1 : 0);
+#else
+  printf ("simdcheck: library built without MNG_SUPPORT_SIMD\n");
+  return 0;
+#endif
+}
+
+/* ************************************************************************** */
+/* * end of file                                                            * */
+/* ************************************************************************** */
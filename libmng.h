@@ -294,6 +294,31 @@
 /* *             1.0.10 - 04/12/2007 - G.Juyn                               * */
 /* *             - added support for ANG proposal                           * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added SIMD feature flags & mng_set_simd/mng_get_simd     * */
+/* *             - added keyframe cache for the display_goxxxx functions    * */
+/* *             - implemented getimgdata functions                         * */
+/* *             - added mng_set_filterselection/mng_get_filterselection    * */
+/* *             - added mng_get_dirtyrectcount & mng_get_dirtyrect         * */
+/* *             - added memory-pool for chunk-structures and animation-    * */
+/* *               objects                                                  * */
+/* *             - added MNG_SIMD_PCLMUL & MNG_SIMD_CRC32 flags             * */
+/* *             - documented in-place processing of pushed data            * */
+/* *             - added mng_read_memory                                    * */
+/* *             - 16-bit canvas styles are now supported                   * */
+/* *             - gray canvas styles are now supported                     * */
+/* *             - added mng_set_cmscache/mng_get_cmscachehits/misses       * */
+/* *             - documented that handles are independent between threads  * */
+/* *             - added mng_set_decodethreads/mng_get_decodethreads        * */
+/* *             - added mng_render_frames and                              * */
+/* *               mng_set_virtualclock/mng_get_virtualclock                * */
+/* *             - added mng_putframe frame-sequence encoder                * */
+/* *             - added mng_set_lazymagnify/mng_get_lazymagnify            * */
+/* *             - mng_set/get_filterselection use the same conditionals as * */
+/* *               their definitions                                        * */
+/* *             - MNG_EMULATE_NEON selects the NEON code on any cpu        * */
+/* *               (for contrib/gcc/mngcheck)                               * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -370,6 +395,38 @@
 #define MNG_INCLUDE_ERROR_STRINGS
 #endif
 
+#ifdef MNG_SUPPORT_SIMD
+#if defined(__aarch64__) || defined(MNG_EMULATE_NEON)
+#define MNG_INCLUDE_SIMD_NEON          /* MNG_EMULATE_NEON is for checking the
+                                          NEON code on another cpu; see
+                                          contrib/gcc/mngcheck */
+#elif defined(__i386__) || defined(__x86_64__)
+#define MNG_INCLUDE_SIMD_X86
+#endif
+#endif
+
+#ifdef MNG_SUPPORT_PARALLEL            /* the workers only serve the reader */
+#if !defined(MNG_SUPPORT_DISPLAY) || !defined(MNG_SUPPORT_READ)
+#undef MNG_SUPPORT_PARALLEL
+#endif
+#endif
+
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_SUPPORT_READ)
+#if !defined(MNG_NO_DISPLAY_GO_SUPPORTED) && !defined(MNG_NO_KEYFRAMES)
+#define MNG_SUPPORT_KEYFRAMES
+#endif
+#endif
+
+#ifndef MNG_NO_MEMPOOL
+#define MNG_SUPPORT_MEMPOOL
+#endif
+
+#if defined(MNG_SUPPORT_WRITE) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_INCLUDE_ZLIB)
+#if !defined(MNG_NO_DELTA_PNG) && !defined(MNG_SKIPCHUNK_FRAM) && !defined(MNG_SKIPCHUNK_CLIP)
+#define MNG_SUPPORT_ENCODER            /* mng_putframe */
+#endif
+#endif
+
 #ifdef MNG_OPTIMIZE_CHUNKINITFREE
 #ifndef MNG_OPTIMIZE_CHUNKACCESS
 #define MNG_OPTIMIZE_CHUNKACCESS
@@ -500,6 +557,8 @@ MNG_EXT mng_bool  MNG_DECL mng_supports_func     (mng_pchar  zFunction,
 /* library initialization function */
 /* must be the first called before anything can be done at all */
 /* initializes internal datastructure(s) */
+/* handles are independent of each other; different threads may each use
+   their own handle at the same time (see doc/libmng.txt) */
 MNG_EXT mng_handle  MNG_DECL mng_initialize      (mng_ptr       pUserdata,
                                                   mng_memalloc  fMemalloc,
                                                   mng_memfree   fMemfree,
@@ -528,6 +587,20 @@ MNG_EXT mng_retcode MNG_DECL mng_read            (mng_handle    hHandle);
 MNG_EXT mng_retcode MNG_DECL mng_read_resume     (mng_handle    hHandle);
 #endif
 
+/* read from memory */
+/* mng_read_memory reads a complete Network Graphic that is already in memory
+   (eg. a memory-mapped file); the readdata, openstream & closestream
+   callbacks are not used; the chunks are indexed in a single pass and
+   processed straight from the supplied buffer, which must contain the
+   signature (unless mng_read_pushsig was called) */
+/* libmng never frees or writes to the buffer; it must remain available until
+   mng_reset or mng_cleanup is called on the handle */
+#ifdef MNG_SUPPORT_READ
+MNG_EXT mng_retcode MNG_DECL mng_read_memory     (mng_handle    hHandle,
+                                                  mng_ptr       pBuf,
+                                                  mng_size_t    iLength);
+#endif
+
 /* high-level "data push" functions */
 /* these functions can be used in situations where data is streaming into the
    application and needs to be buffered by libmng before it is actually
@@ -560,6 +633,10 @@ MNG_EXT mng_retcode MNG_DECL mng_read_resume     (mng_handle    hHandle);
    or the memfree() callback */
 /* if bOwnership = MNG_FALSE, libmng will just copy the data into its own
    buffers and dispose of it in the normal way */
+/* chunks that lie completely within one pushed buffer are processed directly
+   from that buffer; only chunks spanning several buffers are copied, so
+   pushing larger blobs with bOwnership = MNG_TRUE avoids nearly all copying
+   (this also holds when suspension-mode is on) */
 #ifdef MNG_SUPPORT_READ
 MNG_EXT mng_retcode MNG_DECL mng_read_pushdata   (mng_handle    hHandle,
                                                   mng_ptr       pData,
@@ -611,6 +688,25 @@ MNG_EXT mng_retcode MNG_DECL mng_display_gotime  (mng_handle    hHandle,
 #endif
 #endif /* MNG_SUPPORT_DISPLAY */
 
+/* headless rendering */
+/* mng_render_frames displays a previously read graphic as fast as possible,
+   on the virtual clock (see mng_set_virtualclock), and calls fProc for each
+   finished frame with its delay in ticks and the update region of the frame
+   (width & height are 0 if nothing changed); mng_get_dirtyrect can be used
+   in the callback for the individual rectangles */
+/* without a getcanvasline callback libmng renders into a canvas of its own
+   (not for the separate-alpha canvas styles); pCanvas & iRowsize then
+   point to its first line and give the distance between lines; the canvas
+   stays valid until mng_cleanup; with an app canvas they are NULL & 0; the
+   refresh callback is optional */
+/* returning MNG_FALSE from fProc stops at that frame and the function
+   returns MNG_NEEDTIMERWAIT; calling it again continues with the next frame,
+   which is also how animations that loop forever must be ended */
+#ifdef MNG_SUPPORT_DISPLAY
+MNG_EXT mng_retcode MNG_DECL mng_render_frames   (mng_handle      hHandle,
+                                                  mng_renderframe fProc);
+#endif
+
 /* event processing function */
 /* this needs to be called by the app when dynamic MNG is enabled and
    a specific event occurs in the user-interface */
@@ -959,6 +1055,46 @@ MNG_EXT mng_retcode MNG_DECL mng_set_doprogressive   (mng_handle        hHandle,
 MNG_EXT mng_retcode MNG_DECL mng_set_crcmode         (mng_handle        hHandle,
                                                       mng_uint32        iCrcmode);
 
+/* Restricts the vectorized routines the library may use */
+/* the library detects the capabilities of the CPU during mng_initialize()
+   and by default uses all of them; the value is a combination of the
+   MNG_SIMD_xxxx flags (see below) and is masked with the detected
+   capabilities; use MNG_SIMD_NONE to force the portable routines, which
+   may be useful for testing or benchmarking; the same flags also select the
+   crc engine used for reading and writing chunks */
+#ifdef MNG_SUPPORT_SIMD
+MNG_EXT mng_retcode MNG_DECL mng_set_simd            (mng_handle        hHandle,
+                                                      mng_uint32        iSIMD);
+#endif
+
+/* Keyframe cache for the mng_display_goxxxx() functions (OFF by default!) */
+/* when turned on the library takes a snapshot of the canvas, the objects and
+   the playback state every iInterval frames while the animation is played;
+   mng_display_goframe(), _golayer() and _gotime() then resume from the
+   nearest preceding snapshot instead of replaying from the first frame;
+   iMaxmemory limits the total size of the snapshots in bytes (0 = no limit);
+   if the limit is reached the interval is doubled and every other snapshot
+   is dropped; calling this function always drops the current snapshots, so
+   call it again after changing the canvas or background settings;
+   use an iInterval of 0 to turn the cache off */
+#ifdef MNG_SUPPORT_KEYFRAMES
+MNG_EXT mng_retcode MNG_DECL mng_set_keyframecache   (mng_handle        hHandle,
+                                                      mng_uint32        iInterval,
+                                                      mng_uint32        iMaxmemory);
+#endif
+
+/* Memory-pool */
+/* when on, chunk-structures and animation-objects are handed out from pools
+   of size-classed blocks, which are obtained through the memalloc callback
+   and released all at once by mng_reset/mng_cleanup; this saves the many
+   small allocations of long animations; it can only be switched while no
+   chunks or animation-objects are stored (eg. before reading or after
+   mng_reset) */
+#ifdef MNG_SUPPORT_MEMPOOL
+MNG_EXT mng_retcode MNG_DECL mng_set_mempool         (mng_handle        hHandle,
+                                                      mng_bool          bMempool);
+#endif
+
 /* Color-management necessaries */
 /*
     *************************************************************************
@@ -1024,6 +1160,52 @@ MNG_EXT mng_retcode MNG_DECL mng_set_srgbprofile2    (mng_handle        hHandle,
 MNG_EXT mng_retcode MNG_DECL mng_set_srgbimplicit    (mng_handle        hHandle);
 #endif
 
+/* Transform cache (full cms only) */
+/* the lcms transforms created for the color-chunks of an image are kept and
+   reused by later images with the same chunks (and profile); iSize is the
+   number of transforms kept (at most and by default 8; 0 turns it off);
+   the cache is emptied by this function and whenever the output or sRGB
+   profile is changed */
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_FULL_CMS)
+MNG_EXT mng_retcode MNG_DECL mng_set_cmscache        (mng_handle        hHandle,
+                                                      mng_uint32        iSize);
+#endif
+
+/* Parallel decoding (OFF by default!) */
+/* with iThreads > 0 mng_read_memory starts that many worker-threads (at most
+   16) to inflate & unfilter the embedded PNG-images (IHDR..IEND) of an MNG
+   ahead of the reader; storing them in their objects, delta-images, JNGs
+   and all display-processing still happen one after the other on the
+   calling thread, which also takes on a job itself rather than wait for it;
+   the workers never call any callbacks and are stopped when the reading is
+   done (or by mng_reset/mng_cleanup); it can't be changed while reading */
+#ifdef MNG_SUPPORT_PARALLEL
+MNG_EXT mng_retcode MNG_DECL mng_set_decodethreads   (mng_handle        hHandle,
+                                                      mng_uint32        iThreads);
+#endif
+
+/* Virtual clock (OFF by default) */
+/* with bVirtualclock = MNG_TRUE the display no longer uses the gettickcount
+   & settimer callbacks; the library keeps its own clock, which jumps ahead
+   by the requested interval at each timer-break, so the app can call
+   mng_display_resume right after MNG_NEEDTIMERWAIT (for offline rendering,
+   transcoding, etc.) */
+#ifdef MNG_SUPPORT_DISPLAY
+MNG_EXT mng_retcode MNG_DECL mng_set_virtualclock    (mng_handle        hHandle,
+                                                      mng_bool          bVirtualclock);
+#endif
+
+/* Magnify while displaying (OFF by default) */
+/* with bLazymagnify = MNG_TRUE a MAGN'ed 8-bit object (not indexed and
+   without tRNS) is magnified row by row while it is being displayed; the
+   object itself keeps its original size, so the full-size copy is never
+   built; the rendered pixels are identical, but the magnification is then
+   repeated each time the object is shown */
+#if defined(MNG_SUPPORT_DISPLAY) && !defined(MNG_SKIPCHUNK_MAGN)
+MNG_EXT mng_retcode MNG_DECL mng_set_lazymagnify     (mng_handle        hHandle,
+                                                      mng_bool          bLazymagnify);
+#endif
+
 #if defined(MNG_FULL_CMS) || defined(MNG_GAMMA_ONLY) || defined(MNG_APP_CMS)
 /* Gamma settings */
 /* ... blabla (explain gamma processing a little; eg. formula & stuff) ... */
@@ -1079,6 +1261,16 @@ MNG_EXT mng_retcode MNG_DECL mng_set_zlib_maxidat    (mng_handle        hHandle,
                                                       mng_uint32        iMaxIDAT);
 #endif /* MNG_INCLUDE_ZLIB */
 
+#if defined(MNG_INCLUDE_ZLIB) && defined(MNG_ACCESS_ZLIB) && defined(MNG_SUPPORT_WRITE)
+/* filter-selection for the PNG image-data compressed by mng_putimgdata_ihdr;
+   each row gets the filter with the smallest sum of absolute differences
+   from the set of candidates: MNG_FILTERSEL_NONE never filters,
+   MNG_FILTERSEL_FAST tries none, sub & up, and MNG_FILTERSEL_FULL (default)
+   tries all five; together with the zlib level this trades speed for size */
+MNG_EXT mng_retcode MNG_DECL mng_set_filterselection (mng_handle        hHandle,
+                                                      mng_uint8         iFiltersel);
+#endif
+
 /* JNG default compression parameters (based on IJG code) */
 /* these are used when compressing JNG image-data; so you can set them
    just before calling mng_putimgdata_jhdr */
@@ -1206,11 +1398,69 @@ MNG_EXT mng_bool    MNG_DECL mng_get_doprogressive   (mng_handle        hHandle)
 /* see _set_ */
 MNG_EXT mng_uint32  MNG_DECL mng_get_crcmode         (mng_handle        hHandle);
 
+/* see _set_ */
+#ifdef MNG_SUPPORT_SIMD
+MNG_EXT mng_uint32  MNG_DECL mng_get_simd            (mng_handle        hHandle);
+#endif
+
+/* see _set_ */
+#ifdef MNG_SUPPORT_PARALLEL
+MNG_EXT mng_uint32  MNG_DECL mng_get_decodethreads   (mng_handle        hHandle);
+#endif
+
+/* see _set_ */
+#ifdef MNG_SUPPORT_DISPLAY
+MNG_EXT mng_bool    MNG_DECL mng_get_virtualclock    (mng_handle        hHandle);
+#endif
+
+/* see _set_ */
+#if defined(MNG_SUPPORT_DISPLAY) && !defined(MNG_SKIPCHUNK_MAGN)
+MNG_EXT mng_bool    MNG_DECL mng_get_lazymagnify     (mng_handle        hHandle);
+#endif
+
+/* Keyframe cache statistics */
+/* the number of snapshots held and the memory they occupy (in bytes) */
+#ifdef MNG_SUPPORT_KEYFRAMES
+MNG_EXT mng_uint32  MNG_DECL mng_get_keyframecount   (mng_handle        hHandle);
+MNG_EXT mng_uint32  MNG_DECL mng_get_keyframememory  (mng_handle        hHandle);
+#endif
+
+/* Dirty-rectangles */
+/* the changed canvas areas within the region of the last refresh callback;
+   call these from inside that callback (or before the next one) to update
+   only the pixels that actually changed */
+#ifdef MNG_SUPPORT_DISPLAY
+MNG_EXT mng_uint32  MNG_DECL mng_get_dirtyrectcount  (mng_handle        hHandle);
+MNG_EXT mng_retcode MNG_DECL mng_get_dirtyrect       (mng_handle        hHandle,
+                                                      mng_uint32        iIndex,
+                                                      mng_uint32*       iX,
+                                                      mng_uint32*       iY,
+                                                      mng_uint32*       iWidth,
+                                                      mng_uint32*       iHeight);
+#endif
+
+/* Memory-pool */
+/* see _set_; also the bytes currently held by the structures in the pool
+   and the highest that has been since the handle was created */
+#ifdef MNG_SUPPORT_MEMPOOL
+MNG_EXT mng_bool    MNG_DECL mng_get_mempool         (mng_handle        hHandle);
+MNG_EXT mng_uint32  MNG_DECL mng_get_mempoolcurrent  (mng_handle        hHandle);
+MNG_EXT mng_uint32  MNG_DECL mng_get_mempoolpeak     (mng_handle        hHandle);
+#endif
+
 /* see _set_ */
 #if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_FULL_CMS)
 MNG_EXT mng_bool    MNG_DECL mng_get_srgb            (mng_handle        hHandle);
 #endif
 
+/* Transform cache */
+/* see _set_; the number of images that found their transform in the cache
+   and the number that had to create one (since the handle was created) */
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_FULL_CMS)
+MNG_EXT mng_uint32  MNG_DECL mng_get_cmscachehits    (mng_handle        hHandle);
+MNG_EXT mng_uint32  MNG_DECL mng_get_cmscachemisses  (mng_handle        hHandle);
+#endif
+
 /* see _set_ */
 MNG_EXT mng_float   MNG_DECL mng_get_viewgamma       (mng_handle        hHandle);
 MNG_EXT mng_float   MNG_DECL mng_get_displaygamma    (mng_handle        hHandle);
@@ -1236,6 +1486,10 @@ MNG_EXT mng_int32   MNG_DECL mng_get_zlib_strategy   (mng_handle        hHandle)
 MNG_EXT mng_uint32  MNG_DECL mng_get_zlib_maxidat    (mng_handle        hHandle);
 #endif /* MNG_INCLUDE_ZLIB */
 
+#if defined(MNG_INCLUDE_ZLIB) && defined(MNG_ACCESS_ZLIB)
+MNG_EXT mng_uint8   MNG_DECL mng_get_filterselection (mng_handle        hHandle);
+#endif
+
 /* see _set_ */
 #ifdef MNG_INCLUDE_JNG
 #ifdef MNG_INCLUDE_IJG6B
@@ -2296,6 +2550,13 @@ MNG_EXT mng_retcode MNG_DECL mng_putchunk_unknown    (mng_handle       hHandle,
    bitdepth/colortype combination of the preceding IHDR/JHDR/BASI/DHDR;
    all input can be converted to rgb(a)8 (rgb(a)16 for 16-bit images), but
    there are only limited conversions back (see below for putimgdata)  */
+/* the image-data is decoded straight from the stored chunks into the supplied
+   canvas-lines; it is delivered "raw": no gamma- or color-correction is
+   applied and nothing is composed onto a background; only the RGB/BGR/gray
+   canvasstyles (8- or 16-bit, with or without (premultiplied) alpha or filler)
+   are supported; separate-alpha and 565/555 styles return MNG_INVALIDCNVSTYLE;
+   JNG images and DHDR with anything but a full image-replacement return
+   MNG_FNNOTIMPLEMENTED; the functions can't be used while displaying */
 
 /* call this function if you want to extract the nth image from the list;
    the first image is designated seqnr 0! */
@@ -2344,6 +2605,14 @@ MNG_EXT mng_retcode MNG_DECL mng_getimgdata_chunk    (mng_handle        hHandle,
    colortype=g or ga would expect a gray or gray+alpha style respectively
    and so on, and so forth ...
    (nb. the number of conversions will be extremely limited for the moment!) */
+/* mng_putimgdata_ihdr reads the rows through fGetcanvasline, packs them into
+   the requested colortype & bitdepth, filters them (see
+   mng_set_filterselection) and deflates them with the zlib parameters into
+   IDAT chunks of at most mng_get_zlib_maxidat bytes each; the RGB/BGR/gray
+   canvasstyles (8- or 16-bit, with or without alpha or filler) are accepted;
+   rgb input is converted to gray for the gray colortypes; for indexed-color
+   the GRAY8 canvasstyle is expected and the samples are taken as the palette
+   indices; premultiplied, separate-alpha and 565/555 styles are rejected */
 
 MNG_EXT mng_retcode MNG_DECL mng_putimgdata_ihdr     (mng_handle        hHandle,
                                                       mng_uint32        iWidth,
@@ -2372,6 +2641,30 @@ MNG_EXT mng_retcode MNG_DECL mng_putimgdata_jhdr     (mng_handle        hHandle,
 
 /* ************************************************************************** */
 
+#ifdef MNG_SUPPORT_ENCODER
+/* mng_putframe turns a sequence of whole frames into the chunks of an
+   animation; put the MHDR (and anything global like TERM or BACK) first,
+   then call it once per frame, and finish with mng_putchunk_mend;
+   each frame is read through fGetcanvasline as MHDR-width x MHDR-height
+   pixels in the MNG_CANVAS_RGBA8 style; iDelay is the time in ticks the
+   frame stays on display; the first frame becomes a full image in object 1,
+   every next one is compared with its predecessor and only the changed
+   block is stored as a delta-PNG (pixel-add or pixel-replace, whichever
+   compresses better), unless a new full image turns out smaller; a frame
+   identical to the previous one adds its delay to that one and costs
+   nothing; opaque changes are redrawn through a CLIP of object 1, so the
+   player only recomposes the changed block; the filter-selection & zlib
+   parameters of mng_putimgdata_ihdr apply */
+/* note that the chunks should not be changed in between calls, as the
+   encoder keeps track of the state of object 1 */
+MNG_EXT mng_retcode MNG_DECL mng_putframe            (mng_handle        hHandle,
+                                                      mng_uint32        iDelay,
+                                                      mng_uint32        iCanvasstyle,
+                                                      mng_getcanvasline fGetcanvasline);
+#endif
+
+/* ************************************************************************** */
+
 /* use the following functions to set the framecount/layercount/playtime or
    simplicity of an animation you are creating; this may be useful if these
    variables are calculated during the creation-process */
@@ -2514,6 +2807,12 @@ MNG_EXT mng_retcode MNG_DECL mng_updatemngsimplicity (mng_handle        hHandle,
 /* *  canvas for the color-planes and the alpha-plane (eg. mozilla)         * */
 /* *  This requires for the app to supply the "getalphaline" callback!!!    * */
 /* *                                                                        * */
+/* *  The 16-bit styles hold each sample in network byte-order (MSB first); * */
+/* *  RGB16 & BGR16 may also be used as background style                    * */
+/* *                                                                        * */
+/* *  The gray styles receive the luminance of color images; gray images    * */
+/* *  are processed without expanding them to RGB                           * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #define MNG_CANVAS_RGB8      0x00000000L
@@ -2529,18 +2828,18 @@ MNG_EXT mng_retcode MNG_DECL mng_updatemngsimplicity (mng_handle        hHandle,
 #define MNG_CANVAS_BGRA8_PM  0x00009001L
 #define MNG_CANVAS_ABGR8     0x00003001L
 #define MNG_CANVAS_ABGR8_PM  0x0000B001L
-#define MNG_CANVAS_RGB16     0x00000100L         /* not supported yet */
-#define MNG_CANVAS_RGBA16    0x00001100L         /* not supported yet */
-#define MNG_CANVAS_ARGB16    0x00003100L         /* not supported yet */
-#define MNG_CANVAS_BGR16     0x00000101L         /* not supported yet */
-#define MNG_CANVAS_BGRA16    0x00001101L         /* not supported yet */
-#define MNG_CANVAS_ABGR16    0x00003101L         /* not supported yet */
-#define MNG_CANVAS_GRAY8     0x00000002L         /* not supported yet */
-#define MNG_CANVAS_GRAY16    0x00000102L         /* not supported yet */
-#define MNG_CANVAS_GRAYA8    0x00001002L         /* not supported yet */
-#define MNG_CANVAS_GRAYA16   0x00001102L         /* not supported yet */
-#define MNG_CANVAS_AGRAY8    0x00003002L         /* not supported yet */
-#define MNG_CANVAS_AGRAY16   0x00003102L         /* not supported yet */
+#define MNG_CANVAS_RGB16     0x00000100L
+#define MNG_CANVAS_RGBA16    0x00001100L
+#define MNG_CANVAS_ARGB16    0x00003100L
+#define MNG_CANVAS_BGR16     0x00000101L
+#define MNG_CANVAS_BGRA16    0x00001101L
+#define MNG_CANVAS_ABGR16    0x00003101L
+#define MNG_CANVAS_GRAY8     0x00000002L
+#define MNG_CANVAS_GRAY16    0x00000102L
+#define MNG_CANVAS_GRAYA8    0x00001002L
+#define MNG_CANVAS_GRAYA16   0x00001102L
+#define MNG_CANVAS_AGRAY8    0x00003002L
+#define MNG_CANVAS_AGRAY16   0x00003102L
 #define MNG_CANVAS_DX15      0x00000003L         /* not supported yet */
 #define MNG_CANVAS_DX16      0x00000004L         /* not supported yet */
 
@@ -2683,6 +2982,10 @@ MNG_EXT mng_retcode MNG_DECL mng_updatemngsimplicity (mng_handle        hHandle,
 #define MNG_FILTER_AVERAGE               3
 #define MNG_FILTER_PAETH                 4
 
+#define MNG_FILTERSEL_NONE               0       /* putimgdata filter-selection */
+#define MNG_FILTERSEL_FAST               1
+#define MNG_FILTERSEL_FULL               2
+
 #define MNG_INTENT_PERCEPTUAL            0       /* sRGB */
 #define MNG_INTENT_RELATIVECOLORIMETRIC  1
 #define MNG_INTENT_SATURATION            2
@@ -2918,6 +3221,20 @@ MNG_EXT mng_retcode MNG_DECL mng_updatemngsimplicity (mng_handle        hHandle,
 #define MNG_CRC_CRITICAL_ERROR     0x00003000
 #define MNG_CRC_DEFAULT            0x00002121
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* *  SIMD capability flags                                                 * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#define MNG_SIMD_NONE              0x00000000
+#define MNG_SIMD_SSE2              0x00000001
+#define MNG_SIMD_AVX2              0x00000002
+#define MNG_SIMD_PCLMUL            0x00000004     /* crc folding */
+#define MNG_SIMD_NEON              0x00000010
+#define MNG_SIMD_CRC32             0x00000020     /* ARMv8 crc instructions */
+#define MNG_SIMD_ALL               0x0000ffff
+
 /* ************************************************************************** */
 
 #ifdef __cplusplus
@@ -21,6 +21,10 @@
 /* *             1.0.10 - 04/12/2007 - G.Juyn                               * */
 /* *             - added support for ANG proposal                           * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - mng_get_chunkheader is available without                 * */
+/* *               MNG_OPTIMIZE_CHUNKREADER                                 * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -32,7 +36,6 @@
 
 /* ************************************************************************** */
 
-#ifdef MNG_OPTIMIZE_CHUNKREADER
 #if defined(MNG_INCLUDE_READ_PROCS) || defined(MNG_INCLUDE_WRITE_PROCS)
 
 /* ************************************************************************** */
@@ -42,6 +45,15 @@ void mng_get_chunkheader (mng_chunkid       iChunkname,
 
 /* ************************************************************************** */
 
+#endif /* MNG_INCLUDE_READ_PROCS || MNG_INCLUDE_WRITE_PROCS */
+
+/* ************************************************************************** */
+
+#ifdef MNG_OPTIMIZE_CHUNKREADER
+#if defined(MNG_INCLUDE_READ_PROCS) || defined(MNG_INCLUDE_WRITE_PROCS)
+
+/* ************************************************************************** */
+
 #define MNG_F_SPECIALFUNC(n) mng_retcode n (mng_datap   pData,    \
                                             mng_chunkp  pChunk,   \
                                             mng_uint32* piRawlen, \
@@ -73,6 +73,10 @@
 /* *             1.0.10 - 04/12/2007 - G.Juyn                               * */
 /* *             - added support for ANG proposal                           * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - chunk-structures are allocated from the memory-pool when * */
+/* *               on                                                       * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -144,7 +148,7 @@ void mng_add_chunk (mng_datap  pData,
 #ifdef MNG_OPTIMIZE_CHUNKINITFREE
 INIT_CHUNK_HDR (mng_init_general)
 {
-  MNG_ALLOC (pData, *ppChunk, ((mng_chunk_headerp)pHeader)->iChunksize);
+  MNG_ALLOCP (pData, *ppChunk, ((mng_chunk_headerp)pHeader)->iChunksize);
   MNG_COPY (*ppChunk, pHeader, sizeof (mng_chunk_header));
   return MNG_NOERROR;
 }
@@ -159,7 +163,7 @@ INIT_CHUNK_HDR (mng_init_ihdr)
   MNG_TRACE (pData, MNG_FN_INIT_IHDR, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_ihdr));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_ihdr));
   ((mng_ihdrp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -177,7 +181,7 @@ INIT_CHUNK_HDR (mng_init_plte)
   MNG_TRACE (pData, MNG_FN_INIT_PLTE, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_plte));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_plte));
   ((mng_pltep)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -195,7 +199,7 @@ INIT_CHUNK_HDR (mng_init_idat)
   MNG_TRACE (pData, MNG_FN_INIT_IDAT, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_idat));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_idat));
   ((mng_idatp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -213,7 +217,7 @@ INIT_CHUNK_HDR (mng_init_iend)
   MNG_TRACE (pData, MNG_FN_INIT_IEND, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_iend));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_iend));
   ((mng_iendp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -231,7 +235,7 @@ INIT_CHUNK_HDR (mng_init_trns)
   MNG_TRACE (pData, MNG_FN_INIT_TRNS, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_trns));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_trns));
   ((mng_trnsp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -250,7 +254,7 @@ INIT_CHUNK_HDR (mng_init_gama)
   MNG_TRACE (pData, MNG_FN_INIT_GAMA, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_gama));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_gama));
   ((mng_gamap)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -270,7 +274,7 @@ INIT_CHUNK_HDR (mng_init_chrm)
   MNG_TRACE (pData, MNG_FN_INIT_CHRM, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_chrm));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_chrm));
   ((mng_chrmp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -290,7 +294,7 @@ INIT_CHUNK_HDR (mng_init_srgb)
   MNG_TRACE (pData, MNG_FN_INIT_SRGB, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_srgb));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_srgb));
   ((mng_srgbp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -310,7 +314,7 @@ INIT_CHUNK_HDR (mng_init_iccp)
   MNG_TRACE (pData, MNG_FN_INIT_ICCP, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_iccp));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_iccp));
   ((mng_iccpp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -330,7 +334,7 @@ INIT_CHUNK_HDR (mng_init_text)
   MNG_TRACE (pData, MNG_FN_INIT_TEXT, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_text));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_text));
   ((mng_textp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -350,7 +354,7 @@ INIT_CHUNK_HDR (mng_init_ztxt)
   MNG_TRACE (pData, MNG_FN_INIT_ZTXT, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_ztxt));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_ztxt));
   ((mng_ztxtp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -370,7 +374,7 @@ INIT_CHUNK_HDR (mng_init_itxt)
   MNG_TRACE (pData, MNG_FN_INIT_ITXT, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_itxt));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_itxt));
   ((mng_itxtp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -390,7 +394,7 @@ INIT_CHUNK_HDR (mng_init_bkgd)
   MNG_TRACE (pData, MNG_FN_INIT_BKGD, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_bkgd));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_bkgd));
   ((mng_bkgdp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -410,7 +414,7 @@ INIT_CHUNK_HDR (mng_init_phys)
   MNG_TRACE (pData, MNG_FN_INIT_PHYS, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_phys));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_phys));
   ((mng_physp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -430,7 +434,7 @@ INIT_CHUNK_HDR (mng_init_sbit)
   MNG_TRACE (pData, MNG_FN_INIT_SBIT, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_sbit));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_sbit));
   ((mng_sbitp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -450,7 +454,7 @@ INIT_CHUNK_HDR (mng_init_splt)
   MNG_TRACE (pData, MNG_FN_INIT_SPLT, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_splt));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_splt));
   ((mng_spltp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -470,7 +474,7 @@ INIT_CHUNK_HDR (mng_init_hist)
   MNG_TRACE (pData, MNG_FN_INIT_HIST, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_hist));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_hist));
   ((mng_histp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -490,7 +494,7 @@ INIT_CHUNK_HDR (mng_init_time)
   MNG_TRACE (pData, MNG_FN_INIT_TIME, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_time));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_time));
   ((mng_timep)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -509,7 +513,7 @@ INIT_CHUNK_HDR (mng_init_mhdr)
   MNG_TRACE (pData, MNG_FN_INIT_MHDR, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_mhdr));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_mhdr));
   ((mng_mhdrp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -527,7 +531,7 @@ INIT_CHUNK_HDR (mng_init_mend)
   MNG_TRACE (pData, MNG_FN_INIT_MEND, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_mend));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_mend));
   ((mng_mendp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -546,7 +550,7 @@ INIT_CHUNK_HDR (mng_init_loop)
   MNG_TRACE (pData, MNG_FN_INIT_LOOP, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_loop));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_loop));
   ((mng_loopp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -564,7 +568,7 @@ INIT_CHUNK_HDR (mng_init_endl)
   MNG_TRACE (pData, MNG_FN_INIT_ENDL, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_endl));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_endl));
   ((mng_endlp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -584,7 +588,7 @@ INIT_CHUNK_HDR (mng_init_defi)
   MNG_TRACE (pData, MNG_FN_INIT_DEFI, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_defi));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_defi));
   ((mng_defip)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -604,7 +608,7 @@ INIT_CHUNK_HDR (mng_init_basi)
   MNG_TRACE (pData, MNG_FN_INIT_BASI, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_basi));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_basi));
   ((mng_basip)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -624,7 +628,7 @@ INIT_CHUNK_HDR (mng_init_clon)
   MNG_TRACE (pData, MNG_FN_INIT_CLON, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_clon));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_clon));
   ((mng_clonp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -644,7 +648,7 @@ INIT_CHUNK_HDR (mng_init_past)
   MNG_TRACE (pData, MNG_FN_INIT_PAST, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_past));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_past));
   ((mng_pastp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -664,7 +668,7 @@ INIT_CHUNK_HDR (mng_init_disc)
   MNG_TRACE (pData, MNG_FN_INIT_DISC, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_disc));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_disc));
   ((mng_discp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -684,7 +688,7 @@ INIT_CHUNK_HDR (mng_init_back)
   MNG_TRACE (pData, MNG_FN_INIT_BACK, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_back));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_back));
   ((mng_backp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -704,7 +708,7 @@ INIT_CHUNK_HDR (mng_init_fram)
   MNG_TRACE (pData, MNG_FN_INIT_FRAM, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_fram));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_fram));
   ((mng_framp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -724,7 +728,7 @@ INIT_CHUNK_HDR (mng_init_move)
   MNG_TRACE (pData, MNG_FN_INIT_MOVE, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_move));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_move));
   ((mng_movep)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -744,7 +748,7 @@ INIT_CHUNK_HDR (mng_init_clip)
   MNG_TRACE (pData, MNG_FN_INIT_CLIP, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_clip));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_clip));
   ((mng_clipp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -764,7 +768,7 @@ INIT_CHUNK_HDR (mng_init_show)
   MNG_TRACE (pData, MNG_FN_INIT_SHOW, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_show));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_show));
   ((mng_showp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -784,7 +788,7 @@ INIT_CHUNK_HDR (mng_init_term)
   MNG_TRACE (pData, MNG_FN_INIT_TERM, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_term));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_term));
   ((mng_termp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -804,7 +808,7 @@ INIT_CHUNK_HDR (mng_init_save)
   MNG_TRACE (pData, MNG_FN_INIT_SAVE, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_save));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_save));
   ((mng_savep)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -825,7 +829,7 @@ INIT_CHUNK_HDR (mng_init_seek)
   MNG_TRACE (pData, MNG_FN_INIT_SEEK, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_seek));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_seek));
   ((mng_seekp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -845,7 +849,7 @@ INIT_CHUNK_HDR (mng_init_expi)
   MNG_TRACE (pData, MNG_FN_INIT_EXPI, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_expi));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_expi));
   ((mng_expip)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -865,7 +869,7 @@ INIT_CHUNK_HDR (mng_init_fpri)
   MNG_TRACE (pData, MNG_FN_INIT_FPRI, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_fpri));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_fpri));
   ((mng_fprip)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -885,7 +889,7 @@ INIT_CHUNK_HDR (mng_init_need)
   MNG_TRACE (pData, MNG_FN_INIT_NEED, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_need));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_need));
   ((mng_needp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -905,7 +909,7 @@ INIT_CHUNK_HDR (mng_init_phyg)
   MNG_TRACE (pData, MNG_FN_INIT_PHYG, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_phyg));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_phyg));
   ((mng_phygp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -925,7 +929,7 @@ INIT_CHUNK_HDR (mng_init_jhdr)
   MNG_TRACE (pData, MNG_FN_INIT_JHDR, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_jhdr));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_jhdr));
   ((mng_jhdrp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -945,7 +949,7 @@ INIT_CHUNK_HDR (mng_init_jdaa)
   MNG_TRACE (pData, MNG_FN_INIT_JDAA, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_jdaa));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_jdaa));
   ((mng_jdaap)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -965,7 +969,7 @@ INIT_CHUNK_HDR (mng_init_jdat)
   MNG_TRACE (pData, MNG_FN_INIT_JDAT, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_jdat));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_jdat));
   ((mng_jdatp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -985,7 +989,7 @@ INIT_CHUNK_HDR (mng_init_jsep)
   MNG_TRACE (pData, MNG_FN_INIT_JSEP, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_jsep));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_jsep));
   ((mng_jsepp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1005,7 +1009,7 @@ INIT_CHUNK_HDR (mng_init_dhdr)
   MNG_TRACE (pData, MNG_FN_INIT_DHDR, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_dhdr));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_dhdr));
   ((mng_dhdrp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1025,7 +1029,7 @@ INIT_CHUNK_HDR (mng_init_prom)
   MNG_TRACE (pData, MNG_FN_INIT_PROM, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_prom));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_prom));
   ((mng_promp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1045,7 +1049,7 @@ INIT_CHUNK_HDR (mng_init_ipng)
   MNG_TRACE (pData, MNG_FN_INIT_IPNG, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_ipng));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_ipng));
   ((mng_ipngp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1065,7 +1069,7 @@ INIT_CHUNK_HDR (mng_init_pplt)
   MNG_TRACE (pData, MNG_FN_INIT_PPLT, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_pplt));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_pplt));
   ((mng_ppltp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1086,7 +1090,7 @@ INIT_CHUNK_HDR (mng_init_ijng)
   MNG_TRACE (pData, MNG_FN_INIT_IJNG, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_ijng));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_ijng));
   ((mng_ijngp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1107,7 +1111,7 @@ INIT_CHUNK_HDR (mng_init_drop)
   MNG_TRACE (pData, MNG_FN_INIT_DROP, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_drop));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_drop));
   ((mng_dropp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1129,7 +1133,7 @@ INIT_CHUNK_HDR (mng_init_dbyk)
   MNG_TRACE (pData, MNG_FN_INIT_DBYK, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_dbyk));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_dbyk));
   ((mng_dbykp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1151,7 +1155,7 @@ INIT_CHUNK_HDR (mng_init_ordr)
   MNG_TRACE (pData, MNG_FN_INIT_ORDR, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_ordr));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_ordr));
   ((mng_ordrp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1172,7 +1176,7 @@ INIT_CHUNK_HDR (mng_init_magn)
   MNG_TRACE (pData, MNG_FN_INIT_MAGN, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_magn));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_magn));
   ((mng_magnp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1192,7 +1196,7 @@ INIT_CHUNK_HDR (mng_init_evnt)
   MNG_TRACE (pData, MNG_FN_INIT_EVNT, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_evnt));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_evnt));
   ((mng_evntp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1211,7 +1215,7 @@ INIT_CHUNK_HDR (mng_init_unknown)
   MNG_TRACE (pData, MNG_FN_INIT_UNKNOWN, MNG_LC_START);
 #endif
 
-  MNG_ALLOC (pData, *ppChunk, sizeof (mng_unknown_chunk));
+  MNG_ALLOCP (pData, *ppChunk, sizeof (mng_unknown_chunk));
   ((mng_unknown_chunkp)*ppChunk)->sHeader = *((mng_chunk_headerp)pHeader);
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1234,7 +1238,7 @@ INIT_CHUNK_HDR (mng_init_unknown)
 #ifdef MNG_OPTIMIZE_CHUNKINITFREE
 FREE_CHUNK_HDR (mng_free_general)
 {
-  MNG_FREEX (pData, pHeader, ((mng_chunk_headerp)pHeader)->iChunksize);
+  MNG_FREEP (pData, pHeader, ((mng_chunk_headerp)pHeader)->iChunksize);
   return MNG_NOERROR;
 }
 #endif
@@ -1248,7 +1252,7 @@ FREE_CHUNK_HDR (mng_free_ihdr)
   MNG_TRACE (pData, MNG_FN_FREE_IHDR, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_ihdr));
+  MNG_FREEP (pData, pHeader, sizeof (mng_ihdr));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_IHDR, MNG_LC_END);
@@ -1267,7 +1271,7 @@ FREE_CHUNK_HDR (mng_free_plte)
   MNG_TRACE (pData, MNG_FN_FREE_PLTE, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_plte));
+  MNG_FREEP (pData, pHeader, sizeof (mng_plte));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_PLTE, MNG_LC_END);
@@ -1290,7 +1294,7 @@ FREE_CHUNK_HDR (mng_free_idat)
                       ((mng_idatp)pHeader)->iDatasize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_idat));
+  MNG_FREEP (pData, pHeader, sizeof (mng_idat));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1313,7 +1317,7 @@ FREE_CHUNK_HDR (mng_free_iend)
   MNG_TRACE (pData, MNG_FN_FREE_IEND, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_iend));
+  MNG_FREEP (pData, pHeader, sizeof (mng_iend));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_IEND, MNG_LC_END);
@@ -1332,7 +1336,7 @@ FREE_CHUNK_HDR (mng_free_trns)
   MNG_TRACE (pData, MNG_FN_FREE_TRNS, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_trns));
+  MNG_FREEP (pData, pHeader, sizeof (mng_trns));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_TRNS, MNG_LC_END);
@@ -1352,7 +1356,7 @@ FREE_CHUNK_HDR (mng_free_gama)
   MNG_TRACE (pData, MNG_FN_FREE_GAMA, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_gama));
+  MNG_FREEP (pData, pHeader, sizeof (mng_gama));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_GAMA, MNG_LC_END);
@@ -1373,7 +1377,7 @@ FREE_CHUNK_HDR (mng_free_chrm)
   MNG_TRACE (pData, MNG_FN_FREE_CHRM, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_chrm));
+  MNG_FREEP (pData, pHeader, sizeof (mng_chrm));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_CHRM, MNG_LC_END);
@@ -1394,7 +1398,7 @@ FREE_CHUNK_HDR (mng_free_srgb)
   MNG_TRACE (pData, MNG_FN_FREE_SRGB, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_srgb));
+  MNG_FREEP (pData, pHeader, sizeof (mng_srgb));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_SRGB, MNG_LC_END);
@@ -1423,7 +1427,7 @@ FREE_CHUNK_HDR (mng_free_iccp)
                       ((mng_iccpp)pHeader)->iProfilesize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_iccp));
+  MNG_FREEP (pData, pHeader, sizeof (mng_iccp));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1456,7 +1460,7 @@ FREE_CHUNK_HDR (mng_free_text)
                       ((mng_textp)pHeader)->iTextsize + 1);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_text));
+  MNG_FREEP (pData, pHeader, sizeof (mng_text));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1489,7 +1493,7 @@ FREE_CHUNK_HDR (mng_free_ztxt)
                       ((mng_ztxtp)pHeader)->iTextsize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_ztxt));
+  MNG_FREEP (pData, pHeader, sizeof (mng_ztxt));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1529,7 +1533,7 @@ FREE_CHUNK_HDR (mng_free_itxt)
                       ((mng_itxtp)pHeader)->iTextsize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_itxt));
+  MNG_FREEP (pData, pHeader, sizeof (mng_itxt));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1557,7 +1561,7 @@ FREE_CHUNK_HDR (mng_free_mpng)
                       ((mng_mpngp)pHeader)->iFramessize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_mpng));
+  MNG_FREEP (pData, pHeader, sizeof (mng_mpng));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1584,7 +1588,7 @@ FREE_CHUNK_HDR (mng_free_adat)
     MNG_FREEX (pData, ((mng_adatp)pHeader)->pTiles, ((mng_adatp)pHeader)->iTilessize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_adat));
+  MNG_FREEP (pData, pHeader, sizeof (mng_adat));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1609,7 +1613,7 @@ FREE_CHUNK_HDR (mng_free_bkgd)
   MNG_TRACE (pData, MNG_FN_FREE_BKGD, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_bkgd));
+  MNG_FREEP (pData, pHeader, sizeof (mng_bkgd));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_BKGD, MNG_LC_END);
@@ -1630,7 +1634,7 @@ FREE_CHUNK_HDR (mng_free_phys)
   MNG_TRACE (pData, MNG_FN_FREE_PHYS, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_phys));
+  MNG_FREEP (pData, pHeader, sizeof (mng_phys));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_PHYS, MNG_LC_END);
@@ -1651,7 +1655,7 @@ FREE_CHUNK_HDR (mng_free_sbit)
   MNG_TRACE (pData, MNG_FN_FREE_SBIT, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_sbit));
+  MNG_FREEP (pData, pHeader, sizeof (mng_sbit));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_SBIT, MNG_LC_END);
@@ -1681,7 +1685,7 @@ FREE_CHUNK_HDR (mng_free_splt)
                       (((mng_spltp)pHeader)->iSampledepth * 3 + sizeof (mng_uint16)) );
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_splt));
+  MNG_FREEP (pData, pHeader, sizeof (mng_splt));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1706,7 +1710,7 @@ FREE_CHUNK_HDR (mng_free_hist)
   MNG_TRACE (pData, MNG_FN_FREE_HIST, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_hist));
+  MNG_FREEP (pData, pHeader, sizeof (mng_hist));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_HIST, MNG_LC_END);
@@ -1727,7 +1731,7 @@ FREE_CHUNK_HDR (mng_free_time)
   MNG_TRACE (pData, MNG_FN_FREE_TIME, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_time));
+  MNG_FREEP (pData, pHeader, sizeof (mng_time));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_TIME, MNG_LC_END);
@@ -1747,7 +1751,7 @@ FREE_CHUNK_HDR (mng_free_mhdr)
   MNG_TRACE (pData, MNG_FN_FREE_MHDR, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_mhdr));
+  MNG_FREEP (pData, pHeader, sizeof (mng_mhdr));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_MHDR, MNG_LC_END);
@@ -1766,7 +1770,7 @@ FREE_CHUNK_HDR (mng_free_mend)
   MNG_TRACE (pData, MNG_FN_FREE_MEND, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_mend));
+  MNG_FREEP (pData, pHeader, sizeof (mng_mend));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_MEND, MNG_LC_END);
@@ -1792,7 +1796,7 @@ FREE_CHUNK_HDR (mng_free_loop)
 #endif
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_loop));
+  MNG_FREEP (pData, pHeader, sizeof (mng_loop));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1815,7 +1819,7 @@ FREE_CHUNK_HDR (mng_free_endl)
   MNG_TRACE (pData, MNG_FN_FREE_ENDL, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_endl));
+  MNG_FREEP (pData, pHeader, sizeof (mng_endl));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ENDL, MNG_LC_END);
@@ -1836,7 +1840,7 @@ FREE_CHUNK_HDR (mng_free_defi)
   MNG_TRACE (pData, MNG_FN_FREE_DEFI, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_defi));
+  MNG_FREEP (pData, pHeader, sizeof (mng_defi));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_DEFI, MNG_LC_END);
@@ -1857,7 +1861,7 @@ FREE_CHUNK_HDR (mng_free_basi)
   MNG_TRACE (pData, MNG_FN_FREE_BASI, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_basi));
+  MNG_FREEP (pData, pHeader, sizeof (mng_basi));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_BASI, MNG_LC_END);
@@ -1878,7 +1882,7 @@ FREE_CHUNK_HDR (mng_free_clon)
   MNG_TRACE (pData, MNG_FN_FREE_CLON, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_clon));
+  MNG_FREEP (pData, pHeader, sizeof (mng_clon));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_CLON, MNG_LC_END);
@@ -1903,7 +1907,7 @@ FREE_CHUNK_HDR (mng_free_past)
                       ((mng_pastp)pHeader)->iCount * sizeof (mng_past_source) );
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_past));
+  MNG_FREEP (pData, pHeader, sizeof (mng_past));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1932,7 +1936,7 @@ FREE_CHUNK_HDR (mng_free_disc)
                       ((mng_discp)pHeader)->iCount * sizeof (mng_uint16) );
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_disc));
+  MNG_FREEP (pData, pHeader, sizeof (mng_disc));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1957,7 +1961,7 @@ FREE_CHUNK_HDR (mng_free_back)
   MNG_TRACE (pData, MNG_FN_FREE_BACK, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_back));
+  MNG_FREEP (pData, pHeader, sizeof (mng_back));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_BACK, MNG_LC_END);
@@ -1986,7 +1990,7 @@ FREE_CHUNK_HDR (mng_free_fram)
                       ((mng_framp)pHeader)->iCount * sizeof (mng_uint32) );
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_fram));
+  MNG_FREEP (pData, pHeader, sizeof (mng_fram));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2011,7 +2015,7 @@ FREE_CHUNK_HDR (mng_free_move)
   MNG_TRACE (pData, MNG_FN_FREE_MOVE, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_move));
+  MNG_FREEP (pData, pHeader, sizeof (mng_move));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_MOVE, MNG_LC_END);
@@ -2032,7 +2036,7 @@ FREE_CHUNK_HDR (mng_free_clip)
   MNG_TRACE (pData, MNG_FN_FREE_CLIP, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_clip));
+  MNG_FREEP (pData, pHeader, sizeof (mng_clip));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_CLIP, MNG_LC_END);
@@ -2053,7 +2057,7 @@ FREE_CHUNK_HDR (mng_free_show)
   MNG_TRACE (pData, MNG_FN_FREE_SHOW, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_show));
+  MNG_FREEP (pData, pHeader, sizeof (mng_show));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_SHOW, MNG_LC_END);
@@ -2074,7 +2078,7 @@ FREE_CHUNK_HDR (mng_free_term)
   MNG_TRACE (pData, MNG_FN_FREE_TERM, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_term));
+  MNG_FREEP (pData, pHeader, sizeof (mng_term));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_TERM, MNG_LC_END);
@@ -2110,7 +2114,7 @@ FREE_CHUNK_HDR (mng_free_save)
                       ((mng_savep)pHeader)->iCount * sizeof (mng_save_entry) );
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_save));
+  MNG_FREEP (pData, pHeader, sizeof (mng_save));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2139,7 +2143,7 @@ FREE_CHUNK_HDR (mng_free_seek)
                       ((mng_seekp)pHeader)->iNamesize + 1);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_seek));
+  MNG_FREEP (pData, pHeader, sizeof (mng_seek));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2168,7 +2172,7 @@ FREE_CHUNK_HDR (mng_free_expi)
                       ((mng_expip)pHeader)->iNamesize + 1);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_expi));
+  MNG_FREEP (pData, pHeader, sizeof (mng_expi));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2193,7 +2197,7 @@ FREE_CHUNK_HDR (mng_free_fpri)
   MNG_TRACE (pData, MNG_FN_FREE_FPRI, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_fpri));
+  MNG_FREEP (pData, pHeader, sizeof (mng_fpri));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_FPRI, MNG_LC_END);
@@ -2218,7 +2222,7 @@ FREE_CHUNK_HDR (mng_free_need)
                       ((mng_needp)pHeader)->iKeywordssize + 1);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_need));
+  MNG_FREEP (pData, pHeader, sizeof (mng_need));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2243,7 +2247,7 @@ FREE_CHUNK_HDR (mng_free_phyg)
   MNG_TRACE (pData, MNG_FN_FREE_PHYG, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_phyg));
+  MNG_FREEP (pData, pHeader, sizeof (mng_phyg));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_PHYG, MNG_LC_END);
@@ -2264,7 +2268,7 @@ FREE_CHUNK_HDR (mng_free_jhdr)
   MNG_TRACE (pData, MNG_FN_FREE_JHDR, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_jhdr));
+  MNG_FREEP (pData, pHeader, sizeof (mng_jhdr));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_JHDR, MNG_LC_END);
@@ -2289,7 +2293,7 @@ FREE_CHUNK_HDR (mng_free_jdaa)
                       ((mng_jdaap)pHeader)->iDatasize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_jdaa));
+  MNG_FREEP (pData, pHeader, sizeof (mng_jdaa));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2318,7 +2322,7 @@ FREE_CHUNK_HDR (mng_free_jdat)
                       ((mng_jdatp)pHeader)->iDatasize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_jdat));
+  MNG_FREEP (pData, pHeader, sizeof (mng_jdat));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2343,7 +2347,7 @@ FREE_CHUNK_HDR (mng_free_jsep)
   MNG_TRACE (pData, MNG_FN_FREE_JSEP, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_jsep));
+  MNG_FREEP (pData, pHeader, sizeof (mng_jsep));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_JSEP, MNG_LC_END);
@@ -2364,7 +2368,7 @@ FREE_CHUNK_HDR (mng_free_dhdr)
   MNG_TRACE (pData, MNG_FN_FREE_DHDR, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_dhdr));
+  MNG_FREEP (pData, pHeader, sizeof (mng_dhdr));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_DHDR, MNG_LC_END);
@@ -2385,7 +2389,7 @@ FREE_CHUNK_HDR (mng_free_prom)
   MNG_TRACE (pData, MNG_FN_FREE_PROM, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_prom));
+  MNG_FREEP (pData, pHeader, sizeof (mng_prom));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_PROM, MNG_LC_END);
@@ -2406,7 +2410,7 @@ FREE_CHUNK_HDR (mng_free_ipng)
   MNG_TRACE (pData, MNG_FN_FREE_IPNG, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_ipng));
+  MNG_FREEP (pData, pHeader, sizeof (mng_ipng));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_IPNG, MNG_LC_END);
@@ -2427,7 +2431,7 @@ FREE_CHUNK_HDR (mng_free_pplt)
   MNG_TRACE (pData, MNG_FN_FREE_PPLT, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_pplt));
+  MNG_FREEP (pData, pHeader, sizeof (mng_pplt));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_PPLT, MNG_LC_END);
@@ -2449,7 +2453,7 @@ FREE_CHUNK_HDR (mng_free_ijng)
   MNG_TRACE (pData, MNG_FN_FREE_IJNG, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_ijng));
+  MNG_FREEP (pData, pHeader, sizeof (mng_ijng));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_IJNG, MNG_LC_END);
@@ -2475,7 +2479,7 @@ FREE_CHUNK_HDR (mng_free_drop)
                       ((mng_dropp)pHeader)->iCount * sizeof (mng_chunkid) );
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_drop));
+  MNG_FREEP (pData, pHeader, sizeof (mng_drop));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2505,7 +2509,7 @@ FREE_CHUNK_HDR (mng_free_dbyk)
                       ((mng_dbykp)pHeader)->iKeywordssize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_dbyk));
+  MNG_FREEP (pData, pHeader, sizeof (mng_dbyk));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2536,7 +2540,7 @@ FREE_CHUNK_HDR (mng_free_ordr)
                       ((mng_ordrp)pHeader)->iCount * sizeof (mng_ordr_entry) );
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_ordr));
+  MNG_FREEP (pData, pHeader, sizeof (mng_ordr));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2562,7 +2566,7 @@ FREE_CHUNK_HDR (mng_free_magn)
   MNG_TRACE (pData, MNG_FN_FREE_MAGN, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pHeader, sizeof (mng_magn));
+  MNG_FREEP (pData, pHeader, sizeof (mng_magn));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_MAGN, MNG_LC_END);
@@ -2598,7 +2602,7 @@ FREE_CHUNK_HDR (mng_free_evnt)
                       ((mng_evntp)pHeader)->iCount * sizeof (mng_evnt_entry) );
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_evnt));
+  MNG_FREEP (pData, pHeader, sizeof (mng_evnt));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2626,7 +2630,7 @@ FREE_CHUNK_HDR (mng_free_unknown)
                       ((mng_unknown_chunkp)pHeader)->iDatasize);
 
 #ifndef MNG_OPTIMIZE_CHUNKINITFREE
-  MNG_FREEX (pData, pHeader, sizeof (mng_unknown_chunk));
+  MNG_FREEP (pData, pHeader, sizeof (mng_unknown_chunk));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -94,6 +94,14 @@
 /* *             1.0.11 - 08/03/2007 - G.R-P                                * */
 /* *             - fixed incorrect #ifndef                                  * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - implemented getimgdata functions as a direct decode of   * */
+/* *               the stored chunks                                        * */
+/* *             - implemented putimgdata_ihdr (filter-selection +          * */
+/* *               streaming deflate)                                       * */
+/* *             - mng_putchunk_* take their chunk-header from the shared   * */
+/* *               chunk-table instead of a private copy                    * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -105,11 +113,13 @@
 #endif
 #include "libmng_memory.h"
 #include "libmng_chunks.h"
-#ifdef MNG_OPTIMIZE_CHUNKREADER
 #include "libmng_chunk_descr.h"
-#endif
 #include "libmng_chunk_prc.h"
 #include "libmng_chunk_io.h"
+#include "libmng_objects.h"
+#include "libmng_display.h"
+#include "libmng_filter.h"
+#include "libmng_zlib.h"
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
 #pragma option -A                      /* force ANSI-C */
@@ -2525,16 +2535,7 @@ mng_retcode MNG_DECL mng_putchunk_ihdr (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_IHDR, mng_init_general, mng_free_general, mng_read_ihdr, mng_write_ihdr, mng_assign_general, 0, 0, sizeof(mng_ihdr)};
-#else
-          {MNG_UINT_IHDR, mng_init_ihdr, mng_free_ihdr, mng_read_ihdr, mng_write_ihdr, mng_assign_ihdr, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_IHDR, MNG_LC_START);
@@ -2549,16 +2550,8 @@ mng_retcode MNG_DECL mng_putchunk_ihdr (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_IHDR))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_ihdr (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_IHDR, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_IHDR, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -2588,16 +2581,7 @@ mng_retcode MNG_DECL mng_putchunk_plte (mng_handle   hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_PLTE, mng_init_general, mng_free_general, mng_read_plte, mng_write_plte, mng_assign_general, 0, 0, sizeof(mng_plte)};
-#else
-          {MNG_UINT_PLTE, mng_init_plte, mng_free_plte, mng_read_plte, mng_write_plte, mng_assign_plte, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_PLTE, MNG_LC_START);
@@ -2615,16 +2599,8 @@ mng_retcode MNG_DECL mng_putchunk_plte (mng_handle   hHandle,
   if (!check_term (pData, MNG_UINT_PLTE))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_plte (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_PLTE, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_PLTE, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -2652,16 +2628,7 @@ mng_retcode MNG_DECL mng_putchunk_idat (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_IDAT, mng_init_general, mng_free_idat, mng_read_idat, mng_write_idat, mng_assign_idat, 0, 0, sizeof(mng_idat)};
-#else
-          {MNG_UINT_IDAT, mng_init_idat, mng_free_idat, mng_read_idat, mng_write_idat, mng_assign_idat, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_IDAT, MNG_LC_START);
@@ -2679,16 +2646,8 @@ mng_retcode MNG_DECL mng_putchunk_idat (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_IDAT))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_idat (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_IDAT, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_IDAT, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -2718,16 +2677,7 @@ mng_retcode MNG_DECL mng_putchunk_iend (mng_handle hHandle)
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_IEND, mng_init_general, mng_free_general, mng_read_iend, mng_write_iend, mng_assign_general, 0, 0, sizeof(mng_iend)};
-#else
-          {MNG_UINT_IEND, mng_init_iend, mng_free_iend, mng_read_iend, mng_write_iend, mng_assign_iend, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_IEND, MNG_LC_START);
@@ -2745,16 +2695,8 @@ mng_retcode MNG_DECL mng_putchunk_iend (mng_handle hHandle)
   if (!check_term (pData, MNG_UINT_IEND))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_iend (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_IEND, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_IEND, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -2794,16 +2736,7 @@ mng_retcode MNG_DECL mng_putchunk_trns (mng_handle   hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_tRNS, mng_init_general, mng_free_general, mng_read_trns, mng_write_trns, mng_assign_general, 0, 0, sizeof(mng_trns)};
-#else
-          {MNG_UINT_tRNS, mng_init_trns, mng_free_trns, mng_read_trns, mng_write_trns, mng_assign_trns, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_TRNS, MNG_LC_START);
@@ -2821,16 +2754,8 @@ mng_retcode MNG_DECL mng_putchunk_trns (mng_handle   hHandle,
   if (!check_term (pData, MNG_UINT_tRNS))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_trns (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_tRNS, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_tRNS, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -2867,16 +2792,7 @@ mng_retcode MNG_DECL mng_putchunk_gama (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_gAMA, mng_init_general, mng_free_general, mng_read_gama, mng_write_gama, mng_assign_general, 0, 0, sizeof(mng_gama)};
-#else
-          {MNG_UINT_gAMA, mng_init_gama, mng_free_gama, mng_read_gama, mng_write_gama, mng_assign_gama, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_GAMA, MNG_LC_START);
@@ -2894,16 +2810,8 @@ mng_retcode MNG_DECL mng_putchunk_gama (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_gAMA))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_gama (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_gAMA, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_gAMA, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -2938,16 +2846,7 @@ mng_retcode MNG_DECL mng_putchunk_chrm (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_cHRM, mng_init_general, mng_free_general, mng_read_chrm, mng_write_chrm, mng_assign_general, 0, 0, sizeof(mng_chrm)};
-#else
-          {MNG_UINT_cHRM, mng_init_chrm, mng_free_chrm, mng_read_chrm, mng_write_chrm, mng_assign_chrm, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_CHRM, MNG_LC_START);
@@ -2965,16 +2864,8 @@ mng_retcode MNG_DECL mng_putchunk_chrm (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_cHRM))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_chrm (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_cHRM, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_cHRM, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3009,16 +2900,7 @@ mng_retcode MNG_DECL mng_putchunk_srgb (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_sRGB, mng_init_general, mng_free_general, mng_read_srgb, mng_write_srgb, mng_assign_general, 0, 0, sizeof(mng_srgb)};
-#else
-          {MNG_UINT_sRGB, mng_init_srgb, mng_free_srgb, mng_read_srgb, mng_write_srgb, mng_assign_srgb, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_SRGB, MNG_LC_START);
@@ -3036,16 +2918,8 @@ mng_retcode MNG_DECL mng_putchunk_srgb (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_sRGB))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_srgb (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_sRGB, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_sRGB, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3077,16 +2951,7 @@ mng_retcode MNG_DECL mng_putchunk_iccp (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_iCCP, mng_init_general, mng_free_iccp, mng_read_iccp, mng_write_iccp, mng_assign_iccp, 0, 0, sizeof(mng_iccp)};
-#else
-          {MNG_UINT_iCCP, mng_init_iccp, mng_free_iccp, mng_read_iccp, mng_write_iccp, mng_assign_iccp, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_ICCP, MNG_LC_START);
@@ -3104,16 +2969,8 @@ mng_retcode MNG_DECL mng_putchunk_iccp (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_iCCP))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_iccp (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_iCCP, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_iCCP, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3157,16 +3014,7 @@ mng_retcode MNG_DECL mng_putchunk_text (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_tEXt, mng_init_general, mng_free_text, mng_read_text, mng_write_text, mng_assign_text, 0, 0, sizeof(mng_text)};
-#else
-          {MNG_UINT_tEXt, mng_init_text, mng_free_text, mng_read_text, mng_write_text, mng_assign_text, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_TEXT, MNG_LC_START);
@@ -3184,16 +3032,8 @@ mng_retcode MNG_DECL mng_putchunk_text (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_tEXt))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_text (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_tEXt, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_tEXt, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3236,16 +3076,7 @@ mng_retcode MNG_DECL mng_putchunk_ztxt (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_zTXt, mng_init_general, mng_free_ztxt, mng_read_ztxt, mng_write_ztxt, mng_assign_ztxt, 0, 0, sizeof(mng_ztxt)};
-#else
-          {MNG_UINT_zTXt, mng_init_ztxt, mng_free_ztxt, mng_read_ztxt, mng_write_ztxt, mng_assign_ztxt, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_ZTXT, MNG_LC_START);
@@ -3263,16 +3094,8 @@ mng_retcode MNG_DECL mng_putchunk_ztxt (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_zTXt))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_ztxt (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_zTXt, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_zTXt, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3321,16 +3144,7 @@ mng_retcode MNG_DECL mng_putchunk_itxt (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_iTXt, mng_init_general, mng_free_itxt, mng_read_itxt, mng_write_itxt, mng_assign_itxt, 0, 0, sizeof(mng_itxt)};
-#else
-          {MNG_UINT_iTXt, mng_init_itxt, mng_free_itxt, mng_read_itxt, mng_write_itxt, mng_assign_itxt, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_ITXT, MNG_LC_START);
@@ -3348,16 +3162,8 @@ mng_retcode MNG_DECL mng_putchunk_itxt (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_iTXt))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_itxt (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_iTXt, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_iTXt, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3418,16 +3224,7 @@ mng_retcode MNG_DECL mng_putchunk_bkgd (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_bKGD, mng_init_general, mng_free_general, mng_read_bkgd, mng_write_bkgd, mng_assign_general, 0, 0, sizeof(mng_bkgd)};
-#else
-          {MNG_UINT_bKGD, mng_init_bkgd, mng_free_bkgd, mng_read_bkgd, mng_write_bkgd, mng_assign_bkgd, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_BKGD, MNG_LC_START);
@@ -3445,16 +3242,8 @@ mng_retcode MNG_DECL mng_putchunk_bkgd (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_bKGD))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_bkgd (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_bKGD, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_bKGD, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3489,16 +3278,7 @@ mng_retcode MNG_DECL mng_putchunk_phys (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_pHYs, mng_init_general, mng_free_general, mng_read_phys, mng_write_phys, mng_assign_general, 0, 0, sizeof(mng_phys)};
-#else
-          {MNG_UINT_pHYs, mng_init_phys, mng_free_phys, mng_read_phys, mng_write_phys, mng_assign_phys, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_PHYS, MNG_LC_START);
@@ -3516,16 +3296,8 @@ mng_retcode MNG_DECL mng_putchunk_phys (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_pHYs))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_phys (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_pHYs, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_pHYs, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3556,16 +3328,7 @@ mng_retcode MNG_DECL mng_putchunk_sbit (mng_handle    hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_sBIT, mng_init_general, mng_free_general, mng_read_sbit, mng_write_sbit, mng_assign_general, 0, 0, sizeof(mng_sbit)};
-#else
-          {MNG_UINT_sBIT, mng_init_sbit, mng_free_sbit, mng_read_sbit, mng_write_sbit, mng_assign_sbit, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_SBIT, MNG_LC_START);
@@ -3583,16 +3346,8 @@ mng_retcode MNG_DECL mng_putchunk_sbit (mng_handle    hHandle,
   if (!check_term (pData, MNG_UINT_sBIT))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_sbit (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_sBIT, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_sBIT, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3628,16 +3383,7 @@ mng_retcode MNG_DECL mng_putchunk_splt (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_sPLT, mng_init_general, mng_free_splt, mng_read_splt, mng_write_splt, mng_assign_splt, 0, 0, sizeof(mng_splt)};
-#else
-          {MNG_UINT_sPLT, mng_init_splt, mng_free_splt, mng_read_splt, mng_write_splt, mng_assign_splt, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_SPLT, MNG_LC_START);
@@ -3655,16 +3401,8 @@ mng_retcode MNG_DECL mng_putchunk_splt (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_sPLT))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_splt (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_sPLT, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_sPLT, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3708,16 +3446,7 @@ mng_retcode MNG_DECL mng_putchunk_hist (mng_handle    hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_hIST, mng_init_general, mng_free_general, mng_read_hist, mng_write_hist, mng_assign_general, 0, 0, sizeof(mng_hist)};
-#else
-          {MNG_UINT_hIST, mng_init_hist, mng_free_hist, mng_read_hist, mng_write_hist, mng_assign_hist, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_HIST, MNG_LC_START);
@@ -3735,16 +3464,8 @@ mng_retcode MNG_DECL mng_putchunk_hist (mng_handle    hHandle,
   if (!check_term (pData, MNG_UINT_hIST))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_hist (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_hIST, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_hIST, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3777,16 +3498,7 @@ mng_retcode MNG_DECL mng_putchunk_time (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_tIME, mng_init_general, mng_free_general, mng_read_time, mng_write_time, mng_assign_general, 0, 0, sizeof(mng_time)};
-#else
-          {MNG_UINT_tIME, mng_init_time, mng_free_time, mng_read_time, mng_write_time, mng_assign_time, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_TIME, MNG_LC_START);
@@ -3804,16 +3516,8 @@ mng_retcode MNG_DECL mng_putchunk_time (mng_handle hHandle,
   if (pData->iFirstchunkadded == 0)
     MNG_ERROR (pData, MNG_NOHEADER)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_time (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_tIME, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_tIME, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3849,16 +3553,7 @@ mng_retcode MNG_DECL mng_putchunk_mhdr (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_MHDR, mng_init_general, mng_free_general, mng_read_mhdr, mng_write_mhdr, mng_assign_general, 0, 0, sizeof(mng_mhdr)};
-#else
-          {MNG_UINT_MHDR, mng_init_mhdr, mng_free_mhdr, mng_read_mhdr, mng_write_mhdr, mng_assign_mhdr, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_MHDR, MNG_LC_START);
@@ -3876,16 +3571,8 @@ mng_retcode MNG_DECL mng_putchunk_mhdr (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_MHDR))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_mhdr (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_MHDR, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_MHDR, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3914,16 +3601,7 @@ mng_retcode MNG_DECL mng_putchunk_mend (mng_handle hHandle)
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_MEND, mng_init_general, mng_free_general, mng_read_mend, mng_write_mend, mng_assign_general, 0, 0, sizeof(mng_mend)};
-#else
-          {MNG_UINT_MEND, mng_init_mend, mng_free_mend, mng_read_mend, mng_write_mend, mng_assign_mend, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_MEND, MNG_LC_START);
@@ -3941,16 +3619,8 @@ mng_retcode MNG_DECL mng_putchunk_mend (mng_handle hHandle)
   if (!check_term (pData, MNG_UINT_MEND))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_mend (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_MEND, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_MEND, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -3981,16 +3651,7 @@ mng_retcode MNG_DECL mng_putchunk_loop (mng_handle  hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_LOOP, mng_init_general, mng_free_loop, mng_read_loop, mng_write_loop, mng_assign_loop, 0, 0, sizeof(mng_loop)};
-#else
-          {MNG_UINT_LOOP, mng_init_loop, mng_free_loop, mng_read_loop, mng_write_loop, mng_assign_loop, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_LOOP, MNG_LC_START);
@@ -4008,16 +3669,8 @@ mng_retcode MNG_DECL mng_putchunk_loop (mng_handle  hHandle,
   if (!check_term (pData, MNG_UINT_LOOP))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_loop (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_LOOP, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_LOOP, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4047,16 +3700,7 @@ mng_retcode MNG_DECL mng_putchunk_endl (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_ENDL, mng_init_general, mng_free_general, mng_read_endl, mng_write_endl, mng_assign_general, 0, 0, sizeof(mng_endl)};
-#else
-          {MNG_UINT_ENDL, mng_init_endl, mng_free_endl, mng_read_endl, mng_write_endl, mng_assign_endl, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_ENDL, MNG_LC_START);
@@ -4074,16 +3718,8 @@ mng_retcode MNG_DECL mng_putchunk_endl (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_ENDL))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_endl (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_ENDL, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_ENDL, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4119,16 +3755,7 @@ mng_retcode MNG_DECL mng_putchunk_defi (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_DEFI, mng_init_general, mng_free_general, mng_read_defi, mng_write_defi, mng_assign_general, 0, 0, sizeof(mng_defi)};
-#else
-          {MNG_UINT_DEFI, mng_init_defi, mng_free_defi, mng_read_defi, mng_write_defi, mng_assign_defi, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_DEFI, MNG_LC_START);
@@ -4146,16 +3773,8 @@ mng_retcode MNG_DECL mng_putchunk_defi (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_DEFI))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_defi (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_DEFI, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_DEFI, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4202,16 +3821,7 @@ mng_retcode MNG_DECL mng_putchunk_basi (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_BASI, mng_init_general, mng_free_general, mng_read_basi, mng_write_basi, mng_assign_general, 0, 0, sizeof(mng_basi)};
-#else
-          {MNG_UINT_BASI, mng_init_basi, mng_free_basi, mng_read_basi, mng_write_basi, mng_assign_basi, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_BASI, MNG_LC_START);
@@ -4229,16 +3839,8 @@ mng_retcode MNG_DECL mng_putchunk_basi (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_BASI))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_basi (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_BASI, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_BASI, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4283,16 +3885,7 @@ mng_retcode MNG_DECL mng_putchunk_clon (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_CLON, mng_init_general, mng_free_general, mng_read_clon, mng_write_clon, mng_assign_general, 0, 0, sizeof(mng_clon)};
-#else
-          {MNG_UINT_CLON, mng_init_clon, mng_free_clon, mng_read_clon, mng_write_clon, mng_assign_clon, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_CLON, MNG_LC_START);
@@ -4310,16 +3903,8 @@ mng_retcode MNG_DECL mng_putchunk_clon (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_CLON))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_clon (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_CLON, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_CLON, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4357,16 +3942,7 @@ mng_retcode MNG_DECL mng_putchunk_past (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_PAST, mng_init_general, mng_free_past, mng_read_past, mng_write_past, mng_assign_past, 0, 0, sizeof(mng_past)};
-#else
-          {MNG_UINT_PAST, mng_init_past, mng_free_past, mng_read_past, mng_write_past, mng_assign_past, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_PAST, MNG_LC_START);
@@ -4384,16 +3960,8 @@ mng_retcode MNG_DECL mng_putchunk_past (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_PAST))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_past (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_PAST, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_PAST, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4491,16 +4059,7 @@ mng_retcode MNG_DECL mng_putchunk_disc (mng_handle  hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_DISC, mng_init_general, mng_free_disc, mng_read_disc, mng_write_disc, mng_assign_disc, 0, 0, sizeof(mng_disc)};
-#else
-          {MNG_UINT_DISC, mng_init_disc, mng_free_disc, mng_read_disc, mng_write_disc, mng_assign_disc, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_DISC, MNG_LC_START);
@@ -4518,16 +4077,8 @@ mng_retcode MNG_DECL mng_putchunk_disc (mng_handle  hHandle,
   if (!check_term (pData, MNG_UINT_DISC))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_disc (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_DISC, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_DISC, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4566,16 +4117,7 @@ mng_retcode MNG_DECL mng_putchunk_back (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_BACK, mng_init_general, mng_free_general, mng_read_back, mng_write_back, mng_assign_general, 0, 0, sizeof(mng_back)};
-#else
-          {MNG_UINT_BACK, mng_init_back, mng_free_back, mng_read_back, mng_write_back, mng_assign_back, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_BACK, MNG_LC_START);
@@ -4593,16 +4135,8 @@ mng_retcode MNG_DECL mng_putchunk_back (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_BACK))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_back (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_BACK, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_BACK, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4649,16 +4183,7 @@ mng_retcode MNG_DECL mng_putchunk_fram (mng_handle  hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_FRAM, mng_init_general, mng_free_fram, mng_read_fram, mng_write_fram, mng_assign_fram, 0, 0, sizeof(mng_fram)};
-#else
-          {MNG_UINT_FRAM, mng_init_fram, mng_free_fram, mng_read_fram, mng_write_fram, mng_assign_fram, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_FRAM, MNG_LC_START);
@@ -4676,16 +4201,8 @@ mng_retcode MNG_DECL mng_putchunk_fram (mng_handle  hHandle,
   if (!check_term (pData, MNG_UINT_FRAM))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_fram (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_FRAM, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_FRAM, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4743,16 +4260,7 @@ mng_retcode MNG_DECL mng_putchunk_move (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_MOVE, mng_init_general, mng_free_general, mng_read_move, mng_write_move, mng_assign_general, 0, 0, sizeof(mng_move)};
-#else
-          {MNG_UINT_MOVE, mng_init_move, mng_free_move, mng_read_move, mng_write_move, mng_assign_move, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_MOVE, MNG_LC_START);
@@ -4770,16 +4278,8 @@ mng_retcode MNG_DECL mng_putchunk_move (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_MOVE))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_move (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_MOVE, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_MOVE, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4815,16 +4315,7 @@ mng_retcode MNG_DECL mng_putchunk_clip (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_CLIP, mng_init_general, mng_free_general, mng_read_clip, mng_write_clip, mng_assign_general, 0, 0, sizeof(mng_clip)};
-#else
-          {MNG_UINT_CLIP, mng_init_clip, mng_free_clip, mng_read_clip, mng_write_clip, mng_assign_clip, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_CLIP, MNG_LC_START);
@@ -4842,16 +4333,8 @@ mng_retcode MNG_DECL mng_putchunk_clip (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_CLIP))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_clip (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_CLIP, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_CLIP, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4887,16 +4370,7 @@ mng_retcode MNG_DECL mng_putchunk_show (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_SHOW, mng_init_general, mng_free_general, mng_read_show, mng_write_show, mng_assign_general, 0, 0, sizeof(mng_show)};
-#else
-          {MNG_UINT_SHOW, mng_init_show, mng_free_show, mng_read_show, mng_write_show, mng_assign_show, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_SHOW, MNG_LC_START);
@@ -4914,16 +4388,8 @@ mng_retcode MNG_DECL mng_putchunk_show (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_SHOW))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_show (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_SHOW, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_SHOW, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -4955,16 +4421,7 @@ mng_retcode MNG_DECL mng_putchunk_term (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_TERM, mng_init_general, mng_free_general, mng_read_term, mng_write_term, mng_assign_general, 0, 0, sizeof(mng_term)};
-#else
-          {MNG_UINT_TERM, mng_init_term, mng_free_term, mng_read_term, mng_write_term, mng_assign_term, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_TERM, MNG_LC_START);
@@ -4979,16 +4436,8 @@ mng_retcode MNG_DECL mng_putchunk_term (mng_handle hHandle,
   if (pData->iFirstchunkadded != MNG_UINT_MHDR)
     MNG_ERROR (pData, MNG_NOHEADER)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_term (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_TERM, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_TERM, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5019,16 +4468,7 @@ mng_retcode MNG_DECL mng_putchunk_save (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_SAVE, mng_init_general, mng_free_save, mng_read_save, mng_write_save, mng_assign_save, 0, 0, sizeof(mng_save)};
-#else
-          {MNG_UINT_SAVE, mng_init_save, mng_free_save, mng_read_save, mng_write_save, mng_assign_save, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_SAVE, MNG_LC_START);
@@ -5046,16 +4486,8 @@ mng_retcode MNG_DECL mng_putchunk_save (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_SAVE))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_save (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_SAVE, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_SAVE, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5148,16 +4580,7 @@ mng_retcode MNG_DECL mng_putchunk_seek (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_SEEK, mng_init_general, mng_free_seek, mng_read_seek, mng_write_seek, mng_assign_seek, 0, 0, sizeof(mng_seek)};
-#else
-          {MNG_UINT_SEEK, mng_init_seek, mng_free_seek, mng_read_seek, mng_write_seek, mng_assign_seek, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_SEEK, MNG_LC_START);
@@ -5175,16 +4598,8 @@ mng_retcode MNG_DECL mng_putchunk_seek (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_SEEK))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_seek (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_SEEK, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_SEEK, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5218,16 +4633,7 @@ mng_retcode MNG_DECL mng_putchunk_expi (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_eXPI, mng_init_general, mng_free_expi, mng_read_expi, mng_write_expi, mng_assign_general, 0, 0, sizeof(mng_expi)};
-#else
-          {MNG_UINT_eXPI, mng_init_expi, mng_free_expi, mng_read_expi, mng_write_expi, mng_assign_expi, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_EXPI, MNG_LC_START);
@@ -5245,16 +4651,8 @@ mng_retcode MNG_DECL mng_putchunk_expi (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_eXPI))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_expi (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_eXPI, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_eXPI, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5288,16 +4686,7 @@ mng_retcode MNG_DECL mng_putchunk_fpri (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_fPRI, mng_init_general, mng_free_general, mng_read_fpri, mng_write_fpri, mng_assign_general, 0, 0, sizeof(mng_fpri)};
-#else
-          {MNG_UINT_fPRI, mng_init_fpri, mng_free_fpri, mng_read_fpri, mng_write_fpri, mng_assign_fpri, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_FPRI, MNG_LC_START);
@@ -5315,16 +4704,8 @@ mng_retcode MNG_DECL mng_putchunk_fpri (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_fPRI))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_fpri (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_fPRI, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_fPRI, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5352,16 +4733,7 @@ mng_retcode MNG_DECL mng_putchunk_need (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_nEED, mng_init_general, mng_free_need, mng_read_need, mng_write_need, mng_assign_need, 0, 0, sizeof(mng_need)};
-#else
-          {MNG_UINT_nEED, mng_init_need, mng_free_need, mng_read_need, mng_write_need, mng_assign_need, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_NEED, MNG_LC_START);
@@ -5379,16 +4751,8 @@ mng_retcode MNG_DECL mng_putchunk_need (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_nEED))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_need (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_nEED, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_nEED, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5423,16 +4787,7 @@ mng_retcode MNG_DECL mng_putchunk_phyg (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_pHYg, mng_init_general, mng_free_general, mng_read_phyg, mng_write_phyg, mng_assign_general, 0, 0, sizeof(mng_phyg)};
-#else
-          {MNG_UINT_pHYg, mng_init_phyg, mng_free_phyg, mng_read_phyg, mng_write_phyg, mng_assign_phyg, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_PHYG, MNG_LC_START);
@@ -5450,16 +4805,8 @@ mng_retcode MNG_DECL mng_putchunk_phyg (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_pHYg))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_phyg (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_pHYg, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_pHYg, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5498,16 +4845,7 @@ mng_retcode MNG_DECL mng_putchunk_jhdr (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_JHDR, mng_init_general, mng_free_general, mng_read_jhdr, mng_write_jhdr, mng_assign_general, 0, 0, sizeof(mng_jhdr)};
-#else
-          {MNG_UINT_JHDR, mng_init_jhdr, mng_free_jhdr, mng_read_jhdr, mng_write_jhdr, mng_assign_jhdr, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_JHDR, MNG_LC_START);
@@ -5522,16 +4860,8 @@ mng_retcode MNG_DECL mng_putchunk_jhdr (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_JHDR))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_jhdr (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_JHDR, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_JHDR, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5569,16 +4899,7 @@ mng_retcode MNG_DECL mng_putchunk_jdat (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_JDAT, mng_init_general, mng_free_jdat, mng_read_jdat, mng_write_jdat, mng_assign_jdat, 0, 0, sizeof(mng_jdat)};
-#else
-          {MNG_UINT_JDAT, mng_init_jdat, mng_free_jdat, mng_read_jdat, mng_write_jdat, mng_assign_jdat, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_JDAT, MNG_LC_START);
@@ -5597,16 +4918,8 @@ mng_retcode MNG_DECL mng_putchunk_jdat (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_JDAT))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_jdat (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_JDAT, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_JDAT, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5641,16 +4954,7 @@ mng_retcode MNG_DECL mng_putchunk_jdaa (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_JDAA, mng_init_general, mng_free_jdaa, mng_read_jdaa, mng_write_jdaa, mng_assign_jdaa, 0, 0, sizeof(mng_jdaa)};
-#else
-          {MNG_UINT_JDAA, mng_init_jdaa, mng_free_jdaa, mng_read_jdaa, mng_write_jdaa, mng_assign_jdaa, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_JDAA, MNG_LC_START);
@@ -5669,16 +4973,8 @@ mng_retcode MNG_DECL mng_putchunk_jdaa (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_JDAA))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_jdaa (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_JDAA, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_JDAA, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5711,16 +5007,7 @@ mng_retcode MNG_DECL mng_putchunk_jsep (mng_handle hHandle)
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_JSEP, mng_init_general, mng_free_general, mng_read_jsep, mng_write_jsep, mng_assign_general, 0, 0, sizeof(mng_jsep)};
-#else
-          {MNG_UINT_JSEP, mng_init_jsep, mng_free_jsep, mng_read_jsep, mng_write_jsep, mng_assign_jsep, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_JSEP, MNG_LC_START);
@@ -5739,16 +5026,8 @@ mng_retcode MNG_DECL mng_putchunk_jsep (mng_handle hHandle)
   if (!check_term (pData, MNG_UINT_JSEP))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_jsep (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_JSEP, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_JSEP, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5779,16 +5058,7 @@ mng_retcode MNG_DECL mng_putchunk_dhdr (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_DHDR, mng_init_general, mng_free_general, mng_read_dhdr, mng_write_dhdr, mng_assign_general, 0, 0, sizeof(mng_dhdr)};
-#else
-          {MNG_UINT_DHDR, mng_init_dhdr, mng_free_dhdr, mng_read_dhdr, mng_write_dhdr, mng_assign_dhdr, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_DHDR, MNG_LC_START);
@@ -5806,16 +5076,8 @@ mng_retcode MNG_DECL mng_putchunk_dhdr (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_DHDR))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_dhdr (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_DHDR, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_DHDR, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5849,16 +5111,7 @@ mng_retcode MNG_DECL mng_putchunk_prom (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_PROM, mng_init_general, mng_free_general, mng_read_prom, mng_write_prom, mng_assign_general, 0, 0, sizeof(mng_prom)};
-#else
-          {MNG_UINT_PROM, mng_init_prom, mng_free_prom, mng_read_prom, mng_write_prom, mng_assign_prom, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_PROM, MNG_LC_START);
@@ -5876,16 +5129,8 @@ mng_retcode MNG_DECL mng_putchunk_prom (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_PROM))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_prom (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_PROM, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_PROM, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5912,16 +5157,7 @@ mng_retcode MNG_DECL mng_putchunk_ipng (mng_handle hHandle)
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_IPNG, mng_init_general, mng_free_general, mng_read_ipng, mng_write_ipng, mng_assign_general, 0, 0, sizeof(mng_ipng)};
-#else
-          {MNG_UINT_IPNG, mng_init_ipng, mng_free_ipng, mng_read_ipng, mng_write_ipng, mng_assign_ipng, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_IPNG, MNG_LC_START);
@@ -5939,16 +5175,8 @@ mng_retcode MNG_DECL mng_putchunk_ipng (mng_handle hHandle)
   if (!check_term (pData, MNG_UINT_IPNG))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_ipng (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_IPNG, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_IPNG, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -5973,16 +5201,7 @@ mng_retcode MNG_DECL mng_putchunk_pplt (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_PPLT, mng_init_general, mng_free_general, mng_read_pplt, mng_write_pplt, mng_assign_general, 0, 0, sizeof(mng_pplt)};
-#else
-          {MNG_UINT_PPLT, mng_init_pplt, mng_free_pplt, mng_read_pplt, mng_write_pplt, mng_assign_pplt, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_PPLT, MNG_LC_START);
@@ -6000,16 +5219,8 @@ mng_retcode MNG_DECL mng_putchunk_pplt (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_PPLT))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_pplt (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_PPLT, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_PPLT, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -6088,16 +5299,7 @@ mng_retcode MNG_DECL mng_putchunk_ijng (mng_handle hHandle)
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_IJNG, mng_init_general, mng_free_general, mng_read_ijng, mng_write_ijng, mng_assign_general, 0, 0, sizeof(mng_ijng)};
-#else
-          {MNG_UINT_IJNG, mng_init_ijng, mng_free_ijng, mng_read_ijng, mng_write_ijng, mng_assign_ijng, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_IJNG, MNG_LC_START);
@@ -6115,16 +5317,8 @@ mng_retcode MNG_DECL mng_putchunk_ijng (mng_handle hHandle)
   if (!check_term (pData, MNG_UINT_IJNG))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_ijng (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_IJNG, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_IJNG, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -6150,16 +5344,7 @@ mng_retcode MNG_DECL mng_putchunk_drop (mng_handle   hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_DROP, mng_init_general, mng_free_drop, mng_read_drop, mng_write_drop, mng_assign_drop, 0, 0, sizeof(mng_drop)};
-#else
-          {MNG_UINT_DROP, mng_init_drop, mng_free_drop, mng_read_drop, mng_write_drop, mng_assign_drop, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_DROP, MNG_LC_START);
@@ -6177,16 +5362,8 @@ mng_retcode MNG_DECL mng_putchunk_drop (mng_handle   hHandle,
   if (!check_term (pData, MNG_UINT_DROP))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_drop (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_DROP, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_DROP, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -6224,16 +5401,7 @@ mng_retcode MNG_DECL mng_putchunk_dbyk (mng_handle  hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_DBYK, mng_init_general, mng_free_dbyk, mng_read_dbyk, mng_write_dbyk, mng_assign_dbyk, 0, 0, sizeof(mng_dbyk)};
-#else
-          {MNG_UINT_DBYK, mng_init_dbyk, mng_free_dbyk, mng_read_dbyk, mng_write_dbyk, mng_assign_dbyk, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_DBYK, MNG_LC_START);
@@ -6251,16 +5419,8 @@ mng_retcode MNG_DECL mng_putchunk_dbyk (mng_handle  hHandle,
   if (!check_term (pData, MNG_UINT_DBYK))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_dbyk (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_DBYK, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_DBYK, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -6296,16 +5456,7 @@ mng_retcode MNG_DECL mng_putchunk_ordr (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_ORDR, mng_init_general, mng_free_ordr, mng_read_ordr, mng_write_ordr, mng_assign_ordr, 0, 0, sizeof(mng_ordr)};
-#else
-          {MNG_UINT_ORDR, mng_init_ordr, mng_free_ordr, mng_read_ordr, mng_write_ordr, mng_assign_ordr, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_ORDR, MNG_LC_START);
@@ -6323,16 +5474,8 @@ mng_retcode MNG_DECL mng_putchunk_ordr (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_ORDR))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_ordr (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_ORDR, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_ORDR, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -6419,16 +5562,7 @@ mng_retcode MNG_DECL mng_putchunk_magn (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_MAGN, mng_init_general, mng_free_general, mng_read_magn, mng_write_magn, mng_assign_general, 0, 0, sizeof(mng_magn)};
-#else
-          {MNG_UINT_MAGN, mng_init_magn, mng_free_magn, mng_read_magn, mng_write_magn, mng_assign_magn, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_MAGN, MNG_LC_START);
@@ -6446,16 +5580,8 @@ mng_retcode MNG_DECL mng_putchunk_magn (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_MAGN))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_magn (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_MAGN, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_MAGN, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -6495,16 +5621,7 @@ MNG_EXT mng_retcode MNG_DECL mng_putchunk_mpng (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_mpNG, mng_init_general, mng_free_mpng, mng_read_mpng, mng_write_mpng, mng_assign_mpng, 0, 0, sizeof(mng_mpng)};
-#else
-          {MNG_UINT_mpNG, mng_init_mpng, mng_free_mpng, mng_read_mpng, mng_write_mpng, mng_assign_mpng, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_MPNG, MNG_LC_START);
@@ -6519,16 +5636,8 @@ MNG_EXT mng_retcode MNG_DECL mng_putchunk_mpng (mng_handle hHandle,
   if (pData->iFirstchunkadded != MNG_UINT_IHDR)
     MNG_ERROR (pData, MNG_NOHEADER)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_mpng (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_mpNG, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_mpNG, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -6618,16 +5727,7 @@ mng_retcode MNG_DECL mng_putchunk_evnt (mng_handle hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_evNT, mng_init_general, mng_free_evnt, mng_read_evnt, mng_write_evnt, mng_assign_evnt, 0, 0, sizeof(mng_evnt)};
-#else
-          {MNG_UINT_evNT, mng_init_evnt, mng_free_evnt, mng_read_evnt, mng_write_evnt, mng_assign_evnt, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_EVNT, MNG_LC_START);
@@ -6645,16 +5745,8 @@ mng_retcode MNG_DECL mng_putchunk_evnt (mng_handle hHandle,
   if (!check_term (pData, MNG_UINT_evNT))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_evnt (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_evNT, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_evNT, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -6749,16 +5841,7 @@ mng_retcode MNG_DECL mng_putchunk_unknown (mng_handle  hHandle,
   mng_datap        pData;
   mng_chunkp       pChunk;
   mng_retcode      iRetcode;
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  mng_chunk_header sChunkheader =
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-          {MNG_UINT_HUH, mng_init_general, mng_free_unknown, mng_read_unknown, mng_write_unknown, mng_assign_unknown, 0, 0, sizeof(mng_unknown_chunk)};
-#else
-          {MNG_UINT_HUH, mng_init_unknown, mng_free_unknown, mng_read_unknown, mng_write_unknown, mng_assign_unknown, 0, 0};
-#endif
-#else
   mng_chunk_header sChunkheader;
-#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTCHUNK_UNKNOWN, MNG_LC_START);
@@ -6776,16 +5859,8 @@ mng_retcode MNG_DECL mng_putchunk_unknown (mng_handle  hHandle,
   if (!check_term (pData, iChunkname))
     MNG_ERROR (pData, MNG_TERMSEQERROR)
                                        /* create the chunk */
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#else
-  iRetcode = mng_init_unknown (pData, &sChunkheader, &pChunk);
-#endif
-#else
-  mng_get_chunkheader(MNG_UINT_HUH, &sChunkheader);
-  iRetcode = mng_init_general (pData, &sChunkheader, &pChunk);
-#endif
+  mng_get_chunkheader (MNG_UINT_HUH, &sChunkheader);
+  iRetcode = sChunkheader.fCreate (pData, &sChunkheader, &pChunk);
 
   if (iRetcode)                        /* on error bail out */
     return iRetcode;
@@ -6815,22 +5890,96 @@ mng_retcode MNG_DECL mng_putchunk_unknown (mng_handle  hHandle,
 /* ************************************************************************** */
 /* ************************************************************************** */
 
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+MNG_LOCAL mng_bool is_image_header (mng_chunkp pChunk)
+{
+  mng_chunkid iChunkname = ((mng_chunk_headerp)pChunk)->iChunkname;
+
+  return (mng_bool)((iChunkname == MNG_UINT_IHDR) || (iChunkname == MNG_UINT_JHDR) ||
+                    (iChunkname == MNG_UINT_BASI) || (iChunkname == MNG_UINT_DHDR)    );
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_chunkp find_image_header (mng_chunkp pChunk)
+{
+  mng_chunkid iChunkname;
+                                       /* find the first IDAT/JDAT (or the IEND
+                                          of an image without any) */
+  while (pChunk)
+  {
+    iChunkname = ((mng_chunk_headerp)pChunk)->iChunkname;
+
+    if ((iChunkname == MNG_UINT_IDAT) || (iChunkname == MNG_UINT_JDAT) ||
+        (iChunkname == MNG_UINT_JDAA) || (iChunkname == MNG_UINT_IEND)    )
+      break;
+
+    pChunk = ((mng_chunk_headerp)pChunk)->pNext;
+  }
+                                       /* and back to the start of that image */
+  while ((pChunk) && (!is_image_header (pChunk)))
+  {
+    if ((((mng_chunk_headerp)pChunk)->iChunkname == MNG_UINT_MEND) ||
+        (((mng_chunk_headerp)pChunk)->iChunkname == MNG_UINT_MHDR)    )
+      return MNG_NULL;
+
+    pChunk = ((mng_chunk_headerp)pChunk)->pPrev;
+  }
+
+  return pChunk;
+}
+#endif /* MNG_SUPPORT_DISPLAY && MNG_ACCESS_CHUNKS && MNG_STORE_CHUNKS */
+
+/* ************************************************************************** */
+
 mng_retcode MNG_DECL mng_getimgdata_seq (mng_handle        hHandle,
                                          mng_uint32        iSeqnr,
                                          mng_uint32        iCanvasstyle,
                                          mng_getcanvasline fGetcanvasline)
 {
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+  mng_datap   pData;
+  mng_chunkp  pChunk;
+  mng_uint32  iSeq = 0;
+  mng_retcode iRetcode;
+#endif
+
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_GETIMGDATA_SEQ, MNG_LC_START);
 #endif
 
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+  MNG_VALIDHANDLE (hHandle)            /* check validity handle */
+  pData = ((mng_datap)hHandle);        /* and make it addressable */
+
+  if (!fGetcanvasline)                 /* nowhere to put it ? */
+    MNG_ERROR (pData, MNG_NOCALLBACK);
+
+  pChunk = pData->pFirstchunk;         /* find the nth image-header */
+
+  while ((pChunk) && ((!is_image_header (pChunk)) || (iSeq++ < iSeqnr)))
+    pChunk = ((mng_chunk_headerp)pChunk)->pNext;
 
+  if (!pChunk)                         /* past the last image ? */
+    MNG_ERROR (pData, MNG_NOCORRCHUNK);
 
+  iRetcode = mng_decode_imgdata (pData, pChunk, iCanvasstyle, fGetcanvasline);
+
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_GETIMGDATA_SEQ, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+#else
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_GETIMGDATA_SEQ, MNG_LC_END);
 #endif
 
   return MNG_FNNOTIMPLEMENTED;
+#endif
 }
 
 /* ************************************************************************** */
@@ -6840,17 +5989,55 @@ mng_retcode MNG_DECL mng_getimgdata_chunkseq (mng_handle        hHandle,
                                               mng_uint32        iCanvasstyle,
                                               mng_getcanvasline fGetcanvasline)
 {
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+  mng_datap   pData;
+  mng_chunkp  pChunk;
+  mng_uint32  iSeq = 0;
+  mng_retcode iRetcode;
+#endif
+
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_GETIMGDATA_CHUNKSEQ, MNG_LC_START);
 #endif
 
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+  MNG_VALIDHANDLE (hHandle)            /* check validity handle */
+  pData = ((mng_datap)hHandle);        /* and make it addressable */
+
+  if (!fGetcanvasline)                 /* nowhere to put it ? */
+    MNG_ERROR (pData, MNG_NOCALLBACK);
+
+  pChunk = pData->pFirstchunk;         /* find the nth chunk */
 
+  while ((pChunk) && (iSeq < iSeqnr))
+  {
+    pChunk = ((mng_chunk_headerp)pChunk)->pNext;
+    iSeq++;
+  }
+
+  if (pChunk)                          /* and the image it belongs to */
+    pChunk = find_image_header (pChunk);
+
+  if (!pChunk)
+    MNG_ERROR (pData, MNG_NOCORRCHUNK);
+
+  iRetcode = mng_decode_imgdata (pData, pChunk, iCanvasstyle, fGetcanvasline);
+
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
 
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_GETIMGDATA_CHUNKSEQ, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+#else
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_GETIMGDATA_CHUNKSEQ, MNG_LC_END);
 #endif
 
   return MNG_FNNOTIMPLEMENTED;
+#endif
 }
 
 /* ************************************************************************** */
@@ -6860,17 +6047,48 @@ mng_retcode MNG_DECL mng_getimgdata_chunk (mng_handle        hHandle,
                                            mng_uint32        iCanvasstyle,
                                            mng_getcanvasline fGetcanvasline)
 {
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+  mng_datap   pData;
+  mng_chunkp  pChunk;
+  mng_retcode iRetcode;
+#endif
+
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_GETIMGDATA_CHUNK, MNG_LC_START);
 #endif
 
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+  MNG_VALIDHANDLE (hHandle)            /* check validity handle */
+  pData = ((mng_datap)hHandle);        /* and make it addressable */
+
+  if (!fGetcanvasline)                 /* nowhere to put it ? */
+    MNG_ERROR (pData, MNG_NOCALLBACK);
+
+  pChunk = MNG_NULL;                   /* find the image it belongs to */
+
+  if (hChunk)
+    pChunk = find_image_header ((mng_chunkp)hChunk);
 
+  if (!pChunk)
+    MNG_ERROR (pData, MNG_NOCORRCHUNK);
+
+  iRetcode = mng_decode_imgdata (pData, pChunk, iCanvasstyle, fGetcanvasline);
+
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
 
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_GETIMGDATA_CHUNK, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+#else
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_GETIMGDATA_CHUNK, MNG_LC_END);
 #endif
 
   return MNG_FNNOTIMPLEMENTED;
+#endif
 }
 
 /* ************************************************************************** */
@@ -6880,6 +6098,167 @@ mng_retcode MNG_DECL mng_getimgdata_chunk (mng_handle        hHandle,
 
 /* ************************************************************************** */
 
+#ifdef MNG_INCLUDE_ZLIB
+MNG_LOCAL mng_uint32 const imgdata_row     [7] = { 0, 0, 4, 0, 2, 0, 1 };
+MNG_LOCAL mng_uint32 const imgdata_rowskip [7] = { 8, 8, 8, 4, 4, 2, 2 };
+MNG_LOCAL mng_uint32 const imgdata_col     [7] = { 0, 4, 0, 2, 0, 1, 0 };
+MNG_LOCAL mng_uint32 const imgdata_colskip [7] = { 8, 8, 4, 4, 2, 2, 1 };
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_uint32 canvas_pixelsize (mng_uint32 iCanvasstyle)
+{
+  mng_uint32 iPixelsize = (MNG_CANVAS_GRAY (iCanvasstyle) ? 1 : 3);
+
+  if (MNG_CANVAS_HASALPHA (iCanvasstyle))
+    iPixelsize++;
+  if (MNG_CANVAS_HASFILLER (iCanvasstyle))
+    iPixelsize++;
+  if (MNG_CANVAS_16BIT (iCanvasstyle))
+    iPixelsize <<= 1;
+
+  return iPixelsize;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode fetch_imgdata_row (mng_uint8p pScanline,
+                                         mng_uint32 iCanvasstyle,
+                                         mng_uint8  iColortype,
+                                         mng_uint8  iBitdepth,
+                                         mng_uint32 iCol,
+                                         mng_uint32 iColinc,
+                                         mng_uint32 iSamples,
+                                         mng_uint8p pOut)
+{
+  mng_bool   b16        = (mng_bool)(MNG_CANVAS_16BIT (iCanvasstyle) != 0);
+  mng_bool   bAlpha     = (mng_bool)(MNG_CANVAS_HASALPHA (iCanvasstyle) != 0);
+  mng_uint32 iPixelsize = canvas_pixelsize (iCanvasstyle);
+  mng_uint32 iShift     = 16 - iBitdepth;
+  mng_uint32 iBits      = 0;
+  mng_uint32 iAcc       = 0;
+  mng_uint32 aSample [5];
+  mng_uint32 iR, iG, iB, iA;
+  mng_uint32 iS, iN;
+  mng_uint32 iX;
+  mng_uint8p pPixel;
+
+  for (iX = 0; iX < iSamples; iX++)
+  {
+    pPixel = pScanline + (iCol + iX * iColinc) * iPixelsize;
+                                       /* get the pixel as 16-bit samples */
+    if (MNG_CANVAS_GRAY (iCanvasstyle))
+      iN = 1;
+    else
+      iN = 3;
+
+    if (bAlpha)
+      iN++;
+
+    for (iS = 0; iS < iN; iS++)
+    {
+      if (b16)
+        aSample [iS] = mng_get_uint16 (pPixel + (iS << 1));
+      else
+        aSample [iS] = (mng_uint32)*(pPixel + iS) * 257;
+    }
+
+    iS = 0;                            /* and take them apart */
+    iA = 0xFFFF;
+
+    if ((bAlpha) && (MNG_CANVAS_ALPHAFIRST (iCanvasstyle)))
+      iA = aSample [iS++];
+
+    if (MNG_CANVAS_GRAY (iCanvasstyle))
+    {
+      iR = aSample [iS++];
+      iG = iR;
+      iB = iR;
+    }
+    else
+    if (MNG_CANVAS_BGR (iCanvasstyle))
+    {
+      iB = aSample [iS++];
+      iG = aSample [iS++];
+      iR = aSample [iS++];
+    }
+    else
+    {
+      iR = aSample [iS++];
+      iG = aSample [iS++];
+      iB = aSample [iS++];
+    }
+
+    if ((bAlpha) && (!MNG_CANVAS_ALPHAFIRST (iCanvasstyle)))
+      iA = aSample [iS];
+                                       /* now the samples for the colortype */
+    iN = 0;
+
+    switch (iColortype)
+    {
+      case MNG_COLORTYPE_INDEXED :
+        {                              /* the gray8 canvas holds the index */
+          if ((mng_uint32)*pPixel >> iBitdepth)
+            return MNG_INVALIDINDEX;
+
+          aSample [iN++] = (mng_uint32)*pPixel << iShift;
+          break;
+        }
+      case MNG_COLORTYPE_GRAY  :
+      case MNG_COLORTYPE_GRAYA :
+        {                              /* same weights as getimgdata */
+          if (!MNG_CANVAS_GRAY (iCanvasstyle))
+            iR = (iR * 77 + iG * 150 + iB * 29) >> 8;
+
+          aSample [iN++] = iR;
+          break;
+        }
+      default :
+        {
+          aSample [iN++] = iR;
+          aSample [iN++] = iG;
+          aSample [iN++] = iB;
+        }
+    }
+
+    if ((iColortype == MNG_COLORTYPE_GRAYA) || (iColortype == MNG_COLORTYPE_RGBA))
+      aSample [iN++] = iA;
+
+    for (iS = 0; iS < iN; iS++)        /* and store them at the bitdepth */
+    {
+      if (iBitdepth == 16)
+      {
+        mng_put_uint16 (pOut, (mng_uint16)aSample [iS]);
+        pOut += 2;
+      }
+      else
+      if (iBitdepth == 8)
+        *pOut++ = (mng_uint8)(aSample [iS] >> 8);
+      else
+      {                                /* sub-byte samples are packed from
+                                          the most significant bit down */
+        iAcc   = (iAcc << iBitdepth) | (aSample [iS] >> iShift);
+        iBits += iBitdepth;
+
+        if (iBits == 8)
+        {
+          *pOut++ = (mng_uint8)iAcc;
+          iAcc    = 0;
+          iBits   = 0;
+        }
+      }
+    }
+  }
+
+  if (iBits)                           /* partial byte at the end ? */
+    *pOut = (mng_uint8)(iAcc << (8 - iBits));
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_INCLUDE_ZLIB */
+
+/* ************************************************************************** */
+
 mng_retcode MNG_DECL mng_putimgdata_ihdr (mng_handle        hHandle,
                                           mng_uint32        iWidth,
                                           mng_uint32        iHeight,
@@ -6891,17 +6270,189 @@ mng_retcode MNG_DECL mng_putimgdata_ihdr (mng_handle        hHandle,
                                           mng_uint32        iCanvasstyle,
                                           mng_getcanvasline fGetcanvasline)
 {
+#ifdef MNG_INCLUDE_ZLIB
+  mng_datap   pData;
+  mng_uint32  iChannels;
+  mng_uint32  iBpp;
+  mng_uint32  iRowbytes;
+  mng_uint8   iFiltersel;
+  mng_uint8p  pRaw   = MNG_NULL;
+  mng_uint8p  pPrior = MNG_NULL;
+  mng_uint8p  pOut   = MNG_NULL;
+  mng_uint8p  pTemp  = MNG_NULL;
+  mng_uint8p  pFiltered;
+  mng_uint8p  pSwap;
+  mng_uint8p  pScanline;
+  mng_int32   iPass;
+  mng_uint32  iRow, iCols, iBytes;
+  mng_uint32  iX;
+  mng_retcode iError   = MNG_NOERROR;
+  mng_retcode iRetcode = MNG_NOERROR;
+#endif
+
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTIMGDATA_IHDR, MNG_LC_START);
 #endif
 
+#ifdef MNG_INCLUDE_ZLIB
+  MNG_VALIDHANDLE (hHandle)            /* check validity handle */
+  pData = (mng_datap)hHandle;          /* and make it addressable */
+
+  if (!pData->bCreating)               /* aren't we creating a new file ? */
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID)
+                                       /* must have had a header first! */
+  if (pData->iFirstchunkadded == 0)
+    MNG_ERROR (pData, MNG_NOHEADER)
+
+  if (pData->bDeflating)               /* can't do two at once */
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID)
+
+  if (!fGetcanvasline)                 /* where do we get the rows from ? */
+    MNG_ERROR (pData, MNG_NOCALLBACK)
+
+  if (iWidth == 0)                     /* check the image parameters */
+    MNG_ERROR (pData, MNG_INVALIDWIDTH)
+  if (iHeight == 0)
+    MNG_ERROR (pData, MNG_INVALIDHEIGHT)
+  if (iCompression != MNG_COMPRESSION_DEFLATE)
+    MNG_ERROR (pData, MNG_INVALIDCOMPRESS)
+  if (iFilter != MNG_FILTER_ADAPTIVE)
+    MNG_ERROR (pData, MNG_INVALIDFILTER)
+  if ((iInterlace != MNG_INTERLACE_NONE) && (iInterlace != MNG_INTERLACE_ADAM7))
+    MNG_ERROR (pData, MNG_INVALIDINTERLACE)
+
+  switch (iColortype)
+  {
+    case MNG_COLORTYPE_GRAY    : { iChannels = 1; break; }
+    case MNG_COLORTYPE_RGB     : { iChannels = 3; break; }
+    case MNG_COLORTYPE_INDEXED : { iChannels = 1; break; }
+    case MNG_COLORTYPE_GRAYA   : { iChannels = 2; break; }
+    case MNG_COLORTYPE_RGBA    : { iChannels = 4; break; }
+    default                    : MNG_ERROR (pData, MNG_INVALIDCOLORTYPE)
+  }
+
+  if ((iBitdepth != 1) && (iBitdepth != 2) && (iBitdepth != 4) &&
+      (iBitdepth != 8) && (iBitdepth != 16))
+    MNG_ERROR (pData, MNG_INVALIDBITDEPTH)
+
+  if (((iColortype == MNG_COLORTYPE_INDEXED) && (iBitdepth == 16)) ||
+      ((iColortype != MNG_COLORTYPE_GRAY) && (iColortype != MNG_COLORTYPE_INDEXED) &&
+       (iBitdepth < 8)))
+    MNG_ERROR (pData, MNG_INVALIDBITDEPTH)
+                                       /* and what we can read from */
+  if ((MNG_CANVAS_PIXELTYPE (iCanvasstyle) > 2) ||
+      (MNG_CANVAS_ALPHASEPD (iCanvasstyle)) ||
+      (MNG_CANVAS_ALPHAPM (iCanvasstyle)) ||
+      ((iColortype == MNG_COLORTYPE_INDEXED) && (iCanvasstyle != MNG_CANVAS_GRAY8)))
+    MNG_ERROR (pData, MNG_INVALIDCNVSTYLE)
+
+  iBpp      = iChannels * iBitdepth;   /* bits per pixel */
+  iRowbytes = (iWidth * iBpp + 7) >> 3;
+  iBpp      = (iBpp + 7) >> 3;         /* and bytes for the filters */
+                                       /* the PNG spec advises against
+                                          filtering palette & sub-byte rows */
+  if ((iColortype == MNG_COLORTYPE_INDEXED) || (iBitdepth < 8))
+    iFiltersel = MNG_FILTERSEL_NONE;
+  else
+    iFiltersel = pData->iFiltersel;
+                                       /* get the temporary buffers */
+  MNG_ALLOC (pData, pRaw, iRowbytes);
+  MNG_ALLOCX (pData, pPrior, iRowbytes);
+  MNG_ALLOCX (pData, pOut, iRowbytes + 1);
+  MNG_ALLOCX (pData, pTemp, iRowbytes + 1);
+
+  pData->iZoutsize = (pData->iMaxIDAT ? pData->iMaxIDAT : MNG_MAX_IDAT_SIZE);
+
+  MNG_ALLOCX (pData, pData->pZoutbuf, pData->iZoutsize);
+
+  if ((!pPrior) || (!pOut) || (!pTemp) || (!pData->pZoutbuf))
+    iError = MNG_OUTOFMEMORY;
+  else
+    iRetcode = mngzlib_deflateinit (pData);
+
+  if ((!iError) && (!iRetcode))
+  {                                    /* let zlib know where the IDATs go */
+    pData->sZlib.next_out  = pData->pZoutbuf;
+    pData->sZlib.avail_out = (uInt)pData->iZoutsize;
+                                       /* one pass or seven */
+    for (iPass = (iInterlace ? 0 : 6); (iPass < 7) && (!iError) && (!iRetcode); iPass++)
+    {
+      if (iInterlace)
+      {
+        if (imgdata_col [iPass] >= iWidth)
+          iCols = 0;
+        else
+          iCols = (iWidth - imgdata_col [iPass] + imgdata_colskip [iPass] - 1) /
+                  imgdata_colskip [iPass];
+
+        iRow = imgdata_row [iPass];
+      }
+      else
+      {
+        iCols = iWidth;
+        iRow  = 0;
+      }
+
+      iBytes = (iCols * iChannels * iBitdepth + 7) >> 3;
+                                       /* each pass starts with a blank slate */
+      for (iX = 0; iX < iBytes; iX++)
+        *(pPrior + iX) = 0;
+                                       /* empty passes aren't stored at all */
+      while ((iCols) && (iRow < iHeight) && (!iError) && (!iRetcode))
+      {
+        pScanline = (mng_uint8p)fGetcanvasline (hHandle, iRow);
+
+        if (!pScanline)
+          iError = MNG_APPMISCERROR;
+        else
+          iError = fetch_imgdata_row (pScanline, iCanvasstyle, iColortype, iBitdepth,
+                                      (iInterlace ? imgdata_col     [iPass] : 0),
+                                      (iInterlace ? imgdata_colskip [iPass] : 1),
+                                      iCols, pRaw);
+
+        if (!iError)
+        {                              /* pick the filter & deflate the row */
+          pFiltered = mng_select_filter (pData, iFiltersel, (mng_int32)iBpp,
+                                         (mng_int32)iBytes, pRaw, pPrior, pOut, pTemp);
+          iRetcode  = mngzlib_deflaterows (pData, iBytes + 1, pFiltered);
+        }
+
+        pSwap  = pPrior;               /* this row is the next one's prior */
+        pPrior = pRaw;
+        pRaw   = pSwap;
+
+        iRow += (iInterlace ? imgdata_rowskip [iPass] : 1);
+      }
+    }
+                                       /* flush the last IDAT */
+    if ((!iError) && (!iRetcode))
+      iRetcode = mngzlib_deflaterows (pData, 0, MNG_NULL);
+  }
 
+  if (pData->bDeflating)               /* cleanup */
+    mngzlib_deflatefree (pData);
+
+  MNG_FREE  (pData, pData->pZoutbuf, pData->iZoutsize);
+  MNG_FREEX (pData, pTemp, iRowbytes + 1);
+  MNG_FREEX (pData, pOut, iRowbytes + 1);
+  MNG_FREEX (pData, pPrior, iRowbytes);
+  MNG_FREEX (pData, pRaw, iRowbytes);
+
+  pData->iZoutsize = 0;
+
+  if (iError)                          /* our own problem ? */
+    MNG_ERROR (pData, iError)
+#endif /* MNG_INCLUDE_ZLIB */
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTIMGDATA_IHDR, MNG_LC_END);
 #endif
 
+#ifdef MNG_INCLUDE_ZLIB
+  return iRetcode;
+#else
   return MNG_FNNOTIMPLEMENTED;
+#endif
 }
 
 /* ************************************************************************** */
@@ -70,6 +70,12 @@
 /* *             1.0.9 - 12/20/2004 - G.Juyn                                * */
 /* *             - cleaned up macro-invocations (thanks to D. Airlie)       * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - gamma-only correction of the gray+alpha row              * */
+/* *             - gamma-tables are cached per exponent                     * */
+/* *             - full 16-bit gamma correction (was high-order byte only)  * */
+/* *             - added a transform cache for full cms                     * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -80,6 +86,8 @@
 #pragma hdrstop
 #endif
 #include "libmng_objects.h"
+#include "libmng_memory.h"
+#include "libmng_chunk_io.h"
 #include "libmng_cms.h"
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -169,10 +177,12 @@ mng_retcode mng_clear_cms (mng_datap pData)
   MNG_TRACE (pData, MNG_FN_CLEAR_CMS, MNG_LC_START);
 #endif
 
-  if (pData->hTrans)                   /* transformation still active ? */
+                                       /* transformation still active ? */
+  if ((pData->hTrans) && (!pData->bTranscached))
     mnglcms_freetransform (pData->hTrans);
 
-  pData->hTrans = 0;
+  pData->hTrans       = 0;             /* (cached ones stay in the cache) */
+  pData->bTranscached = MNG_FALSE;
 
   if (pData->hProf1)                   /* file profile still active ? */
     mnglcms_freeprofile (pData->hProf1);
@@ -188,6 +198,156 @@ mng_retcode mng_clear_cms (mng_datap pData)
 
 /* ************************************************************************** */
 
+mng_retcode mng_drop_cmscache (mng_datap pData)
+{
+  mng_cmsentryp pEntry = pData->aCmscache;
+  mng_uint32    iX;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_DROP_CMSCACHE, MNG_LC_START);
+#endif
+
+  for (iX = 0; iX < MNG_CMSCACHESIZE; iX++, pEntry++)
+  {
+    if (pEntry->hTrans)
+    {                                  /* still in use ? */
+      if ((pData->bTranscached) && (pEntry->hTrans == pData->hTrans))
+      {                                /* then mng_clear_cms gets to free it */
+        pData->bTranscached = MNG_FALSE;
+        pData->hProf1       = pEntry->hProf;
+      }
+      else
+      {
+        mnglcms_freetransform (pEntry->hTrans);
+
+        if (pEntry->hProf)
+          mnglcms_freeprofile (pEntry->hProf);
+      }
+
+      if (pEntry->pProfile)
+        MNG_FREEX (pData, pEntry->pProfile, pEntry->sKey.iProfilesize);
+
+      pEntry->pProfile = MNG_NULL;
+      pEntry->hProf    = 0;
+      pEntry->hTrans   = 0;
+    }
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_DROP_CMSCACHE, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void init_cmskey (mng_datap   pData,
+                            mng_cmskey *pKey,
+                            mng_uint32  iSource)
+{
+  mng_uint8p pTemp = (mng_uint8p)pKey;
+  mng_uint32 iX;
+                                       /* keys are hashed & compared bytewise, */
+  for (iX = 0; iX < sizeof (mng_cmskey); iX++)
+    *pTemp++ = 0;                      /* so clear any padding as well */
+
+  pKey->iSource = iSource;
+  pKey->iRGBA16 = (mng_uint32)pData->bIsRGBA16;
+  pKey->iIntent = INTENT_PERCEPTUAL;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool find_cmstrans (mng_datap   pData,
+                                  mng_cmskey *pKey,
+                                  mng_uint8p  pProfile)
+{
+  mng_cmsentryp pEntry = pData->aCmscache;
+  mng_uint32    iHash;
+  mng_uint32    iX;
+
+  if (!pData->iCmscachesize)           /* cache turned off ? */
+    return MNG_FALSE;
+
+  iHash = mng_crc (pData, (mng_uint8p)pKey, sizeof (mng_cmskey));
+
+  for (iX = 0; iX < pData->iCmscachesize; iX++, pEntry++)
+  {
+    if ((pEntry->hTrans) && (pEntry->iHash == iHash) &&
+        (!memcmp (&pEntry->sKey, pKey, sizeof (mng_cmskey))) &&
+        ((!pProfile) || (!memcmp (pEntry->pProfile, pProfile, pKey->iProfilesize))))
+    {
+      pData->hTrans       = pEntry->hTrans;
+      pData->bTranscached = MNG_TRUE;
+      pEntry->iLastused   = ++pData->iCmscacheclock;
+      pData->iCmscachehits++;
+
+      return MNG_TRUE;
+    }
+  }
+
+  pData->iCmscachemisses++;
+
+  return MNG_FALSE;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void store_cmstrans (mng_datap   pData,
+                               mng_cmskey *pKey,
+                               mng_uint8p  pProfile)
+{
+  mng_cmsentryp pEntry;
+  mng_uint8p    pCopy = MNG_NULL;
+  mng_uint32    iX;
+
+  if (!pData->iCmscachesize)           /* cache turned off ? */
+    return;
+
+  if (pProfile)                        /* keep a copy for comparison */
+  {
+    MNG_ALLOCX (pData, pCopy, pKey->iProfilesize);
+
+    if (!pCopy)                        /* no memory; then just don't cache */
+      return;
+
+    MNG_COPY (pCopy, pProfile, pKey->iProfilesize);
+  }
+                                       /* find a free or the oldest entry */
+  pEntry = pData->aCmscache;
+
+  for (iX = 1; (iX < pData->iCmscachesize) && (pEntry->hTrans); iX++)
+  {
+    if ((!pData->aCmscache [iX].hTrans) ||
+        (pData->aCmscache [iX].iLastused < pEntry->iLastused))
+      pEntry = &pData->aCmscache [iX];
+  }
+
+  if (pEntry->hTrans)                  /* drop the old one */
+  {
+    mnglcms_freetransform (pEntry->hTrans);
+
+    if (pEntry->hProf)
+      mnglcms_freeprofile (pEntry->hProf);
+
+    if (pEntry->pProfile)
+      MNG_FREEX (pData, pEntry->pProfile, pEntry->sKey.iProfilesize);
+  }
+
+  pEntry->iHash       = mng_crc (pData, (mng_uint8p)pKey, sizeof (mng_cmskey));
+  pEntry->sKey        = *pKey;
+  pEntry->pProfile    = pCopy;
+  pEntry->hProf       = pData->hProf1; /* the cache owns them from now on */
+  pEntry->hTrans      = pData->hTrans;
+  pEntry->iLastused   = ++pData->iCmscacheclock;
+
+  pData->hProf1       = 0;
+  pData->bTranscached = MNG_TRUE;
+}
+
+/* ************************************************************************** */
+
 #endif /* MNG_INCLUDE_LCMS */
 
 /* ************************************************************************** */
@@ -205,8 +365,13 @@ mng_retcode mng_init_full_cms (mng_datap pData,
 {
   mng_cmsprof    hProf;
   mng_cmstrans   hTrans;
+  mng_cmskey     sKey;
   mng_imagep     pImage = MNG_NULL;
   mng_imagedatap pBuf   = MNG_NULL;
+#ifndef MNG_SKIPCHUNK_iCCP
+  mng_uint8p     pProfile;
+  mng_uint32     iProfilesize;
+#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_INIT_FULL_CMS, MNG_LC_START);
@@ -239,31 +404,48 @@ mng_retcode mng_init_full_cms (mng_datap pData,
           MNG_ERRORL (pData, MNG_LCMS_NOHANDLE);
       }
 
-      if ((pBuf) && (pBuf->bHasICCP))  /* generate a profile handle */
-        hProf = cmsOpenProfileFromMem (pBuf->pProfile, pBuf->iProfilesize);
+      if ((pBuf) && (pBuf->bHasICCP))  /* which profile ? */
+      {
+        pProfile     = (mng_uint8p)pBuf->pProfile;
+        iProfilesize = pBuf->iProfilesize;
+      }
       else
-        hProf = cmsOpenProfileFromMem (pData->pGlobalProfile, pData->iGlobalProfilesize);
+      {
+        pProfile     = (mng_uint8p)pData->pGlobalProfile;
+        iProfilesize = pData->iGlobalProfilesize;
+      }
 
-      pData->hProf1 = hProf;           /* save for future use */
+      init_cmskey (pData, &sKey, MNG_CMSSOURCE_ICCP);
+      sKey.iProfilesize = iProfilesize;
+      sKey.iProfilecrc  = mng_crc (pData, pProfile, iProfilesize);
+                                       /* seen this one before ? */
+      if (!find_cmstrans (pData, &sKey, pProfile))
+      {                                /* generate a profile handle */
+        hProf = cmsOpenProfileFromMem (pProfile, iProfilesize);
 
-      if (!hProf)                      /* handle error ? */
-        MNG_ERRORL (pData, MNG_LCMS_NOHANDLE);
+        pData->hProf1 = hProf;         /* save for future use */
+
+        if (!hProf)                    /* handle error ? */
+          MNG_ERRORL (pData, MNG_LCMS_NOHANDLE);
 
 #ifndef MNG_NO_16BIT_SUPPORT
-      if (pData->bIsRGBA16)            /* 16-bit intermediates ? */
-        hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_16_SE,
-                                     pData->hProf2, TYPE_RGBA_16_SE,
-                                     INTENT_PERCEPTUAL, MNG_CMS_FLAGS);
-      else
+        if (pData->bIsRGBA16)          /* 16-bit intermediates ? */
+          hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_16_SE,
+                                       pData->hProf2, TYPE_RGBA_16_SE,
+                                       INTENT_PERCEPTUAL, MNG_CMS_FLAGS);
+        else
 #endif
-        hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_8,
-                                     pData->hProf2, TYPE_RGBA_8,
-                                     INTENT_PERCEPTUAL, MNG_CMS_FLAGS);
+          hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_8,
+                                       pData->hProf2, TYPE_RGBA_8,
+                                       INTENT_PERCEPTUAL, MNG_CMS_FLAGS);
 
-      pData->hTrans = hTrans;          /* save for future use */
+        pData->hTrans = hTrans;        /* save for future use */
 
-      if (!hTrans)                     /* handle error ? */
-        MNG_ERRORL (pData, MNG_LCMS_NOTRANS);
+        if (!hTrans)                   /* handle error ? */
+          MNG_ERRORL (pData, MNG_LCMS_NOTRANS);
+
+        store_cmstrans (pData, &sKey, pProfile);
+      }
                                        /* load color-correction routine */
       pData->fCorrectrow = (mng_fptr)mng_correct_full_cms;
 
@@ -293,19 +475,27 @@ mng_retcode mng_init_full_cms (mng_datap pData,
       else
         iIntent = pData->iGlobalRendintent;
 
-      if (pData->bIsRGBA16)            /* 16-bit intermediates ? */
-        hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_16_SE,
-                                     pData->hProf2, TYPE_RGBA_16_SE,
-                                     iIntent, MNG_CMS_FLAGS);
-      else
-        hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_8,
-                                     pData->hProf2, TYPE_RGBA_8,
-                                     iIntent, MNG_CMS_FLAGS);
+      init_cmskey (pData, &sKey, MNG_CMSSOURCE_SRGB);
+      sKey.iIntent = iIntent;
+                                       /* seen this one before ? */
+      if (!find_cmstrans (pData, &sKey, MNG_NULL))
+      {
+        if (pData->bIsRGBA16)          /* 16-bit intermediates ? */
+          hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_16_SE,
+                                       pData->hProf2, TYPE_RGBA_16_SE,
+                                       iIntent, MNG_CMS_FLAGS);
+        else
+          hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_8,
+                                       pData->hProf2, TYPE_RGBA_8,
+                                       iIntent, MNG_CMS_FLAGS);
 
-      pData->hTrans = hTrans;          /* save for future use */
+        pData->hTrans = hTrans;        /* save for future use */
 
-      if (!hTrans)                     /* handle error ? */
-        MNG_ERRORL (pData, MNG_LCMS_NOTRANS);
+        if (!hTrans)                   /* handle error ? */
+          MNG_ERRORL (pData, MNG_LCMS_NOTRANS);
+
+        store_cmstrans (pData, &sKey, MNG_NULL);
+      }
                                        /* load color-correction routine */
       pData->fCorrectrow = (mng_fptr)mng_correct_full_cms;
 
@@ -366,36 +556,52 @@ mng_retcode mng_init_full_cms (mng_datap pData,
 
       dGamma = pData->dViewgamma / dGamma;
 
-      pGammatable [0] =                /* and build the lookup tables */
-      pGammatable [1] =
-      pGammatable [2] = cmsBuildGamma (256, dGamma);
+      init_cmskey (pData, &sKey, MNG_CMSSOURCE_CHRM);
+      sKey.dGamma      = dGamma;
+      sKey.aChroma [0] = sWhitepoint.x;
+      sKey.aChroma [1] = sWhitepoint.y;
+      sKey.aChroma [2] = sPrimaries.Red.x;
+      sKey.aChroma [3] = sPrimaries.Red.y;
+      sKey.aChroma [4] = sPrimaries.Green.x;
+      sKey.aChroma [5] = sPrimaries.Green.y;
+      sKey.aChroma [6] = sPrimaries.Blue.x;
+      sKey.aChroma [7] = sPrimaries.Blue.y;
+                                       /* seen this one before ? */
+      if (!find_cmstrans (pData, &sKey, MNG_NULL))
+      {
+        pGammatable [0] =              /* and build the lookup tables */
+        pGammatable [1] =
+        pGammatable [2] = cmsBuildGamma (256, dGamma);
 
-      if (!pGammatable [0])            /* enough memory ? */
-        MNG_ERRORL (pData, MNG_LCMS_NOMEM);
+        if (!pGammatable [0])          /* enough memory ? */
+          MNG_ERRORL (pData, MNG_LCMS_NOMEM);
                                        /* create the profile */
-      hProf = cmsCreateRGBProfile (&sWhitepoint, &sPrimaries, pGammatable);
+        hProf = cmsCreateRGBProfile (&sWhitepoint, &sPrimaries, pGammatable);
 
-      cmsFreeGamma (pGammatable [0]);  /* free the temporary gamma tables ? */
+        cmsFreeGamma (pGammatable [0]);/* free the temporary gamma tables ? */
                                        /* yes! but just the one! */
 
-      pData->hProf1 = hProf;           /* save for future use */
+        pData->hProf1 = hProf;         /* save for future use */
 
-      if (!hProf)                      /* handle error ? */
-        MNG_ERRORL (pData, MNG_LCMS_NOHANDLE);
+        if (!hProf)                    /* handle error ? */
+          MNG_ERRORL (pData, MNG_LCMS_NOHANDLE);
 
-      if (pData->bIsRGBA16)            /* 16-bit intermediates ? */
-        hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_16_SE,
-                                     pData->hProf2, TYPE_RGBA_16_SE,
-                                     INTENT_PERCEPTUAL, MNG_CMS_FLAGS);
-      else
-        hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_8,
-                                     pData->hProf2, TYPE_RGBA_8,
-                                     INTENT_PERCEPTUAL, MNG_CMS_FLAGS);
+        if (pData->bIsRGBA16)          /* 16-bit intermediates ? */
+          hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_16_SE,
+                                       pData->hProf2, TYPE_RGBA_16_SE,
+                                       INTENT_PERCEPTUAL, MNG_CMS_FLAGS);
+        else
+          hTrans = cmsCreateTransform (hProf,         TYPE_RGBA_8,
+                                       pData->hProf2, TYPE_RGBA_8,
+                                       INTENT_PERCEPTUAL, MNG_CMS_FLAGS);
 
-      pData->hTrans = hTrans;          /* save for future use */
+        pData->hTrans = hTrans;        /* save for future use */
 
-      if (!hTrans)                     /* handle error ? */
-        MNG_ERRORL (pData, MNG_LCMS_NOTRANS);
+        if (!hTrans)                   /* handle error ? */
+          MNG_ERRORL (pData, MNG_LCMS_NOTRANS);
+
+        store_cmstrans (pData, &sKey, MNG_NULL);
+      }
                                        /* load color-correction routine */
       pData->fCorrectrow = (mng_fptr)mng_correct_full_cms;
 
@@ -480,16 +686,44 @@ mng_retcode mng_init_gamma_only (mng_datap pData,
     {
       dGamma = pData->dViewgamma / (dGamma * pData->dDisplaygamma);
 
-      if (dGamma != pData->dLastgamma) /* lookup table needs to be computed ? */
+      if (dGamma != pData->dLastgamma) /* lookup table needs to be loaded ? */
       {
-        mng_int32 iX;
-
-        pData->aGammatab [0] = 0;
-
-        for (iX = 1; iX <= 255; iX++)
-          pData->aGammatab [iX] = (mng_uint8)(pow (iX / 255.0, dGamma) * 255 + 0.5);
-
-        pData->dLastgamma = dGamma;    /* keep for next time */
+        mng_gammaentryp pEntry = MNG_NULL;
+        mng_uint32      iSlot;
+                                       /* calculated this one before ? */
+        for (iSlot = 0; iSlot < MNG_GAMMACACHESIZE; iSlot++)
+        {
+          if (pData->aGammacache [iSlot].dGamma == dGamma)
+          {
+            pEntry = &pData->aGammacache [iSlot];
+            break;
+          }
+        }
+
+        if (!pEntry)                   /* no; replace the oldest entry */
+        {
+          mng_int32 iX;
+
+          iSlot  = pData->iGammanext;
+          pEntry = &pData->aGammacache [iSlot];
+          pData->iGammanext = (iSlot + 1) % MNG_GAMMACACHESIZE;
+
+          if (pEntry->pTab16)          /* drop its 16-bit table */
+            MNG_FREE (pData, pEntry->pTab16, 65536 * sizeof (mng_uint16));
+
+          pEntry->aTab8 [0] = 0;
+
+          for (iX = 1; iX <= 255; iX++)
+            pEntry->aTab8 [iX] = (mng_uint8)(pow (iX / 255.0, dGamma) * 255 + 0.5);
+
+          pEntry->dGamma = dGamma;
+        }
+
+        MNG_COPY (pData->aGammatab, pEntry->aTab8, 256);
+
+        pData->pGammatab16 = pEntry->pTab16;
+        pData->iGammaslot  = iSlot;
+        pData->dLastgamma  = dGamma;   /* keep for next time */
       }
                                        /* load color-correction routine */
       pData->fCorrectrow = (mng_fptr)mng_correct_gamma_only;
@@ -507,6 +741,30 @@ mng_retcode mng_init_gamma_only (mng_datap pData,
 /* ************************************************************************** */
 
 #if defined(MNG_GAMMA_ONLY) || defined(MNG_FULL_CMS) || defined(MNG_APP_CMS)
+#ifndef MNG_NO_16BIT_SUPPORT
+MNG_LOCAL mng_retcode build_gammatab16 (mng_datap pData)
+{
+  mng_gammaentryp pEntry = &pData->aGammacache [pData->iGammaslot];
+  mng_float       dGamma = pEntry->dGamma;
+  mng_uint16p     pTab;
+  mng_int32       iX;
+
+  MNG_ALLOC (pData, pTab, 65536 * sizeof (mng_uint16));
+
+  pTab [0] = 0;
+
+  for (iX = 1; iX <= 65535; iX++)
+    pTab [iX] = (mng_uint16)(pow (iX / 65535.0, dGamma) * 65535 + 0.5);
+
+  pEntry->pTab16     = pTab;           /* keep it with its 8-bit sibling */
+  pData->pGammatab16 = pTab;
+
+  return MNG_NOERROR;
+}
+#endif
+
+/* ************************************************************************** */
+
 mng_retcode mng_correct_gamma_only (mng_datap pData)
 {
   mng_uint8p pWork;
@@ -518,23 +776,60 @@ mng_retcode mng_correct_gamma_only (mng_datap pData)
 
   pWork = pData->pRGBArow;             /* address intermediate row */
 
+#ifndef MNG_NO_16BIT_SUPPORT
   if (pData->bIsRGBA16)                /* 16-bit intermediate row ? */
-  {
+  {                                    /* correct the full sample; not just */
+    mng_uint16p pTab;                  /* the high-order byte */
+    mng_uint32  iW;
 
-  
-     /* TODO: 16-bit precision gamma processing */
-     /* we'll just do the high-order byte for now */
+    if (!pData->pGammatab16)           /* first 16-bit row with this gamma ? */
+    {
+      mng_retcode iRetcode = build_gammatab16 (pData);
 
-     
-                                       /* convert all samples in the row */
-     for (iX = 0; iX < pData->iRowsamples; iX++)
-     {                                 /* using the precalculated gamma lookup table */
-       *pWork     = pData->aGammatab [*pWork];
-       *(pWork+2) = pData->aGammatab [*(pWork+2)];
-       *(pWork+4) = pData->aGammatab [*(pWork+4)];
+      if (iRetcode)
+        return iRetcode;
+    }
 
-       pWork += 8;
-     }
+    pTab = pData->pGammatab16;
+
+    if (pData->bIsGray)                /* gray+alpha intermediate row ? */
+    {
+      for (iX = 0; iX < pData->iRowsamples; iX++)
+      {
+        iW         = pTab [((mng_uint32)*pWork << 8) | *(pWork+1)];
+        *pWork     = (mng_uint8)(iW >> 8);
+        *(pWork+1) = (mng_uint8)(iW & 0xFF);
+
+        pWork += 4;
+      }
+    }
+    else
+    {                                  /* convert all samples in the row */
+      for (iX = 0; iX < pData->iRowsamples; iX++)
+      {
+        iW         = pTab [((mng_uint32)*pWork << 8) | *(pWork+1)];
+        *pWork     = (mng_uint8)(iW >> 8);
+        *(pWork+1) = (mng_uint8)(iW & 0xFF);
+        iW         = pTab [((mng_uint32)*(pWork+2) << 8) | *(pWork+3)];
+        *(pWork+2) = (mng_uint8)(iW >> 8);
+        *(pWork+3) = (mng_uint8)(iW & 0xFF);
+        iW         = pTab [((mng_uint32)*(pWork+4) << 8) | *(pWork+5)];
+        *(pWork+4) = (mng_uint8)(iW >> 8);
+        *(pWork+5) = (mng_uint8)(iW & 0xFF);
+
+        pWork += 8;
+      }
+    }
+  }
+  else
+#endif /* MNG_NO_16BIT_SUPPORT */
+  if (pData->bIsGray)                  /* gray+alpha intermediate row ? */
+  {
+    for (iX = 0; iX < pData->iRowsamples; iX++)
+    {
+      *pWork = pData->aGammatab [*pWork];
+      pWork += 2;
+    }
   }
   else
   {                                    /* convert all samples in the row */
@@ -554,6 +849,32 @@ mng_retcode mng_correct_gamma_only (mng_datap pData)
 
   return MNG_NOERROR;
 }
+
+/* ************************************************************************** */
+
+mng_retcode mng_clear_gammacache (mng_datap pData)
+{
+  mng_uint32 iSlot;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_CLEAR_GAMMACACHE, MNG_LC_START);
+#endif
+                                       /* the 8-bit tables stay valid; */
+  for (iSlot = 0; iSlot < MNG_GAMMACACHESIZE; iSlot++)
+  {                                    /* the 16-bit ones are too big to keep */
+    if (pData->aGammacache [iSlot].pTab16)
+      MNG_FREE (pData, pData->aGammacache [iSlot].pTab16,
+                65536 * sizeof (mng_uint16));
+  }
+
+  pData->pGammatab16 = MNG_NULL;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_CLEAR_GAMMACACHE, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
 #endif /* MNG_GAMMA_ONLY || MNG_FULL_CMS || MNG_APP_CMS */
 
 /* ************************************************************************** */
@@ -34,6 +34,10 @@
 /* *             1.0.6 - 04/11/2003 - G.Juyn                                * */
 /* *             - B719420 - fixed several MNG_APP_CMS problems             * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added mng_clear_gammacache                               * */
+/* *             - added mng_drop_cmscache                                  * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -55,6 +59,7 @@ void        mnglcms_freeprofile       (mng_cmsprof  hProf    );
 void        mnglcms_freetransform     (mng_cmstrans hTrans   );
 
 mng_retcode mng_clear_cms             (mng_datap    pData    );
+mng_retcode mng_drop_cmscache         (mng_datap    pData    );
 #endif
 
 /* ************************************************************************** */
@@ -73,6 +78,7 @@ mng_retcode mng_init_gamma_only        (mng_datap pData,
                                         mng_bool  bObject,
                                         mng_bool  bRetrobj);
 mng_retcode mng_correct_gamma_only     (mng_datap pData);
+mng_retcode mng_clear_gammacache       (mng_datap pData);
 #endif
 
 #ifdef MNG_APP_CMS
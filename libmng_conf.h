@@ -50,6 +50,13 @@
 /* *             - clearified MNG_BIGENDIAN_SUPPORTED conditional           * */
 /* *             - added MNG_LITTLEENDIAN_SUPPORTED conditional             * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added MNG_SUPPORT_SIMD conditional                       * */
+/* *             - added MNG_NO_KEYFRAMES conditional                       * */
+/* *             - added MNG_NO_MEMPOOL conditional                         * */
+/* *             - added MNG_NO_FUSEDROW conditional                        * */
+/* *             - added MNG_SUPPORT_PARALLEL conditional                   * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 
@@ -228,6 +235,65 @@
 /* #define MNG_BIGENDIAN_SUPPORTED */
 /* #define MNG_LITTLEENDIAN_SUPPORTED */
 
+/* ************************************************************************** */
+
+/* enable SIMD-optimized pixel processing */
+/* use this to let the library pick vectorized (SSE2/AVX2 or NEON) versions
+   of the most time-consuming pixel-loops; the actual routines are selected
+   at runtime depending on the features of the CPU, and the portable routines
+   are always kept as fallback */
+/* NOTE that this requires gcc (or a compatible compiler such as clang) */
+
+#if !defined(MNG_SUPPORT_SIMD) && !defined(MNG_NO_SUPPORT_SIMD)
+#if defined(MNG_BUILD_SO) || defined(MNG_USE_SO) || defined(MNG_BUILD_DLL) || defined(MNG_USE_DLL)
+#if defined(__GNUC__) && \
+    (defined(__i386__) || defined(__x86_64__) || defined(__aarch64__))
+#define MNG_SUPPORT_SIMD
+#endif
+#endif
+#endif
+
+/* ************************************************************************** */
+
+/* enable parallel decoding of embedded images */
+/* with this the app may ask for a number of worker-threads (see
+   mng_set_decodethreads), which then inflate & unfilter the independent
+   IHDR-images of an MNG given to mng_read_memory ahead of the reader;
+   storing the rows and all display-processing stays on the calling thread */
+/* NOTE that this requires POSIX threads; link with -lpthread, and define it
+   for the app as well (it adds mng_set/get_decodethreads to the API) */
+
+/* #define MNG_SUPPORT_PARALLEL */
+
+/* ************************************************************************** */
+
+/* disable the keyframe cache for mng_display_goframe/golayer/gotime */
+/* the cache keeps snapshots of the playback state at regular frame-intervals
+   so seeking doesn't have to replay the animation from the start; it is off
+   until the app calls mng_set_keyframecache(), but you can leave the code out
+   completely with this one */
+
+/* #define MNG_NO_KEYFRAMES */
+
+/* ************************************************************************** */
+
+/* disable the memory-pool for chunk-structures and animation-objects */
+/* with the pool on (mng_set_mempool) these small structures are carved from
+   larger blocks obtained through the memalloc callback, and all of it is
+   given back at once by mng_reset/mng_cleanup; it is off by default */
+
+/* #define MNG_NO_MEMPOOL */
+
+/* ************************************************************************** */
+
+/* disable the fused display routines */
+/* with SIMD support stored 8-bit objects (RGB, RGBA & indexed) are displayed
+   onto the RGBA-family canvas-styles in a single pass that retrieves,
+   gamma-corrects and composes a strip of pixels at a time; define this to
+   always use the separate retrieve, correct & display steps */
+
+/* #define MNG_NO_FUSEDROW */
+
 /* ************************************************************************** */
 /* enable 'version' functions */
 #if !defined(MNG_VERSION_QUERY_SUPPORT) && \
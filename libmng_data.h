@@ -155,6 +155,26 @@
 /* *                                                                        * */
 /* *             1.0.11 - 07/24/2007 - G.R-P bugfix for all-zero delays     * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added SIMD capability fields                             * */
+/* *             - added keyframe cache structure & fields                  * */
+/* *             - added filter-selection & deflaterows buffer fields       * */
+/* *             - added multi-row inflate buffer fields                    * */
+/* *             - added the image-object id-index                          * */
+/* *             - added dirty-rectangle list                               * */
+/* *             - added memory-pool fields                                 * */
+/* *             - removed the per-handle CRC table                         * */
+/* *             - added running total of pushed data                       * */
+/* *             - added fields for mng_read_memory                         * */
+/* *             - added bIsGray for the gray+alpha row                     * */
+/* *             - added fFusedrow                                          * */
+/* *             - added gamma-table cache & 16-bit gamma-table             * */
+/* *             - added transform cache for full cms                       * */
+/* *             - added the decode-job pool for parallel decoding          * */
+/* *             - added virtual clock and render-canvas fields             * */
+/* *             - added mng_putframe frame-sequence encoder                * */
+/* *             - added magnify-on-display fields                          * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -248,6 +268,196 @@ typedef struct mng_savedata_struct {
 
 typedef mng_savedata * mng_savedatap;
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * The keyframe structure                                                 * */
+/* *                                                                        * */
+/* * This contains a snapshot of the playback state taken in between two   * */
+/* * animation objects. The display_goxxxx functions restore the nearest    * */
+/* * one instead of replaying the animation from the first frame.           * */
+/* * Pointers to image objects are stored as an index into the copied list: * */
+/* * 0 = none, 1 = object 0, 2 = first object in the list, and so on.       * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_KEYFRAMES
+typedef struct mng_keyframe_struct {
+           struct mng_keyframe_struct * pNext;   /* single-linked list; ordered */
+           mng_uint32        iMemsize;           /* total memory held */
+
+           mng_uint32        iCanvasstyle;       /* the canvas it was taken from */
+           mng_uint32        iWidth;
+           mng_uint32        iHeight;
+           mng_uint32        iCanvasrowsize;     /* copy of the canvas */
+           mng_uint8p        pCanvas;
+           mng_uint8p        pAlpha;             /* and separate alpha-plane */
+
+           mng_objectp       pObjzero;           /* copy of the image objects */
+           mng_objectp       pFirstimgobj;
+           mng_uint32        iCurrentobj;        /* indexes of object pointers */
+           mng_uint32        iLastclone;
+           mng_uint32        iDeltaImage;
+
+           mng_uint32        iLoopcount;         /* running counts of LOOPs */
+           mng_uint32p       pLoopcounts;
+
+           mng_savedata      sGlobals;           /* global chunk data */
+           mng_savedatap     pSavedata;          /* copy of SAVE data */
+
+           mng_objectp       pCurraniobj;        /* playback state */
+           mng_objectp       pLastseek;
+           mng_bool          bFramedone;
+           mng_uint32        iFrameseq;
+           mng_uint32        iLayerseq;
+           mng_uint32        iFrametime;
+           mng_bool          bSkipping;
+           mng_bool          bRestorebkgd;
+           mng_bool          bNeedrefresh;
+           mng_bool          bMisplacedTERM;
+           mng_bool          bOnlyfirstframe;
+           mng_uint32        iFramesafterTERM;
+           mng_uint32        iIterations;
+           mng_uint32        iUpdateleft;
+           mng_uint32        iUpdateright;
+           mng_uint32        iUpdatetop;
+           mng_uint32        iUpdatebottom;
+           mng_uint32        iPLTEcount;
+
+           mng_uint16        iDEFIobjectid;      /* DEFI fields */
+           mng_bool          bDEFIhasdonotshow;
+           mng_uint8         iDEFIdonotshow;
+           mng_bool          bDEFIhasconcrete;
+           mng_uint8         iDEFIconcrete;
+           mng_bool          bDEFIhasloca;
+           mng_int32         iDEFIlocax;
+           mng_int32         iDEFIlocay;
+           mng_bool          bDEFIhasclip;
+           mng_int32         iDEFIclipl;
+           mng_int32         iDEFIclipr;
+           mng_int32         iDEFIclipt;
+           mng_int32         iDEFIclipb;
+
+#ifndef MNG_SKIPCHUNK_FRAM
+           mng_uint8         iFramemode;         /* current subframe variables */
+           mng_uint32        iFramedelay;
+           mng_uint32        iFrametimeout;
+           mng_bool          bFrameclipping;
+           mng_int32         iFrameclipl;
+           mng_int32         iFrameclipr;
+           mng_int32         iFrameclipt;
+           mng_int32         iFrameclipb;
+           mng_uint32        iNextdelay;
+           mng_bool          bForcedelay;
+           mng_uint32        iAccumdelay;
+#endif
+
+#ifndef MNG_SKIPCHUNK_SHOW
+           mng_uint8         iSHOWmode;          /* SHOW fields */
+           mng_uint16        iSHOWfromid;
+           mng_uint16        iSHOWtoid;
+           mng_uint16        iSHOWnextid;
+           mng_int16         iSHOWskip;
+#endif
+
+           mng_uint8         iDeltaImagetype;    /* delta-image fields */
+           mng_uint8         iDeltatype;
+           mng_uint32        iDeltaBlockwidth;
+           mng_uint32        iDeltaBlockheight;
+           mng_uint32        iDeltaBlockx;
+           mng_uint32        iDeltaBlocky;
+           mng_bool          bDeltaimmediate;
+
+#ifndef MNG_SKIPCHUNK_MAGN
+           mng_uint16        iMAGNfromid;
+           mng_uint16        iMAGNcurrentid;
+           mng_uint16        iMAGNtoid;
+#endif
+
+#ifndef MNG_SKIPCHUNK_PAST
+           mng_uint16        iPASTid;
+           mng_int32         iPastx;
+           mng_int32         iPasty;
+#endif
+
+        } mng_keyframe;
+
+typedef mng_keyframe * mng_keyframep;
+#endif /* MNG_SUPPORT_KEYFRAMES */
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Dirty-rectangle list; collects the canvas areas changed since the last * */
+/* * refresh, one rectangle per image-placement, merged where they overlap  * */
+/* * or lie close together                                                  * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_DISPLAY
+typedef struct {
+           mng_int32         iLeft;              /* right & bottom are exclusive */
+           mng_int32         iTop;
+           mng_int32         iRight;
+           mng_int32         iBottom;
+        } mng_dirtyrect;
+
+typedef struct {
+           mng_uint32        iCount;             /* number of closed rectangles */
+           mng_dirtyrect     aRects [MNG_DIRTYRECTS];
+           mng_bool          bOpen;              /* placement in progress ? */
+           mng_dirtyrect     sOpen;              /* rows written for it so far */
+           mng_dirtyrect     sPlacement;         /* destination of that placement */
+        } mng_dirtylist;
+#endif
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Gamma-table cache; animations often alternate between a few gamma      * */
+/* * values, so the tables are kept instead of being recalculated           * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#if defined(MNG_GAMMA_ONLY) || defined(MNG_FULL_CMS) || defined(MNG_APP_CMS)
+typedef struct {
+           mng_float         dGamma;             /* exponent; 0 = unused entry */
+           mng_uint8         aTab8 [256];        /* 8-bit lookup table */
+           mng_uint16p       pTab16;             /* 16-bit table; built on first use */
+        } mng_gammaentry;
+typedef mng_gammaentry * mng_gammaentryp;
+#endif
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Transform cache for full color-management; embedded images usually     * */
+/* * repeat the same color-chunks, so their transforms are reused           * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifdef MNG_FULL_CMS
+typedef struct {                                 /* hashed & compared as a whole */
+           mng_float         dGamma;             /* exponent for cHRM+gAMA */
+           mng_float         aChroma [8];        /* whitepoint & primaries (cHRM) */
+           mng_uint32        iSource;            /* MNG_CMSSOURCE_xxx */
+           mng_uint32        iRGBA16;            /* 16-bit intermediates ? */
+           mng_uint32        iIntent;
+           mng_uint32        iProfilesize;       /* iCCP profile */
+           mng_uint32        iProfilecrc;
+        } mng_cmskey;
+
+typedef struct {
+           mng_uint32        iHash;              /* crc of the key */
+           mng_cmskey        sKey;
+           mng_uint8p        pProfile;           /* copy of the iCCP profile */
+           mng_cmsprof       hProf;              /* input profile (if created) */
+           mng_cmstrans      hTrans;             /* 0 = unused entry */
+           mng_uint32        iLastused;
+        } mng_cmsentry;
+typedef mng_cmsentry * mng_cmsentryp;
+
+#define MNG_CMSSOURCE_ICCP 1
+#define MNG_CMSSOURCE_SRGB 2
+#define MNG_CMSSOURCE_CHRM 3
+#endif
+
 /* ************************************************************************** */
 /* *                                                                        * */
 /* * Internal buffer structure for data push mechanisms                     * */
@@ -264,6 +474,73 @@ typedef struct {
         } mng_pushdata;
 typedef mng_pushdata * mng_pushdatap;
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Chunk index for reading from memory (mng_read_memory)                  * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+typedef struct {
+           mng_uint32        iOffset;            /* position of the length-field */
+           mng_uint32        iLength;            /* length of the chunk-data */
+        } mng_memchunk;
+typedef mng_memchunk * mng_memchunkp;
+
+#ifdef MNG_SUPPORT_PARALLEL
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Decode-workers for the images found by mng_read_memory                 * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#define MNG_JOB_IDLE     0                   /* no row-buffer yet */
+#define MNG_JOB_READY    1                   /* waiting for a worker */
+#define MNG_JOB_RUNNING  2
+#define MNG_JOB_DONE     3                   /* rows inflated & unfiltered */
+#define MNG_JOB_FAILED   4                   /* left to the reader */
+
+typedef struct {                             /* one IHDR-image */
+           mng_uint32        iFirstchunk;        /* index-entry of the IHDR */
+           mng_uint32        iLastchunk;         /* index-entry of the IEND */
+           mng_uint32        iHeight;
+           mng_uint32        iRowbytes;          /* including the filter-byte */
+           mng_int32         iFilterbpp;
+           mng_uint8         iState;
+           mng_uint8p        pRows;              /* a zeroed predictor-row and
+                                                    then the image-rows */
+           mng_uint32        iRowssize;
+        } mng_decodejob;
+typedef mng_decodejob * mng_decodejobp;
+
+typedef struct {                             /* one worker-thread */
+           pthread_t         hThread;
+           mng_ptr           pPool;
+           mng_uint8p        pArena;             /* memory for its zlib-stream */
+           mng_uint32        iArenaused;
+        } mng_decodeworker;
+typedef mng_decodeworker * mng_decodeworkerp;
+
+typedef struct {
+           pthread_mutex_t   hMutex;             /* guards states & counters */
+           pthread_cond_t    hWork;              /* a job got ready, or stop */
+           pthread_cond_t    hDone;              /* a job has finished */
+           mng_bool          bStop;
+           mng_uint8p        pMemdata;           /* what's being read */
+           mng_memchunkp     pMemindex;
+           mng_uint32        iSIMDflags;
+           mng_decodejobp    pJobs;
+           mng_uint32        iJobcount;
+           mng_uint32        iJobnext;           /* next one for a worker */
+           mng_uint32        iJobready;          /* those below have a buffer */
+           mng_uint32        iJobcurrent;        /* first one not yet passed
+                                                    by the reader */
+           mng_decodeworkerp pWorkers;
+           mng_uint32        iWorkers;
+           mng_decodeworker  sReader;            /* when it does a job itself */
+        } mng_decodepool;
+typedef mng_decodepool * mng_decodepoolp;
+#endif /* MNG_SUPPORT_PARALLEL */
+
 /* ************************************************************************** */
 /* *                                                                        * */
 /* * The main libmng data structure                                         * */
@@ -313,6 +590,12 @@ typedef struct mng_data_struct {
            mng_cmsprof       hProf2;             /* default output profile */
            mng_cmsprof       hProf3;             /* default sRGB profile */
            mng_cmstrans      hTrans;             /* current transformation handle */
+           mng_bool          bTranscached;       /* hTrans is owned by the cache ? */
+           mng_uint32        iCmscachesize;      /* max number of cached transforms */
+           mng_uint32        iCmscacheclock;     /* for least-recently-used */
+           mng_uint32        iCmscachehits;
+           mng_uint32        iCmscachemisses;
+           mng_cmsentry      aCmscache [MNG_CMSCACHESIZE];
 #endif
 
            mng_float         dViewgamma;         /* gamma calculation variables */
@@ -323,7 +606,24 @@ typedef struct mng_data_struct {
            mng_bool          bSectionbreaks;     /* indicate NEEDSECTIONWAIT breaks */
            mng_bool          bCacheplayback;     /* switch to cache playback info */
            mng_bool          bDoProgressive;     /* progressive refresh for large images */
+#ifndef MNG_SKIPCHUNK_MAGN
+           mng_bool          bLazymagnify;       /* magnify while displaying instead of
+                                                    growing the object */
+#endif
            mng_uint32        iCrcmode;           /* CRC existence & checking flags */
+#ifdef MNG_SUPPORT_SIMD
+           mng_uint32        iSIMDcaps;          /* vector units detected on the CPU */
+           mng_uint32        iSIMDflags;         /* vector units the library may use */
+#endif
+#ifdef MNG_SUPPORT_MEMPOOL
+           mng_bool          bMempool;           /* switch for the memory-pool */
+           mng_ptr           pPoolslabs;         /* blocks the pool carves from */
+           mng_uint8p        pPoolnext;          /* unused part of the newest one */
+           mng_uint32        iPoolleft;
+           mng_ptr           aPoolfree [MNG_POOLCLASSES]; /* free-list per size-class */
+           mng_uint32        iPoolcurrent;       /* bytes handed out by the pool */
+           mng_uint32        iPoolpeak;          /* and the most it ever was */
+#endif
 
            mng_speedtype     iSpeed;             /* speed-modifier for animations */
 
@@ -464,6 +764,20 @@ typedef struct mng_data_struct {
            mng_pushdatap     pLastpushchunk;
            mng_pushdatap     pFirstpushdata;
            mng_pushdatap     pLastpushdata;
+           mng_uint32        iPushsize;          /* bytes remaining in pushed data */
+
+           mng_uint8p        pMemdata;           /* variables for mng_read_memory */
+           mng_uint32        iMemdatasize;
+           mng_memchunkp     pMemindex;          /* the chunks found in it */
+           mng_uint32        iMemindexsize;      /* nr. of entries allocated */
+           mng_uint32        iMemchunks;         /* nr. of entries used */
+           mng_uint32        iMemchunknext;      /* next one to be processed */
+           mng_uint32        iMemdataend;        /* where the last chunk ended */
+#ifdef MNG_SUPPORT_PARALLEL
+           mng_uint32        iDecodethreads;     /* nr. of decode-workers wanted */
+           mng_decodepoolp   pDecodepool;        /* the running ones */
+           mng_decodejobp    pDecodejob;         /* current image came from here */
+#endif
 #endif /* MNG_SUPPORT_READ */
 
 #ifdef MNG_SUPPORT_WRITE
@@ -472,6 +786,22 @@ typedef struct mng_data_struct {
            mng_chunkid       iFirstchunkadded;
            mng_uint32        iWritebufsize;
            mng_uint8p        pWritebuf;
+#ifdef MNG_SUPPORT_ENCODER
+           mng_uint8p        pEncframe;          /* mng_putframe: previous frame */
+           mng_uint8p        pEncnext;           /* and the one coming in */
+           mng_uint32        iEncframesize;
+           mng_uint32        iEncframes;         /* frames put so far */
+           mng_uint32        iEncdelay;          /* default interframe delay */
+           mng_bool          bEncdefault;        /* and is it in effect ? */
+           mng_chunkp        pEncfram;           /* FRAM of the last frame */
+           mng_uint8         iEncmode;           /* framing-mode in effect */
+           mng_uint8         iEnccolortype;      /* colortype of object 1 */
+           mng_bool          bEncclipped;        /* object 1 clipped ? */
+           mng_int32         iEncclipl;
+           mng_int32         iEncclipr;
+           mng_int32         iEncclipt;
+           mng_int32         iEncclipb;
+#endif
 #endif
 
 #ifdef MNG_SUPPORT_DISPLAY
@@ -507,6 +837,9 @@ typedef struct mng_data_struct {
            mng_uint32        iSynctime;          /* tickcount at last framesync */
            mng_uint32        iStarttime;         /* tickcount at start */
            mng_uint32        iEndtime;           /* tickcount at end */
+           mng_bool          bVirtualclock;      /* library keeps its own time */
+           mng_uint32        iVirtualtime;       /* tickcount of the virtual clock */
+           mng_uint32        iTimerdelay;        /* interval of the last timer */
            mng_bool          bRunning;           /* animation is active */
            mng_bool          bTimerset;          /* the timer has been set;
                                                     we're expecting a call to
@@ -536,6 +869,13 @@ typedef struct mng_data_struct {
            mng_uint32        iUpdateright;
            mng_uint32        iUpdatetop;
            mng_uint32        iUpdatebottom;
+           mng_dirtylist     sDirty;             /* dirty-rectangles for refresh */
+           mng_dirtylist     sDirtydone;         /* those of the last refresh */
+           mng_dirtyrect     sRefreshdone;       /* update region of the last refresh */
+
+           mng_uint8p        pRendercanvas;      /* canvas for mng_render_frames */
+           mng_uint32        iRendercanvassize;
+           mng_uint32        iRenderrowsize;
 
            mng_int8          iPass;              /* current interlacing pass;
                                                     negative value means no interlace */
@@ -559,6 +899,7 @@ typedef struct mng_data_struct {
            mng_uint8p        pPrevrow;           /* previous row of pixel-data */
            mng_uint8p        pRGBArow;           /* intermediate row of RGBA8 or RGBA16 data */
            mng_bool          bIsRGBA16;          /* indicates intermediate row is RGBA16 */
+           mng_bool          bIsGray;            /* indicates it's gray+alpha instead */
            mng_bool          bIsOpaque;          /* indicates intermediate row is fully opaque */
            mng_int32         iFilterbpp;         /* bpp index for filtering routines */
 
@@ -571,8 +912,24 @@ typedef struct mng_data_struct {
            mng_int32         iDestt;
            mng_int32         iDestb;
 
+#ifndef MNG_SKIPCHUNK_MAGN
+           mng_objectp       pMagnobj;           /* object magnified while displaying */
+           mng_fptr          fMagnretrieve;      /* its own retrieve-row routine */
+           mng_fptr          fMagnifyX;          /* RGBA8 magnification routines */
+           mng_fptr          fMagnifyY;
+           mng_uint8p        pMagnrow1;          /* retrieved source rows */
+           mng_uint8p        pMagnrow2;
+           mng_uint8p        pMagntemp;          /* Y-magnified source row */
+           mng_int32         iMagnrow1;          /* source rows held in there */
+           mng_int32         iMagnrow2;
+           mng_int32         iMagnlast;          /* source row & interval position */
+           mng_int32         iMagnlastS;         /* last produced in pRGBArow */
+           mng_uint32        iMagnrowsize;       /* size of the source row-buffers */
+#endif
+
            mng_objectp       pFirstimgobj;       /* double-linked list of */
            mng_objectp       pLastimgobj;        /* image-object structures */
+           mng_objectp       aObjindex [MNG_OBJINDEXSIZE]; /* and hashed by id */
            mng_objectp       pFirstaniobj;       /* double-linked list of */
            mng_objectp       pLastaniobj;        /* animation-object structures */
 #ifdef MNG_SUPPORT_DYNAMICMNG
@@ -583,11 +940,18 @@ typedef struct mng_data_struct {
 #if defined(MNG_GAMMA_ONLY) || defined(MNG_FULL_CMS) || defined(MNG_APP_CMS)
            mng_uint8         aGammatab[256];     /* precomputed gamma lookup table */
            mng_float         dLastgamma;         /* last gamma used to compute table */
+           mng_uint16p       pGammatab16;        /* 16-bit table for dLastgamma */
+           mng_uint32        iGammaslot;         /* cache-entry holding dLastgamma */
+           mng_uint32        iGammanext;         /* next cache-entry to be replaced */
+           mng_gammaentry    aGammacache [MNG_GAMMACACHESIZE];
 #endif
 
            mng_fptr          fDisplayrow;        /* internal callback to display an
                                                     uncompressed/unfiltered/
                                                     color-corrected row */
+           mng_fptr          fFusedrow;          /* internal callback to retrieve,
+                                                    color-correct and display all
+                                                    rows of a stored object at once */
            mng_fptr          fRestbkgdrow;       /* internal callback for restore-
                                                     background processing of a row */
            mng_fptr          fCorrectrow;        /* internal callback to color-correct an
@@ -745,6 +1109,16 @@ typedef struct mng_data_struct {
 
            mng_objectp       pLastseek;          /* last processed ani_seek object */
 
+#ifdef MNG_SUPPORT_KEYFRAMES
+           mng_uint32        iKeyframeinterval;  /* frames between snapshots; 0 = off */
+           mng_uint32        iKeyframemaxmem;    /* memory limit; 0 = none */
+           mng_uint32        iKeyframememory;    /* memory held by the snapshots */
+           mng_uint32        iKeyframecount;     /* number of snapshots */
+           mng_uint32        iKeyframenext;      /* frame for the next snapshot */
+           mng_keyframep     pFirstkeyframe;     /* list of snapshots */
+           mng_bool          bKeyframeseek;      /* resumed from a snapshot */
+#endif
+
 #ifdef MNG_INCLUDE_MPNG_PROPOSAL
            mng_objectp       pMPNG;              /* mpNG object if available */
 #endif
@@ -764,9 +1138,15 @@ typedef struct mng_data_struct {
            mng_int32         iZstrategy;
 
            mng_uint32        iMaxIDAT;           /* maximum size of IDAT data */
+           mng_uint8         iFiltersel;         /* filter-selection for putimgdata */
 
            mng_bool          bInflating;         /* indicates "inflate" in progress */
            mng_bool          bDeflating;         /* indicates "deflate" in progress */
+
+           mng_uint8p        pZoutbuf;           /* IDAT buffer for deflaterows */
+           mng_uint32        iZoutsize;
+           mng_uint8p        pZrowbuf;           /* multi-row buffer for inflaterows */
+           mng_uint32        iZrowbufsize;
 #endif /* MNG_INCLUDE_ZLIB */
 
 #ifdef MNG_INCLUDE_JNG
@@ -839,11 +1219,6 @@ typedef struct mng_data_struct {
 
 #endif /* MNG_INCLUDE_JNG */
 
-#ifndef MNG_USE_ZLIB_CRC
-           mng_uint32        aCRCtable [256];    /* CRC prefab table */
-           mng_bool          bCRCcomputed;       /* "has been built" indicator */
-#endif
-
 #ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
            png_imgtype       ePng_imgtype;
 #endif
@@ -959,6 +1334,7 @@ typedef mng_data * mng_datap;
 /* ************************************************************************** */
 
 typedef mng_retcode(*mng_displayrow)  (mng_datap  pData);
+typedef mng_retcode(*mng_fusedrow)    (mng_datap  pData);
 typedef mng_retcode(*mng_restbkgdrow) (mng_datap  pData);
 typedef mng_retcode(*mng_correctrow)  (mng_datap  pData);
 typedef mng_retcode(*mng_retrieverow) (mng_datap  pData);
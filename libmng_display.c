@@ -238,6 +238,38 @@
 /* *             1.0.11 - 07/24/2007 - G.R-P bugfix for all-zero delays     * */
 /* *             1.0.11 - 03/29/2008 - G.R-P.                               * */
 /* *             - fixed some possible use of uninitialized variables       * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - select SIMD display routines when available              * */
+/* *             - added keyframe cache for the display_goxxxx functions    * */
+/* *             - added direct image-data extraction for getimgdata        * */
+/* *             - fixed dangling row-buffers after PAST processing         * */
+/* *             - keep the image-object id-index in sync at TERM and       * */
+/* *               keyframe restore                                         * */
+/* *             - added dirty-rectangle list, published at each refresh    * */
+/* *             - enabled the 16-bit canvas styles                         * */
+/* *             - 16-bit background canvas keeps full precision            * */
+/* *             - added gray canvas styles                                 * */
+/* *             - use the fused routines for stored 8-bit objects          * */
+/* *             - IDAT data is taken from a decode-job when the workers    * */
+/* *               are running                                              * */
+/* *             - timer-breaks advance the virtual clock instead of        * */
+/* *               calling settimer when it is on                           * */
+/* *             - MAGN'ed objects can be magnified while displaying        * */
+/* *             - PAST sources are pasted band by band; RGBA sources that  * */
+/* *               need no conversion are pasted from their own buffer      * */
+/* *             - PAST clips to the target and wraps tiled rows correctly  * */
+/* *             - full-width delta-images are applied as a single block    * */
+/* *             - keyframe restore copies the objects, SAVE data & profile * */
+/* *               before it replaces anything                              * */
+/* *             - getimgdata allocates before it borrows the display state * */
+/* *             - whole-block delta only when the delta is non-empty and   * */
+/* *               both buffers exist                                       * */
+/* *             - no lazy magnify when MAGN method-Y 1 has ML != MB        * */
+/* *             - lazy magnify for any ML/MB again                         * */
+/* *             - a keyframe copy that runs out of memory is dropped whole * */
+/* *             - errors of next_layer and of displaying in SHOW & CLON    * */
+/* *               are passed on                                            * */
+/* *             - PAST drops the first work-buffer if the second fails     * */
 /* *                                                                        * */
 /* ************************************************************************** */
 
@@ -275,8 +307,15 @@ MNG_LOCAL mng_retcode set_delay (mng_datap  pData,
     iInterval = 1;
 
   if (pData->bRunning)                 /* only when really displaying */
+  {
+    if (pData->bVirtualclock)          /* no need to wait for virtual time */
+      pData->iVirtualtime += iInterval;
+    else
     if (!pData->fSettimer ((mng_handle)pData, iInterval))
       MNG_ERROR (pData, MNG_APPTIMERERROR);
+  }
+
+  pData->iTimerdelay = iInterval;      /* remember for mng_render_frames */
 
 #ifdef MNG_SUPPORT_DYNAMICMNG
   if ((!pData->bDynamic) || (pData->bRunning))
@@ -329,6 +368,166 @@ MNG_LOCAL mng_uint32 calculate_delay (mng_datap  pData,
   return iWaitfor;
 }
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Dirty-rectangle routines - check_update_region opens a rectangle for   * */
+/* * every new image-placement and grows it with each row written; when     * */
+/* * closed it is merged with any rectangle it overlaps or nearly touches,  * */
+/* * so the host gets a short list it can refresh piecemeal                 * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+MNG_LOCAL mng_uint32 dirtyrect_area (mng_dirtyrect *pRect)
+{
+  return (mng_uint32)(pRect->iRight  - pRect->iLeft) *
+         (mng_uint32)(pRect->iBottom - pRect->iTop );
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void dirtyrect_union (mng_dirtyrect *pRect,
+                                mng_dirtyrect *pOther)
+{
+  pRect->iLeft   = MIN_COORD (pRect->iLeft,   pOther->iLeft  );
+  pRect->iTop    = MIN_COORD (pRect->iTop,    pOther->iTop   );
+  pRect->iRight  = MAX_COORD (pRect->iRight,  pOther->iRight );
+  pRect->iBottom = MAX_COORD (pRect->iBottom, pOther->iBottom);
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool dirtyrect_mergeable (mng_dirtyrect *pRect,
+                                        mng_dirtyrect *pOther)
+{
+  mng_dirtyrect sUnion   = *pRect;
+  mng_uint32    iCovered = dirtyrect_area (pRect) + dirtyrect_area (pOther);
+  mng_uint32    iUnion;
+  mng_int32     iL       = MAX_COORD (pRect->iLeft,   pOther->iLeft  );
+  mng_int32     iT       = MAX_COORD (pRect->iTop,    pOther->iTop   );
+  mng_int32     iR       = MIN_COORD (pRect->iRight,  pOther->iRight );
+  mng_int32     iB       = MIN_COORD (pRect->iBottom, pOther->iBottom);
+
+  if ((iL < iR) && (iT < iB))          /* don't count the overlap twice */
+    iCovered -= (mng_uint32)(iR - iL) * (mng_uint32)(iB - iT);
+
+  dirtyrect_union (&sUnion, pOther);
+  iUnion = dirtyrect_area (&sUnion);
+                                       /* merge if no more than a quarter of
+                                          the union would be refreshed for nothing */
+  return (mng_bool)(iUnion - iCovered <= (iUnion >> 2));
+}
+
+/* ************************************************************************** */
+
+void mng_close_dirtyrect (mng_datap pData)
+{
+  mng_dirtylist *pList = &pData->sDirty;
+  mng_dirtyrect sRect;
+  mng_dirtyrect sUnion;
+  mng_uint32    iX;
+  mng_uint32    iBest;
+  mng_uint32    iGrowth;
+  mng_uint32    iLeast;
+  mng_bool      bMerged;
+
+  if (!pList->bOpen)                   /* nothing in progress ? */
+    return;
+
+  sRect        = pList->sOpen;
+  pList->bOpen = MNG_FALSE;
+
+  do                                   /* absorb whatever it can be merged with */
+  {
+    bMerged = MNG_FALSE;
+
+    for (iX = 0; (iX < pList->iCount) && (!bMerged); iX++)
+    {
+      if (dirtyrect_mergeable (&sRect, &pList->aRects [iX]))
+      {
+        dirtyrect_union (&sRect, &pList->aRects [iX]);
+                                       /* fill the gap with the last one */
+        pList->aRects [iX] = pList->aRects [--pList->iCount];
+        bMerged = MNG_TRUE;
+      }
+    }
+  }
+  while (bMerged);
+
+  if (pList->iCount >= MNG_DIRTYRECTS) /* no room ? then merge with the one */
+  {                                    /* that grows the least */
+    iBest  = 0;
+    iLeast = 0xFFFFFFFFL;
+
+    for (iX = 0; iX < pList->iCount; iX++)
+    {
+      sUnion = pList->aRects [iX];
+      dirtyrect_union (&sUnion, &sRect);
+      iGrowth = dirtyrect_area (&sUnion) - dirtyrect_area (&pList->aRects [iX]);
+
+      if (iGrowth < iLeast)
+      {
+        iBest  = iX;
+        iLeast = iGrowth;
+      }
+    }
+
+    dirtyrect_union (&sRect, &pList->aRects [iBest]);
+    pList->aRects [iBest] = pList->aRects [--pList->iCount];
+  }
+
+  pList->aRects [pList->iCount++] = sRect;
+
+  return;
+}
+
+/* ************************************************************************** */
+
+void mng_open_dirtyrect (mng_datap pData,
+                         mng_int32 iRow)
+{
+  mng_dirtylist *pList = &pData->sDirty;
+
+  mng_close_dirtyrect (pData);         /* finish the previous placement */
+
+  pList->bOpen               = MNG_TRUE;
+  pList->sPlacement.iLeft    = pData->iDestl;
+  pList->sPlacement.iTop     = pData->iDestt;
+  pList->sPlacement.iRight   = pData->iDestr;
+  pList->sPlacement.iBottom  = pData->iDestb;
+  pList->sOpen.iLeft         = pData->iDestl;
+  pList->sOpen.iTop          = iRow;
+  pList->sOpen.iRight        = pData->iDestr;
+  pList->sOpen.iBottom       = iRow + 1;
+
+  return;
+}
+
+/* ************************************************************************** */
+
+void mng_reset_dirtyrects (mng_datap pData)
+{
+  pData->sDirty.iCount = 0;
+  pData->sDirty.bOpen  = MNG_FALSE;
+
+  return;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void flush_dirtyrects (mng_datap pData)
+{
+  mng_close_dirtyrect (pData);         /* these go with the coming refresh */
+  pData->sDirtydone = pData->sDirty;
+                                       /* and so does the update region */
+  pData->sRefreshdone.iLeft   = (mng_int32)pData->iUpdateleft;
+  pData->sRefreshdone.iTop    = (mng_int32)pData->iUpdatetop;
+  pData->sRefreshdone.iRight  = (mng_int32)pData->iUpdateright;
+  pData->sRefreshdone.iBottom = (mng_int32)pData->iUpdatebottom;
+  mng_reset_dirtyrects (pData);
+
+  return;
+}
+
 /* ************************************************************************** */
 /* *                                                                        * */
 /* * Progressive display refresh - does the call to the refresh callback    * */
@@ -344,6 +543,8 @@ mng_retcode mng_display_progressive_refresh (mng_datap  pData,
     if ((pData->bRunning) && (!pData->bSkipping) &&
         (pData->iUpdatetop < pData->iUpdatebottom) && (pData->iUpdateleft < pData->iUpdateright))
     {
+      flush_dirtyrects (pData);        /* publish the dirty-rectangles */
+
       if (!pData->fRefresh (((mng_handle)pData),
                             pData->iUpdateleft, pData->iUpdatetop,
                             pData->iUpdateright  - pData->iUpdateleft,
@@ -393,17 +594,22 @@ MNG_LOCAL mng_retcode interframe_delay (mng_datap pData)
      if ((pData->bRunning) && (!pData->bSkipping) &&
          (pData->iUpdatetop < pData->iUpdatebottom) &&
          (pData->iUpdateleft < pData->iUpdateright))
+     {
+       flush_dirtyrects (pData);      /* publish the dirty-rectangles */
+
        if (!pData->fRefresh (((mng_handle)pData),
                               pData->iUpdateleft,  pData->iUpdatetop,
                               pData->iUpdateright - pData->iUpdateleft,
                               pData->iUpdatebottom - pData->iUpdatetop))
           MNG_ERROR (pData, MNG_APPMISCERROR);
+     }
 
      pData->iUpdateleft   = 0;        /* reset update-region */
      pData->iUpdateright  = 0;
      pData->iUpdatetop    = 0;
      pData->iUpdatebottom = 0;        /* reset refreshneeded indicator */
      pData->bNeedrefresh  = MNG_FALSE;
+     mng_reset_dirtyrects (pData);
 
 #ifndef MNG_SKIPCHUNK_TERM
      if (pData->bOnlyfirstframe) /* only processing first frame after TERM ? */
@@ -420,9 +626,12 @@ MNG_LOCAL mng_retcode interframe_delay (mng_datap pData)
       }
 #endif
 
-     if (pData->fGettickcount)
+     if ((pData->bVirtualclock) || (pData->fGettickcount))
       {                                /* get current tickcount */
-        pData->iRuntime = pData->fGettickcount ((mng_handle)pData);
+        if (pData->bVirtualclock)
+          pData->iRuntime = pData->iVirtualtime;
+        else
+          pData->iRuntime = pData->fGettickcount ((mng_handle)pData);
                                        /* calculate interval since last sync-point */
         if (pData->iRuntime < pData->iSynctime)
           iRuninterval    = pData->iRuntime + ~pData->iSynctime + 1;
@@ -537,27 +746,107 @@ MNG_LOCAL void set_display_routine (mng_datap pData)
 #endif
 
 #ifndef MNG_NO_16BIT_SUPPORT
-/*      case MNG_CANVAS_RGB16   : { pData->fDisplayrow = (mng_fptr)mng_display_rgb16;    break; } */
-/*      case MNG_CANVAS_RGBA16  : { pData->fDisplayrow = (mng_fptr)mng_display_rgba16;   break; } */
-/*      case MNG_CANVAS_ARGB16  : { pData->fDisplayrow = (mng_fptr)mng_display_argb16;   break; } */
-/*      case MNG_CANVAS_BGR16   : { pData->fDisplayrow = (mng_fptr)mng_display_bgr16;    break; } */
-/*      case MNG_CANVAS_BGRA16  : { pData->fDisplayrow = (mng_fptr)mng_display_bgra16;   break; } */
-/*      case MNG_CANVAS_ABGR16  : { pData->fDisplayrow = (mng_fptr)mng_display_abgr16;   break; } */
+#ifndef MNG_SKIPCANVAS_RGB16
+      case MNG_CANVAS_RGB16   : { pData->fDisplayrow = (mng_fptr)mng_display_rgb16;    break; }
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA16
+      case MNG_CANVAS_RGBA16  : { pData->fDisplayrow = (mng_fptr)mng_display_rgba16;   break; }
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB16
+      case MNG_CANVAS_ARGB16  : { pData->fDisplayrow = (mng_fptr)mng_display_argb16;   break; }
+#endif
+#ifndef MNG_SKIPCANVAS_BGR16
+      case MNG_CANVAS_BGR16   : { pData->fDisplayrow = (mng_fptr)mng_display_bgr16;    break; }
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA16
+      case MNG_CANVAS_BGRA16  : { pData->fDisplayrow = (mng_fptr)mng_display_bgra16;   break; }
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR16
+      case MNG_CANVAS_ABGR16  : { pData->fDisplayrow = (mng_fptr)mng_display_abgr16;   break; }
+#endif
 #endif
 /*      case MNG_CANVAS_INDEX8  : { pData->fDisplayrow = (mng_fptr)mng_display_index8;   break; } */
 /*      case MNG_CANVAS_INDEXA8 : { pData->fDisplayrow = (mng_fptr)mng_display_indexa8;  break; } */
 /*      case MNG_CANVAS_AINDEX8 : { pData->fDisplayrow = (mng_fptr)mng_display_aindex8;  break; } */
-/*      case MNG_CANVAS_GRAY8   : { pData->fDisplayrow = (mng_fptr)mng_display_gray8;    break; } */
-/*      case MNG_CANVAS_AGRAY8  : { pData->fDisplayrow = (mng_fptr)mng_display_agray8;   break; } */
-/*      case MNG_CANVAS_GRAYA8  : { pData->fDisplayrow = (mng_fptr)mng_display_graya8;   break; } */
+#ifndef MNG_SKIPCANVAS_GRAY8
+      case MNG_CANVAS_GRAY8   : { pData->fDisplayrow = (mng_fptr)mng_display_gray8;    break; }
+#endif
+#ifndef MNG_SKIPCANVAS_AGRAY8
+      case MNG_CANVAS_AGRAY8  : { pData->fDisplayrow = (mng_fptr)mng_display_agray8;   break; }
+#endif
+#ifndef MNG_SKIPCANVAS_GRAYA8
+      case MNG_CANVAS_GRAYA8  : { pData->fDisplayrow = (mng_fptr)mng_display_graya8;   break; }
+#endif
 #ifndef MNG_NO_16BIT_SUPPORT
-/*      case MNG_CANVAS_GRAY16  : { pData->fDisplayrow = (mng_fptr)mng_display_gray16;   break; } */
-/*      case MNG_CANVAS_GRAYA16 : { pData->fDisplayrow = (mng_fptr)mng_display_graya16;  break; } */
-/*      case MNG_CANVAS_AGRAY16 : { pData->fDisplayrow = (mng_fptr)mng_display_agray16;  break; } */
+#ifndef MNG_SKIPCANVAS_GRAY16
+      case MNG_CANVAS_GRAY16  : { pData->fDisplayrow = (mng_fptr)mng_display_gray16;   break; }
+#endif
+#ifndef MNG_SKIPCANVAS_GRAYA16
+      case MNG_CANVAS_GRAYA16 : { pData->fDisplayrow = (mng_fptr)mng_display_graya16;  break; }
+#endif
+#ifndef MNG_SKIPCANVAS_AGRAY16
+      case MNG_CANVAS_AGRAY16 : { pData->fDisplayrow = (mng_fptr)mng_display_agray16;  break; }
+#endif
 #endif
 /*      case MNG_CANVAS_DX15    : { pData->fDisplayrow = (mng_fptr)mng_display_dx15;     break; } */
 /*      case MNG_CANVAS_DX16    : { pData->fDisplayrow = (mng_fptr)mng_display_dx16;     break; } */
     }
+
+#ifdef MNG_SUPPORT_SIMD
+    if (pData->iSIMDflags)               /* use the vectorized versions ? */
+    {
+      switch (pData->iCanvasstyle)
+      {
+#ifndef MNG_SKIPCANVAS_RGBA8
+        case MNG_CANVAS_RGBA8   : { pData->fDisplayrow = (mng_fptr)mng_display_rgba8_simd;    break; }
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA8_PM
+        case MNG_CANVAS_RGBA8_PM: { pData->fDisplayrow = (mng_fptr)mng_display_rgba8_pm_simd; break; }
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB8
+        case MNG_CANVAS_ARGB8   : { pData->fDisplayrow = (mng_fptr)mng_display_argb8_simd;    break; }
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB8_PM
+        case MNG_CANVAS_ARGB8_PM: { pData->fDisplayrow = (mng_fptr)mng_display_argb8_pm_simd; break; }
+#endif
+#ifndef MNG_SKIPCANVAS_RGB8_A8
+        case MNG_CANVAS_RGB8_A8 : { pData->fDisplayrow = (mng_fptr)mng_display_rgb8_a8_simd;  break; }
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA8
+        case MNG_CANVAS_BGRA8   : { pData->fDisplayrow = (mng_fptr)mng_display_bgra8_simd;    break; }
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA8_PM
+        case MNG_CANVAS_BGRA8_PM: { pData->fDisplayrow = (mng_fptr)mng_display_bgra8_pm_simd; break; }
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR8
+        case MNG_CANVAS_ABGR8   : { pData->fDisplayrow = (mng_fptr)mng_display_abgr8_simd;    break; }
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR8_PM
+        case MNG_CANVAS_ABGR8_PM: { pData->fDisplayrow = (mng_fptr)mng_display_abgr8_pm_simd; break; }
+#endif
+#ifndef MNG_NO_16BIT_SUPPORT
+#ifndef MNG_SKIPCANVAS_RGB16
+        case MNG_CANVAS_RGB16   : { pData->fDisplayrow = (mng_fptr)mng_display_rgb16_simd;    break; }
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA16
+        case MNG_CANVAS_RGBA16  : { pData->fDisplayrow = (mng_fptr)mng_display_rgba16_simd;   break; }
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB16
+        case MNG_CANVAS_ARGB16  : { pData->fDisplayrow = (mng_fptr)mng_display_argb16_simd;   break; }
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA16
+        case MNG_CANVAS_BGRA16  : { pData->fDisplayrow = (mng_fptr)mng_display_bgra16_simd;   break; }
+#endif
+#ifndef MNG_SKIPCANVAS_BGR16
+        case MNG_CANVAS_BGR16   : { pData->fDisplayrow = (mng_fptr)mng_display_bgr16_simd;    break; }
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR16
+        case MNG_CANVAS_ABGR16  : { pData->fDisplayrow = (mng_fptr)mng_display_abgr16_simd;   break; }
+#endif
+#endif
+      }
+    }
+#endif
   }
 
   return;
@@ -576,6 +865,9 @@ MNG_LOCAL mng_retcode load_bkgdlayer (mng_datap pData)
     mng_int32   iY;
     mng_retcode iRetcode;
     mng_bool    bColorcorr   = MNG_FALSE;
+#ifndef MNG_NO_16BIT_SUPPORT
+    mng_fptr    fRestbkgd16  = MNG_NULL;
+#endif
                                        /* save values */
     mng_int32   iDestl       = pData->iDestl;
     mng_int32   iDestr       = pData->iDestr;
@@ -595,6 +887,7 @@ MNG_LOCAL mng_retcode load_bkgdlayer (mng_datap pData)
     mng_uint8p  pPrevrow     = pData->pPrevrow;
     mng_uint8p  pRGBArow     = pData->pRGBArow;
     mng_bool    bIsRGBA16    = pData->bIsRGBA16;
+    mng_bool    bIsGray      = pData->bIsGray;
     mng_bool    bIsOpaque    = pData->bIsOpaque;
     mng_fptr    fCorrectrow  = pData->fCorrectrow;
     mng_fptr    fDisplayrow  = pData->fDisplayrow;
@@ -627,6 +920,7 @@ MNG_LOCAL mng_retcode load_bkgdlayer (mng_datap pData)
       pData->iRowsamples = pData->iWidth;
       pData->iRowsize    = pData->iRowsamples << 2;
       pData->bIsRGBA16   = MNG_FALSE;  /* let's keep it simple ! */
+      pData->bIsGray     = MNG_FALSE;
       pData->bIsOpaque   = MNG_TRUE;
 
       pData->iSourcel    = 0;          /* source relative to destination */
@@ -673,8 +967,14 @@ MNG_LOCAL mng_retcode load_bkgdlayer (mng_datap pData)
           case MNG_CANVAS_RGB565  : { pData->fRestbkgdrow = (mng_fptr)mng_restore_bkgd_rgb565;  break; }
 #endif
 #ifndef MNG_NO_16BIT_SUPPORT
-  /*        case MNG_CANVAS_RGB16   : { pData->fRestbkgdrow = (mng_fptr)mng_restore_bkgd_rgb16;   break; } */
-  /*        case MNG_CANVAS_BGR16   : { pData->fRestbkgdrow = (mng_fptr)mng_restore_bkgd_bgr16;   break; } */
+#ifndef MNG_SKIPCANVAS_RGB16
+          case MNG_CANVAS_RGB16   : { pData->fRestbkgdrow = (mng_fptr)mng_restore_bkgd_rgb16;
+                                      fRestbkgd16         = pData->fRestbkgdrow;            break; }
+#endif
+#ifndef MNG_SKIPCANVAS_BGR16
+          case MNG_CANVAS_BGR16   : { pData->fRestbkgdrow = (mng_fptr)mng_restore_bkgd_bgr16;
+                                      fRestbkgd16         = pData->fRestbkgdrow;            break; }
+#endif
 #endif
   /*        case MNG_CANVAS_INDEX8  : { pData->fRestbkgdrow = (mng_fptr)mng_restore_bkgd_index8;  break; } */
   /*        case MNG_CANVAS_GRAY8   : { pData->fRestbkgdrow = (mng_fptr)mng_restore_bkgd_gray8;   break; } */
@@ -703,6 +1003,14 @@ MNG_LOCAL mng_retcode load_bkgdlayer (mng_datap pData)
       }
 #endif
 
+#ifndef MNG_NO_16BIT_SUPPORT
+      if ((fRestbkgd16) && (pData->fRestbkgdrow == fRestbkgd16))
+      {                                /* keep the 16-bit background as is */
+        pData->iRowsize  = pData->iRowsamples << 3;
+        pData->bIsRGBA16 = MNG_TRUE;
+      }
+#endif
+
       pData->fCorrectrow = MNG_NULL;   /* default no color-correction */
 
       if (bColorcorr)                  /* do we have to do color-correction ? */
@@ -996,6 +1304,7 @@ MNG_LOCAL mng_retcode load_bkgdlayer (mng_datap pData)
     pData->pPrevrow     = pPrevrow;
     pData->pRGBArow     = pRGBArow;
     pData->bIsRGBA16    = bIsRGBA16;
+    pData->bIsGray      = bIsGray;
     pData->bIsOpaque    = bIsOpaque;
     pData->fCorrectrow  = fCorrectrow;
     pData->fDisplayrow  = fDisplayrow; 
@@ -1040,6 +1349,7 @@ MNG_LOCAL mng_retcode clear_canvas (mng_datap pData)
   pData->iRowsamples = pData->iWidth;
   pData->iRowsize    = pData->iRowsamples << 2;
   pData->bIsRGBA16   = MNG_FALSE;      /* let's keep it simple ! */
+  pData->bIsGray     = MNG_FALSE;
   pData->bIsOpaque   = MNG_TRUE;
 
   set_display_routine (pData);         /* determine display routine */
@@ -1228,6 +1538,7 @@ MNG_LOCAL mng_retcode next_frame (mng_datap  pData,
 MNG_LOCAL mng_retcode next_layer (mng_datap pData)
 {
   mng_imagep  pImage;
+  mng_uint32  iImgwidth, iImgheight;
   mng_retcode iRetcode = MNG_NOERROR;
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1278,16 +1589,24 @@ MNG_LOCAL mng_retcode next_layer (mng_datap pData)
 
     if (!pImage)                       /* not an active object ? */
       pImage = (mng_imagep)pData->pObjzero;
+
+    iImgwidth  = pImage->pImgbuf->iWidth;
+    iImgheight = pImage->pImgbuf->iHeight;
+
+#ifndef MNG_SKIPCHUNK_MAGN             /* magnified while it's displayed ? */
+    if ((mng_objectp)pImage == pData->pMagnobj)
+      mng_magnify_size (pImage, &iImgwidth, &iImgheight);
+#endif
                                        /* determine display rectangle */
     pData->iDestl   = MAX_COORD ((mng_int32)0,   pImage->iPosx);
     pData->iDestt   = MAX_COORD ((mng_int32)0,   pImage->iPosy);
                                        /* is it a valid buffer ? */
-    if ((pImage->pImgbuf->iWidth) && (pImage->pImgbuf->iHeight))
+    if ((iImgwidth) && (iImgheight))
     {
       pData->iDestr = MIN_COORD ((mng_int32)pData->iWidth,
-                                 pImage->iPosx + (mng_int32)pImage->pImgbuf->iWidth );
+                                 pImage->iPosx + (mng_int32)iImgwidth );
       pData->iDestb = MIN_COORD ((mng_int32)pData->iHeight,
-                                 pImage->iPosy + (mng_int32)pImage->pImgbuf->iHeight);
+                                 pImage->iPosy + (mng_int32)iImgheight);
     }
     else                               /* it's a single image ! */
     {
@@ -1318,11 +1637,11 @@ MNG_LOCAL mng_retcode next_layer (mng_datap pData)
     pData->iSourcel = MAX_COORD ((mng_int32)0,   pData->iDestl - pImage->iPosx);
     pData->iSourcet = MAX_COORD ((mng_int32)0,   pData->iDestt - pImage->iPosy);
 
-    if ((pImage->pImgbuf->iWidth) && (pImage->pImgbuf->iHeight))
+    if ((iImgwidth) && (iImgheight))
     {                                  /* and maximum size  */
-      pData->iSourcer = MIN_COORD ((mng_int32)pImage->pImgbuf->iWidth,
+      pData->iSourcer = MIN_COORD ((mng_int32)iImgwidth,
                                    pData->iSourcel + pData->iDestr - pData->iDestl);
-      pData->iSourceb = MIN_COORD ((mng_int32)pImage->pImgbuf->iHeight,
+      pData->iSourceb = MIN_COORD ((mng_int32)iImgheight,
                                    pData->iSourcet + pData->iDestb - pData->iDestt);
     }
     else                               /* it's a single image ! */
@@ -1354,15 +1673,27 @@ mng_retcode mng_display_image (mng_datap  pData,
 #endif
                                        /* actively running ? */
 #ifndef MNG_SKIPCHUNK_MAGN
+  pData->pMagnobj = MNG_NULL;
+
   if (((pData->bRunning) || (pData->bSearching)) && (!pData->bSkipping))
-  {
-    if ( (!pData->iBreakpoint) &&      /* needs magnification ? */
-         ( (pImage->iMAGN_MethodX) || (pImage->iMAGN_MethodY) ) )
-    {
-      iRetcode = mng_magnify_imageobject (pData, pImage);
+  {                                    /* needs magnification ? */
+    if ((pImage->iMAGN_MethodX) || (pImage->iMAGN_MethodY))
+    {                                  /* can it be done while displaying ? */
+      if ((pData->bLazymagnify) && (!bLayeradvanced) &&
+          (pImage->pImgbuf->iBitdepth == 8) &&
+          (pImage->pImgbuf->iColortype != MNG_COLORTYPE_INDEXED) &&
+          (!pImage->pImgbuf->bHasTRNS) &&
+          (pImage->pImgbuf->iWidth) && (pImage->pImgbuf->iHeight) &&
+          ((!pData->bHasBACK) || (pData->iBACKimageid != pImage->iId)))
+        pData->pMagnobj = (mng_objectp)pImage;
+      else
+      if (!pData->iBreakpoint)
+      {
+        iRetcode = mng_magnify_imageobject (pData, pImage);
 
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
+        if (iRetcode)                  /* on error bail out */
+          return iRetcode;
+      }
     }
   }
 #endif
@@ -1373,8 +1704,11 @@ mng_retcode mng_display_image (mng_datap  pData,
   {
     mng_imagep pSave    = pData->pCurrentobj;
     pData->pCurrentobj  = pImage;
-    next_layer (pData);                /* advance to next layer */
-    pData->pCurrentobj  = pSave;
+    iRetcode            = next_layer (pData);
+    pData->pCurrentobj  = pSave;       /* advanced to next layer */
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
   }
                                        /* need to restore the background ? */
   if ((!pData->bTimerset) && (pData->bRestorebkgd))
@@ -1519,6 +1853,33 @@ mng_retcode mng_display_image (mng_datap  pData,
         pData->iCol        = 0;
         pData->iColinc     = 1;
         pData->iRowsamples = pImage->pImgbuf->iWidth;
+
+#ifndef MNG_SKIPCHUNK_MAGN
+        if (pData->pMagnobj)           /* magnify while displaying ? */
+        {
+          mng_uint32    iMagnwidth, iMagnheight;
+          mng_magnify_x fMagnifyX;
+          mng_magnify_y fMagnifyY;
+
+          mng_magnify_size (pImage, &iMagnwidth, &iMagnheight);
+                                       /* the retrieved rows are RGBA8 */
+          mng_magnify_routines (pData, MNG_COLORTYPE_RGBA, 8,
+                                pImage->iMAGN_MethodX, pImage->iMAGN_MethodY,
+                                &fMagnifyX, &fMagnifyY);
+
+          pData->fMagnretrieve = pData->fRetrieverow;
+          pData->fRetrieverow  = (mng_fptr)mng_retrieve_magnify;
+          pData->fMagnifyX     = (mng_fptr)fMagnifyX;
+          pData->fMagnifyY     = (mng_fptr)fMagnifyY;
+          pData->iMagnrowsize  = pImage->pImgbuf->iWidth << 2;
+          pData->iMagnrow1     = -1;
+          pData->iMagnrow2     = -1;
+          pData->iMagnlast     = -1;
+          pData->iMagnlastS    = -1;
+          pData->iRowsamples   = (mng_int32)iMagnwidth;
+        }
+#endif
+
         pData->iRowsize    = pData->iRowsamples << 2;
         pData->bIsRGBA16   = MNG_FALSE;
                                        /* adjust for 16-bit object ? */
@@ -1545,28 +1906,69 @@ mng_retcode mng_display_image (mng_datap  pData,
         if (iRetcode)                  /* on error bail out */
           return iRetcode;
 #endif /* MNG_NO_CMS */
-                                       /* get a temporary row-buffer */
-        MNG_ALLOC (pData, pData->pRGBArow, pData->iRowsize);
 
-        iY = pData->iSourcet;          /* this is where we start */
+#ifdef MNG_INCLUDE_GRAYROW             /* gray onto a gray canvas ? */
+        iRetcode = mng_init_grayrow (pData, MNG_TRUE);
 
-        while ((!iRetcode) && (iY < pData->iSourceb))
-        {                              /* get a row */
-          iRetcode = ((mng_retrieverow)pData->fRetrieverow) (pData);
+        if (iRetcode)                  /* on error bail out */
+          return iRetcode;
+#endif
+#ifdef MNG_INCLUDE_FUSEDROW            /* can it be done in one pass ? */
+        iRetcode = mng_init_fusedrow (pData);
+
+        if (iRetcode)                  /* on error bail out */
+          return iRetcode;
+
+        if (pData->fFusedrow)          /* then do all rows at once */
+          iRetcode = ((mng_fusedrow)pData->fFusedrow) (pData);
+        else
+#endif
+        {                              /* get a temporary row-buffer */
+          MNG_ALLOC (pData, pData->pRGBArow, pData->iRowsize);
+
+#ifndef MNG_SKIPCHUNK_MAGN
+          if (pData->pMagnobj)         /* and the source rows for magnifying */
+          {
+            MNG_ALLOC (pData, pData->pMagnrow1, pData->iMagnrowsize);
+            MNG_ALLOC (pData, pData->pMagnrow2, pData->iMagnrowsize);
+            MNG_ALLOC (pData, pData->pMagntemp, pData->iMagnrowsize);
+          }
+#endif
+
+          iY = pData->iSourcet;        /* this is where we start */
+
+          while ((!iRetcode) && (iY < pData->iSourceb))
+          {                            /* get a row */
+            iRetcode = ((mng_retrieverow)pData->fRetrieverow) (pData);
                                        /* color correction ? */
-          if ((!iRetcode) && (pData->fCorrectrow))
-            iRetcode = ((mng_correctrow)pData->fCorrectrow) (pData);
+            if ((!iRetcode) && (pData->fCorrectrow))
+              iRetcode = ((mng_correctrow)pData->fCorrectrow) (pData);
 
-          if (!iRetcode)               /* so... display it */
-            iRetcode = ((mng_displayrow)pData->fDisplayrow) (pData);
+            if (!iRetcode)             /* so... display it */
+              iRetcode = ((mng_displayrow)pData->fDisplayrow) (pData);
 
-          if (!iRetcode)               /* adjust variables for next row */
-            iRetcode = mng_next_row (pData);
+            if (!iRetcode)             /* adjust variables for next row */
+              iRetcode = mng_next_row (pData);
 
-          iY++;                        /* and next line */
-        }
+            iY++;                      /* and next line */
+          }
                                        /* drop the temporary row-buffer */
-        MNG_FREE (pData, pData->pRGBArow, pData->iRowsize);
+          MNG_FREE (pData, pData->pRGBArow, pData->iRowsize);
+
+#ifndef MNG_SKIPCHUNK_MAGN
+          if (pData->pMagnobj)
+          {
+            MNG_FREE (pData, pData->pMagntemp, pData->iMagnrowsize);
+            MNG_FREE (pData, pData->pMagnrow2, pData->iMagnrowsize);
+            MNG_FREE (pData, pData->pMagnrow1, pData->iMagnrowsize);
+          }
+#endif
+        }
+
+        pData->bIsGray = MNG_FALSE;    /* back to the RGBA row */
+#ifndef MNG_SKIPCHUNK_MAGN
+        pData->pMagnobj = MNG_NULL;
+#endif
 
         if (iRetcode)                  /* on error bail out */
           return iRetcode;
@@ -1591,6 +1993,26 @@ mng_retcode mng_display_image (mng_datap  pData,
 /* ************************************************************************** */
 
 #ifndef MNG_NO_DELTA_PNG
+MNG_LOCAL mng_bool delta_is_samelayout (mng_fptr fDeltarow)
+{                                      /* rows of delta & target are identical ? */
+  if ((fDeltarow == (mng_fptr)mng_delta_g8_g8      ) ||
+      (fDeltarow == (mng_fptr)mng_delta_rgb8_rgb8  ) ||
+      (fDeltarow == (mng_fptr)mng_delta_ga8_ga8    ) ||
+      (fDeltarow == (mng_fptr)mng_delta_rgba8_rgba8)    )
+    return MNG_TRUE;
+#ifndef MNG_NO_16BIT_SUPPORT
+  if ((fDeltarow == (mng_fptr)mng_delta_g16_g16      ) ||
+      (fDeltarow == (mng_fptr)mng_delta_rgb16_rgb16  ) ||
+      (fDeltarow == (mng_fptr)mng_delta_ga16_ga16    ) ||
+      (fDeltarow == (mng_fptr)mng_delta_rgba16_rgba16)    )
+    return MNG_TRUE;
+#endif
+
+  return MNG_FALSE;
+}
+
+/* ************************************************************************** */
+
 mng_retcode mng_execute_delta_image (mng_datap  pData,
                                      mng_imagep pTarget,
                                      mng_imagep pDelta)
@@ -2047,13 +2469,46 @@ mng_retcode mng_execute_delta_image (mng_datap  pData,
         pData->pRetrieveobj = (mng_objectp)pDelta;
         pData->pStoreobj    = (mng_objectp)pTarget;
 
+        iRetcode = MNG_NOERROR;        /* still oke for now */
+                                       /* full-width rows of the same layout ? */
+        if ((!pData->fScalerow) && (pBuftarget->iColortype != 3) &&
+            (pData->iDeltaBlockx == 0) &&
+            (pBufdelta->iWidth   == pBuftarget->iWidth  ) &&
+            (pBufdelta->iRowsize == pBuftarget->iRowsize) &&
+            (pData->iDeltaBlocky + pBufdelta->iHeight <= pBuftarget->iHeight) &&
+            (pBufdelta->iHeight) && (pBufdelta->iRowsize) &&
+            (pBufdelta->pImgdata) && (pBuftarget->pImgdata) &&
+            (delta_is_samelayout (pData->fDeltarow)))
+        {                              /* then they're one contiguous block */
+          mng_uint8p pOut  = pBuftarget->pImgdata +
+                             (pData->iDeltaBlocky * pBuftarget->iRowsize);
+          mng_uint32 iSize = pBufdelta->iHeight * pBufdelta->iRowsize;
+
+          if (pData->iDeltatype == MNG_DELTATYPE_BLOCKPIXELADD)
+          {
+#ifndef MNG_NO_16BIT_SUPPORT
+            if (pBuftarget->iBitdepth == 16)
+              mng_add_span16 (pData, pOut, pBufdelta->pImgdata, iSize >> 1);
+            else
+#endif
+              mng_add_span8  (pData, pOut, pBufdelta->pImgdata, iSize);
+          }
+          else
+          {
+            MNG_COPY (pOut, pBufdelta->pImgdata, iSize);
+          }
+                                       /* as if we'd done it row by row */
+          pData->iRow = pData->iDeltaBlocky + pBufdelta->iHeight;
+
+          iY = pBufdelta->iHeight;     /* nothing left for the loop below */
+        }
+        else
+          iY = 0;                      /* this is where we start */
+
         pSaveRGBA = pData->pRGBArow;   /* save current temp-buffer! */
                                        /* get a temporary row-buffer */
         MNG_ALLOC (pData, pData->pRGBArow, (pBufdelta->iRowsize << 1));
 
-        iY       = 0;                  /* this is where we start */
-        iRetcode = MNG_NOERROR;        /* still oke for now */
-
         while ((!iRetcode) && (iY < pBufdelta->iHeight))
         {                              /* get a row */
           mng_uint8p pWork = pBufdelta->pImgdata + (iY * pBufdelta->iRowsize);
@@ -2444,6 +2899,8 @@ MNG_LOCAL mng_retcode restore_state (mng_datap pData)
         else
           pData->pLastimgobj   = pPrev;
 
+        mng_unindex_imageobject (pData, pImage);
+
         if (pImage->pImgbuf->bFrozen)  /* buffer frozen ? */
         {
           if (pImage->pImgbuf->iRefcount < 2)
@@ -2478,856 +2935,843 @@ MNG_LOCAL mng_retcode restore_state (mng_datap pData)
 
 /* ************************************************************************** */
 /* *                                                                        * */
-/* * General display processing routine                                     * */
+/* * Keyframe cache routines                                                * */
+/* *                                                                        * */
+/* * Snapshots of the playback state are taken in between two animation     * */
+/* * objects, so the display_goxxxx functions can resume from the nearest   * */
+/* * one instead of replaying the animation from the first frame.           * */
 /* *                                                                        * */
 /* ************************************************************************** */
 
-mng_retcode mng_process_display (mng_datap pData)
+#ifdef MNG_SUPPORT_KEYFRAMES
+MNG_LOCAL mng_uint32 keyframe_pixelsize (mng_uint32 iCanvasstyle)
 {
-  mng_retcode iRetcode = MNG_NOERROR;
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY, MNG_LC_START);
+  switch (iCanvasstyle)                /* bytes per pixel in the canvas-line */
+  {
+    case MNG_CANVAS_RGB8      : ;
+    case MNG_CANVAS_BGR8      : ;
+    case MNG_CANVAS_RGB8_A8   : ;
+    case MNG_CANVAS_RGBA565   : ;
+    case MNG_CANVAS_BGRA565   : return 3;
+    case MNG_CANVAS_RGBA8     : ;
+    case MNG_CANVAS_RGBA8_PM  : ;
+    case MNG_CANVAS_ARGB8     : ;
+    case MNG_CANVAS_ARGB8_PM  : ;
+    case MNG_CANVAS_BGRX8     : ;
+    case MNG_CANVAS_BGRA8     : ;
+    case MNG_CANVAS_BGRA8_PM  : ;
+    case MNG_CANVAS_ABGR8     : ;
+    case MNG_CANVAS_ABGR8_PM  : return 4;
+    case MNG_CANVAS_RGB565    : ;
+    case MNG_CANVAS_BGR565    : ;
+    case MNG_CANVAS_BGR565_A8 : ;
+    case MNG_CANVAS_RGB555    : ;
+    case MNG_CANVAS_BGR555    : return 2;
+    case MNG_CANVAS_GRAY8     : return 1;
+    case MNG_CANVAS_GRAYA8    : ;
+    case MNG_CANVAS_AGRAY8    : return 2;
+#ifndef MNG_NO_16BIT_SUPPORT
+    case MNG_CANVAS_GRAY16    : return 2;
+    case MNG_CANVAS_GRAYA16   : ;
+    case MNG_CANVAS_AGRAY16   : return 4;
+    case MNG_CANVAS_RGB16     : ;
+    case MNG_CANVAS_BGR16     : return 6;
+    case MNG_CANVAS_RGBA16    : ;
+    case MNG_CANVAS_ARGB16    : ;
+    case MNG_CANVAS_BGRA16    : ;
+    case MNG_CANVAS_ABGR16    : return 8;
 #endif
+  }
 
-  if (!pData->iBreakpoint)             /* not broken previously ? */
+  return 0;                            /* not one we know how to copy */
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_imagep keyframe_nextobject (mng_imagep pImage,
+                                          mng_imagep pZero,
+                                          mng_imagep pFirst)
+{                                      /* object 0 goes in front of the list */
+  if (pImage == pZero)
+    return pFirst;
+
+  return (mng_imagep)pImage->sHeader.pNext;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void keyframe_free_objects (mng_datap  pData,
+                                      mng_imagep pZero,
+                                      mng_imagep pFirst)
+{
+  mng_imagep pImage = pZero;
+  mng_imagep pNext;
+
+  if (!pImage)
+    pImage = pFirst;
+
+  while (pImage)
   {
-    if ((pData->iRequestframe) || (pData->iRequestlayer) || (pData->iRequesttime))
-    {
-      pData->bSearching = MNG_TRUE;    /* indicate we're searching */
+    pNext = keyframe_nextobject (pImage, pZero, pFirst);
 
-      iRetcode = clear_canvas (pData); /* make the canvas virgin black ?!? */
+    if (pImage->pImgbuf)               /* drop (or unshare) its buffer */
+      mng_free_imagedataobject (pData, pImage->pImgbuf);
 
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
-                                       /* let's start from the top, shall we */
-      pData->pCurraniobj = pData->pFirstaniobj;
-    }
+    MNG_FREEX (pData, pImage, sizeof (mng_image));
+
+    pImage = pNext;
   }
 
-  do                                   /* process the objects */
+  return;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_imagedatap keyframe_copy_imgbuf (mng_datap      pData,
+                                               mng_imagedatap pSource,
+                                               mng_uint32     *piMemsize)
+{
+  mng_imagedatap pImgbuf;
+
+  MNG_ALLOCX (pData, pImgbuf, sizeof (mng_imagedata));
+
+  if (!pImgbuf)
+    return MNG_NULL;
+
+  MNG_COPY (pImgbuf, pSource, sizeof (mng_imagedata));
+
+  pImgbuf->iRefcount    = 1;
+  pImgbuf->pImgdata     = MNG_NULL;
+  pImgbuf->iImgdatasize = 0;
+#ifndef MNG_SKIPCHUNK_iCCP
+  pImgbuf->pProfile     = MNG_NULL;
+  pImgbuf->iProfilesize = 0;
+#endif
+
+  if (pSource->iImgdatasize)           /* copy the samples */
   {
-    if (pData->bSearching)             /* clear timer-flag when searching !!! */
-      pData->bTimerset = MNG_FALSE;
-                                       /* do we need to finish something first ? */
-    if ((pData->iBreakpoint) && (pData->iBreakpoint < 99))
+    MNG_ALLOCX (pData, pImgbuf->pImgdata, pSource->iImgdatasize);
+
+    if (!pImgbuf->pImgdata)
     {
-      switch (pData->iBreakpoint)      /* return to broken display routine */
-      {
-#ifndef MNG_SKIPCHUNK_FRAM
-        case  1 : { iRetcode = mng_process_display_fram2 (pData); break; }
-#endif
-#ifndef MNG_SKIPCHUNK_SHOW
-        case  3 : ;                    /* same as 4 !!! */
-        case  4 : { iRetcode = mng_process_display_show  (pData); break; }
-#endif
-#ifndef MNG_SKIPCHUNK_CLON
-        case  5 : { iRetcode = mng_process_display_clon2 (pData); break; }
-#endif
-#ifndef MNG_SKIPCHUNK_MAGN
-        case  9 : { iRetcode = mng_process_display_magn2 (pData); break; }
-        case 10 : { iRetcode = mng_process_display_mend2 (pData); break; }
-#endif
-#ifndef MNG_SKIPCHUNK_PAST
-        case 11 : { iRetcode = mng_process_display_past2 (pData); break; }
-#endif
-        default : MNG_ERROR (pData, MNG_INTERNALERROR);
-      }
+      MNG_FREEX (pData, pImgbuf, sizeof (mng_imagedata));
+      return MNG_NULL;
     }
-    else
+
+    MNG_COPY (pImgbuf->pImgdata, pSource->pImgdata, pSource->iImgdatasize);
+    pImgbuf->iImgdatasize = pSource->iImgdatasize;
+  }
+
+#ifndef MNG_SKIPCHUNK_iCCP
+  if (pSource->iProfilesize)           /* and the profile */
+  {
+    MNG_ALLOCX (pData, pImgbuf->pProfile, pSource->iProfilesize);
+
+    if (!pImgbuf->pProfile)
     {
-      if (pData->pCurraniobj)
-        iRetcode = ((mng_object_headerp)pData->pCurraniobj)->fProcess (pData, pData->pCurraniobj);
+      mng_free_imagedataobject (pData, pImgbuf);
+      return MNG_NULL;
     }
 
-    if (!pData->bTimerset)             /* reset breakpoint flag ? */
-      pData->iBreakpoint = 0;
-                                       /* can we advance to next object ? */
-    if ((!iRetcode) && (pData->pCurraniobj) &&
-        (!pData->bTimerset) && (!pData->bSectionwait))
-    {
-      pData->pCurraniobj = ((mng_object_headerp)pData->pCurraniobj)->pNext;
-                                       /* MEND processing to be done ? */
-      if ((pData->eImagetype == mng_it_mng) && (!pData->pCurraniobj))
-        iRetcode = mng_process_display_mend (pData);
+    MNG_COPY (pImgbuf->pProfile, pSource->pProfile, pSource->iProfilesize);
+    pImgbuf->iProfilesize = pSource->iProfilesize;
+  }
 
-      if (!pData->pCurraniobj)         /* refresh after last image ? */
-        pData->bNeedrefresh = MNG_TRUE;
-    }
+  *piMemsize += pImgbuf->iProfilesize;
+#endif
 
-    if (pData->bSearching)             /* are we looking for something ? */
+  *piMemsize += sizeof (mng_imagedata) + pImgbuf->iImgdatasize;
+
+  return pImgbuf;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool keyframe_copy_objects (mng_datap  pData,
+                                          mng_imagep pSrczero,
+                                          mng_imagep pSrcfirst,
+                                          mng_imagep *ppZero,
+                                          mng_imagep *ppFirst,
+                                          mng_imagep *ppLast,
+                                          mng_uint32 *piMemsize)
+{
+  mng_imagep pSource = pSrczero;
+  mng_imagep pImage;
+  mng_imagep pS;
+  mng_imagep pC;
+
+  *ppZero  = MNG_NULL;
+  *ppFirst = MNG_NULL;
+  *ppLast  = MNG_NULL;
+
+  if (!pSource)
+    pSource = pSrcfirst;
+
+  while (pSource)
+  {
+    MNG_ALLOCX (pData, pImage, sizeof (mng_image));
+
+    if (!pImage)
+      break;
+
+    MNG_COPY (pImage, pSource, sizeof (mng_image));
+
+    pImage->sHeader.pNext = MNG_NULL;
+    pImage->sHeader.pPrev = MNG_NULL;
+    pImage->pImgbuf       = MNG_NULL;
+
+    if (pSource == pSrczero)           /* link it in */
+      *ppZero = pImage;
+    else
     {
-      if ((pData->iRequestframe) && (pData->iRequestframe <= pData->iFrameseq))
-      {
-        pData->iRequestframe = 0;      /* found the frame ! */
-        pData->bSearching    = MNG_FALSE;
-      }
-      else
-      if ((pData->iRequestlayer) && (pData->iRequestlayer <= pData->iLayerseq))
+      if (*ppLast)
       {
-        pData->iRequestlayer = 0;      /* found the layer ! */
-        pData->bSearching    = MNG_FALSE;
+        pImage->sHeader.pPrev = *ppLast;
+        ((mng_imagep)*ppLast)->sHeader.pNext = pImage;
       }
       else
-      if ((pData->iRequesttime) && (pData->iRequesttime <= pData->iFrametime))
+        *ppFirst = pImage;
+
+      *ppLast = pImage;
+    }
+
+    *piMemsize += sizeof (mng_image);
+                                       /* buffer shared with an earlier object ? */
+    pS = pSrczero ? pSrczero : pSrcfirst;
+    pC = *ppZero  ? *ppZero  : *ppFirst;
+
+    while ((pS != pSource) && (!pImage->pImgbuf))
+    {
+      if (pS->pImgbuf == pSource->pImgbuf)
       {
-        pData->iRequesttime  = 0;      /* found the playtime ! */
-        pData->bSearching    = MNG_FALSE;
+        pImage->pImgbuf = pC->pImgbuf;
+        pImage->pImgbuf->iRefcount++;
       }
+
+      pS = keyframe_nextobject (pS, pSrczero, pSrcfirst);
+      pC = keyframe_nextobject (pC, *ppZero,  *ppFirst);
     }
-  }                                    /* until error or a break or no more objects */
-  while ((!iRetcode) && (pData->pCurraniobj) &&
-         (((pData->bRunning) && (!pData->bTimerset)) || (pData->bSearching)) &&
-         (!pData->bSectionwait) && (!pData->bFreezing));
 
-  if (iRetcode)                        /* on error bail out */
-    return iRetcode;
-                                       /* refresh needed ? */
-  if ((!pData->bTimerset) && (pData->bNeedrefresh))
-  {
-    iRetcode = mng_display_progressive_refresh (pData, 1);
+    if (!pImage->pImgbuf)              /* no; so copy it */
+      pImage->pImgbuf = keyframe_copy_imgbuf (pData, pSource->pImgbuf, piMemsize);
 
-    if (iRetcode)                      /* on error bail out */
-      return iRetcode;
+    if (!pImage->pImgbuf)
+      break;
+
+    pSource = keyframe_nextobject (pSource, pSrczero, pSrcfirst);
   }
-                                       /* timer break ? */
-  if ((pData->bTimerset) && (!pData->iBreakpoint))
-    pData->iBreakpoint = 99;
-  else
-  if (!pData->bTimerset)
-    pData->iBreakpoint = 0;            /* reset if no timer break */
 
-  if ((!pData->bTimerset) && (!pData->pCurraniobj))
-    pData->bRunning = MNG_FALSE;       /* all done now ! */
+  if (pSource)                         /* out of memory; drop the partial copy */
+  {                                    /* (the caller may still hold the heads) */
+    keyframe_free_objects (pData, *ppZero, *ppFirst);
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY, MNG_LC_END);
-#endif
+    *ppZero  = MNG_NULL;
+    *ppFirst = MNG_NULL;
+    *ppLast  = MNG_NULL;
 
-  return MNG_NOERROR;
+    return MNG_FALSE;
+  }
+
+  return MNG_TRUE;
 }
 
-/* ************************************************************************** */
-/* *                                                                        * */
-/* * Chunk display processing routines                                      * */
-/* *                                                                        * */
 /* ************************************************************************** */
 
-#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
-png_imgtype mng_png_imgtype(mng_uint8 colortype, mng_uint8 bitdepth)
+MNG_LOCAL mng_uint32 keyframe_objindex (mng_datap   pData,
+                                        mng_objectp pObject)
 {
-  png_imgtype ret;
-  switch (bitdepth)
+  mng_objectp pImage = pData->pFirstimgobj;
+  mng_uint32  iIndex = 2;
+
+  if (!pObject)
+    return 0;
+
+  if (pObject == pData->pObjzero)
+    return 1;
+
+  while (pImage)
   {
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-    case 1:
-    {
-      png_imgtype imgtype[]={png_g1,png_none,png_none,png_idx1};
-      ret=imgtype[colortype];
-      break;
-    }
-    case 2:
-    {
-      png_imgtype imgtype[]={png_g2,png_none,png_none,png_idx2};
-      ret=imgtype[colortype];
-      break;
-    }
-    case 4:
-    {
-      png_imgtype imgtype[]={png_g4,png_none,png_none,png_idx4};
-      ret=imgtype[colortype];
-      break;
-    }
-#endif
-    case 8:
-    {
-      png_imgtype imgtype[]={png_g8,png_none,png_rgb8,png_idx8,png_ga8,
-          png_none,png_rgba8};
-      ret=imgtype[colortype];
-      break;
-    }
-#ifndef MNG_NO_16BIT_SUPPORT
-    case 16:
-    {
-      png_imgtype imgtype[]={png_g16,png_none,png_rgb16,png_none,png_ga16,
-          png_none,png_rgba16};
-      ret=imgtype[colortype];
-      break;
-    }
-#endif
-    default:
-      ret=png_none;
-      break;
+    if (pImage == pObject)
+      return iIndex;
+
+    iIndex++;
+    pImage = ((mng_object_headerp)pImage)->pNext;
   }
-  return (ret);
+
+  return 0;                            /* stale; treat as none */
 }
-#endif /* MNG_OPTIMIZE_FOOTPRINT_INIT */
 
 /* ************************************************************************** */
 
-mng_retcode mng_process_display_ihdr (mng_datap pData)
-{                                      /* address the current "object" if any */
-  mng_imagep pImage = (mng_imagep)pData->pCurrentobj;
+MNG_LOCAL mng_objectp keyframe_objpointer (mng_datap  pData,
+                                           mng_uint32 iIndex)
+{
+  mng_objectp pImage = pData->pFirstimgobj;
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IHDR, MNG_LC_START);
-#endif
+  if (!iIndex)
+    return MNG_NULL;
 
-  if (!pData->bHasDHDR)
+  if (iIndex == 1)
+    return pData->pObjzero;
+
+  while ((pImage) && (iIndex > 2))
   {
-    pData->fInitrowproc = MNG_NULL;    /* do nothing by default */
-    pData->fDisplayrow  = MNG_NULL;
-    pData->fCorrectrow  = MNG_NULL;
-    pData->fStorerow    = MNG_NULL;
-    pData->fProcessrow  = MNG_NULL;
-    pData->fDifferrow   = MNG_NULL;
-    pData->pStoreobj    = MNG_NULL;
+    iIndex--;
+    pImage = ((mng_object_headerp)pImage)->pNext;
   }
 
-  if (!pData->iBreakpoint)             /* not previously broken ? */
-  {
-    mng_retcode iRetcode = MNG_NOERROR;
+  return pImage;
+}
 
-#ifndef MNG_NO_DELTA_PNG
-    if (pData->bHasDHDR)               /* is a delta-image ? */
-    {
-      if (pData->iDeltatype == MNG_DELTATYPE_REPLACE)
-        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pDeltaImage,
-                                             pData->iDatawidth, pData->iDataheight,
-                                             pData->iBitdepth, pData->iColortype,
-                                             pData->iCompression, pData->iFilter,
-                                             pData->iInterlace, MNG_TRUE);
-      else
-      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKPIXELADD    ) ||
-          (pData->iDeltatype == MNG_DELTATYPE_BLOCKPIXELREPLACE)    )
-      {
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iPixelsampledepth = pData->iBitdepth;
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iBitdepth;
-      }
-      else
-      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKALPHAADD    ) ||
-          (pData->iDeltatype == MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iBitdepth;
-      else
-      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKCOLORADD    ) ||
-          (pData->iDeltatype == MNG_DELTATYPE_BLOCKCOLORREPLACE)    )
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iPixelsampledepth = pData->iBitdepth;
+/* ************************************************************************** */
 
-      if (!iRetcode)
-      {                                /* process immediately if bitdepth & colortype are equal */
-        pData->bDeltaimmediate =
-          (mng_bool)((pData->iBitdepth  == ((mng_imagep)pData->pDeltaImage)->pImgbuf->iBitdepth ) &&
-                     (pData->iColortype == ((mng_imagep)pData->pDeltaImage)->pImgbuf->iColortype)    );
-                                       /* be sure to reset object 0 */
-        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
-                                             pData->iDatawidth, pData->iDataheight,
-                                             pData->iBitdepth, pData->iColortype,
-                                             pData->iCompression, pData->iFilter,
-                                             pData->iInterlace, MNG_TRUE);
-      }
-    }
-    else
-#endif
+MNG_LOCAL void keyframe_free_savedata (mng_datap     pData,
+                                       mng_savedatap pSave)
+{
+  if (pSave->iGlobalProfilesize)
+    MNG_FREEX (pData, pSave->pGlobalProfile, pSave->iGlobalProfilesize);
+
+  return;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_savedatap keyframe_copy_savedata (mng_datap     pData,
+                                                mng_savedatap pSource,
+                                                mng_uint32    *piMemsize)
+{
+  mng_savedatap pSave;
+
+  MNG_ALLOCX (pData, pSave, sizeof (mng_savedata));
+
+  if (!pSave)
+    return MNG_NULL;
+
+  MNG_COPY (pSave, pSource, sizeof (mng_savedata));
+
+  pSave->iGlobalProfilesize = 0;
+  pSave->pGlobalProfile     = MNG_NULL;
+
+  if (pSource->iGlobalProfilesize)
+  {
+    MNG_ALLOCX (pData, pSave->pGlobalProfile, pSource->iGlobalProfilesize);
+
+    if (!pSave->pGlobalProfile)
     {
-      if (pImage)                      /* update object buffer ? */
-        iRetcode = mng_reset_object_details (pData, pImage,
-                                             pData->iDatawidth, pData->iDataheight,
-                                             pData->iBitdepth, pData->iColortype,
-                                             pData->iCompression, pData->iFilter,
-                                             pData->iInterlace, MNG_TRUE);
-      else
-        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
-                                             pData->iDatawidth, pData->iDataheight,
-                                             pData->iBitdepth, pData->iColortype,
-                                             pData->iCompression, pData->iFilter,
-                                             pData->iInterlace, MNG_TRUE);
+      MNG_FREEX (pData, pSave, sizeof (mng_savedata));
+      return MNG_NULL;
     }
 
-    if (iRetcode)                      /* on error bail out */
-      return iRetcode;
+    MNG_COPY (pSave->pGlobalProfile, pSource->pGlobalProfile, pSource->iGlobalProfilesize);
+    pSave->iGlobalProfilesize = pSource->iGlobalProfilesize;
   }
 
-#ifndef MNG_NO_DELTA_PNG
-  if (!pData->bHasDHDR)
-#endif
-  {
-    if (pImage)                        /* real object ? */
-      pData->pStoreobj = pImage;       /* tell the row routines */
-    else                               /* otherwise use object 0 */
-      pData->pStoreobj = pData->pObjzero;
-
-#if !defined(MNG_INCLUDE_MPNG_PROPOSAL) && !defined(MNG_INCLUDE_ANG_PROPOSAL)
-    if (                               /* display "on-the-fly" ? */
-#ifndef MNG_SKIPCHUNK_MAGN
-         (((mng_imagep)pData->pStoreobj)->iMAGN_MethodX == 0) &&
-         (((mng_imagep)pData->pStoreobj)->iMAGN_MethodY == 0) &&
-#endif
-         ( (pData->eImagetype == mng_it_png         ) ||
-           (((mng_imagep)pData->pStoreobj)->bVisible)    )       )
-    {
-      next_layer (pData);              /* that's a new layer then ! */
+  *piMemsize += sizeof (mng_savedata) + pSave->iGlobalProfilesize;
 
-      if (pData->bTimerset)            /* timer break ? */
-        pData->iBreakpoint = 2;
-      else
-      {
-        pData->iBreakpoint = 0;
-                                       /* anything to display ? */
-        if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
-          set_display_routine (pData); /* then determine display routine */
-      }
-    }
-#endif
-  }
+  return pSave;
+}
 
-  if (!pData->bTimerset)               /* no timer break ? */
-  {
-#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
-    pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
-    pData->ePng_imgtype=mng_png_imgtype(pData->iColortype,pData->iBitdepth);
-#else
-    switch (pData->iColortype)         /* determine row initialization routine */
-    {
-      case 0 : {                       /* gray */
-                 switch (pData->iBitdepth)
-                 {
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-                   case  1 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g1_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g1_i;
-
-                               break;
-                             }
-                   case  2 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g2_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g2_i;
-
-                               break;
-                             }
-                   case  4 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g4_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g4_i;
-                               break;
-                             }
-#endif /* MNG_NO_1_2_4BIT_SUPPORT */
-                   case  8 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g8_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g8_i;
-
-                               break;
-                             }
-#ifndef MNG_NO_16BIT_SUPPORT
-                   case 16 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g16_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_g16_i;
+/* ************************************************************************** */
 
-                               break;
-                             }
-#endif
-                 }
+MNG_LOCAL mng_bool keyframe_save_globals (mng_datap     pData,
+                                          mng_savedatap pSave,
+                                          mng_uint32    *piMemsize)
+{
+  pSave->bHasglobalPLTE       = pData->bHasglobalPLTE;
+  pSave->bHasglobalTRNS       = pData->bHasglobalTRNS;
+  pSave->bHasglobalGAMA       = pData->bHasglobalGAMA;
+  pSave->bHasglobalCHRM       = pData->bHasglobalCHRM;
+  pSave->bHasglobalSRGB       = pData->bHasglobalSRGB;
+  pSave->bHasglobalICCP       = pData->bHasglobalICCP;
+  pSave->bHasglobalBKGD       = pData->bHasglobalBKGD;
 
-                 break;
-               }
-      case 2 : {                       /* rgb */
-                 switch (pData->iBitdepth)
-                 {
-                   case  8 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_rgb8_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_rgb8_i;
-                               break;
-                             }
-#ifndef MNG_NO_16BIT_SUPPORT
-                   case 16 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_rgb16_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_rgb16_i;
+  pSave->iBACKred             = pData->iBACKred;
+  pSave->iBACKgreen           = pData->iBACKgreen;
+  pSave->iBACKblue            = pData->iBACKblue;
+  pSave->iBACKmandatory       = pData->iBACKmandatory;
+  pSave->iBACKimageid         = pData->iBACKimageid;
+  pSave->iBACKtile            = pData->iBACKtile;
 
-                               break;
-                             }
+#ifndef MNG_SKIPCHUNK_FRAM
+  pSave->iFRAMmode            = pData->iFRAMmode;
+  pSave->iFRAMdelay           = pData->iFRAMdelay;
+  pSave->iFRAMtimeout         = pData->iFRAMtimeout;
+  pSave->bFRAMclipping        = pData->bFRAMclipping;
+  pSave->iFRAMclipl           = pData->iFRAMclipl;
+  pSave->iFRAMclipr           = pData->iFRAMclipr;
+  pSave->iFRAMclipt           = pData->iFRAMclipt;
+  pSave->iFRAMclipb           = pData->iFRAMclipb;
 #endif
-                 }
 
-                 break;
-               }
-      case 3 : {                       /* indexed */
-                 switch (pData->iBitdepth)
-                 {
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-                   case  1 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_idx1_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_idx1_i;
-
-                               break;
-                             }
-                   case  2 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_idx2_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_idx2_i;
-
-                               break;
-                             }
-                   case  4 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_idx4_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_idx4_i;
-
-                               break;
-                             }
-#endif /* MNG_NO_1_2_4BIT_SUPPORT */
-                   case  8 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_idx8_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_idx8_i;
-
-                               break;
-                             }
-                 }
+  pSave->iGlobalPLTEcount     = pData->iGlobalPLTEcount;
+  MNG_COPY (pSave->aGlobalPLTEentries, pData->aGlobalPLTEentries, sizeof (mng_rgbpaltab));
 
-                 break;
-               }
-      case 4 : {                       /* gray+alpha */
-                 switch (pData->iBitdepth)
-                 {
-                   case  8 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_ga8_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_ga8_i;
-
-                               break;
-                             }
-#ifndef MNG_NO_16BIT_SUPPORT
-                   case 16 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_ga16_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_ga16_i;
-                               break;
-                             }
-#endif
-                 }
+  pSave->iGlobalTRNSrawlen    = pData->iGlobalTRNSrawlen;
+  MNG_COPY (pSave->aGlobalTRNSrawdata, pData->aGlobalTRNSrawdata, 256);
 
-                 break;
-               }
-      case 6 : {                       /* rgb+alpha */
-                 switch (pData->iBitdepth)
-                 {
-                   case  8 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_rgba8_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_rgba8_i;
-
-                               break;
-                             }
-#ifndef MNG_NO_16BIT_SUPPORT
-                   case 16 : {
-                               if (!pData->iInterlace)
-                                 pData->fInitrowproc = (mng_fptr)mng_init_rgba16_ni;
-                               else
-                                 pData->fInitrowproc = (mng_fptr)mng_init_rgba16_i;
+  pSave->iGlobalGamma         = pData->iGlobalGamma;
 
-                               break;
-                             }
+#ifndef MNG_SKIPCHUNK_cHRM
+  pSave->iGlobalWhitepointx   = pData->iGlobalWhitepointx;
+  pSave->iGlobalWhitepointy   = pData->iGlobalWhitepointy;
+  pSave->iGlobalPrimaryredx   = pData->iGlobalPrimaryredx;
+  pSave->iGlobalPrimaryredy   = pData->iGlobalPrimaryredy;
+  pSave->iGlobalPrimarygreenx = pData->iGlobalPrimarygreenx;
+  pSave->iGlobalPrimarygreeny = pData->iGlobalPrimarygreeny;
+  pSave->iGlobalPrimarybluex  = pData->iGlobalPrimarybluex;
+  pSave->iGlobalPrimarybluey  = pData->iGlobalPrimarybluey;
 #endif
-                 }
-
-                 break;
-               }
-    }
-#endif /* MNG_OPTIMIZE_FOOTPRINT_INIT */
-
-    pData->iFilterofs = 0;             /* determine filter characteristics */
-    pData->iLevel0    = 0;             /* default levels */
-    pData->iLevel1    = 0;    
-    pData->iLevel2    = 0;
-    pData->iLevel3    = 0;
-
-#ifdef FILTER192                       /* leveling & differing ? */
-    if (pData->iFilter == MNG_FILTER_DIFFERING)
-    {
-      switch (pData->iColortype)
-      {
-        case 0 : {
-                   if (pData->iBitdepth <= 8)
-                     pData->iFilterofs = 1;
-                   else
-                     pData->iFilterofs = 2;
-
-                   break;
-                 }
-        case 2 : {
-                   if (pData->iBitdepth <= 8)
-                     pData->iFilterofs = 3;
-                   else
-                     pData->iFilterofs = 6;
 
-                   break;
-                 }
-        case 3 : {
-                   pData->iFilterofs = 1;
-                   break;
-                 }
-        case 4 : {
-                   if (pData->iBitdepth <= 8)
-                     pData->iFilterofs = 2;
-                   else
-                     pData->iFilterofs = 4;
+  pSave->iGlobalRendintent    = pData->iGlobalRendintent;
 
-                   break;
-                 }
-        case 6 : {
-                   if (pData->iBitdepth <= 8)
-                     pData->iFilterofs = 4;
-                   else
-                     pData->iFilterofs = 8;
+  pSave->iGlobalBKGDred       = pData->iGlobalBKGDred;
+  pSave->iGlobalBKGDgreen     = pData->iGlobalBKGDgreen;
+  pSave->iGlobalBKGDblue      = pData->iGlobalBKGDblue;
 
-                   break;
-                 }
-      }
-    }
-#endif
+#ifndef MNG_SKIPCHUNK_iCCP
+  if (pData->iGlobalProfilesize)       /* has a profile ? */
+  {                                    /* then copy that ! */
+    MNG_ALLOCX (pData, pSave->pGlobalProfile, pData->iGlobalProfilesize);
 
-#ifdef FILTER193                       /* no adaptive filtering ? */
-    if (pData->iFilter == MNG_FILTER_NOFILTER)
-      pData->iPixelofs = pData->iFilterofs;
-    else
-#endif    
-      pData->iPixelofs = pData->iFilterofs + 1;
+    if (!pSave->pGlobalProfile)
+      return MNG_FALSE;
 
+    MNG_COPY (pSave->pGlobalProfile, pData->pGlobalProfile, pData->iGlobalProfilesize);
+    pSave->iGlobalProfilesize = pData->iGlobalProfilesize;
+    *piMemsize += pSave->iGlobalProfilesize;
   }
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IHDR, MNG_LC_END);
 #endif
 
-  return MNG_NOERROR;
+  return MNG_TRUE;
 }
 
 /* ************************************************************************** */
 
-#ifdef MNG_INCLUDE_MPNG_PROPOSAL
-mng_retcode mng_process_display_mpng (mng_datap pData)
+MNG_LOCAL void keyframe_restore_globals (mng_datap     pData,
+                                         mng_savedatap pSave,
+                                         mng_ptr       pProfile)
 {
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MPNG, MNG_LC_START);
+  pData->bHasglobalPLTE       = pSave->bHasglobalPLTE;
+  pData->bHasglobalTRNS       = pSave->bHasglobalTRNS;
+  pData->bHasglobalGAMA       = pSave->bHasglobalGAMA;
+  pData->bHasglobalCHRM       = pSave->bHasglobalCHRM;
+  pData->bHasglobalSRGB       = pSave->bHasglobalSRGB;
+  pData->bHasglobalICCP       = pSave->bHasglobalICCP;
+  pData->bHasglobalBKGD       = pSave->bHasglobalBKGD;
+
+  pData->iBACKred             = pSave->iBACKred;
+  pData->iBACKgreen           = pSave->iBACKgreen;
+  pData->iBACKblue            = pSave->iBACKblue;
+  pData->iBACKmandatory       = pSave->iBACKmandatory;
+  pData->iBACKimageid         = pSave->iBACKimageid;
+  pData->iBACKtile            = pSave->iBACKtile;
+
+#ifndef MNG_SKIPCHUNK_FRAM
+  pData->iFRAMmode            = pSave->iFRAMmode;
+  pData->iFRAMdelay           = pSave->iFRAMdelay;
+  pData->iFRAMtimeout         = pSave->iFRAMtimeout;
+  pData->bFRAMclipping        = pSave->bFRAMclipping;
+  pData->iFRAMclipl           = pSave->iFRAMclipl;
+  pData->iFRAMclipr           = pSave->iFRAMclipr;
+  pData->iFRAMclipt           = pSave->iFRAMclipt;
+  pData->iFRAMclipb           = pSave->iFRAMclipb;
 #endif
 
-  pData->iAlphadepth = 8;              /* assume transparency !! */
+  pData->iGlobalPLTEcount     = pSave->iGlobalPLTEcount;
+  MNG_COPY (pData->aGlobalPLTEentries, pSave->aGlobalPLTEentries, sizeof (mng_rgbpaltab));
 
-  if (pData->fProcessheader)           /* inform the app (creating the output canvas) ? */
-  {
-    pData->iWidth  = ((mng_mpng_objp)pData->pMPNG)->iFramewidth;
-    pData->iHeight = ((mng_mpng_objp)pData->pMPNG)->iFrameheight;
+  pData->iGlobalTRNSrawlen    = pSave->iGlobalTRNSrawlen;
+  MNG_COPY (pData->aGlobalTRNSrawdata, pSave->aGlobalTRNSrawdata, 256);
 
-    if (!pData->fProcessheader (((mng_handle)pData), pData->iWidth, pData->iHeight))
-      MNG_ERROR (pData, MNG_APPMISCERROR);
-  }
+  pData->iGlobalGamma         = pSave->iGlobalGamma;
 
-  next_layer (pData);                  /* first mPNG layer then ! */
-  pData->bTimerset   = MNG_FALSE;
-  pData->iBreakpoint = 0;
+#ifndef MNG_SKIPCHUNK_cHRM
+  pData->iGlobalWhitepointx   = pSave->iGlobalWhitepointx;
+  pData->iGlobalWhitepointy   = pSave->iGlobalWhitepointy;
+  pData->iGlobalPrimaryredx   = pSave->iGlobalPrimaryredx;
+  pData->iGlobalPrimaryredy   = pSave->iGlobalPrimaryredy;
+  pData->iGlobalPrimarygreenx = pSave->iGlobalPrimarygreenx;
+  pData->iGlobalPrimarygreeny = pSave->iGlobalPrimarygreeny;
+  pData->iGlobalPrimarybluex  = pSave->iGlobalPrimarybluex;
+  pData->iGlobalPrimarybluey  = pSave->iGlobalPrimarybluey;
+#endif
 
-  if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
-    set_display_routine (pData);       /* then determine display routine */
+  pData->iGlobalRendintent    = pSave->iGlobalRendintent;
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MPNG, MNG_LC_END);
+  pData->iGlobalBKGDred       = pSave->iGlobalBKGDred;
+  pData->iGlobalBKGDgreen     = pSave->iGlobalBKGDgreen;
+  pData->iGlobalBKGDblue      = pSave->iGlobalBKGDblue;
+
+#ifndef MNG_SKIPCHUNK_iCCP
+  if (pData->iGlobalProfilesize)       /* drop the current profile */
+    MNG_FREE (pData, pData->pGlobalProfile, pData->iGlobalProfilesize);
+
+  pData->pGlobalProfile       = pProfile;
+  pData->iGlobalProfilesize   = pSave->iGlobalProfilesize;
 #endif
 
-  return MNG_NOERROR;
+  return;
 }
-#endif
 
 /* ************************************************************************** */
 
-#ifdef MNG_INCLUDE_ANG_PROPOSAL
-mng_retcode mng_process_display_ang (mng_datap pData)
+MNG_LOCAL void keyframe_free (mng_datap     pData,
+                              mng_keyframep pKeyframe)
 {
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_ANG, MNG_LC_START);
-#endif
+  keyframe_free_objects (pData, (mng_imagep)pKeyframe->pObjzero,
+                         (mng_imagep)pKeyframe->pFirstimgobj);
 
-  if (pData->fProcessheader)           /* inform the app (creating the output canvas) ? */
+  if (pKeyframe->pSavedata)
   {
-    if (!pData->fProcessheader (((mng_handle)pData), pData->iWidth, pData->iHeight))
-      MNG_ERROR (pData, MNG_APPMISCERROR);
+    keyframe_free_savedata (pData, pKeyframe->pSavedata);
+    MNG_FREEX (pData, pKeyframe->pSavedata, sizeof (mng_savedata));
   }
 
-  next_layer (pData);                  /* first mPNG layer then ! */
-  pData->bTimerset   = MNG_FALSE;
-  pData->iBreakpoint = 0;
-
-  if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
-    set_display_routine (pData);       /* then determine display routine */
+  keyframe_free_savedata (pData, &pKeyframe->sGlobals);
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_ANG, MNG_LC_END);
-#endif
+  MNG_FREEX (pData, pKeyframe->pLoopcounts, pKeyframe->iLoopcount << 2);
+  MNG_FREEX (pData, pKeyframe->pCanvas, pKeyframe->iCanvasrowsize * pKeyframe->iHeight);
+  MNG_FREEX (pData, pKeyframe->pAlpha, pKeyframe->iWidth * pKeyframe->iHeight);
+  MNG_FREEX (pData, pKeyframe, sizeof (mng_keyframe));
 
-  return MNG_NOERROR;
+  return;
 }
-#endif
 
 /* ************************************************************************** */
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_idat (mng_datap  pData,
-                                      mng_uint32 iRawlen,
-                                      mng_uint8p pRawdata)
-#else
-mng_retcode mng_process_display_idat (mng_datap  pData)
-#endif
+MNG_LOCAL void keyframe_unlink (mng_datap     pData,
+                                mng_keyframep pKeyframe)
 {
-  mng_retcode iRetcode = MNG_NOERROR;
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IDAT, MNG_LC_START);
-#endif
+  mng_keyframep pPrev = pData->pFirstkeyframe;
 
-#if defined(MNG_INCLUDE_MPNG_PROPOSAL) || defined(MNG_INCLUDE_ANG_PROPOSAL) 
-  if ((pData->eImagetype == mng_it_png) && (pData->iLayerseq <= 0))
+  if (pPrev == pKeyframe)
+    pData->pFirstkeyframe = pKeyframe->pNext;
+  else
   {
-    if (pData->fProcessheader)         /* inform the app (creating the output canvas) ? */
-      if (!pData->fProcessheader (((mng_handle)pData), pData->iWidth, pData->iHeight))
-        MNG_ERROR (pData, MNG_APPMISCERROR);
+    while (pPrev->pNext != pKeyframe)
+      pPrev = pPrev->pNext;
 
-    next_layer (pData);                /* first regular PNG layer then ! */
-    pData->bTimerset   = MNG_FALSE;
-    pData->iBreakpoint = 0;
-
-    if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
-      set_display_routine (pData);     /* then determine display routine */
+    pPrev->pNext = pKeyframe->pNext;
   }
-#endif
 
-  if (pData->bRestorebkgd)             /* need to restore the background ? */
-  {
-    pData->bRestorebkgd = MNG_FALSE;
-    iRetcode            = load_bkgdlayer (pData);
+  pData->iKeyframecount--;
+  pData->iKeyframememory -= pKeyframe->iMemsize;
 
-    if (iRetcode)                      /* on error bail out */
-      return iRetcode;
+  keyframe_free (pData, pKeyframe);
 
-    pData->iLayerseq++;                /* and it counts as a layer then ! */
-  }
+  return;
+}
 
-  if (pData->fInitrowproc)             /* need to initialize row processing? */
-  {
-    iRetcode = ((mng_initrowproc)pData->fInitrowproc) (pData);
-    pData->fInitrowproc = MNG_NULL;    /* only call this once !!! */
-  }
+/* ************************************************************************** */
 
-  if ((!iRetcode) && (!pData->bInflating))
-                                       /* initialize inflate */
-    iRetcode = mngzlib_inflateinit (pData);
+MNG_LOCAL void keyframe_thin (mng_datap pData)
+{                                      /* keep the first one of each interval */
+  mng_keyframep pKeyframe = pData->pFirstkeyframe;
+  mng_keyframep pNext;
 
-  if (!iRetcode)                       /* all ok? then inflate, my man */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-    iRetcode = mngzlib_inflaterows (pData, iRawlen, pRawdata);
-#else
-    iRetcode = mngzlib_inflaterows (pData, pData->iRawlen, pData->pRawdata);
-#endif
+  while ((pKeyframe) && (pKeyframe->pNext))
+  {
+    pNext = pKeyframe->pNext;
 
-  if (iRetcode)                        /* on error bail out */
-    return iRetcode;
-    
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IDAT, MNG_LC_END);
-#endif
+    if ((pNext->iFrameseq / pData->iKeyframeinterval) ==
+        (pKeyframe->iFrameseq / pData->iKeyframeinterval))
+      keyframe_unlink (pData, pNext);
+    else
+      pKeyframe = pNext;
+  }
 
-  return MNG_NOERROR;
+  return;
 }
 
 /* ************************************************************************** */
 
-mng_retcode mng_process_display_iend (mng_datap pData)
+MNG_LOCAL void keyframe_insert (mng_datap     pData,
+                                mng_keyframep pKeyframe)
 {
-  mng_retcode iRetcode, iRetcode2;
-  mng_bool bDodisplay = MNG_FALSE;
-  mng_bool bMagnify   = MNG_FALSE;
-  mng_bool bCleanup   = (mng_bool)(pData->iBreakpoint != 0);
+  mng_keyframep pPrev = MNG_NULL;
+  mng_keyframep pNext;
+                                       /* make room within the limit */
+  while ((pData->iKeyframemaxmem) && (pData->pFirstkeyframe) &&
+         (pData->iKeyframememory + pKeyframe->iMemsize > pData->iKeyframemaxmem))
+  {
+    if ((pData->pFirstkeyframe->pNext) && (pData->iKeyframeinterval < 0x80000000L))
+    {                                  /* spread them out */
+      pData->iKeyframeinterval <<= 1;
+      keyframe_thin (pData);
+    }
+    else                               /* or drop the last one standing */
+      keyframe_unlink (pData, pData->pFirstkeyframe);
+  }
+                                       /* too big by itself ? */
+  if ((pData->iKeyframemaxmem) && (pKeyframe->iMemsize > pData->iKeyframemaxmem))
+  {
+    keyframe_free (pData, pKeyframe);
+    return;
+  }
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IEND, MNG_LC_START);
-#endif
+  pNext = pData->pFirstkeyframe;       /* find its place */
 
-#ifdef MNG_INCLUDE_JNG                 /* progressive+alpha JNG can be displayed now */
-  if ( (pData->bHasJHDR                                         ) &&
-       ( (pData->bJPEGprogressive) || (pData->bJPEGprogressive2)) &&
-       ( (pData->eImagetype == mng_it_jng         ) ||
-         (((mng_imagep)pData->pStoreobj)->bVisible)             ) &&
-       ( (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGGRAYA ) ||
-         (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGCOLORA)    )    )
-    bDodisplay = MNG_TRUE;
-#endif
+  while ((pNext) && (pNext->iFrameseq < pKeyframe->iFrameseq))
+  {
+    pPrev = pNext;
+    pNext = pNext->pNext;
+  }
+                                       /* interval already covered ? */
+  if ((pPrev) && ((pPrev->iFrameseq / pData->iKeyframeinterval) ==
+                  (pKeyframe->iFrameseq / pData->iKeyframeinterval)))
+  {
+    keyframe_free (pData, pKeyframe);
+    return;
+  }
 
-#ifndef MNG_SKIPCHUNK_MAGN
-  if ( (pData->pStoreobj) &&           /* on-the-fly magnification ? */
-       ( (((mng_imagep)pData->pStoreobj)->iMAGN_MethodX) ||
-         (((mng_imagep)pData->pStoreobj)->iMAGN_MethodY)    ) )
-    bMagnify = MNG_TRUE;
-#endif
+  pKeyframe->pNext = pNext;            /* link it in */
 
-  if ((pData->bHasBASI) ||             /* was it a BASI stream */
-      (bDodisplay)      ||             /* or should we display the JNG */
-#ifndef MNG_SKIPCHUNK_MAGN
-      (bMagnify)        ||             /* or should we magnify it */
+  if (pPrev)
+    pPrev->pNext = pKeyframe;
+  else
+    pData->pFirstkeyframe = pKeyframe;
+
+  pData->iKeyframecount++;
+  pData->iKeyframememory += pKeyframe->iMemsize;
+                                       /* a later one in the same interval is redundant */
+  if ((pNext) && ((pNext->iFrameseq / pData->iKeyframeinterval) ==
+                  (pKeyframe->iFrameseq / pData->iKeyframeinterval)))
+    keyframe_unlink (pData, pNext);
+
+  return;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_store_keyframe (mng_datap pData)
+{
+  mng_keyframep pKeyframe;
+  mng_uint32    iPixelsize;
+  mng_uint32    iInterval = pData->iKeyframeinterval;
+  mng_uint32    iY;
+  mng_uint8p    pLine;
+  mng_imagep    pLast;
+  mng_bool      bOk;
+#ifndef MNG_SKIPCHUNK_LOOP
+  mng_objectp   pObject;
+  mng_uint32    iX;
+#endif
+                                       /* only at a quiet point of a complete animation */
+  if ((pData->eImagetype != mng_it_mng) || (pData->bReading) ||
+      (!pData->bCacheplayback) || (!pData->pCurraniobj) ||
+      (pData->iBreakpoint) || (pData->bTimerset) || (pData->bSectionwait) ||
+      (pData->bFreezing) || (pData->bHasDHDR) || (!pData->fGetcanvasline))
+    return MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_DYNAMICMNG
+  if (pData->bDynamic)                 /* events make the playback unpredictable */
+    return MNG_NOERROR;
 #endif
-                                       /* or did we get broken here last time ? */
-      ((pData->iBreakpoint) && (pData->iBreakpoint != 8)))
-  {
-    mng_imagep pImage = (mng_imagep)pData->pCurrentobj;
 
-    if (!pImage)                       /* or was it object 0 ? */
-      pImage = (mng_imagep)pData->pObjzero;
-                                       /* display it now then ? */
-    if ((pImage->bVisible) && (pImage->bViewable))
-    {                                  /* ok, so do it */
-      iRetcode = mng_display_image (pData, pImage, bDodisplay);
+  iPixelsize = keyframe_pixelsize (pData->iCanvasstyle);
 
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
+  if ((!iPixelsize) || (!pData->iWidth) || (!pData->iHeight) ||
+      ((MNG_CANVAS_ALPHASEPD (pData->iCanvasstyle)) && (!pData->fGetalphaline)))
+    return MNG_NOERROR;
+                                       /* next one is due at the next interval */
+  pData->iKeyframenext = (pData->iFrameseq / iInterval + 1) * iInterval;
 
-      if (pData->bTimerset)            /* timer break ? */
-        pData->iBreakpoint = 6;
-    }
+  pKeyframe = pData->pFirstkeyframe;   /* got this interval already ? */
+
+  while ((pKeyframe) && (pKeyframe->iFrameseq / iInterval != pData->iFrameseq / iInterval))
+    pKeyframe = pKeyframe->pNext;
+
+  if (pKeyframe)
+    return MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_STORE_KEYFRAME, MNG_LC_START);
+#endif
+                                       /* failing to get memory isn't fatal here */
+  MNG_ALLOCX (pData, pKeyframe, sizeof (mng_keyframe));
+
+  if (!pKeyframe)
+    return MNG_NOERROR;
+
+  pKeyframe->iMemsize       = sizeof (mng_keyframe);
+  pKeyframe->iCanvasstyle   = pData->iCanvasstyle;
+  pKeyframe->iWidth         = pData->iWidth;
+  pKeyframe->iHeight        = pData->iHeight;
+  pKeyframe->iCanvasrowsize = pData->iWidth * iPixelsize;
+                                       /* copy the objects */
+  bOk = keyframe_copy_objects (pData, (mng_imagep)pData->pObjzero,
+                               (mng_imagep)pData->pFirstimgobj,
+                               (mng_imagep *)&pKeyframe->pObjzero,
+                               (mng_imagep *)&pKeyframe->pFirstimgobj,
+                               &pLast,
+                               &pKeyframe->iMemsize);
+
+  if ((bOk) && (pData->pSavedata))     /* the SAVE state */
+  {
+    pKeyframe->pSavedata = keyframe_copy_savedata (pData, pData->pSavedata,
+                                                   &pKeyframe->iMemsize);
+    bOk = (mng_bool)(pKeyframe->pSavedata != MNG_NULL);
   }
-#ifndef MNG_NO_DELTA_PNG
-  else
-  if ((pData->bHasDHDR) ||             /* was it a DHDR stream */
-      (pData->iBreakpoint == 8))       /* or did we get broken here last time ? */
+
+  if (bOk)                             /* the global chunk data */
+    bOk = keyframe_save_globals (pData, &pKeyframe->sGlobals, &pKeyframe->iMemsize);
+
+#ifndef MNG_SKIPCHUNK_LOOP
+  if (bOk)                             /* the LOOP counters */
   {
-    mng_imagep pImage = (mng_imagep)pData->pDeltaImage;
+    pObject = pData->pFirstaniobj;
 
-    if (!pData->iBreakpoint)
-    {                                  /* perform the delta operations needed */
-      iRetcode = mng_execute_delta_image (pData, pImage, (mng_imagep)pData->pObjzero);
+    while (pObject)
+    {
+      if (((mng_object_headerp)pObject)->fProcess == (mng_processobject)mng_process_ani_loop)
+        pKeyframe->iLoopcount++;
 
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
+      pObject = ((mng_object_headerp)pObject)->pNext;
     }
-                                       /* display it now then ? */
-    if ((pImage->bVisible) && (pImage->bViewable))
-    {                                  /* ok, so do it */
-      iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
 
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
+    if (pKeyframe->iLoopcount)
+    {
+      MNG_ALLOCX (pData, pKeyframe->pLoopcounts, pKeyframe->iLoopcount << 2);
 
-      if (pData->bTimerset)            /* timer break ? */
-        pData->iBreakpoint = 8;
+      if (pKeyframe->pLoopcounts)
+      {
+        pObject = pData->pFirstaniobj;
+        iX      = 0;
+
+        while (pObject)
+        {
+          if (((mng_object_headerp)pObject)->fProcess == (mng_processobject)mng_process_ani_loop)
+            pKeyframe->pLoopcounts [iX++] = ((mng_ani_loopp)pObject)->iRunningcount;
+
+          pObject = ((mng_object_headerp)pObject)->pNext;
+        }
+
+        pKeyframe->iMemsize += pKeyframe->iLoopcount << 2;
+      }
+      else
+        bOk = MNG_FALSE;
     }
   }
 #endif
 
-  if (!pData->bTimerset)               /* can we continue ? */
+  if (bOk)                             /* and finally the canvas */
   {
-    pData->iBreakpoint = 0;            /* clear this flag now ! */
+    MNG_ALLOCX (pData, pKeyframe->pCanvas, pKeyframe->iCanvasrowsize * pKeyframe->iHeight);
 
+    if (MNG_CANVAS_ALPHASEPD (pData->iCanvasstyle))
+      MNG_ALLOCX (pData, pKeyframe->pAlpha, pKeyframe->iWidth * pKeyframe->iHeight);
 
-#ifdef MNG_INCLUDE_MPNG_PROPOSAL
-    if (pData->eImagetype == mng_it_mpng)
-    {
-      pData->pCurraniobj = pData->pFirstaniobj;
-    } else
-#endif
-#ifdef MNG_INCLUDE_ANG_PROPOSAL
-    if (pData->eImagetype == mng_it_ang)
-    {
-      pData->pCurraniobj = pData->pFirstaniobj;
-    } else
-#endif
-    {                                  /* cleanup object 0 */
-      mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
-                                0, 0, 0, 0, 0, 0, 0, MNG_TRUE);
-    }
+    bOk = (mng_bool)((pKeyframe->pCanvas) &&
+                     ((pKeyframe->pAlpha) || (!MNG_CANVAS_ALPHASEPD (pData->iCanvasstyle))));
+  }
 
-    if (pData->bInflating)             /* if we've been inflating */
-    {                                  /* cleanup row-processing, */
-      iRetcode  = mng_cleanup_rowproc (pData);
-                                       /* also cleanup inflate! */
-      iRetcode2 = mngzlib_inflatefree (pData);
+  if (!bOk)                            /* out of memory; just forget about it */
+  {
+    keyframe_free (pData, pKeyframe);
+    return MNG_NOERROR;
+  }
 
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
-      if (iRetcode2)
-        return iRetcode2;
+  for (iY = 0; iY < pKeyframe->iHeight; iY++)
+  {
+    pLine = (mng_uint8p)pData->fGetcanvasline (((mng_handle)pData), iY);
+    MNG_COPY (pKeyframe->pCanvas + iY * pKeyframe->iCanvasrowsize, pLine,
+              pKeyframe->iCanvasrowsize);
+
+    if (pKeyframe->pAlpha)
+    {
+      pLine = (mng_uint8p)pData->fGetalphaline (((mng_handle)pData), iY);
+      MNG_COPY (pKeyframe->pAlpha + iY * pKeyframe->iWidth, pLine, pKeyframe->iWidth);
     }
+  }
 
-#ifdef MNG_INCLUDE_JNG
-    if (pData->bJPEGdecompress)        /* if we've been decompressing JDAT */
-    {                                  /* cleanup row-processing, */
-      iRetcode  = mng_cleanup_rowproc (pData);
-                                       /* also cleanup decompress! */
-      iRetcode2 = mngjpeg_decompressfree (pData);
+  pKeyframe->iMemsize += pKeyframe->iCanvasrowsize * pKeyframe->iHeight;
+
+  if (pKeyframe->pAlpha)
+    pKeyframe->iMemsize += pKeyframe->iWidth * pKeyframe->iHeight;
+                                       /* now the playback state */
+  pKeyframe->iCurrentobj       = keyframe_objindex (pData, pData->pCurrentobj);
+  pKeyframe->iLastclone        = keyframe_objindex (pData, pData->pLastclone);
+  pKeyframe->iDeltaImage       = keyframe_objindex (pData, pData->pDeltaImage);
+
+  pKeyframe->pCurraniobj       = pData->pCurraniobj;
+  pKeyframe->pLastseek         = pData->pLastseek;
+  pKeyframe->bFramedone        = pData->bFramedone;
+  pKeyframe->iFrameseq         = pData->iFrameseq;
+  pKeyframe->iLayerseq         = pData->iLayerseq;
+  pKeyframe->iFrametime        = pData->iFrametime;
+  pKeyframe->bSkipping         = pData->bSkipping;
+  pKeyframe->bRestorebkgd      = pData->bRestorebkgd;
+  pKeyframe->bNeedrefresh      = pData->bNeedrefresh;
+  pKeyframe->bMisplacedTERM    = pData->bMisplacedTERM;
+  pKeyframe->bOnlyfirstframe   = pData->bOnlyfirstframe;
+  pKeyframe->iFramesafterTERM  = pData->iFramesafterTERM;
+  pKeyframe->iIterations       = pData->iIterations;
+  pKeyframe->iUpdateleft       = pData->iUpdateleft;
+  pKeyframe->iUpdateright      = pData->iUpdateright;
+  pKeyframe->iUpdatetop        = pData->iUpdatetop;
+  pKeyframe->iUpdatebottom     = pData->iUpdatebottom;
+  pKeyframe->iPLTEcount        = pData->iPLTEcount;
+
+  pKeyframe->iDEFIobjectid     = pData->iDEFIobjectid;
+  pKeyframe->bDEFIhasdonotshow = pData->bDEFIhasdonotshow;
+  pKeyframe->iDEFIdonotshow    = pData->iDEFIdonotshow;
+  pKeyframe->bDEFIhasconcrete  = pData->bDEFIhasconcrete;
+  pKeyframe->iDEFIconcrete     = pData->iDEFIconcrete;
+  pKeyframe->bDEFIhasloca      = pData->bDEFIhasloca;
+  pKeyframe->iDEFIlocax        = pData->iDEFIlocax;
+  pKeyframe->iDEFIlocay        = pData->iDEFIlocay;
+  pKeyframe->bDEFIhasclip      = pData->bDEFIhasclip;
+  pKeyframe->iDEFIclipl        = pData->iDEFIclipl;
+  pKeyframe->iDEFIclipr        = pData->iDEFIclipr;
+  pKeyframe->iDEFIclipt        = pData->iDEFIclipt;
+  pKeyframe->iDEFIclipb        = pData->iDEFIclipb;
 
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
-      if (iRetcode2)
-        return iRetcode2;
-    }
+#ifndef MNG_SKIPCHUNK_FRAM
+  pKeyframe->iFramemode        = pData->iFramemode;
+  pKeyframe->iFramedelay       = pData->iFramedelay;
+  pKeyframe->iFrametimeout     = pData->iFrametimeout;
+  pKeyframe->bFrameclipping    = pData->bFrameclipping;
+  pKeyframe->iFrameclipl       = pData->iFrameclipl;
+  pKeyframe->iFrameclipr       = pData->iFrameclipr;
+  pKeyframe->iFrameclipt       = pData->iFrameclipt;
+  pKeyframe->iFrameclipb       = pData->iFrameclipb;
+  pKeyframe->iNextdelay        = pData->iNextdelay;
+  pKeyframe->bForcedelay       = pData->bForcedelay;
+  pKeyframe->iAccumdelay       = pData->iAccumdelay;
+#endif
 
-    if (pData->bJPEGdecompress2)       /* if we've been decompressing JDAA */
-    {                                  /* cleanup row-processing, */
-      iRetcode  = mng_cleanup_rowproc (pData);
-                                       /* also cleanup decompress! */
-      iRetcode2 = mngjpeg_decompressfree2 (pData);
+#ifndef MNG_SKIPCHUNK_SHOW
+  pKeyframe->iSHOWmode         = pData->iSHOWmode;
+  pKeyframe->iSHOWfromid       = pData->iSHOWfromid;
+  pKeyframe->iSHOWtoid         = pData->iSHOWtoid;
+  pKeyframe->iSHOWnextid       = pData->iSHOWnextid;
+  pKeyframe->iSHOWskip         = pData->iSHOWskip;
+#endif
 
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
-      if (iRetcode2)
-        return iRetcode2;
-    }
+  pKeyframe->iDeltaImagetype   = pData->iDeltaImagetype;
+  pKeyframe->iDeltatype        = pData->iDeltatype;
+  pKeyframe->iDeltaBlockwidth  = pData->iDeltaBlockwidth;
+  pKeyframe->iDeltaBlockheight = pData->iDeltaBlockheight;
+  pKeyframe->iDeltaBlockx      = pData->iDeltaBlockx;
+  pKeyframe->iDeltaBlocky      = pData->iDeltaBlocky;
+  pKeyframe->bDeltaimmediate   = pData->bDeltaimmediate;
+
+#ifndef MNG_SKIPCHUNK_MAGN
+  pKeyframe->iMAGNfromid       = pData->iMAGNfromid;
+  pKeyframe->iMAGNcurrentid    = pData->iMAGNcurrentid;
+  pKeyframe->iMAGNtoid         = pData->iMAGNtoid;
 #endif
 
-    if (bCleanup)                      /* if we got broken last time we need to cleanup */
-    {
-      pData->bHasIHDR = MNG_FALSE;     /* IEND signals the end for most ... */
-      pData->bHasBASI = MNG_FALSE;
-      pData->bHasDHDR = MNG_FALSE;
-#ifdef MNG_INCLUDE_JNG
-      pData->bHasJHDR = MNG_FALSE;
-      pData->bHasJSEP = MNG_FALSE;
-      pData->bHasJDAA = MNG_FALSE;
-      pData->bHasJDAT = MNG_FALSE;
+#ifndef MNG_SKIPCHUNK_PAST
+  pKeyframe->iPASTid           = pData->iPASTid;
+  pKeyframe->iPastx            = pData->iPastx;
+  pKeyframe->iPasty            = pData->iPasty;
 #endif
-      pData->bHasPLTE = MNG_FALSE;
-      pData->bHasTRNS = MNG_FALSE;
-      pData->bHasGAMA = MNG_FALSE;
-      pData->bHasCHRM = MNG_FALSE;
-      pData->bHasSRGB = MNG_FALSE;
-      pData->bHasICCP = MNG_FALSE;
-      pData->bHasBKGD = MNG_FALSE;
-      pData->bHasIDAT = MNG_FALSE;
-    }
-                                       /* if the image was displayed on the fly, */
-                                       /* we'll have to make the app refresh */
-    if ((pData->eImagetype != mng_it_mng) && (pData->fDisplayrow))
-      pData->bNeedrefresh = MNG_TRUE;
-     
-  }
+
+  keyframe_insert (pData, pKeyframe);  /* and add it to the list */
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IEND, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_STORE_KEYFRAME, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
@@ -3335,199 +3779,234 @@ mng_retcode mng_process_display_iend (mng_datap pData)
 
 /* ************************************************************************** */
 
-/* change in the MNG spec with regards to TERM delay & interframe_delay
-   as proposed by Adam M. Costello (option 4) and finalized by official vote
-   during december 2002 / check the 'mng-list' archives for more details */
+mng_keyframep mng_find_keyframe (mng_datap  pData,
+                                 mng_uint32 iFramenr,
+                                 mng_uint32 iLayernr,
+                                 mng_uint32 iPlaytime)
+{
+  mng_keyframep pKeyframe = pData->pFirstkeyframe;
+  mng_keyframep pFound    = MNG_NULL;
+
+  if ((!iFramenr) && (!iLayernr) && (!iPlaytime))
+    return MNG_NULL;
+                                       /* the last one before the target */
+  while ((pKeyframe) &&
+         ((!iFramenr)  || (pKeyframe->iFrameseq  < iFramenr )) &&
+         ((!iLayernr)  || (pKeyframe->iLayerseq  < iLayernr )) &&
+         ((!iPlaytime) || (pKeyframe->iFrametime < iPlaytime)))
+  {                                    /* taken from the same canvas ? */
+    if ((pKeyframe->iCanvasstyle == pData->iCanvasstyle) &&
+        (pKeyframe->iWidth       == pData->iWidth      ) &&
+        (pKeyframe->iHeight      == pData->iHeight     )    )
+      pFound = pKeyframe;
+
+    pKeyframe = pKeyframe->pNext;
+  }
 
-mng_retcode mng_process_display_mend (mng_datap pData)
+  return pFound;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_restore_keyframe (mng_datap     pData,
+                                  mng_keyframep pKeyframe)
 {
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MEND, MNG_LC_START);
+  mng_imagep  pZero;
+  mng_imagep  pFirst;
+  mng_imagep  pLast;
+  mng_uint32  iMemsize = 0;
+  mng_uint32  iY;
+  mng_uint8p  pLine;
+  mng_savedatap pSavedata = MNG_NULL;
+  mng_ptr     pProfile    = MNG_NULL;
+#ifndef MNG_SKIPCHUNK_LOOP
+  mng_objectp pObject;
+  mng_uint32  iX;
 #endif
 
-  pData->bForcedelay = pData->iAccumdelay ? MNG_FALSE : MNG_TRUE;
-  pData->iAccumdelay = 0;
-
-#ifdef MNG_SUPPORT_DYNAMICMNG
-  if (pData->bStopafterseek)           /* need to stop after this ? */
-  {
-    pData->bFreezing      = MNG_TRUE;  /* stop processing on this one */
-    pData->bRunningevent  = MNG_FALSE;
-    pData->bStopafterseek = MNG_FALSE;
-    pData->bNeedrefresh   = MNG_TRUE;  /* make sure the last bit is displayed ! */
-  }
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_RESTORE_KEYFRAME, MNG_LC_START);
 #endif
+                                       /* copy everything that needs memory first;
+                                          running out leaves the current state be */
+  if (!keyframe_copy_objects (pData, (mng_imagep)pKeyframe->pObjzero,
+                              (mng_imagep)pKeyframe->pFirstimgobj,
+                              &pZero, &pFirst, &pLast, &iMemsize))
+    MNG_ERROR (pData, MNG_OUTOFMEMORY);
 
-#ifndef MNG_SKIPCHUNK_TERM
-                                       /* TERM processed ? */
-  if ((pData->bDisplaying) && (pData->bRunning) &&
-      (pData->bHasTERM) && (pData->pTermaniobj))
+  if (pKeyframe->pSavedata)            /* the SAVE state */
   {
-    mng_retcode   iRetcode;
-    mng_ani_termp pTERM;
-                                       /* get the right animation object ! */
-    pTERM = (mng_ani_termp)pData->pTermaniobj;
+    pSavedata = keyframe_copy_savedata (pData, pKeyframe->pSavedata, &iMemsize);
 
-    pData->iIterations++;              /* increase iteration count */
+    if (!pSavedata)
+    {
+      keyframe_free_objects (pData, pZero, pFirst);
+      MNG_ERROR (pData, MNG_OUTOFMEMORY);
+    }
+  }
 
-    switch (pTERM->iTermaction)        /* determine what to do! */
+#ifndef MNG_SKIPCHUNK_iCCP
+  if (pKeyframe->sGlobals.iGlobalProfilesize)
+  {                                    /* the global ICC profile */
+    MNG_ALLOCX (pData, pProfile, pKeyframe->sGlobals.iGlobalProfilesize);
+
+    if (!pProfile)
     {
-      case 0 : {                       /* show last frame indefinitly */
-                 break;                /* piece of cake, that is... */
-               }
+      if (pSavedata)
+      {
+        keyframe_free_savedata (pData, pSavedata);
+        MNG_FREEX (pData, pSavedata, sizeof (mng_savedata));
+      }
 
-      case 1 : {                       /* cease displaying anything */
-                                       /* max(1, TERM delay, interframe_delay) */
-#ifndef MNG_SKIPCHUNK_FRAM
-                 if (pTERM->iDelay > pData->iFramedelay)
-                   pData->iFramedelay = pTERM->iDelay;
-                 if (!pData->iFramedelay)
-                   pData->iFramedelay = 1;
+      keyframe_free_objects (pData, pZero, pFirst);
+      MNG_ERROR (pData, MNG_OUTOFMEMORY);
+    }
+
+    MNG_COPY (pProfile, pKeyframe->sGlobals.pGlobalProfile,
+              pKeyframe->sGlobals.iGlobalProfilesize);
+  }
 #endif
+                                       /* now replace the current objects */
+  while (pData->pFirstimgobj)
+    mng_free_imageobject (pData, (mng_imagep)pData->pFirstimgobj);
 
-                 iRetcode = interframe_delay (pData);
-                                       /* no interframe_delay? then fake it */
-                 if ((!iRetcode) && (!pData->bTimerset))
-                   iRetcode = set_delay (pData, 1);
+  mng_free_imageobject (pData, (mng_imagep)pData->pObjzero);
 
-                 if (iRetcode)
-                   return iRetcode;
+  pData->pObjzero     = pZero;
+  pData->pFirstimgobj = pFirst;
+  pData->pLastimgobj  = pLast;
 
-                 pData->iBreakpoint = 10;
-                 break;
-               }
+  mng_reindex_imageobjects (pData);
 
-      case 2 : {                       /* show first image after TERM */
-                 iRetcode = restore_state (pData);
+  pData->pCurrentobj  = keyframe_objpointer (pData, pKeyframe->iCurrentobj);
+  pData->pLastclone   = keyframe_objpointer (pData, pKeyframe->iLastclone);
+  pData->pDeltaImage  = keyframe_objpointer (pData, pKeyframe->iDeltaImage);
 
-                 if (iRetcode)         /* on error bail out */
-                   return iRetcode;
-                                       /* notify the app ? */
-                 if (pData->fProcessmend)
-                   if (!pData->fProcessmend ((mng_handle)pData, pData->iIterations, 0))
-                     MNG_ERROR (pData, MNG_APPMISCERROR);
+  if (pData->pSavedata)                /* replace the SAVE state */
+  {
+    keyframe_free_savedata (pData, pData->pSavedata);
+    MNG_FREE (pData, pData->pSavedata, sizeof (mng_savedata));
+  }
 
-                                       /* show first frame after TERM chunk */
-                 pData->pCurraniobj      = pTERM;
-                 pData->bOnlyfirstframe  = MNG_TRUE;
-                 pData->iFramesafterTERM = 0;
-
-                                       /* max(1, TERM delay, interframe_delay) */
-#ifndef MNG_SKIPCHUNK_FRAM
-                 if (pTERM->iDelay > pData->iFramedelay)
-                   pData->iFramedelay = pTERM->iDelay;
-                 if (!pData->iFramedelay)
-                   pData->iFramedelay = 1;
-#endif
-
-                 break;
-               }
-
-      case 3 : {                       /* repeat */
-                 if ((pTERM->iItermax) && (pTERM->iItermax < 0x7FFFFFFF))
-                   pTERM->iItermax--;
-
-                 if (pTERM->iItermax)  /* go back to TERM ? */
-                 {                     /* restore to initial or SAVE state */
-                   iRetcode = restore_state (pData);
+  pData->pSavedata = pSavedata;
+                                       /* the global chunk data */
+  keyframe_restore_globals (pData, &pKeyframe->sGlobals, pProfile);
 
-                   if (iRetcode)       /* on error bail out */
-                     return iRetcode;
-                                       /* notify the app ? */
-                   if (pData->fProcessmend)
-                     if (!pData->fProcessmend ((mng_handle)pData,
-                                               pData->iIterations, pTERM->iItermax))
-                       MNG_ERROR (pData, MNG_APPMISCERROR);
+#ifndef MNG_SKIPCHUNK_LOOP
+  pObject = pData->pFirstaniobj;       /* the LOOP counters */
+  iX      = 0;
 
-                                       /* restart from TERM chunk */
-                   pData->pCurraniobj = pTERM;
+  while ((pObject) && (iX < pKeyframe->iLoopcount))
+  {
+    if (((mng_object_headerp)pObject)->fProcess == (mng_processobject)mng_process_ani_loop)
+      ((mng_ani_loopp)pObject)->iRunningcount = pKeyframe->pLoopcounts [iX++];
 
-                   if (pTERM->iDelay)  /* set the delay (?) */
-                   {
-                                       /* max(1, TERM delay, interframe_delay) */
-#ifndef MNG_SKIPCHUNK_FRAM
-                     if (pTERM->iDelay > pData->iFramedelay)
-                       pData->iFramedelay = pTERM->iDelay;
-                     if (!pData->iFramedelay)
-                       pData->iFramedelay = 1;
+    pObject = ((mng_object_headerp)pObject)->pNext;
+  }
 #endif
+                                       /* the playback state */
+  pData->pCurraniobj       = pKeyframe->pCurraniobj;
+  pData->pLastseek         = pKeyframe->pLastseek;
+  pData->bFramedone        = pKeyframe->bFramedone;
+  pData->iFrameseq         = pKeyframe->iFrameseq;
+  pData->iLayerseq         = pKeyframe->iLayerseq;
+  pData->iFrametime        = pKeyframe->iFrametime;
+  pData->bSkipping         = pKeyframe->bSkipping;
+  pData->bRestorebkgd      = pKeyframe->bRestorebkgd;
+  pData->bMisplacedTERM    = pKeyframe->bMisplacedTERM;
+  pData->bOnlyfirstframe   = pKeyframe->bOnlyfirstframe;
+  pData->iFramesafterTERM  = pKeyframe->iFramesafterTERM;
+  pData->iIterations       = pKeyframe->iIterations;
+  pData->iPLTEcount        = pKeyframe->iPLTEcount;
+
+  pData->iDEFIobjectid     = pKeyframe->iDEFIobjectid;
+  pData->bDEFIhasdonotshow = pKeyframe->bDEFIhasdonotshow;
+  pData->iDEFIdonotshow    = pKeyframe->iDEFIdonotshow;
+  pData->bDEFIhasconcrete  = pKeyframe->bDEFIhasconcrete;
+  pData->iDEFIconcrete     = pKeyframe->iDEFIconcrete;
+  pData->bDEFIhasloca      = pKeyframe->bDEFIhasloca;
+  pData->iDEFIlocax        = pKeyframe->iDEFIlocax;
+  pData->iDEFIlocay        = pKeyframe->iDEFIlocay;
+  pData->bDEFIhasclip      = pKeyframe->bDEFIhasclip;
+  pData->iDEFIclipl        = pKeyframe->iDEFIclipl;
+  pData->iDEFIclipr        = pKeyframe->iDEFIclipr;
+  pData->iDEFIclipt        = pKeyframe->iDEFIclipt;
+  pData->iDEFIclipb        = pKeyframe->iDEFIclipb;
 
-                     pData->bNeedrefresh = MNG_TRUE;
-                   }
-                 }
-                 else
-                 {
-                   switch (pTERM->iIteraction)
-                   {
-                     case 0 : {        /* show last frame indefinitly */
-                                break; /* piece of cake, that is... */
-                              }
-
-                     case 1 : {        /* cease displaying anything */
-                                       /* max(1, TERM delay, interframe_delay) */
 #ifndef MNG_SKIPCHUNK_FRAM
-                                if (pTERM->iDelay > pData->iFramedelay)
-                                  pData->iFramedelay = pTERM->iDelay;
-                                if (!pData->iFramedelay)
-                                  pData->iFramedelay = 1;
+  pData->iFramemode        = pKeyframe->iFramemode;
+  pData->iFramedelay       = pKeyframe->iFramedelay;
+  pData->iFrametimeout     = pKeyframe->iFrametimeout;
+  pData->bFrameclipping    = pKeyframe->bFrameclipping;
+  pData->iFrameclipl       = pKeyframe->iFrameclipl;
+  pData->iFrameclipr       = pKeyframe->iFrameclipr;
+  pData->iFrameclipt       = pKeyframe->iFrameclipt;
+  pData->iFrameclipb       = pKeyframe->iFrameclipb;
+  pData->iNextdelay        = pKeyframe->iNextdelay;
+  pData->bForcedelay       = pKeyframe->bForcedelay;
+  pData->iAccumdelay       = pKeyframe->iAccumdelay;
 #endif
 
-                                iRetcode = interframe_delay (pData);
-                                       /* no interframe_delay? then fake it */
-                                if ((!iRetcode) && (!pData->bTimerset))
-                                  iRetcode = set_delay (pData, 1);
-
-                                if (iRetcode)
-                                  return iRetcode;
-
-                                pData->iBreakpoint = 10;
-                                break;
-                              }
+#ifndef MNG_SKIPCHUNK_SHOW
+  pData->iSHOWmode         = pKeyframe->iSHOWmode;
+  pData->iSHOWfromid       = pKeyframe->iSHOWfromid;
+  pData->iSHOWtoid         = pKeyframe->iSHOWtoid;
+  pData->iSHOWnextid       = pKeyframe->iSHOWnextid;
+  pData->iSHOWskip         = pKeyframe->iSHOWskip;
+#endif
 
-                     case 2 : {        /* show first image after TERM */
-                                iRetcode = restore_state (pData);
-                                       /* on error bail out */
-                                if (iRetcode)
-                                  return iRetcode;
-                                       /* notify the app ? */
-                                if (pData->fProcessmend)
-                                  if (!pData->fProcessmend ((mng_handle)pData,
-                                                            pData->iIterations, 0))
-                                    MNG_ERROR (pData, MNG_APPMISCERROR);
+  pData->iDeltaImagetype   = pKeyframe->iDeltaImagetype;
+  pData->iDeltatype        = pKeyframe->iDeltatype;
+  pData->iDeltaBlockwidth  = pKeyframe->iDeltaBlockwidth;
+  pData->iDeltaBlockheight = pKeyframe->iDeltaBlockheight;
+  pData->iDeltaBlockx      = pKeyframe->iDeltaBlockx;
+  pData->iDeltaBlocky      = pKeyframe->iDeltaBlocky;
+  pData->bDeltaimmediate   = pKeyframe->bDeltaimmediate;
 
-                                       /* show first frame after TERM chunk */
-                                pData->pCurraniobj      = pTERM;
-                                pData->bOnlyfirstframe  = MNG_TRUE;
-                                pData->iFramesafterTERM = 0;
-                                       /* max(1, TERM delay, interframe_delay) */
-#ifndef MNG_SKIPCHUNK_FRAM
-                                if (pTERM->iDelay > pData->iFramedelay)
-                                  pData->iFramedelay = pTERM->iDelay;
-                                if (!pData->iFramedelay)
-                                  pData->iFramedelay = 1;
+#ifndef MNG_SKIPCHUNK_MAGN
+  pData->iMAGNfromid       = pKeyframe->iMAGNfromid;
+  pData->iMAGNcurrentid    = pKeyframe->iMAGNcurrentid;
+  pData->iMAGNtoid         = pKeyframe->iMAGNtoid;
 #endif
 
-                                break;
-                              }
-                   }
-                 }
+#ifndef MNG_SKIPCHUNK_PAST
+  pData->iPASTid           = pKeyframe->iPASTid;
+  pData->iPastx            = pKeyframe->iPastx;
+  pData->iPasty            = pKeyframe->iPasty;
+#endif
+                                       /* put the canvas back */
+  for (iY = 0; iY < pKeyframe->iHeight; iY++)
+  {
+    pLine = (mng_uint8p)pData->fGetcanvasline (((mng_handle)pData), iY);
+    MNG_COPY (pLine, pKeyframe->pCanvas + iY * pKeyframe->iCanvasrowsize,
+              pKeyframe->iCanvasrowsize);
 
-                 break;
-               }
+    if (pKeyframe->pAlpha)
+    {
+      pLine = (mng_uint8p)pData->fGetalphaline (((mng_handle)pData), iY);
+      MNG_COPY (pLine, pKeyframe->pAlpha + iY * pKeyframe->iWidth, pKeyframe->iWidth);
     }
   }
-#endif /* MNG_SKIPCHUNK_TERM */
-                                       /* just reading ? */
-  if ((!pData->bDisplaying) && (pData->bReading))
-    if (pData->fProcessmend)           /* inform the app ? */
-      if (!pData->fProcessmend ((mng_handle)pData, 0, 0))
-        MNG_ERROR (pData, MNG_APPMISCERROR);
-
-  if (!pData->pCurraniobj)             /* always let the app refresh at the end ! */
-    pData->bNeedrefresh = MNG_TRUE;
+                                       /* which all needs refreshing */
+  pData->iUpdateleft       = 0;
+  pData->iUpdateright      = pData->iWidth;
+  pData->iUpdatetop        = 0;
+  pData->iUpdatebottom     = pData->iHeight;
+  pData->bNeedrefresh      = MNG_TRUE;
+
+  mng_reset_dirtyrects (pData);        /* as a single dirty-rectangle */
+  pData->sDirty.iCount                 = 1;
+  pData->sDirty.aRects [0].iLeft       = 0;
+  pData->sDirty.aRects [0].iTop        = 0;
+  pData->sDirty.aRects [0].iRight      = (mng_int32)pData->iWidth;
+  pData->sDirty.aRects [0].iBottom     = (mng_int32)pData->iHeight;
+                                       /* tell process_display to continue from here */
+  pData->bKeyframeseek     = MNG_TRUE;
+  pData->iKeyframenext     = (pKeyframe->iFrameseq / pData->iKeyframeinterval + 1) *
+                             pData->iKeyframeinterval;
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MEND, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_RESTORE_KEYFRAME, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
@@ -3535,488 +4014,370 @@ mng_retcode mng_process_display_mend (mng_datap pData)
 
 /* ************************************************************************** */
 
-mng_retcode mng_process_display_mend2 (mng_datap pData)
+mng_retcode mng_drop_keyframes (mng_datap pData)
 {
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MEND, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_DROP_KEYFRAMES, MNG_LC_START);
 #endif
 
-#ifndef MNG_SKIPCHUNK_FRAM
-  pData->bFrameclipping = MNG_FALSE;   /* nothing to do but restore the app background */
-#endif
-  load_bkgdlayer (pData);
+  while (pData->pFirstkeyframe)
+    keyframe_unlink (pData, pData->pFirstkeyframe);
+
+  pData->iKeyframecount  = 0;
+  pData->iKeyframememory = 0;
+  pData->iKeyframenext   = pData->iKeyframeinterval;
+  pData->bKeyframeseek   = MNG_FALSE;
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MEND, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_DROP_KEYFRAMES, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
 }
+#endif /* MNG_SUPPORT_KEYFRAMES */
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * General display processing routine                                     * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
-#ifndef MNG_SKIPCHUNK_DEFI
-mng_retcode mng_process_display_defi (mng_datap pData)
+mng_retcode mng_process_display (mng_datap pData)
 {
-  mng_imagep pImage;
+  mng_retcode iRetcode = MNG_NOERROR;
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DEFI, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY, MNG_LC_START);
 #endif
 
-  if (!pData->iDEFIobjectid)           /* object id=0 ? */
+  if (!pData->iBreakpoint)             /* not broken previously ? */
   {
-    pImage             = (mng_imagep)pData->pObjzero;
+    if ((pData->iRequestframe) || (pData->iRequestlayer) || (pData->iRequesttime))
+    {
+      pData->bSearching = MNG_TRUE;    /* indicate we're searching */
 
-    if (pData->bDEFIhasdonotshow)
-      pImage->bVisible = (mng_bool)(pData->iDEFIdonotshow == 0);
+#ifdef MNG_SUPPORT_KEYFRAMES
+      if (pData->bKeyframeseek)        /* resuming from a keyframe ? */
+        pData->bKeyframeseek = MNG_FALSE;
+      else
+#endif
+      {
+        iRetcode = clear_canvas (pData); /* make the canvas virgin black ?!? */
 
-    if (pData->bDEFIhasloca)
-    {
-      pImage->iPosx    = pData->iDEFIlocax;
-      pImage->iPosy    = pData->iDEFIlocay;
+        if (iRetcode)                  /* on error bail out */
+          return iRetcode;
+                                       /* let's start from the top, shall we */
+        pData->pCurraniobj = pData->pFirstaniobj;
+      }
     }
+  }
 
-    if (pData->bDEFIhasclip)
+  do                                   /* process the objects */
+  {
+    if (pData->bSearching)             /* clear timer-flag when searching !!! */
+      pData->bTimerset = MNG_FALSE;
+                                       /* do we need to finish something first ? */
+    if ((pData->iBreakpoint) && (pData->iBreakpoint < 99))
     {
-      pImage->bClipped = pData->bDEFIhasclip;
-      pImage->iClipl   = pData->iDEFIclipl;
-      pImage->iClipr   = pData->iDEFIclipr;
-      pImage->iClipt   = pData->iDEFIclipt;
-      pImage->iClipb   = pData->iDEFIclipb;
+      switch (pData->iBreakpoint)      /* return to broken display routine */
+      {
+#ifndef MNG_SKIPCHUNK_FRAM
+        case  1 : { iRetcode = mng_process_display_fram2 (pData); break; }
+#endif
+#ifndef MNG_SKIPCHUNK_SHOW
+        case  3 : ;                    /* same as 4 !!! */
+        case  4 : { iRetcode = mng_process_display_show  (pData); break; }
+#endif
+#ifndef MNG_SKIPCHUNK_CLON
+        case  5 : { iRetcode = mng_process_display_clon2 (pData); break; }
+#endif
+#ifndef MNG_SKIPCHUNK_MAGN
+        case  9 : { iRetcode = mng_process_display_magn2 (pData); break; }
+        case 10 : { iRetcode = mng_process_display_mend2 (pData); break; }
+#endif
+#ifndef MNG_SKIPCHUNK_PAST
+        case 11 : { iRetcode = mng_process_display_past2 (pData); break; }
+#endif
+        default : MNG_ERROR (pData, MNG_INTERNALERROR);
+      }
+    }
+    else
+    {
+      if (pData->pCurraniobj)
+        iRetcode = ((mng_object_headerp)pData->pCurraniobj)->fProcess (pData, pData->pCurraniobj);
     }
 
-    pData->pCurrentobj = 0;            /* not a real object ! */
-  }
-  else
-  {                                    /* already exists ? */
-    pImage = (mng_imagep)mng_find_imageobject (pData, pData->iDEFIobjectid);
-
-    if (!pImage)                       /* if not; create new */
+    if (!pData->bTimerset)             /* reset breakpoint flag ? */
+      pData->iBreakpoint = 0;
+                                       /* can we advance to next object ? */
+    if ((!iRetcode) && (pData->pCurraniobj) &&
+        (!pData->bTimerset) && (!pData->bSectionwait))
     {
-      mng_retcode iRetcode = mng_create_imageobject (pData, pData->iDEFIobjectid,
-                                                     (mng_bool)(pData->iDEFIconcrete == 1),
-                                                     (mng_bool)(pData->iDEFIdonotshow == 0),
-                                                     MNG_FALSE, 0, 0, 0, 0, 0, 0, 0,
-                                                     pData->iDEFIlocax, pData->iDEFIlocay,
-                                                     pData->bDEFIhasclip,
-                                                     pData->iDEFIclipl, pData->iDEFIclipr,
-                                                     pData->iDEFIclipt, pData->iDEFIclipb,
-                                                     &pImage);
+      pData->pCurraniobj = ((mng_object_headerp)pData->pCurraniobj)->pNext;
+                                       /* MEND processing to be done ? */
+      if ((pData->eImagetype == mng_it_mng) && (!pData->pCurraniobj))
+        iRetcode = mng_process_display_mend (pData);
 
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
+      if (!pData->pCurraniobj)         /* refresh after last image ? */
+        pData->bNeedrefresh = MNG_TRUE;
     }
-    else
-    {                                  /* exists; then set new info */
-      if (pData->bDEFIhasdonotshow)
-        pImage->bVisible = (mng_bool)(pData->iDEFIdonotshow == 0);
-
-      pImage->bViewable  = MNG_FALSE;
 
-      if (pData->bDEFIhasloca)
+    if (pData->bSearching)             /* are we looking for something ? */
+    {
+      if ((pData->iRequestframe) && (pData->iRequestframe <= pData->iFrameseq))
       {
-        pImage->iPosx    = pData->iDEFIlocax;
-        pImage->iPosy    = pData->iDEFIlocay;
+        pData->iRequestframe = 0;      /* found the frame ! */
+        pData->bSearching    = MNG_FALSE;
       }
-
-      if (pData->bDEFIhasclip)
+      else
+      if ((pData->iRequestlayer) && (pData->iRequestlayer <= pData->iLayerseq))
       {
-        pImage->bClipped = pData->bDEFIhasclip;
-        pImage->iClipl   = pData->iDEFIclipl;
-        pImage->iClipr   = pData->iDEFIclipr;
-        pImage->iClipt   = pData->iDEFIclipt;
-        pImage->iClipb   = pData->iDEFIclipb;
+        pData->iRequestlayer = 0;      /* found the layer ! */
+        pData->bSearching    = MNG_FALSE;
+      }
+      else
+      if ((pData->iRequesttime) && (pData->iRequesttime <= pData->iFrametime))
+      {
+        pData->iRequesttime  = 0;      /* found the playtime ! */
+        pData->bSearching    = MNG_FALSE;
       }
-
-      if (pData->bDEFIhasconcrete)
-        pImage->pImgbuf->bConcrete = (mng_bool)(pData->iDEFIconcrete == 1);
     }
 
-    pData->pCurrentobj = pImage;       /* others may want to know this */
-  }
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DEFI, MNG_LC_END);
+#ifdef MNG_SUPPORT_KEYFRAMES           /* time for a snapshot ? */
+    if ((!iRetcode) && (pData->iKeyframeinterval) &&
+        (pData->iFrameseq >= pData->iKeyframenext))
+      iRetcode = mng_store_keyframe (pData);
 #endif
+  }                                    /* until error or a break or no more objects */
+  while ((!iRetcode) && (pData->pCurraniobj) &&
+         (((pData->bRunning) && (!pData->bTimerset)) || (pData->bSearching)) &&
+         (!pData->bSectionwait) && (!pData->bFreezing));
 
-  return MNG_NOERROR;
-}
-#endif
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+                                       /* refresh needed ? */
+  if ((!pData->bTimerset) && (pData->bNeedrefresh))
+  {
+    iRetcode = mng_display_progressive_refresh (pData, 1);
 
-/* ************************************************************************** */
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+  }
+                                       /* timer break ? */
+  if ((pData->bTimerset) && (!pData->iBreakpoint))
+    pData->iBreakpoint = 99;
+  else
+  if (!pData->bTimerset)
+    pData->iBreakpoint = 0;            /* reset if no timer break */
 
-#ifndef MNG_SKIPCHUNK_BASI
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_basi (mng_datap  pData,
-                                      mng_uint16 iRed,
-                                      mng_uint16 iGreen,
-                                      mng_uint16 iBlue,
-                                      mng_bool   bHasalpha,
-                                      mng_uint16 iAlpha,
-                                      mng_uint8  iViewable)
-#else
-mng_retcode mng_process_display_basi (mng_datap  pData)
-#endif
-{                                      /* address the current "object" if any */
-  mng_imagep     pImage = (mng_imagep)pData->pCurrentobj;
-  mng_uint8p     pWork;
-  mng_uint32     iX;
-  mng_imagedatap pBuf;
-  mng_retcode    iRetcode;
+  if ((!pData->bTimerset) && (!pData->pCurraniobj))
+    pData->bRunning = MNG_FALSE;       /* all done now ! */
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_BASI, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY, MNG_LC_END);
 #endif
 
-  if (!pImage)                         /* or is it an "on-the-fly" image ? */
-    pImage = (mng_imagep)pData->pObjzero;
-                                       /* address the object-buffer */
-  pBuf               = pImage->pImgbuf;
+  return MNG_NOERROR;
+}
 
-  pData->fDisplayrow = MNG_NULL;       /* do nothing by default */
-  pData->fCorrectrow = MNG_NULL;
-  pData->fStorerow   = MNG_NULL;
-  pData->fProcessrow = MNG_NULL;
-                                       /* set parms now that they're known */
-  iRetcode = mng_reset_object_details (pData, pImage, pData->iDatawidth,
-                                       pData->iDataheight, pData->iBitdepth,
-                                       pData->iColortype, pData->iCompression,
-                                       pData->iFilter, pData->iInterlace, MNG_FALSE);
-  if (iRetcode)                        /* on error bail out */
-    return iRetcode;
-                                       /* save the viewable flag */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  pImage->bViewable = (mng_bool)(iViewable == 1);
-#else
-  pImage->bViewable = (mng_bool)(pData->iBASIviewable == 1);
-#endif
-  pBuf->bViewable   = pImage->bViewable;
-  pData->pStoreobj  = pImage;          /* let row-routines know which object */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Chunk display processing routines                                      * */
+/* *                                                                        * */
+/* ************************************************************************** */
 
-  pWork = pBuf->pImgdata;              /* fill the object-buffer with the specified
-                                          "color" sample */
-  switch (pData->iColortype)           /* depending on color_type & bit_depth */
+#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
+png_imgtype mng_png_imgtype(mng_uint8 colortype, mng_uint8 bitdepth)
+{
+  png_imgtype ret;
+  switch (bitdepth)
   {
-    case 0 : {                         /* gray */
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+    case 1:
+    {
+      png_imgtype imgtype[]={png_g1,png_none,png_none,png_idx1};
+      ret=imgtype[colortype];
+      break;
+    }
+    case 2:
+    {
+      png_imgtype imgtype[]={png_g2,png_none,png_none,png_idx2};
+      ret=imgtype[colortype];
+      break;
+    }
+    case 4:
+    {
+      png_imgtype imgtype[]={png_g4,png_none,png_none,png_idx4};
+      ret=imgtype[colortype];
+      break;
+    }
+#endif
+    case 8:
+    {
+      png_imgtype imgtype[]={png_g8,png_none,png_rgb8,png_idx8,png_ga8,
+          png_none,png_rgba8};
+      ret=imgtype[colortype];
+      break;
+    }
 #ifndef MNG_NO_16BIT_SUPPORT
-               if (pData->iBitdepth == 16)
-               {
-#ifdef MNG_DECREMENT_LOOPS
-                 for (iX = pData->iDatawidth * pData->iDataheight;
-                    iX > 0;iX--)
-#else
-                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
+    case 16:
+    {
+      png_imgtype imgtype[]={png_g16,png_none,png_rgb16,png_none,png_ga16,
+          png_none,png_rgba16};
+      ret=imgtype[colortype];
+      break;
+    }
 #endif
-                 {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   mng_put_uint16 (pWork, iRed);
+    default:
+      ret=png_none;
+      break;
+  }
+  return (ret);
+}
+#endif /* MNG_OPTIMIZE_FOOTPRINT_INIT */
+
+/* ************************************************************************** */
+
+MNG_LOCAL void set_rowinit_routine (mng_datap pData)
+{
+#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
+  pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
+  pData->ePng_imgtype=mng_png_imgtype(pData->iColortype,pData->iBitdepth);
 #else
-                   mng_put_uint16 (pWork, pData->iBASIred);
-#endif
-                   pWork += 2;
-                 }
-               }
-               else
-#endif
+  switch (pData->iColortype)           /* determine row initialization routine */
+  {
+    case 0 : {                         /* gray */
+               switch (pData->iBitdepth)
                {
-#ifdef MNG_DECREMENT_LOOPS
-                 for (iX = pData->iDatawidth * pData->iDataheight;
-                    iX > 0;iX--)
-#else
-                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
-#endif
-                 {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   *pWork = (mng_uint8)iRed;
-#else
-                   *pWork = (mng_uint8)pData->iBASIred;
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+                 case  1 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g1_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g1_i;
+
+                             break;
+                           }
+                 case  2 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g2_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g2_i;
+
+                             break;
+                           }
+                 case  4 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g4_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g4_i;
+                             break;
+                           }
+#endif /* MNG_NO_1_2_4BIT_SUPPORT */
+                 case  8 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g8_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g8_i;
+
+                             break;
+                           }
+#ifndef MNG_NO_16BIT_SUPPORT
+                 case 16 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g16_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g16_i;
+
+                             break;
+                           }
 #endif
-                   pWork++;
-                 }
                }
-                                       /* force tRNS ? */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-               if ((bHasalpha) && (!iAlpha))
-#else
-               if ((pData->bBASIhasalpha) && (!pData->iBASIalpha))
-#endif
+
+               break;
+             }
+    case 2 : {                         /* rgb */
+               switch (pData->iBitdepth)
                {
-                 pBuf->bHasTRNS  = MNG_TRUE;
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                 pBuf->iTRNSgray = iRed;
-#else
-                 pBuf->iTRNSgray = pData->iBASIred;
+                 case  8 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgb8_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgb8_i;
+                             break;
+                           }
+#ifndef MNG_NO_16BIT_SUPPORT
+                 case 16 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgb16_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgb16_i;
+
+                             break;
+                           }
 #endif
                }
 
                break;
              }
-
-    case 2 : {                         /* rgb */
-#ifndef MNG_NO_16BIT_SUPPORT
-               if (pData->iBitdepth == 16)
-               {
-#ifdef MNG_DECREMENT_LOOPS
-                 for (iX = pData->iDatawidth * pData->iDataheight;
-                    iX > 0;iX--)
-#else
-                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
-#endif
-                 {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   mng_put_uint16 (pWork,   iRed  );
-                   mng_put_uint16 (pWork+2, iGreen);
-                   mng_put_uint16 (pWork+4, iBlue );
-#else
-                   mng_put_uint16 (pWork,   pData->iBASIred  );
-                   mng_put_uint16 (pWork+2, pData->iBASIgreen);
-                   mng_put_uint16 (pWork+4, pData->iBASIblue );
-#endif
-                   pWork += 6;
-                 }
-               }
-               else
-#endif
-               {
-#ifdef MNG_DECREMENT_LOOPS
-                 for (iX = pData->iDatawidth * pData->iDataheight;
-                    iX > 0;iX--)
-#else
-                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
-#endif
-                 {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   *pWork     = (mng_uint8)iRed;
-                   *(pWork+1) = (mng_uint8)iGreen;
-                   *(pWork+2) = (mng_uint8)iBlue;
-#else
-                   *pWork     = (mng_uint8)pData->iBASIred;
-                   *(pWork+1) = (mng_uint8)pData->iBASIgreen;
-                   *(pWork+2) = (mng_uint8)pData->iBASIblue;
-#endif
-                   pWork += 3;
-                 }
-               }
-                                       /* force tRNS ? */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-               if ((bHasalpha) && (!iAlpha))
-#else
-               if ((pData->bBASIhasalpha) && (!pData->iBASIalpha))
-#endif
-               {
-                 pBuf->bHasTRNS   = MNG_TRUE;
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                 pBuf->iTRNSred   = iRed;
-                 pBuf->iTRNSgreen = iGreen;
-                 pBuf->iTRNSblue  = iBlue;
-#else
-                 pBuf->iTRNSred   = pData->iBASIred;
-                 pBuf->iTRNSgreen = pData->iBASIgreen;
-                 pBuf->iTRNSblue  = pData->iBASIblue;
-#endif
-               }
-
-               break;
-             }
-
-    case 3 : {                         /* indexed */
-               pBuf->bHasPLTE = MNG_TRUE;
-
-               switch (pData->iBitdepth)
-               {
-                 case 1  : { pBuf->iPLTEcount =   2; break; }
-                 case 2  : { pBuf->iPLTEcount =   4; break; }
-                 case 4  : { pBuf->iPLTEcount =  16; break; }
-                 case 8  : { pBuf->iPLTEcount = 256; break; }
-                 default : { pBuf->iPLTEcount =   1; break; }
-               }
-
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-               pBuf->aPLTEentries [0].iRed   = (mng_uint8)iRed;
-               pBuf->aPLTEentries [0].iGreen = (mng_uint8)iGreen;
-               pBuf->aPLTEentries [0].iBlue  = (mng_uint8)iBlue;
-#else
-               pBuf->aPLTEentries [0].iRed   = (mng_uint8)pData->iBASIred;
-               pBuf->aPLTEentries [0].iGreen = (mng_uint8)pData->iBASIgreen;
-               pBuf->aPLTEentries [0].iBlue  = (mng_uint8)pData->iBASIblue;
-#endif
-
-               for (iX = 1; iX < pBuf->iPLTEcount; iX++)
-               {
-                 pBuf->aPLTEentries [iX].iRed   = 0;
-                 pBuf->aPLTEentries [iX].iGreen = 0;
-                 pBuf->aPLTEentries [iX].iBlue  = 0;
-               }
-                                       /* force tRNS ? */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-               if ((bHasalpha) && (iAlpha < 255))
-#else
-               if ((pData->bBASIhasalpha) && (pData->iBASIalpha < 255))
-#endif
-               {
-                 pBuf->bHasTRNS         = MNG_TRUE;
-                 pBuf->iTRNScount       = 1;
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                 pBuf->aTRNSentries [0] = (mng_uint8)iAlpha;
-#else
-                 pBuf->aTRNSentries [0] = (mng_uint8)pData->iBASIalpha;
-#endif
-               }
-
-               break;
-             }
-
-    case 4 : {                         /* gray+alpha */
-#ifndef MNG_NO_16BIT_SUPPORT
-               if (pData->iBitdepth == 16)
-               {
-#ifdef MNG_DECREMENT_LOOPS
-                 for (iX = pData->iDatawidth * pData->iDataheight;
-                    iX > 0;iX--)
-#else
-                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
-#endif
-                 {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   mng_put_uint16 (pWork,   iRed);
-                   mng_put_uint16 (pWork+2, iAlpha);
-#else
-                   mng_put_uint16 (pWork,   pData->iBASIred);
-                   mng_put_uint16 (pWork+2, pData->iBASIalpha);
-#endif
-                   pWork += 4;
-                 }
-               }
-               else
-#endif
-               {
-#ifdef MNG_DECREMENT_LOOPS
-                 for (iX = pData->iDatawidth * pData->iDataheight;
-                    iX > 0;iX--)
-#else
-                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
-#endif
-                 {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   *pWork     = (mng_uint8)iRed;
-                   *(pWork+1) = (mng_uint8)iAlpha;
-#else
-                   *pWork     = (mng_uint8)pData->iBASIred;
-                   *(pWork+1) = (mng_uint8)pData->iBASIalpha;
-#endif
-                   pWork += 2;
-                 }
-               }
-
-               break;
-             }
-
-    case 6 : {                         /* rgb+alpha */
-#ifndef MNG_NO_16BIT_SUPPORT
-               if (pData->iBitdepth == 16)
-               {
-#ifdef MNG_DECREMENT_LOOPS
-                 for (iX = pData->iDatawidth * pData->iDataheight;
-                    iX > 0;iX--)
-#else
-                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
-#endif
-                 {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   mng_put_uint16 (pWork,   iRed);
-                   mng_put_uint16 (pWork+2, iGreen);
-                   mng_put_uint16 (pWork+4, iBlue);
-                   mng_put_uint16 (pWork+6, iAlpha);
-#else
-                   mng_put_uint16 (pWork,   pData->iBASIred);
-                   mng_put_uint16 (pWork+2, pData->iBASIgreen);
-                   mng_put_uint16 (pWork+4, pData->iBASIblue);
-                   mng_put_uint16 (pWork+6, pData->iBASIalpha);
-#endif
-                   pWork += 8;
-                 }
-               }
-               else
-#endif
-               {
-#ifdef MNG_DECREMENT_LOOPS
-                 for (iX = pData->iDatawidth * pData->iDataheight;
-                    iX > 0;iX--)
-#else
-                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
-#endif
-                 {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   *pWork     = (mng_uint8)iRed;
-                   *(pWork+1) = (mng_uint8)iGreen;
-                   *(pWork+2) = (mng_uint8)iBlue;
-                   *(pWork+3) = (mng_uint8)iAlpha;
-#else
-                   *pWork     = (mng_uint8)pData->iBASIred;
-                   *(pWork+1) = (mng_uint8)pData->iBASIgreen;
-                   *(pWork+2) = (mng_uint8)pData->iBASIblue;
-                   *(pWork+3) = (mng_uint8)pData->iBASIalpha;
-#endif
-                   pWork += 4;
-                 }
-               }
-
-               break;
-             }
-
-  }
-
-#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
-  pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
-  pData->ePng_imgtype=mng_png_imgtype(pData->iColortype,pData->iBitdepth);
-#else
-  switch (pData->iColortype)           /* determine row initialization routine */
-  {                                    /* just to accomodate IDAT if it arrives */
-    case 0 : {                         /* gray */
-               switch (pData->iBitdepth)
+    case 3 : {                         /* indexed */
+               switch (pData->iBitdepth)
                {
 #ifndef MNG_NO_1_2_4BIT_SUPPORT
                  case  1 : {
                              if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_g1_ni;
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx1_ni;
                              else
-                               pData->fInitrowproc = (mng_fptr)mng_init_g1_i;
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx1_i;
 
                              break;
                            }
                  case  2 : {
                              if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_g2_ni;
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx2_ni;
                              else
-                               pData->fInitrowproc = (mng_fptr)mng_init_g2_i;
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx2_i;
 
                              break;
                            }
                  case  4 : {
                              if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_g4_ni;
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx4_ni;
                              else
-                               pData->fInitrowproc = (mng_fptr)mng_init_g4_i;
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx4_i;
 
                              break;
                            }
 #endif /* MNG_NO_1_2_4BIT_SUPPORT */
                  case  8 : {
                              if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_g8_ni;
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx8_ni;
                              else
-                               pData->fInitrowproc = (mng_fptr)mng_init_g8_i;
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx8_i;
+
+                             break;
+                           }
+               }
+
+               break;
+             }
+    case 4 : {                         /* gray+alpha */
+               switch (pData->iBitdepth)
+               {
+                 case  8 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_ga8_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_ga8_i;
 
                              break;
                            }
 #ifndef MNG_NO_16BIT_SUPPORT
                  case 16 : {
                              if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_g16_ni;
+                               pData->fInitrowproc = (mng_fptr)mng_init_ga16_ni;
                              else
-                               pData->fInitrowproc = (mng_fptr)mng_init_g16_i;
-
+                               pData->fInitrowproc = (mng_fptr)mng_init_ga16_i;
                              break;
                            }
 #endif
@@ -4024,114 +4385,23 @@ mng_retcode mng_process_display_basi (mng_datap  pData)
 
                break;
              }
-    case 2 : {                         /* rgb */
+    case 6 : {                         /* rgb+alpha */
                switch (pData->iBitdepth)
                {
                  case  8 : {
                              if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_rgb8_ni;
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgba8_ni;
                              else
-                               pData->fInitrowproc = (mng_fptr)mng_init_rgb8_i;
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgba8_i;
 
                              break;
                            }
 #ifndef MNG_NO_16BIT_SUPPORT
                  case 16 : {
                              if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_rgb16_ni;
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgba16_ni;
                              else
-                               pData->fInitrowproc = (mng_fptr)mng_init_rgb16_i;
-
-                             break;
-                           }
-#endif
-               }
-
-               break;
-             }
-    case 3 : {                         /* indexed */
-               switch (pData->iBitdepth)
-               {
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-                 case  1 : {
-                             if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_idx1_ni;
-                             else
-                               pData->fInitrowproc = (mng_fptr)mng_init_idx1_i;
-
-                             break;
-                           }
-                 case  2 : {
-                             if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_idx2_ni;
-                             else
-                               pData->fInitrowproc = (mng_fptr)mng_init_idx2_i;
-
-                             break;
-                           }
-                 case  4 : {
-                             if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_idx4_ni;
-                             else
-                               pData->fInitrowproc = (mng_fptr)mng_init_idx4_i;
-
-                             break;
-                           }
-#endif /* MNG_NO_1_2_4BIT_SUPPORT */
-                 case  8 : {
-                             if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_idx8_ni;
-                             else
-                               pData->fInitrowproc = (mng_fptr)mng_init_idx8_i;
-
-                             break;
-                           }
-               }
-
-               break;
-             }
-    case 4 : {                         /* gray+alpha */
-               switch (pData->iBitdepth)
-               {
-                 case  8 : {
-                             if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_ga8_ni;
-                             else
-                               pData->fInitrowproc = (mng_fptr)mng_init_ga8_i;
-
-                             break;
-                           }
-#ifndef MNG_NO_16BIT_SUPPORT
-                 case 16 : {
-                             if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_ga16_ni;
-                             else
-                               pData->fInitrowproc = (mng_fptr)mng_init_ga16_i;
-
-                             break;
-                           }
-#endif
-               }
-
-               break;
-             }
-    case 6 : {                         /* rgb+alpha */
-               switch (pData->iBitdepth)
-               {
-                 case  8 : {
-                             if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_rgba8_ni;
-                             else
-                               pData->fInitrowproc = (mng_fptr)mng_init_rgba8_i;
-
-                             break;
-                           }
-#ifndef MNG_NO_16BIT_SUPPORT
-                 case 16 : {
-                             if (!pData->iInterlace)
-                               pData->fInitrowproc = (mng_fptr)mng_init_rgba16_ni;
-                             else
-                               pData->fInitrowproc = (mng_fptr)mng_init_rgba16_i;
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgba16_i;
 
                              break;
                            }
@@ -4145,36 +4415,28 @@ mng_retcode mng_process_display_basi (mng_datap  pData)
 
   pData->iFilterofs = 0;               /* determine filter characteristics */
   pData->iLevel0    = 0;               /* default levels */
-  pData->iLevel1    = 0;
+  pData->iLevel1    = 0;    
   pData->iLevel2    = 0;
   pData->iLevel3    = 0;
 
-#ifdef FILTER192
-  if (pData->iFilter == 0xC0)          /* leveling & differing ? */
+#ifdef FILTER192                       /* leveling & differing ? */
+  if (pData->iFilter == MNG_FILTER_DIFFERING)
   {
     switch (pData->iColortype)
     {
       case 0 : {
-#ifndef MNG_NO_16BIT_SUPPORT
                  if (pData->iBitdepth <= 8)
-#endif
                    pData->iFilterofs = 1;
-#ifndef MNG_NO_16BIT_SUPPORT
                  else
                    pData->iFilterofs = 2;
-#endif
 
                  break;
                }
       case 2 : {
-#ifndef MNG_NO_16BIT_SUPPORT
                  if (pData->iBitdepth <= 8)
-#endif
                    pData->iFilterofs = 3;
-#ifndef MNG_NO_16BIT_SUPPORT
                  else
                    pData->iFilterofs = 6;
-#endif
 
                  break;
                }
@@ -4183,26 +4445,18 @@ mng_retcode mng_process_display_basi (mng_datap  pData)
                  break;
                }
       case 4 : {
-#ifndef MNG_NO_16BIT_SUPPORT
                  if (pData->iBitdepth <= 8)
-#endif
                    pData->iFilterofs = 2;
-#ifndef MNG_NO_16BIT_SUPPORT
                  else
                    pData->iFilterofs = 4;
-#endif
 
                  break;
                }
       case 6 : {
-#ifndef MNG_NO_16BIT_SUPPORT
                  if (pData->iBitdepth <= 8)
-#endif
                    pData->iFilterofs = 4;
-#ifndef MNG_NO_16BIT_SUPPORT
                  else
                    pData->iFilterofs = 8;
-#endif
 
                  break;
                }
@@ -4210,160 +4464,141 @@ mng_retcode mng_process_display_basi (mng_datap  pData)
   }
 #endif
 
-#ifdef FILTER193
-  if (pData->iFilter == 0xC1)          /* no adaptive filtering ? */
+#ifdef FILTER193                       /* no adaptive filtering ? */
+  if (pData->iFilter == MNG_FILTER_NOFILTER)
     pData->iPixelofs = pData->iFilterofs;
   else
-#endif
+#endif    
     pData->iPixelofs = pData->iFilterofs + 1;
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_BASI, MNG_LC_END);
-#endif
-
-  return MNG_NOERROR;
+  return;
 }
-#endif
 
 /* ************************************************************************** */
 
-#ifndef MNG_SKIPCHUNK_CLON
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_clon (mng_datap  pData,
-                                      mng_uint16 iSourceid,
-                                      mng_uint16 iCloneid,
-                                      mng_uint8  iClonetype,
-                                      mng_bool   bHasdonotshow,
-                                      mng_uint8  iDonotshow,
-                                      mng_uint8  iConcrete,
-                                      mng_bool   bHasloca,
-                                      mng_uint8  iLocationtype,
-                                      mng_int32  iLocationx,
-                                      mng_int32  iLocationy)
-#else
-mng_retcode mng_process_display_clon (mng_datap  pData)
-#endif
-{
-  mng_imagep  pSource, pClone;
-  mng_bool    bVisible, bAbstract;
-  mng_retcode iRetcode = MNG_NOERROR;
+mng_retcode mng_process_display_ihdr (mng_datap pData)
+{                                      /* address the current "object" if any */
+  mng_imagep pImage = (mng_imagep)pData->pCurrentobj;
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLON, MNG_LC_START);
-#endif
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                                       /* locate the source object first */
-  pSource = mng_find_imageobject (pData, iSourceid);
-                                       /* check if the clone exists */
-  pClone  = mng_find_imageobject (pData, iCloneid);
-#else
-                                       /* locate the source object first */
-  pSource = mng_find_imageobject (pData, pData->iCLONsourceid);
-                                       /* check if the clone exists */
-  pClone  = mng_find_imageobject (pData, pData->iCLONcloneid);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IHDR, MNG_LC_START);
 #endif
 
-  if (!pSource)                        /* source must exist ! */
-    MNG_ERROR (pData, MNG_OBJECTUNKNOWN);
+  if (!pData->bHasDHDR)
+  {
+    pData->fInitrowproc = MNG_NULL;    /* do nothing by default */
+    pData->fDisplayrow  = MNG_NULL;
+    pData->fCorrectrow  = MNG_NULL;
+    pData->fStorerow    = MNG_NULL;
+    pData->fProcessrow  = MNG_NULL;
+    pData->fDifferrow   = MNG_NULL;
+    pData->pStoreobj    = MNG_NULL;
+  }
 
-  if (pClone)                          /* clone must not exist ! */
-    MNG_ERROR (pData, MNG_OBJECTEXISTS);
+  if (!pData->iBreakpoint)             /* not previously broken ? */
+  {
+    mng_retcode iRetcode = MNG_NOERROR;
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  if (bHasdonotshow)                   /* DoNotShow flag filled ? */
-    bVisible = (mng_bool)(iDonotshow == 0);
-  else
-    bVisible = pSource->bVisible;
-#else
-  if (pData->bCLONhasdonotshow)        /* DoNotShow flag filled ? */
-    bVisible = (mng_bool)(pData->iCLONdonotshow == 0);
-  else
-    bVisible = pSource->bVisible;
-#endif
+#ifndef MNG_NO_DELTA_PNG
+    if (pData->bHasDHDR)               /* is a delta-image ? */
+    {
+      if (pData->iDeltatype == MNG_DELTATYPE_REPLACE)
+        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pDeltaImage,
+                                             pData->iDatawidth, pData->iDataheight,
+                                             pData->iBitdepth, pData->iColortype,
+                                             pData->iCompression, pData->iFilter,
+                                             pData->iInterlace, MNG_TRUE);
+      else
+      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKPIXELADD    ) ||
+          (pData->iDeltatype == MNG_DELTATYPE_BLOCKPIXELREPLACE)    )
+      {
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iPixelsampledepth = pData->iBitdepth;
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iBitdepth;
+      }
+      else
+      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKALPHAADD    ) ||
+          (pData->iDeltatype == MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iBitdepth;
+      else
+      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKCOLORADD    ) ||
+          (pData->iDeltatype == MNG_DELTATYPE_BLOCKCOLORREPLACE)    )
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iPixelsampledepth = pData->iBitdepth;
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  bAbstract  = (mng_bool)(iConcrete == 1);
-#else
-  bAbstract  = (mng_bool)(pData->iCLONconcrete == 1);
+      if (!iRetcode)
+      {                                /* process immediately if bitdepth & colortype are equal */
+        pData->bDeltaimmediate =
+          (mng_bool)((pData->iBitdepth  == ((mng_imagep)pData->pDeltaImage)->pImgbuf->iBitdepth ) &&
+                     (pData->iColortype == ((mng_imagep)pData->pDeltaImage)->pImgbuf->iColortype)    );
+                                       /* be sure to reset object 0 */
+        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
+                                             pData->iDatawidth, pData->iDataheight,
+                                             pData->iBitdepth, pData->iColortype,
+                                             pData->iCompression, pData->iFilter,
+                                             pData->iInterlace, MNG_TRUE);
+      }
+    }
+    else
 #endif
+    {
+      if (pImage)                      /* update object buffer ? */
+        iRetcode = mng_reset_object_details (pData, pImage,
+                                             pData->iDatawidth, pData->iDataheight,
+                                             pData->iBitdepth, pData->iColortype,
+                                             pData->iCompression, pData->iFilter,
+                                             pData->iInterlace, MNG_TRUE);
+      else
+        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
+                                             pData->iDatawidth, pData->iDataheight,
+                                             pData->iBitdepth, pData->iColortype,
+                                             pData->iCompression, pData->iFilter,
+                                             pData->iInterlace, MNG_TRUE);
+    }
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  switch (iClonetype)                  /* determine action to take */
-  {
-    case 0 : {                         /* full clone */
-               iRetcode = mng_clone_imageobject (pData, iCloneid, MNG_FALSE,
-                                                 bVisible, bAbstract, bHasloca,
-                                                 iLocationtype, iLocationx, iLocationy,
-                                                 pSource, &pClone);
-               break;
-             }
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+  }
 
-    case 1 : {                         /* partial clone */
-               iRetcode = mng_clone_imageobject (pData, iCloneid, MNG_TRUE,
-                                                 bVisible, bAbstract, bHasloca,
-                                                 iLocationtype, iLocationx, iLocationy,
-                                                 pSource, &pClone);
-               break;
-             }
-
-    case 2 : {                         /* renumber object */
-               iRetcode = mng_renum_imageobject (pData, pSource, iCloneid,
-                                                 bVisible, bAbstract, bHasloca,
-                                                 iLocationtype, iLocationx, iLocationy);
-               pClone   = pSource;
-               break;
-             }
-
-  }
-#else
-  switch (pData->iCLONclonetype)       /* determine action to take */
+#ifndef MNG_NO_DELTA_PNG
+  if (!pData->bHasDHDR)
+#endif
   {
-    case 0 : {                         /* full clone */
-               iRetcode = mng_clone_imageobject (pData, pData->iCLONcloneid, MNG_FALSE,
-                                                 bVisible, bAbstract,
-                                                 pData->bCLONhasloca, pData->iCLONlocationtype,
-                                                 pData->iCLONlocationx, pData->iCLONlocationy,
-                                                 pSource, &pClone);
-               break;
-             }
-
-    case 1 : {                         /* partial clone */
-               iRetcode = mng_clone_imageobject (pData, pData->iCLONcloneid, MNG_TRUE,
-                                                 bVisible, bAbstract,
-                                                 pData->bCLONhasloca, pData->iCLONlocationtype,
-                                                 pData->iCLONlocationx, pData->iCLONlocationy,
-                                                 pSource, &pClone);
-               break;
-             }
-
-    case 2 : {                         /* renumber object */
-               iRetcode = mng_renum_imageobject (pData, pSource, pData->iCLONcloneid,
-                                                 bVisible, bAbstract,
-                                                 pData->bCLONhasloca, pData->iCLONlocationtype,
-                                                 pData->iCLONlocationx, pData->iCLONlocationy);
-               pClone   = pSource;
-               break;
-             }
+    if (pImage)                        /* real object ? */
+      pData->pStoreobj = pImage;       /* tell the row routines */
+    else                               /* otherwise use object 0 */
+      pData->pStoreobj = pData->pObjzero;
 
-  }
+#if !defined(MNG_INCLUDE_MPNG_PROPOSAL) && !defined(MNG_INCLUDE_ANG_PROPOSAL)
+    if (                               /* display "on-the-fly" ? */
+#ifndef MNG_SKIPCHUNK_MAGN
+         (((mng_imagep)pData->pStoreobj)->iMAGN_MethodX == 0) &&
+         (((mng_imagep)pData->pStoreobj)->iMAGN_MethodY == 0) &&
 #endif
+         ( (pData->eImagetype == mng_it_png         ) ||
+           (((mng_imagep)pData->pStoreobj)->bVisible)    )       )
+    {                                  /* that's a new layer then ! */
+      mng_retcode iRetcode = next_layer (pData);
 
-  if (iRetcode)                        /* on error bail out */
-    return iRetcode;
-
-                                       /* display on the fly ? */
-  if ((pClone->bViewable) && (pClone->bVisible))
-  {
-    pData->pLastclone = pClone;        /* remember in case of timer break ! */
-                                       /* display it */
-    mng_display_image (pData, pClone, MNG_FALSE);
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
 
-    if (pData->bTimerset)              /* timer break ? */
-      pData->iBreakpoint = 5;
+      if (pData->bTimerset)            /* timer break ? */
+        pData->iBreakpoint = 2;
+      else
+      {
+        pData->iBreakpoint = 0;
+                                       /* anything to display ? */
+        if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
+          set_display_routine (pData); /* then determine display routine */
+      }
+    }
+#endif
   }
 
+  if (!pData->bTimerset)               /* no timer break ? */
+    set_rowinit_routine (pData);       /* then determine row initialization */
+
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLON, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IHDR, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
@@ -4371,17 +4606,37 @@ mng_retcode mng_process_display_clon (mng_datap  pData)
 
 /* ************************************************************************** */
 
-mng_retcode mng_process_display_clon2 (mng_datap pData)
+#ifdef MNG_INCLUDE_MPNG_PROPOSAL
+mng_retcode mng_process_display_mpng (mng_datap pData)
 {
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLON, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MPNG, MNG_LC_START);
 #endif
-                                       /* only called after timer break ! */
-  mng_display_image (pData, (mng_imagep)pData->pLastclone, MNG_FALSE);
+
+  pData->iAlphadepth = 8;              /* assume transparency !! */
+
+  if (pData->fProcessheader)           /* inform the app (creating the output canvas) ? */
+  {
+    pData->iWidth  = ((mng_mpng_objp)pData->pMPNG)->iFramewidth;
+    pData->iHeight = ((mng_mpng_objp)pData->pMPNG)->iFrameheight;
+
+    if (!pData->fProcessheader (((mng_handle)pData), pData->iWidth, pData->iHeight))
+      MNG_ERROR (pData, MNG_APPMISCERROR);
+  }
+
+  iRetcode = next_layer (pData);       /* first mPNG layer then ! */
+
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+
+  pData->bTimerset   = MNG_FALSE;
   pData->iBreakpoint = 0;
 
+  if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
+    set_display_routine (pData);       /* then determine display routine */
+
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLON, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MPNG, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
@@ -4390,80 +4645,32 @@ mng_retcode mng_process_display_clon2 (mng_datap pData)
 
 /* ************************************************************************** */
 
-#ifndef MNG_SKIPCHUNK_DISC
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_disc (mng_datap   pData,
-                                      mng_uint32  iCount,
-                                      mng_uint16p pIds)
-#else
-mng_retcode mng_process_display_disc (mng_datap   pData)
-#endif
+#ifdef MNG_INCLUDE_ANG_PROPOSAL
+mng_retcode mng_process_display_ang (mng_datap pData)
 {
-  mng_uint32 iX;
-  mng_imagep pImage;
-  mng_uint32 iRetcode;
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DISC, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_ANG, MNG_LC_START);
 #endif
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  if (iCount)                          /* specific list ? */
-#else
-  if (pData->iDISCcount)               /* specific list ? */
-#endif
+  if (pData->fProcessheader)           /* inform the app (creating the output canvas) ? */
   {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-    mng_uint16p pWork = pIds;
-#else
-    mng_uint16p pWork = pData->pDISCids;
-#endif
-
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-#ifdef MNG_DECREMENT_LOOPS             /* iterate the list */
-    for (iX = iCount; iX > 0; iX--)
-#else
-    for (iX = 0; iX < iCount; iX++)
-#endif
-#else
-#ifdef MNG_DECREMENT_LOOPS             /* iterate the list */
-    for (iX = pData->iDISCcount; iX > 0; iX--)
-#else
-    for (iX = 0; iX < pData->iDISCcount; iX++)
-#endif
-#endif
-    {
-      pImage = mng_find_imageobject (pData, *pWork++);
+    if (!pData->fProcessheader (((mng_handle)pData), pData->iWidth, pData->iHeight))
+      MNG_ERROR (pData, MNG_APPMISCERROR);
+  }
 
-      if (pImage)                      /* found the object ? */
-      {                                /* then drop it */
-        iRetcode = mng_free_imageobject (pData, pImage);
+  iRetcode = next_layer (pData);       /* first mPNG layer then ! */
 
-        if (iRetcode)                  /* on error bail out */
-          return iRetcode;
-      }
-    }
-  }
-  else                                 /* empty: drop all un-frozen objects */
-  {
-    mng_imagep pNext = (mng_imagep)pData->pFirstimgobj;
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
 
-    while (pNext)                      /* any left ? */
-    {
-      pImage = pNext;
-      pNext  = pImage->sHeader.pNext;
+  pData->bTimerset   = MNG_FALSE;
+  pData->iBreakpoint = 0;
 
-      if (!pImage->bFrozen)            /* not frozen ? */
-      {                                /* then drop it */
-        iRetcode = mng_free_imageobject (pData, pImage);
-                       
-        if (iRetcode)                  /* on error bail out */
-          return iRetcode;
-      }
-    }
-  }
+  if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
+    set_display_routine (pData);       /* then determine display routine */
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DISC, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_ANG, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
@@ -4472,1074 +4679,2481 @@ mng_retcode mng_process_display_disc (mng_datap   pData)
 
 /* ************************************************************************** */
 
-#ifndef MNG_SKIPCHUNK_FRAM
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_fram (mng_datap  pData,
-                                      mng_uint8  iFramemode,
-                                      mng_uint8  iChangedelay,
-                                      mng_uint32 iDelay,
-                                      mng_uint8  iChangetimeout,
-                                      mng_uint32 iTimeout,
-                                      mng_uint8  iChangeclipping,
-                                      mng_uint8  iCliptype,
-                                      mng_int32  iClipl,
-                                      mng_int32  iClipr,
-                                      mng_int32  iClipt,
-                                      mng_int32  iClipb)
+mng_retcode mng_process_display_idat (mng_datap  pData,
+                                      mng_uint32 iRawlen,
+                                      mng_uint8p pRawdata)
 #else
-mng_retcode mng_process_display_fram (mng_datap  pData)
+mng_retcode mng_process_display_idat (mng_datap  pData)
 #endif
 {
-  mng_retcode iRetcode;
+  mng_retcode iRetcode = MNG_NOERROR;
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_FRAM, MNG_LC_START);
-#endif
-                                       /* advance a frame then */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  iRetcode = next_frame (pData, iFramemode, iChangedelay, iDelay,
-                         iChangetimeout, iTimeout, iChangeclipping,
-                         iCliptype, iClipl, iClipr, iClipt, iClipb);
-#else
-  iRetcode = next_frame (pData, pData->iTempFramemode, pData->iTempChangedelay,
-                         pData->iTempDelay, pData->iTempChangetimeout,
-                         pData->iTempTimeout, pData->iTempChangeclipping,
-                         pData->iTempCliptype, pData->iTempClipl, pData->iTempClipr,
-                         pData->iTempClipt, pData->iTempClipb);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IDAT, MNG_LC_START);
 #endif
 
-  if (pData->bTimerset)                /* timer break ? */
-    pData->iBreakpoint = 1;
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_FRAM, MNG_LC_END);
-#endif
+#if defined(MNG_INCLUDE_MPNG_PROPOSAL) || defined(MNG_INCLUDE_ANG_PROPOSAL) 
+  if ((pData->eImagetype == mng_it_png) && (pData->iLayerseq <= 0))
+  {
+    if (pData->fProcessheader)         /* inform the app (creating the output canvas) ? */
+      if (!pData->fProcessheader (((mng_handle)pData), pData->iWidth, pData->iHeight))
+        MNG_ERROR (pData, MNG_APPMISCERROR);
 
-  return iRetcode;
-}
+    iRetcode = next_layer (pData);     /* first regular PNG layer then ! */
 
-/* ************************************************************************** */
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
 
-mng_retcode mng_process_display_fram2 (mng_datap pData)
-{
-  mng_retcode iRetcode;
+    pData->bTimerset   = MNG_FALSE;
+    pData->iBreakpoint = 0;
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_FRAM, MNG_LC_START);
+    if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
+      set_display_routine (pData);     /* then determine display routine */
+  }
 #endif
-                                       /* again; after the break */
-  iRetcode = next_frame (pData, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
-  pData->iBreakpoint = 0;              /* not again! */
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_FRAM, MNG_LC_END);
-#endif
-
-  return iRetcode;
-}
-#endif
+  if (pData->bRestorebkgd)             /* need to restore the background ? */
+  {
+    pData->bRestorebkgd = MNG_FALSE;
+    iRetcode            = load_bkgdlayer (pData);
 
-/* ************************************************************************** */
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
 
-#ifndef MNG_SKIPCHUNK_MOVE
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_move (mng_datap  pData,
-                                      mng_uint16 iFromid,
-                                      mng_uint16 iToid,
-                                      mng_uint8  iMovetype,
-                                      mng_int32  iMovex,
-                                      mng_int32  iMovey)
-#else
-mng_retcode mng_process_display_move (mng_datap  pData)
-#endif
-{
-  mng_uint16 iX;
-  mng_imagep pImage;
+    pData->iLayerseq++;                /* and it counts as a layer then ! */
+  }
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MOVE, MNG_LC_START);
-#endif
-                                       /* iterate the list */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  for (iX = iFromid; iX <= iToid; iX++)
-#else
-  for (iX = pData->iMOVEfromid; iX <= pData->iMOVEtoid; iX++)
-#endif
+  if (pData->fInitrowproc)             /* need to initialize row processing? */
   {
-    if (!iX)                           /* object id=0 ? */
-      pImage = (mng_imagep)pData->pObjzero;
-    else
-      pImage = mng_find_imageobject (pData, iX);
+    iRetcode = ((mng_initrowproc)pData->fInitrowproc) (pData);
+    pData->fInitrowproc = MNG_NULL;    /* only call this once !!! */
+  }
 
-    if (pImage)                        /* object exists ? */
-    {
+  if ((!iRetcode) && (!pData->bInflating))
+                                       /* initialize inflate */
+    iRetcode = mngzlib_inflateinit (pData);
+
+  if (!iRetcode)                       /* all ok? then inflate, my man */
+  {
+#ifdef MNG_SUPPORT_PARALLEL
+    if (pData->pDecodepool)            /* or has a worker done that already ? */
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      switch (iMovetype)
+      iRetcode = mngzlib_inflatejob (pData, iRawlen, pRawdata);
 #else
-      switch (pData->iMOVEmovetype)
+      iRetcode = mngzlib_inflatejob (pData, pData->iRawlen, pData->pRawdata);
 #endif
-      {
-        case 0 : {                     /* absolute */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   pImage->iPosx = iMovex;
-                   pImage->iPosy = iMovey;
-#else
-                   pImage->iPosx = pData->iMOVEmovex;
-                   pImage->iPosy = pData->iMOVEmovey;
+    else
 #endif
-                   break;
-                 }
-        case 1 : {                     /* relative */
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   pImage->iPosx = pImage->iPosx + iMovex;
-                   pImage->iPosy = pImage->iPosy + iMovey;
+      iRetcode = mngzlib_inflaterows (pData, iRawlen, pRawdata);
 #else
-                   pImage->iPosx = pImage->iPosx + pData->iMOVEmovex;
-                   pImage->iPosy = pImage->iPosy + pData->iMOVEmovey;
+      iRetcode = mngzlib_inflaterows (pData, pData->iRawlen, pData->pRawdata);
 #endif
-                   break;
-                 }
-      }
-    }
   }
 
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+    
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MOVE, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IDAT, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
 }
-#endif
 
 /* ************************************************************************** */
 
-#ifndef MNG_SKIPCHUNK_CLIP
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_clip (mng_datap  pData,
-                                      mng_uint16 iFromid,
-                                      mng_uint16 iToid,
-                                      mng_uint8  iCliptype,
-                                      mng_int32  iClipl,
-                                      mng_int32  iClipr,
-                                      mng_int32  iClipt,
-                                      mng_int32  iClipb)
-#else
-mng_retcode mng_process_display_clip (mng_datap  pData)
-#endif
+mng_retcode mng_process_display_iend (mng_datap pData)
 {
-  mng_uint16 iX;
-  mng_imagep pImage;
+  mng_retcode iRetcode, iRetcode2;
+  mng_bool bDodisplay = MNG_FALSE;
+  mng_bool bMagnify   = MNG_FALSE;
+  mng_bool bCleanup   = (mng_bool)(pData->iBreakpoint != 0);
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLIP, MNG_LC_START);
-#endif
-                                       /* iterate the list */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  for (iX = iFromid; iX <= iToid; iX++)
-#else
-  for (iX = pData->iCLIPfromid; iX <= pData->iCLIPtoid; iX++)
-#endif
-  {
-    if (!iX)                           /* object id=0 ? */
-      pImage = (mng_imagep)pData->pObjzero;
-    else
-      pImage = mng_find_imageobject (pData, iX);
-
-    if (pImage)                        /* object exists ? */
-    {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      switch (iCliptype)
-#else
-      switch (pData->iCLIPcliptype)
-#endif
-      {
-        case 0 : {                     /* absolute */
-                   pImage->bClipped = MNG_TRUE;
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   pImage->iClipl   = iClipl;
-                   pImage->iClipr   = iClipr;
-                   pImage->iClipt   = iClipt;
-                   pImage->iClipb   = iClipb;
-#else
-                   pImage->iClipl   = pData->iCLIPclipl;
-                   pImage->iClipr   = pData->iCLIPclipr;
-                   pImage->iClipt   = pData->iCLIPclipt;
-                   pImage->iClipb   = pData->iCLIPclipb;
-#endif
-                   break;
-                 }
-        case 1 : {                    /* relative */
-                   pImage->bClipped = MNG_TRUE;
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   pImage->iClipl   = pImage->iClipl + iClipl;
-                   pImage->iClipr   = pImage->iClipr + iClipr;
-                   pImage->iClipt   = pImage->iClipt + iClipt;
-                   pImage->iClipb   = pImage->iClipb + iClipb;
-#else
-                   pImage->iClipl   = pImage->iClipl + pData->iCLIPclipl;
-                   pImage->iClipr   = pImage->iClipr + pData->iCLIPclipr;
-                   pImage->iClipt   = pImage->iClipt + pData->iCLIPclipt;
-                   pImage->iClipb   = pImage->iClipb + pData->iCLIPclipb;
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IEND, MNG_LC_START);
 #endif
-                   break;
-                 }
-      }
-    }
-  }
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLIP, MNG_LC_END);
+#ifdef MNG_INCLUDE_JNG                 /* progressive+alpha JNG can be displayed now */
+  if ( (pData->bHasJHDR                                         ) &&
+       ( (pData->bJPEGprogressive) || (pData->bJPEGprogressive2)) &&
+       ( (pData->eImagetype == mng_it_jng         ) ||
+         (((mng_imagep)pData->pStoreobj)->bVisible)             ) &&
+       ( (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGGRAYA ) ||
+         (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGCOLORA)    )    )
+    bDodisplay = MNG_TRUE;
 #endif
 
-  return MNG_NOERROR;
-}
+#ifndef MNG_SKIPCHUNK_MAGN
+  if ( (pData->pStoreobj) &&           /* on-the-fly magnification ? */
+       ( (((mng_imagep)pData->pStoreobj)->iMAGN_MethodX) ||
+         (((mng_imagep)pData->pStoreobj)->iMAGN_MethodY)    ) )
+    bMagnify = MNG_TRUE;
 #endif
 
-/* ************************************************************************** */
-
-#ifndef MNG_SKIPCHUNK_SHOW
-mng_retcode mng_process_display_show (mng_datap pData)
-{
-  mng_int16  iX, iS, iFrom, iTo;
-  mng_imagep pImage;
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SHOW, MNG_LC_START);
+  if ((pData->bHasBASI) ||             /* was it a BASI stream */
+      (bDodisplay)      ||             /* or should we display the JNG */
+#ifndef MNG_SKIPCHUNK_MAGN
+      (bMagnify)        ||             /* or should we magnify it */
 #endif
+                                       /* or did we get broken here last time ? */
+      ((pData->iBreakpoint) && (pData->iBreakpoint != 8)))
+  {
+    mng_imagep pImage = (mng_imagep)pData->pCurrentobj;
 
-  /* TODO: optimization for the cases where "abs (iTo - iFrom)" is rather high;
-     especially where ((iFrom==1) && (iTo==65535)); eg. an empty SHOW !!! */
+    if (!pImage)                       /* or was it object 0 ? */
+      pImage = (mng_imagep)pData->pObjzero;
+                                       /* display it now then ? */
+    if ((pImage->bVisible) && (pImage->bViewable))
+    {                                  /* ok, so do it */
+      iRetcode = mng_display_image (pData, pImage, bDodisplay);
 
-  if (pData->iBreakpoint == 3)         /* previously broken during cycle-mode ? */
-  {
-    pImage = mng_find_imageobject (pData, pData->iSHOWnextid);
-                 
-    if (pImage)                        /* still there ? */
-      mng_display_image (pData, pImage, MNG_FALSE);
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
 
-    pData->iBreakpoint = 0;            /* let's not go through this again! */
+      if (pData->bTimerset)            /* timer break ? */
+        pData->iBreakpoint = 6;
+    }
   }
+#ifndef MNG_NO_DELTA_PNG
   else
+  if ((pData->bHasDHDR) ||             /* was it a DHDR stream */
+      (pData->iBreakpoint == 8))       /* or did we get broken here last time ? */
   {
-    if (pData->iBreakpoint)            /* previously broken at other point ? */
-    {                                  /* restore last parms */
-      iFrom = (mng_int16)pData->iSHOWfromid;
-      iTo   = (mng_int16)pData->iSHOWtoid;
-      iX    = (mng_int16)pData->iSHOWnextid;
-      iS    = (mng_int16)pData->iSHOWskip;
-    }
-    else
-    {                                  /* regular sequence ? */
-      if (pData->iSHOWtoid >= pData->iSHOWfromid)
-        iS  = 1;
-      else                             /* reverse sequence ! */
-        iS  = -1;
+    mng_imagep pImage = (mng_imagep)pData->pDeltaImage;
 
-      iFrom = (mng_int16)pData->iSHOWfromid;
-      iTo   = (mng_int16)pData->iSHOWtoid;
-      iX    = iFrom;
+    if (!pData->iBreakpoint)
+    {                                  /* perform the delta operations needed */
+      iRetcode = mng_execute_delta_image (pData, pImage, (mng_imagep)pData->pObjzero);
 
-      pData->iSHOWfromid = (mng_uint16)iFrom;
-      pData->iSHOWtoid   = (mng_uint16)iTo;
-      pData->iSHOWskip   = iS;
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
     }
-                                       /* cycle mode ? */
-    if ((pData->iSHOWmode == 6) || (pData->iSHOWmode == 7))
-    {
-      mng_uint16 iTrigger = 0;
-      mng_uint16 iFound   = 0;
-      mng_uint16 iPass    = 0;
-      mng_imagep pFound   = 0;
+                                       /* display it now then ? */
+    if ((pImage->bVisible) && (pImage->bViewable))
+    {                                  /* ok, so do it */
+      iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
 
-      do
-      {
-        iPass++;                       /* lets prevent endless loops when there
-                                          are no potential candidates in the list! */
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
 
-        if (iS > 0)                    /* forward ? */
-        {
-          for (iX = iFrom; iX <= iTo; iX += iS)
-          {
-            pImage = mng_find_imageobject (pData, (mng_uint16)iX);
-                         
-            if (pImage)                /* object exists ? */
-            {
-              if (iFound)              /* already found a candidate ? */
-                pImage->bVisible = MNG_FALSE;
-              else
-              if (iTrigger)            /* found the trigger ? */
-              {
-                pImage->bVisible = MNG_TRUE;
-                iFound           = iX;
-                pFound           = pImage;
-              }
-              else
-              if (pImage->bVisible)    /* ok, this is the trigger */
-              {
-                pImage->bVisible = MNG_FALSE;
-                iTrigger         = iX;
-              }
-            }
-          }
-        }
-        else
-        {
-          for (iX = iFrom; iX >= iTo; iX += iS)
-          {
-            pImage = mng_find_imageobject (pData, (mng_uint16)iX);
-                         
-            if (pImage)                /* object exists ? */
-            {
-              if (iFound)              /* already found a candidate ? */
-                pImage->bVisible = MNG_FALSE;
-              else
-              if (iTrigger)            /* found the trigger ? */
-              {
-                pImage->bVisible = MNG_TRUE;
-                iFound           = iX;
-                pFound           = pImage;
-              }
-              else
-              if (pImage->bVisible)    /* ok, this is the trigger */
-              {
-                pImage->bVisible = MNG_FALSE;
-                iTrigger         = iX;
-              }
-            }
-          }
-        }
+      if (pData->bTimerset)            /* timer break ? */
+        pData->iBreakpoint = 8;
+    }
+  }
+#endif
 
-        if (!iTrigger)                 /* did not find a trigger ? */
-          iTrigger = 1;                /* then fake it so the first image
-                                          gets nominated */
-      }                                /* cycle back to beginning ? */
-      while ((iPass < 2) && (iTrigger) && (!iFound));
+  if (!pData->bTimerset)               /* can we continue ? */
+  {
+    pData->iBreakpoint = 0;            /* clear this flag now ! */
 
-      pData->iBreakpoint = 0;          /* just a sanity precaution */
-                                       /* display it ? */
-      if ((pData->iSHOWmode == 6) && (pFound))
-      {
-        mng_display_image (pData, pFound, MNG_FALSE);
 
-        if (pData->bTimerset)          /* timer set ? */
-        {
-          pData->iBreakpoint = 3;
-          pData->iSHOWnextid = iFound; /* save it for after the break */
-        }
-      }
-    }
-    else
+#ifdef MNG_INCLUDE_MPNG_PROPOSAL
+    if (pData->eImagetype == mng_it_mpng)
     {
-      do
-      {
-        pImage = mng_find_imageobject (pData, iX);
-                     
-        if (pImage)                    /* object exists ? */
-        {
-          if (pData->iBreakpoint)      /* did we get broken last time ? */
-          {                            /* could only happen in the display routine */
-            mng_display_image (pData, pImage, MNG_FALSE);
-            pData->iBreakpoint = 0;    /* only once inside this loop please ! */
-          }
-          else
-          {
-            switch (pData->iSHOWmode)  /* do what ? */
-            {
-              case 0 : {
-                         pImage->bVisible = MNG_TRUE;
-                         mng_display_image (pData, pImage, MNG_FALSE);
-                         break;
-                       }
-              case 1 : {
-                         pImage->bVisible = MNG_FALSE;
-                         break;
-                       }
-              case 2 : {
-                         if (pImage->bVisible)
-                           mng_display_image (pData, pImage, MNG_FALSE);
-                         break;
-                       }
-              case 3 : {
-                         pImage->bVisible = MNG_TRUE;
-                         break;
-                       }
-              case 4 : {
-                         pImage->bVisible = (mng_bool)(!pImage->bVisible);
-                         if (pImage->bVisible)
-                           mng_display_image (pData, pImage, MNG_FALSE);
-                         break;
-                       }
-              case 5 : {
-                         pImage->bVisible = (mng_bool)(!pImage->bVisible);
-                       }
-            }
-          }
-        }
-
-        if (!pData->bTimerset)         /* next ? */
-          iX += iS;
+      pData->pCurraniobj = pData->pFirstaniobj;
+    } else
+#endif
+#ifdef MNG_INCLUDE_ANG_PROPOSAL
+    if (pData->eImagetype == mng_it_ang)
+    {
+      pData->pCurraniobj = pData->pFirstaniobj;
+    } else
+#endif
+    {                                  /* cleanup object 0 */
+      mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
+                                0, 0, 0, 0, 0, 0, 0, MNG_TRUE);
+    }
 
-      }                                /* continue ? */
-      while ((!pData->bTimerset) && (((iS > 0) && (iX <= iTo)) ||
-                                     ((iS < 0) && (iX >= iTo))    ));
+    if (pData->bInflating)             /* if we've been inflating */
+    {                                  /* cleanup row-processing, */
+      iRetcode  = mng_cleanup_rowproc (pData);
+                                       /* also cleanup inflate! */
+      iRetcode2 = mngzlib_inflatefree (pData);
 
-      if (pData->bTimerset)            /* timer set ? */
-      {
-        pData->iBreakpoint = 4;
-        pData->iSHOWnextid = iX;       /* save for next time */
-      }
-      else
-        pData->iBreakpoint = 0;
-        
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
+      if (iRetcode2)
+        return iRetcode2;
     }
-  }
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SHOW, MNG_LC_END);
-#endif
 
-  return MNG_NOERROR;
-}
-#endif
+#ifdef MNG_INCLUDE_JNG
+    if (pData->bJPEGdecompress)        /* if we've been decompressing JDAT */
+    {                                  /* cleanup row-processing, */
+      iRetcode  = mng_cleanup_rowproc (pData);
+                                       /* also cleanup decompress! */
+      iRetcode2 = mngjpeg_decompressfree (pData);
 
-/* ************************************************************************** */
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
+      if (iRetcode2)
+        return iRetcode2;
+    }
 
-#ifndef MNG_SKIPCHUNK_SAVE
-mng_retcode mng_process_display_save (mng_datap pData)
-{
-  mng_retcode iRetcode;
+    if (pData->bJPEGdecompress2)       /* if we've been decompressing JDAA */
+    {                                  /* cleanup row-processing, */
+      iRetcode  = mng_cleanup_rowproc (pData);
+                                       /* also cleanup decompress! */
+      iRetcode2 = mngjpeg_decompressfree2 (pData);
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SAVE, MNG_LC_START);
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
+      if (iRetcode2)
+        return iRetcode2;
+    }
 #endif
 
-  iRetcode = save_state (pData);       /* save the current state */
-
-  if (iRetcode)                        /* on error bail out */
-    return iRetcode;
+    if (bCleanup)                      /* if we got broken last time we need to cleanup */
+    {
+      pData->bHasIHDR = MNG_FALSE;     /* IEND signals the end for most ... */
+      pData->bHasBASI = MNG_FALSE;
+      pData->bHasDHDR = MNG_FALSE;
+#ifdef MNG_INCLUDE_JNG
+      pData->bHasJHDR = MNG_FALSE;
+      pData->bHasJSEP = MNG_FALSE;
+      pData->bHasJDAA = MNG_FALSE;
+      pData->bHasJDAT = MNG_FALSE;
+#endif
+      pData->bHasPLTE = MNG_FALSE;
+      pData->bHasTRNS = MNG_FALSE;
+      pData->bHasGAMA = MNG_FALSE;
+      pData->bHasCHRM = MNG_FALSE;
+      pData->bHasSRGB = MNG_FALSE;
+      pData->bHasICCP = MNG_FALSE;
+      pData->bHasBKGD = MNG_FALSE;
+      pData->bHasIDAT = MNG_FALSE;
+    }
+                                       /* if the image was displayed on the fly, */
+                                       /* we'll have to make the app refresh */
+    if ((pData->eImagetype != mng_it_mng) && (pData->fDisplayrow))
+      pData->bNeedrefresh = MNG_TRUE;
+     
+  }
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SAVE, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IEND, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
 }
-#endif
 
 /* ************************************************************************** */
 
-#ifndef MNG_SKIPCHUNK_SEEK
-mng_retcode mng_process_display_seek (mng_datap pData)
+/* change in the MNG spec with regards to TERM delay & interframe_delay
+   as proposed by Adam M. Costello (option 4) and finalized by official vote
+   during december 2002 / check the 'mng-list' archives for more details */
+
+mng_retcode mng_process_display_mend (mng_datap pData)
 {
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SEEK, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MEND, MNG_LC_START);
 #endif
 
+  pData->bForcedelay = pData->iAccumdelay ? MNG_FALSE : MNG_TRUE;
+  pData->iAccumdelay = 0;
+
 #ifdef MNG_SUPPORT_DYNAMICMNG
-  if (pData->bStopafterseek)           /* need to stop after this SEEK ? */
+  if (pData->bStopafterseek)           /* need to stop after this ? */
   {
     pData->bFreezing      = MNG_TRUE;  /* stop processing on this one */
     pData->bRunningevent  = MNG_FALSE;
     pData->bStopafterseek = MNG_FALSE;
     pData->bNeedrefresh   = MNG_TRUE;  /* make sure the last bit is displayed ! */
   }
-  else
 #endif
-  {                                    /* restore the initial or SAVE state */
-    mng_retcode iRetcode = restore_state (pData);
 
-    if (iRetcode)                      /* on error bail out */
-      return iRetcode;
+#ifndef MNG_SKIPCHUNK_TERM
+                                       /* TERM processed ? */
+  if ((pData->bDisplaying) && (pData->bRunning) &&
+      (pData->bHasTERM) && (pData->pTermaniobj))
+  {
+    mng_retcode   iRetcode;
+    mng_ani_termp pTERM;
+                                       /* get the right animation object ! */
+    pTERM = (mng_ani_termp)pData->pTermaniobj;
 
-#ifdef MNG_SUPPORT_DYNAMICMNG
-                                       /* stop after next SEEK ? */
-    if ((pData->bDynamic) || (pData->bRunningevent))
-      pData->bStopafterseek = MNG_TRUE;
-#endif
-  }
+    pData->iIterations++;              /* increase iteration count */
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SEEK, MNG_LC_END);
-#endif
+    switch (pTERM->iTermaction)        /* determine what to do! */
+    {
+      case 0 : {                       /* show last frame indefinitly */
+                 break;                /* piece of cake, that is... */
+               }
 
-  return MNG_NOERROR;
-}
+      case 1 : {                       /* cease displaying anything */
+                                       /* max(1, TERM delay, interframe_delay) */
+#ifndef MNG_SKIPCHUNK_FRAM
+                 if (pTERM->iDelay > pData->iFramedelay)
+                   pData->iFramedelay = pTERM->iDelay;
+                 if (!pData->iFramedelay)
+                   pData->iFramedelay = 1;
 #endif
 
-/* ************************************************************************** */
+                 iRetcode = interframe_delay (pData);
+                                       /* no interframe_delay? then fake it */
+                 if ((!iRetcode) && (!pData->bTimerset))
+                   iRetcode = set_delay (pData, 1);
 
-#ifdef MNG_INCLUDE_JNG
-mng_retcode mng_process_display_jhdr (mng_datap pData)
-{                                      /* address the current "object" if any */
-  mng_imagep  pImage   = (mng_imagep)pData->pCurrentobj;
-  mng_retcode iRetcode = MNG_NOERROR;
+                 if (iRetcode)
+                   return iRetcode;
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JHDR, MNG_LC_START);
+                 pData->iBreakpoint = 10;
+                 break;
+               }
+
+      case 2 : {                       /* show first image after TERM */
+                 iRetcode = restore_state (pData);
+
+                 if (iRetcode)         /* on error bail out */
+                   return iRetcode;
+                                       /* notify the app ? */
+                 if (pData->fProcessmend)
+                   if (!pData->fProcessmend ((mng_handle)pData, pData->iIterations, 0))
+                     MNG_ERROR (pData, MNG_APPMISCERROR);
+
+                                       /* show first frame after TERM chunk */
+                 pData->pCurraniobj      = pTERM;
+                 pData->bOnlyfirstframe  = MNG_TRUE;
+                 pData->iFramesafterTERM = 0;
+
+                                       /* max(1, TERM delay, interframe_delay) */
+#ifndef MNG_SKIPCHUNK_FRAM
+                 if (pTERM->iDelay > pData->iFramedelay)
+                   pData->iFramedelay = pTERM->iDelay;
+                 if (!pData->iFramedelay)
+                   pData->iFramedelay = 1;
 #endif
 
-  if (!pData->bHasDHDR)
-  {
-    pData->fInitrowproc  = MNG_NULL;   /* do nothing by default */
-    pData->fDisplayrow   = MNG_NULL;
-    pData->fCorrectrow   = MNG_NULL;
-    pData->fStorerow     = MNG_NULL;
-    pData->fProcessrow   = MNG_NULL;
-    pData->fDifferrow    = MNG_NULL;
-    pData->fStorerow2    = MNG_NULL;
-    pData->fStorerow3    = MNG_NULL;
+                 break;
+               }
 
-    pData->pStoreobj     = MNG_NULL;   /* initialize important work-parms */
+      case 3 : {                       /* repeat */
+                 if ((pTERM->iItermax) && (pTERM->iItermax < 0x7FFFFFFF))
+                   pTERM->iItermax--;
 
-    pData->iJPEGrow      = 0;
-    pData->iJPEGalpharow = 0;
-    pData->iJPEGrgbrow   = 0;
-    pData->iRowmax       = 0;          /* so init_rowproc does the right thing ! */
-  }
+                 if (pTERM->iItermax)  /* go back to TERM ? */
+                 {                     /* restore to initial or SAVE state */
+                   iRetcode = restore_state (pData);
 
-  if (!pData->iBreakpoint)             /* not previously broken ? */
-  {
-#ifndef MNG_NO_DELTA_PNG
-    if (pData->bHasDHDR)               /* delta-image ? */
-    {
-      if (pData->iDeltatype == MNG_DELTATYPE_REPLACE)
-      {
-        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pDeltaImage,
-                                             pData->iDatawidth, pData->iDataheight,
-                                             pData->iJHDRimgbitdepth, pData->iJHDRcolortype,
-                                             pData->iJHDRalphacompression, pData->iJHDRalphafilter,
-                                             pData->iJHDRalphainterlace, MNG_TRUE);
+                   if (iRetcode)       /* on error bail out */
+                     return iRetcode;
+                                       /* notify the app ? */
+                   if (pData->fProcessmend)
+                     if (!pData->fProcessmend ((mng_handle)pData,
+                                               pData->iIterations, pTERM->iItermax))
+                       MNG_ERROR (pData, MNG_APPMISCERROR);
 
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphabitdepth    = pData->iJHDRalphabitdepth;
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iJHDRcompression  = pData->iJHDRimgcompression;
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iJHDRinterlace    = pData->iJHDRimginterlace;
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
-      }
-      else
-      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKPIXELADD    ) ||
-          (pData->iDeltatype == MNG_DELTATYPE_BLOCKPIXELREPLACE)    )
-      {
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iPixelsampledepth = pData->iJHDRimgbitdepth;
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
-      }
-      else
-      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKALPHAADD    ) ||
-          (pData->iDeltatype == MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
-      else
-      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKCOLORADD    ) ||
-          (pData->iDeltatype == MNG_DELTATYPE_BLOCKCOLORREPLACE)    )
-        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iPixelsampledepth = pData->iJHDRimgbitdepth;
-        
-    }
-    else
-#endif /* MNG_NO_DELTA_PNG */
-    {
-      if (pImage)                      /* update object buffer ? */
-      {
-        iRetcode = mng_reset_object_details (pData, pImage,
-                                             pData->iDatawidth, pData->iDataheight,
-                                             pData->iJHDRimgbitdepth, pData->iJHDRcolortype,
-                                             pData->iJHDRalphacompression, pData->iJHDRalphafilter,
-                                             pData->iJHDRalphainterlace, MNG_TRUE);
+                                       /* restart from TERM chunk */
+                   pData->pCurraniobj = pTERM;
 
-        pImage->pImgbuf->iAlphabitdepth    = pData->iJHDRalphabitdepth;
-        pImage->pImgbuf->iJHDRcompression  = pData->iJHDRimgcompression;
-        pImage->pImgbuf->iJHDRinterlace    = pData->iJHDRimginterlace;
-        pImage->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
-      }
-      else                             /* update object 0 */
-      {
-        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
-                                             pData->iDatawidth, pData->iDataheight,
-                                             pData->iJHDRimgbitdepth, pData->iJHDRcolortype,
-                                             pData->iJHDRalphacompression, pData->iJHDRalphafilter,
-                                             pData->iJHDRalphainterlace, MNG_TRUE);
+                   if (pTERM->iDelay)  /* set the delay (?) */
+                   {
+                                       /* max(1, TERM delay, interframe_delay) */
+#ifndef MNG_SKIPCHUNK_FRAM
+                     if (pTERM->iDelay > pData->iFramedelay)
+                       pData->iFramedelay = pTERM->iDelay;
+                     if (!pData->iFramedelay)
+                       pData->iFramedelay = 1;
+#endif
 
-        ((mng_imagep)pData->pObjzero)->pImgbuf->iAlphabitdepth    = pData->iJHDRalphabitdepth;
-        ((mng_imagep)pData->pObjzero)->pImgbuf->iJHDRcompression  = pData->iJHDRimgcompression;
-        ((mng_imagep)pData->pObjzero)->pImgbuf->iJHDRinterlace    = pData->iJHDRimginterlace;
-        ((mng_imagep)pData->pObjzero)->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
-      }
-    }
+                     pData->bNeedrefresh = MNG_TRUE;
+                   }
+                 }
+                 else
+                 {
+                   switch (pTERM->iIteraction)
+                   {
+                     case 0 : {        /* show last frame indefinitly */
+                                break; /* piece of cake, that is... */
+                              }
 
-    if (iRetcode)                      /* on error bail out */
-      return iRetcode;
-  }
+                     case 1 : {        /* cease displaying anything */
+                                       /* max(1, TERM delay, interframe_delay) */
+#ifndef MNG_SKIPCHUNK_FRAM
+                                if (pTERM->iDelay > pData->iFramedelay)
+                                  pData->iFramedelay = pTERM->iDelay;
+                                if (!pData->iFramedelay)
+                                  pData->iFramedelay = 1;
+#endif
 
-  if (!pData->bHasDHDR)
-  {                                    /* we're always storing a JPEG */
-    if (pImage)                        /* real object ? */
-      pData->pStoreobj = pImage;       /* tell the row routines */
-    else                               /* otherwise use object 0 */
-      pData->pStoreobj = pData->pObjzero;
-                                       /* display "on-the-fly" ? */
-    if (
-#ifndef MNG_SKIPCHUNK_MAGN
-         ( ((mng_imagep)pData->pStoreobj)->iMAGN_MethodX == 0) &&
-         ( ((mng_imagep)pData->pStoreobj)->iMAGN_MethodY == 0) &&
+                                iRetcode = interframe_delay (pData);
+                                       /* no interframe_delay? then fake it */
+                                if ((!iRetcode) && (!pData->bTimerset))
+                                  iRetcode = set_delay (pData, 1);
+
+                                if (iRetcode)
+                                  return iRetcode;
+
+                                pData->iBreakpoint = 10;
+                                break;
+                              }
+
+                     case 2 : {        /* show first image after TERM */
+                                iRetcode = restore_state (pData);
+                                       /* on error bail out */
+                                if (iRetcode)
+                                  return iRetcode;
+                                       /* notify the app ? */
+                                if (pData->fProcessmend)
+                                  if (!pData->fProcessmend ((mng_handle)pData,
+                                                            pData->iIterations, 0))
+                                    MNG_ERROR (pData, MNG_APPMISCERROR);
+
+                                       /* show first frame after TERM chunk */
+                                pData->pCurraniobj      = pTERM;
+                                pData->bOnlyfirstframe  = MNG_TRUE;
+                                pData->iFramesafterTERM = 0;
+                                       /* max(1, TERM delay, interframe_delay) */
+#ifndef MNG_SKIPCHUNK_FRAM
+                                if (pTERM->iDelay > pData->iFramedelay)
+                                  pData->iFramedelay = pTERM->iDelay;
+                                if (!pData->iFramedelay)
+                                  pData->iFramedelay = 1;
 #endif
-         ( (pData->eImagetype == mng_it_jng         ) ||
-           (((mng_imagep)pData->pStoreobj)->bVisible)    )       )
-    {
-      next_layer (pData);              /* that's a new layer then ! */
 
-      pData->iBreakpoint = 0;
+                                break;
+                              }
+                   }
+                 }
 
-      if (pData->bTimerset)            /* timer break ? */
-        pData->iBreakpoint = 7;
-      else
-      if (pData->bRunning)             /* still running ? */
-      {                                /* anything to display ? */
-        if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
-        {
-          set_display_routine (pData); /* then determine display routine */
-                                       /* display from the object we store in */
-          pData->pRetrieveobj = pData->pStoreobj;
-        }
-      }
+                 break;
+               }
     }
   }
+#endif /* MNG_SKIPCHUNK_TERM */
+                                       /* just reading ? */
+  if ((!pData->bDisplaying) && (pData->bReading))
+    if (pData->fProcessmend)           /* inform the app ? */
+      if (!pData->fProcessmend ((mng_handle)pData, 0, 0))
+        MNG_ERROR (pData, MNG_APPMISCERROR);
 
-  if (!pData->bTimerset)               /* no timer break ? */
-  {                                    /* default row initialization ! */
-#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
-    pData->ePng_imgtype=png_none;
-#endif
-    pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
-
-    if ((!pData->bHasDHDR) || (pData->iDeltatype == MNG_DELTATYPE_REPLACE))
-    {                                  /* 8-bit JPEG ? */
-      if (pData->iJHDRimgbitdepth == 8)
-      {                                /* intermediate row is 8-bit deep */
-        pData->bIsRGBA16   = MNG_FALSE;
-        pData->iRowsamples = pData->iDatawidth;
-
-        switch (pData->iJHDRcolortype) /* determine pixel processing routines */
-        {
-          case MNG_COLORTYPE_JPEGGRAY :
-               {
-                 pData->fStorerow2   = (mng_fptr)mng_store_jpeg_g8;
-                 pData->fRetrieverow = (mng_fptr)mng_retrieve_g8;
-                 pData->bIsOpaque    = MNG_TRUE;
-                 break;
-               }
-          case MNG_COLORTYPE_JPEGCOLOR :
-               {
-                 pData->fStorerow2   = (mng_fptr)mng_store_jpeg_rgb8;
-                 pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb8;
-                 pData->bIsOpaque    = MNG_TRUE;
-                 break;
-               }
-          case MNG_COLORTYPE_JPEGGRAYA :
-               {
-                 pData->fStorerow2   = (mng_fptr)mng_store_jpeg_ga8;
-                 pData->fRetrieverow = (mng_fptr)mng_retrieve_ga8;
-                 pData->bIsOpaque    = MNG_FALSE;
-                 break;
-               }
-          case MNG_COLORTYPE_JPEGCOLORA :
-               {
-                 pData->fStorerow2   = (mng_fptr)mng_store_jpeg_rgba8;
-                 pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba8;
-                 pData->bIsOpaque    = MNG_FALSE;
-                 break;
-               }
-        }
-      }
-#ifndef MNG_NO_16BIT_SUPPORT
-      else
-      {
-        pData->bIsRGBA16 = MNG_TRUE;   /* intermediate row is 16-bit deep */
-
-        /* TODO: 12-bit JPEG */
-        /* TODO: 8- + 12-bit JPEG (eg. type=20) */
-
-      }
-#endif
-                                       /* possible IDAT alpha-channel ? */
-      if (pData->iJHDRalphacompression == MNG_COMPRESSION_DEFLATE)
-      {
-                                       /* determine alpha processing routine */
-#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
-        pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
-#endif
-        switch (pData->iJHDRalphabitdepth)
-        {
-#ifndef MNG_OPTIMIZE_FOOTPRINT_INIT
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-          case  1 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a1_ni;  break; }
-          case  2 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a2_ni;  break; }
-          case  4 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a4_ni;  break; }
-#endif /* MNG_NO_1_2_4BIT_SUPPORT */
-          case  8 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a8_ni;  break; }
-#ifndef MNG_NO_16BIT_SUPPORT
-          case 16 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a16_ni; break; }
-#endif
-#else
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-          case  1 : { pData->ePng_imgtype = png_jpeg_a1;  break; }
-          case  2 : { pData->ePng_imgtype = png_jpeg_a2;  break; }
-          case  4 : { pData->ePng_imgtype = png_jpeg_a4;  break; }
-#endif /* MNG_NO_1_2_4BIT_SUPPORT */
-          case  8 : { pData->ePng_imgtype = png_jpeg_a8;  break; }
-#ifndef MNG_NO_16BIT_SUPPORT
-          case 16 : { pData->ePng_imgtype = png_jpeg_a16; break; }
-#endif
-#endif
-        }
-      }
-      else                             /* possible JDAA alpha-channel ? */
-      if (pData->iJHDRalphacompression == MNG_COMPRESSION_BASELINEJPEG)
-      {                                /* 8-bit JPEG ? */
-        if (pData->iJHDRimgbitdepth == 8)
-        {
-          if (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGGRAYA)
-            pData->fStorerow3 = (mng_fptr)mng_store_jpeg_g8_alpha;
-          else
-          if (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGCOLORA)
-            pData->fStorerow3 = (mng_fptr)mng_store_jpeg_rgb8_alpha;
-        }
-        else
-        {
-          /* TODO: 12-bit JPEG with 8-bit JDAA */
-        }
-      }
-                                       /* initialize JPEG library */
-      iRetcode = mngjpeg_initialize (pData);
-
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
-    }
-    else
-    {                                  /* must be alpha add/replace !! */
-      if ((pData->iDeltatype != MNG_DELTATYPE_BLOCKALPHAADD    ) &&
-          (pData->iDeltatype != MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
-        MNG_ERROR (pData, MNG_INVDELTATYPE);
-                                       /* determine alpha processing routine */
-#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
-        pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
-#endif
-      switch (pData->iJHDRalphabitdepth)
-      {
-#ifndef MNG_OPTIMIZE_FOOTPRINT_INIT
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-        case  1 : { pData->fInitrowproc = (mng_fptr)mng_init_g1_ni;  break; }
-        case  2 : { pData->fInitrowproc = (mng_fptr)mng_init_g2_ni;  break; }
-        case  4 : { pData->fInitrowproc = (mng_fptr)mng_init_g4_ni;  break; }
-#endif /* MNG_NO_1_2_4BIT_SUPPORT */
-        case  8 : { pData->fInitrowproc = (mng_fptr)mng_init_g8_ni;  break; }
-#ifndef MNG_NO_16BIT_SUPPORT
-        case 16 : { pData->fInitrowproc = (mng_fptr)mng_init_g16_ni; break; }
-#endif
-#else
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-        case  1 : { pData->ePng_imgtype = png_jpeg_a1;  break; }
-        case  2 : { pData->ePng_imgtype = png_jpeg_a2;  break; }
-        case  4 : { pData->ePng_imgtype = png_jpeg_a4;  break; }
-#endif /* MNG_NO_1_2_4BIT_SUPPORT */
-        case  8 : { pData->ePng_imgtype = png_jpeg_a8;  break; }
-#ifndef MNG_NO_16BIT_SUPPORT
-        case 16 : { pData->ePng_imgtype = png_jpeg_a16; break; }
-#endif
-#endif /* MNG_OPTIMIZE_FOOTPRINT_INIT */
-      }
-    }
-
-    pData->iFilterofs = 0;             /* determine filter characteristics */
-    pData->iLevel0    = 0;             /* default levels */
-    pData->iLevel1    = 0;    
-    pData->iLevel2    = 0;
-    pData->iLevel3    = 0;
-
-#ifdef FILTER192                       /* leveling & differing ? */
-    if (pData->iJHDRalphafilter == 0xC0)
-    {
-       if (pData->iJHDRalphabitdepth <= 8)
-         pData->iFilterofs = 1;
-       else
-         pData->iFilterofs = 2;
-
-    }
-#endif
-#ifdef FILTER193                       /* no adaptive filtering ? */
-    if (pData->iJHDRalphafilter == 0xC1)
-      pData->iPixelofs = pData->iFilterofs;
-    else
-#endif
-      pData->iPixelofs = pData->iFilterofs + 1;
-
-  }
+  if (!pData->pCurraniobj)             /* always let the app refresh at the end ! */
+    pData->bNeedrefresh = MNG_TRUE;
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JHDR, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MEND, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
 }
-#endif /* MNG_INCLUDE_JNG */
 
 /* ************************************************************************** */
 
-#ifdef MNG_INCLUDE_JNG
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_jdaa (mng_datap  pData,
-                                      mng_uint32 iRawlen,
-                                      mng_uint8p pRawdata)
-#else
-mng_retcode mng_process_display_jdaa (mng_datap  pData)
-#endif
+mng_retcode mng_process_display_mend2 (mng_datap pData)
 {
-  mng_retcode iRetcode = MNG_NOERROR;
-
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JDAA, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MEND, MNG_LC_START);
 #endif
 
-  if (!pData->bJPEGdecompress2)        /* if we're not decompressing already */
-  {
-    if (pData->fInitrowproc)           /* initialize row-processing? */
-    {
-      iRetcode = ((mng_initrowproc)pData->fInitrowproc) (pData);
-      pData->fInitrowproc = MNG_NULL;  /* only call this once !!! */
-    }
-
-    if (!iRetcode)                     /* initialize decompress */
-      iRetcode = mngjpeg_decompressinit2 (pData);
-  }
-
-  if (!iRetcode)                       /* all ok? then decompress, my man */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-    iRetcode = mngjpeg_decompressdata2 (pData, iRawlen, pRawdata);
-#else
-    iRetcode = mngjpeg_decompressdata2 (pData, pData->iRawlen, pData->pRawdata);
+#ifndef MNG_SKIPCHUNK_FRAM
+  pData->bFrameclipping = MNG_FALSE;   /* nothing to do but restore the app background */
 #endif
-
-  if (iRetcode)
-    return iRetcode;
+  load_bkgdlayer (pData);
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JDAA, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MEND, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
 }
-#endif /* MNG_INCLUDE_JNG */
 
 /* ************************************************************************** */
 
-#ifdef MNG_INCLUDE_JNG
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_jdat (mng_datap  pData,
-                                      mng_uint32 iRawlen,
-                                      mng_uint8p pRawdata)
-#else
-mng_retcode mng_process_display_jdat (mng_datap  pData)
-#endif
+#ifndef MNG_SKIPCHUNK_DEFI
+mng_retcode mng_process_display_defi (mng_datap pData)
 {
-  mng_retcode iRetcode = MNG_NOERROR;
+  mng_imagep pImage;
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JDAT, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DEFI, MNG_LC_START);
 #endif
 
-  if (pData->bRestorebkgd)             /* need to restore the background ? */
+  if (!pData->iDEFIobjectid)           /* object id=0 ? */
   {
-    pData->bRestorebkgd = MNG_FALSE;
-    iRetcode            = load_bkgdlayer (pData);
+    pImage             = (mng_imagep)pData->pObjzero;
 
-    pData->iLayerseq++;                /* and it counts as a layer then ! */
+    if (pData->bDEFIhasdonotshow)
+      pImage->bVisible = (mng_bool)(pData->iDEFIdonotshow == 0);
 
-    if (iRetcode)                      /* on error bail out */
-      return iRetcode;
-  }
+    if (pData->bDEFIhasloca)
+    {
+      pImage->iPosx    = pData->iDEFIlocax;
+      pImage->iPosy    = pData->iDEFIlocay;
+    }
 
-  if (!pData->bJPEGdecompress)         /* if we're not decompressing already */
-  {
-    if (pData->fInitrowproc)           /* initialize row-processing? */
+    if (pData->bDEFIhasclip)
     {
-      iRetcode = ((mng_initrowproc)pData->fInitrowproc) (pData);
-      pData->fInitrowproc = MNG_NULL;  /* only call this once !!! */
+      pImage->bClipped = pData->bDEFIhasclip;
+      pImage->iClipl   = pData->iDEFIclipl;
+      pImage->iClipr   = pData->iDEFIclipr;
+      pImage->iClipt   = pData->iDEFIclipt;
+      pImage->iClipb   = pData->iDEFIclipb;
     }
 
-    if (!iRetcode)                     /* initialize decompress */
-      iRetcode = mngjpeg_decompressinit (pData);
+    pData->pCurrentobj = 0;            /* not a real object ! */
   }
+  else
+  {                                    /* already exists ? */
+    pImage = (mng_imagep)mng_find_imageobject (pData, pData->iDEFIobjectid);
 
-  if (!iRetcode)                       /* all ok? then decompress, my man */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-    iRetcode = mngjpeg_decompressdata (pData, iRawlen, pRawdata);
-#else
-    iRetcode = mngjpeg_decompressdata (pData, pData->iRawlen, pData->pRawdata);
-#endif
+    if (!pImage)                       /* if not; create new */
+    {
+      mng_retcode iRetcode = mng_create_imageobject (pData, pData->iDEFIobjectid,
+                                                     (mng_bool)(pData->iDEFIconcrete == 1),
+                                                     (mng_bool)(pData->iDEFIdonotshow == 0),
+                                                     MNG_FALSE, 0, 0, 0, 0, 0, 0, 0,
+                                                     pData->iDEFIlocax, pData->iDEFIlocay,
+                                                     pData->bDEFIhasclip,
+                                                     pData->iDEFIclipl, pData->iDEFIclipr,
+                                                     pData->iDEFIclipt, pData->iDEFIclipb,
+                                                     &pImage);
 
-  if (iRetcode)
-    return iRetcode;
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
+    }
+    else
+    {                                  /* exists; then set new info */
+      if (pData->bDEFIhasdonotshow)
+        pImage->bVisible = (mng_bool)(pData->iDEFIdonotshow == 0);
+
+      pImage->bViewable  = MNG_FALSE;
+
+      if (pData->bDEFIhasloca)
+      {
+        pImage->iPosx    = pData->iDEFIlocax;
+        pImage->iPosy    = pData->iDEFIlocay;
+      }
+
+      if (pData->bDEFIhasclip)
+      {
+        pImage->bClipped = pData->bDEFIhasclip;
+        pImage->iClipl   = pData->iDEFIclipl;
+        pImage->iClipr   = pData->iDEFIclipr;
+        pImage->iClipt   = pData->iDEFIclipt;
+        pImage->iClipb   = pData->iDEFIclipb;
+      }
+
+      if (pData->bDEFIhasconcrete)
+        pImage->pImgbuf->bConcrete = (mng_bool)(pData->iDEFIconcrete == 1);
+    }
+
+    pData->pCurrentobj = pImage;       /* others may want to know this */
+  }
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JDAT, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DEFI, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
 }
-#endif /* MNG_INCLUDE_JNG */
+#endif
 
 /* ************************************************************************** */
 
-#ifndef MNG_NO_DELTA_PNG
+#ifndef MNG_SKIPCHUNK_BASI
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_dhdr (mng_datap  pData,
-                                      mng_uint16 iObjectid,
-                                      mng_uint8  iImagetype,
-                                      mng_uint8  iDeltatype,
-                                      mng_uint32 iBlockwidth,
-                                      mng_uint32 iBlockheight,
-                                      mng_uint32 iBlockx,
-                                      mng_uint32 iBlocky)
+mng_retcode mng_process_display_basi (mng_datap  pData,
+                                      mng_uint16 iRed,
+                                      mng_uint16 iGreen,
+                                      mng_uint16 iBlue,
+                                      mng_bool   bHasalpha,
+                                      mng_uint16 iAlpha,
+                                      mng_uint8  iViewable)
 #else
-mng_retcode mng_process_display_dhdr (mng_datap  pData)
+mng_retcode mng_process_display_basi (mng_datap  pData)
 #endif
-{
-  mng_imagep  pImage;
-  mng_retcode iRetcode;
+{                                      /* address the current "object" if any */
+  mng_imagep     pImage = (mng_imagep)pData->pCurrentobj;
+  mng_uint8p     pWork;
+  mng_uint32     iX;
+  mng_imagedatap pBuf;
+  mng_retcode    iRetcode;
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DHDR, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_BASI, MNG_LC_START);
 #endif
 
-  pData->fInitrowproc     = MNG_NULL;  /* do nothing by default */
-  pData->fDisplayrow      = MNG_NULL;
-  pData->fCorrectrow      = MNG_NULL;
-  pData->fStorerow        = MNG_NULL;
-  pData->fProcessrow      = MNG_NULL;
-  pData->pStoreobj        = MNG_NULL;
-
-  pData->fDeltagetrow     = MNG_NULL;
-  pData->fDeltaaddrow     = MNG_NULL;
-  pData->fDeltareplacerow = MNG_NULL;
-  pData->fDeltaputrow     = MNG_NULL;
+  if (!pImage)                         /* or is it an "on-the-fly" image ? */
+    pImage = (mng_imagep)pData->pObjzero;
+                                       /* address the object-buffer */
+  pBuf               = pImage->pImgbuf;
 
+  pData->fDisplayrow = MNG_NULL;       /* do nothing by default */
+  pData->fCorrectrow = MNG_NULL;
+  pData->fStorerow   = MNG_NULL;
+  pData->fProcessrow = MNG_NULL;
+                                       /* set parms now that they're known */
+  iRetcode = mng_reset_object_details (pData, pImage, pData->iDatawidth,
+                                       pData->iDataheight, pData->iBitdepth,
+                                       pData->iColortype, pData->iCompression,
+                                       pData->iFilter, pData->iInterlace, MNG_FALSE);
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+                                       /* save the viewable flag */
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  pImage = mng_find_imageobject (pData, iObjectid);
+  pImage->bViewable = (mng_bool)(iViewable == 1);
 #else
-  pImage = mng_find_imageobject (pData, pData->iDHDRobjectid);
+  pImage->bViewable = (mng_bool)(pData->iBASIviewable == 1);
 #endif
+  pBuf->bViewable   = pImage->bViewable;
+  pData->pStoreobj  = pImage;          /* let row-routines know which object */
 
-  if (pImage)                          /* object exists ? */
+  pWork = pBuf->pImgdata;              /* fill the object-buffer with the specified
+                                          "color" sample */
+  switch (pData->iColortype)           /* depending on color_type & bit_depth */
   {
-    if (pImage->pImgbuf->bConcrete)    /* is it concrete ? */
-    {                                  /* previous magnification to be done ? */
-#ifndef MNG_SKIPCHUNK_MAGN
-      if ((pImage->iMAGN_MethodX) || (pImage->iMAGN_MethodY))
-      {
-        iRetcode = mng_magnify_imageobject (pData, pImage);
-                       
-        if (iRetcode)                  /* on error bail out */
-          return iRetcode;
-      }
-#endif
-                                       /* save delta fields */
-      pData->pDeltaImage           = (mng_ptr)pImage;
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      pData->iDeltaImagetype       = iImagetype;
-      pData->iDeltatype            = iDeltatype;
-      pData->iDeltaBlockwidth      = iBlockwidth;
-      pData->iDeltaBlockheight     = iBlockheight;
-      pData->iDeltaBlockx          = iBlockx;
-      pData->iDeltaBlocky          = iBlocky;
+    case 0 : {                         /* gray */
+#ifndef MNG_NO_16BIT_SUPPORT
+               if (pData->iBitdepth == 16)
+               {
+#ifdef MNG_DECREMENT_LOOPS
+                 for (iX = pData->iDatawidth * pData->iDataheight;
+                    iX > 0;iX--)
 #else
-      pData->iDeltaImagetype       = pData->iDHDRimagetype;
-      pData->iDeltatype            = pData->iDHDRdeltatype;
-      pData->iDeltaBlockwidth      = pData->iDHDRblockwidth;
-      pData->iDeltaBlockheight     = pData->iDHDRblockheight;
-      pData->iDeltaBlockx          = pData->iDHDRblockx;
-      pData->iDeltaBlocky          = pData->iDHDRblocky;
+                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
 #endif
-                                       /* restore target-object fields */
-      pData->iDatawidth            = pImage->pImgbuf->iWidth;
-      pData->iDataheight           = pImage->pImgbuf->iHeight;
-      pData->iBitdepth             = pImage->pImgbuf->iBitdepth;
-      pData->iColortype            = pImage->pImgbuf->iColortype;
-      pData->iCompression          = pImage->pImgbuf->iCompression;
-      pData->iFilter               = pImage->pImgbuf->iFilter;
-      pData->iInterlace            = pImage->pImgbuf->iInterlace;
-
+                 {
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      if ((iDeltatype == MNG_DELTATYPE_BLOCKPIXELADD    ) ||
-          (iDeltatype == MNG_DELTATYPE_BLOCKPIXELREPLACE)    )
-        pData->iBitdepth           = pImage->pImgbuf->iPixelsampledepth;
-      else
-      if ((iDeltatype == MNG_DELTATYPE_BLOCKALPHAADD    ) ||
-          (iDeltatype == MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
-        pData->iBitdepth           = pImage->pImgbuf->iAlphasampledepth;
-      else
-      if ((iDeltatype == MNG_DELTATYPE_BLOCKCOLORADD    ) ||
-          (iDeltatype == MNG_DELTATYPE_BLOCKCOLORREPLACE)    )
-        pData->iBitdepth           = pImage->pImgbuf->iPixelsampledepth;
+                   mng_put_uint16 (pWork, iRed);
 #else
-      if ((pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKPIXELADD    ) ||
-          (pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKPIXELREPLACE)    )
-        pData->iBitdepth           = pImage->pImgbuf->iPixelsampledepth;
-      else
-      if ((pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKALPHAADD    ) ||
-          (pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
-        pData->iBitdepth           = pImage->pImgbuf->iAlphasampledepth;
-      else
-      if ((pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKCOLORADD    ) ||
-          (pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKCOLORREPLACE)    )
-        pData->iBitdepth           = pImage->pImgbuf->iPixelsampledepth;
+                   mng_put_uint16 (pWork, pData->iBASIred);
 #endif
-
-#ifdef MNG_INCLUDE_JNG
-      pData->iJHDRimgbitdepth      = pImage->pImgbuf->iBitdepth;
-      pData->iJHDRcolortype        = pImage->pImgbuf->iColortype;
-      pData->iJHDRimgcompression   = pImage->pImgbuf->iJHDRcompression;
-      pData->iJHDRimginterlace     = pImage->pImgbuf->iJHDRinterlace;
-      pData->iJHDRalphacompression = pImage->pImgbuf->iCompression;
-      pData->iJHDRalphafilter      = pImage->pImgbuf->iFilter;
-      pData->iJHDRalphainterlace   = pImage->pImgbuf->iInterlace;
-      pData->iJHDRalphabitdepth    = pImage->pImgbuf->iAlphabitdepth;
+                   pWork += 2;
+                 }
+               }
+               else
 #endif
-
+               {
+#ifdef MNG_DECREMENT_LOOPS
+                 for (iX = pData->iDatawidth * pData->iDataheight;
+                    iX > 0;iX--)
+#else
+                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
+#endif
+                 {
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                                       /* block size specified ? */
-      if (iDeltatype != MNG_DELTATYPE_NOCHANGE)
-      {                                /* block entirely within target ? */
-        if (iDeltatype != MNG_DELTATYPE_REPLACE)
-        {
-          if (((iBlockx + iBlockwidth ) > pData->iDatawidth ) ||
-              ((iBlocky + iBlockheight) > pData->iDataheight)    )
-            MNG_ERROR (pData, MNG_INVALIDBLOCK);
-        }
-
-        pData->iDatawidth          = iBlockwidth;
-        pData->iDataheight         = iBlockheight;
-      }
+                   *pWork = (mng_uint8)iRed;
 #else
-                                       /* block size specified ? */
-      if (pData->iDHDRdeltatype != MNG_DELTATYPE_NOCHANGE)
-      {                                /* block entirely within target ? */
-        if (pData->iDHDRdeltatype != MNG_DELTATYPE_REPLACE)
-        {
-          if (((pData->iDHDRblockx + pData->iDHDRblockwidth ) > pData->iDatawidth ) ||
-              ((pData->iDHDRblocky + pData->iDHDRblockheight) > pData->iDataheight)    )
-            MNG_ERROR (pData, MNG_INVALIDBLOCK);
-        }
-
-        pData->iDatawidth          = pData->iDHDRblockwidth;
-        pData->iDataheight         = pData->iDHDRblockheight;
-      }
+                   *pWork = (mng_uint8)pData->iBASIred;
 #endif
-
+                   pWork++;
+                 }
+               }
+                                       /* force tRNS ? */
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      switch (iDeltatype)              /* determine nr of delta-channels */
+               if ((bHasalpha) && (!iAlpha))
 #else
-      switch (pData->iDHDRdeltatype)   /* determine nr of delta-channels */
+               if ((pData->bBASIhasalpha) && (!pData->iBASIalpha))
 #endif
-      {
-         case MNG_DELTATYPE_BLOCKALPHAADD : ;
-         case MNG_DELTATYPE_BLOCKALPHAREPLACE :
-              {
+               {
+                 pBuf->bHasTRNS  = MNG_TRUE;
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                 pBuf->iTRNSgray = iRed;
+#else
+                 pBuf->iTRNSgray = pData->iBASIred;
+#endif
+               }
+
+               break;
+             }
+
+    case 2 : {                         /* rgb */
+#ifndef MNG_NO_16BIT_SUPPORT
+               if (pData->iBitdepth == 16)
+               {
+#ifdef MNG_DECREMENT_LOOPS
+                 for (iX = pData->iDatawidth * pData->iDataheight;
+                    iX > 0;iX--)
+#else
+                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
+#endif
+                 {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   mng_put_uint16 (pWork,   iRed  );
+                   mng_put_uint16 (pWork+2, iGreen);
+                   mng_put_uint16 (pWork+4, iBlue );
+#else
+                   mng_put_uint16 (pWork,   pData->iBASIred  );
+                   mng_put_uint16 (pWork+2, pData->iBASIgreen);
+                   mng_put_uint16 (pWork+4, pData->iBASIblue );
+#endif
+                   pWork += 6;
+                 }
+               }
+               else
+#endif
+               {
+#ifdef MNG_DECREMENT_LOOPS
+                 for (iX = pData->iDatawidth * pData->iDataheight;
+                    iX > 0;iX--)
+#else
+                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
+#endif
+                 {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   *pWork     = (mng_uint8)iRed;
+                   *(pWork+1) = (mng_uint8)iGreen;
+                   *(pWork+2) = (mng_uint8)iBlue;
+#else
+                   *pWork     = (mng_uint8)pData->iBASIred;
+                   *(pWork+1) = (mng_uint8)pData->iBASIgreen;
+                   *(pWork+2) = (mng_uint8)pData->iBASIblue;
+#endif
+                   pWork += 3;
+                 }
+               }
+                                       /* force tRNS ? */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+               if ((bHasalpha) && (!iAlpha))
+#else
+               if ((pData->bBASIhasalpha) && (!pData->iBASIalpha))
+#endif
+               {
+                 pBuf->bHasTRNS   = MNG_TRUE;
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                 pBuf->iTRNSred   = iRed;
+                 pBuf->iTRNSgreen = iGreen;
+                 pBuf->iTRNSblue  = iBlue;
+#else
+                 pBuf->iTRNSred   = pData->iBASIred;
+                 pBuf->iTRNSgreen = pData->iBASIgreen;
+                 pBuf->iTRNSblue  = pData->iBASIblue;
+#endif
+               }
+
+               break;
+             }
+
+    case 3 : {                         /* indexed */
+               pBuf->bHasPLTE = MNG_TRUE;
+
+               switch (pData->iBitdepth)
+               {
+                 case 1  : { pBuf->iPLTEcount =   2; break; }
+                 case 2  : { pBuf->iPLTEcount =   4; break; }
+                 case 4  : { pBuf->iPLTEcount =  16; break; }
+                 case 8  : { pBuf->iPLTEcount = 256; break; }
+                 default : { pBuf->iPLTEcount =   1; break; }
+               }
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+               pBuf->aPLTEentries [0].iRed   = (mng_uint8)iRed;
+               pBuf->aPLTEentries [0].iGreen = (mng_uint8)iGreen;
+               pBuf->aPLTEentries [0].iBlue  = (mng_uint8)iBlue;
+#else
+               pBuf->aPLTEentries [0].iRed   = (mng_uint8)pData->iBASIred;
+               pBuf->aPLTEentries [0].iGreen = (mng_uint8)pData->iBASIgreen;
+               pBuf->aPLTEentries [0].iBlue  = (mng_uint8)pData->iBASIblue;
+#endif
+
+               for (iX = 1; iX < pBuf->iPLTEcount; iX++)
+               {
+                 pBuf->aPLTEentries [iX].iRed   = 0;
+                 pBuf->aPLTEentries [iX].iGreen = 0;
+                 pBuf->aPLTEentries [iX].iBlue  = 0;
+               }
+                                       /* force tRNS ? */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+               if ((bHasalpha) && (iAlpha < 255))
+#else
+               if ((pData->bBASIhasalpha) && (pData->iBASIalpha < 255))
+#endif
+               {
+                 pBuf->bHasTRNS         = MNG_TRUE;
+                 pBuf->iTRNScount       = 1;
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                 pBuf->aTRNSentries [0] = (mng_uint8)iAlpha;
+#else
+                 pBuf->aTRNSentries [0] = (mng_uint8)pData->iBASIalpha;
+#endif
+               }
+
+               break;
+             }
+
+    case 4 : {                         /* gray+alpha */
+#ifndef MNG_NO_16BIT_SUPPORT
+               if (pData->iBitdepth == 16)
+               {
+#ifdef MNG_DECREMENT_LOOPS
+                 for (iX = pData->iDatawidth * pData->iDataheight;
+                    iX > 0;iX--)
+#else
+                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
+#endif
+                 {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   mng_put_uint16 (pWork,   iRed);
+                   mng_put_uint16 (pWork+2, iAlpha);
+#else
+                   mng_put_uint16 (pWork,   pData->iBASIred);
+                   mng_put_uint16 (pWork+2, pData->iBASIalpha);
+#endif
+                   pWork += 4;
+                 }
+               }
+               else
+#endif
+               {
+#ifdef MNG_DECREMENT_LOOPS
+                 for (iX = pData->iDatawidth * pData->iDataheight;
+                    iX > 0;iX--)
+#else
+                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
+#endif
+                 {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   *pWork     = (mng_uint8)iRed;
+                   *(pWork+1) = (mng_uint8)iAlpha;
+#else
+                   *pWork     = (mng_uint8)pData->iBASIred;
+                   *(pWork+1) = (mng_uint8)pData->iBASIalpha;
+#endif
+                   pWork += 2;
+                 }
+               }
+
+               break;
+             }
+
+    case 6 : {                         /* rgb+alpha */
+#ifndef MNG_NO_16BIT_SUPPORT
+               if (pData->iBitdepth == 16)
+               {
+#ifdef MNG_DECREMENT_LOOPS
+                 for (iX = pData->iDatawidth * pData->iDataheight;
+                    iX > 0;iX--)
+#else
+                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
+#endif
+                 {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   mng_put_uint16 (pWork,   iRed);
+                   mng_put_uint16 (pWork+2, iGreen);
+                   mng_put_uint16 (pWork+4, iBlue);
+                   mng_put_uint16 (pWork+6, iAlpha);
+#else
+                   mng_put_uint16 (pWork,   pData->iBASIred);
+                   mng_put_uint16 (pWork+2, pData->iBASIgreen);
+                   mng_put_uint16 (pWork+4, pData->iBASIblue);
+                   mng_put_uint16 (pWork+6, pData->iBASIalpha);
+#endif
+                   pWork += 8;
+                 }
+               }
+               else
+#endif
+               {
+#ifdef MNG_DECREMENT_LOOPS
+                 for (iX = pData->iDatawidth * pData->iDataheight;
+                    iX > 0;iX--)
+#else
+                 for (iX = 0; iX < pData->iDatawidth * pData->iDataheight; iX++)
+#endif
+                 {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   *pWork     = (mng_uint8)iRed;
+                   *(pWork+1) = (mng_uint8)iGreen;
+                   *(pWork+2) = (mng_uint8)iBlue;
+                   *(pWork+3) = (mng_uint8)iAlpha;
+#else
+                   *pWork     = (mng_uint8)pData->iBASIred;
+                   *(pWork+1) = (mng_uint8)pData->iBASIgreen;
+                   *(pWork+2) = (mng_uint8)pData->iBASIblue;
+                   *(pWork+3) = (mng_uint8)pData->iBASIalpha;
+#endif
+                   pWork += 4;
+                 }
+               }
+
+               break;
+             }
+
+  }
+
+#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
+  pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
+  pData->ePng_imgtype=mng_png_imgtype(pData->iColortype,pData->iBitdepth);
+#else
+  switch (pData->iColortype)           /* determine row initialization routine */
+  {                                    /* just to accomodate IDAT if it arrives */
+    case 0 : {                         /* gray */
+               switch (pData->iBitdepth)
+               {
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+                 case  1 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g1_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g1_i;
+
+                             break;
+                           }
+                 case  2 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g2_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g2_i;
+
+                             break;
+                           }
+                 case  4 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g4_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g4_i;
+
+                             break;
+                           }
+#endif /* MNG_NO_1_2_4BIT_SUPPORT */
+                 case  8 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g8_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g8_i;
+
+                             break;
+                           }
+#ifndef MNG_NO_16BIT_SUPPORT
+                 case 16 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_g16_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_g16_i;
+
+                             break;
+                           }
+#endif
+               }
+
+               break;
+             }
+    case 2 : {                         /* rgb */
+               switch (pData->iBitdepth)
+               {
+                 case  8 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgb8_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgb8_i;
+
+                             break;
+                           }
+#ifndef MNG_NO_16BIT_SUPPORT
+                 case 16 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgb16_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgb16_i;
+
+                             break;
+                           }
+#endif
+               }
+
+               break;
+             }
+    case 3 : {                         /* indexed */
+               switch (pData->iBitdepth)
+               {
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+                 case  1 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx1_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx1_i;
+
+                             break;
+                           }
+                 case  2 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx2_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx2_i;
+
+                             break;
+                           }
+                 case  4 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx4_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx4_i;
+
+                             break;
+                           }
+#endif /* MNG_NO_1_2_4BIT_SUPPORT */
+                 case  8 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx8_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_idx8_i;
+
+                             break;
+                           }
+               }
+
+               break;
+             }
+    case 4 : {                         /* gray+alpha */
+               switch (pData->iBitdepth)
+               {
+                 case  8 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_ga8_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_ga8_i;
+
+                             break;
+                           }
+#ifndef MNG_NO_16BIT_SUPPORT
+                 case 16 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_ga16_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_ga16_i;
+
+                             break;
+                           }
+#endif
+               }
+
+               break;
+             }
+    case 6 : {                         /* rgb+alpha */
+               switch (pData->iBitdepth)
+               {
+                 case  8 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgba8_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgba8_i;
+
+                             break;
+                           }
+#ifndef MNG_NO_16BIT_SUPPORT
+                 case 16 : {
+                             if (!pData->iInterlace)
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgba16_ni;
+                             else
+                               pData->fInitrowproc = (mng_fptr)mng_init_rgba16_i;
+
+                             break;
+                           }
+#endif
+               }
+
+               break;
+             }
+  }
+#endif /* MNG_OPTIMIZE_FOOTPRINT_INIT */
+
+  pData->iFilterofs = 0;               /* determine filter characteristics */
+  pData->iLevel0    = 0;               /* default levels */
+  pData->iLevel1    = 0;
+  pData->iLevel2    = 0;
+  pData->iLevel3    = 0;
+
+#ifdef FILTER192
+  if (pData->iFilter == 0xC0)          /* leveling & differing ? */
+  {
+    switch (pData->iColortype)
+    {
+      case 0 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (pData->iBitdepth <= 8)
+#endif
+                   pData->iFilterofs = 1;
+#ifndef MNG_NO_16BIT_SUPPORT
+                 else
+                   pData->iFilterofs = 2;
+#endif
+
+                 break;
+               }
+      case 2 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (pData->iBitdepth <= 8)
+#endif
+                   pData->iFilterofs = 3;
+#ifndef MNG_NO_16BIT_SUPPORT
+                 else
+                   pData->iFilterofs = 6;
+#endif
+
+                 break;
+               }
+      case 3 : {
+                 pData->iFilterofs = 1;
+                 break;
+               }
+      case 4 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (pData->iBitdepth <= 8)
+#endif
+                   pData->iFilterofs = 2;
+#ifndef MNG_NO_16BIT_SUPPORT
+                 else
+                   pData->iFilterofs = 4;
+#endif
+
+                 break;
+               }
+      case 6 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (pData->iBitdepth <= 8)
+#endif
+                   pData->iFilterofs = 4;
+#ifndef MNG_NO_16BIT_SUPPORT
+                 else
+                   pData->iFilterofs = 8;
+#endif
+
+                 break;
+               }
+    }
+  }
+#endif
+
+#ifdef FILTER193
+  if (pData->iFilter == 0xC1)          /* no adaptive filtering ? */
+    pData->iPixelofs = pData->iFilterofs;
+  else
+#endif
+    pData->iPixelofs = pData->iFilterofs + 1;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_BASI, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif
+
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_CLON
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_clon (mng_datap  pData,
+                                      mng_uint16 iSourceid,
+                                      mng_uint16 iCloneid,
+                                      mng_uint8  iClonetype,
+                                      mng_bool   bHasdonotshow,
+                                      mng_uint8  iDonotshow,
+                                      mng_uint8  iConcrete,
+                                      mng_bool   bHasloca,
+                                      mng_uint8  iLocationtype,
+                                      mng_int32  iLocationx,
+                                      mng_int32  iLocationy)
+#else
+mng_retcode mng_process_display_clon (mng_datap  pData)
+#endif
+{
+  mng_imagep  pSource, pClone;
+  mng_bool    bVisible, bAbstract;
+  mng_retcode iRetcode = MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLON, MNG_LC_START);
+#endif
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                                       /* locate the source object first */
+  pSource = mng_find_imageobject (pData, iSourceid);
+                                       /* check if the clone exists */
+  pClone  = mng_find_imageobject (pData, iCloneid);
+#else
+                                       /* locate the source object first */
+  pSource = mng_find_imageobject (pData, pData->iCLONsourceid);
+                                       /* check if the clone exists */
+  pClone  = mng_find_imageobject (pData, pData->iCLONcloneid);
+#endif
+
+  if (!pSource)                        /* source must exist ! */
+    MNG_ERROR (pData, MNG_OBJECTUNKNOWN);
+
+  if (pClone)                          /* clone must not exist ! */
+    MNG_ERROR (pData, MNG_OBJECTEXISTS);
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  if (bHasdonotshow)                   /* DoNotShow flag filled ? */
+    bVisible = (mng_bool)(iDonotshow == 0);
+  else
+    bVisible = pSource->bVisible;
+#else
+  if (pData->bCLONhasdonotshow)        /* DoNotShow flag filled ? */
+    bVisible = (mng_bool)(pData->iCLONdonotshow == 0);
+  else
+    bVisible = pSource->bVisible;
+#endif
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  bAbstract  = (mng_bool)(iConcrete == 1);
+#else
+  bAbstract  = (mng_bool)(pData->iCLONconcrete == 1);
+#endif
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  switch (iClonetype)                  /* determine action to take */
+  {
+    case 0 : {                         /* full clone */
+               iRetcode = mng_clone_imageobject (pData, iCloneid, MNG_FALSE,
+                                                 bVisible, bAbstract, bHasloca,
+                                                 iLocationtype, iLocationx, iLocationy,
+                                                 pSource, &pClone);
+               break;
+             }
+
+    case 1 : {                         /* partial clone */
+               iRetcode = mng_clone_imageobject (pData, iCloneid, MNG_TRUE,
+                                                 bVisible, bAbstract, bHasloca,
+                                                 iLocationtype, iLocationx, iLocationy,
+                                                 pSource, &pClone);
+               break;
+             }
+
+    case 2 : {                         /* renumber object */
+               iRetcode = mng_renum_imageobject (pData, pSource, iCloneid,
+                                                 bVisible, bAbstract, bHasloca,
+                                                 iLocationtype, iLocationx, iLocationy);
+               pClone   = pSource;
+               break;
+             }
+
+  }
+#else
+  switch (pData->iCLONclonetype)       /* determine action to take */
+  {
+    case 0 : {                         /* full clone */
+               iRetcode = mng_clone_imageobject (pData, pData->iCLONcloneid, MNG_FALSE,
+                                                 bVisible, bAbstract,
+                                                 pData->bCLONhasloca, pData->iCLONlocationtype,
+                                                 pData->iCLONlocationx, pData->iCLONlocationy,
+                                                 pSource, &pClone);
+               break;
+             }
+
+    case 1 : {                         /* partial clone */
+               iRetcode = mng_clone_imageobject (pData, pData->iCLONcloneid, MNG_TRUE,
+                                                 bVisible, bAbstract,
+                                                 pData->bCLONhasloca, pData->iCLONlocationtype,
+                                                 pData->iCLONlocationx, pData->iCLONlocationy,
+                                                 pSource, &pClone);
+               break;
+             }
+
+    case 2 : {                         /* renumber object */
+               iRetcode = mng_renum_imageobject (pData, pSource, pData->iCLONcloneid,
+                                                 bVisible, bAbstract,
+                                                 pData->bCLONhasloca, pData->iCLONlocationtype,
+                                                 pData->iCLONlocationx, pData->iCLONlocationy);
+               pClone   = pSource;
+               break;
+             }
+
+  }
+#endif
+
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+
+                                       /* display on the fly ? */
+  if ((pClone->bViewable) && (pClone->bVisible))
+  {
+    pData->pLastclone = pClone;        /* remember in case of timer break ! */
+                                       /* display it */
+    iRetcode = mng_display_image (pData, pClone, MNG_FALSE);
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+
+    if (pData->bTimerset)              /* timer break ? */
+      pData->iBreakpoint = 5;
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLON, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_process_display_clon2 (mng_datap pData)
+{
+  mng_retcode iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLON, MNG_LC_START);
+#endif
+                                       /* only called after timer break ! */
+  iRetcode = mng_display_image (pData, (mng_imagep)pData->pLastclone, MNG_FALSE);
+  pData->iBreakpoint = 0;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLON, MNG_LC_END);
+#endif
+
+  return iRetcode;
+}
+#endif
+
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_DISC
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_disc (mng_datap   pData,
+                                      mng_uint32  iCount,
+                                      mng_uint16p pIds)
+#else
+mng_retcode mng_process_display_disc (mng_datap   pData)
+#endif
+{
+  mng_uint32 iX;
+  mng_imagep pImage;
+  mng_uint32 iRetcode;
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DISC, MNG_LC_START);
+#endif
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  if (iCount)                          /* specific list ? */
+#else
+  if (pData->iDISCcount)               /* specific list ? */
+#endif
+  {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+    mng_uint16p pWork = pIds;
+#else
+    mng_uint16p pWork = pData->pDISCids;
+#endif
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+#ifdef MNG_DECREMENT_LOOPS             /* iterate the list */
+    for (iX = iCount; iX > 0; iX--)
+#else
+    for (iX = 0; iX < iCount; iX++)
+#endif
+#else
+#ifdef MNG_DECREMENT_LOOPS             /* iterate the list */
+    for (iX = pData->iDISCcount; iX > 0; iX--)
+#else
+    for (iX = 0; iX < pData->iDISCcount; iX++)
+#endif
+#endif
+    {
+      pImage = mng_find_imageobject (pData, *pWork++);
+
+      if (pImage)                      /* found the object ? */
+      {                                /* then drop it */
+        iRetcode = mng_free_imageobject (pData, pImage);
+
+        if (iRetcode)                  /* on error bail out */
+          return iRetcode;
+      }
+    }
+  }
+  else                                 /* empty: drop all un-frozen objects */
+  {
+    mng_imagep pNext = (mng_imagep)pData->pFirstimgobj;
+
+    while (pNext)                      /* any left ? */
+    {
+      pImage = pNext;
+      pNext  = pImage->sHeader.pNext;
+
+      if (!pImage->bFrozen)            /* not frozen ? */
+      {                                /* then drop it */
+        iRetcode = mng_free_imageobject (pData, pImage);
+                       
+        if (iRetcode)                  /* on error bail out */
+          return iRetcode;
+      }
+    }
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DISC, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif
+
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_FRAM
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_fram (mng_datap  pData,
+                                      mng_uint8  iFramemode,
+                                      mng_uint8  iChangedelay,
+                                      mng_uint32 iDelay,
+                                      mng_uint8  iChangetimeout,
+                                      mng_uint32 iTimeout,
+                                      mng_uint8  iChangeclipping,
+                                      mng_uint8  iCliptype,
+                                      mng_int32  iClipl,
+                                      mng_int32  iClipr,
+                                      mng_int32  iClipt,
+                                      mng_int32  iClipb)
+#else
+mng_retcode mng_process_display_fram (mng_datap  pData)
+#endif
+{
+  mng_retcode iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_FRAM, MNG_LC_START);
+#endif
+                                       /* advance a frame then */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  iRetcode = next_frame (pData, iFramemode, iChangedelay, iDelay,
+                         iChangetimeout, iTimeout, iChangeclipping,
+                         iCliptype, iClipl, iClipr, iClipt, iClipb);
+#else
+  iRetcode = next_frame (pData, pData->iTempFramemode, pData->iTempChangedelay,
+                         pData->iTempDelay, pData->iTempChangetimeout,
+                         pData->iTempTimeout, pData->iTempChangeclipping,
+                         pData->iTempCliptype, pData->iTempClipl, pData->iTempClipr,
+                         pData->iTempClipt, pData->iTempClipb);
+#endif
+
+  if (pData->bTimerset)                /* timer break ? */
+    pData->iBreakpoint = 1;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_FRAM, MNG_LC_END);
+#endif
+
+  return iRetcode;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_process_display_fram2 (mng_datap pData)
+{
+  mng_retcode iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_FRAM, MNG_LC_START);
+#endif
+                                       /* again; after the break */
+  iRetcode = next_frame (pData, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  pData->iBreakpoint = 0;              /* not again! */
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_FRAM, MNG_LC_END);
+#endif
+
+  return iRetcode;
+}
+#endif
+
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_MOVE
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_move (mng_datap  pData,
+                                      mng_uint16 iFromid,
+                                      mng_uint16 iToid,
+                                      mng_uint8  iMovetype,
+                                      mng_int32  iMovex,
+                                      mng_int32  iMovey)
+#else
+mng_retcode mng_process_display_move (mng_datap  pData)
+#endif
+{
+  mng_uint16 iX;
+  mng_imagep pImage;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MOVE, MNG_LC_START);
+#endif
+                                       /* iterate the list */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  for (iX = iFromid; iX <= iToid; iX++)
+#else
+  for (iX = pData->iMOVEfromid; iX <= pData->iMOVEtoid; iX++)
+#endif
+  {
+    if (!iX)                           /* object id=0 ? */
+      pImage = (mng_imagep)pData->pObjzero;
+    else
+      pImage = mng_find_imageobject (pData, iX);
+
+    if (pImage)                        /* object exists ? */
+    {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+      switch (iMovetype)
+#else
+      switch (pData->iMOVEmovetype)
+#endif
+      {
+        case 0 : {                     /* absolute */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   pImage->iPosx = iMovex;
+                   pImage->iPosy = iMovey;
+#else
+                   pImage->iPosx = pData->iMOVEmovex;
+                   pImage->iPosy = pData->iMOVEmovey;
+#endif
+                   break;
+                 }
+        case 1 : {                     /* relative */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   pImage->iPosx = pImage->iPosx + iMovex;
+                   pImage->iPosy = pImage->iPosy + iMovey;
+#else
+                   pImage->iPosx = pImage->iPosx + pData->iMOVEmovex;
+                   pImage->iPosy = pImage->iPosy + pData->iMOVEmovey;
+#endif
+                   break;
+                 }
+      }
+    }
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MOVE, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif
+
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_CLIP
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_clip (mng_datap  pData,
+                                      mng_uint16 iFromid,
+                                      mng_uint16 iToid,
+                                      mng_uint8  iCliptype,
+                                      mng_int32  iClipl,
+                                      mng_int32  iClipr,
+                                      mng_int32  iClipt,
+                                      mng_int32  iClipb)
+#else
+mng_retcode mng_process_display_clip (mng_datap  pData)
+#endif
+{
+  mng_uint16 iX;
+  mng_imagep pImage;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLIP, MNG_LC_START);
+#endif
+                                       /* iterate the list */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  for (iX = iFromid; iX <= iToid; iX++)
+#else
+  for (iX = pData->iCLIPfromid; iX <= pData->iCLIPtoid; iX++)
+#endif
+  {
+    if (!iX)                           /* object id=0 ? */
+      pImage = (mng_imagep)pData->pObjzero;
+    else
+      pImage = mng_find_imageobject (pData, iX);
+
+    if (pImage)                        /* object exists ? */
+    {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+      switch (iCliptype)
+#else
+      switch (pData->iCLIPcliptype)
+#endif
+      {
+        case 0 : {                     /* absolute */
+                   pImage->bClipped = MNG_TRUE;
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   pImage->iClipl   = iClipl;
+                   pImage->iClipr   = iClipr;
+                   pImage->iClipt   = iClipt;
+                   pImage->iClipb   = iClipb;
+#else
+                   pImage->iClipl   = pData->iCLIPclipl;
+                   pImage->iClipr   = pData->iCLIPclipr;
+                   pImage->iClipt   = pData->iCLIPclipt;
+                   pImage->iClipb   = pData->iCLIPclipb;
+#endif
+                   break;
+                 }
+        case 1 : {                    /* relative */
+                   pImage->bClipped = MNG_TRUE;
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   pImage->iClipl   = pImage->iClipl + iClipl;
+                   pImage->iClipr   = pImage->iClipr + iClipr;
+                   pImage->iClipt   = pImage->iClipt + iClipt;
+                   pImage->iClipb   = pImage->iClipb + iClipb;
+#else
+                   pImage->iClipl   = pImage->iClipl + pData->iCLIPclipl;
+                   pImage->iClipr   = pImage->iClipr + pData->iCLIPclipr;
+                   pImage->iClipt   = pImage->iClipt + pData->iCLIPclipt;
+                   pImage->iClipb   = pImage->iClipb + pData->iCLIPclipb;
+#endif
+                   break;
+                 }
+      }
+    }
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_CLIP, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif
+
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_SHOW
+mng_retcode mng_process_display_show (mng_datap pData)
+{
+  mng_int16   iX, iS, iFrom, iTo;
+  mng_imagep  pImage;
+  mng_retcode iRetcode = MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SHOW, MNG_LC_START);
+#endif
+
+  /* TODO: optimization for the cases where "abs (iTo - iFrom)" is rather high;
+     especially where ((iFrom==1) && (iTo==65535)); eg. an empty SHOW !!! */
+
+  if (pData->iBreakpoint == 3)         /* previously broken during cycle-mode ? */
+  {
+    pImage = mng_find_imageobject (pData, pData->iSHOWnextid);
+                 
+    if (pImage)                        /* still there ? */
+      iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
+
+    pData->iBreakpoint = 0;            /* let's not go through this again! */
+  }
+  else
+  {
+    if (pData->iBreakpoint)            /* previously broken at other point ? */
+    {                                  /* restore last parms */
+      iFrom = (mng_int16)pData->iSHOWfromid;
+      iTo   = (mng_int16)pData->iSHOWtoid;
+      iX    = (mng_int16)pData->iSHOWnextid;
+      iS    = (mng_int16)pData->iSHOWskip;
+    }
+    else
+    {                                  /* regular sequence ? */
+      if (pData->iSHOWtoid >= pData->iSHOWfromid)
+        iS  = 1;
+      else                             /* reverse sequence ! */
+        iS  = -1;
+
+      iFrom = (mng_int16)pData->iSHOWfromid;
+      iTo   = (mng_int16)pData->iSHOWtoid;
+      iX    = iFrom;
+
+      pData->iSHOWfromid = (mng_uint16)iFrom;
+      pData->iSHOWtoid   = (mng_uint16)iTo;
+      pData->iSHOWskip   = iS;
+    }
+                                       /* cycle mode ? */
+    if ((pData->iSHOWmode == 6) || (pData->iSHOWmode == 7))
+    {
+      mng_uint16 iTrigger = 0;
+      mng_uint16 iFound   = 0;
+      mng_uint16 iPass    = 0;
+      mng_imagep pFound   = 0;
+
+      do
+      {
+        iPass++;                       /* lets prevent endless loops when there
+                                          are no potential candidates in the list! */
+
+        if (iS > 0)                    /* forward ? */
+        {
+          for (iX = iFrom; iX <= iTo; iX += iS)
+          {
+            pImage = mng_find_imageobject (pData, (mng_uint16)iX);
+                         
+            if (pImage)                /* object exists ? */
+            {
+              if (iFound)              /* already found a candidate ? */
+                pImage->bVisible = MNG_FALSE;
+              else
+              if (iTrigger)            /* found the trigger ? */
+              {
+                pImage->bVisible = MNG_TRUE;
+                iFound           = iX;
+                pFound           = pImage;
+              }
+              else
+              if (pImage->bVisible)    /* ok, this is the trigger */
+              {
+                pImage->bVisible = MNG_FALSE;
+                iTrigger         = iX;
+              }
+            }
+          }
+        }
+        else
+        {
+          for (iX = iFrom; iX >= iTo; iX += iS)
+          {
+            pImage = mng_find_imageobject (pData, (mng_uint16)iX);
+                         
+            if (pImage)                /* object exists ? */
+            {
+              if (iFound)              /* already found a candidate ? */
+                pImage->bVisible = MNG_FALSE;
+              else
+              if (iTrigger)            /* found the trigger ? */
+              {
+                pImage->bVisible = MNG_TRUE;
+                iFound           = iX;
+                pFound           = pImage;
+              }
+              else
+              if (pImage->bVisible)    /* ok, this is the trigger */
+              {
+                pImage->bVisible = MNG_FALSE;
+                iTrigger         = iX;
+              }
+            }
+          }
+        }
+
+        if (!iTrigger)                 /* did not find a trigger ? */
+          iTrigger = 1;                /* then fake it so the first image
+                                          gets nominated */
+      }                                /* cycle back to beginning ? */
+      while ((iPass < 2) && (iTrigger) && (!iFound));
+
+      pData->iBreakpoint = 0;          /* just a sanity precaution */
+                                       /* display it ? */
+      if ((pData->iSHOWmode == 6) && (pFound))
+      {
+        iRetcode = mng_display_image (pData, pFound, MNG_FALSE);
+
+        if (pData->bTimerset)          /* timer set ? */
+        {
+          pData->iBreakpoint = 3;
+          pData->iSHOWnextid = iFound; /* save it for after the break */
+        }
+      }
+    }
+    else
+    {
+      do
+      {
+        pImage = mng_find_imageobject (pData, iX);
+                     
+        if (pImage)                    /* object exists ? */
+        {
+          if (pData->iBreakpoint)      /* did we get broken last time ? */
+          {                            /* could only happen in the display routine */
+            iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
+            pData->iBreakpoint = 0;    /* only once inside this loop please ! */
+          }
+          else
+          {
+            switch (pData->iSHOWmode)  /* do what ? */
+            {
+              case 0 : {
+                         pImage->bVisible = MNG_TRUE;
+                         iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
+                         break;
+                       }
+              case 1 : {
+                         pImage->bVisible = MNG_FALSE;
+                         break;
+                       }
+              case 2 : {
+                         if (pImage->bVisible)
+                           iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
+                         break;
+                       }
+              case 3 : {
+                         pImage->bVisible = MNG_TRUE;
+                         break;
+                       }
+              case 4 : {
+                         pImage->bVisible = (mng_bool)(!pImage->bVisible);
+                         if (pImage->bVisible)
+                           iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
+                         break;
+                       }
+              case 5 : {
+                         pImage->bVisible = (mng_bool)(!pImage->bVisible);
+                       }
+            }
+          }
+        }
+
+        if (!pData->bTimerset)         /* next ? */
+          iX += iS;
+
+      }                                /* continue ? */
+      while ((!iRetcode) && (!pData->bTimerset) &&
+             (((iS > 0) && (iX <= iTo)) || ((iS < 0) && (iX >= iTo))));
+
+      if (pData->bTimerset)            /* timer set ? */
+      {
+        pData->iBreakpoint = 4;
+        pData->iSHOWnextid = iX;       /* save for next time */
+      }
+      else
+        pData->iBreakpoint = 0;
+        
+    }
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SHOW, MNG_LC_END);
+#endif
+
+  return iRetcode;
+}
+#endif
+
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_SAVE
+mng_retcode mng_process_display_save (mng_datap pData)
+{
+  mng_retcode iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SAVE, MNG_LC_START);
+#endif
+
+  iRetcode = save_state (pData);       /* save the current state */
+
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SAVE, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif
+
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_SEEK
+mng_retcode mng_process_display_seek (mng_datap pData)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SEEK, MNG_LC_START);
+#endif
+
+#ifdef MNG_SUPPORT_DYNAMICMNG
+  if (pData->bStopafterseek)           /* need to stop after this SEEK ? */
+  {
+    pData->bFreezing      = MNG_TRUE;  /* stop processing on this one */
+    pData->bRunningevent  = MNG_FALSE;
+    pData->bStopafterseek = MNG_FALSE;
+    pData->bNeedrefresh   = MNG_TRUE;  /* make sure the last bit is displayed ! */
+  }
+  else
+#endif
+  {                                    /* restore the initial or SAVE state */
+    mng_retcode iRetcode = restore_state (pData);
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+
+#ifdef MNG_SUPPORT_DYNAMICMNG
+                                       /* stop after next SEEK ? */
+    if ((pData->bDynamic) || (pData->bRunningevent))
+      pData->bStopafterseek = MNG_TRUE;
+#endif
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_SEEK, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif
+
+/* ************************************************************************** */
+
+#ifdef MNG_INCLUDE_JNG
+mng_retcode mng_process_display_jhdr (mng_datap pData)
+{                                      /* address the current "object" if any */
+  mng_imagep  pImage   = (mng_imagep)pData->pCurrentobj;
+  mng_retcode iRetcode = MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JHDR, MNG_LC_START);
+#endif
+
+  if (!pData->bHasDHDR)
+  {
+    pData->fInitrowproc  = MNG_NULL;   /* do nothing by default */
+    pData->fDisplayrow   = MNG_NULL;
+    pData->fCorrectrow   = MNG_NULL;
+    pData->fStorerow     = MNG_NULL;
+    pData->fProcessrow   = MNG_NULL;
+    pData->fDifferrow    = MNG_NULL;
+    pData->fStorerow2    = MNG_NULL;
+    pData->fStorerow3    = MNG_NULL;
+
+    pData->pStoreobj     = MNG_NULL;   /* initialize important work-parms */
+
+    pData->iJPEGrow      = 0;
+    pData->iJPEGalpharow = 0;
+    pData->iJPEGrgbrow   = 0;
+    pData->iRowmax       = 0;          /* so init_rowproc does the right thing ! */
+  }
+
+  if (!pData->iBreakpoint)             /* not previously broken ? */
+  {
+#ifndef MNG_NO_DELTA_PNG
+    if (pData->bHasDHDR)               /* delta-image ? */
+    {
+      if (pData->iDeltatype == MNG_DELTATYPE_REPLACE)
+      {
+        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pDeltaImage,
+                                             pData->iDatawidth, pData->iDataheight,
+                                             pData->iJHDRimgbitdepth, pData->iJHDRcolortype,
+                                             pData->iJHDRalphacompression, pData->iJHDRalphafilter,
+                                             pData->iJHDRalphainterlace, MNG_TRUE);
+
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphabitdepth    = pData->iJHDRalphabitdepth;
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iJHDRcompression  = pData->iJHDRimgcompression;
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iJHDRinterlace    = pData->iJHDRimginterlace;
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
+      }
+      else
+      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKPIXELADD    ) ||
+          (pData->iDeltatype == MNG_DELTATYPE_BLOCKPIXELREPLACE)    )
+      {
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iPixelsampledepth = pData->iJHDRimgbitdepth;
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
+      }
+      else
+      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKALPHAADD    ) ||
+          (pData->iDeltatype == MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
+      else
+      if ((pData->iDeltatype == MNG_DELTATYPE_BLOCKCOLORADD    ) ||
+          (pData->iDeltatype == MNG_DELTATYPE_BLOCKCOLORREPLACE)    )
+        ((mng_imagep)pData->pDeltaImage)->pImgbuf->iPixelsampledepth = pData->iJHDRimgbitdepth;
+        
+    }
+    else
+#endif /* MNG_NO_DELTA_PNG */
+    {
+      if (pImage)                      /* update object buffer ? */
+      {
+        iRetcode = mng_reset_object_details (pData, pImage,
+                                             pData->iDatawidth, pData->iDataheight,
+                                             pData->iJHDRimgbitdepth, pData->iJHDRcolortype,
+                                             pData->iJHDRalphacompression, pData->iJHDRalphafilter,
+                                             pData->iJHDRalphainterlace, MNG_TRUE);
+
+        pImage->pImgbuf->iAlphabitdepth    = pData->iJHDRalphabitdepth;
+        pImage->pImgbuf->iJHDRcompression  = pData->iJHDRimgcompression;
+        pImage->pImgbuf->iJHDRinterlace    = pData->iJHDRimginterlace;
+        pImage->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
+      }
+      else                             /* update object 0 */
+      {
+        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
+                                             pData->iDatawidth, pData->iDataheight,
+                                             pData->iJHDRimgbitdepth, pData->iJHDRcolortype,
+                                             pData->iJHDRalphacompression, pData->iJHDRalphafilter,
+                                             pData->iJHDRalphainterlace, MNG_TRUE);
+
+        ((mng_imagep)pData->pObjzero)->pImgbuf->iAlphabitdepth    = pData->iJHDRalphabitdepth;
+        ((mng_imagep)pData->pObjzero)->pImgbuf->iJHDRcompression  = pData->iJHDRimgcompression;
+        ((mng_imagep)pData->pObjzero)->pImgbuf->iJHDRinterlace    = pData->iJHDRimginterlace;
+        ((mng_imagep)pData->pObjzero)->pImgbuf->iAlphasampledepth = pData->iJHDRalphabitdepth;
+      }
+    }
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+  }
+
+  if (!pData->bHasDHDR)
+  {                                    /* we're always storing a JPEG */
+    if (pImage)                        /* real object ? */
+      pData->pStoreobj = pImage;       /* tell the row routines */
+    else                               /* otherwise use object 0 */
+      pData->pStoreobj = pData->pObjzero;
+                                       /* display "on-the-fly" ? */
+    if (
+#ifndef MNG_SKIPCHUNK_MAGN
+         ( ((mng_imagep)pData->pStoreobj)->iMAGN_MethodX == 0) &&
+         ( ((mng_imagep)pData->pStoreobj)->iMAGN_MethodY == 0) &&
+#endif
+         ( (pData->eImagetype == mng_it_jng         ) ||
+           (((mng_imagep)pData->pStoreobj)->bVisible)    )       )
+    {
+      iRetcode = next_layer (pData);   /* that's a new layer then ! */
+
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
+
+      pData->iBreakpoint = 0;
+
+      if (pData->bTimerset)            /* timer break ? */
+        pData->iBreakpoint = 7;
+      else
+      if (pData->bRunning)             /* still running ? */
+      {                                /* anything to display ? */
+        if ((pData->iDestr > pData->iDestl) && (pData->iDestb > pData->iDestt))
+        {
+          set_display_routine (pData); /* then determine display routine */
+                                       /* display from the object we store in */
+          pData->pRetrieveobj = pData->pStoreobj;
+        }
+      }
+    }
+  }
+
+  if (!pData->bTimerset)               /* no timer break ? */
+  {                                    /* default row initialization ! */
+#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
+    pData->ePng_imgtype=png_none;
+#endif
+    pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
+
+    if ((!pData->bHasDHDR) || (pData->iDeltatype == MNG_DELTATYPE_REPLACE))
+    {                                  /* 8-bit JPEG ? */
+      if (pData->iJHDRimgbitdepth == 8)
+      {                                /* intermediate row is 8-bit deep */
+        pData->bIsRGBA16   = MNG_FALSE;
+        pData->iRowsamples = pData->iDatawidth;
+
+        switch (pData->iJHDRcolortype) /* determine pixel processing routines */
+        {
+          case MNG_COLORTYPE_JPEGGRAY :
+               {
+                 pData->fStorerow2   = (mng_fptr)mng_store_jpeg_g8;
+                 pData->fRetrieverow = (mng_fptr)mng_retrieve_g8;
+                 pData->bIsOpaque    = MNG_TRUE;
+                 break;
+               }
+          case MNG_COLORTYPE_JPEGCOLOR :
+               {
+                 pData->fStorerow2   = (mng_fptr)mng_store_jpeg_rgb8;
+                 pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb8;
+                 pData->bIsOpaque    = MNG_TRUE;
+                 break;
+               }
+          case MNG_COLORTYPE_JPEGGRAYA :
+               {
+                 pData->fStorerow2   = (mng_fptr)mng_store_jpeg_ga8;
+                 pData->fRetrieverow = (mng_fptr)mng_retrieve_ga8;
+                 pData->bIsOpaque    = MNG_FALSE;
+                 break;
+               }
+          case MNG_COLORTYPE_JPEGCOLORA :
+               {
+                 pData->fStorerow2   = (mng_fptr)mng_store_jpeg_rgba8;
+                 pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba8;
+                 pData->bIsOpaque    = MNG_FALSE;
+                 break;
+               }
+        }
+      }
+#ifndef MNG_NO_16BIT_SUPPORT
+      else
+      {
+        pData->bIsRGBA16 = MNG_TRUE;   /* intermediate row is 16-bit deep */
+
+        /* TODO: 12-bit JPEG */
+        /* TODO: 8- + 12-bit JPEG (eg. type=20) */
+
+      }
+#endif
+                                       /* possible IDAT alpha-channel ? */
+      if (pData->iJHDRalphacompression == MNG_COMPRESSION_DEFLATE)
+      {
+                                       /* determine alpha processing routine */
+#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
+        pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
+#endif
+        switch (pData->iJHDRalphabitdepth)
+        {
+#ifndef MNG_OPTIMIZE_FOOTPRINT_INIT
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+          case  1 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a1_ni;  break; }
+          case  2 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a2_ni;  break; }
+          case  4 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a4_ni;  break; }
+#endif /* MNG_NO_1_2_4BIT_SUPPORT */
+          case  8 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a8_ni;  break; }
+#ifndef MNG_NO_16BIT_SUPPORT
+          case 16 : { pData->fInitrowproc = (mng_fptr)mng_init_jpeg_a16_ni; break; }
+#endif
+#else
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+          case  1 : { pData->ePng_imgtype = png_jpeg_a1;  break; }
+          case  2 : { pData->ePng_imgtype = png_jpeg_a2;  break; }
+          case  4 : { pData->ePng_imgtype = png_jpeg_a4;  break; }
+#endif /* MNG_NO_1_2_4BIT_SUPPORT */
+          case  8 : { pData->ePng_imgtype = png_jpeg_a8;  break; }
+#ifndef MNG_NO_16BIT_SUPPORT
+          case 16 : { pData->ePng_imgtype = png_jpeg_a16; break; }
+#endif
+#endif
+        }
+      }
+      else                             /* possible JDAA alpha-channel ? */
+      if (pData->iJHDRalphacompression == MNG_COMPRESSION_BASELINEJPEG)
+      {                                /* 8-bit JPEG ? */
+        if (pData->iJHDRimgbitdepth == 8)
+        {
+          if (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGGRAYA)
+            pData->fStorerow3 = (mng_fptr)mng_store_jpeg_g8_alpha;
+          else
+          if (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGCOLORA)
+            pData->fStorerow3 = (mng_fptr)mng_store_jpeg_rgb8_alpha;
+        }
+        else
+        {
+          /* TODO: 12-bit JPEG with 8-bit JDAA */
+        }
+      }
+                                       /* initialize JPEG library */
+      iRetcode = mngjpeg_initialize (pData);
+
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
+    }
+    else
+    {                                  /* must be alpha add/replace !! */
+      if ((pData->iDeltatype != MNG_DELTATYPE_BLOCKALPHAADD    ) &&
+          (pData->iDeltatype != MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
+        MNG_ERROR (pData, MNG_INVDELTATYPE);
+                                       /* determine alpha processing routine */
+#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
+        pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
+#endif
+      switch (pData->iJHDRalphabitdepth)
+      {
+#ifndef MNG_OPTIMIZE_FOOTPRINT_INIT
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+        case  1 : { pData->fInitrowproc = (mng_fptr)mng_init_g1_ni;  break; }
+        case  2 : { pData->fInitrowproc = (mng_fptr)mng_init_g2_ni;  break; }
+        case  4 : { pData->fInitrowproc = (mng_fptr)mng_init_g4_ni;  break; }
+#endif /* MNG_NO_1_2_4BIT_SUPPORT */
+        case  8 : { pData->fInitrowproc = (mng_fptr)mng_init_g8_ni;  break; }
+#ifndef MNG_NO_16BIT_SUPPORT
+        case 16 : { pData->fInitrowproc = (mng_fptr)mng_init_g16_ni; break; }
+#endif
+#else
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+        case  1 : { pData->ePng_imgtype = png_jpeg_a1;  break; }
+        case  2 : { pData->ePng_imgtype = png_jpeg_a2;  break; }
+        case  4 : { pData->ePng_imgtype = png_jpeg_a4;  break; }
+#endif /* MNG_NO_1_2_4BIT_SUPPORT */
+        case  8 : { pData->ePng_imgtype = png_jpeg_a8;  break; }
+#ifndef MNG_NO_16BIT_SUPPORT
+        case 16 : { pData->ePng_imgtype = png_jpeg_a16; break; }
+#endif
+#endif /* MNG_OPTIMIZE_FOOTPRINT_INIT */
+      }
+    }
+
+    pData->iFilterofs = 0;             /* determine filter characteristics */
+    pData->iLevel0    = 0;             /* default levels */
+    pData->iLevel1    = 0;    
+    pData->iLevel2    = 0;
+    pData->iLevel3    = 0;
+
+#ifdef FILTER192                       /* leveling & differing ? */
+    if (pData->iJHDRalphafilter == 0xC0)
+    {
+       if (pData->iJHDRalphabitdepth <= 8)
+         pData->iFilterofs = 1;
+       else
+         pData->iFilterofs = 2;
+
+    }
+#endif
+#ifdef FILTER193                       /* no adaptive filtering ? */
+    if (pData->iJHDRalphafilter == 0xC1)
+      pData->iPixelofs = pData->iFilterofs;
+    else
+#endif
+      pData->iPixelofs = pData->iFilterofs + 1;
+
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JHDR, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_INCLUDE_JNG */
+
+/* ************************************************************************** */
+
+#ifdef MNG_INCLUDE_JNG
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_jdaa (mng_datap  pData,
+                                      mng_uint32 iRawlen,
+                                      mng_uint8p pRawdata)
+#else
+mng_retcode mng_process_display_jdaa (mng_datap  pData)
+#endif
+{
+  mng_retcode iRetcode = MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JDAA, MNG_LC_START);
+#endif
+
+  if (!pData->bJPEGdecompress2)        /* if we're not decompressing already */
+  {
+    if (pData->fInitrowproc)           /* initialize row-processing? */
+    {
+      iRetcode = ((mng_initrowproc)pData->fInitrowproc) (pData);
+      pData->fInitrowproc = MNG_NULL;  /* only call this once !!! */
+    }
+
+    if (!iRetcode)                     /* initialize decompress */
+      iRetcode = mngjpeg_decompressinit2 (pData);
+  }
+
+  if (!iRetcode)                       /* all ok? then decompress, my man */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+    iRetcode = mngjpeg_decompressdata2 (pData, iRawlen, pRawdata);
+#else
+    iRetcode = mngjpeg_decompressdata2 (pData, pData->iRawlen, pData->pRawdata);
+#endif
+
+  if (iRetcode)
+    return iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JDAA, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_INCLUDE_JNG */
+
+/* ************************************************************************** */
+
+#ifdef MNG_INCLUDE_JNG
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_jdat (mng_datap  pData,
+                                      mng_uint32 iRawlen,
+                                      mng_uint8p pRawdata)
+#else
+mng_retcode mng_process_display_jdat (mng_datap  pData)
+#endif
+{
+  mng_retcode iRetcode = MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JDAT, MNG_LC_START);
+#endif
+
+  if (pData->bRestorebkgd)             /* need to restore the background ? */
+  {
+    pData->bRestorebkgd = MNG_FALSE;
+    iRetcode            = load_bkgdlayer (pData);
+
+    pData->iLayerseq++;                /* and it counts as a layer then ! */
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+  }
+
+  if (!pData->bJPEGdecompress)         /* if we're not decompressing already */
+  {
+    if (pData->fInitrowproc)           /* initialize row-processing? */
+    {
+      iRetcode = ((mng_initrowproc)pData->fInitrowproc) (pData);
+      pData->fInitrowproc = MNG_NULL;  /* only call this once !!! */
+    }
+
+    if (!iRetcode)                     /* initialize decompress */
+      iRetcode = mngjpeg_decompressinit (pData);
+  }
+
+  if (!iRetcode)                       /* all ok? then decompress, my man */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+    iRetcode = mngjpeg_decompressdata (pData, iRawlen, pRawdata);
+#else
+    iRetcode = mngjpeg_decompressdata (pData, pData->iRawlen, pData->pRawdata);
+#endif
+
+  if (iRetcode)
+    return iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_JDAT, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_INCLUDE_JNG */
+
+/* ************************************************************************** */
+
+#ifndef MNG_NO_DELTA_PNG
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_dhdr (mng_datap  pData,
+                                      mng_uint16 iObjectid,
+                                      mng_uint8  iImagetype,
+                                      mng_uint8  iDeltatype,
+                                      mng_uint32 iBlockwidth,
+                                      mng_uint32 iBlockheight,
+                                      mng_uint32 iBlockx,
+                                      mng_uint32 iBlocky)
+#else
+mng_retcode mng_process_display_dhdr (mng_datap  pData)
+#endif
+{
+  mng_imagep  pImage;
+  mng_retcode iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DHDR, MNG_LC_START);
+#endif
+
+  pData->fInitrowproc     = MNG_NULL;  /* do nothing by default */
+  pData->fDisplayrow      = MNG_NULL;
+  pData->fCorrectrow      = MNG_NULL;
+  pData->fStorerow        = MNG_NULL;
+  pData->fProcessrow      = MNG_NULL;
+  pData->pStoreobj        = MNG_NULL;
+
+  pData->fDeltagetrow     = MNG_NULL;
+  pData->fDeltaaddrow     = MNG_NULL;
+  pData->fDeltareplacerow = MNG_NULL;
+  pData->fDeltaputrow     = MNG_NULL;
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  pImage = mng_find_imageobject (pData, iObjectid);
+#else
+  pImage = mng_find_imageobject (pData, pData->iDHDRobjectid);
+#endif
+
+  if (pImage)                          /* object exists ? */
+  {
+    if (pImage->pImgbuf->bConcrete)    /* is it concrete ? */
+    {                                  /* previous magnification to be done ? */
+#ifndef MNG_SKIPCHUNK_MAGN
+      if ((pImage->iMAGN_MethodX) || (pImage->iMAGN_MethodY))
+      {
+        iRetcode = mng_magnify_imageobject (pData, pImage);
+                       
+        if (iRetcode)                  /* on error bail out */
+          return iRetcode;
+      }
+#endif
+                                       /* save delta fields */
+      pData->pDeltaImage           = (mng_ptr)pImage;
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+      pData->iDeltaImagetype       = iImagetype;
+      pData->iDeltatype            = iDeltatype;
+      pData->iDeltaBlockwidth      = iBlockwidth;
+      pData->iDeltaBlockheight     = iBlockheight;
+      pData->iDeltaBlockx          = iBlockx;
+      pData->iDeltaBlocky          = iBlocky;
+#else
+      pData->iDeltaImagetype       = pData->iDHDRimagetype;
+      pData->iDeltatype            = pData->iDHDRdeltatype;
+      pData->iDeltaBlockwidth      = pData->iDHDRblockwidth;
+      pData->iDeltaBlockheight     = pData->iDHDRblockheight;
+      pData->iDeltaBlockx          = pData->iDHDRblockx;
+      pData->iDeltaBlocky          = pData->iDHDRblocky;
+#endif
+                                       /* restore target-object fields */
+      pData->iDatawidth            = pImage->pImgbuf->iWidth;
+      pData->iDataheight           = pImage->pImgbuf->iHeight;
+      pData->iBitdepth             = pImage->pImgbuf->iBitdepth;
+      pData->iColortype            = pImage->pImgbuf->iColortype;
+      pData->iCompression          = pImage->pImgbuf->iCompression;
+      pData->iFilter               = pImage->pImgbuf->iFilter;
+      pData->iInterlace            = pImage->pImgbuf->iInterlace;
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+      if ((iDeltatype == MNG_DELTATYPE_BLOCKPIXELADD    ) ||
+          (iDeltatype == MNG_DELTATYPE_BLOCKPIXELREPLACE)    )
+        pData->iBitdepth           = pImage->pImgbuf->iPixelsampledepth;
+      else
+      if ((iDeltatype == MNG_DELTATYPE_BLOCKALPHAADD    ) ||
+          (iDeltatype == MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
+        pData->iBitdepth           = pImage->pImgbuf->iAlphasampledepth;
+      else
+      if ((iDeltatype == MNG_DELTATYPE_BLOCKCOLORADD    ) ||
+          (iDeltatype == MNG_DELTATYPE_BLOCKCOLORREPLACE)    )
+        pData->iBitdepth           = pImage->pImgbuf->iPixelsampledepth;
+#else
+      if ((pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKPIXELADD    ) ||
+          (pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKPIXELREPLACE)    )
+        pData->iBitdepth           = pImage->pImgbuf->iPixelsampledepth;
+      else
+      if ((pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKALPHAADD    ) ||
+          (pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKALPHAREPLACE)    )
+        pData->iBitdepth           = pImage->pImgbuf->iAlphasampledepth;
+      else
+      if ((pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKCOLORADD    ) ||
+          (pData->iDHDRdeltatype == MNG_DELTATYPE_BLOCKCOLORREPLACE)    )
+        pData->iBitdepth           = pImage->pImgbuf->iPixelsampledepth;
+#endif
+
+#ifdef MNG_INCLUDE_JNG
+      pData->iJHDRimgbitdepth      = pImage->pImgbuf->iBitdepth;
+      pData->iJHDRcolortype        = pImage->pImgbuf->iColortype;
+      pData->iJHDRimgcompression   = pImage->pImgbuf->iJHDRcompression;
+      pData->iJHDRimginterlace     = pImage->pImgbuf->iJHDRinterlace;
+      pData->iJHDRalphacompression = pImage->pImgbuf->iCompression;
+      pData->iJHDRalphafilter      = pImage->pImgbuf->iFilter;
+      pData->iJHDRalphainterlace   = pImage->pImgbuf->iInterlace;
+      pData->iJHDRalphabitdepth    = pImage->pImgbuf->iAlphabitdepth;
+#endif
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                                       /* block size specified ? */
+      if (iDeltatype != MNG_DELTATYPE_NOCHANGE)
+      {                                /* block entirely within target ? */
+        if (iDeltatype != MNG_DELTATYPE_REPLACE)
+        {
+          if (((iBlockx + iBlockwidth ) > pData->iDatawidth ) ||
+              ((iBlocky + iBlockheight) > pData->iDataheight)    )
+            MNG_ERROR (pData, MNG_INVALIDBLOCK);
+        }
+
+        pData->iDatawidth          = iBlockwidth;
+        pData->iDataheight         = iBlockheight;
+      }
+#else
+                                       /* block size specified ? */
+      if (pData->iDHDRdeltatype != MNG_DELTATYPE_NOCHANGE)
+      {                                /* block entirely within target ? */
+        if (pData->iDHDRdeltatype != MNG_DELTATYPE_REPLACE)
+        {
+          if (((pData->iDHDRblockx + pData->iDHDRblockwidth ) > pData->iDatawidth ) ||
+              ((pData->iDHDRblocky + pData->iDHDRblockheight) > pData->iDataheight)    )
+            MNG_ERROR (pData, MNG_INVALIDBLOCK);
+        }
+
+        pData->iDatawidth          = pData->iDHDRblockwidth;
+        pData->iDataheight         = pData->iDHDRblockheight;
+      }
+#endif
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+      switch (iDeltatype)              /* determine nr of delta-channels */
+#else
+      switch (pData->iDHDRdeltatype)   /* determine nr of delta-channels */
+#endif
+      {
+         case MNG_DELTATYPE_BLOCKALPHAADD : ;
+         case MNG_DELTATYPE_BLOCKALPHAREPLACE :
+              {
 #ifdef MNG_INCLUDE_JNG
                 if ((pData->iColortype     == MNG_COLORTYPE_GRAYA    ) ||
                     (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGGRAYA)    )
@@ -5561,945 +7175,1538 @@ mng_retcode mng_process_display_dhdr (mng_datap  pData)
                 if (pData->iColortype      == MNG_COLORTYPE_RGBA)
                   pData->iColortype     = MNG_COLORTYPE_GRAY;
 #endif
-                else                   /* target has no alpha; that sucks! */
-                  MNG_ERROR (pData, MNG_TARGETNOALPHA);
+                else                   /* target has no alpha; that sucks! */
+                  MNG_ERROR (pData, MNG_TARGETNOALPHA);
+
+                break;
+              }
+
+         case MNG_DELTATYPE_BLOCKCOLORADD : ;
+         case MNG_DELTATYPE_BLOCKCOLORREPLACE :
+              {
+#ifdef MNG_INCLUDE_JNG
+                if ((pData->iColortype     == MNG_COLORTYPE_GRAYA    ) ||
+                    (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGGRAYA)    )
+                {
+                  pData->iColortype     = MNG_COLORTYPE_GRAY;
+                  pData->iJHDRcolortype = MNG_COLORTYPE_JPEGGRAY;
+                }
+                else
+                if ((pData->iColortype     == MNG_COLORTYPE_RGBA      ) ||
+                    (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGCOLORA)    )
+                {
+                  pData->iColortype     = MNG_COLORTYPE_RGB;
+                  pData->iJHDRcolortype = MNG_COLORTYPE_JPEGCOLOR;
+                }
+#else
+                if (pData->iColortype == MNG_COLORTYPE_GRAYA)
+                  pData->iColortype = MNG_COLORTYPE_GRAY;
+                else
+                if (pData->iColortype == MNG_COLORTYPE_RGBA)
+                  pData->iColortype = MNG_COLORTYPE_RGB;
+#endif                  
+                else                   /* target has no alpha; that sucks! */
+                  MNG_ERROR (pData, MNG_TARGETNOALPHA);
+
+                break;
+              }
+
+      }
+                                       /* full image replace ? */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+      if (iDeltatype == MNG_DELTATYPE_REPLACE)
+#else
+      if (pData->iDHDRdeltatype == MNG_DELTATYPE_REPLACE)
+#endif
+      {
+        iRetcode = mng_reset_object_details (pData, pImage,
+                                             pData->iDatawidth, pData->iDataheight,
+                                             pData->iBitdepth, pData->iColortype,
+                                             pData->iCompression, pData->iFilter,
+                                             pData->iInterlace, MNG_FALSE);
+
+        if (iRetcode)                  /* on error bail out */
+          return iRetcode;
+
+        pData->pStoreobj = pImage;     /* and store straight into this object */
+      }
+      else
+      {
+        mng_imagedatap pBufzero, pBuf;
+                                       /* we store in object 0 and process it later */
+        pData->pStoreobj = pData->pObjzero;
+                                       /* make sure to initialize object 0 then */
+        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
+                                             pData->iDatawidth, pData->iDataheight,
+                                             pData->iBitdepth, pData->iColortype,
+                                             pData->iCompression, pData->iFilter,
+                                             pData->iInterlace, MNG_TRUE);
+
+        if (iRetcode)                  /* on error bail out */
+          return iRetcode;
+
+        pBuf     = pImage->pImgbuf;    /* copy possible palette & cheap transparency */
+        pBufzero = ((mng_imagep)pData->pObjzero)->pImgbuf;
+
+        pBufzero->bHasPLTE = pBuf->bHasPLTE;
+        pBufzero->bHasTRNS = pBuf->bHasTRNS;
+
+        if (pBufzero->bHasPLTE)        /* copy palette ? */
+        {
+          mng_uint32 iX;
+
+          pBufzero->iPLTEcount = pBuf->iPLTEcount;
+
+          for (iX = 0; iX < pBuf->iPLTEcount; iX++)
+          {
+            pBufzero->aPLTEentries [iX].iRed   = pBuf->aPLTEentries [iX].iRed;
+            pBufzero->aPLTEentries [iX].iGreen = pBuf->aPLTEentries [iX].iGreen;
+            pBufzero->aPLTEentries [iX].iBlue  = pBuf->aPLTEentries [iX].iBlue;
+          }
+        }
+
+        if (pBufzero->bHasTRNS)        /* copy cheap transparency ? */
+        {
+          pBufzero->iTRNSgray  = pBuf->iTRNSgray;
+          pBufzero->iTRNSred   = pBuf->iTRNSred;
+          pBufzero->iTRNSgreen = pBuf->iTRNSgreen;
+          pBufzero->iTRNSblue  = pBuf->iTRNSblue;
+          pBufzero->iTRNScount = pBuf->iTRNScount;
+
+          MNG_COPY (pBufzero->aTRNSentries, pBuf->aTRNSentries,
+                    sizeof (pBufzero->aTRNSentries));
+        }
+                                       /* process immediately if bitdepth & colortype are equal */
+        pData->bDeltaimmediate =
+          (mng_bool)((pData->bDisplaying) && (!pData->bSkipping) &&
+                     ((pData->bRunning) || (pData->bSearching)) &&
+                     (pData->iBitdepth  == ((mng_imagep)pData->pDeltaImage)->pImgbuf->iBitdepth ) &&
+                     (pData->iColortype == ((mng_imagep)pData->pDeltaImage)->pImgbuf->iColortype)    );
+      }
+ 
+#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
+  pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
+  pData->ePng_imgtype = mng_png_imgtype (pData->iColortype, pData->iBitdepth);
+#else
+      switch (pData->iColortype)       /* determine row initialization routine */
+      {
+        case 0 : {                     /* gray */
+                   switch (pData->iBitdepth)
+                   {
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+                     case  1 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g1_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g1_i;
+
+                                 break;
+                               }
+                     case  2 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g2_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g2_i;
+
+                                 break;
+                               }
+                     case  4 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g4_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g4_i;
+
+                                 break;
+                               }
+#endif /* MNG_NO_1_2_4BIT_SUPPORT */
+                     case  8 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g8_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g8_i;
+
+                                 break;
+                               }
+#ifndef MNG_NO_16BIT_SUPPORT
+                     case 16 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g16_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_g16_i;
+
+                                 break;
+                               }
+#endif
+                   }
+
+                   break;
+                 }
+        case 2 : {                     /* rgb */
+                   switch (pData->iBitdepth)
+                   {
+                     case  8 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_rgb8_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_rgb8_i;
+
+                                 break;
+                               }
+#ifndef MNG_NO_16BIT_SUPPORT
+                     case 16 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_rgb16_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_rgb16_i;
+
+                                 break;
+                               }
+#endif
+                   }
+
+                   break;
+                 }
+        case 3 : {                     /* indexed */
+                   switch (pData->iBitdepth)
+                   {
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+                     case  1 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_idx1_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_idx1_i;
+
+                                 break;
+                               }
+                     case  2 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_idx2_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_idx2_i;
+
+                                 break;
+                               }
+                     case  4 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_idx4_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_idx4_i;
+
+                                 break;
+                               }
+#endif /* MNG_NO_1_2_4BIT_SUPPORT */
+                     case  8 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_idx8_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_idx8_i;
+
+                                 break;
+                               }
+                   }
+
+                   break;
+                 }
+        case 4 : {                     /* gray+alpha */
+                   switch (pData->iBitdepth)
+                   {
+                     case  8 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_ga8_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_ga8_i;
+
+                                 break;
+                               }
+#ifndef MNG_NO_16BIT_SUPPORT
+                     case 16 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_ga16_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_ga16_i;
+
+                                 break;
+                               }
+#endif
+                   }
 
-                break;
-              }
+                   break;
+                 }
+        case 6 : {                     /* rgb+alpha */
+                   switch (pData->iBitdepth)
+                   {
+                     case  8 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_rgba8_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_rgba8_i;
 
-         case MNG_DELTATYPE_BLOCKCOLORADD : ;
-         case MNG_DELTATYPE_BLOCKCOLORREPLACE :
-              {
-#ifdef MNG_INCLUDE_JNG
-                if ((pData->iColortype     == MNG_COLORTYPE_GRAYA    ) ||
-                    (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGGRAYA)    )
-                {
-                  pData->iColortype     = MNG_COLORTYPE_GRAY;
-                  pData->iJHDRcolortype = MNG_COLORTYPE_JPEGGRAY;
-                }
-                else
-                if ((pData->iColortype     == MNG_COLORTYPE_RGBA      ) ||
-                    (pData->iJHDRcolortype == MNG_COLORTYPE_JPEGCOLORA)    )
-                {
-                  pData->iColortype     = MNG_COLORTYPE_RGB;
-                  pData->iJHDRcolortype = MNG_COLORTYPE_JPEGCOLOR;
-                }
-#else
-                if (pData->iColortype == MNG_COLORTYPE_GRAYA)
-                  pData->iColortype = MNG_COLORTYPE_GRAY;
-                else
-                if (pData->iColortype == MNG_COLORTYPE_RGBA)
-                  pData->iColortype = MNG_COLORTYPE_RGB;
-#endif                  
-                else                   /* target has no alpha; that sucks! */
-                  MNG_ERROR (pData, MNG_TARGETNOALPHA);
+                                 break;
+                               }
+#ifndef MNG_NO_16BIT_SUPPORT
+                     case 16 : {
+                                 if (!pData->iInterlace)
+                                   pData->fInitrowproc = (mng_fptr)mng_init_rgba16_ni;
+                                 else
+                                   pData->fInitrowproc = (mng_fptr)mng_init_rgba16_i;
 
-                break;
-              }
+                                 break;
+                               }
+#endif
+                   }
 
+                   break;
+                 }
       }
-                                       /* full image replace ? */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      if (iDeltatype == MNG_DELTATYPE_REPLACE)
-#else
-      if (pData->iDHDRdeltatype == MNG_DELTATYPE_REPLACE)
-#endif
-      {
-        iRetcode = mng_reset_object_details (pData, pImage,
-                                             pData->iDatawidth, pData->iDataheight,
-                                             pData->iBitdepth, pData->iColortype,
-                                             pData->iCompression, pData->iFilter,
-                                             pData->iInterlace, MNG_FALSE);
+#endif /* MNG_OPTIMIZE_FOOTPRINT_INIT */
+    }
+    else
+      MNG_ERROR (pData, MNG_OBJNOTCONCRETE);
 
-        if (iRetcode)                  /* on error bail out */
-          return iRetcode;
+  }
+  else
+    MNG_ERROR (pData, MNG_OBJECTUNKNOWN);
 
-        pData->pStoreobj = pImage;     /* and store straight into this object */
-      }
-      else
-      {
-        mng_imagedatap pBufzero, pBuf;
-                                       /* we store in object 0 and process it later */
-        pData->pStoreobj = pData->pObjzero;
-                                       /* make sure to initialize object 0 then */
-        iRetcode = mng_reset_object_details (pData, (mng_imagep)pData->pObjzero,
-                                             pData->iDatawidth, pData->iDataheight,
-                                             pData->iBitdepth, pData->iColortype,
-                                             pData->iCompression, pData->iFilter,
-                                             pData->iInterlace, MNG_TRUE);
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DHDR, MNG_LC_END);
+#endif
 
-        if (iRetcode)                  /* on error bail out */
-          return iRetcode;
+  return MNG_NOERROR;
+}
+#endif
 
-        pBuf     = pImage->pImgbuf;    /* copy possible palette & cheap transparency */
-        pBufzero = ((mng_imagep)pData->pObjzero)->pImgbuf;
+/* ************************************************************************** */
 
-        pBufzero->bHasPLTE = pBuf->bHasPLTE;
-        pBufzero->bHasTRNS = pBuf->bHasTRNS;
+#ifndef MNG_NO_DELTA_PNG
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_prom (mng_datap  pData,
+                                      mng_uint8  iBitdepth,
+                                      mng_uint8  iColortype,
+                                      mng_uint8  iFilltype)
+#else
+mng_retcode mng_process_display_prom (mng_datap  pData)
+#endif
+{
+  mng_imagep     pImage;
+  mng_imagedatap pBuf;
+  mng_retcode    iRetcode;
 
-        if (pBufzero->bHasPLTE)        /* copy palette ? */
-        {
-          mng_uint32 iX;
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_PROM, MNG_LC_START);
+#endif
 
-          pBufzero->iPLTEcount = pBuf->iPLTEcount;
+  if (!pData->pDeltaImage)             /* gotta have this now! */
+    MNG_ERROR (pData, MNG_INVALIDDELTA);
 
-          for (iX = 0; iX < pBuf->iPLTEcount; iX++)
-          {
-            pBufzero->aPLTEentries [iX].iRed   = pBuf->aPLTEentries [iX].iRed;
-            pBufzero->aPLTEentries [iX].iGreen = pBuf->aPLTEentries [iX].iGreen;
-            pBufzero->aPLTEentries [iX].iBlue  = pBuf->aPLTEentries [iX].iBlue;
-          }
-        }
+  pImage = (mng_imagep)pData->pDeltaImage;
+  pBuf   = pImage->pImgbuf;
+                                       /* can't demote bitdepth! */
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  if (iBitdepth < pBuf->iBitdepth)
+    MNG_ERROR (pData, MNG_INVALIDBITDEPTH);
 
-        if (pBufzero->bHasTRNS)        /* copy cheap transparency ? */
-        {
-          pBufzero->iTRNSgray  = pBuf->iTRNSgray;
-          pBufzero->iTRNSred   = pBuf->iTRNSred;
-          pBufzero->iTRNSgreen = pBuf->iTRNSgreen;
-          pBufzero->iTRNSblue  = pBuf->iTRNSblue;
-          pBufzero->iTRNScount = pBuf->iTRNScount;
+  if ( ((pBuf->iColortype == MNG_COLORTYPE_GRAY      ) &&
+        (iColortype       != MNG_COLORTYPE_GRAY      ) &&
+        (iColortype       != MNG_COLORTYPE_GRAYA     ) &&
+        (iColortype       != MNG_COLORTYPE_RGB       ) &&
+        (iColortype       != MNG_COLORTYPE_RGBA      )    ) ||
+       ((pBuf->iColortype == MNG_COLORTYPE_GRAYA     ) &&
+        (iColortype       != MNG_COLORTYPE_GRAYA     ) &&
+        (iColortype       != MNG_COLORTYPE_RGBA      )    ) ||
+       ((pBuf->iColortype == MNG_COLORTYPE_RGB       ) &&
+        (iColortype       != MNG_COLORTYPE_RGB       ) &&
+        (iColortype       != MNG_COLORTYPE_RGBA      )    ) ||
+       ((pBuf->iColortype == MNG_COLORTYPE_RGBA      ) &&
+        (iColortype       != MNG_COLORTYPE_RGBA      )    ) ||
+#ifdef MNG_INCLUDE_JNG
+       ((pBuf->iColortype == MNG_COLORTYPE_JPEGGRAY  ) &&
+        (iColortype       != MNG_COLORTYPE_JPEGGRAY  ) &&
+        (iColortype       != MNG_COLORTYPE_JPEGCOLOR ) &&
+        (iColortype       != MNG_COLORTYPE_JPEGGRAYA ) &&
+        (iColortype       != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+       ((pBuf->iColortype == MNG_COLORTYPE_JPEGCOLOR ) &&
+        (iColortype       != MNG_COLORTYPE_JPEGCOLOR ) &&
+        (iColortype       != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+       ((pBuf->iColortype == MNG_COLORTYPE_JPEGGRAYA ) &&
+        (iColortype       != MNG_COLORTYPE_JPEGGRAYA ) &&
+        (iColortype       != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+       ((pBuf->iColortype == MNG_COLORTYPE_JPEGCOLORA) &&
+        (iColortype       != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+#endif
+       ((pBuf->iColortype == MNG_COLORTYPE_INDEXED   ) &&
+        (iColortype       != MNG_COLORTYPE_INDEXED   ) &&
+        (iColortype       != MNG_COLORTYPE_RGB       ) &&
+        (iColortype       != MNG_COLORTYPE_RGBA      )    )    )
+    MNG_ERROR (pData, MNG_INVALIDCOLORTYPE);
 
-          MNG_COPY (pBufzero->aTRNSentries, pBuf->aTRNSentries,
-                    sizeof (pBufzero->aTRNSentries));
-        }
-                                       /* process immediately if bitdepth & colortype are equal */
-        pData->bDeltaimmediate =
-          (mng_bool)((pData->bDisplaying) && (!pData->bSkipping) &&
-                     ((pData->bRunning) || (pData->bSearching)) &&
-                     (pData->iBitdepth  == ((mng_imagep)pData->pDeltaImage)->pImgbuf->iBitdepth ) &&
-                     (pData->iColortype == ((mng_imagep)pData->pDeltaImage)->pImgbuf->iColortype)    );
-      }
- 
-#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
-  pData->fInitrowproc = (mng_fptr)mng_init_rowproc;
-  pData->ePng_imgtype = mng_png_imgtype (pData->iColortype, pData->iBitdepth);
+  iRetcode = mng_promote_imageobject (pData, pImage, iBitdepth, iColortype, iFilltype);
 #else
-      switch (pData->iColortype)       /* determine row initialization routine */
-      {
-        case 0 : {                     /* gray */
-                   switch (pData->iBitdepth)
-                   {
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-                     case  1 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g1_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g1_i;
+  if (pData->iPROMbitdepth < pBuf->iBitdepth)
+    MNG_ERROR (pData, MNG_INVALIDBITDEPTH);
+
+  if ( ((pBuf->iColortype      == MNG_COLORTYPE_GRAY      ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_GRAY      ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_GRAYA     ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_RGB       ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    ) ||
+       ((pBuf->iColortype      == MNG_COLORTYPE_GRAYA     ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_GRAYA     ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    ) ||
+       ((pBuf->iColortype      == MNG_COLORTYPE_RGB       ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_RGB       ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    ) ||
+       ((pBuf->iColortype      == MNG_COLORTYPE_RGBA      ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    ) ||
+#ifdef MNG_INCLUDE_JNG
+       ((pBuf->iColortype      == MNG_COLORTYPE_JPEGGRAY  ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGGRAY  ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLOR ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGGRAYA ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+       ((pBuf->iColortype      == MNG_COLORTYPE_JPEGCOLOR ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLOR ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+       ((pBuf->iColortype      == MNG_COLORTYPE_JPEGGRAYA ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGGRAYA ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+       ((pBuf->iColortype      == MNG_COLORTYPE_JPEGCOLORA) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+#endif
+       ((pBuf->iColortype      == MNG_COLORTYPE_INDEXED   ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_INDEXED   ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_RGB       ) &&
+        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    )    )
+    MNG_ERROR (pData, MNG_INVALIDCOLORTYPE);
 
-                                 break;
-                               }
-                     case  2 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g2_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g2_i;
+  iRetcode = mng_promote_imageobject (pData, pImage, pData->iPROMbitdepth,
+                                      pData->iPROMcolortype, pData->iPROMfilltype);
+#endif
 
-                                 break;
-                               }
-                     case  4 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g4_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g4_i;
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
 
-                                 break;
-                               }
-#endif /* MNG_NO_1_2_4BIT_SUPPORT */
-                     case  8 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g8_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g8_i;
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_PROM, MNG_LC_END);
+#endif
 
-                                 break;
-                               }
-#ifndef MNG_NO_16BIT_SUPPORT
-                     case 16 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g16_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_g16_i;
+  return MNG_NOERROR;
+}
+#endif
 
-                                 break;
-                               }
+/* ************************************************************************** */
+
+#ifndef MNG_NO_DELTA_PNG
+mng_retcode mng_process_display_ipng (mng_datap pData)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IPNG, MNG_LC_START);
 #endif
-                   }
+                                       /* indicate it for what it is now */
+  pData->iDeltaImagetype = MNG_IMAGETYPE_PNG;
 
-                   break;
-                 }
-        case 2 : {                     /* rgb */
-                   switch (pData->iBitdepth)
-                   {
-                     case  8 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_rgb8_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_rgb8_i;
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IPNG, MNG_LC_END);
+#endif
 
-                                 break;
-                               }
-#ifndef MNG_NO_16BIT_SUPPORT
-                     case 16 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_rgb16_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_rgb16_i;
+  return MNG_NOERROR;
+}
+#endif
 
-                                 break;
-                               }
+/* ************************************************************************** */
+
+#ifndef MNG_NO_DELTA_PNG
+#ifdef MNG_INCLUDE_JNG
+mng_retcode mng_process_display_ijng (mng_datap pData)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IJNG, MNG_LC_START);
 #endif
-                   }
+                                       /* indicate it for what it is now */
+  pData->iDeltaImagetype = MNG_IMAGETYPE_JNG;
 
-                   break;
-                 }
-        case 3 : {                     /* indexed */
-                   switch (pData->iBitdepth)
-                   {
-#ifndef MNG_NO_1_2_4BIT_SUPPORT
-                     case  1 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_idx1_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_idx1_i;
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IJNG, MNG_LC_END);
+#endif
 
-                                 break;
-                               }
-                     case  2 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_idx2_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_idx2_i;
+  return MNG_NOERROR;
+}
+#endif
+#endif
 
-                                 break;
-                               }
-                     case  4 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_idx4_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_idx4_i;
+/* ************************************************************************** */
 
-                                 break;
-                               }
-#endif /* MNG_NO_1_2_4BIT_SUPPORT */
-                     case  8 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_idx8_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_idx8_i;
+#ifndef MNG_NO_DELTA_PNG
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+mng_retcode mng_process_display_pplt (mng_datap      pData,
+                                      mng_uint8      iType,
+                                      mng_uint32     iCount,
+                                      mng_palette8ep paIndexentries,
+                                      mng_uint8p     paAlphaentries,
+                                      mng_uint8p     paUsedentries)
+#else
+mng_retcode mng_process_display_pplt (mng_datap      pData)
+#endif
+{
+  mng_uint32     iX;
+  mng_imagep     pImage = (mng_imagep)pData->pObjzero;
+  mng_imagedatap pBuf   = pImage->pImgbuf;
 
-                                 break;
-                               }
-                   }
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_PPLT, MNG_LC_START);
+#endif
 
-                   break;
-                 }
-        case 4 : {                     /* gray+alpha */
-                   switch (pData->iBitdepth)
-                   {
-                     case  8 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_ga8_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_ga8_i;
+#ifdef MNG_DECREMENT_LOOPS
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  iX = iCount;
+#else
+  iX = pData->iPPLTcount;
+#endif
+#endif
 
-                                 break;
-                               }
-#ifndef MNG_NO_16BIT_SUPPORT
-                     case 16 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_ga16_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_ga16_i;
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  switch (iType)
+#else
+  switch (pData->iPPLTtype)
+#endif
+  {
+    case MNG_DELTATYPE_REPLACERGB :
+      {
+#ifdef MNG_DECREMENT_LOOPS
+        for (; iX > 0;iX--)
+#else
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+        for (iX = 0; iX < iCount; iX++)
+#else
+        for (iX = 0; iX < pData->iPPLTcount; iX++)
+#endif
+#endif
+        {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+          if (paUsedentries [iX])
+          {
+            pBuf->aPLTEentries [iX].iRed   = paIndexentries [iX].iRed;
+            pBuf->aPLTEentries [iX].iGreen = paIndexentries [iX].iGreen;
+            pBuf->aPLTEentries [iX].iBlue  = paIndexentries [iX].iBlue;
+          }
+#else
+          if (pData->paPPLTusedentries [iX])
+          {
+            pBuf->aPLTEentries [iX].iRed   = pData->paPPLTindexentries [iX].iRed;
+            pBuf->aPLTEentries [iX].iGreen = pData->paPPLTindexentries [iX].iGreen;
+            pBuf->aPLTEentries [iX].iBlue  = pData->paPPLTindexentries [iX].iBlue;
+          }
+#endif
+        }
 
-                                 break;
-                               }
+        break;
+      }
+    case MNG_DELTATYPE_DELTARGB :
+      {
+#ifdef MNG_DECREMENT_LOOPS
+        for (; iX > 0;iX--)
+#else
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+        for (iX = 0; iX < iCount; iX++)
+#else
+        for (iX = 0; iX < pData->iPPLTcount; iX++)
+#endif
+#endif
+        {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+          if (paUsedentries [iX])
+          {
+            pBuf->aPLTEentries [iX].iRed   =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iRed   +
+                                           paIndexentries [iX].iRed  );
+            pBuf->aPLTEentries [iX].iGreen =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iGreen +
+                                           paIndexentries [iX].iGreen);
+            pBuf->aPLTEentries [iX].iBlue  =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iBlue  +
+                                           paIndexentries [iX].iBlue );
+          }
+#else
+          if (pData->paPPLTusedentries [iX])
+          {
+            pBuf->aPLTEentries [iX].iRed   =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iRed   +
+                                           pData->paPPLTindexentries [iX].iRed  );
+            pBuf->aPLTEentries [iX].iGreen =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iGreen +
+                                           pData->paPPLTindexentries [iX].iGreen);
+            pBuf->aPLTEentries [iX].iBlue  =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iBlue  +
+                                           pData->paPPLTindexentries [iX].iBlue );
+          }
 #endif
-                   }
-
-                   break;
-                 }
-        case 6 : {                     /* rgb+alpha */
-                   switch (pData->iBitdepth)
-                   {
-                     case  8 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_rgba8_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_rgba8_i;
-
-                                 break;
-                               }
-#ifndef MNG_NO_16BIT_SUPPORT
-                     case 16 : {
-                                 if (!pData->iInterlace)
-                                   pData->fInitrowproc = (mng_fptr)mng_init_rgba16_ni;
-                                 else
-                                   pData->fInitrowproc = (mng_fptr)mng_init_rgba16_i;
+        }
 
-                                 break;
-                               }
+        break;
+      }
+    case MNG_DELTATYPE_REPLACEALPHA :
+      {
+#ifdef MNG_DECREMENT_LOOPS
+        for (; iX > 0;iX--)
+#else
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+        for (iX = 0; iX < iCount; iX++)
+#else
+        for (iX = 0; iX < pData->iPPLTcount; iX++)
+#endif
+#endif
+        {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+          if (paUsedentries [iX])
+            pBuf->aTRNSentries [iX] = paAlphaentries [iX];
+        }
+#else
+          if (pData->paPPLTusedentries [iX])
+            pBuf->aTRNSentries [iX] = pData->paPPLTalphaentries [iX];
+        }
 #endif
-                   }
 
-                   break;
-                 }
+        break;
       }
-#endif /* MNG_OPTIMIZE_FOOTPRINT_INIT */
-    }
-    else
-      MNG_ERROR (pData, MNG_OBJNOTCONCRETE);
-
-  }
-  else
-    MNG_ERROR (pData, MNG_OBJECTUNKNOWN);
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_DHDR, MNG_LC_END);
+    case MNG_DELTATYPE_DELTAALPHA :
+      {
+#ifdef MNG_DECREMENT_LOOPS
+        for (; iX > 0;iX--)
+#else
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+        for (iX = 0; iX < iCount; iX++)
+#else
+        for (iX = 0; iX < pData->iPPLTcount; iX++)
 #endif
-
-  return MNG_NOERROR;
-}
 #endif
-
-/* ************************************************************************** */
-
-#ifndef MNG_NO_DELTA_PNG
+        {
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_prom (mng_datap  pData,
-                                      mng_uint8  iBitdepth,
-                                      mng_uint8  iColortype,
-                                      mng_uint8  iFilltype)
+          if (paUsedentries [iX])
+            pBuf->aTRNSentries [iX] =
+                               (mng_uint8)(pBuf->aTRNSentries [iX] +
+                                           paAlphaentries [iX]);
 #else
-mng_retcode mng_process_display_prom (mng_datap  pData)
+          if (pData->paPPLTusedentries [iX])
+            pBuf->aTRNSentries [iX] =
+                               (mng_uint8)(pBuf->aTRNSentries [iX] +
+                                           pData->paPPLTalphaentries [iX]);
 #endif
-{
-  mng_imagep     pImage;
-  mng_imagedatap pBuf;
-  mng_retcode    iRetcode;
+        }
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_PROM, MNG_LC_START);
+        break;
+      }
+    case MNG_DELTATYPE_REPLACERGBA :
+      {
+#ifdef MNG_DECREMENT_LOOPS
+        for (; iX > 0;iX--)
+#else
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+        for (iX = 0; iX < iCount; iX++)
+#else
+        for (iX = 0; iX < pData->iPPLTcount; iX++)
 #endif
-
-  if (!pData->pDeltaImage)             /* gotta have this now! */
-    MNG_ERROR (pData, MNG_INVALIDDELTA);
-
-  pImage = (mng_imagep)pData->pDeltaImage;
-  pBuf   = pImage->pImgbuf;
-                                       /* can't demote bitdepth! */
+#endif
+        {
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  if (iBitdepth < pBuf->iBitdepth)
-    MNG_ERROR (pData, MNG_INVALIDBITDEPTH);
-
-  if ( ((pBuf->iColortype == MNG_COLORTYPE_GRAY      ) &&
-        (iColortype       != MNG_COLORTYPE_GRAY      ) &&
-        (iColortype       != MNG_COLORTYPE_GRAYA     ) &&
-        (iColortype       != MNG_COLORTYPE_RGB       ) &&
-        (iColortype       != MNG_COLORTYPE_RGBA      )    ) ||
-       ((pBuf->iColortype == MNG_COLORTYPE_GRAYA     ) &&
-        (iColortype       != MNG_COLORTYPE_GRAYA     ) &&
-        (iColortype       != MNG_COLORTYPE_RGBA      )    ) ||
-       ((pBuf->iColortype == MNG_COLORTYPE_RGB       ) &&
-        (iColortype       != MNG_COLORTYPE_RGB       ) &&
-        (iColortype       != MNG_COLORTYPE_RGBA      )    ) ||
-       ((pBuf->iColortype == MNG_COLORTYPE_RGBA      ) &&
-        (iColortype       != MNG_COLORTYPE_RGBA      )    ) ||
-#ifdef MNG_INCLUDE_JNG
-       ((pBuf->iColortype == MNG_COLORTYPE_JPEGGRAY  ) &&
-        (iColortype       != MNG_COLORTYPE_JPEGGRAY  ) &&
-        (iColortype       != MNG_COLORTYPE_JPEGCOLOR ) &&
-        (iColortype       != MNG_COLORTYPE_JPEGGRAYA ) &&
-        (iColortype       != MNG_COLORTYPE_JPEGCOLORA)    ) ||
-       ((pBuf->iColortype == MNG_COLORTYPE_JPEGCOLOR ) &&
-        (iColortype       != MNG_COLORTYPE_JPEGCOLOR ) &&
-        (iColortype       != MNG_COLORTYPE_JPEGCOLORA)    ) ||
-       ((pBuf->iColortype == MNG_COLORTYPE_JPEGGRAYA ) &&
-        (iColortype       != MNG_COLORTYPE_JPEGGRAYA ) &&
-        (iColortype       != MNG_COLORTYPE_JPEGCOLORA)    ) ||
-       ((pBuf->iColortype == MNG_COLORTYPE_JPEGCOLORA) &&
-        (iColortype       != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+          if (paUsedentries [iX])
+          {
+            pBuf->aPLTEentries [iX].iRed   = paIndexentries [iX].iRed;
+            pBuf->aPLTEentries [iX].iGreen = paIndexentries [iX].iGreen;
+            pBuf->aPLTEentries [iX].iBlue  = paIndexentries [iX].iBlue;
+            pBuf->aTRNSentries [iX]        = paAlphaentries [iX];
+          }
+#else
+          if (pData->paPPLTusedentries [iX])
+          {
+            pBuf->aPLTEentries [iX].iRed   = pData->paPPLTindexentries [iX].iRed;
+            pBuf->aPLTEentries [iX].iGreen = pData->paPPLTindexentries [iX].iGreen;
+            pBuf->aPLTEentries [iX].iBlue  = pData->paPPLTindexentries [iX].iBlue;
+            pBuf->aTRNSentries [iX]        = pData->paPPLTalphaentries [iX];
+          }
 #endif
-       ((pBuf->iColortype == MNG_COLORTYPE_INDEXED   ) &&
-        (iColortype       != MNG_COLORTYPE_INDEXED   ) &&
-        (iColortype       != MNG_COLORTYPE_RGB       ) &&
-        (iColortype       != MNG_COLORTYPE_RGBA      )    )    )
-    MNG_ERROR (pData, MNG_INVALIDCOLORTYPE);
+        }
 
-  iRetcode = mng_promote_imageobject (pData, pImage, iBitdepth, iColortype, iFilltype);
+        break;
+      }
+    case MNG_DELTATYPE_DELTARGBA :
+      {
+#ifdef MNG_DECREMENT_LOOPS
+        for (; iX > 0;iX--)
 #else
-  if (pData->iPROMbitdepth < pBuf->iBitdepth)
-    MNG_ERROR (pData, MNG_INVALIDBITDEPTH);
-
-  if ( ((pBuf->iColortype      == MNG_COLORTYPE_GRAY      ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_GRAY      ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_GRAYA     ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_RGB       ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    ) ||
-       ((pBuf->iColortype      == MNG_COLORTYPE_GRAYA     ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_GRAYA     ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    ) ||
-       ((pBuf->iColortype      == MNG_COLORTYPE_RGB       ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_RGB       ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    ) ||
-       ((pBuf->iColortype      == MNG_COLORTYPE_RGBA      ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    ) ||
-#ifdef MNG_INCLUDE_JNG
-       ((pBuf->iColortype      == MNG_COLORTYPE_JPEGGRAY  ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGGRAY  ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLOR ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGGRAYA ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLORA)    ) ||
-       ((pBuf->iColortype      == MNG_COLORTYPE_JPEGCOLOR ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLOR ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLORA)    ) ||
-       ((pBuf->iColortype      == MNG_COLORTYPE_JPEGGRAYA ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGGRAYA ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLORA)    ) ||
-       ((pBuf->iColortype      == MNG_COLORTYPE_JPEGCOLORA) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_JPEGCOLORA)    ) ||
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+        for (iX = 0; iX < iCount; iX++)
+#else
+        for (iX = 0; iX < pData->iPPLTcount; iX++)
 #endif
-       ((pBuf->iColortype      == MNG_COLORTYPE_INDEXED   ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_INDEXED   ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_RGB       ) &&
-        (pData->iPROMcolortype != MNG_COLORTYPE_RGBA      )    )    )
-    MNG_ERROR (pData, MNG_INVALIDCOLORTYPE);
-
-  iRetcode = mng_promote_imageobject (pData, pImage, pData->iPROMbitdepth,
-                                      pData->iPROMcolortype, pData->iPROMfilltype);
 #endif
+        {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+          if (paUsedentries [iX])
+          {
+            pBuf->aPLTEentries [iX].iRed   =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iRed   +
+                                           paIndexentries [iX].iRed  );
+            pBuf->aPLTEentries [iX].iGreen =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iGreen +
+                                           paIndexentries [iX].iGreen);
+            pBuf->aPLTEentries [iX].iBlue  =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iBlue  +
+                                           paIndexentries [iX].iBlue );
+            pBuf->aTRNSentries [iX] =
+                               (mng_uint8)(pBuf->aTRNSentries [iX] +
+                                           paAlphaentries [iX]);
+          }
+#else
+          if (pData->paPPLTusedentries [iX])
+          {
+            pBuf->aPLTEentries [iX].iRed   =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iRed   +
+                                           pData->paPPLTindexentries [iX].iRed  );
+            pBuf->aPLTEentries [iX].iGreen =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iGreen +
+                                           pData->paPPLTindexentries [iX].iGreen);
+            pBuf->aPLTEentries [iX].iBlue  =
+                               (mng_uint8)(pBuf->aPLTEentries [iX].iBlue  +
+                                           pData->paPPLTindexentries [iX].iBlue );
+            pBuf->aTRNSentries [iX] =
+                               (mng_uint8)(pBuf->aTRNSentries [iX] +
+                                           pData->paPPLTalphaentries [iX]);
+          }
+#endif
+        }
 
-  if (iRetcode)                        /* on error bail out */
-    return iRetcode;
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_PROM, MNG_LC_END);
-#endif
+        break;
+      }
+  }
 
-  return MNG_NOERROR;
-}
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  if ((iType != MNG_DELTATYPE_REPLACERGB) && (iType != MNG_DELTATYPE_DELTARGB))
+#else
+  if ((pData->iPPLTtype != MNG_DELTATYPE_REPLACERGB) &&
+      (pData->iPPLTtype != MNG_DELTATYPE_DELTARGB  )    )
 #endif
-
-/* ************************************************************************** */
-
-#ifndef MNG_NO_DELTA_PNG
-mng_retcode mng_process_display_ipng (mng_datap pData)
-{
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IPNG, MNG_LC_START);
+  {
+    if (pBuf->bHasTRNS)
+    {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+      if (iCount > pBuf->iTRNScount)
+        pBuf->iTRNScount = iCount;
+#else
+      if (pData->iPPLTcount > pBuf->iTRNScount)
+        pBuf->iTRNScount = pData->iPPLTcount;
 #endif
-                                       /* indicate it for what it is now */
-  pData->iDeltaImagetype = MNG_IMAGETYPE_PNG;
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IPNG, MNG_LC_END);
+    }
+    else
+    {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+      pBuf->iTRNScount = iCount;
+      pBuf->bHasTRNS   = MNG_TRUE;
+#else
+      pBuf->iTRNScount = pData->iPPLTcount;
+      pBuf->bHasTRNS   = MNG_TRUE;
 #endif
+    }
+  }
 
-  return MNG_NOERROR;
-}
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  if ((iType != MNG_DELTATYPE_REPLACEALPHA) && (iType != MNG_DELTATYPE_DELTAALPHA))
+#else
+  if ((pData->iPPLTtype != MNG_DELTATYPE_REPLACEALPHA) &&
+      (pData->iPPLTtype != MNG_DELTATYPE_DELTAALPHA  )    )
 #endif
-
-/* ************************************************************************** */
-
-#ifndef MNG_NO_DELTA_PNG
-#ifdef MNG_INCLUDE_JNG
-mng_retcode mng_process_display_ijng (mng_datap pData)
-{
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IJNG, MNG_LC_START);
+  {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+    if (iCount > pBuf->iPLTEcount)
+      pBuf->iPLTEcount = iCount;
+#else
+    if (pData->iPPLTcount > pBuf->iPLTEcount)
+      pBuf->iPLTEcount = pData->iPPLTcount;
 #endif
-                                       /* indicate it for what it is now */
-  pData->iDeltaImagetype = MNG_IMAGETYPE_JNG;
+  }
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_IJNG, MNG_LC_END);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_PPLT, MNG_LC_END);
 #endif
 
   return MNG_NOERROR;
 }
 #endif
-#endif
 
 /* ************************************************************************** */
 
-#ifndef MNG_NO_DELTA_PNG
+#ifndef MNG_SKIPCHUNK_MAGN
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_pplt (mng_datap      pData,
-                                      mng_uint8      iType,
-                                      mng_uint32     iCount,
-                                      mng_palette8ep paIndexentries,
-                                      mng_uint8p     paAlphaentries,
-                                      mng_uint8p     paUsedentries)
+mng_retcode mng_process_display_magn (mng_datap  pData,
+                                      mng_uint16 iFirstid,
+                                      mng_uint16 iLastid,
+                                      mng_uint8  iMethodX,
+                                      mng_uint16 iMX,
+                                      mng_uint16 iMY,
+                                      mng_uint16 iML,
+                                      mng_uint16 iMR,
+                                      mng_uint16 iMT,
+                                      mng_uint16 iMB,
+                                      mng_uint8  iMethodY)
 #else
-mng_retcode mng_process_display_pplt (mng_datap      pData)
+mng_retcode mng_process_display_magn (mng_datap  pData)
 #endif
 {
-  mng_uint32     iX;
-  mng_imagep     pImage = (mng_imagep)pData->pObjzero;
-  mng_imagedatap pBuf   = pImage->pImgbuf;
+  mng_uint16 iX;
+  mng_imagep pImage;
 
 #ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_PPLT, MNG_LC_START);
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MAGN, MNG_LC_START);
 #endif
-
-#ifdef MNG_DECREMENT_LOOPS
+                                       /* iterate the object-ids */
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  iX = iCount;
+  for (iX = iFirstid; iX <= iLastid; iX++)
 #else
-  iX = pData->iPPLTcount;
-#endif
+  for (iX = pData->iMAGNfirstid; iX <= pData->iMAGNlastid; iX++)
 #endif
+  {
+    if (iX == 0)                       /* process object 0 ? */
+    {
+      pImage = (mng_imagep)pData->pObjzero;
 
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  switch (iType)
+      pImage->iMAGN_MethodX = iMethodX;
+      pImage->iMAGN_MethodY = iMethodY;
+      pImage->iMAGN_MX      = iMX;
+      pImage->iMAGN_MY      = iMY;
+      pImage->iMAGN_ML      = iML;
+      pImage->iMAGN_MR      = iMR;
+      pImage->iMAGN_MT      = iMT;
+      pImage->iMAGN_MB      = iMB;
 #else
-  switch (pData->iPPLTtype)
+      pImage->iMAGN_MethodX = pData->iMAGNmethodX;
+      pImage->iMAGN_MethodY = pData->iMAGNmethodY;
+      pImage->iMAGN_MX      = pData->iMAGNmX;
+      pImage->iMAGN_MY      = pData->iMAGNmY;
+      pImage->iMAGN_ML      = pData->iMAGNmL;
+      pImage->iMAGN_MR      = pData->iMAGNmR;
+      pImage->iMAGN_MT      = pData->iMAGNmT;
+      pImage->iMAGN_MB      = pData->iMAGNmB;
 #endif
-  {
-    case MNG_DELTATYPE_REPLACERGB :
-      {
-#ifdef MNG_DECREMENT_LOOPS
-        for (; iX > 0;iX--)
-#else
+    }
+    else
+    {
+      pImage = mng_find_imageobject (pData, iX);
+                                       /* object exists & is not frozen ? */
+      if ((pImage) && (!pImage->bFrozen))
+      {                                /* previous magnification to be done ? */
+        if ((pImage->iMAGN_MethodX) || (pImage->iMAGN_MethodY))
+        {
+          mng_retcode iRetcode = mng_magnify_imageobject (pData, pImage);
+          if (iRetcode)                /* on error bail out */
+            return iRetcode;
+        }
+
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-        for (iX = 0; iX < iCount; iX++)
+        pImage->iMAGN_MethodX = iMethodX;
+        pImage->iMAGN_MethodY = iMethodY;
+        pImage->iMAGN_MX      = iMX;
+        pImage->iMAGN_MY      = iMY;
+        pImage->iMAGN_ML      = iML;
+        pImage->iMAGN_MR      = iMR;
+        pImage->iMAGN_MT      = iMT;
+        pImage->iMAGN_MB      = iMB;
 #else
-        for (iX = 0; iX < pData->iPPLTcount; iX++)
+        pImage->iMAGN_MethodX = pData->iMAGNmethodX;
+        pImage->iMAGN_MethodY = pData->iMAGNmethodY;
+        pImage->iMAGN_MX      = pData->iMAGNmX;
+        pImage->iMAGN_MY      = pData->iMAGNmY;
+        pImage->iMAGN_ML      = pData->iMAGNmL;
+        pImage->iMAGN_MR      = pData->iMAGNmR;
+        pImage->iMAGN_MT      = pData->iMAGNmT;
+        pImage->iMAGN_MB      = pData->iMAGNmB;
 #endif
+      }
+    }
+  }
+
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+  pData->iMAGNfromid = iFirstid;
+  pData->iMAGNtoid   = iLastid;
+  iX                 = iFirstid;
+#else
+  pData->iMAGNfromid = pData->iMAGNfirstid;
+  pData->iMAGNtoid   = pData->iMAGNlastid;
+  iX                 = pData->iMAGNfirstid;
 #endif
-        {
+                                       /* iterate again for showing */
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
-          if (paUsedentries [iX])
-          {
-            pBuf->aPLTEentries [iX].iRed   = paIndexentries [iX].iRed;
-            pBuf->aPLTEentries [iX].iGreen = paIndexentries [iX].iGreen;
-            pBuf->aPLTEentries [iX].iBlue  = paIndexentries [iX].iBlue;
-          }
+  while ((iX <= iLastid) && (!pData->bTimerset))
 #else
-          if (pData->paPPLTusedentries [iX])
-          {
-            pBuf->aPLTEentries [iX].iRed   = pData->paPPLTindexentries [iX].iRed;
-            pBuf->aPLTEentries [iX].iGreen = pData->paPPLTindexentries [iX].iGreen;
-            pBuf->aPLTEentries [iX].iBlue  = pData->paPPLTindexentries [iX].iBlue;
-          }
+  while ((iX <= pData->iMAGNlastid) && (!pData->bTimerset))
 #endif
-        }
+  {
+    pData->iMAGNcurrentid = iX;
 
-        break;
+    if (iX)                            /* only real objects ! */
+    {
+      pImage = mng_find_imageobject (pData, iX);
+                                       /* object exists & is not frozen  &
+                                          is visible & is viewable ? */
+      if ((pImage) && (!pImage->bFrozen) &&
+          (pImage->bVisible) && (pImage->bViewable))
+      {
+        mng_retcode iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
+        if (iRetcode)
+          return iRetcode;
       }
-    case MNG_DELTATYPE_DELTARGB :
+    }
+
+    iX++;
+  }
+
+  if (pData->bTimerset)                /* broken ? */
+    pData->iBreakpoint = 9;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MAGN, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_process_display_magn2 (mng_datap pData)
+{
+  mng_uint16 iX;
+  mng_imagep pImage;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MAGN, MNG_LC_START);
+#endif
+
+  iX = pData->iMAGNcurrentid;
+                                       /* iterate again for showing */
+  while ((iX <= pData->iMAGNtoid) && (!pData->bTimerset))
+  {
+    pData->iMAGNcurrentid = iX;
+
+    if (iX)                            /* only real objects ! */
+    {
+      pImage = mng_find_imageobject (pData, iX);
+                                       /* object exists & is not frozen  &
+                                          is visible & is viewable ? */
+      if ((pImage) && (!pImage->bFrozen) &&
+          (pImage->bVisible) && (pImage->bViewable))
       {
-#ifdef MNG_DECREMENT_LOOPS
-        for (; iX > 0;iX--)
-#else
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-        for (iX = 0; iX < iCount; iX++)
-#else
-        for (iX = 0; iX < pData->iPPLTcount; iX++)
+        mng_retcode iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
+        if (iRetcode)
+          return iRetcode;
+      }
+    }
+
+    iX++;
+  }
+
+  if (pData->bTimerset)                /* broken ? */
+    pData->iBreakpoint = 9;
+  else
+    pData->iBreakpoint = 0;            /* not again ! */
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MAGN, MNG_LC_END);
 #endif
+
+  return MNG_NOERROR;
+}
 #endif
-        {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-          if (paUsedentries [iX])
-          {
-            pBuf->aPLTEentries [iX].iRed   =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iRed   +
-                                           paIndexentries [iX].iRed  );
-            pBuf->aPLTEentries [iX].iGreen =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iGreen +
-                                           paIndexentries [iX].iGreen);
-            pBuf->aPLTEentries [iX].iBlue  =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iBlue  +
-                                           paIndexentries [iX].iBlue );
-          }
-#else
-          if (pData->paPPLTusedentries [iX])
-          {
-            pBuf->aPLTEentries [iX].iRed   =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iRed   +
-                                           pData->paPPLTindexentries [iX].iRed  );
-            pBuf->aPLTEentries [iX].iGreen =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iGreen +
-                                           pData->paPPLTindexentries [iX].iGreen);
-            pBuf->aPLTEentries [iX].iBlue  =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iBlue  +
-                                           pData->paPPLTindexentries [iX].iBlue );
-          }
+
+/* ************************************************************************** */
+
+#ifndef MNG_SKIPCHUNK_PAST
+typedef struct {                       /* a PAST source; ready for pasting */
+                 mng_imagep  pSourceimg;
+                 mng_fptr    fRetrieverow;
+                 mng_fptr    fScalerow;
+                 mng_fptr    fCorrectrow;
+                 mng_fptr    fFliprow;
+                 mng_fptr    fTilerow;
+                 mng_fptr    fDeltarow;
+                 mng_bool    bIsOpaque;
+#ifndef MNG_NO_16BIT_SUPPORT
+                 mng_bool    bSourceRGBA16;
+#endif
+                 mng_bool    bDirect;  /* paste straight from the source ? */
+                 mng_int32   iSourcel;
+                 mng_int32   iSourcet;
+                 mng_int32   iDestl;
+                 mng_int32   iDestt;
+                 mng_int32   iDestr;
+                 mng_int32   iDestb;
+                 mng_int32   iSourceY; /* source-row for the top target-row */
+                 mng_int32   iSourceYinc;
+               } mng_past_job;
+typedef mng_past_job * mng_past_jobp;
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode past_setup_job (mng_datap        pData,
+                                      mng_imagep       pTargetimg,
+                                      mng_past_sourcep pSource,
+                                      mng_past_jobp    pJob)
+{
+  mng_retcode    iRetcode = MNG_NOERROR;
+  mng_imagep     pSourceimg;
+  mng_imagedatap pBuf;
+#ifndef MNG_NO_16BIT_SUPPORT
+  mng_bool       bSourceRGBA16;
+  mng_bool       bTargetRGBA16 = (mng_bool)(pTargetimg->pImgbuf->iBitdepth > 8);
 #endif
-        }
 
-        break;
-      }
-    case MNG_DELTATYPE_REPLACEALPHA :
-      {
-#ifdef MNG_DECREMENT_LOOPS
-        for (; iX > 0;iX--)
-#else
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-        for (iX = 0; iX < iCount; iX++)
-#else
-        for (iX = 0; iX < pData->iPPLTcount; iX++)
+  pJob->pSourceimg = MNG_NULL;         /* nothing to paste by default */
+                                       /* find the little bastard first */
+  pSourceimg       = (mng_imagep)mng_find_imageobject (pData, pSource->iSourceid);
+                                       /* exists and viewable? */
+  if ((!pSourceimg) || (!pSourceimg->bViewable))
+    return MNG_NOERROR;
+                                       /* needs magnification ? */
+#ifndef MNG_SKIPCHUNK_MAGN
+  if ((pSourceimg->iMAGN_MethodX) || (pSourceimg->iMAGN_MethodY))
+  {
+    iRetcode = mng_magnify_imageobject (pData, pSourceimg);
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+  }
 #endif
+
+  pBuf = (mng_imagedatap)pSourceimg->pImgbuf;
+
+  if ((!pBuf->iWidth) || (!pBuf->iHeight))
+    return MNG_NOERROR;                /* nothing in there !?! */
+                                       /* address source for row-routines */
+  pData->pRetrieveobj = (mng_objectp)pSourceimg;
+#ifndef MNG_NO_16BIT_SUPPORT
+  bSourceRGBA16       = (mng_bool)(pBuf->iBitdepth > 8);
 #endif
-        {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-          if (paUsedentries [iX])
-            pBuf->aTRNSentries [iX] = paAlphaentries [iX];
-        }
-#else
-          if (pData->paPPLTusedentries [iX])
-            pBuf->aTRNSentries [iX] = pData->paPPLTalphaentries [iX];
-        }
+
+  switch (pBuf->iColortype)
+  {
+    case  0 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (bSourceRGBA16)
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_g16;
+                else
 #endif
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_g8;
 
-        break;
-      }
-    case MNG_DELTATYPE_DELTAALPHA :
-      {
-#ifdef MNG_DECREMENT_LOOPS
-        for (; iX > 0;iX--)
-#else
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-        for (iX = 0; iX < iCount; iX++)
-#else
-        for (iX = 0; iX < pData->iPPLTcount; iX++)
+                pData->bIsOpaque      = (mng_bool)(!pBuf->bHasTRNS);
+                break;
+              }
+
+    case  2 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                if (bSourceRGBA16)
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb16;
+                else
 #endif
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb8;
+
+                pData->bIsOpaque      = (mng_bool)(!pBuf->bHasTRNS);
+                break;
+              }
+
+
+    case  3 : { pData->fRetrieverow   = (mng_fptr)mng_retrieve_idx8;
+                pData->bIsOpaque      = (mng_bool)(!pBuf->bHasTRNS);
+                break;
+              }
+
+
+    case  4 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                if (bSourceRGBA16)
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_ga16;
+                else
 #endif
-        {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-          if (paUsedentries [iX])
-            pBuf->aTRNSentries [iX] =
-                               (mng_uint8)(pBuf->aTRNSentries [iX] +
-                                           paAlphaentries [iX]);
-#else
-          if (pData->paPPLTusedentries [iX])
-            pBuf->aTRNSentries [iX] =
-                               (mng_uint8)(pBuf->aTRNSentries [iX] +
-                                           pData->paPPLTalphaentries [iX]);
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_ga8;
+
+                pData->bIsOpaque      = MNG_FALSE;
+                break;
+              }
+
+
+    case  6 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (bSourceRGBA16)
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba16;
+                else
 #endif
-        }
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba8;
 
-        break;
-      }
-    case MNG_DELTATYPE_REPLACERGBA :
-      {
-#ifdef MNG_DECREMENT_LOOPS
-        for (; iX > 0;iX--)
-#else
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-        for (iX = 0; iX < iCount; iX++)
-#else
-        for (iX = 0; iX < pData->iPPLTcount; iX++)
+                pData->bIsOpaque      = MNG_FALSE;
+                break;
+              }
+
+    case  8 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (bSourceRGBA16)
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_g16;
+                else
 #endif
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_g8;
+
+                pData->bIsOpaque      = MNG_TRUE;
+                break;
+              }
+
+    case 10 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (bSourceRGBA16)
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb16;
+                else
 #endif
-        {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-          if (paUsedentries [iX])
-          {
-            pBuf->aPLTEentries [iX].iRed   = paIndexentries [iX].iRed;
-            pBuf->aPLTEentries [iX].iGreen = paIndexentries [iX].iGreen;
-            pBuf->aPLTEentries [iX].iBlue  = paIndexentries [iX].iBlue;
-            pBuf->aTRNSentries [iX]        = paAlphaentries [iX];
-          }
-#else
-          if (pData->paPPLTusedentries [iX])
-          {
-            pBuf->aPLTEentries [iX].iRed   = pData->paPPLTindexentries [iX].iRed;
-            pBuf->aPLTEentries [iX].iGreen = pData->paPPLTindexentries [iX].iGreen;
-            pBuf->aPLTEentries [iX].iBlue  = pData->paPPLTindexentries [iX].iBlue;
-            pBuf->aTRNSentries [iX]        = pData->paPPLTalphaentries [iX];
-          }
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb8;
+
+                pData->bIsOpaque      = MNG_TRUE;
+                break;
+              }
+
+
+    case 12 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (bSourceRGBA16)
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_ga16;
+                else
 #endif
-        }
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_ga8;
 
-        break;
-      }
-    case MNG_DELTATYPE_DELTARGBA :
-      {
-#ifdef MNG_DECREMENT_LOOPS
-        for (; iX > 0;iX--)
-#else
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-        for (iX = 0; iX < iCount; iX++)
-#else
-        for (iX = 0; iX < pData->iPPLTcount; iX++)
+                pData->bIsOpaque      = MNG_FALSE;
+                break;
+              }
+
+
+    case 14 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+                 if (bSourceRGBA16)
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba16;
+                else
 #endif
+                  pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba8;
+
+                pData->bIsOpaque      = MNG_FALSE;
+                break;
+              }
+  }
+                                       /* determine scaling */
+#ifndef MNG_NO_16BIT_SUPPORT
+#ifndef MNG_NO_DELTA_PNG
+  if ((!bSourceRGBA16) && (bTargetRGBA16))
+    pData->fScalerow = (mng_fptr)mng_scale_rgba8_rgba16;
+  else
+  if ((bSourceRGBA16) && (!bTargetRGBA16))
+    pData->fScalerow = (mng_fptr)mng_scale_rgba16_rgba8;
+  else
 #endif
-        {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-          if (paUsedentries [iX])
-          {
-            pBuf->aPLTEentries [iX].iRed   =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iRed   +
-                                           paIndexentries [iX].iRed  );
-            pBuf->aPLTEentries [iX].iGreen =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iGreen +
-                                           paIndexentries [iX].iGreen);
-            pBuf->aPLTEentries [iX].iBlue  =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iBlue  +
-                                           paIndexentries [iX].iBlue );
-            pBuf->aTRNSentries [iX] =
-                               (mng_uint8)(pBuf->aTRNSentries [iX] +
-                                           paAlphaentries [iX]);
-          }
-#else
-          if (pData->paPPLTusedentries [iX])
-          {
-            pBuf->aPLTEentries [iX].iRed   =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iRed   +
-                                           pData->paPPLTindexentries [iX].iRed  );
-            pBuf->aPLTEentries [iX].iGreen =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iGreen +
-                                           pData->paPPLTindexentries [iX].iGreen);
-            pBuf->aPLTEentries [iX].iBlue  =
-                               (mng_uint8)(pBuf->aPLTEentries [iX].iBlue  +
-                                           pData->paPPLTindexentries [iX].iBlue );
-            pBuf->aTRNSentries [iX] =
-                               (mng_uint8)(pBuf->aTRNSentries [iX] +
-                                           pData->paPPLTalphaentries [iX]);
-          }
 #endif
-        }
+    pData->fScalerow = MNG_NULL;
 
-        break;
-      }
-  }
+                                       /* default no color-correction */
+  pData->fCorrectrow = MNG_NULL;
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  if ((iType != MNG_DELTATYPE_REPLACERGB) && (iType != MNG_DELTATYPE_DELTARGB))
-#else
-  if ((pData->iPPLTtype != MNG_DELTATYPE_REPLACERGB) &&
-      (pData->iPPLTtype != MNG_DELTATYPE_DELTARGB  )    )
+#if defined(MNG_FULL_CMS)              /* determine color-management routine */
+  iRetcode = mng_init_full_cms   (pData, MNG_FALSE, MNG_FALSE, MNG_TRUE);
+#elif defined(MNG_GAMMA_ONLY)
+  iRetcode = mng_init_gamma_only (pData, MNG_FALSE, MNG_FALSE, MNG_TRUE);
+#elif defined(MNG_APP_CMS)
+  iRetcode = mng_init_app_cms    (pData, MNG_FALSE, MNG_FALSE, MNG_TRUE);
 #endif
+
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+
+#if defined(MNG_GAMMA_ONLY) || defined(MNG_FULL_CMS) || defined(MNG_APP_CMS)
+                                       /* an 8-bit identity table is a no-op */
+  if (pData->fCorrectrow == (mng_fptr)mng_correct_gamma_only)
   {
-    if (pBuf->bHasTRNS)
-    {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      if (iCount > pBuf->iTRNScount)
-        pBuf->iTRNScount = iCount;
-#else
-      if (pData->iPPLTcount > pBuf->iTRNScount)
-        pBuf->iTRNScount = pData->iPPLTcount;
-#endif
-    }
+    mng_int32 iG;
+
+#ifndef MNG_NO_16BIT_SUPPORT
+    if (bTargetRGBA16)
+      iG = -1;
     else
-    {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      pBuf->iTRNScount = iCount;
-      pBuf->bHasTRNS   = MNG_TRUE;
-#else
-      pBuf->iTRNScount = pData->iPPLTcount;
-      pBuf->bHasTRNS   = MNG_TRUE;
 #endif
-    }
-  }
+    for (iG = 0; (iG < 256) && (pData->aGammatab [iG] == (mng_uint8)iG); iG++) ;
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  if ((iType != MNG_DELTATYPE_REPLACEALPHA) && (iType != MNG_DELTATYPE_DELTAALPHA))
-#else
-  if ((pData->iPPLTtype != MNG_DELTATYPE_REPLACEALPHA) &&
-      (pData->iPPLTtype != MNG_DELTATYPE_DELTAALPHA  )    )
+    if (iG == 256)
+      pData->fCorrectrow = MNG_NULL;
+  }
 #endif
+
+  pData->fFliprow = MNG_NULL;          /* no flipping or tiling by default */
+  pData->fTilerow = MNG_NULL;
+                                       /* but perhaps we do have to ... */
+  switch (pSource->iOrientation)
   {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-    if (iCount > pBuf->iPLTEcount)
-      pBuf->iPLTEcount = iCount;
-#else
-    if (pData->iPPLTcount > pBuf->iPLTEcount)
-      pBuf->iPLTEcount = pData->iPPLTcount;
+    case 2 : ;
+    case 4 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+               if (bTargetRGBA16)
+                 pData->fFliprow = (mng_fptr)mng_flip_rgba16;
+               else
+#endif
+                 pData->fFliprow = (mng_fptr)mng_flip_rgba8;
+               break;
+             }
+
+    case 8 : {
+#ifndef MNG_NO_16BIT_SUPPORT
+               if (bTargetRGBA16)
+                 pData->fTilerow = (mng_fptr)mng_tile_rgba16;
+               else
 #endif
+                 pData->fTilerow = (mng_fptr)mng_tile_rgba8;
+               break;
+             }
   }
+                                       /* determine composition routine */
+                                       /* note that we're abusing the delta-routine setup !!! */
+  switch (pSource->iComposition)
+  {
+    case 0 : {                         /* composite over */
+#ifndef MNG_NO_16BIT_SUPPORT
+               if (bTargetRGBA16)
+                 pData->fDeltarow = (mng_fptr)mng_composeover_rgba16;
+               else
+#endif
+                 pData->fDeltarow = (mng_fptr)mng_composeover_rgba8;
+               break;
+             }
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_PPLT, MNG_LC_END);
+    case 1 : {                         /* replace */
+#ifndef MNG_NO_16BIT_SUPPORT
+               if (bTargetRGBA16)
+                 pData->fDeltarow = (mng_fptr)mng_delta_rgba16_rgba16;
+               else
 #endif
+                 pData->fDeltarow = (mng_fptr)mng_delta_rgba8_rgba8;
+               break;
+             }
 
-  return MNG_NOERROR;
-}
+    case 2 : {                         /* composite under */
+#ifndef MNG_NO_16BIT_SUPPORT
+               if (bTargetRGBA16)
+                 pData->fDeltarow = (mng_fptr)mng_composeunder_rgba16;
+               else
 #endif
+                 pData->fDeltarow = (mng_fptr)mng_composeunder_rgba8;
+               break;
+             }
+  }
 
-/* ************************************************************************** */
+#ifdef MNG_SUPPORT_SIMD                /* vector units for the 8-bit ones ? */
+  if (pData->iSIMDflags & (MNG_SIMD_SSE2 | MNG_SIMD_NEON))
+  {
+    if (pData->fFliprow == (mng_fptr)mng_flip_rgba8)
+      pData->fFliprow  = (mng_fptr)mng_flip_rgba8_simd;
 
-#ifndef MNG_SKIPCHUNK_MAGN
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-mng_retcode mng_process_display_magn (mng_datap  pData,
-                                      mng_uint16 iFirstid,
-                                      mng_uint16 iLastid,
-                                      mng_uint8  iMethodX,
-                                      mng_uint16 iMX,
-                                      mng_uint16 iMY,
-                                      mng_uint16 iML,
-                                      mng_uint16 iMR,
-                                      mng_uint16 iMT,
-                                      mng_uint16 iMB,
-                                      mng_uint8  iMethodY)
-#else
-mng_retcode mng_process_display_magn (mng_datap  pData)
+    if (pData->fDeltarow == (mng_fptr)mng_composeover_rgba8)
+      pData->fDeltarow = (mng_fptr)mng_composeover_rgba8_simd;
+    else
+    if (pData->fDeltarow == (mng_fptr)mng_composeunder_rgba8)
+      pData->fDeltarow = (mng_fptr)mng_composeunder_rgba8_simd;
+  }
 #endif
-{
-  mng_uint16 iX;
-  mng_imagep pImage;
+                                       /* determine offsets & clipping */
+  if (pSource->iOffsettype == 1)
+  {
+    pData->iDestl          = pData->iPastx + pSource->iOffsetx;
+    pData->iDestt          = pData->iPasty + pSource->iOffsety;
+  }
+  else
+  {
+    pData->iDestl          = pSource->iOffsetx;
+    pData->iDestt          = pSource->iOffsety;
+  }
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MAGN, MNG_LC_START);
-#endif
-                                       /* iterate the object-ids */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  for (iX = iFirstid; iX <= iLastid; iX++)
-#else
-  for (iX = pData->iMAGNfirstid; iX <= pData->iMAGNlastid; iX++)
-#endif
+  pData->iDestr            = (mng_int32)pTargetimg->pImgbuf->iWidth;
+  pData->iDestb            = (mng_int32)pTargetimg->pImgbuf->iHeight;
+                                       /* take the source dimension into account ? */
+  if (pSource->iOrientation != 8)
   {
-    if (iX == 0)                       /* process object 0 ? */
-    {
-      pImage = (mng_imagep)pData->pObjzero;
+    pData->iDestr          = MIN_COORD (pData->iDestr, pData->iDestl + (mng_int32)pBuf->iWidth);
+    pData->iDestb          = MIN_COORD (pData->iDestb, pData->iDestt + (mng_int32)pBuf->iHeight);
+  }
+                                       /* source clipping */
+  if (pSource->iBoundarytype == 1)
+  {
+    if (pData->iDestl < pData->iPastx + pSource->iBoundaryl)
+      pData->iSourcel      = pData->iPastx + pSource->iBoundaryl - pData->iDestl;
+    else
+      pData->iSourcel      = 0;
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      pImage->iMAGN_MethodX = iMethodX;
-      pImage->iMAGN_MethodY = iMethodY;
-      pImage->iMAGN_MX      = iMX;
-      pImage->iMAGN_MY      = iMY;
-      pImage->iMAGN_ML      = iML;
-      pImage->iMAGN_MR      = iMR;
-      pImage->iMAGN_MT      = iMT;
-      pImage->iMAGN_MB      = iMB;
-#else
-      pImage->iMAGN_MethodX = pData->iMAGNmethodX;
-      pImage->iMAGN_MethodY = pData->iMAGNmethodY;
-      pImage->iMAGN_MX      = pData->iMAGNmX;
-      pImage->iMAGN_MY      = pData->iMAGNmY;
-      pImage->iMAGN_ML      = pData->iMAGNmL;
-      pImage->iMAGN_MR      = pData->iMAGNmR;
-      pImage->iMAGN_MT      = pData->iMAGNmT;
-      pImage->iMAGN_MB      = pData->iMAGNmB;
-#endif
-    }
+    if (pData->iDestt < pData->iPasty + pSource->iBoundaryt)
+      pData->iSourcet      = pData->iPasty + pSource->iBoundaryt - pData->iDestt;
     else
-    {
-      pImage = mng_find_imageobject (pData, iX);
-                                       /* object exists & is not frozen ? */
-      if ((pImage) && (!pImage->bFrozen))
-      {                                /* previous magnification to be done ? */
-        if ((pImage->iMAGN_MethodX) || (pImage->iMAGN_MethodY))
-        {
-          mng_retcode iRetcode = mng_magnify_imageobject (pData, pImage);
-          if (iRetcode)                /* on error bail out */
-            return iRetcode;
-        }
+      pData->iSourcet      = 0;
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-        pImage->iMAGN_MethodX = iMethodX;
-        pImage->iMAGN_MethodY = iMethodY;
-        pImage->iMAGN_MX      = iMX;
-        pImage->iMAGN_MY      = iMY;
-        pImage->iMAGN_ML      = iML;
-        pImage->iMAGN_MR      = iMR;
-        pImage->iMAGN_MT      = iMT;
-        pImage->iMAGN_MB      = iMB;
-#else
-        pImage->iMAGN_MethodX = pData->iMAGNmethodX;
-        pImage->iMAGN_MethodY = pData->iMAGNmethodY;
-        pImage->iMAGN_MX      = pData->iMAGNmX;
-        pImage->iMAGN_MY      = pData->iMAGNmY;
-        pImage->iMAGN_ML      = pData->iMAGNmL;
-        pImage->iMAGN_MR      = pData->iMAGNmR;
-        pImage->iMAGN_MT      = pData->iMAGNmT;
-        pImage->iMAGN_MB      = pData->iMAGNmB;
+    pData->iDestl          = MAX_COORD (pData->iDestl, pData->iPastx + pSource->iBoundaryl);
+    pData->iDestt          = MAX_COORD (pData->iDestt, pData->iPasty + pSource->iBoundaryt);
+    pData->iDestr          = MIN_COORD (pData->iDestr, pData->iPastx + pSource->iBoundaryr);
+    pData->iDestb          = MIN_COORD (pData->iDestb, pData->iPasty + pSource->iBoundaryb);
+  }
+  else
+  {
+    if (pData->iDestl < pSource->iBoundaryl)
+      pData->iSourcel      = pSource->iBoundaryl - pData->iDestl;
+    else
+      pData->iSourcel      = 0;
+
+    if (pData->iDestt < pSource->iBoundaryt)
+      pData->iSourcet      = pSource->iBoundaryt - pData->iDestt;
+    else
+      pData->iSourcet      = 0;
+
+    pData->iDestl          = MAX_COORD (pData->iDestl, pSource->iBoundaryl);
+    pData->iDestt          = MAX_COORD (pData->iDestt, pSource->iBoundaryt);
+    pData->iDestr          = MIN_COORD (pData->iDestr, pSource->iBoundaryr);
+    pData->iDestb          = MIN_COORD (pData->iDestb, pSource->iBoundaryb);
+  }
+                                       /* never left of or above the target */
+  if (pData->iDestl < 0)
+  {
+    pData->iSourcel       -= pData->iDestl;
+    pData->iDestl          = 0;
+  }
+
+  if (pData->iDestt < 0)
+  {
+    pData->iSourcet       -= pData->iDestt;
+    pData->iDestt          = 0;
+  }
+                                       /* anything to display ? */
+  if ((pData->iDestl > pData->iDestr) || (pData->iDestt > pData->iDestb))
+    return MNG_NOERROR;
+                                       /* an RGBA source that needs no work can
+                                          be pasted straight from its buffer */
+  pJob->bDirect = (mng_bool)(((pBuf->iColortype == MNG_COLORTYPE_RGBA)       ||
+                              (pBuf->iColortype == MNG_COLORTYPE_JPEGCOLORA)    ) &&
+                             (!pData->fScalerow) && (!pData->fCorrectrow)          &&
+                             (!pData->fFliprow)  && (!pData->fTilerow)             &&
+                             (pBuf != pTargetimg->pImgbuf)                         );
+
+  if ((pData->iSourcel) && (!pJob->bDirect))
+  {                                    /* indent source ? */
+#ifndef MNG_NO_16BIT_SUPPORT
+     if (bTargetRGBA16)                /* abuse tiling routine to shift source-pixels */
+       pData->fTilerow = (mng_fptr)mng_tile_rgba16;
+     else
 #endif
-      }
-    }
+       pData->fTilerow = (mng_fptr)mng_tile_rgba8;
+  }
+                                       /* vertical direction */
+  if ((pSource->iOrientation == 2) || (pSource->iOrientation == 6))
+  {
+    pJob->iSourceY         = (mng_int32)pBuf->iHeight - 1 - pData->iSourcet;
+    pJob->iSourceYinc      = -1;
+  }
+  else
+  {
+    pJob->iSourceY         = pData->iSourcet;
+    pJob->iSourceYinc      = 1;
   }
+                                       /* and keep the lot */
+  pJob->pSourceimg         = pSourceimg;
+  pJob->fRetrieverow       = pData->fRetrieverow;
+  pJob->fScalerow          = pData->fScalerow;
+  pJob->fCorrectrow        = pData->fCorrectrow;
+  pJob->fFliprow           = pData->fFliprow;
+  pJob->fTilerow           = pData->fTilerow;
+  pJob->fDeltarow          = pData->fDeltarow;
+  pJob->bIsOpaque          = pData->bIsOpaque;
+#ifndef MNG_NO_16BIT_SUPPORT
+  pJob->bSourceRGBA16      = bSourceRGBA16;
+#endif
+  pJob->iSourcel           = pData->iSourcel;
+  pJob->iSourcet           = pData->iSourcet;
+  pJob->iDestl             = pData->iDestl;
+  pJob->iDestt             = pData->iDestt;
+  pJob->iDestr             = pData->iDestr;
+  pJob->iDestb             = pData->iDestb;
 
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  pData->iMAGNfromid = iFirstid;
-  pData->iMAGNtoid   = iLastid;
-  iX                 = iFirstid;
-#else
-  pData->iMAGNfromid = pData->iMAGNfirstid;
-  pData->iMAGNtoid   = pData->iMAGNlastid;
-  iX                 = pData->iMAGNfirstid;
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode past_paste_rows (mng_datap     pData,
+                                       mng_past_jobp pJob,
+                                       mng_int32     iFirst,
+                                       mng_int32     iLast)
+{
+  mng_retcode    iRetcode = MNG_NOERROR;
+  mng_imagedatap pBuf     = pJob->pSourceimg->pImgbuf;
+  mng_int32      iHeight  = (mng_int32)pBuf->iHeight;
+  mng_uint8p     pRGBArow = pData->pRGBArow;
+  mng_int32      iSourceY;
+  mng_int32      iTargetY;
+  mng_int32      iTargetsamples;
+  mng_int32      iTargetrowsize;
+#ifndef MNG_NO_16BIT_SUPPORT
+  mng_bool       bTargetRGBA16;
+#endif
+
+  iFirst = MAX_COORD (iFirst, pJob->iDestt);
+  iLast  = MIN_COORD (iLast,  pJob->iDestb);
+
+  if (iFirst >= iLast)                 /* not in this band ? */
+    return MNG_NOERROR;
+                                       /* load the source's setup */
+  pData->pRetrieveobj = (mng_objectp)pJob->pSourceimg;
+  pData->fRetrieverow = pJob->fRetrieverow;
+  pData->fScalerow    = pJob->fScalerow;
+  pData->fCorrectrow  = pJob->fCorrectrow;
+  pData->fFliprow     = pJob->fFliprow;
+  pData->fTilerow     = pJob->fTilerow;
+  pData->fDeltarow    = pJob->fDeltarow;
+  pData->bIsOpaque    = pJob->bIsOpaque;
+  pData->iSourcel     = pJob->iSourcel;
+  pData->iSourcet     = pJob->iSourcet;
+  pData->iDestl       = pJob->iDestl;
+  pData->iDestt       = pJob->iDestt;
+  pData->iDestr       = pJob->iDestr;
+  pData->iDestb       = pJob->iDestb;
+
+  pData->iPass        = -1;            /* init row-processing variables */
+  pData->iRowinc      = 1;
+  pData->iColinc      = 1;
+  pData->iPixelofs    = 0;
+  pData->iCol         = pJob->iDestl;
+                                       /* make sure the delta-routines do the right thing */
+  pData->iDeltatype   = MNG_DELTATYPE_BLOCKPIXELREPLACE;
+
+  iTargetsamples      = pJob->iDestr - pJob->iDestl;
+#ifndef MNG_NO_16BIT_SUPPORT
+  bTargetRGBA16       = (mng_bool)(((mng_imagep)pData->pStoreobj)->pImgbuf->iBitdepth > 8);
+
+  if (bTargetRGBA16)
+    iTargetrowsize    = (iTargetsamples << 3);
+  else
 #endif
-                                       /* iterate again for showing */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-  while ((iX <= iLastid) && (!pData->bTimerset))
-#else
-  while ((iX <= pData->iMAGNlastid) && (!pData->bTimerset))
+    iTargetrowsize    = (iTargetsamples << 2);
+                                       /* source-row for the first one here */
+  iSourceY            = (pJob->iSourceY + (iFirst - pJob->iDestt) * pJob->iSourceYinc) % iHeight;
+
+  if (iSourceY < 0)
+    iSourceY         += iHeight;
+
+  for (iTargetY = iFirst; (!iRetcode) && (iTargetY < iLast); iTargetY++)
+  {                                    /* get a row */
+    pData->iRow          = iSourceY;
+    pData->iRowsamples   = (mng_int32)pBuf->iWidth;
+    pData->iRowsize      = pBuf->iRowsize;
+#ifndef MNG_NO_16BIT_SUPPORT
+    pData->bIsRGBA16     = pJob->bSourceRGBA16;
 #endif
-  {
-    pData->iMAGNcurrentid = iX;
 
-    if (iX)                            /* only real objects ! */
+    if (pJob->bDirect)                 /* just point at it ? */
+      pData->pRGBArow    = pBuf->pImgdata + (iSourceY * pBuf->iRowsize) +
+                                            (pJob->iSourcel * pBuf->iSamplesize);
+    else
+      iRetcode           = ((mng_retrieverow)pData->fRetrieverow) (pData);
+                                       /* scale it (if necessary) */
+    if ((!iRetcode) && (pData->fScalerow))
+      iRetcode           = ((mng_scalerow)pData->fScalerow) (pData);
+
+#ifndef MNG_NO_16BIT_SUPPORT
+    pData->bIsRGBA16     = bTargetRGBA16;
+#endif
+                                       /* color correction (if necessary) */
+    if ((!iRetcode) && (pData->fCorrectrow))
+      iRetcode           = ((mng_correctrow)pData->fCorrectrow) (pData);
+                                       /* flipping (if necessary) */
+    if ((!iRetcode) && (pData->fFliprow))
+      iRetcode           = ((mng_fliprow)pData->fFliprow) (pData);
+                                       /* tiling (if necessary) */
+    if ((!iRetcode) && (pData->fTilerow))
+      iRetcode           = ((mng_tilerow)pData->fTilerow) (pData);
+
+    if (!iRetcode)                     /* and paste..... */
     {
-      pImage = mng_find_imageobject (pData, iX);
-                                       /* object exists & is not frozen  &
-                                          is visible & is viewable ? */
-      if ((pImage) && (!pImage->bFrozen) &&
-          (pImage->bVisible) && (pImage->bViewable))
-      {
-        mng_retcode iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
-        if (iRetcode)
-          return iRetcode;
-      }
+      pData->iRow        = iTargetY;
+      pData->iRowsamples = iTargetsamples;
+      pData->iRowsize    = iTargetrowsize;
+      iRetcode           = ((mng_deltarow)pData->fDeltarow) (pData);
     }
 
-    iX++;
-  }
+    if (pJob->bDirect)                 /* back to our own row-buffer */
+      pData->pRGBArow    = pRGBArow;
 
-  if (pData->bTimerset)                /* broken ? */
-    pData->iBreakpoint = 9;
+    iSourceY += pJob->iSourceYinc;     /* and next line */
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MAGN, MNG_LC_END);
-#endif
+    if (iSourceY < 0)
+      iSourceY = iHeight - 1;
+    else
+    if (iSourceY >= iHeight)
+      iSourceY = 0;
+  }
 
-  return MNG_NOERROR;
+  return iRetcode;
 }
 
 /* ************************************************************************** */
 
-mng_retcode mng_process_display_magn2 (mng_datap pData)
+MNG_LOCAL mng_retcode past_paste_jobs (mng_datap     pData,
+                                       mng_past_jobp pJobs,
+                                       mng_uint32    iJobs)
 {
-  mng_uint16 iX;
-  mng_imagep pImage;
+  mng_retcode    iRetcode = MNG_NOERROR;
+  mng_imagedatap pTarget  = ((mng_imagep)pData->pStoreobj)->pImgbuf;
+  mng_int32      iFirst   = (mng_int32)pTarget->iHeight;
+  mng_int32      iLast    = 0;
+  mng_uint32     iTemprowsize = 0;
+  mng_uint32     iSamples;
+  mng_int32      iBandrows;
+  mng_int32      iY;
+  mng_uint32     iX;
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MAGN, MNG_LC_START);
-#endif
+  if (!iJobs)                          /* anything queued at all ? */
+    return MNG_NOERROR;
 
-  iX = pData->iMAGNcurrentid;
-                                       /* iterate again for showing */
-  while ((iX <= pData->iMAGNtoid) && (!pData->bTimerset))
+  for (iX = 0; iX < iJobs; iX++)       /* which rows & how much room ? */
   {
-    pData->iMAGNcurrentid = iX;
+    iFirst   = MIN_COORD (iFirst, pJobs [iX].iDestt);
+    iLast    = MAX_COORD (iLast,  pJobs [iX].iDestb);
+    iSamples = pJobs [iX].pSourceimg->pImgbuf->iWidth;
+                                       /* rows may be up to RGBA16 on either side */
+    if (iSamples < (mng_uint32)(pJobs [iX].iDestr - pJobs [iX].iDestl))
+      iSamples = (mng_uint32)(pJobs [iX].iDestr - pJobs [iX].iDestl);
+
+    if (iTemprowsize < (iSamples << 3))
+      iTemprowsize = iSamples << 3;
+  }
+                                       /* paste a band of target-rows at a time,
+                                          so all sources hit it while it's hot */
+  iBandrows = (mng_int32)(MNG_PASTBANDSIZE / (pTarget->iRowsize ? pTarget->iRowsize : 1));
 
-    if (iX)                            /* only real objects ! */
-    {
-      pImage = mng_find_imageobject (pData, iX);
-                                       /* object exists & is not frozen  &
-                                          is visible & is viewable ? */
-      if ((pImage) && (!pImage->bFrozen) &&
-          (pImage->bVisible) && (pImage->bViewable))
-      {
-        mng_retcode iRetcode = mng_display_image (pData, pImage, MNG_FALSE);
-        if (iRetcode)
-          return iRetcode;
-      }
-    }
+  if (iBandrows < 1)
+    iBandrows = 1;
+                                       /* get temporary work-buffers */
+  MNG_ALLOC  (pData, pData->pRGBArow, iTemprowsize);
+  MNG_ALLOCX (pData, pData->pWorkrow, iTemprowsize);
 
-    iX++;
+  if (!pData->pWorkrow)                /* don't lose the first one */
+  {
+    MNG_FREE  (pData, pData->pRGBArow, iTemprowsize);
+    MNG_ERROR (pData, MNG_OUTOFMEMORY);
   }
 
-  if (pData->bTimerset)                /* broken ? */
-    pData->iBreakpoint = 9;
-  else
-    pData->iBreakpoint = 0;            /* not again ! */
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_PROCESS_DISPLAY_MAGN, MNG_LC_END);
-#endif
+  for (iY = iFirst; (!iRetcode) && (iY < iLast); iY += iBandrows)
+  {
+    for (iX = 0; (!iRetcode) && (iX < iJobs); iX++)
+      iRetcode = past_paste_rows (pData, pJobs + iX, iY, iY + iBandrows);
+  }
+                                       /* drop the temporary row-buffers */
+  MNG_FREE  (pData, pData->pWorkrow, iTemprowsize);
+  MNG_FREE  (pData, pData->pRGBArow, iTemprowsize);
 
-  return MNG_NOERROR;
+  return iRetcode;
 }
-#endif
+#endif /* MNG_SKIPCHUNK_PAST */
 
 /* ************************************************************************** */
 
@@ -6518,7 +8725,6 @@ mng_retcode mng_process_display_past (mng_datap  pData)
 {
   mng_retcode      iRetcode = MNG_NOERROR;
   mng_imagep       pTargetimg;
-  mng_imagep       pSourceimg;
 #ifndef MNG_OPTIMIZE_DISPLAYCALLS
   mng_past_sourcep pSource = (mng_past_sourcep)pSources;
 #else
@@ -6598,477 +8804,118 @@ mng_retcode mng_process_display_past (mng_datap  pData)
       iRetcode = mng_reset_object_details (pData, pTargetimg,
                                            pTargetimg->iClipr - pTargetimg->iPosx,
                                            pTargetimg->iClipb - pTargetimg->iPosy,
-                                           MNG_BITDEPTH_8, MNG_COLORTYPE_RGBA,
-                                           0, 0, 0, MNG_FALSE);
-
-      if (iRetcode)                    /* on error bail out */
-        return iRetcode;
-    }
-    else
-      pTargetimg = MNG_NULL;           /* clipped beyond visibility ! */
-  }
-
-  if (pTargetimg)                      /* usable destination ? */
-  {
-    mng_int32      iSourceY;
-    mng_int32      iSourceYinc;
-    mng_int32      iSourcerowsize;
-    mng_int32      iSourcesamples;
-#ifndef MNG_NO_16BIT_SUPPORT
-    mng_bool       bSourceRGBA16;
-#endif
-    mng_int32      iTargetY;
-    mng_int32      iTargetrowsize;
-    mng_int32      iTargetsamples;
-#ifndef MNG_NO_16BIT_SUPPORT
-    mng_bool       bTargetRGBA16 = MNG_FALSE;
-#endif
-    mng_int32      iTemprowsize;
-    mng_imagedatap pBuf;
-#ifndef MNG_SKIPCHUNK_MAGN
-                                       /* needs magnification ? */
-    if ((pTargetimg->iMAGN_MethodX) || (pTargetimg->iMAGN_MethodY))
-      iRetcode = mng_magnify_imageobject (pData, pTargetimg);
-#endif
-
-    if (!iRetcode)                     /* still ok ? */
-    {
-#ifndef MNG_NO_16BIT_SUPPORT
-      bTargetRGBA16 = (mng_bool)(pTargetimg->pImgbuf->iBitdepth > 8);
-#endif
-
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-      switch (iTargettype)             /* determine target x/y */
-#else
-      switch (pData->iPASTtargettype)  /* determine target x/y */
-#endif
-      {
-        case 0 : {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   pData->iPastx = iTargetx;
-                   pData->iPasty = iTargety;
-#else
-                   pData->iPastx = pData->iPASTtargetx;
-                   pData->iPasty = pData->iPASTtargety;
-#endif
-                   break;
-                 }
-
-        case 1 : {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   pData->iPastx = pTargetimg->iPastx + iTargetx;
-                   pData->iPasty = pTargetimg->iPasty + iTargety;
-#else
-                   pData->iPastx = pTargetimg->iPastx + pData->iPASTtargetx;
-                   pData->iPasty = pTargetimg->iPasty + pData->iPASTtargety;
-#endif
-                   break;
-                 }
-
-        case 2 : {
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-                   pData->iPastx += iTargetx;
-                   pData->iPasty += iTargety;
-#else
-                   pData->iPastx += pData->iPASTtargetx;
-                   pData->iPasty += pData->iPASTtargety;
-#endif
-                   break;
-                 }
-      }
-                                       /* save for next time ... */
-      pTargetimg->iPastx      = pData->iPastx;
-      pTargetimg->iPasty      = pData->iPasty;
-                                       /* address destination for row-routines */
-      pData->pStoreobj        = (mng_objectp)pTargetimg;
-      pData->pStorebuf        = (mng_objectp)pTargetimg->pImgbuf;
-    }
-                                       /* process the sources one by one */
-#ifndef MNG_OPTIMIZE_DISPLAYCALLS
-    while ((!iRetcode) && (iX < iCount))
-#else
-    while ((!iRetcode) && (iX < pData->iPASTcount))
-#endif
-    {                                  /* find the little bastards first */
-      pSourceimg              = (mng_imagep)mng_find_imageobject (pData, pSource->iSourceid);
-                                       /* exists and viewable? */
-      if ((pSourceimg) && (pSourceimg->bViewable))
-      {                                /* needs magnification ? */
-#ifndef MNG_SKIPCHUNK_MAGN
-        if ((pSourceimg->iMAGN_MethodX) || (pSourceimg->iMAGN_MethodY))
-          iRetcode = mng_magnify_imageobject (pData, pSourceimg);
-#endif
-
-        if (!iRetcode)                 /* still ok ? */
-        {
-          pBuf                = (mng_imagedatap)pSourceimg->pImgbuf;
-                                       /* address source for row-routines */
-          pData->pRetrieveobj = (mng_objectp)pSourceimg;
-
-          pData->iPass        = -1;    /* init row-processing variables */
-          pData->iRowinc      = 1;
-          pData->iColinc      = 1;
-          pData->iPixelofs    = 0;
-          iSourcesamples      = (mng_int32)pBuf->iWidth;
-          iSourcerowsize      = pBuf->iRowsize;
-#ifndef MNG_NO_16BIT_SUPPORT
-          bSourceRGBA16       = (mng_bool)(pBuf->iBitdepth > 8);
-                                       /* make sure the delta-routines do the right thing */
-#endif
-          pData->iDeltatype   = MNG_DELTATYPE_BLOCKPIXELREPLACE;
-
-          switch (pBuf->iColortype)
-          {
-            case  0 : { 
-#ifndef MNG_NO_16BIT_SUPPORT
-                         if (bSourceRGBA16)
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_g16;
-                        else
-#endif
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_g8;
-
-                        pData->bIsOpaque      = (mng_bool)(!pBuf->bHasTRNS);
-                        break;
-                      }
-
-            case  2 : {
-#ifndef MNG_NO_16BIT_SUPPORT
-                        if (bSourceRGBA16)
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb16;
-                        else
-#endif
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb8;
-
-                        pData->bIsOpaque      = (mng_bool)(!pBuf->bHasTRNS);
-                        break;
-                      }
-
-
-            case  3 : { pData->fRetrieverow   = (mng_fptr)mng_retrieve_idx8;
-                        pData->bIsOpaque      = (mng_bool)(!pBuf->bHasTRNS);
-                        break;
-                      }
-
-
-            case  4 : {
-#ifndef MNG_NO_16BIT_SUPPORT
-                        if (bSourceRGBA16)
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_ga16;
-                        else
-#endif
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_ga8;
-
-                        pData->bIsOpaque      = MNG_FALSE;
-                        break;
-                      }
-
-
-            case  6 : {
-#ifndef MNG_NO_16BIT_SUPPORT
-                         if (bSourceRGBA16)
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba16;
-                        else
-#endif
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba8;
-
-                        pData->bIsOpaque      = MNG_FALSE;
-                        break;
-                      }
-
-            case  8 : {
-#ifndef MNG_NO_16BIT_SUPPORT
-                         if (bSourceRGBA16)
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_g16;
-                        else
-#endif
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_g8;
-
-                        pData->bIsOpaque      = MNG_TRUE;
-                        break;
-                      }
-
-            case 10 : {
-#ifndef MNG_NO_16BIT_SUPPORT
-                         if (bSourceRGBA16)
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb16;
-                        else
-#endif
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_rgb8;
-
-                        pData->bIsOpaque      = MNG_TRUE;
-                        break;
-                      }
-
-
-            case 12 : {
-#ifndef MNG_NO_16BIT_SUPPORT
-                         if (bSourceRGBA16)
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_ga16;
-                        else
-#endif
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_ga8;
-
-                        pData->bIsOpaque      = MNG_FALSE;
-                        break;
-                      }
-
-
-            case 14 : {
-#ifndef MNG_NO_16BIT_SUPPORT
-                         if (bSourceRGBA16)
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba16;
-                        else
-#endif
-                          pData->fRetrieverow = (mng_fptr)mng_retrieve_rgba8;
-
-                        pData->bIsOpaque      = MNG_FALSE;
-                        break;
-                      }
-          }
-                                       /* determine scaling */
-#ifndef MNG_NO_16BIT_SUPPORT
-#ifndef MNG_NO_DELTA_PNG
-          if ((!bSourceRGBA16) && (bTargetRGBA16))
-            pData->fScalerow = (mng_fptr)mng_scale_rgba8_rgba16;
-          else
-          if ((bSourceRGBA16) && (!bTargetRGBA16))
-            pData->fScalerow = (mng_fptr)mng_scale_rgba16_rgba8;
-          else
-#endif
-#endif
-            pData->fScalerow = MNG_NULL;
-
-                                       /* default no color-correction */
-          pData->fCorrectrow = MNG_NULL;
-
-#if defined(MNG_FULL_CMS)              /* determine color-management routine */
-          iRetcode = mng_init_full_cms   (pData, MNG_FALSE, MNG_FALSE, MNG_TRUE);
-#elif defined(MNG_GAMMA_ONLY)
-          iRetcode = mng_init_gamma_only (pData, MNG_FALSE, MNG_FALSE, MNG_TRUE);
-#elif defined(MNG_APP_CMS)
-          iRetcode = mng_init_app_cms    (pData, MNG_FALSE, MNG_FALSE, MNG_TRUE);
-#endif
-        }
-
-        if (!iRetcode)                 /* still ok ? */
-        {  
-          pData->fFliprow = MNG_NULL;  /* no flipping or tiling by default */
-          pData->fTilerow = MNG_NULL;
-                                       /* but perhaps we do have to ... */
-          switch (pSource->iOrientation)
-          {
-            case 2 : ;
-            case 4 : {
-#ifndef MNG_NO_16BIT_SUPPORT
-                       if (bTargetRGBA16)
-                         pData->fFliprow = (mng_fptr)mng_flip_rgba16;
-                       else
-#endif
-                         pData->fFliprow = (mng_fptr)mng_flip_rgba8;
-                       break;
-                     }
-
-            case 8 : {
-#ifndef MNG_NO_16BIT_SUPPORT
-                       if (bTargetRGBA16)
-                         pData->fTilerow = (mng_fptr)mng_tile_rgba16;
-                       else
-#endif
-                         pData->fTilerow = (mng_fptr)mng_tile_rgba8;
-                       break;
-                     }
-          }
-                                       /* determine composition routine */
-                                       /* note that we're abusing the delta-routine setup !!! */
-          switch (pSource->iComposition)
-          {
-            case 0 : {                 /* composite over */
-#ifndef MNG_NO_16BIT_SUPPORT
-                       if (bTargetRGBA16)
-                         pData->fDeltarow = (mng_fptr)mng_composeover_rgba16;
-                       else
-#endif
-                         pData->fDeltarow = (mng_fptr)mng_composeover_rgba8;
-                       break;
-                     }
-
-            case 1 : {                 /* replace */
-#ifndef MNG_NO_16BIT_SUPPORT
-                       if (bTargetRGBA16)
-                         pData->fDeltarow = (mng_fptr)mng_delta_rgba16_rgba16;
-                       else
-#endif
-                         pData->fDeltarow = (mng_fptr)mng_delta_rgba8_rgba8;
-                       break;
-                     }
-
-            case 2 : {                 /* composite under */
-#ifndef MNG_NO_16BIT_SUPPORT
-                       if (bTargetRGBA16)
-                         pData->fDeltarow = (mng_fptr)mng_composeunder_rgba16;
-                       else
-#endif
-                         pData->fDeltarow = (mng_fptr)mng_composeunder_rgba8;
-                       break;
-                     }
-          }
-                                       /* determine offsets & clipping */
-          if (pSource->iOffsettype == 1)
-          {
-            pData->iDestl          = pData->iPastx + pSource->iOffsetx;
-            pData->iDestt          = pData->iPasty + pSource->iOffsety;
-          }
-          else
-          {
-            pData->iDestl          = pSource->iOffsetx;
-            pData->iDestt          = pSource->iOffsety;
-          }
-
-          pData->iDestr            = (mng_int32)pTargetimg->pImgbuf->iWidth;
-          pData->iDestb            = (mng_int32)pTargetimg->pImgbuf->iHeight;
-                                       /* take the source dimension into account ? */
-          if (pSource->iOrientation != 8)
-          {
-            pData->iDestr          = MIN_COORD (pData->iDestr, pData->iDestl + (mng_int32)pBuf->iWidth);
-            pData->iDestb          = MIN_COORD (pData->iDestb, pData->iDestt + (mng_int32)pBuf->iHeight);
-          }
-                                       /* source clipping */
-          if (pSource->iBoundarytype == 1)
-          {
-            if (pData->iDestl < pData->iPastx + pSource->iBoundaryl)
-              pData->iSourcel      = pData->iPastx + pSource->iBoundaryl - pData->iDestl;
-            else
-              pData->iSourcel      = 0;
-
-            if (pData->iDestt < pData->iPasty + pSource->iBoundaryt)
-              pData->iSourcet      = pData->iPasty + pSource->iBoundaryt - pData->iDestt;
-            else
-              pData->iSourcet      = 0;
-
-            pData->iDestl          = MAX_COORD (pData->iDestl, pData->iPastx + pSource->iBoundaryl);
-            pData->iDestt          = MAX_COORD (pData->iDestt, pData->iPasty + pSource->iBoundaryt);
-            pData->iDestr          = MIN_COORD (pData->iDestr, pData->iPastx + pSource->iBoundaryr);
-            pData->iDestb          = MIN_COORD (pData->iDestb, pData->iPasty + pSource->iBoundaryb);
-          }
-          else
-          {
-            if (pData->iDestl < pSource->iBoundaryl)
-              pData->iSourcel      = pSource->iBoundaryl - pData->iDestl;
-            else
-              pData->iSourcel      = 0;
-
-            if (pData->iDestt < pSource->iBoundaryt)
-              pData->iSourcet      = pSource->iBoundaryt - pData->iDestt;
-            else
-              pData->iSourcet      = 0;
-
-            pData->iDestl          = MAX_COORD (pData->iDestl, pSource->iBoundaryl);
-            pData->iDestt          = MAX_COORD (pData->iDestt, pSource->iBoundaryt);
-            pData->iDestr          = MIN_COORD (pData->iDestr, pSource->iBoundaryr);
-            pData->iDestb          = MIN_COORD (pData->iDestb, pSource->iBoundaryb);
-          }
-
-          if (pData->iSourcel)         /* indent source ? */
-          {
-#ifndef MNG_NO_16BIT_SUPPORT
-             if (bTargetRGBA16)        /* abuse tiling routine to shift source-pixels */
-               pData->fTilerow = (mng_fptr)mng_tile_rgba16;
-             else
-#endif
-               pData->fTilerow = (mng_fptr)mng_tile_rgba8;
-          }
-                                       /* anything to display ? */
-          if ((pData->iDestl <= pData->iDestr) && (pData->iDestt <= pData->iDestb))
-          {                            /* init variables for the loop */
-            if ((pSource->iOrientation == 2) || (pSource->iOrientation == 6))
-            {
-              iSourceY             = (mng_int32)pBuf->iHeight - 1 - pData->iSourcet;
-              iSourceYinc          = -1;
-            }
-            else
-            {
-              iSourceY             = pData->iSourcet;
-              iSourceYinc          = 1;
-            }
-
-            iTargetY               = pData->iDestt;
-            pData->iCol            = pData->iDestl;
+                                           MNG_BITDEPTH_8, MNG_COLORTYPE_RGBA,
+                                           0, 0, 0, MNG_FALSE);
 
-            iTargetsamples         = pData->iDestr - pData->iDestl;
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
+    }
+    else
+      pTargetimg = MNG_NULL;           /* clipped beyond visibility ! */
+  }
 
-#ifndef MNG_NO_16BIT_SUPPORT
-            if (bTargetRGBA16)
-              iTargetrowsize       = (iTargetsamples << 3);
-            else
+  if (pTargetimg)                      /* usable destination ? */
+  {
+#ifdef MNG_OPTIMIZE_DISPLAYCALLS
+    mng_uint32     iCount = pData->iPASTcount;
+#endif
+    mng_past_jobp  pJobs  = MNG_NULL;
+    mng_uint32     iJobs  = 0;
+#ifndef MNG_SKIPCHUNK_MAGN
+                                       /* needs magnification ? */
+    if ((pTargetimg->iMAGN_MethodX) || (pTargetimg->iMAGN_MethodY))
+      iRetcode = mng_magnify_imageobject (pData, pTargetimg);
 #endif
-              iTargetrowsize       = (iTargetsamples << 2);
 
-                                       /* get temporary work-buffers */
-            if (iSourcerowsize > iTargetrowsize)
-              iTemprowsize         = iSourcerowsize << 1;
-            else
-              iTemprowsize         = iTargetrowsize << 1;
-            MNG_ALLOC (pData, pData->pRGBArow, iTemprowsize);
-            MNG_ALLOC (pData, pData->pWorkrow, iTemprowsize);
-
-            while ((!iRetcode) && (iTargetY < pData->iDestb))
-            {                          /* get a row */
-              pData->iRow          = iSourceY;
-              pData->iRowsamples   = iSourcesamples;
-              pData->iRowsize      = iSourcerowsize;
-#ifndef MNG_NO_16BIT_SUPPORT
-              pData->bIsRGBA16     = bSourceRGBA16;
+    if (!iRetcode)                     /* still ok ? */
+    {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+      switch (iTargettype)             /* determine target x/y */
+#else
+      switch (pData->iPASTtargettype)  /* determine target x/y */
 #endif
-              iRetcode             = ((mng_retrieverow)pData->fRetrieverow) (pData);
-                                       /* scale it (if necessary) */
-              if ((!iRetcode) && (pData->fScalerow))
-                iRetcode           = ((mng_scalerow)pData->fScalerow) (pData);
+      {
+        case 0 : {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   pData->iPastx = iTargetx;
+                   pData->iPasty = iTargety;
+#else
+                   pData->iPastx = pData->iPASTtargetx;
+                   pData->iPasty = pData->iPASTtargety;
+#endif
+                   break;
+                 }
 
-              pData->bIsRGBA16     = bTargetRGBA16;
-                                       /* color correction (if necessary) */
-              if ((!iRetcode) && (pData->fCorrectrow))
-                iRetcode           = ((mng_correctrow)pData->fCorrectrow) (pData);
-                                       /* flipping (if necessary) */
-              if ((!iRetcode) && (pData->fFliprow))
-                iRetcode           = ((mng_fliprow)pData->fFliprow) (pData);
-                                       /* tiling (if necessary) */
-              if ((!iRetcode) && (pData->fTilerow))
-                iRetcode           = ((mng_tilerow)pData->fTilerow) (pData);
+        case 1 : {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   pData->iPastx = pTargetimg->iPastx + iTargetx;
+                   pData->iPasty = pTargetimg->iPasty + iTargety;
+#else
+                   pData->iPastx = pTargetimg->iPastx + pData->iPASTtargetx;
+                   pData->iPasty = pTargetimg->iPasty + pData->iPASTtargety;
+#endif
+                   break;
+                 }
 
-              if (!iRetcode)           /* and paste..... */
-              {
-                pData->iRow        = iTargetY;
-                pData->iRowsamples = iTargetsamples;
-                pData->iRowsize    = iTargetrowsize;
-                iRetcode           = ((mng_deltarow)pData->fDeltarow) (pData);
-              }
+        case 2 : {
+#ifndef MNG_OPTIMIZE_DISPLAYCALLS
+                   pData->iPastx += iTargetx;
+                   pData->iPasty += iTargety;
+#else
+                   pData->iPastx += pData->iPASTtargetx;
+                   pData->iPasty += pData->iPASTtargety;
+#endif
+                   break;
+                 }
+      }
+                                       /* save for next time ... */
+      pTargetimg->iPastx      = pData->iPastx;
+      pTargetimg->iPasty      = pData->iPasty;
+                                       /* address destination for row-routines */
+      pData->pStoreobj        = (mng_objectp)pTargetimg;
+      pData->pStorebuf        = (mng_objectp)pTargetimg->pImgbuf;
+                                       /* room to queue up the sources */
+      if (iCount)
+        MNG_ALLOC (pData, pJobs, iCount * sizeof (mng_past_job));
+    }
+                                       /* setup the sources one by one; the ones
+                                          that need nothing special are queued
+                                          and pasted together, band by band */
+    while ((!iRetcode) && (iX < iCount))
+    {
+      iRetcode = past_setup_job (pData, pTargetimg, pSource, pJobs + iJobs);
 
-              iSourceY += iSourceYinc; /* and next line */
+      if ((!iRetcode) && (pJobs [iJobs].pSourceimg))
+      {                                /* needs correcting or reads the target ? */
+        if ((pJobs [iJobs].fCorrectrow) ||
+            (pJobs [iJobs].pSourceimg->pImgbuf == pTargetimg->pImgbuf))
+        {                              /* then flush the queue & do it by itself */
+          iRetcode = past_paste_jobs (pData, pJobs, iJobs);
 
-              if (iSourceY < 0)
-                iSourceY = (mng_int32)pBuf->iHeight - 1;
-              else
-              if (iSourceY >= (mng_int32)pBuf->iHeight)
-                iSourceY = 0;
+          if (!iRetcode)
+            iRetcode = past_paste_jobs (pData, pJobs + iJobs, 1);
 
-              iTargetY++;
-            }
-                                       /* drop the temporary row-buffer */
-            MNG_FREEX (pData, pData->pWorkrow, iTemprowsize);
-            MNG_FREEX (pData, pData->pRGBArow, iTemprowsize);
-          }
+          iJobs = 0;
+        }
+        else
+          iJobs++;
+      }
 
 #if defined(MNG_FULL_CMS)              /* cleanup cms stuff */
-          if (!iRetcode)
-            iRetcode = mng_clear_cms (pData);
+      if (!iRetcode)
+        iRetcode = mng_clear_cms (pData);
 #endif
-        }
 
-        pSource++;                     /* neeeeext */
-        iX++;
-      }
+      pSource++;                       /* neeeeext */
+      iX++;
     }
 
+    if (!iRetcode)                     /* paste what's still queued */
+      iRetcode = past_paste_jobs (pData, pJobs, iJobs);
+
+    if (pJobs)
+      MNG_FREE (pData, pJobs, iCount * sizeof (mng_past_job));
+
     if (iRetcode)                      /* on error bail out */
       return iRetcode;
 
@@ -7142,6 +8989,460 @@ mng_retcode mng_process_display_past2 (mng_datap pData)
 }
 #endif /* MNG_SKIPCHUNK_PAST */
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Direct image-data extraction - used by the mng_getimgdata_xxx          * */
+/* * functions to decode a stored image straight onto a caller's canvas,    * */
+/* * without creating objects or touching the animation/timer machinery     * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+MNG_LOCAL void imgdata_header (mng_datap  pData,
+                               mng_uint32 iWidth,
+                               mng_uint32 iHeight,
+                               mng_uint8  iBitdepth,
+                               mng_uint8  iColortype,
+                               mng_uint8  iCompression,
+                               mng_uint8  iFilter,
+                               mng_uint8  iInterlace)
+{                                      /* same as reading the IHDR */
+  pData->iDatawidth   = iWidth;
+  pData->iDataheight  = iHeight;
+  pData->iBitdepth    = iBitdepth;
+  pData->iColortype   = iColortype;
+  pData->iCompression = iCompression;
+  pData->iFilter      = iFilter;
+  pData->iInterlace   = iInterlace;
+
+#if defined(MNG_NO_1_2_4BIT_SUPPORT) || defined(MNG_NO_16BIT_SUPPORT)
+  pData->iPNGmult  = 1;
+  pData->iPNGdepth = pData->iBitdepth;
+#endif
+#ifdef MNG_NO_1_2_4BIT_SUPPORT
+  if (pData->iBitdepth < 8)
+    pData->iBitdepth = 8;
+#endif
+#ifdef MNG_NO_16BIT_SUPPORT
+  if (pData->iBitdepth > 8)
+  {
+    pData->iBitdepth = 8;
+    pData->iPNGmult  = 2;
+  }
+#endif
+
+  return;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void imgdata_trns (mng_datap      pData,
+                             mng_imagedatap pBuf,
+                             mng_uint32     iRawlen,
+                             mng_uint8p     pRawdata)
+{                                      /* tRNS from raw (global) data */
+  pBuf->bHasTRNS = MNG_TRUE;
+
+  switch (pData->iColortype)
+  {
+    case 0 : {                         /* gray */
+               if (iRawlen >= 2)
+                 pBuf->iTRNSgray = mng_get_uint16 (pRawdata);
+               break;
+             }
+    case 2 : {                         /* rgb */
+               if (iRawlen >= 6)
+               {
+                 pBuf->iTRNSred   = mng_get_uint16 (pRawdata);
+                 pBuf->iTRNSgreen = mng_get_uint16 (pRawdata+2);
+                 pBuf->iTRNSblue  = mng_get_uint16 (pRawdata+4);
+               }
+               break;
+             }
+    case 3 : {                         /* indexed */
+               if (iRawlen > 256)
+                 iRawlen = 256;
+               pBuf->iTRNScount = iRawlen;
+               MNG_COPY (pBuf->aTRNSentries, pRawdata, iRawlen);
+               break;
+             }
+    default: {                         /* not allowed; ignore it */
+               pBuf->bHasTRNS = MNG_FALSE;
+               break;
+             }
+  }
+
+  return;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_decode_imgdata (mng_datap         pData,
+                                mng_chunkp        pHeader,
+                                mng_uint32        iCanvasstyle,
+                                mng_getcanvasline fGetcanvasline)
+{
+  mng_chunkp        pChunk;
+  mng_chunkp        pFirstdata   = MNG_NULL;
+  mng_pltep         pGlobalplte  = MNG_NULL;
+  mng_trnsp         pGlobaltrns  = MNG_NULL;
+  mng_bool          bInside      = MNG_FALSE;
+  mng_imagedatap    pBuf         = MNG_NULL;
+  mng_retcode       iRetcode     = MNG_NOERROR;
+  mng_retcode       iError       = MNG_NOERROR;
+  mng_chunkid       iChunkname;
+                                       /* state borrowed from the display */
+  mng_uint32        iSavewidth   = pData->iDatawidth;
+  mng_uint32        iSaveheight  = pData->iDataheight;
+  mng_uint8         iSavedepth   = pData->iBitdepth;
+  mng_uint8         iSavetype    = pData->iColortype;
+  mng_uint8         iSavecompr   = pData->iCompression;
+  mng_uint8         iSavefilter  = pData->iFilter;
+  mng_uint8         iSaveinterl  = pData->iInterlace;
+#if defined(MNG_NO_1_2_4BIT_SUPPORT) || defined(MNG_NO_16BIT_SUPPORT)
+  mng_uint8         iSavemult    = pData->iPNGmult;
+  mng_uint8         iSavepngdep  = pData->iPNGdepth;
+#endif
+#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
+  png_imgtype       eSaveimgtype = pData->ePng_imgtype;
+#endif
+  mng_uint32        iSavestyle   = pData->iCanvasstyle;
+  mng_getcanvasline fSaveline    = pData->fGetcanvasline;
+  mng_bool          bSaverefresh = pData->bNeedrefresh;
+  mng_uint32        iSaveupdl    = pData->iUpdateleft;
+  mng_uint32        iSaveupdr    = pData->iUpdateright;
+  mng_uint32        iSaveupdt    = pData->iUpdatetop;
+  mng_uint32        iSaveupdb    = pData->iUpdatebottom;
+  mng_dirtylist     sSavedirty   = pData->sDirty;
+  mng_objectp       pSavestore   = pData->pStoreobj;
+  mng_ptr           pSavebuf     = pData->pStorebuf;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_DECODE_IMGDATA, MNG_LC_START);
+#endif
+
+                                       /* can we deliver this ? */
+  if ((MNG_CANVAS_PIXELTYPE (iCanvasstyle) > 2) || (MNG_CANVAS_ALPHASEPD (iCanvasstyle)))
+    MNG_ERROR (pData, MNG_INVALIDCNVSTYLE);
+                                       /* not while an image is being processed */
+  if ((pData->bHasIHDR) || (pData->bHasBASI) || (pData->bHasDHDR) ||
+#ifdef MNG_INCLUDE_JNG
+      (pData->bHasJHDR) ||
+#endif
+      (pData->bInflating) || (pData->pWorkrow) || (pData->pRGBArow))
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID);
+
+  iChunkname = ((mng_chunk_headerp)pHeader)->iChunkname;
+
+#ifndef MNG_NO_DELTA_PNG
+  if (iChunkname == MNG_UINT_DHDR)     /* only full replacement carries a
+                                          complete image (in the IHDR) */
+  {
+    if (((mng_dhdrp)pHeader)->iDeltatype != MNG_DELTATYPE_REPLACE)
+      MNG_ERROR (pData, MNG_FNNOTIMPLEMENTED);
+
+    pChunk = ((mng_chunk_headerp)pHeader)->pNext;
+
+    while ((pChunk) &&
+           (((mng_chunk_headerp)pChunk)->iChunkname != MNG_UINT_IHDR) &&
+           (((mng_chunk_headerp)pChunk)->iChunkname != MNG_UINT_IEND)    )
+      pChunk = ((mng_chunk_headerp)pChunk)->pNext;
+
+    if ((!pChunk) || (((mng_chunk_headerp)pChunk)->iChunkname != MNG_UINT_IHDR))
+      MNG_ERROR (pData, MNG_NOHEADER);
+
+    pHeader    = pChunk;
+    iChunkname = MNG_UINT_IHDR;
+  }
+#endif
+
+                                       /* temporary buffer for PLTE & tRNS; get it
+                                          before anything of the display changes */
+  MNG_ALLOC (pData, pBuf, sizeof (mng_imagedata));
+
+  if (iChunkname == MNG_UINT_IHDR)
+    imgdata_header (pData, ((mng_ihdrp)pHeader)->iWidth,
+                    ((mng_ihdrp)pHeader)->iHeight, ((mng_ihdrp)pHeader)->iBitdepth,
+                    ((mng_ihdrp)pHeader)->iColortype, ((mng_ihdrp)pHeader)->iCompression,
+                    ((mng_ihdrp)pHeader)->iFilter, ((mng_ihdrp)pHeader)->iInterlace);
+#ifndef MNG_SKIPCHUNK_BASI
+  else
+  if (iChunkname == MNG_UINT_BASI)
+    imgdata_header (pData, ((mng_basip)pHeader)->iWidth,
+                    ((mng_basip)pHeader)->iHeight, ((mng_basip)pHeader)->iBitdepth,
+                    ((mng_basip)pHeader)->iColortype, ((mng_basip)pHeader)->iCompression,
+                    ((mng_basip)pHeader)->iFilter, ((mng_basip)pHeader)->iInterlace);
+#endif
+  else
+  {                                    /* JNG decoding needs objects */
+    MNG_FREEX (pData, pBuf, sizeof (mng_imagedata));
+    MNG_ERROR (pData, MNG_FNNOTIMPLEMENTED);
+  }
+                                       /* find the global PLTE/tRNS in effect */
+  pChunk = pData->pFirstchunk;
+
+  while ((pChunk) && (pChunk != pHeader))
+  {
+    switch (((mng_chunk_headerp)pChunk)->iChunkname)
+    {
+      case MNG_UINT_IHDR :
+      case MNG_UINT_BASI :
+      case MNG_UINT_DHDR :
+      case MNG_UINT_JHDR : { bInside = MNG_TRUE;  break; }
+      case MNG_UINT_IEND : { bInside = MNG_FALSE; break; }
+      case MNG_UINT_PLTE : {
+                             if (!bInside)
+                               pGlobalplte = (mng_pltep)pChunk;
+                             break;
+                           }
+      case MNG_UINT_tRNS : {
+                             if (!bInside)
+                               pGlobaltrns = (mng_trnsp)pChunk;
+                             break;
+                           }
+    }
+
+    pChunk = ((mng_chunk_headerp)pChunk)->pNext;
+  }
+
+  pBuf->iWidth     = pData->iDatawidth;
+  pBuf->iHeight    = pData->iDataheight;
+  pBuf->iBitdepth  = pData->iBitdepth;
+  pBuf->iColortype = pData->iColortype;
+                                       /* gather the palette & transparency */
+  pChunk = ((mng_chunk_headerp)pHeader)->pNext;
+
+  while ((pChunk) && (((mng_chunk_headerp)pChunk)->iChunkname != MNG_UINT_IEND))
+  {
+    iChunkname = ((mng_chunk_headerp)pChunk)->iChunkname;
+
+    if ((iChunkname == MNG_UINT_IDAT) && (!pFirstdata))
+      pFirstdata = pChunk;
+    else
+    if (iChunkname == MNG_UINT_PLTE)
+    {
+      mng_pltep pPLTE = (mng_pltep)pChunk;
+
+      if ((pPLTE->bEmpty) && (pGlobalplte))
+      {                                /* inherit the global one */
+        pPLTE = pGlobalplte;
+
+        if ((pGlobaltrns) && (!pGlobaltrns->bEmpty))
+          imgdata_trns (pData, pBuf, pGlobaltrns->iRawlen, pGlobaltrns->aRawdata);
+      }
+
+      pBuf->bHasPLTE   = MNG_TRUE;
+      pBuf->iPLTEcount = pPLTE->iEntrycount;
+      MNG_COPY (pBuf->aPLTEentries, pPLTE->aEntries, sizeof (pBuf->aPLTEentries));
+    }
+    else
+    if (iChunkname == MNG_UINT_tRNS)
+    {
+      mng_trnsp pTRNS = (mng_trnsp)pChunk;
+
+      if (pTRNS->bEmpty)
+      {
+        if ((pGlobaltrns) && (!pGlobaltrns->bEmpty))
+          imgdata_trns (pData, pBuf, pGlobaltrns->iRawlen, pGlobaltrns->aRawdata);
+      }
+      else
+      {
+        pBuf->bHasTRNS   = MNG_TRUE;
+        pBuf->iTRNSgray  = pTRNS->iGray;
+        pBuf->iTRNSred   = pTRNS->iRed;
+        pBuf->iTRNSgreen = pTRNS->iGreen;
+        pBuf->iTRNSblue  = pTRNS->iBlue;
+        pBuf->iTRNScount = pTRNS->iCount;
+        MNG_COPY (pBuf->aTRNSentries, pTRNS->aEntries, sizeof (pBuf->aTRNSentries));
+      }
+    }
+
+    pChunk = ((mng_chunk_headerp)pChunk)->pNext;
+  }
+
+#if defined(MNG_NO_16BIT_SUPPORT)
+  if (pData->iPNGmult == 2)            /* match the reduced samples */
+  {
+    pBuf->iTRNSgray  >>= 8;
+    pBuf->iTRNSred   >>= 8;
+    pBuf->iTRNSgreen >>= 8;
+    pBuf->iTRNSblue  >>= 8;
+  }
+#endif
+
+  if ((pData->iColortype == MNG_COLORTYPE_INDEXED) && (!pBuf->bHasPLTE))
+    iError = MNG_PLTEMISSING;
+  else
+  if ((!pFirstdata) && (((mng_chunk_headerp)pHeader)->iChunkname == MNG_UINT_IHDR))
+    iError = MNG_IDATMISSING;
+
+  if (!iError)                         /* borrow the row-processing machinery */
+  {
+    pData->iCanvasstyle   = iCanvasstyle;
+    pData->fGetcanvasline = fGetcanvasline;
+    pData->pStoreobj      = MNG_NULL;
+    pData->pStorebuf      = (mng_ptr)pBuf;
+    pData->fInitrowproc   = MNG_NULL;
+    pData->fProcessrow    = MNG_NULL;
+    pData->fStorerow      = MNG_NULL;
+    pData->fCorrectrow    = MNG_NULL;
+    pData->fDifferrow     = MNG_NULL;
+    pData->fDisplayrow    = (mng_fptr)mng_display_imgdata;
+
+#ifndef MNG_SKIPCHUNK_BASI
+    if (!pFirstdata)                   /* BASI without pixel-data ? */
+    {
+      mng_basip  pBASI = (mng_basip)pHeader;
+      mng_uint16 iR    = pBASI->iRed;
+      mng_uint16 iG    = pBASI->iGreen;
+      mng_uint16 iB    = pBASI->iBlue;
+      mng_uint16 iA    = 0xFFFF;
+      mng_uint8p pWork;
+      mng_uint32 iX, iY;
+
+      if (pData->iColortype == MNG_COLORTYPE_GRAY)
+      {
+        mng_uint8 multiplier[]={0,255,85,0,17,0,0,0,1};
+
+        if (pBASI->iBitdepth < 8)      /* scale up sub-byte gray */
+          iR = (mng_uint16)(iR * multiplier [pBASI->iBitdepth]);
+
+        iG = iR;
+        iB = iR;
+      }
+      else
+      if (pData->iColortype == MNG_COLORTYPE_GRAYA)
+      {
+        iG = iR;
+        iB = iR;
+      }
+
+      if ((pData->iColortype == MNG_COLORTYPE_GRAYA) ||
+          (pData->iColortype == MNG_COLORTYPE_RGBA )    )
+        iA = pBASI->iAlpha;
+
+      pData->bIsRGBA16   = (mng_bool)(pBASI->iBitdepth == 16);
+      pData->iCol        = 0;
+      pData->iColinc     = 1;
+      pData->iRowsamples = pData->iDatawidth;
+
+      MNG_ALLOCX (pData, pData->pRGBArow, (pData->iDatawidth << 3));
+
+      if (!pData->pRGBArow)
+        iError = MNG_OUTOFMEMORY;
+      else
+      {
+        pWork = pData->pRGBArow;       /* a single row of the sample color */
+
+        for (iX = 0; iX < pData->iDatawidth; iX++)
+        {
+          if (pData->bIsRGBA16)
+          {
+            mng_put_uint16 (pWork,   iR);
+            mng_put_uint16 (pWork+2, iG);
+            mng_put_uint16 (pWork+4, iB);
+            mng_put_uint16 (pWork+6, iA);
+            pWork += 8;
+          }
+          else
+          {
+            *pWork     = (mng_uint8)iR;
+            *(pWork+1) = (mng_uint8)iG;
+            *(pWork+2) = (mng_uint8)iB;
+            *(pWork+3) = (mng_uint8)((iA == 0xFFFF) ? 0xFF : iA);
+            pWork += 4;
+          }
+        }
+
+        for (iY = 0; (!iRetcode) && (iY < pData->iDataheight); iY++)
+        {
+          pData->iRow = (mng_int32)iY;
+          iRetcode    = mng_display_imgdata (pData);
+        }
+      }
+    }
+    else
+#endif
+    {
+      set_rowinit_routine (pData);     /* same as for an IHDR */
+
+      if (pData->fInitrowproc)
+        iRetcode = ((mng_initrowproc)pData->fInitrowproc) (pData);
+      else
+        iError   = MNG_INVALIDCOLORTYPE;
+
+      pData->fInitrowproc = MNG_NULL;
+      pData->fCorrectrow  = MNG_NULL;  /* deliver the raw pixel-data */
+
+      if ((!iRetcode) && (!iError))
+        iRetcode = mngzlib_inflateinit (pData);
+
+      pChunk = pFirstdata;             /* feed all the IDATs */
+
+      while ((!iRetcode) && (!iError) && (pChunk) &&
+             (((mng_chunk_headerp)pChunk)->iChunkname != MNG_UINT_IEND))
+      {
+        if ((((mng_chunk_headerp)pChunk)->iChunkname == MNG_UINT_IDAT) &&
+            (((mng_idatp)pChunk)->iDatasize))
+          iRetcode = mngzlib_inflaterows (pData, ((mng_idatp)pChunk)->iDatasize,
+                                          (mng_uint8p)((mng_idatp)pChunk)->pData);
+
+        pChunk = ((mng_chunk_headerp)pChunk)->pNext;
+      }
+
+      if ((!iRetcode) && (!iError) &&  /* got all the rows ? */
+          ( ((pData->iPass <  0) && (pData->iRow < (mng_int32)pData->iDataheight)) ||
+            ((pData->iPass >= 0) && (pData->iPass < 7)                            )    ))
+        iError = MNG_NOTENOUGHIDAT;
+
+      if (pData->bInflating)           /* done with zlib */
+      {
+        mng_retcode iRetcode2 = mngzlib_inflatefree (pData);
+
+        if (!iRetcode)
+          iRetcode = iRetcode2;
+      }
+    }
+  }
+                                       /* cleanup & give the display back */
+  mng_cleanup_rowproc (pData);
+  MNG_FREEX (pData, pBuf, sizeof (mng_imagedata));
+
+  pData->fDisplayrow    = MNG_NULL;
+  pData->fProcessrow    = MNG_NULL;
+  pData->fDifferrow     = MNG_NULL;
+  pData->iCanvasstyle   = iSavestyle;
+  pData->fGetcanvasline = fSaveline;
+  pData->bNeedrefresh   = bSaverefresh;
+  pData->iUpdateleft    = iSaveupdl;   /* it's not on the display canvas */
+  pData->iUpdateright   = iSaveupdr;
+  pData->iUpdatetop     = iSaveupdt;
+  pData->iUpdatebottom  = iSaveupdb;
+  pData->sDirty         = sSavedirty;
+  pData->pStoreobj      = pSavestore;
+  pData->pStorebuf      = pSavebuf;
+
+  imgdata_header (pData, iSavewidth, iSaveheight, iSavedepth, iSavetype,
+                  iSavecompr, iSavefilter, iSaveinterl);
+#if defined(MNG_NO_1_2_4BIT_SUPPORT) || defined(MNG_NO_16BIT_SUPPORT)
+  pData->iPNGmult     = iSavemult;
+  pData->iPNGdepth    = iSavepngdep;
+#endif
+#ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
+  pData->ePng_imgtype = eSaveimgtype;
+#endif
+
+  if (iError)                          /* others have been reported already */
+    MNG_ERROR (pData, iError);
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_DECODE_IMGDATA, MNG_LC_END);
+#endif
+
+  return iRetcode;
+}
+#endif /* MNG_SUPPORT_DISPLAY && MNG_ACCESS_CHUNKS && MNG_STORE_CHUNKS */
+
 /* ************************************************************************** */
 
 #endif /* MNG_INCLUDE_DISPLAY_PROCS */
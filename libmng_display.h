@@ -59,6 +59,10 @@
 /* *             1.0.10 - 04/12/2007 - G.Juyn                               * */
 /* *             - added support for ANG proposal                           * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added direct image-data extraction for getimgdata        * */
+/* *             - added dirty-rectangle routines                           * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -77,6 +81,11 @@
 mng_retcode mng_display_progressive_refresh (mng_datap  pData,
                                              mng_uint32 iInterval);
 
+void        mng_open_dirtyrect        (mng_datap      pData,
+                                       mng_int32      iRow);
+void        mng_close_dirtyrect       (mng_datap      pData);
+void        mng_reset_dirtyrects      (mng_datap      pData);
+
 /* ************************************************************************** */
 
 mng_retcode mng_reset_objzero         (mng_datap      pData);
@@ -95,6 +104,28 @@ mng_retcode mng_process_display       (mng_datap      pData);
 
 /* ************************************************************************** */
 
+#ifdef MNG_SUPPORT_KEYFRAMES
+mng_retcode   mng_store_keyframe      (mng_datap      pData);
+mng_keyframep mng_find_keyframe       (mng_datap      pData,
+                                       mng_uint32     iFramenr,
+                                       mng_uint32     iLayernr,
+                                       mng_uint32     iPlaytime);
+mng_retcode   mng_restore_keyframe    (mng_datap      pData,
+                                       mng_keyframep  pKeyframe);
+mng_retcode   mng_drop_keyframes      (mng_datap      pData);
+#endif
+
+/* ************************************************************************** */
+
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+mng_retcode   mng_decode_imgdata      (mng_datap         pData,
+                                       mng_chunkp        pHeader,
+                                       mng_uint32        iCanvasstyle,
+                                       mng_getcanvasline fGetcanvasline);
+#endif
+
+/* ************************************************************************** */
+
 #ifdef MNG_OPTIMIZE_FOOTPRINT_INIT
 png_imgtype mng_png_imgtype           (mng_uint8      colortype,
                                        mng_uint8      bitdepth);
@@ -0,0 +1,705 @@
+/* ************************************************************************** */
+/* *             For conditions of distribution and use,                    * */
+/* *                see copyright notice in libmng.h                        * */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * project   : libmng                                                     * */
+/* * file      : libmng_encode.c           copyright (c) 2026               * */
+/* * version   : 1.0.11                                                     * */
+/* *                                                                        * */
+/* * purpose   : Frame-sequence encoder (implementation)                    * */
+/* *                                                                        * */
+/* * comment   : implementation of mng_putframe; turns a sequence of full   * */
+/* *             RGBA frames into FRAM/DEFI/IHDR images, delta-PNG blocks   * */
+/* *             and CLIP chunks in the list of stored chunks               * */
+/* *                                                                        * */
+/* * changes   : 1.0.11 - 10/17/2026                                        * */
+/* *             - initial version                                          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#include "libmng.h"
+#include "libmng_data.h"
+#include "libmng_error.h"
+#include "libmng_trace.h"
+#ifdef __BORLANDC__
+#pragma hdrstop
+#endif
+#include "libmng_memory.h"
+#include "libmng_chunks.h"
+#include "libmng_filter.h"
+#include "libmng_zlib.h"
+#include "libmng_encode.h"
+
+#if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
+#pragma option -A                      /* force ANSI-C */
+#endif
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_ENCODER
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Every frame lives in object 1, a concrete RGB or RGBA image the size   * */
+/* * of the MHDR canvas. A frame is either a new image for object 1, a      * */
+/* * delta-PNG block for the part that changed, or nothing at all when it   * */
+/* * is identical to the previous one (then that frame is kept on screen    * */
+/* * longer). Opaque changes are drawn in framing-mode 1 with object 1      * */
+/* * clipped to the changed block, so the player only recomposes that part; * */
+/* * anything translucent needs a fresh background (framing-mode 4) and a   * */
+/* * full redraw                                                            * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#define MNG_ENC_OBJECTID 1
+
+#define MNG_ENC_FULL     0             /* encodings for a frame */
+#define MNG_ENC_ADD      1
+#define MNG_ENC_REPLACE  2
+
+/* ************************************************************************** */
+
+void mng_drop_encoder (mng_datap pData)
+{
+  MNG_FREE (pData, pData->pEncframe, pData->iEncframesize);
+  MNG_FREE (pData, pData->pEncnext,  pData->iEncframesize);
+
+  pData->iEncframesize = 0;
+  pData->iEncframes    = 0;
+  pData->iEncdelay     = 0;
+  pData->bEncdefault   = MNG_FALSE;
+  pData->pEncfram      = MNG_NULL;
+  pData->iEncmode      = 0;
+  pData->iEnccolortype = 0;
+  pData->bEncclipped   = MNG_FALSE;
+  pData->iEncclipl     = 0;
+  pData->iEncclipr     = 0;
+  pData->iEncclipt     = 0;
+  pData->iEncclipb     = 0;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool block_opaque (mng_uint8p pFrame,
+                                 mng_uint32 iRowsize,
+                                 mng_uint32 iX,
+                                 mng_uint32 iY,
+                                 mng_uint32 iWidth,
+                                 mng_uint32 iHeight)
+{
+  mng_uint32 iCol, iRow;
+  mng_uint8p pAlpha;
+
+  for (iRow = iY; iRow < iY + iHeight; iRow++)
+  {
+    pAlpha = pFrame + iRow * iRowsize + iX * 4 + 3;
+
+    for (iCol = 0; iCol < iWidth; iCol++)
+    {
+      if (*pAlpha != 0xFF)
+        return MNG_FALSE;
+
+      pAlpha += 4;
+    }
+  }
+
+  return MNG_TRUE;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool block_samealpha (mng_uint8p pFrame,
+                                    mng_uint8p pPrev,
+                                    mng_uint32 iRowsize,
+                                    mng_uint32 iX,
+                                    mng_uint32 iY,
+                                    mng_uint32 iWidth,
+                                    mng_uint32 iHeight)
+{
+  mng_uint32 iCol, iRow;
+  mng_uint32 iOffset;
+
+  for (iRow = iY; iRow < iY + iHeight; iRow++)
+  {
+    iOffset = iRow * iRowsize + iX * 4 + 3;
+
+    for (iCol = 0; iCol < iWidth; iCol++)
+    {
+      if (*(pFrame + iOffset) != *(pPrev + iOffset))
+        return MNG_FALSE;
+
+      iOffset += 4;
+    }
+  }
+
+  return MNG_TRUE;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool changed_block (mng_uint8p  pFrame,
+                                  mng_uint8p  pPrev,
+                                  mng_uint32  iRowsize,
+                                  mng_uint32  iWidth,
+                                  mng_uint32  iHeight,
+                                  mng_uint32 *iX,
+                                  mng_uint32 *iY,
+                                  mng_uint32 *iBlockwidth,
+                                  mng_uint32 *iBlockheight)
+{
+  mng_uint32 iTop, iBottom, iLeft, iRight;
+  mng_uint32 iRow, iCol;
+  mng_uint8p pSrc, pOld;
+                                       /* whole rows first */
+  for (iTop = 0; iTop < iHeight; iTop++)
+    if (memcmp (pFrame + iTop * iRowsize, pPrev + iTop * iRowsize, iRowsize))
+      break;
+
+  if (iTop >= iHeight)                 /* nothing changed at all ? */
+    return MNG_FALSE;
+
+  for (iBottom = iHeight; iBottom > iTop + 1; iBottom--)
+    if (memcmp (pFrame + (iBottom - 1) * iRowsize,
+                pPrev  + (iBottom - 1) * iRowsize, iRowsize))
+      break;
+
+  iLeft  = iWidth;                     /* then narrow it down to the columns */
+  iRight = 0;
+
+  for (iRow = iTop; iRow < iBottom; iRow++)
+  {
+    pSrc = pFrame + iRow * iRowsize;
+    pOld = pPrev  + iRow * iRowsize;
+
+    for (iCol = 0; iCol < iLeft; iCol++)
+      if (memcmp (pSrc + iCol * 4, pOld + iCol * 4, 4))
+        break;
+
+    if (iCol < iLeft)
+      iLeft = iCol;
+
+    for (iCol = iWidth; iCol > iRight; iCol--)
+      if (memcmp (pSrc + (iCol - 1) * 4, pOld + (iCol - 1) * 4, 4))
+        break;
+
+    if (iCol > iRight)
+      iRight = iCol;
+  }
+
+  *iX           = iLeft;
+  *iY           = iTop;
+  *iBlockwidth  = iRight  - iLeft;
+  *iBlockheight = iBottom - iTop;
+
+  return MNG_TRUE;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode encode_block (mng_datap   pData,
+                                    mng_uint8p  pFrame,
+                                    mng_uint8p  pPrev,
+                                    mng_uint32  iRowsize,
+                                    mng_uint32  iX,
+                                    mng_uint32  iY,
+                                    mng_uint32  iWidth,
+                                    mng_uint32  iHeight,
+                                    mng_uint32  iChannels,
+                                    mng_uint8p *pZdata,
+                                    mng_uint32 *iZsize,
+                                    mng_uint32 *iZlen)
+{
+  mng_uint32  iRowbytes = iWidth * iChannels;
+  mng_uint32  iFiltsize = iHeight * (iRowbytes + 1);
+  mng_uint8   iFiltersel = pData->iFiltersel;
+  mng_uint8p  pRaw    = MNG_NULL;
+  mng_uint8p  pPrior  = MNG_NULL;
+  mng_uint8p  pOut    = MNG_NULL;
+  mng_uint8p  pTemp   = MNG_NULL;
+  mng_uint8p  pFiltbuf;
+  mng_uint8p  pFiltered;
+  mng_uint8p  pSwap;
+  mng_uint8p  pSrc, pOld, pDst;
+  mng_uint32  iRow, iCol, iC;
+  mng_retcode iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_ENCODE_BLOCK, MNG_LC_START);
+#endif
+
+  MNG_ALLOC (pData, pFiltbuf, iFiltsize);
+  MNG_ALLOCX (pData, pRaw,   iRowbytes);
+  MNG_ALLOCX (pData, pPrior, iRowbytes);
+  MNG_ALLOCX (pData, pOut,   iRowbytes + 1);
+  MNG_ALLOCX (pData, pTemp,  iRowbytes + 1);
+
+  if ((!pRaw) || (!pPrior) || (!pOut) || (!pTemp))
+  {
+    MNG_FREEX (pData, pTemp,    iRowbytes + 1);
+    MNG_FREEX (pData, pOut,     iRowbytes + 1);
+    MNG_FREEX (pData, pPrior,   iRowbytes);
+    MNG_FREEX (pData, pRaw,     iRowbytes);
+    MNG_FREEX (pData, pFiltbuf, iFiltsize);
+    MNG_ERROR (pData, MNG_OUTOFMEMORY);
+  }
+                                       /* pack & filter the rows */
+  for (iRow = 0; iRow < iHeight; iRow++)
+  {
+    pSrc = pFrame + (iY + iRow) * iRowsize + iX * 4;
+    pDst = pRaw;
+
+    if (pPrev)                         /* pixel-differences ? */
+    {
+      pOld = pPrev + (iY + iRow) * iRowsize + iX * 4;
+
+      for (iCol = 0; iCol < iWidth; iCol++)
+      {
+        for (iC = 0; iC < iChannels; iC++)
+          *(pDst + iC) = (mng_uint8)(*(pSrc + iC) - *(pOld + iC));
+
+        pSrc += 4;
+        pOld += 4;
+        pDst += iChannels;
+      }
+    }
+    else
+    if (iChannels == 4)
+      MNG_COPY (pDst, pSrc, iRowbytes)
+    else
+    {
+      for (iCol = 0; iCol < iWidth; iCol++)
+      {
+        *pDst     = *pSrc;
+        *(pDst+1) = *(pSrc+1);
+        *(pDst+2) = *(pSrc+2);
+
+        pSrc += 4;
+        pDst += 3;
+      }
+    }
+
+    pFiltered = mng_select_filter (pData, iFiltersel, (mng_int32)iChannels,
+                                   (mng_int32)iRowbytes, pRaw, pPrior, pOut, pTemp);
+
+    MNG_COPY (pFiltbuf + iRow * (iRowbytes + 1), pFiltered, iRowbytes + 1);
+
+    pSwap  = pPrior;                   /* this row is the next one's prior */
+    pPrior = pRaw;
+    pRaw   = pSwap;
+  }
+
+  MNG_FREEX (pData, pTemp,  iRowbytes + 1);
+  MNG_FREEX (pData, pOut,   iRowbytes + 1);
+  MNG_FREEX (pData, pPrior, iRowbytes);
+  MNG_FREEX (pData, pRaw,   iRowbytes);
+                                       /* deflate never grows it by more */
+  *iZsize = iFiltsize + (iFiltsize >> 7) + 64;
+
+  MNG_ALLOCX (pData, *pZdata, *iZsize);
+
+  if (!*pZdata)
+  {
+    MNG_FREEX (pData, pFiltbuf, iFiltsize);
+    MNG_ERROR (pData, MNG_OUTOFMEMORY);
+  }
+
+  iRetcode = mngzlib_deflateinit (pData);
+
+  if (!iRetcode)
+  {
+    pData->sZlib.next_out  = *pZdata;
+    pData->sZlib.avail_out = (uInt)*iZsize;
+
+    iRetcode = mngzlib_deflatedata (pData, iFiltsize, pFiltbuf);
+    *iZlen   = (mng_uint32)pData->sZlib.total_out;
+
+    mngzlib_deflatefree (pData);
+  }
+
+  MNG_FREEX (pData, pFiltbuf, iFiltsize);
+
+  if (iRetcode)
+  {
+    MNG_FREE (pData, *pZdata, *iZsize);
+    return iRetcode;
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_ENCODE_BLOCK, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode put_idats (mng_datap  pData,
+                                 mng_uint8p pZdata,
+                                 mng_uint32 iZlen)
+{
+  mng_uint32  iMax = (pData->iMaxIDAT ? pData->iMaxIDAT : MNG_MAX_IDAT_SIZE);
+  mng_uint32  iLen;
+  mng_retcode iRetcode;
+
+  while (iZlen)
+  {
+    iLen     = (iZlen > iMax ? iMax : iZlen);
+    iRetcode = mng_putchunk_idat ((mng_handle)pData, iLen, pZdata);
+
+    if (iRetcode)
+      return iRetcode;
+
+    pZdata += iLen;
+    iZlen  -= iLen;
+  }
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode put_fram (mng_datap  pData,
+                                mng_uint8  iMode,
+                                mng_uint32 iDelay)
+{
+  mng_uint8   iChangedelay = MNG_CHANGEDELAY_NO;
+  mng_retcode iRetcode;
+
+  if (!pData->bEncdefault)             /* (re)establish the default delay */
+  {
+    iChangedelay       = MNG_CHANGEDELAY_DEFAULT;
+    pData->iEncdelay   = iDelay;
+    pData->bEncdefault = MNG_TRUE;
+  }
+  else
+  if (iDelay != pData->iEncdelay)
+    iChangedelay = MNG_CHANGEDELAY_NEXTSUBFRAME;
+
+  if (iMode == pData->iEncmode)        /* only mention what changes */
+    iMode = MNG_FRAMINGMODE_NOCHANGE;
+  else
+    pData->iEncmode = iMode;
+
+  iRetcode = mng_putchunk_fram ((mng_handle)pData,
+                                (mng_bool)((!iMode) && (!iChangedelay)),
+                                iMode, 0, MNG_NULL, iChangedelay, 0, 0, 0,
+                                iDelay, 0, 0, 0, 0, 0, 0, 0, MNG_NULL);
+
+  if (!iRetcode)                       /* remember it for identical frames */
+    pData->pEncfram = pData->pLastchunk;
+
+  return iRetcode;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode put_clip (mng_datap  pData,
+                                mng_uint32 iX,
+                                mng_uint32 iY,
+                                mng_uint32 iWidth,
+                                mng_uint32 iHeight,
+                                mng_bool   bClipped)
+{
+  mng_retcode iRetcode;
+
+  if ((pData->bEncclipped == bClipped) &&
+      ((!bClipped) ||
+       ((pData->iEncclipl == (mng_int32)iX          ) &&
+        (pData->iEncclipr == (mng_int32)(iX + iWidth)) &&
+        (pData->iEncclipt == (mng_int32)iY          ) &&
+        (pData->iEncclipb == (mng_int32)(iY + iHeight))   )))
+    return MNG_NOERROR;                /* it's already like that */
+
+  pData->bEncclipped = bClipped;
+  pData->iEncclipl   = (mng_int32)iX;
+  pData->iEncclipr   = (mng_int32)(iX + iWidth);
+  pData->iEncclipt   = (mng_int32)iY;
+  pData->iEncclipb   = (mng_int32)(iY + iHeight);
+
+  iRetcode = mng_putchunk_clip ((mng_handle)pData,
+                                MNG_ENC_OBJECTID, MNG_ENC_OBJECTID,
+                                MNG_CLIPPING_ABSOLUTE,
+                                pData->iEncclipl, pData->iEncclipr,
+                                pData->iEncclipt, pData->iEncclipb);
+  return iRetcode;
+}
+
+/* ************************************************************************** */
+
+mng_retcode MNG_DECL mng_putframe (mng_handle        hHandle,
+                                   mng_uint32        iDelay,
+                                   mng_uint32        iCanvasstyle,
+                                   mng_getcanvasline fGetcanvasline)
+{
+  mng_datap   pData;
+  mng_mhdrp   pMHDR;
+  mng_uint32  iWidth, iHeight, iRowsize;
+  mng_uint32  iX = 0, iY = 0;
+  mng_uint32  iBlockwidth, iBlockheight;
+  mng_uint32  iRow;
+  mng_uint8p  pLine;
+  mng_uint8p  pSwap;
+  mng_bool    bOpaque, bBlockopaque;
+  mng_uint8   iEncoding   = MNG_ENC_FULL;
+  mng_uint8   iColortype;
+  mng_uint8   iDeltatype  = MNG_DELTATYPE_BLOCKPIXELREPLACE;
+  mng_uint32  iChannels;
+  mng_uint8p  pZfull = MNG_NULL, pZadd = MNG_NULL, pZrepl = MNG_NULL;
+  mng_uint32  iZfullsize = 0, iZaddsize = 0, iZreplsize = 0;
+  mng_uint32  iZfull = 0, iZadd = 0, iZrepl = 0;
+  mng_uint8p  pZdata;
+  mng_uint32  iZlen;
+  mng_retcode iRetcode = MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTFRAME, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)            /* check validity handle */
+  pData = (mng_datap)hHandle;          /* and make it addressable */
+
+  if (!pData->bCreating)               /* aren't we creating a new file ? */
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID)
+                                       /* must have had the MHDR first! */
+  if (pData->iFirstchunkadded == 0)
+    MNG_ERROR (pData, MNG_NOHEADER)
+
+  if (pData->iFirstchunkadded != MNG_UINT_MHDR)
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID)
+
+  if (pData->bDeflating)               /* can't do two at once */
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID)
+
+  if (!fGetcanvasline)                 /* where do we get the rows from ? */
+    MNG_ERROR (pData, MNG_NOCALLBACK)
+
+  if (iCanvasstyle != MNG_CANVAS_RGBA8)
+    MNG_ERROR (pData, MNG_INVALIDCNVSTYLE)
+
+  pMHDR   = (mng_mhdrp)pData->pFirstchunk;
+  iWidth  = pMHDR->iWidth;
+  iHeight = pMHDR->iHeight;
+
+  if (iWidth == 0)
+    MNG_ERROR (pData, MNG_INVALIDWIDTH)
+  if (iHeight == 0)
+    MNG_ERROR (pData, MNG_INVALIDHEIGHT)
+                                       /* two of these must fit in memory */
+  if ((iWidth > 0x3FFFFFFF) || (iHeight > 0x3FFFFFFF / iWidth))
+    MNG_ERROR (pData, MNG_IMAGETOOLARGE)
+
+  iRowsize = iWidth * 4;
+
+  if (!pData->pEncframe)               /* first frame ? */
+  {
+    pData->iEncframesize = iRowsize * iHeight;
+
+    MNG_ALLOC (pData, pData->pEncframe, pData->iEncframesize);
+    MNG_ALLOC (pData, pData->pEncnext,  pData->iEncframesize);
+  }
+                                       /* get the new frame */
+  for (iRow = 0; iRow < iHeight; iRow++)
+  {
+    pLine = (mng_uint8p)fGetcanvasline (hHandle, iRow);
+
+    if (!pLine)
+      MNG_ERROR (pData, MNG_APPMISCERROR)
+
+    MNG_COPY (pData->pEncnext + iRow * iRowsize, pLine, iRowsize);
+  }
+
+  iBlockwidth  = iWidth;
+  iBlockheight = iHeight;
+
+  if (pData->iEncframes)               /* anything changed ? */
+  {
+    if (!changed_block (pData->pEncnext, pData->pEncframe, iRowsize,
+                        iWidth, iHeight, &iX, &iY, &iBlockwidth, &iBlockheight))
+    {                                  /* no; just keep the last one up longer */
+      mng_framp pFRAM = (mng_framp)pData->pEncfram;
+
+      if (pFRAM->iChangedelay == MNG_CHANGEDELAY_NO)
+      {
+        pFRAM->bEmpty       = MNG_FALSE;
+        pFRAM->iDelay       = pData->iEncdelay;
+      }
+      else                             /* the next one must set the default */
+      if (pFRAM->iChangedelay == MNG_CHANGEDELAY_DEFAULT)
+        pData->bEncdefault  = MNG_FALSE;
+
+      pFRAM->iChangedelay = MNG_CHANGEDELAY_NEXTSUBFRAME;
+
+      pFRAM->iDelay += iDelay;
+      pData->iEncframes++;
+
+#ifdef MNG_SUPPORT_TRACE
+      MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTFRAME, MNG_LC_END);
+#endif
+
+      return MNG_NOERROR;
+    }
+  }
+
+  bOpaque      = block_opaque (pData->pEncnext, iRowsize, 0, 0, iWidth, iHeight);
+  bBlockopaque = bOpaque;
+
+  if (pData->iEncframes)
+  {
+    if (!bOpaque)
+      bBlockopaque = block_opaque (pData->pEncnext, iRowsize,
+                                   iX, iY, iBlockwidth, iBlockheight);
+                                       /* an RGB object can't take alpha */
+    if ((pData->iEnccolortype == MNG_COLORTYPE_RGBA) || (bBlockopaque))
+    {
+      if ((pData->iEnccolortype == MNG_COLORTYPE_RGBA) &&
+          (!block_samealpha (pData->pEncnext, pData->pEncframe, iRowsize,
+                             iX, iY, iBlockwidth, iBlockheight)))
+        iChannels = 4;                 /* pixel or just color deltas ? */
+      else
+        iChannels = 3;
+
+      iRetcode = encode_block (pData, pData->pEncnext, pData->pEncframe, iRowsize,
+                               iX, iY, iBlockwidth, iBlockheight, iChannels,
+                               &pZadd, &iZaddsize, &iZadd);
+
+      if (!iRetcode)
+        iRetcode = encode_block (pData, pData->pEncnext, MNG_NULL, iRowsize,
+                                 iX, iY, iBlockwidth, iBlockheight, iChannels,
+                                 &pZrepl, &iZreplsize, &iZrepl);
+
+      if (!iRetcode)
+      {
+        if (iZadd < iZrepl)
+          iEncoding = MNG_ENC_ADD;
+        else
+          iEncoding = MNG_ENC_REPLACE;
+
+        if (iChannels == 3)
+          iDeltatype = (mng_uint8)(iEncoding == MNG_ENC_ADD ?
+                                   MNG_DELTATYPE_BLOCKCOLORADD :
+                                   MNG_DELTATYPE_BLOCKCOLORREPLACE);
+        else
+          iDeltatype = (mng_uint8)(iEncoding == MNG_ENC_ADD ?
+                                   MNG_DELTATYPE_BLOCKPIXELADD :
+                                   MNG_DELTATYPE_BLOCKPIXELREPLACE);
+                                       /* for an RGB object these are the same */
+        if (pData->iEnccolortype == MNG_COLORTYPE_RGB)
+          iDeltatype = (mng_uint8)(iEncoding == MNG_ENC_ADD ?
+                                   MNG_DELTATYPE_BLOCKPIXELADD :
+                                   MNG_DELTATYPE_BLOCKPIXELREPLACE);
+      }
+                                       /* a large block might do better as a
+                                          whole new image; unless it is one */
+      if ((!iRetcode) && (iBlockwidth * iBlockheight * 2 >= iWidth * iHeight) &&
+          ((iBlockwidth != iWidth) || (iBlockheight != iHeight) ||
+           (iChannels != (mng_uint32)(bOpaque ? 3 : 4))))
+      {
+        iRetcode = encode_block (pData, pData->pEncnext, MNG_NULL, iRowsize,
+                                 0, 0, iWidth, iHeight, (bOpaque ? 3 : 4),
+                                 &pZfull, &iZfullsize, &iZfull);
+                                       /* DEFI+IHDR vs DHDR overhead */
+        if ((!iRetcode) && (iZfull + 26 < iZadd) && (iZfull + 26 < iZrepl))
+          iEncoding = MNG_ENC_FULL;
+      }
+    }
+  }
+
+  if ((!iRetcode) && (iEncoding == MNG_ENC_FULL) && (!pZfull))
+    iRetcode = encode_block (pData, pData->pEncnext, MNG_NULL, iRowsize,
+                             0, 0, iWidth, iHeight, (bOpaque ? 3 : 4),
+                             &pZfull, &iZfullsize, &iZfull);
+
+  if (!iRetcode)
+  {
+    if (iEncoding == MNG_ENC_FULL)
+    {                                  /* a whole new object 1 */
+      iColortype = (mng_uint8)(bOpaque ? MNG_COLORTYPE_RGB : MNG_COLORTYPE_RGBA);
+
+      iRetcode = put_fram (pData, (mng_uint8)(bOpaque ? MNG_FRAMINGMODE_1 :
+                                                        MNG_FRAMINGMODE_4), iDelay);
+
+      if (!iRetcode)
+        iRetcode = mng_putchunk_defi (hHandle, MNG_ENC_OBJECTID,
+                                      MNG_DONOTSHOW_VISIBLE, MNG_CONCRETE,
+                                      pData->bEncclipped, 0, 0,
+                                      pData->bEncclipped, 0, (mng_int32)iWidth,
+                                      0, (mng_int32)iHeight);
+      if (!iRetcode)
+        iRetcode = mng_putchunk_ihdr (hHandle, iWidth, iHeight, 8, iColortype,
+                                      MNG_COMPRESSION_DEFLATE, MNG_FILTER_ADAPTIVE,
+                                      MNG_INTERLACE_NONE);
+
+      pData->iEnccolortype = iColortype;
+      pData->bEncclipped   = MNG_FALSE;
+      pZdata               = pZfull;
+      iZlen                = iZfull;
+    }
+    else
+    {                                  /* opaque changes are just redrawn;
+                                          translucent ones need a background */
+      if (bBlockopaque)
+      {
+        iRetcode = put_fram (pData, MNG_FRAMINGMODE_1, iDelay);
+
+        if (!iRetcode)
+          iRetcode = put_clip (pData, iX, iY, iBlockwidth, iBlockheight, MNG_TRUE);
+      }
+      else
+      {
+        iRetcode = put_fram (pData, MNG_FRAMINGMODE_4, iDelay);
+
+        if (!iRetcode)
+          iRetcode = put_clip (pData, 0, 0, iWidth, iHeight, MNG_FALSE);
+      }
+
+      if (!iRetcode)
+        iRetcode = mng_putchunk_dhdr (hHandle, MNG_ENC_OBJECTID, MNG_IMAGETYPE_PNG,
+                                      iDeltatype, iBlockwidth, iBlockheight, iX, iY);
+
+      if (iEncoding == MNG_ENC_ADD)
+      {
+        pZdata = pZadd;
+        iZlen  = iZadd;
+      }
+      else
+      {
+        pZdata = pZrepl;
+        iZlen  = iZrepl;
+      }
+    }
+
+    if (!iRetcode)
+      iRetcode = put_idats (pData, pZdata, iZlen);
+
+    if (!iRetcode)
+      iRetcode = mng_putchunk_iend (hHandle);
+  }
+
+  MNG_FREEX (pData, pZrepl, iZreplsize);
+  MNG_FREEX (pData, pZadd,  iZaddsize);
+  MNG_FREEX (pData, pZfull, iZfullsize);
+
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+
+  pSwap            = pData->pEncframe; /* this one's the reference now */
+  pData->pEncframe = pData->pEncnext;
+  pData->pEncnext  = pSwap;
+
+  pData->iEncframes++;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_PUTFRAME, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+#endif /* MNG_SUPPORT_ENCODER */
+
+/* ************************************************************************** */
+/* * end of file                                                            * */
+/* ************************************************************************** */
@@ -0,0 +1,38 @@
+/* ************************************************************************** */
+/* *             For conditions of distribution and use,                    * */
+/* *                see copyright notice in libmng.h                        * */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * project   : libmng                                                     * */
+/* * file      : libmng_encode.h           copyright (c) 2026               * */
+/* * version   : 1.0.11                                                     * */
+/* *                                                                        * */
+/* * purpose   : Frame-sequence encoder (definition)                        * */
+/* *                                                                        * */
+/* * comment   : Definition of the frame-sequence encoder functions         * */
+/* *                                                                        * */
+/* * changes   : 1.0.11 - 10/17/2026                                        * */
+/* *             - initial version                                          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
+#pragma option -A                      /* force ANSI-C */
+#endif
+
+#ifndef _libmng_encode_h_
+#define _libmng_encode_h_
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_ENCODER
+void mng_drop_encoder (mng_datap pData);
+#endif
+
+/* ************************************************************************** */
+
+#endif /* _libmng_encode_h_ */
+
+/* ************************************************************************** */
+/* * end of file                                                            * */
+/* ************************************************************************** */
@@ -35,6 +35,14 @@
 /* *             1.0.9 - 12/20/2004 - G.Juyn                                * */
 /* *             - cleaned up macro-invocations (thanks to D. Airlie)       * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added filter-selection for the putimgdata encoder        * */
+/* *             - added SSE2/NEON unfilter routines for 3/4/6/8-byte       * */
+/* *               pixels                                                   * */
+/* *             - added handle-free mng_unfilter_row for the decode        * */
+/* *               workers                                                  * */
+/* *             - unfilter_paeth & encode_row share paeth_predictor        * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -46,97 +54,104 @@
 #endif
 #include "libmng_filter.h"
 
+#ifdef MNG_INCLUDE_SIMD_X86
+#include <emmintrin.h>
+#endif
+#ifdef MNG_INCLUDE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
 #pragma option -A                      /* force ANSI-C */
 #endif
 
 /* ************************************************************************** */
 
-#ifdef MNG_INCLUDE_FILTERS
+#if defined(MNG_INCLUDE_FILTERS) || defined(MNG_INCLUDE_WRITE_PROCS)
 
 /* ************************************************************************** */
 
-MNG_LOCAL mng_retcode filter_sub (mng_datap pData)
+/* the PNG paeth predictor: whichever of left, above & upper-left is closest
+   to left + above - upper-left (ties in that order); the decoder and the
+   encoder's filter-selection must agree on it to the bit */
+MNG_LOCAL mng_uint32 paeth_predictor (mng_uint32 iA,
+                                      mng_uint32 iB,
+                                      mng_uint32 iC)
 {
-  mng_uint32 iBpp;
-  mng_uint8p pRawx;
-  mng_uint8p pRawx_prev;
-  mng_int32  iX;
+  mng_int32 iP  = (mng_int32)(iA + iB - iC);
+  mng_int32 iPa = abs (iP - (mng_int32)iA);
+  mng_int32 iPb = abs (iP - (mng_int32)iB);
+  mng_int32 iPc = abs (iP - (mng_int32)iC);
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_FILTER_SUB, MNG_LC_START);
-#endif
+  if ((iPa <= iPb) && (iPa <= iPc))
+    return iA;
+  else
+  if (iPb <= iPc)
+    return iB;
+  else
+    return iC;
+}
+
+/* ************************************************************************** */
+
+#endif /* MNG_INCLUDE_FILTERS || MNG_INCLUDE_WRITE_PROCS */
+
+/* ************************************************************************** */
+
+#ifdef MNG_INCLUDE_FILTERS
+
+/* ************************************************************************** */
 
-  iBpp       = pData->iFilterbpp;
-  pRawx      = pData->pWorkrow + pData->iPixelofs + iBpp;
-  pRawx_prev = pData->pWorkrow + pData->iPixelofs;
+MNG_LOCAL void unfilter_sub (mng_uint8p pRaw,
+                             mng_int32  iRowsize,
+                             mng_int32  iBpp)
+{
+  mng_uint8p pRawx      = pRaw + iBpp;
+  mng_uint8p pRawx_prev = pRaw;
+  mng_int32  iX;
 
-  for (iX = iBpp; iX < pData->iRowsize; iX++)
+  for (iX = iBpp; iX < iRowsize; iX++)
   {
     *pRawx = (mng_uint8)(*pRawx + *pRawx_prev);
     pRawx++;
     pRawx_prev++;
   }
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_FILTER_SUB, MNG_LC_END);
-#endif
-
-  return MNG_NOERROR;
 }
 
 /* ************************************************************************** */
 
-MNG_LOCAL mng_retcode filter_up (mng_datap pData)
+MNG_LOCAL void unfilter_up (mng_uint8p pRaw,
+                            mng_uint8p pPrior,
+                            mng_int32  iRowsize)
 {
-  mng_uint8p pRawx;
-  mng_uint8p pPriorx;
+  mng_uint8p pRawx   = pRaw;
+  mng_uint8p pPriorx = pPrior;
   mng_int32  iX;
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_FILTER_UP, MNG_LC_START);
-#endif
-
-  pRawx   = pData->pWorkrow + pData->iPixelofs;
-  pPriorx = pData->pPrevrow + pData->iPixelofs;
-
 #ifdef MNG_DECREMENT_LOOPS
-  for (iX = pData->iRowsize - 1; iX >= 0; iX--)
+  for (iX = iRowsize - 1; iX >= 0; iX--)
 #else
-  for (iX = 0; iX < pData->iRowsize; iX++)
+  for (iX = 0; iX < iRowsize; iX++)
 #endif
   {
     *pRawx = (mng_uint8)(*pRawx + *pPriorx);
     pRawx++;
     pPriorx++;
   }
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_FILTER_UP, MNG_LC_END);
-#endif
-
-  return MNG_NOERROR;
 }
 
 /* ************************************************************************** */
 
-MNG_LOCAL mng_retcode filter_average (mng_datap pData)
+MNG_LOCAL void unfilter_average (mng_uint8p pRaw,
+                                 mng_uint8p pPrior,
+                                 mng_int32  iRowsize,
+                                 mng_int32  iBpp)
 {
-  mng_int32  iBpp;
-  mng_uint8p pRawx;
-  mng_uint8p pRawx_prev;
-  mng_uint8p pPriorx;
+  mng_uint8p pRawx      = pRaw;
+  mng_uint8p pRawx_prev = pRaw;
+  mng_uint8p pPriorx    = pPrior;
   mng_int32  iX;
 
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_FILTER_AVERAGE, MNG_LC_START);
-#endif
-
-  iBpp       = pData->iFilterbpp;
-  pRawx      = pData->pWorkrow + pData->iPixelofs;
-  pPriorx    = pData->pPrevrow + pData->iPixelofs;
-  pRawx_prev = pData->pWorkrow + pData->iPixelofs;
-
 #ifdef MNG_DECREMENT_LOOPS
   for (iX = iBpp - 1; iX >= 0; iX--)
 #else
@@ -148,44 +163,27 @@ MNG_LOCAL mng_retcode filter_average (mng_datap pData)
     pPriorx++;
   }
 
-  for (iX = iBpp; iX < pData->iRowsize; iX++)
+  for (iX = iBpp; iX < iRowsize; iX++)
   {
     *pRawx = (mng_uint8)(*pRawx + ((*pRawx_prev + *pPriorx) >> 1));
     pRawx++;
     pPriorx++;
     pRawx_prev++;
   }
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_FILTER_AVERAGE, MNG_LC_END);
-#endif
-
-  return MNG_NOERROR;
 }
 
 /* ************************************************************************** */
 
-MNG_LOCAL mng_retcode filter_paeth (mng_datap pData)
+MNG_LOCAL void unfilter_paeth (mng_uint8p pRaw,
+                               mng_uint8p pPrior,
+                               mng_int32  iRowsize,
+                               mng_int32  iBpp)
 {
-  mng_int32  iBpp;
-  mng_uint8p pRawx;
-  mng_uint8p pRawx_prev;
-  mng_uint8p pPriorx;
-  mng_uint8p pPriorx_prev;
+  mng_uint8p pRawx        = pRaw;
+  mng_uint8p pRawx_prev   = pRaw;
+  mng_uint8p pPriorx      = pPrior;
+  mng_uint8p pPriorx_prev = pPrior;
   mng_int32  iX;
-  mng_uint32 iA, iB, iC;
-  mng_uint32 iP;
-  mng_uint32 iPa, iPb, iPc;
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_FILTER_PAETH, MNG_LC_START);
-#endif
-
-  iBpp         = pData->iFilterbpp;
-  pRawx        = pData->pWorkrow + pData->iPixelofs;
-  pPriorx      = pData->pPrevrow + pData->iPixelofs;
-  pRawx_prev   = pData->pWorkrow + pData->iPixelofs;
-  pPriorx_prev = pData->pPrevrow + pData->iPixelofs;
 
 #ifdef MNG_DECREMENT_LOOPS
   for (iX = iBpp - 1; iX >= 0; iX--)
@@ -199,29 +197,83 @@ MNG_LOCAL mng_retcode filter_paeth (mng_datap pData)
     pPriorx++;
   }
 
-  for (iX = iBpp; iX < pData->iRowsize; iX++)
+  for (iX = iBpp; iX < iRowsize; iX++)
   {
-    iA  = (mng_uint32)*pRawx_prev;
-    iB  = (mng_uint32)*pPriorx;
-    iC  = (mng_uint32)*pPriorx_prev;
-    iP  = iA + iB - iC;
-    iPa = abs (iP - iA);
-    iPb = abs (iP - iB);
-    iPc = abs (iP - iC);
-
-    if ((iPa <= iPb) && (iPa <= iPc))
-      *pRawx = (mng_uint8)(*pRawx + iA);
-    else
-      if (iPb <= iPc)
-        *pRawx = (mng_uint8)(*pRawx + iB);
-      else
-        *pRawx = (mng_uint8)(*pRawx + iC);
-
+    *pRawx = (mng_uint8)(*pRawx + paeth_predictor (*pRawx_prev, *pPriorx,
+                                                   *pPriorx_prev));
     pRawx++;
     pPriorx++;
     pRawx_prev++;
     pPriorx_prev++;
   }
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode filter_sub (mng_datap pData)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_FILTER_SUB, MNG_LC_START);
+#endif
+
+  unfilter_sub (pData->pWorkrow + pData->iPixelofs,
+                pData->iRowsize, pData->iFilterbpp);
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_FILTER_SUB, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode filter_up (mng_datap pData)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_FILTER_UP, MNG_LC_START);
+#endif
+
+  unfilter_up (pData->pWorkrow + pData->iPixelofs,
+               pData->pPrevrow + pData->iPixelofs, pData->iRowsize);
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_FILTER_UP, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode filter_average (mng_datap pData)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_FILTER_AVERAGE, MNG_LC_START);
+#endif
+
+  unfilter_average (pData->pWorkrow + pData->iPixelofs,
+                    pData->pPrevrow + pData->iPixelofs,
+                    pData->iRowsize, pData->iFilterbpp);
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_FILTER_AVERAGE, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_retcode filter_paeth (mng_datap pData)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_FILTER_PAETH, MNG_LC_START);
+#endif
+
+  unfilter_paeth (pData->pWorkrow + pData->iPixelofs,
+                  pData->pPrevrow + pData->iPixelofs,
+                  pData->iRowsize, pData->iFilterbpp);
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FILTER_PAETH, MNG_LC_END);
@@ -232,6 +284,358 @@ MNG_LOCAL mng_retcode filter_paeth (mng_datap pData)
 
 /* ************************************************************************** */
 
+#ifdef MNG_SUPPORT_SIMD
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Vectorized unfilter routines - up handles 16 bytes at a time for any   * */
+/* * pixel-size; sub, average & paeth depend on the pixel to the left, so   * */
+/* * they do one whole pixel (3, 4, 6 or 8 bytes) per step; other sizes     * */
+/* * are left to the portable routines above                                * */
+/* *                                                                        * */
+/* * the kernels take the pixel-size as a constant so the compiler can      * */
+/* * specialize the partial loads & stores                                  * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#define MNG_SIMD_BYBPP(FN) \
+  switch (iBpp) \
+  { \
+    case 3 : { FN (pRaw, pPrior, iRowsize, 3); return MNG_TRUE; } \
+    case 4 : { FN (pRaw, pPrior, iRowsize, 4); return MNG_TRUE; } \
+    case 6 : { FN (pRaw, pPrior, iRowsize, 6); return MNG_TRUE; } \
+    case 8 : { FN (pRaw, pPrior, iRowsize, 8); return MNG_TRUE; } \
+  }
+
+#ifdef MNG_INCLUDE_SIMD_X86
+
+#define MNG_SSE2_INLINE __inline__ __attribute__ ((always_inline, target ("sse2")))
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_SSE2_INLINE __m128i sse2_loadpixel (mng_uint8p pSrc,
+                                                  mng_int32  iBpp)
+{
+  mng_uint32 iLo;
+  mng_uint32 iHi = 0;
+                                       /* odd sizes are assembled by hand;
+                                          a short memcpy goes via the stack */
+  if (iBpp == 3)
+    iLo = (mng_uint32)*pSrc | ((mng_uint32)*(pSrc+1) << 8) | ((mng_uint32)*(pSrc+2) << 16);
+  else
+    memcpy (&iLo, pSrc, 4);
+
+  if (iBpp == 6)
+    iHi = (mng_uint32)*(pSrc+4) | ((mng_uint32)*(pSrc+5) << 8);
+  else
+  if (iBpp == 8)
+    memcpy (&iHi, pSrc + 4, 4);
+
+  return _mm_set_epi32 (0, 0, (int)iHi, (int)iLo);
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_SSE2_INLINE void sse2_storepixel (mng_uint8p pDst,
+                                                __m128i    vPixel,
+                                                mng_int32  iBpp)
+{
+  mng_uint32 iLo = (mng_uint32)_mm_cvtsi128_si32 (vPixel);
+  mng_uint32 iHi = (mng_uint32)_mm_cvtsi128_si32 (_mm_srli_si128 (vPixel, 4));
+
+  if (iBpp == 3)
+  {
+    *pDst     = (mng_uint8)iLo;
+    *(pDst+1) = (mng_uint8)(iLo >> 8);
+    *(pDst+2) = (mng_uint8)(iLo >> 16);
+  }
+  else
+    memcpy (pDst, &iLo, 4);
+
+  if (iBpp == 6)
+  {
+    *(pDst+4) = (mng_uint8)iHi;
+    *(pDst+5) = (mng_uint8)(iHi >> 8);
+  }
+  else
+  if (iBpp == 8)
+    memcpy (pDst + 4, &iHi, 4);
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_SSE2_INLINE void sse2_sub (mng_uint8p pRaw,
+                                         mng_uint8p pPrior,
+                                         mng_int32  iRowsize,
+                                         mng_int32  iBpp)
+{
+  __m128i   vA = _mm_setzero_si128 ();
+  mng_int32 iX;
+
+  for (iX = 0; iX + iBpp <= iRowsize; iX += iBpp)
+  {
+    vA = _mm_add_epi8 (vA, sse2_loadpixel (pRaw + iX, iBpp));
+    sse2_storepixel (pRaw + iX, vA, iBpp);
+  }
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_SSE2_INLINE void sse2_average (mng_uint8p pRaw,
+                                             mng_uint8p pPrior,
+                                             mng_int32  iRowsize,
+                                             mng_int32  iBpp)
+{
+  __m128i   vOne = _mm_set1_epi8 (1);
+  __m128i   vA   = _mm_setzero_si128 ();
+  __m128i   vB, vAvg;
+  mng_int32 iX;
+
+  for (iX = 0; iX + iBpp <= iRowsize; iX += iBpp)
+  {
+    vB   = sse2_loadpixel (pPrior + iX, iBpp);
+                                       /* pavgb rounds up; PNG rounds down */
+    vAvg = _mm_sub_epi8 (_mm_avg_epu8 (vA, vB),
+                         _mm_and_si128 (_mm_xor_si128 (vA, vB), vOne));
+    vA   = _mm_add_epi8 (sse2_loadpixel (pRaw + iX, iBpp), vAvg);
+
+    sse2_storepixel (pRaw + iX, vA, iBpp);
+  }
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_SSE2_INLINE void sse2_paeth (mng_uint8p pRaw,
+                                           mng_uint8p pPrior,
+                                           mng_int32  iRowsize,
+                                           mng_int32  iBpp)
+{
+  __m128i   vZero = _mm_setzero_si128 ();
+  __m128i   vA    = vZero;             /* left, above & upper-left as 16-bit */
+  __m128i   vC    = vZero;
+  __m128i   vB, vPa, vPb, vPc, vMin, vSel, vNear;
+  mng_int32 iX;
+
+  for (iX = 0; iX + iBpp <= iRowsize; iX += iBpp)
+  {
+    vB  = _mm_unpacklo_epi8 (sse2_loadpixel (pPrior + iX, iBpp), vZero);
+                                       /* |p-a| = |b-c|, |p-b| = |a-c| and
+                                          |p-c| = |a+b-2c| */
+    vPa = _mm_sub_epi16 (vB, vC);
+    vPb = _mm_sub_epi16 (vA, vC);
+    vPc = _mm_add_epi16 (vPa, vPb);
+
+    vPa = _mm_max_epi16 (vPa, _mm_sub_epi16 (vZero, vPa));
+    vPb = _mm_max_epi16 (vPb, _mm_sub_epi16 (vZero, vPb));
+    vPc = _mm_max_epi16 (vPc, _mm_sub_epi16 (vZero, vPc));
+                                       /* ties favor a over b over c */
+    vMin  = _mm_min_epi16 (_mm_min_epi16 (vPa, vPb), vPc);
+
+    vSel  = _mm_cmpeq_epi16 (vMin, vPb);
+    vNear = _mm_or_si128 (_mm_and_si128 (vSel, vB), _mm_andnot_si128 (vSel, vC));
+    vSel  = _mm_cmpeq_epi16 (vMin, vPa);
+    vNear = _mm_or_si128 (_mm_and_si128 (vSel, vA), _mm_andnot_si128 (vSel, vNear));
+
+    vA = _mm_add_epi8 (sse2_loadpixel (pRaw + iX, iBpp), _mm_packus_epi16 (vNear, vNear));
+
+    sse2_storepixel (pRaw + iX, vA, iBpp);
+
+    vA = _mm_unpacklo_epi8 (vA, vZero);
+    vC = vB;
+  }
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL __attribute__ ((target ("sse2")))
+mng_bool sse2_filter_row (mng_uint8  iFilter,
+                          mng_uint8p pRaw,
+                          mng_uint8p pPrior,
+                          mng_int32  iRowsize,
+                          mng_int32  iBpp)
+{
+  mng_int32 iX;
+
+  switch (iFilter)
+  {
+    case 1 : { MNG_SIMD_BYBPP (sse2_sub);     break; }
+    case 2 : {                         /* up doesn't care about pixels */
+               for (iX = 0; iX + 16 <= iRowsize; iX += 16)
+                 _mm_storeu_si128 ((__m128i *)(pRaw + iX),
+                                   _mm_add_epi8 (_mm_loadu_si128 ((__m128i *)(pRaw   + iX)),
+                                                 _mm_loadu_si128 ((__m128i *)(pPrior + iX))));
+
+               for (; iX < iRowsize; iX++)
+                 *(pRaw + iX) = (mng_uint8)(*(pRaw + iX) + *(pPrior + iX));
+
+               return MNG_TRUE;
+             }
+    case 3 : { MNG_SIMD_BYBPP (sse2_average); break; }
+    case 4 : { MNG_SIMD_BYBPP (sse2_paeth);   break; }
+  }
+
+  return MNG_FALSE;
+}
+
+#endif /* MNG_INCLUDE_SIMD_X86 */
+
+/* ************************************************************************** */
+
+#ifdef MNG_INCLUDE_SIMD_NEON
+
+#define MNG_NEON_INLINE __inline__ __attribute__ ((always_inline))
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_NEON_INLINE uint8x8_t neon_loadpixel (mng_uint8p pSrc,
+                                                    mng_int32  iBpp)
+{
+  uint64_t  iBits = 0;
+  mng_int32 iX;
+                                       /* a short memcpy goes via the stack */
+  for (iX = 0; iX < iBpp; iX++)
+    iBits |= (uint64_t)*(pSrc+iX) << (iX << 3);
+
+  return vcreate_u8 (iBits);
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_NEON_INLINE void neon_storepixel (mng_uint8p pDst,
+                                                uint8x8_t  vPixel,
+                                                mng_int32  iBpp)
+{
+  uint64_t  iBits = vget_lane_u64 (vreinterpret_u64_u8 (vPixel), 0);
+  mng_int32 iX;
+
+  for (iX = 0; iX < iBpp; iX++)
+    *(pDst+iX) = (mng_uint8)(iBits >> (iX << 3));
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_NEON_INLINE void neon_sub (mng_uint8p pRaw,
+                                         mng_uint8p pPrior,
+                                         mng_int32  iRowsize,
+                                         mng_int32  iBpp)
+{
+  uint8x8_t vA = vdup_n_u8 (0);
+  mng_int32 iX;
+
+  for (iX = 0; iX + iBpp <= iRowsize; iX += iBpp)
+  {
+    vA = vadd_u8 (vA, neon_loadpixel (pRaw + iX, iBpp));
+    neon_storepixel (pRaw + iX, vA, iBpp);
+  }
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_NEON_INLINE void neon_average (mng_uint8p pRaw,
+                                             mng_uint8p pPrior,
+                                             mng_int32  iRowsize,
+                                             mng_int32  iBpp)
+{
+  uint8x8_t vA = vdup_n_u8 (0);
+  mng_int32 iX;
+
+  for (iX = 0; iX + iBpp <= iRowsize; iX += iBpp)
+  {                                    /* halving-add rounds down like PNG */
+    vA = vadd_u8 (neon_loadpixel (pRaw + iX, iBpp),
+                  vhadd_u8 (vA, neon_loadpixel (pPrior + iX, iBpp)));
+    neon_storepixel (pRaw + iX, vA, iBpp);
+  }
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL MNG_NEON_INLINE void neon_paeth (mng_uint8p pRaw,
+                                           mng_uint8p pPrior,
+                                           mng_int32  iRowsize,
+                                           mng_int32  iBpp)
+{
+  uint16x8_t vA = vdupq_n_u16 (0);     /* left, above & upper-left as 16-bit */
+  uint16x8_t vC = vdupq_n_u16 (0);
+  uint16x8_t vB, vPa, vPb, vPc, vMin, vNear;
+  uint8x8_t  vX;
+  mng_int32  iX;
+
+  for (iX = 0; iX + iBpp <= iRowsize; iX += iBpp)
+  {
+    vB   = vmovl_u8 (neon_loadpixel (pPrior + iX, iBpp));
+                                       /* |p-a| = |b-c|, |p-b| = |a-c| and
+                                          |p-c| = |a+b-2c| */
+    vPa  = vabdq_u16 (vB, vC);
+    vPb  = vabdq_u16 (vA, vC);
+    vPc  = vabdq_u16 (vaddq_u16 (vA, vB), vaddq_u16 (vC, vC));
+                                       /* ties favor a over b over c */
+    vMin  = vminq_u16 (vminq_u16 (vPa, vPb), vPc);
+    vNear = vbslq_u16 (vceqq_u16 (vMin, vPb), vB, vC);
+    vNear = vbslq_u16 (vceqq_u16 (vMin, vPa), vA, vNear);
+
+    vX = vadd_u8 (neon_loadpixel (pRaw + iX, iBpp), vmovn_u16 (vNear));
+    neon_storepixel (pRaw + iX, vX, iBpp);
+
+    vA = vmovl_u8 (vX);
+    vC = vB;
+  }
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool neon_filter_row (mng_uint8  iFilter,
+                                    mng_uint8p pRaw,
+                                    mng_uint8p pPrior,
+                                    mng_int32  iRowsize,
+                                    mng_int32  iBpp)
+{
+  mng_int32 iX;
+
+  switch (iFilter)
+  {
+    case 1 : { MNG_SIMD_BYBPP (neon_sub);     break; }
+    case 2 : {                         /* up doesn't care about pixels */
+               for (iX = 0; iX + 16 <= iRowsize; iX += 16)
+                 vst1q_u8 (pRaw + iX, vaddq_u8 (vld1q_u8 (pRaw + iX), vld1q_u8 (pPrior + iX)));
+
+               for (; iX < iRowsize; iX++)
+                 *(pRaw + iX) = (mng_uint8)(*(pRaw + iX) + *(pPrior + iX));
+
+               return MNG_TRUE;
+             }
+    case 3 : { MNG_SIMD_BYBPP (neon_average); break; }
+    case 4 : { MNG_SIMD_BYBPP (neon_paeth);   break; }
+  }
+
+  return MNG_FALSE;
+}
+
+#endif /* MNG_INCLUDE_SIMD_NEON */
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool simd_filter_row (mng_datap pData)
+{
+  mng_uint8  iFilter  = *(pData->pWorkrow + pData->iFilterofs);
+  mng_uint8p pRaw     = pData->pWorkrow + pData->iPixelofs;
+  mng_uint8p pPrior   = pData->pPrevrow + pData->iPixelofs;
+  mng_int32  iRowsize = pData->iRowsize;
+  mng_int32  iBpp     = pData->iFilterbpp;
+
+#ifdef MNG_INCLUDE_SIMD_X86
+  if (pData->iSIMDflags & MNG_SIMD_SSE2)
+    return sse2_filter_row (iFilter, pRaw, pPrior, iRowsize, iBpp);
+#endif
+#ifdef MNG_INCLUDE_SIMD_NEON
+  if (pData->iSIMDflags & MNG_SIMD_NEON)
+    return neon_filter_row (iFilter, pRaw, pPrior, iRowsize, iBpp);
+#endif
+
+  return MNG_FALSE;
+}
+
+/* ************************************************************************** */
+#endif /* MNG_SUPPORT_SIMD */
+
 mng_retcode mng_filter_a_row (mng_datap pData)
 {
   mng_retcode iRetcode;
@@ -240,6 +644,11 @@ mng_retcode mng_filter_a_row (mng_datap pData)
   MNG_TRACE (pData, MNG_FN_FILTER_A_ROW, MNG_LC_START);
 #endif
 
+#ifdef MNG_SUPPORT_SIMD                /* try the vector-code first */
+  if ((pData->iSIMDflags) && (simd_filter_row (pData)))
+    iRetcode = MNG_NOERROR;
+  else
+#endif
   switch (*(pData->pWorkrow + pData->iFilterofs))
   {
     case 1  : {
@@ -269,6 +678,42 @@ mng_retcode mng_filter_a_row (mng_datap pData)
   return iRetcode;
 }
 
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_PARALLEL
+mng_retcode mng_unfilter_row (mng_uint8  iFilter,
+                              mng_uint8p pRaw,
+                              mng_uint8p pPrior,
+                              mng_int32  iRowsize,
+                              mng_int32  iBpp,
+                              mng_uint32 iSIMDflags)
+{                                      /* no handle, no trace: this one runs
+                                          on the decode-workers */
+#ifdef MNG_INCLUDE_SIMD_X86
+  if ((iSIMDflags & MNG_SIMD_SSE2) &&
+      (sse2_filter_row (iFilter, pRaw, pPrior, iRowsize, iBpp)))
+    return MNG_NOERROR;
+#endif
+#ifdef MNG_INCLUDE_SIMD_NEON
+  if ((iSIMDflags & MNG_SIMD_NEON) &&
+      (neon_filter_row (iFilter, pRaw, pPrior, iRowsize, iBpp)))
+    return MNG_NOERROR;
+#endif
+
+  switch (iFilter)
+  {
+    case 1  : { unfilter_sub     (pRaw, iRowsize, iBpp);         break; }
+    case 2  : { unfilter_up      (pRaw, pPrior, iRowsize);       break; }
+    case 3  : { unfilter_average (pRaw, pPrior, iRowsize, iBpp); break; }
+    case 4  : { unfilter_paeth   (pRaw, pPrior, iRowsize, iBpp); break; }
+
+    default : return MNG_INVALIDFILTER;
+  }
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_SUPPORT_PARALLEL */
+
 /* ************************************************************************** */
 /* ************************************************************************** */
 
@@ -972,6 +1417,153 @@ mng_retcode mng_differ_rgba16 (mng_datap pData)
 
 #endif /* MNG_INCLUDE_FILTERS */
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Encoder filter-selection - each candidate filter is scored by the sum  * */
+/* * of its output bytes taken as signed values, and the one with the       * */
+/* * smallest sum is chosen                                                 * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifdef MNG_INCLUDE_WRITE_PROCS
+
+#define MNG_FILTERSCORE(S,D) { S += ((D) < 128 ? (D) : 256 - (D)); }
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_uint32 encode_row (mng_uint8  iType,
+                                 mng_int32  iBpp,
+                                 mng_int32  iSize,
+                                 mng_uint8p pRaw,
+                                 mng_uint8p pPrior,
+                                 mng_uint8p pOut,
+                                 mng_uint32 iLimit)
+{
+  mng_uint32 iSum = 0;
+  mng_int32  iX;
+  mng_uint32 iA, iC;
+  mng_uint32 iD;
+
+  *pOut++ = iType;                     /* filter-type leads the row */
+                                       /* bail out as soon as the sum gets
+                                          over the limit (can't win anymore) */
+  switch (iType)
+  {
+    case MNG_FILTER_NONE :
+      {
+        for (iX = 0; (iX < iSize) && (iSum < iLimit); iX++)
+        {
+          iD        = pRaw [iX];
+          pOut [iX] = (mng_uint8)iD;
+          MNG_FILTERSCORE (iSum, iD)
+        }
+        break;
+      }
+    case MNG_FILTER_SUB :
+      {
+        for (iX = 0; (iX < iSize) && (iSum < iLimit); iX++)
+        {
+          iA        = (iX >= iBpp ? pRaw [iX - iBpp] : 0);
+          iD        = (mng_uint8)(pRaw [iX] - iA);
+          pOut [iX] = (mng_uint8)iD;
+          MNG_FILTERSCORE (iSum, iD)
+        }
+        break;
+      }
+    case MNG_FILTER_UP :
+      {
+        for (iX = 0; (iX < iSize) && (iSum < iLimit); iX++)
+        {
+          iD        = (mng_uint8)(pRaw [iX] - pPrior [iX]);
+          pOut [iX] = (mng_uint8)iD;
+          MNG_FILTERSCORE (iSum, iD)
+        }
+        break;
+      }
+    case MNG_FILTER_AVERAGE :
+      {
+        for (iX = 0; (iX < iSize) && (iSum < iLimit); iX++)
+        {
+          iA        = (iX >= iBpp ? pRaw [iX - iBpp] : 0);
+          iD        = (mng_uint8)(pRaw [iX] - ((iA + pPrior [iX]) >> 1));
+          pOut [iX] = (mng_uint8)iD;
+          MNG_FILTERSCORE (iSum, iD)
+        }
+        break;
+      }
+    default :
+      {
+        for (iX = 0; (iX < iSize) && (iSum < iLimit); iX++)
+        {
+          iA        = (iX >= iBpp ? pRaw   [iX - iBpp] : 0);
+          iC        = (iX >= iBpp ? pPrior [iX - iBpp] : 0);
+          iD        = (mng_uint8)(pRaw [iX] -
+                                  paeth_predictor (iA, pPrior [iX], iC));
+          pOut [iX] = (mng_uint8)iD;
+          MNG_FILTERSCORE (iSum, iD)
+        }
+      }
+  }
+
+  return iSum;
+}
+
+/* ************************************************************************** */
+
+mng_uint8p mng_select_filter (mng_datap  pData,
+                              mng_uint8  iFiltersel,
+                              mng_int32  iBpp,
+                              mng_int32  iRowsize,
+                              mng_uint8p pRaw,
+                              mng_uint8p pPrior,
+                              mng_uint8p pOut,
+                              mng_uint8p pTemp)
+{
+  mng_uint8p pBest = pOut;
+  mng_uint8p pTry  = pTemp;
+  mng_uint8p pSwap;
+  mng_uint8  iLast;
+  mng_uint8  iType;
+  mng_uint32 iBest;
+  mng_uint32 iSum;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_SELECT_FILTER, MNG_LC_START);
+#endif
+
+  if (iFiltersel == MNG_FILTERSEL_FULL)
+    iLast = MNG_FILTER_PAETH;
+  else
+  if (iFiltersel == MNG_FILTERSEL_FAST)
+    iLast = MNG_FILTER_UP;
+  else
+    iLast = MNG_FILTER_NONE;
+                                       /* "none" is the one to beat */
+  iBest = encode_row (MNG_FILTER_NONE, iBpp, iRowsize, pRaw, pPrior,
+                      pBest, 0xFFFFFFFFL);
+
+  for (iType = MNG_FILTER_SUB; iType <= iLast; iType++)
+  {
+    iSum = encode_row (iType, iBpp, iRowsize, pRaw, pPrior, pTry, iBest);
+
+    if (iSum < iBest)                  /* better ? then keep this one */
+    {
+      iBest = iSum;
+      pSwap = pBest;
+      pBest = pTry;
+      pTry  = pSwap;
+    }
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_SELECT_FILTER, MNG_LC_END);
+#endif
+
+  return pBest;
+}
+
+#endif /* MNG_INCLUDE_WRITE_PROCS */
+
 /* ************************************************************************** */
 /* * end of file                                                            * */
 /* ************************************************************************** */
@@ -25,6 +25,10 @@
 /* *             1.0.5 - 08/19/2002 - G.Juyn                                * */
 /* *             - B597134 - libmng pollutes the linker namespace           * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added filter-selection for the putimgdata encoder        * */
+/* *             - added mng_unfilter_row                                   * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -37,6 +41,14 @@
 /* ************************************************************************** */
 
 mng_retcode mng_filter_a_row         (mng_datap pData);
+#ifdef MNG_SUPPORT_PARALLEL
+mng_retcode mng_unfilter_row         (mng_uint8  iFilter,
+                                      mng_uint8p pRaw,
+                                      mng_uint8p pPrior,
+                                      mng_int32  iRowsize,
+                                      mng_int32  iBpp,
+                                      mng_uint32 iSIMDflags);
+#endif
 
 /* ************************************************************************** */
 
@@ -62,6 +74,19 @@ mng_retcode mng_differ_rgba16        (mng_datap pData);
 
 /* ************************************************************************** */
 
+#ifdef MNG_INCLUDE_WRITE_PROCS
+mng_uint8p  mng_select_filter        (mng_datap  pData,
+                                      mng_uint8  iFiltersel,
+                                      mng_int32  iBpp,
+                                      mng_int32  iRowsize,
+                                      mng_uint8p pRaw,
+                                      mng_uint8p pPrior,
+                                      mng_uint8p pOut,
+                                      mng_uint8p pTemp);
+#endif
+
+/* ************************************************************************** */
+
 #endif /* _libmng_filter_h_ */
 
 /* ************************************************************************** */
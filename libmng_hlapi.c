@@ -198,6 +198,33 @@
 /* *                                                                        * */
 /* *             1.0.11 - 07/24/2007 - G.R-P bugfix for all-zero delays     * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added SIMD capability detection & funcquery entries      * */
+/* *             - added keyframe cache to the display_goxxxx functions     * */
+/* *             - enabled getimgdata functions                             * */
+/* *             - enabled putimgdata_ihdr & added filter-selection default * */
+/* *             - added mng_get_dirtyrectcount & mng_get_dirtyrect         * */
+/* *             - release the memory-pool in mng_reset                     * */
+/* *             - added mng_set_mempool/mng_get_mempool & counters         * */
+/* *             - detect PCLMULQDQ & ARMv8 CRC32 support                   * */
+/* *             - maintain the running total of pushed data                * */
+/* *             - added mng_read_memory                                    * */
+/* *             - added bIsGray for the gray+alpha row                     * */
+/* *             - added fFusedrow                                          * */
+/* *             - 16-bit gamma-tables are dropped by mng_reset             * */
+/* *             - added mng_set_cmscache/mng_get_cmscachehits/misses       * */
+/* *             - mng_read_memory starts and stops the decode workers      * */
+/* *             - added mng_render_frames; tickcount comes from the        * */
+/* *               virtual clock when it is on                              * */
+/* *             - added mng_putframe frame-sequence encoder                * */
+/* *             - added mng_set_lazymagnify/mng_get_lazymagnify            * */
+/* *             - filterselection entries in the function-table use the    * */
+/* *               conditionals of their definitions                        * */
+/* *             - crc32 capability assumed with MNG_EMULATE_NEON           * */
+/* *             - a failing goframe/golayer/gotime resets the run-data so  * */
+/* *               a retry starts afresh; the reset leaves any DHDR block   * */
+/* *             - mng_reset keeps a pool that still has blocks out         * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -213,12 +240,17 @@
 #include "libmng_memory.h"
 #include "libmng_read.h"
 #include "libmng_write.h"
+#include "libmng_encode.h"
 #include "libmng_display.h"
 #include "libmng_zlib.h"
 #include "libmng_jpeg.h"
 #include "libmng_cms.h"
 #include "libmng_pixels.h"
 
+#if defined(MNG_INCLUDE_SIMD_NEON) && defined(__linux__) && !defined(MNG_EMULATE_NEON)
+#include <sys/auxv.h>                  /* getauxval for the ARMv8 crc check */
+#endif
+
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
 #pragma option -A                      /* force ANSI-C */
 #endif
@@ -319,6 +351,20 @@ MNG_LOCAL mng_retcode mng_drop_objects (mng_datap pData,
 
 /* ************************************************************************** */
 
+#if defined(MNG_SUPPORT_READ) || defined(MNG_SUPPORT_DISPLAY)
+MNG_LOCAL mng_uint32 get_tickcount (mng_datap pData)
+{
+#ifdef MNG_SUPPORT_DISPLAY
+  if (pData->bVirtualclock)            /* library keeps the time ? */
+    return pData->iVirtualtime;
+#endif
+
+  return pData->fGettickcount ((mng_handle)pData);
+}
+#endif
+
+/* ************************************************************************** */
+
 #ifdef MNG_SUPPORT_DISPLAY
 #ifndef MNG_SKIPCHUNK_SAVE
 MNG_LOCAL mng_retcode mng_drop_savedata (mng_datap pData)
@@ -401,6 +447,13 @@ MNG_LOCAL mng_retcode mng_reset_rundata (mng_datap pData)
   pData->iUpdateright          = 0;
   pData->iUpdatetop            = 0;
   pData->iUpdatebottom         = 0;
+  pData->sDirty.iCount         = 0;    /* and dirty-rectangles */
+  pData->sDirty.bOpen          = MNG_FALSE;
+  pData->sDirtydone.iCount     = 0;
+  pData->sRefreshdone.iLeft    = 0;
+  pData->sRefreshdone.iTop     = 0;
+  pData->sRefreshdone.iRight   = 0;
+  pData->sRefreshdone.iBottom  = 0;
   pData->iPLTEcount            = 0;    /* reset PLTE data */
 
 #ifndef MNG_SKIPCHUNK_DEFI
@@ -496,6 +549,7 @@ MNG_LOCAL mng_retcode mng_reset_rundata (mng_datap pData)
 #endif
 #ifndef MNG_NO_DELTA_PNG
                                        /* reset delta-image */
+  pData->bHasDHDR              = MNG_FALSE;
   pData->pDeltaImage           = MNG_NULL;
   pData->iDeltaImagetype       = 0;
   pData->iDeltatype            = 0;
@@ -552,6 +606,37 @@ MNG_LOCAL void cleanup_errors (mng_datap pData)
 
 /* ************************************************************************** */
 
+#ifdef MNG_SUPPORT_SIMD
+MNG_LOCAL mng_uint32 mng_detect_simd (void)
+{
+  mng_uint32 iCaps = MNG_SIMD_NONE;
+
+#ifdef MNG_INCLUDE_SIMD_X86
+  __builtin_cpu_init ();               /* ask the cpu what it can do */
+
+  if (__builtin_cpu_supports ("sse2"))
+    iCaps |= MNG_SIMD_SSE2;
+  if (__builtin_cpu_supports ("avx2"))
+    iCaps |= MNG_SIMD_AVX2;
+  if (__builtin_cpu_supports ("pclmul"))
+    iCaps |= MNG_SIMD_PCLMUL;
+#endif
+#ifdef MNG_INCLUDE_SIMD_NEON
+  iCaps |= MNG_SIMD_NEON;              /* always present on aarch64 */
+#if defined(MNG_EMULATE_NEON)
+  iCaps |= MNG_SIMD_CRC32;
+#elif defined(__linux__)
+  if (getauxval (AT_HWCAP) & HWCAP_CRC32)
+    iCaps |= MNG_SIMD_CRC32;           /* optional in ARMv8.0 */
+#elif defined(__APPLE__)
+  iCaps |= MNG_SIMD_CRC32;
+#endif
+#endif
+
+  return iCaps;
+}
+#endif /* MNG_SUPPORT_SIMD */
+
 #ifdef MNG_SUPPORT_READ
 MNG_LOCAL mng_retcode make_pushbuffer (mng_datap       pData,
                                        mng_ptr         pPushdata,
@@ -686,6 +771,10 @@ MNG_LOCAL mng_func_entry const func_table [] =
     {"mng_get_bkgdstyle",          1, 0, 0},
     {"mng_get_cacheplayback",      1, 0, 2},
     {"mng_get_canvasstyle",        1, 0, 0},
+#ifdef MNG_FULL_CMS
+    {"mng_get_cmscachehits",       1, 0, 11},
+    {"mng_get_cmscachemisses",     1, 0, 11},
+#endif
     {"mng_get_colortype",          1, 0, 0},
     {"mng_get_compression",        1, 0, 0},
 #ifndef MNG_NO_CURRENT_INFO
@@ -694,14 +783,22 @@ MNG_LOCAL mng_func_entry const func_table [] =
     {"mng_get_currentplaytime",    1, 0, 0},
 #endif
     {"mng_get_currframdelay",      1, 0, 9},
+#ifdef MNG_SUPPORT_PARALLEL
+    {"mng_get_decodethreads",      1, 0, 11},
+#endif
 #ifndef MNG_NO_DFLT_INFO
     {"mng_get_dfltimggamma",       1, 0, 0},
     {"mng_get_dfltimggammaint",    1, 0, 0},
 #endif
+    {"mng_get_dirtyrect",          1, 0, 11},
+    {"mng_get_dirtyrectcount",     1, 0, 11},
     {"mng_get_displaygamma",       1, 0, 0},
     {"mng_get_displaygammaint",    1, 0, 0},
     {"mng_get_doprogressive",      1, 0, 2},
     {"mng_get_filter",             1, 0, 0},
+#if defined(MNG_INCLUDE_ZLIB) && defined(MNG_ACCESS_ZLIB)
+    {"mng_get_filterselection",    1, 0, 11},
+#endif
     {"mng_get_framecount",         1, 0, 0},
     {"mng_get_imageheight",        1, 0, 0},
     {"mng_get_imagelevel",         1, 0, 0},
@@ -715,19 +812,34 @@ MNG_LOCAL mng_func_entry const func_table [] =
     {"mng_get_jpeg_progressive",   1, 0, 0},
     {"mng_get_jpeg_quality",       1, 0, 0},
     {"mng_get_jpeg_smoothing",     1, 0, 0},
+#endif
+#ifdef MNG_SUPPORT_KEYFRAMES
+    {"mng_get_keyframecount",      1, 0, 11},
+    {"mng_get_keyframememory",     1, 0, 11},
 #endif
     {"mng_get_lastbackchunk",      1, 0, 3},
     {"mng_get_lastseekname",       1, 0, 5},
     {"mng_get_layercount",         1, 0, 0},
+#if defined(MNG_SUPPORT_DISPLAY) && !defined(MNG_SKIPCHUNK_MAGN)
+    {"mng_get_lazymagnify",        1, 0, 11},
+#endif
 #ifndef MNG_SKIP_MAXCANVAS
     {"mng_get_maxcanvasheight",    1, 0, 0},
     {"mng_get_maxcanvaswidth",     1, 0, 0},
+#endif
+#ifdef MNG_SUPPORT_MEMPOOL
+    {"mng_get_mempool",            1, 0, 11},
+    {"mng_get_mempoolcurrent",     1, 0, 11},
+    {"mng_get_mempoolpeak",        1, 0, 11},
 #endif
     {"mng_get_playtime",           1, 0, 0},
     {"mng_get_refreshpass",        1, 0, 0},
     {"mng_get_runtime",            1, 0, 0},
     {"mng_get_sectionbreaks",      1, 0, 0},
     {"mng_get_sigtype",            1, 0, 0},
+#ifdef MNG_SUPPORT_SIMD
+    {"mng_get_simd",               1, 0, 11},
+#endif
     {"mng_get_simplicity",         1, 0, 0},
     {"mng_get_speed",              1, 0, 0},
     {"mng_get_srgb",               1, 0, 0},
@@ -746,6 +858,7 @@ MNG_LOCAL mng_func_entry const func_table [] =
     {"mng_get_viewgamma",          1, 0, 0},
     {"mng_get_viewgammaint",       1, 0, 0},
 #endif
+    {"mng_get_virtualclock",       1, 0, 11},
 #ifdef MNG_ACCESS_ZLIB
     {"mng_get_zlib_level",         1, 0, 0},
     {"mng_get_zlib_maxidat",       1, 0, 0},
@@ -911,9 +1024,9 @@ MNG_LOCAL mng_func_entry const func_table [] =
 #ifndef MNG_SKIPCHUNK_zTXt
     {"mng_getchunk_ztxt",          1, 0, 0},
 #endif
-    {"mng_getimgdata_chunk",       0, 0, 0},
-    {"mng_getimgdata_chunkseq",    0, 0, 0},
-    {"mng_getimgdata_seq",         0, 0, 0},
+    {"mng_getimgdata_chunk",       1, 0, 11},
+    {"mng_getimgdata_chunkseq",    1, 0, 11},
+    {"mng_getimgdata_seq",         1, 0, 11},
     {"mng_getlasterror",           1, 0, 0},
     {"mng_initialize",             1, 0, 0},
     {"mng_iterate_chunks",         1, 0, 0},
@@ -1046,19 +1159,30 @@ MNG_LOCAL mng_func_entry const func_table [] =
 #ifndef MNG_SKIPCHUNK_zTXt
     {"mng_putchunk_ztxt",          1, 0, 0},
 #endif
-    {"mng_putimgdata_ihdr",        0, 0, 0},
+#ifdef MNG_SUPPORT_ENCODER
+    {"mng_putframe",               1, 0, 11},
+#endif
+    {"mng_putimgdata_ihdr",        1, 0, 11},
     {"mng_putimgdata_jhdr",        0, 0, 0},
     {"mng_reset",                  1, 0, 0},
     {"mng_read",                   1, 0, 0},
+    {"mng_read_memory",            1, 0, 11},
     {"mng_read_pushchunk",         1, 0, 8},
     {"mng_read_pushdata",          1, 0, 8},
     {"mng_read_pushsig",           1, 0, 8},
     {"mng_read_resume",            1, 0, 0},
     {"mng_readdisplay",            1, 0, 0},
+    {"mng_render_frames",          1, 0, 11},
     {"mng_set_bgcolor",            1, 0, 0},
     {"mng_set_bkgdstyle",          1, 0, 0},
     {"mng_set_cacheplayback",      1, 0, 2},
     {"mng_set_canvasstyle",        1, 0, 0},
+#ifdef MNG_FULL_CMS
+    {"mng_set_cmscache",           1, 0, 11},
+#endif
+#ifdef MNG_SUPPORT_PARALLEL
+    {"mng_set_decodethreads",      1, 0, 11},
+#endif
     {"mng_set_dfltimggamma",       1, 0, 0},
 #ifndef MNG_NO_DFLT_INFO
     {"mng_set_dfltimggammaint",    1, 0, 0},
@@ -1066,6 +1190,9 @@ MNG_LOCAL mng_func_entry const func_table [] =
     {"mng_set_displaygamma",       1, 0, 0},
     {"mng_set_displaygammaint",    1, 0, 0},
     {"mng_set_doprogressive",      1, 0, 2},
+#if defined(MNG_INCLUDE_ZLIB) && defined(MNG_ACCESS_ZLIB) && defined(MNG_SUPPORT_WRITE)
+    {"mng_set_filterselection",    1, 0, 11},
+#endif
 #ifdef MNG_ACCESS_JPEG
     {"mng_set_jpeg_dctmethod",     1, 0, 0},
     {"mng_set_jpeg_maxjdat",       1, 0, 0},
@@ -1074,15 +1201,27 @@ MNG_LOCAL mng_func_entry const func_table [] =
     {"mng_set_jpeg_quality",       1, 0, 0},
     {"mng_set_jpeg_smoothing",     1, 0, 0},
 #endif
+#ifdef MNG_SUPPORT_KEYFRAMES
+    {"mng_set_keyframecache",      1, 0, 11},
+#endif
+#if defined(MNG_SUPPORT_DISPLAY) && !defined(MNG_SKIPCHUNK_MAGN)
+    {"mng_set_lazymagnify",        1, 0, 11},
+#endif
 #ifndef MNG_SKIP_MAXCANVAS
     {"mng_set_maxcanvasheight",    1, 0, 0},
     {"mng_set_maxcanvassize",      1, 0, 0},
     {"mng_set_maxcanvaswidth",     1, 0, 0},
+#endif
+#ifdef MNG_SUPPORT_MEMPOOL
+    {"mng_set_mempool",            1, 0, 11},
 #endif
     {"mng_set_outputprofile",      1, 0, 0},
     {"mng_set_outputprofile2",     1, 0, 0},
     {"mng_set_outputsrgb",         1, 0, 1},
     {"mng_set_sectionbreaks",      1, 0, 0},
+#ifdef MNG_SUPPORT_SIMD
+    {"mng_set_simd",               1, 0, 11},
+#endif
     {"mng_set_speed",              1, 0, 0},
     {"mng_set_srgb",               1, 0, 0},
     {"mng_set_srgbimplicit",       1, 0, 1},
@@ -1096,6 +1235,7 @@ MNG_LOCAL mng_func_entry const func_table [] =
     {"mng_set_viewgamma",          1, 0, 0},
     {"mng_set_viewgammaint",       1, 0, 0},
 #endif
+    {"mng_set_virtualclock",       1, 0, 11},
 #ifdef MNG_ACCESS_ZLIB
     {"mng_set_zlib_level",         1, 0, 0},
     {"mng_set_zlib_maxidat",       1, 0, 0},
@@ -1264,6 +1404,8 @@ mng_handle MNG_DECL mng_initialize (mng_ptr       pUserdata,
   pData->hProf2                = 0;
   pData->hProf3                = 0;
   pData->hTrans                = 0;
+  pData->bTranscached          = MNG_FALSE;
+  pData->iCmscachesize         = MNG_CMSCACHESIZE;
 #endif
 
   pData->dViewgamma            = 1.0;
@@ -1281,6 +1423,29 @@ mng_handle MNG_DECL mng_initialize (mng_ptr       pUserdata,
                                           critical chunks; warning for ancillery;
                                           generate crc for output */
   pData->iCrcmode              = MNG_CRC_DEFAULT;
+#ifdef MNG_SUPPORT_SIMD                /* use whatever vector-units we have */
+  pData->iSIMDcaps             = mng_detect_simd ();
+  pData->iSIMDflags            = pData->iSIMDcaps;
+#endif
+#ifdef MNG_SUPPORT_KEYFRAMES           /* no keyframe cache by default */
+  pData->iKeyframeinterval     = 0;
+  pData->iKeyframemaxmem       = 0;
+#endif
+#ifdef MNG_SUPPORT_PARALLEL            /* decode on the calling thread only */
+  pData->iDecodethreads        = 0;
+  pData->pDecodepool           = MNG_NULL;
+  pData->pDecodejob            = MNG_NULL;
+#endif
+#ifdef MNG_SUPPORT_DISPLAY             /* the app keeps the time */
+  pData->bVirtualclock         = MNG_FALSE;
+  pData->pRendercanvas         = MNG_NULL;
+  pData->iRendercanvassize     = 0;    /* and the canvas */
+  pData->iRenderrowsize        = 0;
+#endif
+#if defined(MNG_SUPPORT_DISPLAY) && !defined(MNG_SKIPCHUNK_MAGN)
+  pData->bLazymagnify          = MNG_FALSE;
+  pData->pMagnobj              = MNG_NULL;
+#endif
                                        /* normal animation-speed ! */
   pData->iSpeed                = mng_st_normal;
                                        /* initial image limits */
@@ -1359,6 +1524,7 @@ mng_handle MNG_DECL mng_initialize (mng_ptr       pUserdata,
   pData->pLastpushchunk        = MNG_NULL;
   pData->pFirstpushdata        = MNG_NULL;
   pData->pLastpushdata         = MNG_NULL;
+  pData->iPushsize             = 0;
 #endif
 
 #ifdef MNG_INCLUDE_ZLIB
@@ -1371,6 +1537,8 @@ mng_handle MNG_DECL mng_initialize (mng_ptr       pUserdata,
   pData->iZstrategy            = MNG_ZLIB_STRATEGY;
                                        /* default maximum IDAT data size */
   pData->iMaxIDAT              = MNG_MAX_IDAT_SIZE;
+                                       /* default putimgdata filter-selection */
+  pData->iFiltersel            = MNG_ZLIB_FILTERSEL;
 #endif
 
 #ifdef MNG_INCLUDE_JNG                 /* default IJG compression parameters */
@@ -1413,12 +1581,19 @@ mng_retcode MNG_DECL mng_reset (mng_handle hHandle)
 #ifndef MNG_SKIPCHUNK_SAVE
   mng_drop_savedata (pData);           /* cleanup saved-data from SAVE/SEEK */
 #endif
+#ifdef MNG_SUPPORT_KEYFRAMES
+  mng_drop_keyframes (pData);          /* cleanup the keyframe cache */
+#endif
 #endif
 
 #if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_FULL_CMS)
   mng_clear_cms (pData);               /* cleanup left-over cms stuff if any */
 #endif
 
+#if defined(MNG_SUPPORT_DISPLAY) && (defined(MNG_GAMMA_ONLY) || defined(MNG_FULL_CMS) || defined(MNG_APP_CMS))
+  mng_clear_gammacache (pData);        /* drop the 16-bit gamma-tables */
+#endif
+
 #if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_INCLUDE_JNG)
   mngjpeg_cleanup (pData);             /* cleanup jpeg stuff */
 #endif
@@ -1445,12 +1620,18 @@ mng_retcode MNG_DECL mng_reset (mng_handle hHandle)
     mng_release_pushdata (pData);
   while (pData->pFirstpushchunk)
     mng_release_pushchunk (pData);
+
+  mng_drop_memindex (pData);           /* forget about any memory-input */
 #endif
 
 #ifdef MNG_SUPPORT_WRITE               /* cleanup default write buffer */
   MNG_FREE (pData, pData->pWritebuf, pData->iWritebufsize);
 #endif
 
+#ifdef MNG_SUPPORT_ENCODER
+  mng_drop_encoder (pData);            /* and the mng_putframe state */
+#endif
+
 #if defined(MNG_SUPPORT_READ) || defined(MNG_SUPPORT_WRITE)
   mng_drop_chunks  (pData);            /* drop stored chunks (if any) */
 #endif
@@ -1464,6 +1645,11 @@ mng_retcode MNG_DECL mng_reset (mng_handle hHandle)
 #endif
 #endif
 
+#ifdef MNG_SUPPORT_MEMPOOL
+  mng_release_mempool (pData);         /* the pool should be empty now; give
+                                          it back (it refuses if it isn't) */
+#endif
+
   pData->eSigtype              = mng_it_unknown;
   pData->eImagetype            = mng_it_unknown;
   pData->iWidth                = 0;    /* these are unknown yet */
@@ -1612,6 +1798,8 @@ mng_retcode MNG_DECL mng_reset (mng_handle hHandle)
   pData->iSynctime             = 0;
   pData->iStarttime            = 0;
   pData->iEndtime              = 0;
+  pData->iVirtualtime          = 0;
+  pData->iTimerdelay           = 0;
   pData->bRunning              = MNG_FALSE;
   pData->bTimerset             = MNG_FALSE;
   pData->iBreakpoint           = 0;
@@ -1659,6 +1847,7 @@ mng_retcode MNG_DECL mng_reset (mng_handle hHandle)
   pData->pPrevrow              = MNG_NULL;
   pData->pRGBArow              = MNG_NULL;
   pData->bIsRGBA16             = MNG_TRUE;
+  pData->bIsGray               = MNG_FALSE;
   pData->bIsOpaque             = MNG_TRUE;
   pData->iFilterbpp            = 1;
 
@@ -1681,6 +1870,7 @@ mng_retcode MNG_DECL mng_reset (mng_handle hHandle)
 #endif
                                        /* no processing callbacks */
   pData->fDisplayrow           = MNG_NULL;
+  pData->fFusedrow             = MNG_NULL;
   pData->fRestbkgdrow          = MNG_NULL;
   pData->fCorrectrow           = MNG_NULL;
   pData->fRetrieverow          = MNG_NULL;
@@ -1860,9 +2050,13 @@ mng_retcode MNG_DECL mng_cleanup (mng_handle* hHandle)
 
 #ifdef MNG_SUPPORT_DISPLAY             /* drop object 0 */
   mng_free_imageobject (pData, (mng_imagep)pData->pObjzero);
+                                       /* and the mng_render_frames canvas */
+  MNG_FREE (pData, pData->pRendercanvas, pData->iRendercanvassize);
 #endif
 
 #if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_FULL_CMS)
+  mng_drop_cmscache (pData);           /* drop cached transforms */
+
   if (pData->hProf2)                   /* output profile defined ? */
     mnglcms_freeprofile (pData->hProf2);
 
@@ -1960,7 +2154,7 @@ mng_retcode MNG_DECL mng_read (mng_handle hHandle)
   if (pData->bSuspended)               /* read suspension ? */
   {
      iRetcode            = MNG_NEEDMOREDATA;
-     pData->iSuspendtime = pData->fGettickcount ((mng_handle)pData);
+     pData->iSuspendtime = get_tickcount (pData);
   }
 
 #ifdef MNG_SUPPORT_TRACE
@@ -1973,6 +2167,93 @@ mng_retcode MNG_DECL mng_read (mng_handle hHandle)
 
 /* ************************************************************************** */
 
+#ifdef MNG_SUPPORT_READ
+mng_retcode MNG_DECL mng_read_memory (mng_handle hHandle,
+                                      mng_ptr    pBuf,
+                                      mng_size_t iLength)
+{
+  mng_datap   pData;                   /* local vars */
+  mng_retcode iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_READ_MEMORY, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)            /* check validity handle and callbacks */
+  pData = ((mng_datap)hHandle);        /* and make it addressable */
+
+#ifndef MNG_INTERNAL_MEMMNGMT
+  MNG_VALIDCB (hHandle, fMemalloc)
+  MNG_VALIDCB (hHandle, fMemfree)
+#endif
+
+#ifdef MNG_SUPPORT_DISPLAY             /* valid at this point ? */
+  if ((pData->bReading) || (pData->bDisplaying))
+#else
+  if (pData->bReading)
+#endif
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID);
+
+#ifdef MNG_SUPPORT_WRITE
+  if ((pData->bWriting) || (pData->bCreating))
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID);
+#endif
+
+  if (!pData->bCacheplayback)          /* must store playback info to work!! */
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID);
+  if ((pData->pMemdata) || (!pBuf))    /* been here before, or no data ? */
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID);
+                                       /* more than we can handle ? */
+  if ((mng_size_t)(mng_uint32)iLength != iLength)
+    MNG_ERROR (pData, MNG_INVALIDLENGTH);
+
+  cleanup_errors (pData);              /* cleanup previous errors */
+
+  pData->pMemdata     = (mng_uint8p)pBuf;
+  pData->iMemdatasize = (mng_uint32)iLength;
+                                       /* find all the chunks */
+  iRetcode = mng_index_memory (pData);
+
+  if (iRetcode)
+    return iRetcode;
+
+#ifdef MNG_SUPPORT_PARALLEL
+  if (pData->iDecodethreads)           /* let the workers get ahead ? */
+  {
+    iRetcode = mngzlib_decodestart (pData);
+
+    if (iRetcode)
+      return iRetcode;
+  }
+#endif
+
+  pData->bReading = MNG_TRUE;          /* read only! */
+
+  iRetcode = mng_read_graphic (pData); /* and process them */
+
+  if (pData->bEOF)                     /* already at EOF ? */
+  {
+    pData->bReading = MNG_FALSE;       /* then we're no longer reading */
+
+#ifdef MNG_SUPPORT_PARALLEL
+    mngzlib_decodestop (pData);        /* and the workers are done */
+#endif
+
+#ifdef MNG_SUPPORT_DISPLAY
+    mng_reset_rundata (pData);         /* reset rundata */
+#endif
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_READ_MEMORY, MNG_LC_END);
+#endif
+
+  return iRetcode;
+}
+#endif /* MNG_SUPPORT_READ */
+
+/* ************************************************************************** */
+
 #ifdef MNG_SUPPORT_READ
 mng_retcode MNG_DECL mng_read_pushdata (mng_handle hHandle,
                                         mng_ptr    pData,
@@ -2000,6 +2281,7 @@ mng_retcode MNG_DECL mng_read_pushdata (mng_handle hHandle,
     pMyData->pFirstpushdata = pPush;
 
   pMyData->pLastpushdata = pPush;
+  pMyData->iPushsize    += (mng_uint32)iLength;
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_READ_PUSHDATA, MNG_LC_END);
@@ -2101,7 +2383,7 @@ mng_retcode MNG_DECL mng_read_resume (mng_handle hHandle)
 #ifdef MNG_SUPPORT_DISPLAY             /* re-synchronize ? */
   if ((pData->bDisplaying) && (pData->bRunning))
     pData->iSynctime  = pData->iSynctime - pData->iSuspendtime +
-                        pData->fGettickcount (hHandle);
+                        get_tickcount (pData);
 #endif
 
   iRetcode = mng_read_graphic (pData); /* continue reading now */
@@ -2121,7 +2403,7 @@ mng_retcode MNG_DECL mng_read_resume (mng_handle hHandle)
   if (pData->bSuspended)               /* read suspension ? */
   {
      iRetcode            = MNG_NEEDMOREDATA;
-     pData->iSuspendtime = pData->fGettickcount ((mng_handle)pData);
+     pData->iSuspendtime = get_tickcount (pData);
   }
 
 #ifdef MNG_SUPPORT_TRACE
@@ -2246,8 +2528,12 @@ mng_retcode MNG_DECL mng_readdisplay (mng_handle hHandle)
   MNG_VALIDCB (hHandle, fReaddata)
   MNG_VALIDCB (hHandle, fGetcanvasline)
   MNG_VALIDCB (hHandle, fRefresh)
-  MNG_VALIDCB (hHandle, fGettickcount)
-  MNG_VALIDCB (hHandle, fSettimer)
+
+  if (!pData->bVirtualclock)           /* the app keeps the time ? */
+  {
+    MNG_VALIDCB (hHandle, fGettickcount)
+    MNG_VALIDCB (hHandle, fSettimer)
+  }
                                        /* valid at this point ? */
   if ((pData->bReading) || (pData->bDisplaying))
     MNG_ERROR (pData, MNG_FUNCTIONINVALID);
@@ -2270,7 +2556,7 @@ mng_retcode MNG_DECL mng_readdisplay (mng_handle hHandle)
   pData->iRequesttime  = 0;
   pData->bSearching    = MNG_FALSE;
   pData->iRuntime      = 0;
-  pData->iSynctime     = pData->fGettickcount (hHandle);
+  pData->iSynctime     = get_tickcount (pData);
   pData->iSuspendtime  = 0;
   pData->iStarttime    = pData->iSynctime;
   pData->iEndtime      = 0;
@@ -2295,7 +2581,7 @@ mng_retcode MNG_DECL mng_readdisplay (mng_handle hHandle)
   if (pData->bSuspended)               /* read suspension ? */
   {
      iRetcode            = MNG_NEEDMOREDATA;
-     pData->iSuspendtime = pData->fGettickcount ((mng_handle)pData);
+     pData->iSuspendtime = get_tickcount (pData);
   }
   else
   if (pData->bTimerset)                /* indicate timer break ? */
@@ -2341,8 +2627,12 @@ mng_retcode MNG_DECL mng_display (mng_handle hHandle)
 
   MNG_VALIDCB (hHandle, fGetcanvasline)
   MNG_VALIDCB (hHandle, fRefresh)
-  MNG_VALIDCB (hHandle, fGettickcount)
-  MNG_VALIDCB (hHandle, fSettimer)
+
+  if (!pData->bVirtualclock)           /* the app keeps the time ? */
+  {
+    MNG_VALIDCB (hHandle, fGettickcount)
+    MNG_VALIDCB (hHandle, fSettimer)
+  }
 
   if (pData->bDisplaying)              /* valid at this point ? */
     MNG_ERROR (pData, MNG_FUNCTIONINVALID);
@@ -2369,7 +2659,7 @@ mng_retcode MNG_DECL mng_display (mng_handle hHandle)
   pData->iRequesttime  = 0;
   pData->bSearching    = MNG_FALSE;
   pData->iRuntime      = 0;
-  pData->iSynctime     = pData->fGettickcount (hHandle);
+  pData->iSynctime     = get_tickcount (pData);
 #ifdef MNG_SUPPORT_READ
   pData->iSuspendtime  = 0;
 #endif  
@@ -2432,9 +2722,9 @@ mng_retcode MNG_DECL mng_display_resume (mng_handle hHandle)
       {
         if (pData->bSuspended)         /* calculate proper synchronization */
           pData->iSynctime = pData->iSynctime - pData->iSuspendtime +
-                             pData->fGettickcount (hHandle);
+                             get_tickcount (pData);
         else
-          pData->iSynctime = pData->fGettickcount (hHandle);
+          pData->iSynctime = get_tickcount (pData);
 
         pData->bSuspended = MNG_FALSE; /* now reset this flag */  
                                        /* and continue reading */
@@ -2450,7 +2740,7 @@ mng_retcode MNG_DECL mng_display_resume (mng_handle hHandle)
       else
 #endif /* MNG_SUPPORT_READ */
       {                                /* synchronize timing */
-        pData->iSynctime = pData->fGettickcount (hHandle);
+        pData->iSynctime = get_tickcount (pData);
                                        /* resume display processing */
         iRetcode = mng_process_display (pData);
       }
@@ -2462,7 +2752,7 @@ mng_retcode MNG_DECL mng_display_resume (mng_handle hHandle)
   }
   else
   {                                    /* synchronize timing */
-    pData->iSynctime = pData->fGettickcount (hHandle);
+    pData->iSynctime = get_tickcount (pData);
     pData->bRunning  = MNG_TRUE;       /* it's restarted again ! */
                                        /* resume display processing */
     iRetcode = mng_process_display (pData);
@@ -2474,7 +2764,7 @@ mng_retcode MNG_DECL mng_display_resume (mng_handle hHandle)
   if (pData->bSuspended)               /* read suspension ? */
   {
      iRetcode            = MNG_NEEDMOREDATA;
-     pData->iSuspendtime = pData->fGettickcount ((mng_handle)pData);
+     pData->iSuspendtime = get_tickcount (pData);
   }
   else
   if (pData->bTimerset)                /* indicate timer break ? */
@@ -2510,6 +2800,161 @@ mng_retcode MNG_DECL mng_display_resume (mng_handle hHandle)
 
 /* ************************************************************************** */
 
+#ifdef MNG_SUPPORT_DISPLAY
+MNG_LOCAL mng_uint32 canvas_pixelsize (mng_uint32 iStyle)
+{
+  mng_uint32 iSize;
+
+  if (MNG_CANVAS_ALPHASEPD (iStyle))   /* no separate alpha-plane here */
+    return 0;
+
+  switch (MNG_CANVAS_PIXELTYPE (iStyle))
+  {
+    case 0  :                          /* rgb & bgr */
+    case 1  : { iSize = 3; break; }
+    case 2  : { iSize = 1; break; }    /* gray */
+    case 5  :                          /* 565 */
+    case 6  : { return (MNG_CANVAS_HASALPHA (iStyle) ? 3 : 2); }
+    case 7  :                          /* 555 */
+    case 8  : { return 2; }
+    default : { return 0; }
+  }
+
+  if ((MNG_CANVAS_HASALPHA (iStyle)) || (MNG_CANVAS_HASFILLER (iStyle)))
+    iSize++;
+
+  if (MNG_CANVAS_16BIT (iStyle))
+    iSize = iSize << 1;
+
+  return iSize;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_ptr MNG_DECL render_canvasline (mng_handle hHandle,
+                                              mng_uint32 iLinenr)
+{
+  mng_datap pData = (mng_datap)hHandle;
+
+  return (mng_ptr)(pData->pRendercanvas + iLinenr * pData->iRenderrowsize);
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool MNG_DECL render_refresh (mng_handle hHandle,
+                                            mng_uint32 iX,
+                                            mng_uint32 iY,
+                                            mng_uint32 iWidth,
+                                            mng_uint32 iHeight)
+{
+  return MNG_TRUE;                     /* frames go to the render callback */
+}
+
+/* ************************************************************************** */
+
+mng_retcode MNG_DECL mng_render_frames (mng_handle      hHandle,
+                                        mng_renderframe fProc)
+{
+  mng_datap   pData;                   /* local vars */
+  mng_ptr     pCanvas  = MNG_NULL;
+  mng_uint32  iRowsize = 0;
+  mng_bool    bVirtualclock;
+  mng_retcode iRetcode;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_RENDER_FRAMES, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)            /* check validity handle */
+  pData = ((mng_datap)hHandle);        /* and make it addressable */
+
+  if (!fProc)                          /* where do the frames go ? */
+    MNG_ERROR (pData, MNG_NOCALLBACK);
+                                       /* must have read the header */
+  if ((!pData->iWidth) || (!pData->iHeight))
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID);
+
+#ifdef MNG_SUPPORT_READ
+  if (pData->bReading)                 /* and everything else */
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID);
+#endif
+                                       /* no canvas from the app ? */
+  if ((!pData->fGetcanvasline) || (pData->fGetcanvasline == render_canvasline))
+  {
+    mng_uint32 iPixelsize = canvas_pixelsize (pData->iCanvasstyle);
+    mng_uint32 iSize;
+
+    if (!iPixelsize)                   /* then we need to know the layout */
+      MNG_ERROR (pData, MNG_INVALIDCNVSTYLE);
+
+    if (pData->iWidth > 0x7FFFFFFFL / pData->iHeight / iPixelsize)
+      MNG_ERROR (pData, MNG_IMAGETOOLARGE);
+
+    iSize = pData->iWidth * pData->iHeight * iPixelsize;
+
+    if (iSize != pData->iRendercanvassize)
+    {                                  /* (re)allocate our own canvas */
+      MNG_FREE (pData, pData->pRendercanvas, pData->iRendercanvassize);
+      pData->iRendercanvassize = 0;
+      MNG_ALLOC (pData, pData->pRendercanvas, iSize);
+      pData->iRendercanvassize = iSize;
+    }
+
+    pData->iRenderrowsize = pData->iWidth * iPixelsize;
+    pData->fGetcanvasline = render_canvasline;
+
+    pCanvas  = (mng_ptr)pData->pRendercanvas;
+    iRowsize = pData->iRenderrowsize;
+  }
+
+  if (!pData->fRefresh)                /* app doesn't need refreshes ? */
+    pData->fRefresh = render_refresh;
+
+  bVirtualclock        = pData->bVirtualclock;
+  pData->bVirtualclock = MNG_TRUE;     /* never wait for a timer */
+
+  pData->sRefreshdone.iLeft   = 0;     /* nothing refreshed yet */
+  pData->sRefreshdone.iTop    = 0;
+  pData->sRefreshdone.iRight  = 0;
+  pData->sRefreshdone.iBottom = 0;
+
+  if (pData->bDisplaying)              /* continue a previous run ? */
+    iRetcode = mng_display_resume (hHandle);
+  else
+    iRetcode = mng_display (hHandle);
+                                       /* each timer-break ends a frame */
+  while ((iRetcode == MNG_NEEDTIMERWAIT) || (iRetcode == MNG_NEEDSECTIONWAIT))
+  {
+    if (iRetcode == MNG_NEEDTIMERWAIT)
+    {
+      if (!fProc (hHandle, pCanvas, iRowsize, pData->iTimerdelay,
+                  (mng_uint32)pData->sRefreshdone.iLeft,
+                  (mng_uint32)pData->sRefreshdone.iTop,
+                  (mng_uint32)(pData->sRefreshdone.iRight  - pData->sRefreshdone.iLeft),
+                  (mng_uint32)(pData->sRefreshdone.iBottom - pData->sRefreshdone.iTop)))
+        break;                         /* app has seen enough */
+
+      pData->sRefreshdone.iLeft   = 0;
+      pData->sRefreshdone.iTop    = 0;
+      pData->sRefreshdone.iRight  = 0;
+      pData->sRefreshdone.iBottom = 0;
+    }
+
+    iRetcode = mng_display_resume (hHandle);
+  }
+
+  pData->bVirtualclock = bVirtualclock;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_RENDER_FRAMES, MNG_LC_END);
+#endif
+
+  return iRetcode;
+}
+#endif /* MNG_SUPPORT_DISPLAY */
+
+/* ************************************************************************** */
+
 #ifdef MNG_SUPPORT_DISPLAY
 mng_retcode MNG_DECL mng_display_freeze (mng_handle hHandle)
 {
@@ -2607,6 +3052,9 @@ mng_retcode MNG_DECL mng_display_goframe (mng_handle hHandle,
 {
   mng_datap   pData;
   mng_retcode iRetcode;
+#ifdef MNG_SUPPORT_KEYFRAMES
+  mng_keyframep pKeyframe;
+#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_DISPLAY_GOFRAME, MNG_LC_START);
@@ -2632,6 +3080,22 @@ mng_retcode MNG_DECL mng_display_goframe (mng_handle hHandle,
 
   cleanup_errors (pData);              /* cleanup previous errors */
 
+#ifdef MNG_SUPPORT_KEYFRAMES           /* is there a keyframe on the way ? */
+  pKeyframe = mng_find_keyframe (pData, iFramenr, 0, 0);
+
+  if ((pKeyframe) &&
+      ((pData->iFrameseq > iFramenr) || (pKeyframe->iFrameseq > pData->iFrameseq)))
+  {
+    iRetcode = mng_reset_rundata (pData);
+
+    if (!iRetcode)                     /* then resume from there */
+      iRetcode = mng_restore_keyframe (pData, pKeyframe);
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+  }
+  else
+#endif
   if (pData->iFrameseq > iFramenr)     /* search from current or go back to start ? */
   {
     iRetcode = mng_reset_rundata (pData);
@@ -2644,8 +3108,11 @@ mng_retcode MNG_DECL mng_display_goframe (mng_handle hHandle,
     pData->iRequestframe = iFramenr;   /* go find the requested frame then */
     iRetcode = mng_process_display (pData);
 
-    if (iRetcode)                      /* on error bail out */
+    if (iRetcode)                      /* on error drop the half-done search */
+    {                                  /* so a retry starts from a clean slate */
+      mng_reset_rundata (pData);
       return iRetcode;
+    }
 
     pData->bTimerset = MNG_FALSE;      /* reset just to be safe */
   }
@@ -2668,6 +3135,9 @@ mng_retcode MNG_DECL mng_display_golayer (mng_handle hHandle,
 {
   mng_datap   pData;
   mng_retcode iRetcode;
+#ifdef MNG_SUPPORT_KEYFRAMES
+  mng_keyframep pKeyframe;
+#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_DISPLAY_GOLAYER, MNG_LC_START);
@@ -2693,6 +3163,22 @@ mng_retcode MNG_DECL mng_display_golayer (mng_handle hHandle,
 
   cleanup_errors (pData);              /* cleanup previous errors */
 
+#ifdef MNG_SUPPORT_KEYFRAMES           /* is there a keyframe on the way ? */
+  pKeyframe = mng_find_keyframe (pData, 0, iLayernr, 0);
+
+  if ((pKeyframe) &&
+      ((pData->iLayerseq > iLayernr) || (pKeyframe->iLayerseq > pData->iLayerseq)))
+  {
+    iRetcode = mng_reset_rundata (pData);
+
+    if (!iRetcode)                     /* then resume from there */
+      iRetcode = mng_restore_keyframe (pData, pKeyframe);
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+  }
+  else
+#endif
   if (pData->iLayerseq > iLayernr)     /* search from current or go back to start ? */
   {
     iRetcode = mng_reset_rundata (pData);
@@ -2705,8 +3191,11 @@ mng_retcode MNG_DECL mng_display_golayer (mng_handle hHandle,
     pData->iRequestlayer = iLayernr;   /* go find the requested layer then */
     iRetcode = mng_process_display (pData);
 
-    if (iRetcode)                      /* on error bail out */
+    if (iRetcode)                      /* on error drop the half-done search */
+    {                                  /* so a retry starts from a clean slate */
+      mng_reset_rundata (pData);
       return iRetcode;
+    }
 
     pData->bTimerset = MNG_FALSE;      /* reset just to be safe */
   }
@@ -2729,6 +3218,9 @@ mng_retcode MNG_DECL mng_display_gotime (mng_handle hHandle,
 {
   mng_datap   pData;
   mng_retcode iRetcode;
+#ifdef MNG_SUPPORT_KEYFRAMES
+  mng_keyframep pKeyframe;
+#endif
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (((mng_datap)hHandle), MNG_FN_DISPLAY_GOTIME, MNG_LC_START);
@@ -2754,6 +3246,22 @@ mng_retcode MNG_DECL mng_display_gotime (mng_handle hHandle,
 
   cleanup_errors (pData);              /* cleanup previous errors */
 
+#ifdef MNG_SUPPORT_KEYFRAMES           /* is there a keyframe on the way ? */
+  pKeyframe = mng_find_keyframe (pData, 0, 0, iPlaytime);
+
+  if ((pKeyframe) &&
+      ((pData->iFrametime > iPlaytime) || (pKeyframe->iFrametime > pData->iFrametime)))
+  {
+    iRetcode = mng_reset_rundata (pData);
+
+    if (!iRetcode)                     /* then resume from there */
+      iRetcode = mng_restore_keyframe (pData, pKeyframe);
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+  }
+  else
+#endif
   if (pData->iFrametime > iPlaytime)   /* search from current or go back to start ? */
   {
     iRetcode = mng_reset_rundata (pData);
@@ -2766,8 +3274,11 @@ mng_retcode MNG_DECL mng_display_gotime (mng_handle hHandle,
     pData->iRequesttime = iPlaytime;   /* go find the requested playtime then */
     iRetcode = mng_process_display (pData);
 
-    if (iRetcode)                      /* on error bail out */
+    if (iRetcode)                      /* on error drop the half-done search */
+    {                                  /* so a retry starts from a clean slate */
+      mng_reset_rundata (pData);
       return iRetcode;
+    }
 
     pData->bTimerset = MNG_FALSE;      /* reset just to be safe */
   }
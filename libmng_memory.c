@@ -0,0 +1,184 @@
+/* ************************************************************************** */
+/* *             For conditions of distribution and use,                    * */
+/* *                see copyright notice in libmng.h                        * */
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * project   : libmng                                                     * */
+/* * file      : libmng_memory.c           copyright (c) 2026               * */
+/* * version   : 1.0.11                                                     * */
+/* *                                                                        * */
+/* * purpose   : Memory management (implementation)                         * */
+/* *                                                                        * */
+/* * comment   : implementation of the memory-pool for chunk-structures     * */
+/* *             and animation-objects                                      * */
+/* *                                                                        * */
+/* * changes   : 1.0.11 - 10/17/2026                                        * */
+/* *             - initial version                                          * */
+/* *             - mng_release_mempool refuses while blocks are out         * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#include "libmng.h"
+#include "libmng_data.h"
+#include "libmng_error.h"
+#include "libmng_trace.h"
+#ifdef __BORLANDC__
+#pragma hdrstop
+#endif
+#include "libmng_memory.h"
+
+#if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
+#pragma option -A                      /* force ANSI-C */
+#endif
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_MEMPOOL
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Every pooled block starts with this header; while the block is handed  * */
+/* * out it holds the requested size, while it's free it links the block    * */
+/* * into the free-list of its size-class. The first header of a slab links * */
+/* * it into the list of slabs                                              * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+typedef union mng_poolhead_union {
+           union mng_poolhead_union *pNext;
+           mng_size_t        iSize;
+           mng_float         dAlign;             /* keeps the data aligned */
+        } mng_poolhead;
+typedef mng_poolhead * mng_poolheadp;
+
+#define MNG_POOLCLASS(S) (((S) + MNG_POOLGRANULE - 1) / MNG_POOLGRANULE - 1)
+
+/* ************************************************************************** */
+
+mng_ptr mng_pool_alloc (mng_datap  pData,
+                        mng_size_t iSize)
+{
+  mng_poolheadp pBlock;
+  mng_uint8p    pSlab;
+  mng_size_t    iClass     = MNG_POOLCLASS (iSize);
+  mng_size_t    iBlocksize = sizeof (mng_poolhead) + (iClass + 1) * MNG_POOLGRANULE;
+
+  if ((!iSize) || (iClass >= MNG_POOLCLASSES))
+  {                                    /* not a pool size; get it separately */
+    MNG_ALLOCX (pData, pBlock, sizeof (mng_poolhead) + iSize);
+
+    if (!pBlock)
+      return MNG_NULL;
+  }
+  else
+  if (pData->aPoolfree [iClass])       /* one of this size freed before ? */
+  {
+    pBlock = (mng_poolheadp)pData->aPoolfree [iClass];
+    pData->aPoolfree [iClass] = (mng_ptr)pBlock->pNext;
+                                       /* memalloc hands out zeroed memory */
+    memset ((mng_ptr)(pBlock + 1), 0, iSize);
+  }
+  else
+  {
+    if (pData->iPoolleft < iBlocksize) /* newest slab used up ? */
+    {
+      MNG_ALLOCX (pData, pSlab, MNG_POOLSLABSIZE);
+
+      if (!pSlab)
+        return MNG_NULL;
+                                       /* link it in front */
+      ((mng_poolheadp)pSlab)->pNext = (mng_poolheadp)pData->pPoolslabs;
+      pData->pPoolslabs = (mng_ptr)pSlab;
+      pData->pPoolnext  = pSlab + sizeof (mng_poolhead);
+      pData->iPoolleft  = MNG_POOLSLABSIZE - sizeof (mng_poolhead);
+    }
+                                       /* carve the block from it */
+    pBlock            = (mng_poolheadp)pData->pPoolnext;
+    pData->pPoolnext += iBlocksize;
+    pData->iPoolleft -= (mng_uint32)iBlocksize;
+  }
+
+  pBlock->iSize        = iSize;
+  pData->iPoolcurrent += (mng_uint32)iSize;
+
+  if (pData->iPoolcurrent > pData->iPoolpeak)
+    pData->iPoolpeak = pData->iPoolcurrent;
+
+  return (mng_ptr)(pBlock + 1);
+}
+
+/* ************************************************************************** */
+
+void mng_pool_free (mng_datap pData,
+                    mng_ptr   pBuf)
+{
+  mng_poolheadp pBlock = (mng_poolheadp)pBuf - 1;
+  mng_size_t    iSize  = pBlock->iSize;
+  mng_size_t    iClass = MNG_POOLCLASS (iSize);
+
+  pData->iPoolcurrent -= (mng_uint32)iSize;
+
+  if ((!iSize) || (iClass >= MNG_POOLCLASSES))
+  {                                    /* it was allocated separately */
+    MNG_FREEX (pData, pBlock, sizeof (mng_poolhead) + iSize);
+  }
+  else
+  {                                    /* keep it for the next one */
+    pBlock->pNext             = (mng_poolheadp)pData->aPoolfree [iClass];
+    pData->aPoolfree [iClass] = (mng_ptr)pBlock;
+  }
+
+  return;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_release_mempool (mng_datap pData)
+{
+  mng_poolheadp pSlab;
+  mng_poolheadp pNext;
+  mng_uint32    iX;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_RELEASE_MEMPOOL, MNG_LC_START);
+#endif
+                                       /* anything still handed out (from a
+                                          slab or separately) ? then the pool
+                                          stays as it is, so those blocks and
+                                          the counters stay valid for
+                                          mng_pool_free (no MNG_ERROR here; an
+                                          errorproc could make it carry on) */
+  if (pData->iPoolcurrent)
+    return MNG_FUNCTIONINVALID;
+                                       /* give back all the slabs at once */
+  pSlab = (mng_poolheadp)pData->pPoolslabs;
+
+  while (pSlab)
+  {
+    pNext = pSlab->pNext;
+    MNG_FREEX (pData, pSlab, MNG_POOLSLABSIZE);
+    pSlab = pNext;
+  }
+
+  pData->pPoolslabs   = MNG_NULL;
+  pData->pPoolnext    = MNG_NULL;
+  pData->iPoolleft    = 0;
+
+  for (iX = 0; iX < MNG_POOLCLASSES; iX++)
+    pData->aPoolfree [iX] = MNG_NULL;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_RELEASE_MEMPOOL, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+#endif /* MNG_SUPPORT_MEMPOOL */
+
+/* ************************************************************************** */
+/* * end of file                                                            * */
+/* ************************************************************************** */
+
@@ -24,6 +24,9 @@
 /* *             0.9.2 - 08/05/2000 - G.Juyn                                * */
 /* *             - changed file-prefixes                                    * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added pooled variants & memory-pool functions            * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -55,6 +58,31 @@
 
 #define MNG_COPY(D,S,L)   { memcpy (D, S, (mng_size_t)(L)); }
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Pooled variants for chunk-structures & animation-objects; these go     * */
+/* * through the memory-pool when it is switched on                         * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_MEMPOOL
+#define MNG_ALLOCP(H,P,L) { if (H->bMempool) \
+                            { P = mng_pool_alloc (H, (mng_size_t)(L)); \
+                              if (P == 0) { MNG_ERROR (H, MNG_OUTOFMEMORY) } } \
+                            else MNG_ALLOC (H,P,L) }
+#define MNG_FREEP(H,P,L)  { if (H->bMempool) { if (P) mng_pool_free (H, P); } \
+                            else MNG_FREEX (H,P,L) }
+
+mng_ptr     mng_pool_alloc      (mng_datap  pData,
+                                 mng_size_t iSize);
+void        mng_pool_free       (mng_datap  pData,
+                                 mng_ptr    pBuf);
+mng_retcode mng_release_mempool (mng_datap  pData);
+#else
+#define MNG_ALLOCP(H,P,L) MNG_ALLOC (H,P,L)
+#define MNG_FREEP(H,P,L)  MNG_FREEX (H,P,L)
+#endif
+
 /* ************************************************************************** */
 
 #endif /* _libmng_memory_h_ */
@@ -147,6 +147,22 @@
 /* *             1.0.10 - 04/12/2007 - G.Juyn                               * */
 /* *             - added support for ANG proposal                           * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - fixed dangling row-buffers after color-correcting an     * */
+/* *               object                                                   * */
+/* *             - added an id-index (hashed buckets) so                    * */
+/* *               mng_find_imageobject doesn't walk the whole object-list  * */
+/* *             - animation-objects are allocated from the memory-pool     * */
+/* *               when on; images are not                                  * */
+/* *             - no settimer call for events on the virtual clock         * */
+/* *             - split mng_magnify_size & mng_magnify_routines from       * */
+/* *               mng_magnify_imageobject; identical rows are copied       * */
+/* *             - the last MAGN interval is sized with ML again; rows      * */
+/* *               past the buffer are not written                          * */
+/* *             - the last MAGN interval (method-Y 1) is sized with MB, as * */
+/* *               the MNG spec defines MB (bottom Y-factor)                * */
+/* *             - magnifying drops the new buffer if the temp-row fails    * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -221,7 +237,7 @@ MNG_LOCAL mng_retcode create_obj_general (mng_datap          pData,
 {
   mng_object_headerp pWork;
 
-  MNG_ALLOC (pData, pWork, iObjsize);
+  MNG_ALLOCP (pData, pWork, iObjsize);
 
   pWork->fCleanup = fCleanup;
   pWork->fProcess = fProcess;
@@ -236,7 +252,7 @@ MNG_LOCAL mng_retcode create_obj_general (mng_datap          pData,
 MNG_LOCAL mng_retcode mng_free_obj_general (mng_datap   pData,
                                             mng_objectp pObject)
 {
-  MNG_FREEX (pData, pObject, ((mng_object_headerp)pObject)->iObjsize);
+  MNG_FREEP (pData, pObject, ((mng_object_headerp)pObject)->iObjsize);
   return MNG_NOERROR;
 }
 #endif
@@ -267,22 +283,13 @@ mng_retcode mng_create_imagedataobject (mng_datap      pData,
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_CREATE_IMGDATAOBJECT, MNG_LC_START);
 #endif
-                                       /* get a buffer */
-#ifdef MNG_OPTIMIZE_OBJCLEANUP
-  {
-    mng_ptr pTemp;
-    mng_retcode iRetcode = create_obj_general (pData, sizeof (mng_imagedata),
-                                               (mng_cleanupobject)mng_free_imagedataobject,
-                                               MNG_NULL, &pTemp);
-    if (iRetcode)
-      return iRetcode;
-    pImagedata = (mng_imagedatap)pTemp;
-  }
-#else
+                                       /* get a buffer (images aren't pooled) */
   MNG_ALLOC (pData, pImagedata, sizeof (mng_imagedata));
                                        /* fill the appropriate fields */
   pImagedata->sHeader.fCleanup   = (mng_cleanupobject)mng_free_imagedataobject;
   pImagedata->sHeader.fProcess   = MNG_NULL;
+#ifdef MNG_OPTIMIZE_OBJCLEANUP
+  pImagedata->sHeader.iObjsize   = sizeof (mng_imagedata);
 #endif
   pImagedata->iRefcount          = 1;
   pImagedata->bFrozen            = MNG_FALSE;
@@ -537,6 +544,78 @@ mng_retcode mng_clone_imagedataobject  (mng_datap      pData,
 /* *                                                                        * */
 /* ************************************************************************** */
 
+#define MNG_OBJINDEX(I) ((I) & (MNG_OBJINDEXSIZE - 1))
+
+/* ************************************************************************** */
+
+MNG_LOCAL void index_imageobject (mng_datap  pData,
+                                  mng_imagep pImage)
+{                                      /* append to the end of its bucket, so
+                                          equal ids stay in list-order */
+  mng_objectp *ppLink = &pData->aObjindex [MNG_OBJINDEX (pImage->iId)];
+
+  while (*ppLink)
+    ppLink = &((mng_imagep)*ppLink)->pIndexnext;
+
+  *ppLink            = (mng_objectp)pImage;
+  pImage->pIndexnext = MNG_NULL;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_unindex_imageobject (mng_datap  pData,
+                                     mng_imagep pImage)
+{
+  mng_objectp *ppLink = &pData->aObjindex [MNG_OBJINDEX (pImage->iId)];
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_UNINDEX_IMGOBJECT, MNG_LC_START);
+#endif
+
+  while ((*ppLink) && (*ppLink != (mng_objectp)pImage))
+    ppLink = &((mng_imagep)*ppLink)->pIndexnext;
+
+  if (*ppLink)                         /* found it ? then take it out */
+    *ppLink = pImage->pIndexnext;
+
+  pImage->pIndexnext = MNG_NULL;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_UNINDEX_IMGOBJECT, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_reindex_imageobjects (mng_datap pData)
+{                                      /* after the list was replaced in one go */
+  mng_imagep pImage = (mng_imagep)pData->pFirstimgobj;
+  mng_uint32 iX;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_REINDEX_IMGOBJECTS, MNG_LC_START);
+#endif
+
+  for (iX = 0; iX < MNG_OBJINDEXSIZE; iX++)
+    pData->aObjindex [iX] = MNG_NULL;
+
+  while (pImage)
+  {
+    index_imageobject (pData, pImage);
+    pImage = (mng_imagep)pImage->sHeader.pNext;
+  }
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_REINDEX_IMGOBJECTS, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
 mng_retcode mng_create_imageobject (mng_datap  pData,
                                     mng_uint16 iId,
                                     mng_bool   bConcrete,
@@ -640,7 +719,8 @@ mng_retcode mng_create_imageobject (mng_datap  pData,
       pNext->sHeader.pPrev  = pImage;
     else
       pData->pLastimgobj    = pImage;
-    
+
+    index_imageobject (pData, pImage); /* and make it quick to find */
   }  
 
   *ppObject = pImage;                  /* and return the new buffer */
@@ -678,6 +758,7 @@ mng_retcode mng_free_imageobject (mng_datap  pData,
     else
       pData->pLastimgobj   = pImage->sHeader.pPrev;
 
+    mng_unindex_imageobject (pData, pImage);
   }
                                        /* unlink the image-data buffer */
   iRetcode = mng_free_imagedataobject (pData, pImgbuf);
@@ -696,14 +777,19 @@ mng_retcode mng_free_imageobject (mng_datap  pData,
 mng_imagep mng_find_imageobject (mng_datap  pData,
                                  mng_uint16 iId)
 {
-  mng_imagep pImage = (mng_imagep)pData->pFirstimgobj;
+  mng_imagep pImage = MNG_NULL;
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACEX (pData, MNG_FN_FIND_IMGOBJECT, MNG_LC_START);
 #endif
-                                       /* look up the right id */
-  while ((pImage) && (pImage->iId != iId))
-    pImage = (mng_imagep)pImage->sHeader.pNext;
+
+  if (iId)                             /* object 0 isn't in the list */
+  {                                    /* look up the right id */
+    pImage = (mng_imagep)pData->aObjindex [MNG_OBJINDEX (iId)];
+
+    while ((pImage) && (pImage->iId != iId))
+      pImage = (mng_imagep)pImage->pIndexnext;
+  }
 
 #ifdef MNG_INCLUDE_MPNG_PROPOSAL
   if ((!pImage) && (pData->eImagetype == mng_it_mpng))
@@ -750,22 +836,13 @@ mng_retcode mng_clone_imageobject (mng_datap  pData,
       return iRetcode;
   }
 #endif
-                                       /* get a buffer */
-#ifdef MNG_OPTIMIZE_OBJCLEANUP
-  {
-    mng_ptr     pTemp;
-    mng_retcode iRetcode = create_obj_general (pData, sizeof (mng_image),
-                                               (mng_cleanupobject)mng_free_imageobject,
-                                               MNG_NULL, &pTemp);
-    if (iRetcode)
-      return iRetcode;
-    pNew = (mng_imagep)pTemp;
-  }
-#else
+                                       /* get a buffer (images aren't pooled) */
   MNG_ALLOC (pData, pNew, sizeof (mng_image));
                                        /* fill or copy the appropriate fields */
   pNew->sHeader.fCleanup = (mng_cleanupobject)mng_free_imageobject;
   pNew->sHeader.fProcess = MNG_NULL;
+#ifdef MNG_OPTIMIZE_OBJCLEANUP
+  pNew->sHeader.iObjsize = sizeof (mng_image);
 #endif
   pNew->iId              = iId;
   pNew->bFrozen          = MNG_FALSE;
@@ -839,6 +916,7 @@ mng_retcode mng_clone_imageobject (mng_datap  pData,
     else
       pData->pLastimgobj   = pNew;
 
+    index_imageobject (pData, pNew);   /* and make it quick to find */
   }
 
   if (bPartial)                        /* partial clone ? */
@@ -907,6 +985,9 @@ mng_retcode mng_renum_imageobject (mng_datap  pData,
     }
   }
 
+  if (pSource->iId)                    /* drop it from the id-index */
+    mng_unindex_imageobject (pData, pSource);
+
   if (iId)                             /* not for object 0 */
   {                                    /* find previous lower object-id */
     pPrev = (mng_imagep)pData->pLastimgobj;
@@ -949,6 +1030,9 @@ mng_retcode mng_renum_imageobject (mng_datap  pData,
 
   pSource->iId = iId;                  /* now set the new id! */
 
+  if (iId)                             /* and index it again */
+    index_imageobject (pData, pSource);
+
   if (bAbstract)                       /* force it to abstract ? */
     pSource->pImgbuf->bConcrete = MNG_FALSE;
 
@@ -1797,142 +1881,126 @@ mng_retcode mng_promote_imageobject (mng_datap  pData,
 /* ************************************************************************** */
 
 #ifndef MNG_SKIPCHUNK_MAGN
-mng_retcode mng_magnify_imageobject (mng_datap  pData,
-                                     mng_imagep pImage)
+void mng_magnify_size (mng_imagep  pImage,
+                       mng_uint32p piWidth,
+                       mng_uint32p piHeight)
 {
-  mng_uint8p     pNewdata;
-  mng_uint8p     pSrcline1;
-  mng_uint8p     pSrcline2;
-  mng_uint8p     pTempline;
-  mng_uint8p     pDstline;
-  mng_uint32     iNewrowsize;
-  mng_uint32     iNewsize;
-  mng_uint32     iY;
-  mng_int32      iS, iM;
-  mng_retcode    iRetcode;
-
-  mng_imagedatap pBuf      = pImage->pImgbuf;
-  mng_uint32     iNewW     = pBuf->iWidth;
-  mng_uint32     iNewH     = pBuf->iHeight;
-  mng_magnify_x  fMagnifyX = MNG_NULL;
-  mng_magnify_y  fMagnifyY = MNG_NULL;
-
-#ifdef MNG_SUPPORT_TRACE
-  MNG_TRACE (pData, MNG_FN_MAGNIFY_IMGOBJECT, MNG_LC_START);
-#endif
-
-  if (pBuf->iColortype == MNG_COLORTYPE_INDEXED)           /* indexed color ? */
-  {                                    /* concrete buffer ? */
-    if ((pBuf->bConcrete) && (pImage->iId))
-      MNG_ERROR (pData, MNG_INVALIDCOLORTYPE);
-
-#ifndef MNG_OPTIMIZE_FOOTPRINT_MAGN
-    if (pBuf->iTRNScount)              /* with transparency ? */
-      iRetcode = mng_promote_imageobject (pData, pImage, 8, 6, 0);
-    else
-      iRetcode = mng_promote_imageobject (pData, pImage, 8, 2, 0);
-
-    if (iRetcode)                      /* on error bail out */
-      return iRetcode;
-#endif
-  }
-
-#ifdef MNG_OPTIMIZE_FOOTPRINT_MAGN
-  /* Promote everything to RGBA, using fill method 0 (LBR) */
-  iRetcode = mng_promote_imageobject (pData, pImage, 8, 6, 0);           
-  if (iRetcode)                      /* on error bail out */
-    return iRetcode;
-#endif
+  mng_uint32 iW    = pImage->pImgbuf->iWidth;
+  mng_uint32 iH    = pImage->pImgbuf->iHeight;
+  mng_uint32 iNewW = iW;
+  mng_uint32 iNewH = iH;
+                                       /* a zero factor still leaves the
+                                          original pixel in place */
+  mng_uint32 iMX   = (pImage->iMAGN_MX ? pImage->iMAGN_MX : 1);
+  mng_uint32 iMY   = (pImage->iMAGN_MY ? pImage->iMAGN_MY : 1);
+  mng_uint32 iML   = (pImage->iMAGN_ML ? pImage->iMAGN_ML : 1);
+  mng_uint32 iMR   = (pImage->iMAGN_MR ? pImage->iMAGN_MR : 1);
+  mng_uint32 iMT   = (pImage->iMAGN_MT ? pImage->iMAGN_MT : 1);
+  mng_uint32 iMB   = (pImage->iMAGN_MB ? pImage->iMAGN_MB : 1);
 
   if (pImage->iMAGN_MethodX)           /* determine new width */
   {
     if (pImage->iMAGN_MethodX == 1)
     {
-      iNewW   = pImage->iMAGN_ML;
-      if (pBuf->iWidth  > 1)
-        iNewW = iNewW + pImage->iMAGN_MR;
-      if (pBuf->iWidth  > 2)
-        iNewW = iNewW + (pBuf->iWidth  - 2) * (pImage->iMAGN_MX);
+      iNewW   = iML;
+      if (iW > 1)
+        iNewW = iNewW + iMR;
+      if (iW > 2)
+        iNewW = iNewW + (iW - 2) * iMX;
     }
     else
     {
-      iNewW   = pBuf->iWidth  + pImage->iMAGN_ML - 1;
-      if (pBuf->iWidth  > 2)
-        iNewW = iNewW + pImage->iMAGN_MR - 1;
-      if (pBuf->iWidth  > 3)
-        iNewW = iNewW + (pBuf->iWidth  - 3) * (pImage->iMAGN_MX - 1);
+      iNewW   = iW + iML - 1;
+      if (iW > 2)
+        iNewW = iNewW + iMR - 1;
+      if (iW > 3)
+        iNewW = iNewW + (iW - 3) * (iMX - 1);
     }
   }
 
   if (pImage->iMAGN_MethodY)           /* determine new height */
   {
     if (pImage->iMAGN_MethodY == 1)
-    {
-      iNewH   = pImage->iMAGN_MT;
-      if (pBuf->iHeight > 1)
-        iNewH = iNewH + pImage->iMAGN_ML;
-      if (pBuf->iHeight > 2)
-        iNewH = iNewH + (pBuf->iHeight - 2) * (pImage->iMAGN_MY);
+    {                                  /* MT for the top, MB for the bottom */
+      iNewH   = iMT;
+      if (iH > 1)
+        iNewH = iNewH + iMB;
+      if (iH > 2)
+        iNewH = iNewH + (iH - 2) * iMY;
     }
     else
     {
-      iNewH   = pBuf->iHeight + pImage->iMAGN_MT - 1;
-      if (pBuf->iHeight > 2)
-        iNewH = iNewH + pImage->iMAGN_MB - 1;
-      if (pBuf->iHeight > 3)
-        iNewH = iNewH + (pBuf->iHeight - 3) * (pImage->iMAGN_MY - 1);
+      iNewH   = iH + iMT - 1;
+      if (iH > 2)
+        iNewH = iNewH + iMB - 1;
+      if (iH > 3)
+        iNewH = iNewH + (iH - 3) * (iMY - 1);
     }
   }
-                                       /* get new buffer */
-  iNewrowsize  = iNewW * pBuf->iSamplesize;
-  iNewsize     = iNewH * iNewrowsize;
 
-  MNG_ALLOC (pData, pNewdata, iNewsize);
+  *piWidth  = iNewW;
+  *piHeight = iNewH;
 
-  switch (pBuf->iColortype)            /* determine magnification routines */
+  return;
+}
+
+/* ************************************************************************** */
+
+void mng_magnify_routines (mng_datap      pData,
+                           mng_uint8      iColortype,
+                           mng_uint8      iBitdepth,
+                           mng_uint8      iMethodX,
+                           mng_uint8      iMethodY,
+                           mng_magnify_x *pfMagnifyX,
+                           mng_magnify_y *pfMagnifyY)
+{
+  *pfMagnifyX = MNG_NULL;
+  *pfMagnifyY = MNG_NULL;
+
+  switch (iColortype)
   {
 #ifndef MNG_OPTIMIZE_FOOTPRINT_MAGN
     case  0 : ;
     case  8 : {
-                if (pBuf->iBitdepth <= 8)
+                if (iBitdepth <= 8)
                 {
-                  switch (pImage->iMAGN_MethodX)
+                  switch (iMethodX)
                   {
-                    case 1  : { fMagnifyX = mng_magnify_g8_x1; break; }
-                    case 2  : { fMagnifyX = mng_magnify_g8_x2; break; }
-                    case 3  : { fMagnifyX = mng_magnify_g8_x3; break; }
-                    case 4  : { fMagnifyX = mng_magnify_g8_x2; break; }
-                    case 5  : { fMagnifyX = mng_magnify_g8_x3; break; }
+                    case 1  : { *pfMagnifyX = mng_magnify_g8_x1; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_g8_x2; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_g8_x3; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_g8_x2; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_g8_x3; break; }
                   }
 
-                  switch (pImage->iMAGN_MethodY)
+                  switch (iMethodY)
                   {
-                    case 1  : { fMagnifyY = mng_magnify_g8_y1; break; }
-                    case 2  : { fMagnifyY = mng_magnify_g8_y2; break; }
-                    case 3  : { fMagnifyY = mng_magnify_g8_y3; break; }
-                    case 4  : { fMagnifyY = mng_magnify_g8_y2; break; }
-                    case 5  : { fMagnifyY = mng_magnify_g8_y3; break; }
+                    case 1  : { *pfMagnifyY = mng_magnify_g8_y1; break; }
+                    case 2  : { *pfMagnifyY = mng_magnify_g8_y2; break; }
+                    case 3  : { *pfMagnifyY = mng_magnify_g8_y3; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_g8_y2; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_g8_y3; break; }
                   }
                 }
 #ifndef MNG_NO_16BIT_SUPPORT
                 else
                 {
-                  switch (pImage->iMAGN_MethodX)
+                  switch (iMethodX)
                   {
-                    case 1  : { fMagnifyX = mng_magnify_g16_x1; break; }
-                    case 2  : { fMagnifyX = mng_magnify_g16_x2; break; }
-                    case 3  : { fMagnifyX = mng_magnify_g16_x3; break; }
-                    case 4  : { fMagnifyX = mng_magnify_g16_x2; break; }
-                    case 5  : { fMagnifyX = mng_magnify_g16_x3; break; }
+                    case 1  : { *pfMagnifyX = mng_magnify_g16_x1; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_g16_x2; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_g16_x3; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_g16_x2; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_g16_x3; break; }
                   }
 
-                  switch (pImage->iMAGN_MethodY)
+                  switch (iMethodY)
                   {
-                    case 1  : { fMagnifyY = mng_magnify_g16_y1; break; }
-                    case 2  : { fMagnifyY = mng_magnify_g16_y2; break; }
-                    case 3  : { fMagnifyY = mng_magnify_g16_y3; break; }
-                    case 4  : { fMagnifyY = mng_magnify_g16_y2; break; }
-                    case 5  : { fMagnifyY = mng_magnify_g16_y3; break; }
+                    case 1  : { *pfMagnifyY = mng_magnify_g16_y1; break; }
+                    case 2  : { *pfMagnifyY = mng_magnify_g16_y2; break; }
+                    case 3  : { *pfMagnifyY = mng_magnify_g16_y3; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_g16_y2; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_g16_y3; break; }
                   }
                 }
 #endif
@@ -1942,45 +2010,45 @@ mng_retcode mng_magnify_imageobject (mng_datap  pData,
 
     case  2 : ;
     case 10 : {
-                if (pBuf->iBitdepth <= 8)
+                if (iBitdepth <= 8)
                 {
-                  switch (pImage->iMAGN_MethodX)
+                  switch (iMethodX)
                   {
-                    case 1  : { fMagnifyX = mng_magnify_rgb8_x1; break; }
-                    case 2  : { fMagnifyX = mng_magnify_rgb8_x2; break; }
-                    case 3  : { fMagnifyX = mng_magnify_rgb8_x3; break; }
-                    case 4  : { fMagnifyX = mng_magnify_rgb8_x2; break; }
-                    case 5  : { fMagnifyX = mng_magnify_rgb8_x3; break; }
+                    case 1  : { *pfMagnifyX = mng_magnify_rgb8_x1; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_rgb8_x2; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_rgb8_x3; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_rgb8_x2; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_rgb8_x3; break; }
                   }
 
-                  switch (pImage->iMAGN_MethodY)
+                  switch (iMethodY)
                   {
-                    case 1  : { fMagnifyY = mng_magnify_rgb8_y1; break; }
-                    case 2  : { fMagnifyY = mng_magnify_rgb8_y2; break; }
-                    case 3  : { fMagnifyY = mng_magnify_rgb8_y3; break; }
-                    case 4  : { fMagnifyY = mng_magnify_rgb8_y2; break; }
-                    case 5  : { fMagnifyY = mng_magnify_rgb8_y3; break; }
+                    case 1  : { *pfMagnifyY = mng_magnify_rgb8_y1; break; }
+                    case 2  : { *pfMagnifyY = mng_magnify_rgb8_y2; break; }
+                    case 3  : { *pfMagnifyY = mng_magnify_rgb8_y3; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_rgb8_y2; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_rgb8_y3; break; }
                   }
                 }
 #ifndef MNG_NO_16BIT_SUPPORT
                 else
                 {
-                  switch (pImage->iMAGN_MethodX)
+                  switch (iMethodX)
                   {
-                    case 1  : { fMagnifyX = mng_magnify_rgb16_x1; break; }
-                    case 2  : { fMagnifyX = mng_magnify_rgb16_x2; break; }
-                    case 3  : { fMagnifyX = mng_magnify_rgb16_x3; break; }
-                    case 4  : { fMagnifyX = mng_magnify_rgb16_x2; break; }
-                    case 5  : { fMagnifyX = mng_magnify_rgb16_x3; break; }
+                    case 1  : { *pfMagnifyX = mng_magnify_rgb16_x1; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_rgb16_x2; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_rgb16_x3; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_rgb16_x2; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_rgb16_x3; break; }
                   }
 
-                  switch (pImage->iMAGN_MethodY)
+                  switch (iMethodY)
                   {
-                    case 1  : { fMagnifyY = mng_magnify_rgb16_y1; break; }
-                    case 2  : { fMagnifyY = mng_magnify_rgb16_y2; break; }
-                    case 3  : { fMagnifyY = mng_magnify_rgb16_y3; break; }
-                    case 4  : { fMagnifyY = mng_magnify_rgb16_y2; break; }
-                    case 5  : { fMagnifyY = mng_magnify_rgb16_y3; break; }
+                    case 1  : { *pfMagnifyY = mng_magnify_rgb16_y1; break; }
+                    case 2  : { *pfMagnifyY = mng_magnify_rgb16_y2; break; }
+                    case 3  : { *pfMagnifyY = mng_magnify_rgb16_y3; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_rgb16_y2; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_rgb16_y3; break; }
                   }
                 }
 #endif
@@ -1990,45 +2058,45 @@ mng_retcode mng_magnify_imageobject (mng_datap  pData,
 
     case  4 : ;
     case 12 : {
-                if (pBuf->iBitdepth <= 8)
+                if (iBitdepth <= 8)
                 {
-                  switch (pImage->iMAGN_MethodX)
+                  switch (iMethodX)
                   {
-                    case 1  : { fMagnifyX = mng_magnify_ga8_x1; break; }
-                    case 2  : { fMagnifyX = mng_magnify_ga8_x2; break; }
-                    case 3  : { fMagnifyX = mng_magnify_ga8_x3; break; }
-                    case 4  : { fMagnifyX = mng_magnify_ga8_x4; break; }
-                    case 5  : { fMagnifyX = mng_magnify_ga8_x5; break; }
+                    case 1  : { *pfMagnifyX = mng_magnify_ga8_x1; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_ga8_x2; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_ga8_x3; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_ga8_x4; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_ga8_x5; break; }
                   }
 
-                  switch (pImage->iMAGN_MethodY)
+                  switch (iMethodY)
                   {
-                    case 1  : { fMagnifyY = mng_magnify_ga8_y1; break; }
-                    case 2  : { fMagnifyY = mng_magnify_ga8_y2; break; }
-                    case 3  : { fMagnifyY = mng_magnify_ga8_y3; break; }
-                    case 4  : { fMagnifyY = mng_magnify_ga8_y4; break; }
-                    case 5  : { fMagnifyY = mng_magnify_ga8_y5; break; }
+                    case 1  : { *pfMagnifyY = mng_magnify_ga8_y1; break; }
+                    case 2  : { *pfMagnifyY = mng_magnify_ga8_y2; break; }
+                    case 3  : { *pfMagnifyY = mng_magnify_ga8_y3; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_ga8_y4; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_ga8_y5; break; }
                   }
                 }
 #ifndef MNG_NO_16BIT_SUPPORT
                 else
                 {
-                  switch (pImage->iMAGN_MethodX)
+                  switch (iMethodX)
                   {
-                    case 1  : { fMagnifyX = mng_magnify_ga16_x1; break; }
-                    case 2  : { fMagnifyX = mng_magnify_ga16_x2; break; }
-                    case 3  : { fMagnifyX = mng_magnify_ga16_x3; break; }
-                    case 4  : { fMagnifyX = mng_magnify_ga16_x4; break; }
-                    case 5  : { fMagnifyX = mng_magnify_ga16_x5; break; }
+                    case 1  : { *pfMagnifyX = mng_magnify_ga16_x1; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_ga16_x2; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_ga16_x3; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_ga16_x4; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_ga16_x5; break; }
                   }
 
-                  switch (pImage->iMAGN_MethodY)
+                  switch (iMethodY)
                   {
-                    case 1  : { fMagnifyY = mng_magnify_ga16_y1; break; }
-                    case 2  : { fMagnifyY = mng_magnify_ga16_y2; break; }
-                    case 3  : { fMagnifyY = mng_magnify_ga16_y3; break; }
-                    case 4  : { fMagnifyY = mng_magnify_ga16_y4; break; }
-                    case 5  : { fMagnifyY = mng_magnify_ga16_y5; break; }
+                    case 1  : { *pfMagnifyY = mng_magnify_ga16_y1; break; }
+                    case 2  : { *pfMagnifyY = mng_magnify_ga16_y2; break; }
+                    case 3  : { *pfMagnifyY = mng_magnify_ga16_y3; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_ga16_y4; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_ga16_y5; break; }
                   }
                 }
 #endif
@@ -2039,46 +2107,46 @@ mng_retcode mng_magnify_imageobject (mng_datap  pData,
 
     case  6 : ;
     case 14 : {
-                if (pBuf->iBitdepth <= 8)
+                if (iBitdepth <= 8)
                 {
-                  switch (pImage->iMAGN_MethodX)
+                  switch (iMethodX)
                   {
-                    case 1  : { fMagnifyX = mng_magnify_rgba8_x1; break; }
-                    case 2  : { fMagnifyX = mng_magnify_rgba8_x2; break; }
-                    case 3  : { fMagnifyX = mng_magnify_rgba8_x3; break; }
-                    case 4  : { fMagnifyX = mng_magnify_rgba8_x4; break; }
-                    case 5  : { fMagnifyX = mng_magnify_rgba8_x5; break; }
+                    case 1  : { *pfMagnifyX = mng_magnify_rgba8_x1; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_rgba8_x2; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_rgba8_x3; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_rgba8_x4; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_rgba8_x5; break; }
                   }
 
-                  switch (pImage->iMAGN_MethodY)
+                  switch (iMethodY)
                   {
-                    case 1  : { fMagnifyY = mng_magnify_rgba8_y1; break; }
-                    case 2  : { fMagnifyY = mng_magnify_rgba8_y2; break; }
-                    case 3  : { fMagnifyY = mng_magnify_rgba8_y3; break; }
-                    case 4  : { fMagnifyY = mng_magnify_rgba8_y4; break; }
-                    case 5  : { fMagnifyY = mng_magnify_rgba8_y5; break; }
+                    case 1  : { *pfMagnifyY = mng_magnify_rgba8_y1; break; }
+                    case 2  : { *pfMagnifyY = mng_magnify_rgba8_y2; break; }
+                    case 3  : { *pfMagnifyY = mng_magnify_rgba8_y3; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_rgba8_y4; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_rgba8_y5; break; }
                   }
                 }
 #ifndef MNG_NO_16BIT_SUPPORT
 #ifndef MNG_OPTIMIZE_FOOTPRINT_MAGN
                 else
                 {
-                  switch (pImage->iMAGN_MethodX)
+                  switch (iMethodX)
                   {
-                    case 1  : { fMagnifyX = mng_magnify_rgba16_x1; break; }
-                    case 2  : { fMagnifyX = mng_magnify_rgba16_x2; break; }
-                    case 3  : { fMagnifyX = mng_magnify_rgba16_x3; break; }
-                    case 4  : { fMagnifyX = mng_magnify_rgba16_x4; break; }
-                    case 5  : { fMagnifyX = mng_magnify_rgba16_x5; break; }
+                    case 1  : { *pfMagnifyX = mng_magnify_rgba16_x1; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_rgba16_x2; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_rgba16_x3; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_rgba16_x4; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_rgba16_x5; break; }
                   }
 
-                  switch (pImage->iMAGN_MethodY)
+                  switch (iMethodY)
                   {
-                    case 1  : { fMagnifyY = mng_magnify_rgba16_y1; break; }
-                    case 2  : { fMagnifyY = mng_magnify_rgba16_y2; break; }
-                    case 3  : { fMagnifyY = mng_magnify_rgba16_y3; break; }
-                    case 4  : { fMagnifyY = mng_magnify_rgba16_y4; break; }
-                    case 5  : { fMagnifyY = mng_magnify_rgba16_y5; break; }
+                    case 1  : { *pfMagnifyY = mng_magnify_rgba16_y1; break; }
+                    case 2  : { *pfMagnifyY = mng_magnify_rgba16_y2; break; }
+                    case 3  : { *pfMagnifyY = mng_magnify_rgba16_y3; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_rgba16_y4; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_rgba16_y5; break; }
                   }
                 }
 #endif
@@ -2087,10 +2155,159 @@ mng_retcode mng_magnify_imageobject (mng_datap  pData,
               }
   }
 
+#ifdef MNG_INCLUDE_SIMD_MAGN           /* vectorized ones available ? */
+  if ((pData->iSIMDflags & (MNG_SIMD_SSE2 | MNG_SIMD_NEON)) && (iBitdepth <= 8))
+  {
+    switch (iColortype)
+    {
+#ifndef MNG_OPTIMIZE_FOOTPRINT_MAGN
+#ifndef MNG_NO_GRAY_SUPPORT
+      case  0 : ;
+      case  8 : {
+                  switch (iMethodX)
+                  {
+                    case 1  : { *pfMagnifyX = mng_magnify_g8_x1_simd; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_g8_x2_simd; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_g8_x3_simd; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_g8_x2_simd; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_g8_x3_simd; break; }
+                  }
+
+                  switch (iMethodY)
+                  {
+                    case 2  : { *pfMagnifyY = mng_magnify_g8_y2_simd; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_g8_y2_simd; break; }
+                  }
+
+                  break;
+                }
+
+      case  4 : ;
+      case 12 : {
+                  switch (iMethodX)
+                  {
+                    case 1  : { *pfMagnifyX = mng_magnify_ga8_x1_simd; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_ga8_x2_simd; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_ga8_x3_simd; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_ga8_x4_simd; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_ga8_x5_simd; break; }
+                  }
+
+                  switch (iMethodY)
+                  {
+                    case 2  : { *pfMagnifyY = mng_magnify_ga8_y2_simd; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_ga8_y4_simd; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_ga8_y5_simd; break; }
+                  }
+
+                  break;
+                }
+#endif
+#endif
+
+      case  6 : ;
+      case 14 : {
+                  switch (iMethodX)
+                  {
+                    case 1  : { *pfMagnifyX = mng_magnify_rgba8_x1_simd; break; }
+                    case 2  : { *pfMagnifyX = mng_magnify_rgba8_x2_simd; break; }
+                    case 3  : { *pfMagnifyX = mng_magnify_rgba8_x3_simd; break; }
+                    case 4  : { *pfMagnifyX = mng_magnify_rgba8_x4_simd; break; }
+                    case 5  : { *pfMagnifyX = mng_magnify_rgba8_x5_simd; break; }
+                  }
+
+                  switch (iMethodY)
+                  {
+                    case 2  : { *pfMagnifyY = mng_magnify_rgba8_y2_simd; break; }
+                    case 4  : { *pfMagnifyY = mng_magnify_rgba8_y4_simd; break; }
+                    case 5  : { *pfMagnifyY = mng_magnify_rgba8_y5_simd; break; }
+                  }
+
+                  break;
+                }
+    }
+  }
+#endif
+
+  return;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_magnify_imageobject (mng_datap  pData,
+                                     mng_imagep pImage)
+{
+  mng_uint8p     pNewdata;
+  mng_uint8p     pSrcline1;
+  mng_uint8p     pSrcline2;
+  mng_uint8p     pTempline;
+  mng_uint8p     pDstline;
+  mng_uint32     iNewrowsize;
+  mng_uint32     iNewsize;
+  mng_uint32     iY;
+  mng_int32      iS, iM;
+  mng_bool       bNearest;
+  mng_retcode    iRetcode;
+
+  mng_imagedatap pBuf      = pImage->pImgbuf;
+  mng_uint32     iNewW;
+  mng_uint32     iNewH;
+  mng_magnify_x  fMagnifyX;
+  mng_magnify_y  fMagnifyY;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_MAGNIFY_IMGOBJECT, MNG_LC_START);
+#endif
+
+  if (pBuf->iColortype == MNG_COLORTYPE_INDEXED)           /* indexed color ? */
+  {                                    /* concrete buffer ? */
+    if ((pBuf->bConcrete) && (pImage->iId))
+      MNG_ERROR (pData, MNG_INVALIDCOLORTYPE);
+
+#ifndef MNG_OPTIMIZE_FOOTPRINT_MAGN
+    if (pBuf->iTRNScount)              /* with transparency ? */
+      iRetcode = mng_promote_imageobject (pData, pImage, 8, 6, 0);
+    else
+      iRetcode = mng_promote_imageobject (pData, pImage, 8, 2, 0);
+
+    if (iRetcode)                      /* on error bail out */
+      return iRetcode;
+#endif
+  }
+
+#ifdef MNG_OPTIMIZE_FOOTPRINT_MAGN
+  /* Promote everything to RGBA, using fill method 0 (LBR) */
+  iRetcode = mng_promote_imageobject (pData, pImage, 8, 6, 0);           
+  if (iRetcode)                      /* on error bail out */
+    return iRetcode;
+#endif
+
+  mng_magnify_size (pImage, &iNewW, &iNewH);
+
+                                       /* get new buffer */
+  iNewrowsize  = iNewW * pBuf->iSamplesize;
+  iNewsize     = iNewH * iNewrowsize;
+
+  MNG_ALLOC (pData, pNewdata, iNewsize);
+
+                                       /* determine magnification routines */
+  mng_magnify_routines (pData, pBuf->iColortype, pBuf->iBitdepth,
+                        pImage->iMAGN_MethodX, pImage->iMAGN_MethodY,
+                        &fMagnifyX, &fMagnifyY);
+
   pSrcline1 = pBuf->pImgdata;          /* initialize row-loop variables */
   pDstline  = pNewdata;
+                                       /* nearest-neighbor rows just repeat */
+  bNearest  = (mng_bool)((pImage->iMAGN_MethodY == 3) ||
+                         ((pImage->iMAGN_MethodY == 5) && (!(pBuf->iColortype & 0x04))));
                                        /* allocate temporary row */
-  MNG_ALLOC (pData, pTempline, iNewrowsize);
+  MNG_ALLOCX (pData, pTempline, iNewrowsize);
+
+  if (!pTempline)                      /* don't lose the new buffer */
+  {
+    MNG_FREEX (pData, pNewdata, iNewsize);
+    MNG_ERROR (pData, MNG_OUTOFMEMORY);
+  }
 
   for (iY = 0; iY < pBuf->iHeight; iY++)
   {
@@ -2134,22 +2351,17 @@ mng_retcode mng_magnify_imageobject (mng_datap  pData,
         iM = (mng_int32)pImage->iMAGN_MY;
 
       for (iS = 1; iS < iM; iS++)
-      {
-        iRetcode = fMagnifyY (pData, iS, iM, pBuf->iWidth,
-                              pSrcline1, pSrcline2, pTempline);
-
-        if (iRetcode)                  /* on error bail out */
+      {                                /* same as the row above ? */
+        if ((fMagnifyX) &&
+            ((!pSrcline2) || (pImage->iMAGN_MethodY == 1) ||
+             ((bNearest) && (iS != ((iM + 1) / 2)))          ))
         {
-          MNG_FREEX (pData, pTempline, iNewrowsize);
-          MNG_FREEX (pData, pNewdata,  iNewsize);
-          return iRetcode;
+          MNG_COPY (pDstline, pDstline - iNewrowsize, iNewrowsize);
         }
-
-        if (fMagnifyX)                   /* magnifying in X-direction ? */
+        else
         {
-          iRetcode = fMagnifyX (pData, pImage->iMAGN_MX,
-                                pImage->iMAGN_ML, pImage->iMAGN_MR,
-                                pBuf->iWidth, pTempline, pDstline);
+          iRetcode = fMagnifyY (pData, iS, iM, pBuf->iWidth,
+                                pSrcline1, pSrcline2, pTempline);
 
           if (iRetcode)                  /* on error bail out */
           {
@@ -2157,10 +2369,24 @@ mng_retcode mng_magnify_imageobject (mng_datap  pData,
             MNG_FREEX (pData, pNewdata,  iNewsize);
             return iRetcode;
           }
-        }
-        else
-        {
-          MNG_COPY (pDstline, pTempline, iNewrowsize);
+
+          if (fMagnifyX)                   /* magnifying in X-direction ? */
+          {
+            iRetcode = fMagnifyX (pData, pImage->iMAGN_MX,
+                                  pImage->iMAGN_ML, pImage->iMAGN_MR,
+                                  pBuf->iWidth, pTempline, pDstline);
+
+            if (iRetcode)                  /* on error bail out */
+            {
+              MNG_FREEX (pData, pTempline, iNewrowsize);
+              MNG_FREEX (pData, pNewdata,  iNewsize);
+              return iRetcode;
+            }
+          }
+          else
+          {
+            MNG_COPY (pDstline, pTempline, iNewrowsize);
+          }
         }
 
         pDstline  += iNewrowsize;
@@ -2300,7 +2526,8 @@ mng_retcode mng_colorcorrect_object (mng_datap  pData,
         iY++;                          /* and next line */
       }
                                        /* drop the temporary row-buffer */
-      MNG_FREEX (pData, pData->pRGBArow, pData->iRowsize);
+      MNG_FREE (pData, pData->pRGBArow, pData->iRowsize);
+      pData->pWorkrow = MNG_NULL;      /* (it was an alias) */
 
       if (iRetcode)                    /* on error bail out */
         return iRetcode;
@@ -2588,7 +2815,7 @@ mng_retcode mng_create_ani_plte (mng_datap      pData)
       return iRetcode;
     pPLTE = (mng_ani_pltep)pTemp;
 #else
-    MNG_ALLOC (pData, pPLTE, sizeof (mng_ani_plte));
+    MNG_ALLOCP (pData, pPLTE, sizeof (mng_ani_plte));
 
     pPLTE->sHeader.fCleanup = mng_free_ani_plte;
     pPLTE->sHeader.fProcess = mng_process_ani_plte;
@@ -2622,7 +2849,7 @@ mng_retcode mng_free_ani_plte (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_PLTE, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_plte));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_plte));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_PLTE, MNG_LC_END);
@@ -2684,7 +2911,7 @@ mng_retcode mng_create_ani_trns (mng_datap    pData)
       return iRetcode;
     pTRNS = (mng_ani_trnsp)pTemp;
 #else
-    MNG_ALLOC (pData, pTRNS, sizeof (mng_ani_trns));
+    MNG_ALLOCP (pData, pTRNS, sizeof (mng_ani_trns));
 
     pTRNS->sHeader.fCleanup = mng_free_ani_trns;
     pTRNS->sHeader.fProcess = mng_process_ani_trns;
@@ -2718,7 +2945,7 @@ mng_retcode mng_free_ani_trns (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_TRNS, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_trns));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_trns));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_TRNS, MNG_LC_END);
@@ -2782,7 +3009,7 @@ mng_retcode mng_create_ani_gama (mng_datap  pData,
       return iRetcode;
     pGAMA = (mng_ani_gamap)pTemp;
 #else
-    MNG_ALLOC (pData, pGAMA, sizeof (mng_ani_gama));
+    MNG_ALLOCP (pData, pGAMA, sizeof (mng_ani_gama));
 
     pGAMA->sHeader.fCleanup = mng_free_ani_gama;
     pGAMA->sHeader.fProcess = mng_process_ani_gama;
@@ -2816,7 +3043,7 @@ mng_retcode mng_free_ani_gama (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_GAMA, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_gama));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_gama));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_GAMA, MNG_LC_END);
@@ -2894,7 +3121,7 @@ mng_retcode mng_create_ani_chrm (mng_datap  pData,
       return iRetcode;
     pCHRM = (mng_ani_chrmp)pTemp;
 #else
-    MNG_ALLOC (pData, pCHRM, sizeof (mng_ani_chrm));
+    MNG_ALLOCP (pData, pCHRM, sizeof (mng_ani_chrm));
 
     pCHRM->sHeader.fCleanup = mng_free_ani_chrm;
     pCHRM->sHeader.fProcess = mng_process_ani_chrm;
@@ -2942,7 +3169,7 @@ mng_retcode mng_free_ani_chrm (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_CHRM, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_chrm));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_chrm));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_CHRM, MNG_LC_END);
@@ -3027,7 +3254,7 @@ mng_retcode mng_create_ani_srgb (mng_datap pData,
       return iRetcode;
     pSRGB = (mng_ani_srgbp)pTemp;
 #else
-    MNG_ALLOC (pData, pSRGB, sizeof (mng_ani_srgb));
+    MNG_ALLOCP (pData, pSRGB, sizeof (mng_ani_srgb));
 
     pSRGB->sHeader.fCleanup = mng_free_ani_srgb;
     pSRGB->sHeader.fProcess = mng_process_ani_srgb;
@@ -3061,7 +3288,7 @@ mng_retcode mng_free_ani_srgb (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_SRGB, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_srgb));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_srgb));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_SRGB, MNG_LC_END);
@@ -3133,7 +3360,7 @@ mng_retcode mng_create_ani_iccp (mng_datap  pData,
       return iRetcode;
     pICCP = (mng_ani_iccpp)pTemp;
 #else
-    MNG_ALLOC (pData, pICCP, sizeof (mng_ani_iccp));
+    MNG_ALLOCP (pData, pICCP, sizeof (mng_ani_iccp));
 
     pICCP->sHeader.fCleanup = mng_free_ani_iccp;
     pICCP->sHeader.fProcess = mng_process_ani_iccp;
@@ -3184,7 +3411,7 @@ mng_retcode mng_free_ani_iccp (mng_datap   pData,
     MNG_FREEX (pData, pICCP->pProfile, pICCP->iProfilesize);
 
 #ifndef MNG_OPTIMIZE_OBJCLEANUP
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_iccp));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_iccp));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -3270,7 +3497,7 @@ mng_retcode mng_create_ani_bkgd (mng_datap  pData)
       return iRetcode;
     pBKGD = (mng_ani_bkgdp)pTemp;
 #else
-    MNG_ALLOC (pData, pBKGD, sizeof (mng_ani_bkgd));
+    MNG_ALLOCP (pData, pBKGD, sizeof (mng_ani_bkgd));
 
     pBKGD->sHeader.fCleanup = mng_free_ani_bkgd;
     pBKGD->sHeader.fProcess = mng_process_ani_bkgd;
@@ -3306,7 +3533,7 @@ mng_retcode mng_free_ani_bkgd (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_BKGD, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_bkgd));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_bkgd));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_BKGD, MNG_LC_END);
@@ -3376,7 +3603,7 @@ mng_retcode mng_create_ani_loop (mng_datap   pData,
       return iRetcode;
     pLOOP = (mng_ani_loopp)pTemp;
 #else
-    MNG_ALLOC (pData, pLOOP, sizeof (mng_ani_loop));
+    MNG_ALLOCP (pData, pLOOP, sizeof (mng_ani_loop));
 
     pLOOP->sHeader.fCleanup = mng_free_ani_loop;
     pLOOP->sHeader.fProcess = mng_process_ani_loop;
@@ -3445,7 +3672,7 @@ mng_retcode mng_free_ani_loop (mng_datap   pData,
 #endif
 
 #ifndef MNG_OPTIMIZE_OBJCLEANUP
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_loop));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_loop));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -3507,7 +3734,7 @@ mng_retcode mng_create_ani_endl (mng_datap pData,
       return iRetcode;
     pENDL = (mng_ani_endlp)pTemp;
 #else
-    MNG_ALLOC (pData, pENDL, sizeof (mng_ani_endl));
+    MNG_ALLOCP (pData, pENDL, sizeof (mng_ani_endl));
 
     pENDL->sHeader.fCleanup = mng_free_ani_endl;
     pENDL->sHeader.fProcess = mng_process_ani_endl;
@@ -3539,7 +3766,7 @@ mng_retcode mng_free_ani_endl (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_ENDL, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_endl));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_endl));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_ENDL, MNG_LC_END);
@@ -3649,7 +3876,7 @@ mng_retcode mng_create_ani_defi (mng_datap pData)
       return iRetcode;
     pDEFI = (mng_ani_defip)pTemp;
 #else
-    MNG_ALLOC (pData, pDEFI, sizeof (mng_ani_defi));
+    MNG_ALLOCP (pData, pDEFI, sizeof (mng_ani_defi));
 
     pDEFI->sHeader.fCleanup = mng_free_ani_defi;
     pDEFI->sHeader.fProcess = mng_process_ani_defi;
@@ -3689,7 +3916,7 @@ mng_retcode mng_free_ani_defi (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_DEFI, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_defi));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_defi));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_DEFI, MNG_LC_END);
@@ -3774,7 +4001,7 @@ mng_retcode mng_create_ani_basi (mng_datap  pData,
       return iRetcode;
     pBASI = (mng_ani_basip)pTemp;
 #else
-    MNG_ALLOC (pData, pBASI, sizeof (mng_ani_basi));
+    MNG_ALLOCP (pData, pBASI, sizeof (mng_ani_basi));
 
     pBASI->sHeader.fCleanup = mng_free_ani_basi;
     pBASI->sHeader.fProcess = mng_process_ani_basi;
@@ -3849,7 +4076,7 @@ mng_retcode mng_free_ani_basi (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_BASI, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_basi));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_basi));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_BASI, MNG_LC_END);
@@ -3932,7 +4159,7 @@ mng_retcode mng_create_ani_clon (mng_datap  pData,
       return iRetcode;
     pCLON = (mng_ani_clonp)pTemp;
 #else
-    MNG_ALLOC (pData, pCLON, sizeof (mng_ani_clon));
+    MNG_ALLOCP (pData, pCLON, sizeof (mng_ani_clon));
 
     pCLON->sHeader.fCleanup = mng_free_ani_clon;
     pCLON->sHeader.fProcess = mng_process_ani_clon;
@@ -4028,7 +4255,7 @@ mng_retcode mng_free_ani_clon (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_CLON, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_clon));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_clon));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_CLON, MNG_LC_END);
@@ -4112,7 +4339,7 @@ mng_retcode mng_create_ani_back (mng_datap  pData)
       return iRetcode;
     pBACK = (mng_ani_backp)pTemp;
 #else
-    MNG_ALLOC (pData, pBACK, sizeof (mng_ani_back));
+    MNG_ALLOCP (pData, pBACK, sizeof (mng_ani_back));
 
     pBACK->sHeader.fCleanup = mng_free_ani_back;
     pBACK->sHeader.fProcess = mng_process_ani_back;
@@ -4154,7 +4381,7 @@ mng_retcode mng_free_ani_back (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_BACK, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_back));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_back));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_BACK, MNG_LC_END);
@@ -4230,7 +4457,7 @@ mng_retcode mng_create_ani_fram (mng_datap  pData,
       return iRetcode;
     pFRAM = (mng_ani_framp)pTemp;
 #else
-    MNG_ALLOC (pData, pFRAM, sizeof (mng_ani_fram));
+    MNG_ALLOCP (pData, pFRAM, sizeof (mng_ani_fram));
 
     pFRAM->sHeader.fCleanup = mng_free_ani_fram;
     pFRAM->sHeader.fProcess = mng_process_ani_fram;
@@ -4334,7 +4561,7 @@ mng_retcode mng_free_ani_fram (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_FRAM, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_fram));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_fram));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_FRAM, MNG_LC_END);
@@ -4429,7 +4656,7 @@ mng_retcode mng_create_ani_move (mng_datap  pData,
       return iRetcode;
     pMOVE = (mng_ani_movep)pTemp;
 #else
-    MNG_ALLOC (pData, pMOVE, sizeof (mng_ani_move));
+    MNG_ALLOCP (pData, pMOVE, sizeof (mng_ani_move));
 
     pMOVE->sHeader.fCleanup = mng_free_ani_move;
     pMOVE->sHeader.fProcess = mng_process_ani_move;
@@ -4499,7 +4726,7 @@ mng_retcode mng_free_ani_move (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_MOVE, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_move));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_move));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_MOVE, MNG_LC_END);
@@ -4578,7 +4805,7 @@ mng_retcode mng_create_ani_clip (mng_datap  pData,
       return iRetcode;
     pCLIP = (mng_ani_clipp)pTemp;
 #else
-    MNG_ALLOC (pData, pCLIP, sizeof (mng_ani_clip));
+    MNG_ALLOCP (pData, pCLIP, sizeof (mng_ani_clip));
 
     pCLIP->sHeader.fCleanup = mng_free_ani_clip;
     pCLIP->sHeader.fProcess = mng_process_ani_clip;
@@ -4659,7 +4886,7 @@ mng_retcode mng_free_ani_clip (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_CLIP, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_clip));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_clip));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_CLIP, MNG_LC_END);
@@ -4735,7 +4962,7 @@ mng_retcode mng_create_ani_show (mng_datap  pData)
       return iRetcode;
     pSHOW = (mng_ani_showp)pTemp;
 #else
-    MNG_ALLOC (pData, pSHOW, sizeof (mng_ani_show));
+    MNG_ALLOCP (pData, pSHOW, sizeof (mng_ani_show));
 
     pSHOW->sHeader.fCleanup = mng_free_ani_show;
     pSHOW->sHeader.fProcess = mng_process_ani_show;
@@ -4771,7 +4998,7 @@ mng_retcode mng_free_ani_show (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_SHOW, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_show));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_show));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_SHOW, MNG_LC_END);
@@ -4846,7 +5073,7 @@ mng_retcode mng_create_ani_term (mng_datap  pData,
       return iRetcode;
     pTERM = (mng_ani_termp)pTemp;
 #else
-    MNG_ALLOC (pData, pTERM, sizeof (mng_ani_term));
+    MNG_ALLOCP (pData, pTERM, sizeof (mng_ani_term));
 
     pTERM->sHeader.fCleanup = mng_free_ani_term;
     pTERM->sHeader.fProcess = mng_process_ani_term;
@@ -4884,7 +5111,7 @@ mng_retcode mng_free_ani_term (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_TERM, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_term));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_term));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_TERM, MNG_LC_END);
@@ -4936,7 +5163,7 @@ mng_retcode mng_create_ani_save (mng_datap pData)
       return iRetcode;
     pSAVE = (mng_ani_savep)pTemp;
 #else
-    MNG_ALLOC (pData, pSAVE, sizeof (mng_ani_save));
+    MNG_ALLOCP (pData, pSAVE, sizeof (mng_ani_save));
 
     pSAVE->sHeader.fCleanup = mng_free_ani_save;
     pSAVE->sHeader.fProcess = mng_process_ani_save;
@@ -4962,7 +5189,7 @@ mng_retcode mng_free_ani_save (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_SAVE, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_save));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_save));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_SAVE, MNG_LC_END);
@@ -5027,7 +5254,7 @@ mng_retcode mng_create_ani_seek (mng_datap  pData,
       return iRetcode;
     pSEEK = (mng_ani_seekp)pTemp;
 #else
-    MNG_ALLOC (pData, pSEEK, sizeof (mng_ani_seek));
+    MNG_ALLOCP (pData, pSEEK, sizeof (mng_ani_seek));
 
     pSEEK->sHeader.fCleanup = mng_free_ani_seek;
     pSEEK->sHeader.fProcess = mng_process_ani_seek;
@@ -5076,7 +5303,7 @@ mng_retcode mng_free_ani_seek (mng_datap   pData,
     MNG_FREEX (pData, pSEEK->zSegmentname, pSEEK->iSegmentnamesize + 1);
 
 #ifndef MNG_OPTIMIZE_OBJCLEANUP
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_seek));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_seek));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -5176,7 +5403,7 @@ mng_retcode mng_create_ani_dhdr (mng_datap  pData,
       return iRetcode;
     pDHDR = (mng_ani_dhdrp)pTemp;
 #else
-    MNG_ALLOC (pData, pDHDR, sizeof (mng_ani_dhdr));
+    MNG_ALLOCP (pData, pDHDR, sizeof (mng_ani_dhdr));
 
     pDHDR->sHeader.fCleanup = mng_free_ani_dhdr;
     pDHDR->sHeader.fProcess = mng_process_ani_dhdr;
@@ -5258,7 +5485,7 @@ mng_retcode mng_free_ani_dhdr (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_DHDR, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_dhdr));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_dhdr));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_DHDR, MNG_LC_END);
@@ -5339,7 +5566,7 @@ mng_retcode mng_create_ani_prom (mng_datap pData,
       return iRetcode;
     pPROM = (mng_ani_promp)pTemp;
 #else
-    MNG_ALLOC (pData, pPROM, sizeof (mng_ani_prom));
+    MNG_ALLOCP (pData, pPROM, sizeof (mng_ani_prom));
 
     pPROM->sHeader.fCleanup = mng_free_ani_prom;
     pPROM->sHeader.fProcess = mng_process_ani_prom;
@@ -5399,7 +5626,7 @@ mng_retcode mng_free_ani_prom (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_PROM, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_prom));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_prom));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_PROM, MNG_LC_END);
@@ -5463,7 +5690,7 @@ mng_retcode mng_create_ani_ipng (mng_datap pData)
       return iRetcode;
     pIPNG = (mng_ani_ipngp)pTemp;
 #else
-    MNG_ALLOC (pData, pIPNG, sizeof (mng_ani_ipng));
+    MNG_ALLOCP (pData, pIPNG, sizeof (mng_ani_ipng));
 
     pIPNG->sHeader.fCleanup = mng_free_ani_ipng;
     pIPNG->sHeader.fProcess = mng_process_ani_ipng;
@@ -5489,7 +5716,7 @@ mng_retcode mng_free_ani_ipng (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_IPNG, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_ipng));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_ipng));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_IPNG, MNG_LC_END);
@@ -5547,7 +5774,7 @@ mng_retcode mng_create_ani_ijng (mng_datap pData)
       return iRetcode;
     pIJNG = (mng_ani_ijngp)pTemp;
 #else
-    MNG_ALLOC (pData, pIJNG, sizeof (mng_ani_ijng));
+    MNG_ALLOCP (pData, pIJNG, sizeof (mng_ani_ijng));
 
     pIJNG->sHeader.fCleanup = mng_free_ani_ijng;
     pIJNG->sHeader.fProcess = mng_process_ani_ijng;
@@ -5573,7 +5800,7 @@ mng_retcode mng_free_ani_ijng (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_IJNG, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_ijng));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_ijng));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_IJNG, MNG_LC_END);
@@ -5637,7 +5864,7 @@ mng_retcode mng_create_ani_pplt (mng_datap      pData,
       return iRetcode;
     pPPLT = (mng_ani_ppltp)pTemp;
 #else
-    MNG_ALLOC (pData, pPPLT, sizeof (mng_ani_pplt));
+    MNG_ALLOCP (pData, pPPLT, sizeof (mng_ani_pplt));
 
     pPPLT->sHeader.fCleanup = mng_free_ani_pplt;
     pPPLT->sHeader.fProcess = mng_process_ani_pplt;
@@ -5683,7 +5910,7 @@ mng_retcode mng_free_ani_pplt (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_PPLT, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_pplt));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_pplt));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_PPLT, MNG_LC_END);
@@ -5766,7 +5993,7 @@ mng_retcode mng_create_ani_magn (mng_datap  pData,
       return iRetcode;
     pMAGN = (mng_ani_magnp)pTemp;
 #else
-    MNG_ALLOC (pData, pMAGN, sizeof (mng_ani_magn));
+    MNG_ALLOCP (pData, pMAGN, sizeof (mng_ani_magn));
 
     pMAGN->sHeader.fCleanup = mng_free_ani_magn;
     pMAGN->sHeader.fProcess = mng_process_ani_magn;
@@ -5863,7 +6090,7 @@ mng_retcode mng_free_ani_magn (mng_datap   pData,
   MNG_TRACE (pData, MNG_FN_FREE_ANI_MAGN, MNG_LC_START);
 #endif
 
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_magn));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_magn));
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_FREE_ANI_MAGN, MNG_LC_END);
@@ -5948,7 +6175,7 @@ mng_retcode mng_create_ani_past (mng_datap  pData,
       return iRetcode;
     pPAST = (mng_ani_pastp)pTemp;
 #else
-    MNG_ALLOC (pData, pPAST, sizeof (mng_ani_past));
+    MNG_ALLOCP (pData, pPAST, sizeof (mng_ani_past));
 
     pPAST->sHeader.fCleanup = mng_free_ani_past;
     pPAST->sHeader.fProcess = mng_process_ani_past;
@@ -6042,7 +6269,7 @@ mng_retcode mng_free_ani_past (mng_datap   pData,
     MNG_FREEX (pData, pPAST->pSources, (pPAST->iCount * sizeof (mng_past_source)));
 
 #ifndef MNG_OPTIMIZE_OBJCLEANUP
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_past));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_past));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -6124,7 +6351,7 @@ mng_retcode mng_create_ani_disc (mng_datap   pData,
       return iRetcode;
     pDISC = (mng_ani_discp)pTemp;
 #else
-    MNG_ALLOC (pData, pDISC, sizeof (mng_ani_disc));
+    MNG_ALLOCP (pData, pDISC, sizeof (mng_ani_disc));
 
     pDISC->sHeader.fCleanup = mng_free_ani_disc;
     pDISC->sHeader.fProcess = mng_process_ani_disc;
@@ -6194,7 +6421,7 @@ mng_retcode mng_free_ani_disc (mng_datap   pData,
     MNG_FREEX (pData, pDISC->pIds, (pDISC->iCount << 1));
 
 #ifndef MNG_OPTIMIZE_OBJCLEANUP
-  MNG_FREEX (pData, pObject, sizeof (mng_ani_disc));
+  MNG_FREEP (pData, pObject, sizeof (mng_ani_disc));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -6281,7 +6508,7 @@ mng_retcode mng_create_event (mng_datap  pData,
       return iRetcode;
     pEvent = (mng_eventp)pTemp;
 #else
-    MNG_ALLOC (pData, pEvent, sizeof (mng_event));
+    MNG_ALLOCP (pData, pEvent, sizeof (mng_event));
 
     pEvent->sHeader.fCleanup = mng_free_event;
     pEvent->sHeader.fProcess = mng_process_event;
@@ -6359,7 +6586,7 @@ mng_retcode mng_free_event (mng_datap   pData,
     MNG_FREEX (pData, pEvent->zSegmentname, pEvent->iSegmentnamesize + 1);
 
 #ifndef MNG_OPTIMIZE_OBJCLEANUP
-  MNG_FREEX (pData, pEvent, sizeof (mng_event));
+  MNG_FREEP (pData, pEvent, sizeof (mng_event));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -6414,7 +6641,7 @@ mng_retcode mng_process_event (mng_datap   pData,
     pData->pCurraniobj   = (mng_objectp)pEvent->pSEEK;
     pData->bRunningevent = MNG_TRUE;
                                        /* wake-up the app ! */
-    if (!pData->fSettimer ((mng_handle)pData, 5))
+    if ((!pData->bVirtualclock) && (!pData->fSettimer ((mng_handle)pData, 5)))
       MNG_ERROR (pData, MNG_APPTIMERERROR);
 
   }
@@ -6481,7 +6708,7 @@ mng_retcode mng_create_mpng_obj (mng_datap  pData,
     return iRetcode;
   pMPNG = (mng_mpng_objp)pTemp;
 #else
-  MNG_ALLOC (pData, pMPNG, sizeof (mng_mpng_obj));
+  MNG_ALLOCP (pData, pMPNG, sizeof (mng_mpng_obj));
 
   pMPNG->sHeader.fCleanup = mng_free_mpng_obj;
   pMPNG->sHeader.fProcess = mng_process_mpng_obj;
@@ -6537,7 +6764,7 @@ mng_retcode mng_create_mpng_obj (mng_datap  pData,
     if (iRetcode)
       return iRetcode;
 #else
-    MNG_ALLOC (pData, pLOOP, sizeof (mng_ani_loop));
+    MNG_ALLOCP (pData, pLOOP, sizeof (mng_ani_loop));
 
     pLOOP->sHeader.fCleanup = mng_free_ani_loop;
     pLOOP->sHeader.fProcess = mng_process_ani_loop;
@@ -6587,7 +6814,7 @@ mng_retcode mng_create_mpng_obj (mng_datap  pData,
       if (iRetcode)
         return iRetcode;
 #else
-      MNG_ALLOC (pData, pFRAM, sizeof (mng_ani_fram));
+      MNG_ALLOCP (pData, pFRAM, sizeof (mng_ani_fram));
 
       pFRAM->sHeader.fCleanup = mng_free_ani_fram;
       pFRAM->sHeader.fProcess = mng_process_ani_fram;
@@ -6608,7 +6835,7 @@ mng_retcode mng_create_mpng_obj (mng_datap  pData,
     if (iRetcode)
       return iRetcode;
 #else
-    MNG_ALLOC (pData, pMOVE, sizeof (mng_ani_move));
+    MNG_ALLOCP (pData, pMOVE, sizeof (mng_ani_move));
 
     pMOVE->sHeader.fCleanup = mng_free_ani_move;
     pMOVE->sHeader.fProcess = mng_process_ani_move;
@@ -6627,7 +6854,7 @@ mng_retcode mng_create_mpng_obj (mng_datap  pData,
     if (iRetcode)
       return iRetcode;
 #else
-    MNG_ALLOC (pData, pCLIP, sizeof (mng_ani_clip));
+    MNG_ALLOCP (pData, pCLIP, sizeof (mng_ani_clip));
 
     pCLIP->sHeader.fCleanup = mng_free_ani_clip;
     pCLIP->sHeader.fProcess = mng_process_ani_clip;
@@ -6647,7 +6874,7 @@ mng_retcode mng_create_mpng_obj (mng_datap  pData,
     if (iRetcode)
       return iRetcode;
 #else
-    MNG_ALLOC (pData, pSHOW, sizeof (mng_ani_show));
+    MNG_ALLOCP (pData, pSHOW, sizeof (mng_ani_show));
 
     pSHOW->sHeader.fCleanup = mng_free_ani_show;
     pSHOW->sHeader.fProcess = mng_process_ani_show;
@@ -6668,7 +6895,7 @@ mng_retcode mng_create_mpng_obj (mng_datap  pData,
     if (iRetcode)
       return iRetcode;
 #else
-    MNG_ALLOC (pData, pENDL, sizeof (mng_ani_endl));
+    MNG_ALLOCP (pData, pENDL, sizeof (mng_ani_endl));
 
     pENDL->sHeader.fCleanup = mng_free_ani_endl;
     pENDL->sHeader.fProcess = mng_process_ani_endl;
@@ -6701,7 +6928,7 @@ mng_retcode mng_free_mpng_obj (mng_datap   pData,
     MNG_FREEX (pData, pMPNG->pFrames, pMPNG->iFramessize);
 
 #ifndef MNG_OPTIMIZE_OBJCLEANUP
-  MNG_FREEX (pData, pMPNG, sizeof (mng_mpng_obj));
+  MNG_FREEP (pData, pMPNG, sizeof (mng_mpng_obj));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -6763,7 +6990,7 @@ mng_retcode mng_create_ang_obj (mng_datap  pData,
     return iRetcode;
   pANG = (mng_ang_objp)pTemp;
 #else
-  MNG_ALLOC (pData, pANG, sizeof (mng_ang_obj));
+  MNG_ALLOCP (pData, pANG, sizeof (mng_ang_obj));
 
   pANG->sHeader.fCleanup = mng_free_ang_obj;
   pANG->sHeader.fProcess = mng_process_ang_obj;
@@ -6816,7 +7043,7 @@ mng_retcode mng_free_ang_obj (mng_datap   pData,
     MNG_FREEX (pData, pANG->pTiles, pANG->iTilessize);
 
 #ifndef MNG_OPTIMIZE_OBJCLEANUP
-  MNG_FREEX (pData, pANG, sizeof (mng_ang_obj));
+  MNG_FREEP (pData, pANG, sizeof (mng_ang_obj));
 #endif
 
 #ifdef MNG_SUPPORT_TRACE
@@ -6868,7 +7095,7 @@ mng_retcode mng_process_ang_obj (mng_datap   pData,
     if (iRetcode)
       return iRetcode;
 #else
-    MNG_ALLOC (pData, pLOOP, sizeof (mng_ani_loop));
+    MNG_ALLOCP (pData, pLOOP, sizeof (mng_ani_loop));
 
     pLOOP->sHeader.fCleanup = mng_free_ani_loop;
     pLOOP->sHeader.fProcess = mng_process_ani_loop;
@@ -6897,7 +7124,7 @@ mng_retcode mng_process_ang_obj (mng_datap   pData,
     if (iRetcode)
       return iRetcode;
 #else
-    MNG_ALLOC (pData, pFRAM, sizeof (mng_ani_fram));
+    MNG_ALLOCP (pData, pFRAM, sizeof (mng_ani_fram));
 
     pFRAM->sHeader.fCleanup = mng_free_ani_fram;
     pFRAM->sHeader.fProcess = mng_process_ani_fram;
@@ -6919,7 +7146,7 @@ mng_retcode mng_process_ang_obj (mng_datap   pData,
       if (iRetcode)
         return iRetcode;
 #else
-      MNG_ALLOC (pData, pMOVE, sizeof (mng_ani_move));
+      MNG_ALLOCP (pData, pMOVE, sizeof (mng_ani_move));
 
       pMOVE->sHeader.fCleanup = mng_free_ani_move;
       pMOVE->sHeader.fProcess = mng_process_ani_move;
@@ -6940,7 +7167,7 @@ mng_retcode mng_process_ang_obj (mng_datap   pData,
     if (iRetcode)
       return iRetcode;
 #else
-    MNG_ALLOC (pData, pSHOW, sizeof (mng_ani_show));
+    MNG_ALLOCP (pData, pSHOW, sizeof (mng_ani_show));
 
     pSHOW->sHeader.fCleanup = mng_free_ani_show;
     pSHOW->sHeader.fProcess = mng_process_ani_show;
@@ -6966,7 +7193,7 @@ mng_retcode mng_process_ang_obj (mng_datap   pData,
     if (iRetcode)
       return iRetcode;
 #else
-    MNG_ALLOC (pData, pENDL, sizeof (mng_ani_endl));
+    MNG_ALLOCP (pData, pENDL, sizeof (mng_ani_endl));
 
     pENDL->sHeader.fCleanup = mng_free_ani_endl;
     pENDL->sHeader.fProcess = mng_process_ani_endl;
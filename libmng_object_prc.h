@@ -67,6 +67,10 @@
 /* *             1.0.10 - 04/12/2007 - G.Juyn                               * */
 /* *             - added support for ANG proposal                           * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added image-object (re)index functions                   * */
+/* *             - added mng_magnify_size & mng_magnify_routines            * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -135,6 +139,11 @@ mng_retcode mng_free_imageobject     (mng_datap  pData,
 mng_imagep  mng_find_imageobject     (mng_datap  pData,
                                       mng_uint16 iId);
 
+mng_retcode mng_unindex_imageobject  (mng_datap  pData,
+                                      mng_imagep pImage);
+
+mng_retcode mng_reindex_imageobjects (mng_datap  pData);
+
 mng_retcode mng_clone_imageobject    (mng_datap  pData,
                                       mng_uint16 iId,
                                       mng_bool   bPartial,
@@ -177,6 +186,19 @@ mng_retcode mng_promote_imageobject  (mng_datap  pData,
 mng_retcode mng_magnify_imageobject  (mng_datap  pData,
                                       mng_imagep pImage);
 
+#ifndef MNG_SKIPCHUNK_MAGN
+void        mng_magnify_size         (mng_imagep     pImage,
+                                      mng_uint32p    piWidth,
+                                      mng_uint32p    piHeight);
+void        mng_magnify_routines     (mng_datap      pData,
+                                      mng_uint8      iColortype,
+                                      mng_uint8      iBitdepth,
+                                      mng_uint8      iMethodX,
+                                      mng_uint8      iMethodY,
+                                      mng_magnify_x *pfMagnifyX,
+                                      mng_magnify_y *pfMagnifyY);
+#endif
+
 mng_retcode mng_colorcorrect_object  (mng_datap  pData,
                                       mng_imagep pImage);
 
@@ -73,6 +73,9 @@
 /* *             1.0.10 - 04/12/2007 - G.Juyn                               * */
 /* *             - added support for ANG proposal                           * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added bucket-link to the image-object                    * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -189,6 +192,7 @@ typedef mng_imagedata * mng_imagedatap;
 typedef struct {                                 /* MNG specification "object" */
            mng_object_header sHeader;            /* default header (DO NOT REMOVE) */
            mng_uint16        iId;                /* object-id */
+           mng_objectp       pIndexnext;         /* next in the same id-bucket */
            mng_bool          bFrozen;            /* frozen flag */
            mng_bool          bVisible;           /* potential visibility flag */
            mng_bool          bViewable;          /* viewable flag */
@@ -87,6 +87,21 @@
 /* *             1.0.10 - 03/07/2006 - (thanks to W. Manthey)               * */
 /* *             - added CANVAS_RGB555 and CANVAS_BGR555                    * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added SIMD versions of the 8-bit RGBA-family display     * */
+/* *               routines                                                 * */
+/* *             - added raw image-data display routine for getimgdata      * */
+/* *             - added 16-bit canvas display & restore routines           * */
+/* *             - added gray canvas display routines                       * */
+/* *             - added gray+alpha row processing for gray canvas styles   * */
+/* *             - added fused retrieve/correct/display routines            * */
+/* *             - added SIMD magnification routines                        * */
+/* *             - added mng_retrieve_magnify                               * */
+/* *             - added SIMD PAST compose-over/under & flip routines       * */
+/* *             - added mng_add_span8/16                                   * */
+/* *             - added mng_add_part8/16                                   * */
+/* *             - added mng_add_part8/16                                   * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -112,6 +127,33 @@
 
 mng_retcode mng_display_progressive_check (mng_datap pData);
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Gray canvas support - with any of the gray canvas-styles compiled in,  * */
+/* * gray images are processed into a gray+alpha intermediate row instead   * */
+/* * of RGBA when they're displayed on a gray canvas (see bIsGray)          * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#if !defined(MNG_SKIPCANVAS_GRAY8)  || !defined(MNG_SKIPCANVAS_GRAYA8)  || \
+    !defined(MNG_SKIPCANVAS_AGRAY8) || (!defined(MNG_NO_16BIT_SUPPORT) && \
+    (!defined(MNG_SKIPCANVAS_GRAY16) || !defined(MNG_SKIPCANVAS_GRAYA16) || \
+     !defined(MNG_SKIPCANVAS_AGRAY16)))
+#define MNG_INCLUDE_GRAYROW
+#endif
+
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Fused display support - stored 8-bit objects are retrieved, corrected  * */
+/* * and composed onto the canvas in one pass; this builds on the           * */
+/* * vectorized composing routines (see mng_init_fusedrow)                  * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#if defined(MNG_SUPPORT_SIMD) && !defined(MNG_NO_FUSEDROW)
+#define MNG_INCLUDE_FUSEDROW
+#endif
+
 /* ************************************************************************** */
 /* *                                                                        * */
 /* * Display routines - convert rowdata (which is already color-corrected)  * */
@@ -176,6 +218,128 @@ mng_retcode mng_display_rgb555         (mng_datap  pData);
 #ifndef MNG_SKIPCANVAS_BGR555
 mng_retcode mng_display_bgr555         (mng_datap  pData);
 #endif
+#ifndef MNG_NO_16BIT_SUPPORT
+#ifndef MNG_SKIPCANVAS_RGB16
+mng_retcode mng_display_rgb16          (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA16
+mng_retcode mng_display_rgba16         (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB16
+mng_retcode mng_display_argb16         (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_BGR16
+mng_retcode mng_display_bgr16          (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA16
+mng_retcode mng_display_bgra16         (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR16
+mng_retcode mng_display_abgr16         (mng_datap  pData);
+#endif
+#endif /* MNG_NO_16BIT_SUPPORT */
+#ifdef MNG_INCLUDE_GRAYROW
+#ifndef MNG_SKIPCANVAS_GRAY8
+mng_retcode mng_display_gray8          (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_GRAYA8
+mng_retcode mng_display_graya8         (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_AGRAY8
+mng_retcode mng_display_agray8         (mng_datap  pData);
+#endif
+#ifndef MNG_NO_16BIT_SUPPORT
+#ifndef MNG_SKIPCANVAS_GRAY16
+mng_retcode mng_display_gray16         (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_GRAYA16
+mng_retcode mng_display_graya16        (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_AGRAY16
+mng_retcode mng_display_agray16        (mng_datap  pData);
+#endif
+#endif /* MNG_NO_16BIT_SUPPORT */
+#endif /* MNG_INCLUDE_GRAYROW */
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_ACCESS_CHUNKS) && defined(MNG_STORE_CHUNKS)
+mng_retcode mng_display_imgdata        (mng_datap  pData);
+#endif
+
+#ifdef MNG_SUPPORT_SIMD                /* vectorized versions of the above */
+#ifndef MNG_SKIPCANVAS_RGBA8
+mng_retcode mng_display_rgba8_simd     (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA8_PM
+mng_retcode mng_display_rgba8_pm_simd  (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB8
+mng_retcode mng_display_argb8_simd     (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB8_PM
+mng_retcode mng_display_argb8_pm_simd  (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_RGB8_A8
+mng_retcode mng_display_rgb8_a8_simd   (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA8
+mng_retcode mng_display_bgra8_simd     (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA8_PM
+mng_retcode mng_display_bgra8_pm_simd  (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR8
+mng_retcode mng_display_abgr8_simd     (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR8_PM
+mng_retcode mng_display_abgr8_pm_simd  (mng_datap  pData);
+#endif
+#ifndef MNG_NO_16BIT_SUPPORT
+#ifndef MNG_SKIPCANVAS_RGB16
+mng_retcode mng_display_rgb16_simd     (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA16
+mng_retcode mng_display_rgba16_simd    (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB16
+mng_retcode mng_display_argb16_simd    (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA16
+mng_retcode mng_display_bgra16_simd    (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_BGR16
+mng_retcode mng_display_bgr16_simd     (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR16
+mng_retcode mng_display_abgr16_simd    (mng_datap  pData);
+#endif
+#endif /* MNG_NO_16BIT_SUPPORT */
+#endif /* MNG_SUPPORT_SIMD */
+
+#ifdef MNG_INCLUDE_FUSEDROW            /* retrieve, correct & display in one */
+#ifndef MNG_SKIPCANVAS_RGBA8
+mng_retcode mng_display_fused_rgba8    (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA8_PM
+mng_retcode mng_display_fused_rgba8_pm (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB8
+mng_retcode mng_display_fused_argb8    (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB8_PM
+mng_retcode mng_display_fused_argb8_pm (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA8
+mng_retcode mng_display_fused_bgra8    (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA8_PM
+mng_retcode mng_display_fused_bgra8_pm (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR8
+mng_retcode mng_display_fused_abgr8    (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR8_PM
+mng_retcode mng_display_fused_abgr8_pm (mng_datap  pData);
+#endif
+#endif /* MNG_INCLUDE_FUSEDROW */
 
 /* ************************************************************************** */
 /* *                                                                        * */
@@ -203,6 +367,14 @@ mng_retcode mng_restore_bkgd_rgb565    (mng_datap  pData);
 #ifndef MNG_SKIPCANVAS_BGR565
 mng_retcode mng_restore_bkgd_bgr565    (mng_datap  pData);
 #endif
+#ifndef MNG_NO_16BIT_SUPPORT
+#ifndef MNG_SKIPCANVAS_RGB16
+mng_retcode mng_restore_bkgd_rgb16     (mng_datap  pData);
+#endif
+#ifndef MNG_SKIPCANVAS_BGR16
+mng_retcode mng_restore_bkgd_bgr16     (mng_datap  pData);
+#endif
+#endif /* MNG_NO_16BIT_SUPPORT */
 
 /* ************************************************************************** */
 /* *                                                                        * */
@@ -222,6 +394,14 @@ mng_retcode mng_retrieve_ga16          (mng_datap  pData);
 mng_retcode mng_retrieve_rgb16         (mng_datap  pData);
 mng_retcode mng_retrieve_rgba16        (mng_datap  pData);
 #endif
+#ifdef MNG_INCLUDE_GRAYROW
+mng_retcode mng_retrieve_g8_gray       (mng_datap  pData);
+mng_retcode mng_retrieve_ga8_gray      (mng_datap  pData);
+#ifndef MNG_NO_16BIT_SUPPORT
+mng_retcode mng_retrieve_g16_gray      (mng_datap  pData);
+mng_retcode mng_retrieve_ga16_gray     (mng_datap  pData);
+#endif
+#endif
 
 /* ************************************************************************** */
 /* *                                                                        * */
@@ -323,6 +503,37 @@ mng_retcode mng_store_jpeg_rgb12_a16   (mng_datap  pData);
 /* *                                                                        * */
 /* ************************************************************************** */
 
+void        mng_add_span8              (mng_datap  pData,
+                                        mng_uint8p pOutrow,
+                                        mng_uint8p pWorkrow,
+                                        mng_uint32 iCount);
+#ifndef MNG_NO_16BIT_SUPPORT
+void        mng_add_span16             (mng_datap  pData,
+                                        mng_uint8p pOutrow,
+                                        mng_uint8p pWorkrow,
+                                        mng_uint32 iCount);
+#endif
+
+#ifndef MNG_NO_DELTA_PNG
+#define MNG_ADDPART_GA_G       0       /* which part of the pixels a color- */
+#define MNG_ADDPART_GA_A       1       /* or alpha-only delta row adds to */
+#define MNG_ADDPART_RGBA_RGB   2
+#define MNG_ADDPART_RGBA_A     3
+
+void        mng_add_part8              (mng_datap  pData,
+                                        mng_uint8p pOutrow,
+                                        mng_uint8p pWorkrow,
+                                        mng_uint32 iCount,
+                                        mng_uint8  iPart);
+#ifndef MNG_NO_16BIT_SUPPORT
+void        mng_add_part16             (mng_datap  pData,
+                                        mng_uint8p pOutrow,
+                                        mng_uint8p pWorkrow,
+                                        mng_uint32 iCount,
+                                        mng_uint8  iPart);
+#endif
+#endif
+
 #ifndef MNG_NO_DELTA_PNG
 #ifndef MNG_NO_1_2_4BIT_SUPPORT
 mng_retcode mng_delta_g1               (mng_datap  pData);
@@ -556,6 +767,17 @@ mng_retcode mng_process_ga16           (mng_datap  pData);
 mng_retcode mng_process_rgb16          (mng_datap  pData);
 mng_retcode mng_process_rgba16         (mng_datap  pData);
 #endif
+#ifdef MNG_INCLUDE_GRAYROW
+#ifndef MNG_NO_1_2_4BIT_SUPPORT
+mng_retcode mng_process_g124_gray      (mng_datap  pData);
+#endif
+mng_retcode mng_process_g8_gray        (mng_datap  pData);
+mng_retcode mng_process_ga8_gray       (mng_datap  pData);
+#ifndef MNG_NO_16BIT_SUPPORT
+mng_retcode mng_process_g16_gray       (mng_datap  pData);
+mng_retcode mng_process_ga16_gray      (mng_datap  pData);
+#endif
+#endif
 
 /* ************************************************************************** */
 /* *                                                                        * */
@@ -635,6 +857,13 @@ mng_retcode mng_init_jpeg_a16_ni       (mng_datap  pData);
 /* ************************************************************************** */
 
 mng_retcode mng_init_rowproc           (mng_datap  pData);
+#ifdef MNG_INCLUDE_GRAYROW
+mng_retcode mng_init_grayrow           (mng_datap  pData,
+                                        mng_bool   bRetrieve);
+#endif
+#ifdef MNG_INCLUDE_FUSEDROW
+mng_retcode mng_init_fusedrow          (mng_datap  pData);
+#endif
 mng_retcode mng_next_row               (mng_datap  pData);
 #ifdef MNG_INCLUDE_JNG
 mng_retcode mng_next_jpeg_alpharow     (mng_datap  pData);
@@ -1108,6 +1337,163 @@ mng_retcode mng_magnify_rgba16_y5      (mng_datap  pData,
 #endif
 #endif
 
+#ifndef MNG_SKIPCHUNK_MAGN
+mng_retcode mng_retrieve_magnify       (mng_datap  pData);
+#endif
+
+#if defined(MNG_SUPPORT_SIMD) && !defined(MNG_SKIPCHUNK_MAGN)
+#if defined(MNG_INCLUDE_SIMD_X86) || defined(MNG_INCLUDE_SIMD_NEON)
+#define MNG_INCLUDE_SIMD_MAGN          /* vectorized versions of the above */
+#endif
+#endif
+
+#ifdef MNG_INCLUDE_SIMD_MAGN
+#ifndef MNG_OPTIMIZE_FOOTPRINT_MAGN
+#ifndef MNG_NO_GRAY_SUPPORT
+mng_retcode mng_magnify_g8_x1_simd     (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_g8_x2_simd     (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_g8_x3_simd     (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_g8_y2_simd     (mng_datap  pData,
+                                        mng_int32  iS,
+                                        mng_int32  iM,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline1,
+                                        mng_uint8p pSrcline2,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_ga8_x1_simd    (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_ga8_x2_simd    (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_ga8_x3_simd    (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_ga8_x4_simd    (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_ga8_x5_simd    (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_ga8_y2_simd    (mng_datap  pData,
+                                        mng_int32  iS,
+                                        mng_int32  iM,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline1,
+                                        mng_uint8p pSrcline2,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_ga8_y4_simd    (mng_datap  pData,
+                                        mng_int32  iS,
+                                        mng_int32  iM,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline1,
+                                        mng_uint8p pSrcline2,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_ga8_y5_simd    (mng_datap  pData,
+                                        mng_int32  iS,
+                                        mng_int32  iM,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline1,
+                                        mng_uint8p pSrcline2,
+                                        mng_uint8p pDstline);
+#endif
+#endif
+mng_retcode mng_magnify_rgba8_x1_simd  (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_rgba8_x2_simd  (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_rgba8_x3_simd  (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_rgba8_x4_simd  (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_rgba8_x5_simd  (mng_datap  pData,
+                                        mng_uint16 iMX,
+                                        mng_uint16 iML,
+                                        mng_uint16 iMR,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_rgba8_y2_simd  (mng_datap  pData,
+                                        mng_int32  iS,
+                                        mng_int32  iM,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline1,
+                                        mng_uint8p pSrcline2,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_rgba8_y4_simd  (mng_datap  pData,
+                                        mng_int32  iS,
+                                        mng_int32  iM,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline1,
+                                        mng_uint8p pSrcline2,
+                                        mng_uint8p pDstline);
+mng_retcode mng_magnify_rgba8_y5_simd  (mng_datap  pData,
+                                        mng_int32  iS,
+                                        mng_int32  iM,
+                                        mng_uint32 iWidth,
+                                        mng_uint8p pSrcline1,
+                                        mng_uint8p pSrcline2,
+                                        mng_uint8p pDstline);
+#endif
+
 /* ************************************************************************** */
 /* *                                                                        * */
 /* * PAST composition routines - compose over/under with a target object    * */
@@ -1138,6 +1524,12 @@ mng_retcode mng_tile_rgba16            (mng_datap  pData);
 #endif
 #endif
 
+#if defined(MNG_SUPPORT_SIMD) && !defined(MNG_SKIPCHUNK_PAST)
+mng_retcode mng_composeover_rgba8_simd (mng_datap  pData);
+mng_retcode mng_composeunder_rgba8_simd(mng_datap  pData);
+mng_retcode mng_flip_rgba8_simd        (mng_datap  pData);
+#endif
+
 /* ************************************************************************** */
 
 #endif /* _libmng_pixels_h_ */
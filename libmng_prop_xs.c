@@ -114,6 +114,21 @@
 /* *             1.0.10 - 03/07/2006 - (thanks to W. Manthey)               * */
 /* *             - added CANVAS_RGB555 and CANVAS_BGR555                    * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added mng_set_simd/mng_get_simd                          * */
+/* *             - added mng_set_keyframecache & keyframe statistics        * */
+/* *             - added mng_set_filterselection/mng_get_filterselection    * */
+/* *             - added mng_get_dirtyrectcount & mng_get_dirtyrect         * */
+/* *             - added mng_set_mempool/mng_get_mempool & counters         * */
+/* *             - accept the 16-bit canvas & background styles             * */
+/* *             - added gray canvas styles                                 * */
+/* *             - added mng_set_cmscache/mng_get_cmscachehits/misses       * */
+/* *             - added mng_set_decodethreads/mng_get_decodethreads        * */
+/* *             - added mng_set_virtualclock/mng_get_virtualclock          * */
+/* *             - added mng_set_lazymagnify/mng_get_lazymagnify            * */
+/* *             - filterselection set/get guarded like libmng.h & the      * */
+/* *               function-table                                           * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -126,6 +141,7 @@
 #include "libmng_objects.h"
 #include "libmng_memory.h"
 #include "libmng_cms.h"
+#include "libmng_display.h"
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
 #pragma option -A                      /* force ANSI-C */
@@ -224,21 +240,47 @@ mng_retcode MNG_DECL mng_set_canvasstyle (mng_handle hHandle,
 #ifndef MNG_SKIPCANVAS_BGR555
     case MNG_CANVAS_BGR555  : break;
 #endif
-/*    case MNG_CANVAS_RGB16   : break; */
-/*    case MNG_CANVAS_RGBA16  : break; */
-/*    case MNG_CANVAS_ARGB16  : break; */
-/*    case MNG_CANVAS_BGR16   : break; */
-/*    case MNG_CANVAS_BGRA16  : break; */
-/*    case MNG_CANVAS_ABGR16  : break; */
+#ifndef MNG_NO_16BIT_SUPPORT
+#ifndef MNG_SKIPCANVAS_RGB16
+    case MNG_CANVAS_RGB16   : break;
+#endif
+#ifndef MNG_SKIPCANVAS_RGBA16
+    case MNG_CANVAS_RGBA16  : break;
+#endif
+#ifndef MNG_SKIPCANVAS_ARGB16
+    case MNG_CANVAS_ARGB16  : break;
+#endif
+#ifndef MNG_SKIPCANVAS_BGR16
+    case MNG_CANVAS_BGR16   : break;
+#endif
+#ifndef MNG_SKIPCANVAS_BGRA16
+    case MNG_CANVAS_BGRA16  : break;
+#endif
+#ifndef MNG_SKIPCANVAS_ABGR16
+    case MNG_CANVAS_ABGR16  : break;
+#endif
+#ifndef MNG_SKIPCANVAS_GRAY16
+    case MNG_CANVAS_GRAY16  : break;
+#endif
+#ifndef MNG_SKIPCANVAS_GRAYA16
+    case MNG_CANVAS_GRAYA16 : break;
+#endif
+#ifndef MNG_SKIPCANVAS_AGRAY16
+    case MNG_CANVAS_AGRAY16 : break;
+#endif
+#endif
+#ifndef MNG_SKIPCANVAS_GRAY8
+    case MNG_CANVAS_GRAY8   : break;
+#endif
+#ifndef MNG_SKIPCANVAS_GRAYA8
+    case MNG_CANVAS_GRAYA8  : break;
+#endif
+#ifndef MNG_SKIPCANVAS_AGRAY8
+    case MNG_CANVAS_AGRAY8  : break;
+#endif
 /*    case MNG_CANVAS_INDEX8  : break; */
 /*    case MNG_CANVAS_INDEXA8 : break; */
 /*    case MNG_CANVAS_AINDEX8 : break; */
-/*    case MNG_CANVAS_GRAY8   : break; */
-/*    case MNG_CANVAS_GRAY16  : break; */
-/*    case MNG_CANVAS_GRAYA8  : break; */
-/*    case MNG_CANVAS_GRAYA16 : break; */
-/*    case MNG_CANVAS_AGRAY8  : break; */
-/*    case MNG_CANVAS_AGRAY16 : break; */
 /*    case MNG_CANVAS_DX15    : break; */
 /*    case MNG_CANVAS_DX16    : break; */
     default                 : { MNG_ERROR (((mng_datap)hHandle), MNG_INVALIDCNVSTYLE) };
@@ -281,8 +323,14 @@ mng_retcode MNG_DECL mng_set_bkgdstyle (mng_handle hHandle,
 #ifndef MNG_SKIPCANVAS_BGR565
     case MNG_CANVAS_BGR565  : break;
 #endif
-/*    case MNG_CANVAS_RGB16   : break; */
-/*    case MNG_CANVAS_BGR16   : break; */
+#ifndef MNG_NO_16BIT_SUPPORT
+#ifndef MNG_SKIPCANVAS_RGB16
+    case MNG_CANVAS_RGB16   : break;
+#endif
+#ifndef MNG_SKIPCANVAS_BGR16
+    case MNG_CANVAS_BGR16   : break;
+#endif
+#endif
 /*    case MNG_CANVAS_INDEX8  : break; */
 /*    case MNG_CANVAS_GRAY8   : break; */
 /*    case MNG_CANVAS_GRAY16  : break; */
@@ -446,6 +494,205 @@ mng_retcode MNG_DECL mng_set_crcmode (mng_handle hHandle,
 
 /* ************************************************************************** */
 
+#ifdef MNG_SUPPORT_SIMD
+mng_retcode MNG_DECL mng_set_simd (mng_handle hHandle,
+                                   mng_uint32 iSIMD)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_SIMD, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)
+                                       /* can't use what isn't there! */
+  ((mng_datap)hHandle)->iSIMDflags = iSIMD & ((mng_datap)hHandle)->iSIMDcaps;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_SIMD, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_SUPPORT_SIMD */
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_KEYFRAMES
+mng_retcode MNG_DECL mng_set_keyframecache (mng_handle hHandle,
+                                            mng_uint32 iInterval,
+                                            mng_uint32 iMaxmemory)
+{
+  mng_datap pData;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_KEYFRAMECACHE, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)
+  pData = (mng_datap)hHandle;
+
+  pData->iKeyframeinterval = iInterval;
+  pData->iKeyframemaxmem   = iMaxmemory;
+                                       /* start afresh */
+  mng_drop_keyframes (pData);
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_KEYFRAMECACHE, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_SUPPORT_KEYFRAMES */
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_MEMPOOL
+mng_retcode MNG_DECL mng_set_mempool (mng_handle hHandle,
+                                      mng_bool   bMempool)
+{
+  mng_datap pData;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_MEMPOOL, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)
+  pData = (mng_datap)hHandle;
+                                       /* can't switch with structures around
+                                          that came from the other allocator */
+  if ((pData->iPoolcurrent)
+#if defined(MNG_SUPPORT_READ) || defined(MNG_SUPPORT_WRITE)
+      || (pData->pFirstchunk)
+#endif
+#ifdef MNG_SUPPORT_DISPLAY
+      || (pData->pFirstaniobj)
+#ifdef MNG_SUPPORT_DYNAMICMNG
+      || (pData->pFirstevent)
+#endif
+#ifdef MNG_INCLUDE_MPNG_PROPOSAL
+      || (pData->pMPNG)
+#endif
+#ifdef MNG_INCLUDE_ANG_PROPOSAL
+      || (pData->pANG)
+#endif
+#endif
+     )
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID);
+
+  pData->bMempool = bMempool;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_MEMPOOL, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_SUPPORT_MEMPOOL */
+
+/* ************************************************************************** */
+
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_FULL_CMS)
+mng_retcode MNG_DECL mng_set_cmscache (mng_handle hHandle,
+                                       mng_uint32 iSize)
+{
+  mng_datap pData;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_CMSCACHE, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)
+  pData = (mng_datap)hHandle;
+
+  if (iSize > MNG_CMSCACHESIZE)        /* there's only so much room */
+    iSize = MNG_CMSCACHESIZE;
+
+  mng_drop_cmscache (pData);           /* start afresh */
+
+  pData->iCmscachesize = iSize;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_CMSCACHE, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_SUPPORT_DISPLAY && MNG_FULL_CMS */
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_PARALLEL
+mng_retcode MNG_DECL mng_set_decodethreads (mng_handle hHandle,
+                                            mng_uint32 iThreads)
+{
+  mng_datap pData;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_DECODETHREADS, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)
+  pData = (mng_datap)hHandle;
+
+  if (pData->pDecodepool)              /* not while they're at it */
+    MNG_ERROR (pData, MNG_FUNCTIONINVALID);
+
+  if (iThreads > MNG_MAXDECODETHREADS) /* enough is enough */
+    iThreads = MNG_MAXDECODETHREADS;
+
+  pData->iDecodethreads = iThreads;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_DECODETHREADS, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_SUPPORT_PARALLEL */
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_DISPLAY
+mng_retcode MNG_DECL mng_set_virtualclock (mng_handle hHandle,
+                                           mng_bool   bVirtualclock)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_VIRTUALCLOCK, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)
+  ((mng_datap)hHandle)->bVirtualclock = bVirtualclock;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_VIRTUALCLOCK, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_SUPPORT_DISPLAY */
+
+/* ************************************************************************** */
+
+#if defined(MNG_SUPPORT_DISPLAY) && !defined(MNG_SKIPCHUNK_MAGN)
+mng_retcode MNG_DECL mng_set_lazymagnify (mng_handle hHandle,
+                                          mng_bool   bLazymagnify)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_LAZYMAGNIFY, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)
+  ((mng_datap)hHandle)->bLazymagnify = bLazymagnify;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_LAZYMAGNIFY, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_SUPPORT_DISPLAY && !MNG_SKIPCHUNK_MAGN */
+
+/* ************************************************************************** */
+
 #ifdef MNG_SUPPORT_DISPLAY
 mng_retcode MNG_DECL mng_set_srgb (mng_handle hHandle,
                                    mng_bool   bIssRGB)
@@ -485,6 +732,8 @@ mng_retcode MNG_DECL mng_set_outputprofile (mng_handle hHandle,
 
   pData = (mng_datap)hHandle;          /* address the structure */
 
+  mng_drop_cmscache (pData);           /* cached transforms used the old one */
+
   if (pData->hProf2)                   /* previously defined ? */
     mnglcms_freeprofile (pData->hProf2);
                                        /* allocate new CMS profile handle */
@@ -524,6 +773,8 @@ mng_retcode MNG_DECL mng_set_outputprofile2 (mng_handle hHandle,
 
   pData = (mng_datap)hHandle;          /* address the structure */
 
+  mng_drop_cmscache (pData);           /* cached transforms used the old one */
+
   if (pData->hProf2)                   /* previously defined ? */
     mnglcms_freeprofile (pData->hProf2);
                                        /* allocate new CMS profile handle */
@@ -559,6 +810,8 @@ mng_retcode MNG_DECL mng_set_outputsrgb (mng_handle hHandle)
 
   pData = (mng_datap)hHandle;          /* address the structure */
 
+  mng_drop_cmscache (pData);           /* cached transforms used the old one */
+
   if (pData->hProf2)                   /* previously defined ? */
     mnglcms_freeprofile (pData->hProf2);
                                        /* allocate new CMS profile handle */
@@ -594,6 +847,8 @@ mng_retcode MNG_DECL mng_set_srgbprofile (mng_handle hHandle,
 
   pData = (mng_datap)hHandle;          /* address the structure */
 
+  mng_drop_cmscache (pData);           /* cached transforms used the old one */
+
   if (pData->hProf3)                   /* previously defined ? */
     mnglcms_freeprofile (pData->hProf3);
                                        /* allocate new CMS profile handle */
@@ -631,6 +886,8 @@ mng_retcode MNG_DECL mng_set_srgbprofile2 (mng_handle hHandle,
 
   pData = (mng_datap)hHandle;          /* address the structure */
 
+  mng_drop_cmscache (pData);           /* cached transforms used the old one */
+
   if (pData->hProf3)                   /* previously defined ? */
     mnglcms_freeprofile (pData->hProf3);
                                        /* allocate new CMS profile handle */
@@ -665,6 +922,8 @@ mng_retcode MNG_DECL mng_set_srgbimplicit (mng_handle hHandle)
 
   pData = (mng_datap)hHandle;          /* address the structure */
 
+  mng_drop_cmscache (pData);           /* cached transforms used the old one */
+
   if (pData->hProf3)                   /* previously defined ? */
     mnglcms_freeprofile (pData->hProf3);
                                        /* allocate new CMS profile handle */
@@ -1014,6 +1273,31 @@ mng_retcode MNG_DECL mng_set_zlib_maxidat (mng_handle hHandle,
 
 /* ************************************************************************** */
 
+#if defined(MNG_INCLUDE_ZLIB) && defined(MNG_ACCESS_ZLIB) && defined(MNG_SUPPORT_WRITE)
+mng_retcode MNG_DECL mng_set_filterselection (mng_handle hHandle,
+                                              mng_uint8  iFiltersel)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_FILTERSELECTION, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)
+
+  if (iFiltersel > MNG_FILTERSEL_FULL)
+    MNG_ERROR (((mng_datap)hHandle), MNG_INVALIDFILTER)
+
+  ((mng_datap)hHandle)->iFiltersel = iFiltersel;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (((mng_datap)hHandle), MNG_FN_SET_FILTERSELECTION, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_INCLUDE_ZLIB && MNG_ACCESS_ZLIB && MNG_SUPPORT_WRITE */
+
+/* ************************************************************************** */
+
 #ifdef MNG_INCLUDE_JNG
 #ifdef MNG_ACCESS_JPEG
 #ifdef MNG_SUPPORT_WRITE
@@ -1841,6 +2125,259 @@ mng_uint32 MNG_DECL mng_get_crcmode (mng_handle hHandle)
 
 /* ************************************************************************** */
 
+#ifdef MNG_SUPPORT_SIMD
+mng_uint32 MNG_DECL mng_get_simd (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_SIMD, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_SIMD, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->iSIMDflags;
+}
+#endif /* MNG_SUPPORT_SIMD */
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_KEYFRAMES
+mng_uint32 MNG_DECL mng_get_keyframecount (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_KEYFRAMECOUNT, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_KEYFRAMECOUNT, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->iKeyframecount;
+}
+
+/* ************************************************************************** */
+
+mng_uint32 MNG_DECL mng_get_keyframememory (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_KEYFRAMEMEMORY, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_KEYFRAMEMEMORY, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->iKeyframememory;
+}
+#endif /* MNG_SUPPORT_KEYFRAMES */
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_MEMPOOL
+mng_bool MNG_DECL mng_get_mempool (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_MEMPOOL, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_MEMPOOL, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->bMempool;
+}
+
+/* ************************************************************************** */
+
+mng_uint32 MNG_DECL mng_get_mempoolcurrent (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_MEMPOOLCURRENT, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_MEMPOOLCURRENT, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->iPoolcurrent;
+}
+
+/* ************************************************************************** */
+
+mng_uint32 MNG_DECL mng_get_mempoolpeak (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_MEMPOOLPEAK, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_MEMPOOLPEAK, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->iPoolpeak;
+}
+#endif /* MNG_SUPPORT_MEMPOOL */
+
+/* ************************************************************************** */
+
+#if defined(MNG_SUPPORT_DISPLAY) && defined(MNG_FULL_CMS)
+mng_uint32 MNG_DECL mng_get_cmscachehits (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_CMSCACHEHITS, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_CMSCACHEHITS, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->iCmscachehits;
+}
+
+/* ************************************************************************** */
+
+mng_uint32 MNG_DECL mng_get_cmscachemisses (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_CMSCACHEMISSES, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_CMSCACHEMISSES, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->iCmscachemisses;
+}
+#endif /* MNG_SUPPORT_DISPLAY && MNG_FULL_CMS */
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_PARALLEL
+mng_uint32 MNG_DECL mng_get_decodethreads (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_DECODETHREADS, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_DECODETHREADS, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->iDecodethreads;
+}
+#endif /* MNG_SUPPORT_PARALLEL */
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_DISPLAY
+mng_bool MNG_DECL mng_get_virtualclock (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_VIRTUALCLOCK, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_VIRTUALCLOCK, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->bVirtualclock;
+}
+#endif /* MNG_SUPPORT_DISPLAY */
+
+/* ************************************************************************** */
+
+#if defined(MNG_SUPPORT_DISPLAY) && !defined(MNG_SKIPCHUNK_MAGN)
+mng_bool MNG_DECL mng_get_lazymagnify (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_LAZYMAGNIFY, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_LAZYMAGNIFY, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->bLazymagnify;
+}
+#endif /* MNG_SUPPORT_DISPLAY && !MNG_SKIPCHUNK_MAGN */
+
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_DISPLAY
+mng_uint32 MNG_DECL mng_get_dirtyrectcount (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_DIRTYRECTCOUNT, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEB (((mng_datap)hHandle), MNG_FN_GET_DIRTYRECTCOUNT, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->sDirtydone.iCount;
+}
+
+/* ************************************************************************** */
+
+mng_retcode MNG_DECL mng_get_dirtyrect (mng_handle  hHandle,
+                                        mng_uint32  iIndex,
+                                        mng_uint32* iX,
+                                        mng_uint32* iY,
+                                        mng_uint32* iWidth,
+                                        mng_uint32* iHeight)
+{
+  mng_dirtyrect *pRect;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEX (((mng_datap)hHandle), MNG_FN_GET_DIRTYRECT, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLE (hHandle)
+
+  if (iIndex >= ((mng_datap)hHandle)->sDirtydone.iCount)
+    MNG_ERROR (((mng_datap)hHandle), MNG_INVALIDINDEX);
+
+  pRect    = &((mng_datap)hHandle)->sDirtydone.aRects [iIndex];
+  *iX      = (mng_uint32)pRect->iLeft;
+  *iY      = (mng_uint32)pRect->iTop;
+  *iWidth  = (mng_uint32)(pRect->iRight  - pRect->iLeft);
+  *iHeight = (mng_uint32)(pRect->iBottom - pRect->iTop );
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEX (((mng_datap)hHandle), MNG_FN_GET_DIRTYRECT, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+#endif /* MNG_SUPPORT_DISPLAY */
+
+/* ************************************************************************** */
+
 #ifdef MNG_SUPPORT_DISPLAY
 mng_bool MNG_DECL mng_get_srgb (mng_handle hHandle)
 {
@@ -2140,6 +2677,25 @@ mng_uint32 MNG_DECL mng_get_zlib_maxidat (mng_handle hHandle)
 
 /* ************************************************************************** */
 
+#if defined(MNG_INCLUDE_ZLIB) && defined(MNG_ACCESS_ZLIB)
+mng_uint8 MNG_DECL mng_get_filterselection (mng_handle hHandle)
+{
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEX (((mng_datap)hHandle), MNG_FN_GET_FILTERSELECTION, MNG_LC_START);
+#endif
+
+  MNG_VALIDHANDLEX (hHandle)
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACEX (((mng_datap)hHandle), MNG_FN_GET_FILTERSELECTION, MNG_LC_END);
+#endif
+
+  return ((mng_datap)hHandle)->iFiltersel;
+}
+#endif /* MNG_INCLUDE_ZLIB && MNG_ACCESS_ZLIB */
+
+/* ************************************************************************** */
+
 #ifdef MNG_INCLUDE_JNG
 #ifdef MNG_ACCESS_JPEG
 mngjpeg_dctmethod MNG_DECL mng_get_jpeg_dctmethod (mng_handle hHandle)
@@ -108,6 +108,22 @@
 /* *             1.0.10 - 04/08/2007 - G.Juyn                               * */
 /* *             - added support for mPNG proposal                          * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - moved the chunk-table out of process_raw_chunk so it     * */
+/* *               isn't rebuilt for every chunk                            * */
+/* *             - keep a running total of pushed data instead of summing   * */
+/* *               the list on every read                                   * */
+/* *             - pushed data bypasses the suspension-buffer when there's  * */
+/* *               enough of it                                             * */
+/* *             - fixed pushed data being read out of order in             * */
+/* *               suspension-mode                                          * */
+/* *             - added mng_read_memory; chunks are indexed in one pass    * */
+/* *               and processed straight from the application's buffer     * */
+/* *             - made the chunk tables const (thread-safety audit)        * */
+/* *             - mng_drop_memindex stops the decode workers               * */
+/* *             - the chunk-table moved to libmng_chunk_descr.c; chunks    * */
+/* *               are looked up with mng_get_chunkheader in both configs   * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -121,12 +137,13 @@
 #include "libmng_objects.h"
 #include "libmng_object_prc.h"
 #include "libmng_chunks.h"
-#ifdef MNG_OPTIMIZE_CHUNKREADER
 #include "libmng_chunk_descr.h"
-#endif
 #include "libmng_chunk_prc.h"
 #include "libmng_chunk_io.h"
 #include "libmng_display.h"
+#ifdef MNG_SUPPORT_PARALLEL
+#include "libmng_zlib.h"
+#endif
 #include "libmng_read.h"
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -145,8 +162,9 @@ mng_retcode mng_process_eof (mng_datap pData)
   {
     pData->bEOF = MNG_TRUE;            /* now we do! */
 
-#ifndef MNG_NO_OPEN_CLOSE_STREAM
-    if (pData->fClosestream && !pData->fClosestream ((mng_handle)pData))
+#ifndef MNG_NO_OPEN_CLOSE_STREAM      /* (there's no stream when reading memory) */
+    if ((pData->fClosestream) && (!pData->pMemdata) &&
+        (!pData->fClosestream ((mng_handle)pData)))
     {
       MNG_ERROR (pData, MNG_APPIOERROR);
     }
@@ -168,6 +186,7 @@ mng_retcode mng_release_pushdata (mng_datap pData)
 #endif
 
   pData->pFirstpushdata = pNext;       /* next becomes the first */
+  pData->iPushsize     -= pFirst->iRemaining;
 
   if (!pNext)                          /* no next? => no last! */
     pData->pLastpushdata = MNG_NULL;
@@ -218,6 +237,82 @@ mng_retcode mng_release_pushchunk (mng_datap pData)
 
 /* ************************************************************************** */
 
+mng_retcode mng_index_memory (mng_datap pData)
+{
+  mng_uint32    iOffset = 0;
+  mng_uint32    iLength;
+  mng_memchunkp pTemp;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_INDEX_MEMORY, MNG_LC_START);
+#endif
+
+  if (!pData->bHavesig)                /* skip the signature */
+    iOffset = 2 * sizeof (mng_uint32);
+                                       /* as long as there's a complete chunk */
+  while ((pData->iMemdatasize >= iOffset + 12) &&
+         (pData->iMemdatasize - iOffset - 12 >= mng_get_uint32 (pData->pMemdata + iOffset)))
+  {
+    iLength = mng_get_uint32 (pData->pMemdata + iOffset);
+
+    if (iLength > 0x7ffffff)           /* leave that one to read_memchunk */
+      break;
+
+    if (pData->iMemchunks >= pData->iMemindexsize)
+    {                                  /* need a larger index ? */
+      MNG_ALLOC (pData, pTemp, (pData->iMemindexsize + 256) * sizeof (mng_memchunk));
+
+      if (pData->iMemchunks)
+      {
+        MNG_COPY (pTemp, pData->pMemindex, pData->iMemchunks * sizeof (mng_memchunk));
+        MNG_FREEX (pData, pData->pMemindex, pData->iMemindexsize * sizeof (mng_memchunk));
+      }
+
+      pData->pMemindex      = pTemp;
+      pData->iMemindexsize += 256;
+    }
+
+    pTemp          = pData->pMemindex + pData->iMemchunks;
+    pTemp->iOffset = iOffset;
+    pTemp->iLength = iLength;
+
+    pData->iMemchunks++;
+    iOffset += iLength + 12;           /* length, name, data & crc */
+  }
+
+  pData->iMemdataend = iOffset;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_INDEX_MEMORY, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mng_drop_memindex (mng_datap pData)
+{
+#ifdef MNG_SUPPORT_PARALLEL
+  mngzlib_decodestop (pData);          /* the workers use the index too */
+#endif
+
+  if (pData->pMemindex)
+    MNG_FREEX (pData, pData->pMemindex, pData->iMemindexsize * sizeof (mng_memchunk));
+
+  pData->pMemdata      = MNG_NULL;     /* the data itself belongs to the app */
+  pData->iMemdatasize  = 0;
+  pData->pMemindex     = MNG_NULL;
+  pData->iMemindexsize = 0;
+  pData->iMemchunks    = 0;
+  pData->iMemchunknext = 0;
+  pData->iMemdataend   = 0;
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
 MNG_LOCAL mng_retcode read_data (mng_datap    pData,
                                  mng_uint8p   pBuf,
                                  mng_uint32   iSize,
@@ -226,21 +321,14 @@ MNG_LOCAL mng_retcode read_data (mng_datap    pData,
   mng_retcode   iRetcode;
   mng_uint32    iTempsize = iSize;
   mng_uint8p    pTempbuf  = pBuf;
-  mng_pushdatap pPush     = pData->pFirstpushdata;
-  mng_uint32    iPushsize = 0;
+  mng_pushdatap pPush;
   *iRead                  = 0;         /* nothing yet */
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_READ_DATA, MNG_LC_START);
 #endif
-
-  while (pPush)                        /* calculate size of pushed data */
-  {
-    iPushsize += pPush->iRemaining;
-    pPush      = pPush->pNext;
-  }
-
-  if (iTempsize <= iPushsize)          /* got enough push data? */
+                                       /* got enough push data? */
+  if (iTempsize <= pData->iPushsize)
   {
     while (iTempsize)
     {
@@ -250,9 +338,11 @@ MNG_LOCAL mng_retcode read_data (mng_datap    pData,
       {                                /* no: then copy what we've got */
         MNG_COPY (pTempbuf, pPush->pDatanext, pPush->iRemaining);
                                        /* move pointers & lengths */
-        pTempbuf  += pPush->iRemaining;
-        *iRead    += pPush->iRemaining;
-        iTempsize -= pPush->iRemaining;
+        pTempbuf          += pPush->iRemaining;
+        *iRead            += pPush->iRemaining;
+        iTempsize         -= pPush->iRemaining;
+        pData->iPushsize  -= pPush->iRemaining;
+        pPush->iRemaining  = 0;
                                        /* release the depleted buffer */
         iRetcode = mng_release_pushdata (pData);
         if (iRetcode)
@@ -264,6 +354,7 @@ MNG_LOCAL mng_retcode read_data (mng_datap    pData,
                                        /* move pointers & lengths */
         pPush->iRemaining -= iTempsize;
         pPush->pDatanext  += iTempsize;
+        pData->iPushsize  -= iTempsize;
         pTempbuf          += iTempsize;
         *iRead            += iTempsize;
         iTempsize         = 0;         /* all done!!! */
@@ -305,6 +396,7 @@ MNG_LOCAL mng_retcode read_databuffer (mng_datap    pData,
   {
     mng_uint8p pTemp;
     mng_uint32 iTemp;
+    mng_uint32 iWant;
 
     *iRead = 0;                        /* let's be negative about the outcome */
 
@@ -339,8 +431,12 @@ MNG_LOCAL mng_retcode read_databuffer (mng_datap    pData,
       }
                                        /* calculate how much to get */
       iRemain = iSize - (mng_uint32)(*pBufnext - pBuf);
+      iWant   = iRemain;
+                                       /* take what's been pushed so far */
+      if ((pData->iPushsize) && (pData->iPushsize < iWant))
+        iWant = pData->iPushsize;
                                        /* let's go get it */
-      iRetcode = read_data (pData, *pBufnext, iRemain, &iTemp);
+      iRetcode = read_data (pData, *pBufnext, iWant, &iTemp);
       if (iRetcode)
         return iRetcode;
                                        /* first read after suspension return 0 means EOF */
@@ -365,6 +461,13 @@ MNG_LOCAL mng_retcode read_databuffer (mng_datap    pData,
         }
       }
     }
+    else                               /* enough pushed data to do without */
+    if ((!pData->iSuspendbufleft) && (iSize <= pData->iPushsize))
+    {                                  /* the suspension-buffer ? */
+      iRetcode = read_data (pData, pBuf, iSize, iRead);
+      if (iRetcode)
+        return iRetcode;
+    }
     else
     {                                  /* need to read some more ? */
       while ((!pData->bSuspended) && (!pData->bEOF) && (iSize > pData->iSuspendbufleft))
@@ -383,8 +486,12 @@ MNG_LOCAL mng_retcode read_databuffer (mng_datap    pData,
           MNG_ERROR (pData, MNG_INTERNALERROR);
                                        /* now read some more data */
         pTemp = pData->pSuspendbufnext + pData->iSuspendbufleft;
+        iWant = MNG_SUSPENDREQUESTSIZE;
+                                       /* take what's been pushed so far */
+        if ((pData->iPushsize) && (pData->iPushsize < iWant))
+          iWant = pData->iPushsize;
 
-        iRetcode = read_data (pData, pTemp, MNG_SUSPENDREQUESTSIZE, &iTemp);
+        iRetcode = read_data (pData, pTemp, iWant, &iTemp);
         if (iRetcode)
           return iRetcode;
                                        /* adjust fill-counter */
@@ -448,338 +555,7 @@ MNG_LOCAL mng_retcode process_raw_chunk (mng_datap  pData,
                                          mng_uint8p pBuf,
                                          mng_uint32 iBuflen)
 {
-
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  /* the table-idea & binary search code was adapted from
-     libpng 1.1.0 (pngread.c) */
-  /* NOTE1: the table must remain sorted by chunkname, otherwise the binary
-     search will break !!! (ps. watch upper-/lower-case chunknames !!) */
-  /* NOTE2: the layout must remain equal to the header part of all the
-     chunk-structures (yes, that means even the pNext and pPrev fields;
-     it's wasting a bit of space, but hey, the code is a lot easier) */
-
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-  mng_chunk_header mng_chunk_unknown = {MNG_UINT_HUH, mng_init_general, mng_free_unknown,
-                                        mng_read_unknown, mng_write_unknown, mng_assign_unknown, 0, 0, sizeof(mng_unknown_chunk)};
-#else
-  mng_chunk_header mng_chunk_unknown = {MNG_UINT_HUH, mng_init_unknown, mng_free_unknown,
-                                        mng_read_unknown, mng_write_unknown, mng_assign_unknown, 0, 0};
-#endif
-
-#ifdef MNG_OPTIMIZE_CHUNKINITFREE
-
-  mng_chunk_header mng_chunk_table [] =
-  {
-#ifndef MNG_SKIPCHUNK_BACK
-    {MNG_UINT_BACK, mng_init_general, mng_free_general, mng_read_back, mng_write_back, mng_assign_general, 0, 0, sizeof(mng_back)},
-#endif
-#ifndef MNG_SKIPCHUNK_BASI
-    {MNG_UINT_BASI, mng_init_general, mng_free_general, mng_read_basi, mng_write_basi, mng_assign_general, 0, 0, sizeof(mng_basi)},
-#endif
-#ifndef MNG_SKIPCHUNK_CLIP
-    {MNG_UINT_CLIP, mng_init_general, mng_free_general, mng_read_clip, mng_write_clip, mng_assign_general, 0, 0, sizeof(mng_clip)},
-#endif
-#ifndef MNG_SKIPCHUNK_CLON
-    {MNG_UINT_CLON, mng_init_general, mng_free_general, mng_read_clon, mng_write_clon, mng_assign_general, 0, 0, sizeof(mng_clon)},
-#endif
-#ifndef MNG_NO_DELTA_PNG
-#ifndef MNG_SKIPCHUNK_DBYK
-    {MNG_UINT_DBYK, mng_init_general, mng_free_dbyk,    mng_read_dbyk, mng_write_dbyk, mng_assign_dbyk,    0, 0, sizeof(mng_dbyk)},
-#endif
-#endif
-#ifndef MNG_SKIPCHUNK_DEFI
-    {MNG_UINT_DEFI, mng_init_general, mng_free_general, mng_read_defi, mng_write_defi, mng_assign_general, 0, 0, sizeof(mng_defi)},
-#endif
-#ifndef MNG_NO_DELTA_PNG
-    {MNG_UINT_DHDR, mng_init_general, mng_free_general, mng_read_dhdr, mng_write_dhdr, mng_assign_general, 0, 0, sizeof(mng_dhdr)},
-#endif
-#ifndef MNG_SKIPCHUNK_DISC
-    {MNG_UINT_DISC, mng_init_general, mng_free_disc,    mng_read_disc, mng_write_disc, mng_assign_disc,    0, 0, sizeof(mng_disc)},
-#endif
-#ifndef MNG_NO_DELTA_PNG
-#ifndef MNG_SKIPCHUNK_DROP
-    {MNG_UINT_DROP, mng_init_general, mng_free_drop,    mng_read_drop, mng_write_drop, mng_assign_drop,    0, 0, sizeof(mng_drop)},
-#endif
-#endif
-#ifndef MNG_SKIPCHUNK_LOOP
-    {MNG_UINT_ENDL, mng_init_general, mng_free_general, mng_read_endl, mng_write_endl, mng_assign_general, 0, 0, sizeof(mng_endl)},
-#endif
-#ifndef MNG_SKIPCHUNK_FRAM
-    {MNG_UINT_FRAM, mng_init_general, mng_free_fram,    mng_read_fram, mng_write_fram, mng_assign_fram,    0, 0, sizeof(mng_fram)},
-#endif
-    {MNG_UINT_IDAT, mng_init_general, mng_free_idat,    mng_read_idat, mng_write_idat, mng_assign_idat,    0, 0, sizeof(mng_idat)},  /* 12-th element! */
-    {MNG_UINT_IEND, mng_init_general, mng_free_general, mng_read_iend, mng_write_iend, mng_assign_general, 0, 0, sizeof(mng_iend)},
-    {MNG_UINT_IHDR, mng_init_general, mng_free_general, mng_read_ihdr, mng_write_ihdr, mng_assign_general, 0, 0, sizeof(mng_ihdr)},
-#ifndef MNG_NO_DELTA_PNG
-#ifdef MNG_INCLUDE_JNG
-    {MNG_UINT_IJNG, mng_init_general, mng_free_general, mng_read_ijng, mng_write_ijng, mng_assign_general, 0, 0, sizeof(mng_ijng)},
-#endif
-    {MNG_UINT_IPNG, mng_init_general, mng_free_general, mng_read_ipng, mng_write_ipng, mng_assign_general, 0, 0, sizeof(mng_ipng)},
-#endif
-#ifdef MNG_INCLUDE_JNG
-    {MNG_UINT_JDAA, mng_init_general, mng_free_jdaa,    mng_read_jdaa, mng_write_jdaa, mng_assign_jdaa,    0, 0, sizeof(mng_jdaa)},
-    {MNG_UINT_JDAT, mng_init_general, mng_free_jdat,    mng_read_jdat, mng_write_jdat, mng_assign_jdat,    0, 0, sizeof(mng_jdat)},
-    {MNG_UINT_JHDR, mng_init_general, mng_free_general, mng_read_jhdr, mng_write_jhdr, mng_assign_general, 0, 0, sizeof(mng_jhdr)},
-    {MNG_UINT_JSEP, mng_init_general, mng_free_general, mng_read_jsep, mng_write_jsep, mng_assign_general, 0, 0, sizeof(mng_jsep)},
-    {MNG_UINT_JdAA, mng_init_general, mng_free_jdaa,    mng_read_jdaa, mng_write_jdaa, mng_assign_jdaa,    0, 0, sizeof(mng_jdaa)},
-#endif
-#ifndef MNG_SKIPCHUNK_LOOP
-    {MNG_UINT_LOOP, mng_init_general, mng_free_loop,    mng_read_loop, mng_write_loop, mng_assign_loop,    0, 0, sizeof(mng_loop)},
-#endif
-#ifndef MNG_SKIPCHUNK_MAGN
-    {MNG_UINT_MAGN, mng_init_general, mng_free_general, mng_read_magn, mng_write_magn, mng_assign_general, 0, 0, sizeof(mng_magn)},
-#endif
-    {MNG_UINT_MEND, mng_init_general, mng_free_general, mng_read_mend, mng_write_mend, mng_assign_general, 0, 0, sizeof(mng_mend)},
-    {MNG_UINT_MHDR, mng_init_general, mng_free_general, mng_read_mhdr, mng_write_mhdr, mng_assign_general, 0, 0, sizeof(mng_mhdr)},
-#ifndef MNG_SKIPCHUNK_MOVE
-    {MNG_UINT_MOVE, mng_init_general, mng_free_general, mng_read_move, mng_write_move, mng_assign_general, 0, 0, sizeof(mng_move)},
-#endif
-#ifndef MNG_NO_DELTA_PNG
-#ifndef MNG_SKIPCHUNK_ORDR
-    {MNG_UINT_ORDR, mng_init_general, mng_free_ordr,    mng_read_ordr, mng_write_ordr, mng_assign_ordr,    0, 0, sizeof(mng_ordr)},
-#endif
-#endif
-#ifndef MNG_SKIPCHUNK_PAST
-    {MNG_UINT_PAST, mng_init_general, mng_free_past,    mng_read_past, mng_write_past, mng_assign_past,    0, 0, sizeof(mng_past)},
-#endif
-    {MNG_UINT_PLTE, mng_init_general, mng_free_general, mng_read_plte, mng_write_plte, mng_assign_general, 0, 0, sizeof(mng_plte)},
-#ifndef MNG_NO_DELTA_PNG
-    {MNG_UINT_PPLT, mng_init_general, mng_free_general, mng_read_pplt, mng_write_pplt, mng_assign_general, 0, 0, sizeof(mng_pplt)},
-    {MNG_UINT_PROM, mng_init_general, mng_free_general, mng_read_prom, mng_write_prom, mng_assign_general, 0, 0, sizeof(mng_prom)},
-#endif
-#ifndef MNG_SKIPCHUNK_SAVE
-    {MNG_UINT_SAVE, mng_init_general, mng_free_save,    mng_read_save, mng_write_save, mng_assign_save,    0, 0, sizeof(mng_save)},
-#endif
-#ifndef MNG_SKIPCHUNK_SEEK
-    {MNG_UINT_SEEK, mng_init_general, mng_free_seek,    mng_read_seek, mng_write_seek, mng_assign_seek,    0, 0, sizeof(mng_seek)},
-#endif
-#ifndef MNG_SKIPCHUNK_SHOW
-    {MNG_UINT_SHOW, mng_init_general, mng_free_general, mng_read_show, mng_write_show, mng_assign_general, 0, 0, sizeof(mng_show)},
-#endif
-#ifndef MNG_SKIPCHUNK_TERM
-    {MNG_UINT_TERM, mng_init_general, mng_free_general, mng_read_term, mng_write_term, mng_assign_general, 0, 0, sizeof(mng_term)},
-#endif
-#ifndef MNG_SKIPCHUNK_bKGD
-    {MNG_UINT_bKGD, mng_init_general, mng_free_general, mng_read_bkgd, mng_write_bkgd, mng_assign_general, 0, 0, sizeof(mng_bkgd)},
-#endif
-#ifndef MNG_SKIPCHUNK_cHRM
-    {MNG_UINT_cHRM, mng_init_general, mng_free_general, mng_read_chrm, mng_write_chrm, mng_assign_general, 0, 0, sizeof(mng_chrm)},
-#endif
-#ifndef MNG_SKIPCHUNK_eXPI
-    {MNG_UINT_eXPI, mng_init_general, mng_free_expi,    mng_read_expi, mng_write_expi, mng_assign_expi,    0, 0, sizeof(mng_expi)},
-#endif
-#ifndef MNG_SKIPCHUNK_evNT
-    {MNG_UINT_evNT, mng_init_general, mng_free_evnt,    mng_read_evnt, mng_write_evnt, mng_assign_evnt,    0, 0, sizeof(mng_evnt)},
-#endif
-#ifndef MNG_SKIPCHUNK_fPRI
-    {MNG_UINT_fPRI, mng_init_general, mng_free_general, mng_read_fpri, mng_write_fpri, mng_assign_general, 0, 0, sizeof(mng_fpri)},
-#endif
-#ifndef MNG_SKIPCHUNK_gAMA
-    {MNG_UINT_gAMA, mng_init_general, mng_free_general, mng_read_gama, mng_write_gama, mng_assign_general, 0, 0, sizeof(mng_gama)},
-#endif
-#ifndef MNG_SKIPCHUNK_hIST
-    {MNG_UINT_hIST, mng_init_general, mng_free_general, mng_read_hist, mng_write_hist, mng_assign_general, 0, 0, sizeof(mng_hist)},
-#endif
-#ifndef MNG_SKIPCHUNK_iCCP
-    {MNG_UINT_iCCP, mng_init_general, mng_free_iccp,    mng_read_iccp, mng_write_iccp, mng_assign_iccp,    0, 0, sizeof(mng_iccp)},
-#endif
-#ifndef MNG_SKIPCHUNK_iTXt
-    {MNG_UINT_iTXt, mng_init_general, mng_free_itxt,    mng_read_itxt, mng_write_itxt, mng_assign_itxt,    0, 0, sizeof(mng_itxt)},
-#endif
-#ifdef MNG_INCLUDE_MPNG_PROPOSAL
-    {MNG_UINT_mpNG, mng_init_general, mng_free_mpng,    mng_read_mpng, mng_write_mpng, mng_assign_mpng,    0, 0, sizeof(mng_mpng)},
-#endif
-#ifndef MNG_SKIPCHUNK_nEED
-    {MNG_UINT_nEED, mng_init_general, mng_free_need,    mng_read_need, mng_write_need, mng_assign_need,    0, 0, sizeof(mng_need)},
-#endif
-/* TODO:     {MNG_UINT_oFFs, 0, 0, 0, 0, 0, 0},  */
-/* TODO:     {MNG_UINT_pCAL, 0, 0, 0, 0, 0, 0},  */
-#ifndef MNG_SKIPCHUNK_pHYg
-    {MNG_UINT_pHYg, mng_init_general, mng_free_general, mng_read_phyg, mng_write_phyg, mng_assign_general, 0, 0, sizeof(mng_phyg)},
-#endif
-#ifndef MNG_SKIPCHUNK_pHYs
-    {MNG_UINT_pHYs, mng_init_general, mng_free_general, mng_read_phys, mng_write_phys, mng_assign_general, 0, 0, sizeof(mng_phys)},
-#endif
-#ifndef MNG_SKIPCHUNK_sBIT
-    {MNG_UINT_sBIT, mng_init_general, mng_free_general, mng_read_sbit, mng_write_sbit, mng_assign_general, 0, 0, sizeof(mng_sbit)},
-#endif
-/* TODO:     {MNG_UINT_sCAL, 0, 0, 0, 0, 0, 0},  */
-#ifndef MNG_SKIPCHUNK_sPLT
-    {MNG_UINT_sPLT, mng_init_general, mng_free_splt,    mng_read_splt, mng_write_splt, mng_assign_splt,    0, 0, sizeof(mng_splt)},
-#endif
-    {MNG_UINT_sRGB, mng_init_general, mng_free_general, mng_read_srgb, mng_write_srgb, mng_assign_general, 0, 0, sizeof(mng_srgb)},
-#ifndef MNG_SKIPCHUNK_tEXt
-    {MNG_UINT_tEXt, mng_init_general, mng_free_text,    mng_read_text, mng_write_text, mng_assign_text,    0, 0, sizeof(mng_text)},
-#endif
-#ifndef MNG_SKIPCHUNK_tIME
-    {MNG_UINT_tIME, mng_init_general, mng_free_general, mng_read_time, mng_write_time, mng_assign_general, 0, 0, sizeof(mng_time)},
-#endif
-    {MNG_UINT_tRNS, mng_init_general, mng_free_general, mng_read_trns, mng_write_trns, mng_assign_general, 0, 0, sizeof(mng_trns)},
-#ifndef MNG_SKIPCHUNK_zTXt
-    {MNG_UINT_zTXt, mng_init_general, mng_free_ztxt,    mng_read_ztxt, mng_write_ztxt, mng_assign_ztxt,    0, 0, sizeof(mng_ztxt)},
-#endif
-  };
-
-#else                        /* MNG_OPTIMIZE_CHUNKINITFREE */
-
-  mng_chunk_header mng_chunk_table [] =
-  {
-#ifndef MNG_SKIPCHUNK_BACK
-    {MNG_UINT_BACK, mng_init_back, mng_free_back, mng_read_back, mng_write_back, mng_assign_back, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_BASI
-    {MNG_UINT_BASI, mng_init_basi, mng_free_basi, mng_read_basi, mng_write_basi, mng_assign_basi, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_CLIP
-    {MNG_UINT_CLIP, mng_init_clip, mng_free_clip, mng_read_clip, mng_write_clip, mng_assign_clip, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_CLON
-    {MNG_UINT_CLON, mng_init_clon, mng_free_clon, mng_read_clon, mng_write_clon, mng_assign_clon, 0, 0},
-#endif
-#ifndef MNG_NO_DELTA_PNG
-#ifndef MNG_SKIPCHUNK_DBYK
-    {MNG_UINT_DBYK, mng_init_dbyk, mng_free_dbyk, mng_read_dbyk, mng_write_dbyk, mng_assign_dbyk, 0, 0},
-#endif
-#endif
-#ifndef MNG_SKIPCHUNK_DEFI
-    {MNG_UINT_DEFI, mng_init_defi, mng_free_defi, mng_read_defi, mng_write_defi, mng_assign_defi, 0, 0},
-#endif
-#ifndef MNG_NO_DELTA_PNG
-    {MNG_UINT_DHDR, mng_init_dhdr, mng_free_dhdr, mng_read_dhdr, mng_write_dhdr, mng_assign_dhdr, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_DISC
-    {MNG_UINT_DISC, mng_init_disc, mng_free_disc, mng_read_disc, mng_write_disc, mng_assign_disc, 0, 0},
-#endif
-#ifndef MNG_NO_DELTA_PNG
-#ifndef MNG_SKIPCHUNK_DROP
-    {MNG_UINT_DROP, mng_init_drop, mng_free_drop, mng_read_drop, mng_write_drop, mng_assign_drop, 0, 0},
-#endif
-#endif
-#ifndef MNG_SKIPCHUNK_LOOP
-    {MNG_UINT_ENDL, mng_init_endl, mng_free_endl, mng_read_endl, mng_write_endl, mng_assign_endl, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_FRAM
-    {MNG_UINT_FRAM, mng_init_fram, mng_free_fram, mng_read_fram, mng_write_fram, mng_assign_fram, 0, 0},
-#endif
-    {MNG_UINT_IDAT, mng_init_idat, mng_free_idat, mng_read_idat, mng_write_idat, mng_assign_idat, 0, 0},  /* 12-th element! */
-    {MNG_UINT_IEND, mng_init_iend, mng_free_iend, mng_read_iend, mng_write_iend, mng_assign_iend, 0, 0},
-    {MNG_UINT_IHDR, mng_init_ihdr, mng_free_ihdr, mng_read_ihdr, mng_write_ihdr, mng_assign_ihdr, 0, 0},
-#ifndef MNG_NO_DELTA_PNG
-#ifdef MNG_INCLUDE_JNG
-    {MNG_UINT_IJNG, mng_init_ijng, mng_free_ijng, mng_read_ijng, mng_write_ijng, mng_assign_ijng, 0, 0},
-#endif
-    {MNG_UINT_IPNG, mng_init_ipng, mng_free_ipng, mng_read_ipng, mng_write_ipng, mng_assign_ipng, 0, 0},
-#endif
-#ifdef MNG_INCLUDE_JNG
-    {MNG_UINT_JDAA, mng_init_jdaa, mng_free_jdaa, mng_read_jdaa, mng_write_jdaa, mng_assign_jdaa, 0, 0},
-    {MNG_UINT_JDAT, mng_init_jdat, mng_free_jdat, mng_read_jdat, mng_write_jdat, mng_assign_jdat, 0, 0},
-    {MNG_UINT_JHDR, mng_init_jhdr, mng_free_jhdr, mng_read_jhdr, mng_write_jhdr, mng_assign_jhdr, 0, 0},
-    {MNG_UINT_JSEP, mng_init_jsep, mng_free_jsep, mng_read_jsep, mng_write_jsep, mng_assign_jsep, 0, 0},
-    {MNG_UINT_JdAA, mng_init_jdaa, mng_free_jdaa, mng_read_jdaa, mng_write_jdaa, mng_assign_jdaa, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_LOOP
-    {MNG_UINT_LOOP, mng_init_loop, mng_free_loop, mng_read_loop, mng_write_loop, mng_assign_loop, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_MAGN
-    {MNG_UINT_MAGN, mng_init_magn, mng_free_magn, mng_read_magn, mng_write_magn, mng_assign_magn, 0, 0},
-#endif
-    {MNG_UINT_MEND, mng_init_mend, mng_free_mend, mng_read_mend, mng_write_mend, mng_assign_mend, 0, 0},
-    {MNG_UINT_MHDR, mng_init_mhdr, mng_free_mhdr, mng_read_mhdr, mng_write_mhdr, mng_assign_mhdr, 0, 0},
-#ifndef MNG_SKIPCHUNK_MOVE
-    {MNG_UINT_MOVE, mng_init_move, mng_free_move, mng_read_move, mng_write_move, mng_assign_move, 0, 0},
-#endif
-#ifndef MNG_NO_DELTA_PNG
-#ifndef MNG_SKIPCHUNK_ORDR
-    {MNG_UINT_ORDR, mng_init_ordr, mng_free_ordr, mng_read_ordr, mng_write_ordr, mng_assign_ordr, 0, 0},
-#endif
-#endif
-#ifndef MNG_SKIPCHUNK_PAST
-    {MNG_UINT_PAST, mng_init_past, mng_free_past, mng_read_past, mng_write_past, mng_assign_past, 0, 0},
-#endif
-    {MNG_UINT_PLTE, mng_init_plte, mng_free_plte, mng_read_plte, mng_write_plte, mng_assign_plte, 0, 0},
-#ifndef MNG_NO_DELTA_PNG
-    {MNG_UINT_PPLT, mng_init_pplt, mng_free_pplt, mng_read_pplt, mng_write_pplt, mng_assign_pplt, 0, 0},
-    {MNG_UINT_PROM, mng_init_prom, mng_free_prom, mng_read_prom, mng_write_prom, mng_assign_prom, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_SAVE
-    {MNG_UINT_SAVE, mng_init_save, mng_free_save, mng_read_save, mng_write_save, mng_assign_save, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_SEEK
-    {MNG_UINT_SEEK, mng_init_seek, mng_free_seek, mng_read_seek, mng_write_seek, mng_assign_seek, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_SHOW
-    {MNG_UINT_SHOW, mng_init_show, mng_free_show, mng_read_show, mng_write_show, mng_assign_show, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_TERM
-    {MNG_UINT_TERM, mng_init_term, mng_free_term, mng_read_term, mng_write_term, mng_assign_term, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_bKGD
-    {MNG_UINT_bKGD, mng_init_bkgd, mng_free_bkgd, mng_read_bkgd, mng_write_bkgd, mng_assign_bkgd, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_cHRM
-    {MNG_UINT_cHRM, mng_init_chrm, mng_free_chrm, mng_read_chrm, mng_write_chrm, mng_assign_chrm, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_eXPI
-    {MNG_UINT_eXPI, mng_init_expi, mng_free_expi, mng_read_expi, mng_write_expi, mng_assign_expi, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_evNT
-    {MNG_UINT_evNT, mng_init_evnt, mng_free_evnt, mng_read_evnt, mng_write_evnt, mng_assign_evnt, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_fPRI
-    {MNG_UINT_fPRI, mng_init_fpri, mng_free_fpri, mng_read_fpri, mng_write_fpri, mng_assign_fpri, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_gAMA
-    {MNG_UINT_gAMA, mng_init_gama, mng_free_gama, mng_read_gama, mng_write_gama, mng_assign_gama, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_hIST
-    {MNG_UINT_hIST, mng_init_hist, mng_free_hist, mng_read_hist, mng_write_hist, mng_assign_hist, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_iCCP
-    {MNG_UINT_iCCP, mng_init_iccp, mng_free_iccp, mng_read_iccp, mng_write_iccp, mng_assign_iccp, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_iTXt
-    {MNG_UINT_iTXt, mng_init_itxt, mng_free_itxt, mng_read_itxt, mng_write_itxt, mng_assign_itxt, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_nEED
-    {MNG_UINT_nEED, mng_init_need, mng_free_need, mng_read_need, mng_write_need, mng_assign_need, 0, 0},
-#endif
-/* TODO:     {MNG_UINT_oFFs, 0, 0, 0, 0, 0, 0},  */
-/* TODO:     {MNG_UINT_pCAL, 0, 0, 0, 0, 0, 0},  */
-#ifndef MNG_SKIPCHUNK_pHYg
-    {MNG_UINT_pHYg, mng_init_phyg, mng_free_phyg, mng_read_phyg, mng_write_phyg, mng_assign_phyg, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_pHYs
-    {MNG_UINT_pHYs, mng_init_phys, mng_free_phys, mng_read_phys, mng_write_phys, mng_assign_phys, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_sBIT
-    {MNG_UINT_sBIT, mng_init_sbit, mng_free_sbit, mng_read_sbit, mng_write_sbit, mng_assign_sbit, 0, 0},
-#endif
-/* TODO:     {MNG_UINT_sCAL, 0, 0, 0, 0, 0, 0},  */
-#ifndef MNG_SKIPCHUNK_sPLT
-    {MNG_UINT_sPLT, mng_init_splt, mng_free_splt, mng_read_splt, mng_write_splt, mng_assign_splt, 0, 0},
-#endif
-    {MNG_UINT_sRGB, mng_init_srgb, mng_free_srgb, mng_read_srgb, mng_write_srgb, mng_assign_srgb, 0, 0},
-#ifndef MNG_SKIPCHUNK_tEXt
-    {MNG_UINT_tEXt, mng_init_text, mng_free_text, mng_read_text, mng_write_text, mng_assign_text, 0, 0},
-#endif
-#ifndef MNG_SKIPCHUNK_tIME
-    {MNG_UINT_tIME, mng_init_time, mng_free_time, mng_read_time, mng_write_time, mng_assign_time, 0, 0},
-#endif
-    {MNG_UINT_tRNS, mng_init_trns, mng_free_trns, mng_read_trns, mng_write_trns, mng_assign_trns, 0, 0},
-#ifndef MNG_SKIPCHUNK_zTXt
-    {MNG_UINT_zTXt, mng_init_ztxt, mng_free_ztxt, mng_read_ztxt, mng_write_ztxt, mng_assign_ztxt, 0, 0},
-#endif
-  };
-
-#endif                       /* MNG_OPTIMIZE_CHUNKINITFREE */
-
-                                       /* binary search variables */
-  mng_int32         iTop, iLower, iUpper, iMiddle;
-  mng_chunk_headerp pEntry;            /* pointer to found entry */
-#else
   mng_chunk_header  sEntry;            /* temp chunk-header */
-#endif /* MNG_OPTIMIZE_CHUNKREADER */
-
   mng_chunkid       iChunkname;        /* the chunk's tag */
   mng_chunkp        pChunk;            /* chunk structure (if #define MNG_STORE_CHUNKS) */
   mng_retcode       iRetcode;          /* temporary error-code */
@@ -797,60 +573,11 @@ MNG_LOCAL mng_retcode process_raw_chunk (mng_datap  pData,
   iBuflen -= sizeof (mng_chunkid);
   pChunk = 0;
 
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-                                       /* determine max index of table */
-  iTop = (sizeof (mng_chunk_table) / sizeof (mng_chunk_table [0])) - 1;
-
-  /* binary search; with 54 chunks, worst-case is 7 comparisons */
-  iLower  = 0;
-#ifndef MNG_NO_DELTA_PNG
-  iMiddle = 11;                        /* start with the IDAT entry */
-#else
-  iMiddle = 8;
-#endif
-  iUpper  = iTop;
-  pEntry  = 0;                         /* no goods yet! */
-
-  do                                   /* the binary search itself */
-    {
-      if (mng_chunk_table [iMiddle].iChunkname < iChunkname)
-        iLower = iMiddle + 1;
-      else if (mng_chunk_table [iMiddle].iChunkname > iChunkname)
-        iUpper = iMiddle - 1;
-      else
-      {
-        pEntry = &mng_chunk_table [iMiddle];
-        break;
-      }
-
-      iMiddle = (iLower + iUpper) >> 1;
-    }
-  while (iLower <= iUpper);
-
-  if (!pEntry)                         /* unknown chunk ? */
-    pEntry = &mng_chunk_unknown;       /* make it so! */
-
-#else /* MNG_OPTIMIZE_CHUNKREADER */
-
   mng_get_chunkheader (iChunkname, &sEntry);
 
-#endif /* MNG_OPTIMIZE_CHUNKREADER */
-
   pData->iChunkname = iChunkname;      /* keep track of where we are */
   pData->iChunkseq++;
 
-#ifndef MNG_OPTIMIZE_CHUNKREADER
-  if (pEntry->fRead)                   /* read-callback available ? */
-  {
-    iRetcode = pEntry->fRead (pData, pEntry, iBuflen, (mng_ptr)pBuf, &pChunk);
-
-    if (!iRetcode)                     /* everything oke ? */
-    {                                  /* remember unknown chunk's id */
-      if ((pChunk) && (pEntry->iChunkname == MNG_UINT_HUH))
-        ((mng_chunk_headerp)pChunk)->iChunkname = iChunkname;
-    }
-  }
-#else /* MNG_OPTIMIZE_CHUNKREADER */
   if (sEntry.fRead)                    /* read-callback available ? */
   {
     iRetcode = sEntry.fRead (pData, &sEntry, iBuflen, (mng_ptr)pBuf, &pChunk);
@@ -863,7 +590,6 @@ MNG_LOCAL mng_retcode process_raw_chunk (mng_datap  pData,
     }
 #endif
   }
-#endif /* MNG_OPTIMIZE_CHUNKREADER */
   else
     iRetcode = MNG_NOERROR;
 
@@ -958,6 +684,63 @@ MNG_LOCAL mng_retcode check_chunk_crc (mng_datap  pData,
 
 /* ************************************************************************** */
 
+MNG_LOCAL mng_retcode read_memchunk (mng_datap pData)
+{
+  mng_memchunkp pChunk;
+  mng_uint8p    pBuf;
+  mng_uint8p    pTemp;
+  mng_uint32    iBuflen;
+  mng_uint32    iEnd;
+  mng_retcode   iRetcode;
+
+  if (pData->iMemchunknext < pData->iMemchunks)
+  {                                    /* next chunk from the index */
+    pChunk = pData->pMemindex + pData->iMemchunknext;
+    pBuf   = pData->pMemdata + pChunk->iOffset + sizeof (mng_uint32);
+    iEnd   = pChunk->iOffset + pChunk->iLength + 12;
+
+    pData->iMemchunknext++;
+    pData->iChunklen = pChunk->iLength;
+
+    if (pData->iCrcmode & MNG_CRC_INPUT)
+      iBuflen = pChunk->iLength + (mng_uint32)(sizeof (mng_chunkid) + sizeof (mng_uint32));
+    else
+      iBuflen = pChunk->iLength + (mng_uint32)(sizeof (mng_chunkid));
+
+    if (iBuflen > 16777216)            /* is the length incredible? */
+      MNG_ERROR (pData, MNG_IMPROBABLELENGTH);
+                                       /* the chunk-readers count on a zero-byte
+                                          somewhere after the data; the length-field
+                                          of the next chunk usually provides it */
+    if ((iEnd < pData->iMemdatasize) && (!*(pData->pMemdata + iEnd)))
+      return check_chunk_crc (pData, pBuf, iBuflen);
+                                       /* otherwise use a terminated copy */
+    MNG_ALLOC (pData, pTemp, iBuflen + 1);
+    MNG_COPY (pTemp, pBuf, iBuflen);
+
+    iRetcode = check_chunk_crc (pData, pTemp, iBuflen);
+
+    MNG_FREEX (pData, pTemp, iBuflen + 1);
+
+    return iRetcode;
+  }
+                                       /* ran out before the closing IEND/MEND */
+  iRetcode = mng_process_eof (pData);
+
+  if (iRetcode)                        /* on error bail out */
+    return iRetcode;
+                                       /* stopped at an invalid length ? */
+  if ((pData->iMemdatasize - pData->iMemdataend >= sizeof (mng_uint32)) &&
+      (mng_get_uint32 (pData->pMemdata + pData->iMemdataend) > 0x7ffffff))
+    return MNG_INVALIDLENGTH;
+
+  MNG_ERROR (pData, MNG_UNEXPECTEDEOF);
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
 MNG_LOCAL mng_retcode read_chunk (mng_datap  pData)
 {
   mng_uint32  iBufmax   = pData->iReadbufsize;
@@ -1046,6 +829,14 @@ MNG_LOCAL mng_retcode read_chunk (mng_datap  pData)
       pData->bRunning = MNG_FALSE;     /* then this is the right moment to do it */
 #endif
 
+    if (pData->pMemdata)               /* reading from memory ? */
+    {
+      iRetcode = read_memchunk (pData);
+
+      if (iRetcode)                    /* on error bail out */
+        return iRetcode;
+    }
+    else
     if (pData->iSuspendpoint <= 2)
     {
       iBuflen  = sizeof (mng_uint32);  /* read length */
@@ -1065,7 +856,7 @@ MNG_LOCAL mng_retcode read_chunk (mng_datap  pData)
 
     }
 
-    if (!pData->bSuspended)            /* still going ? */
+    if ((!pData->pMemdata) && (!pData->bSuspended))
     {                                  /* previously suspended or not eof ? */
       if ((pData->iSuspendpoint > 2) || (iRead == iBuflen))
       {                                /* determine length chunkname + data (+ crc) */
@@ -1075,12 +866,16 @@ MNG_LOCAL mng_retcode read_chunk (mng_datap  pData)
           iBuflen = pData->iChunklen + (mng_uint32)(sizeof (mng_chunkid));
 
                                        /* do we have enough data in the current push buffer ? */
-        if ((pData->pFirstpushdata) && (iBuflen <= pData->pFirstpushdata->iRemaining))
+                                       /* (and nothing buffered yet from earlier reads) */
+        if ((pData->pFirstpushdata) && (!pData->iSuspendbufleft) &&
+            (pData->iSuspendpoint != 4) &&
+            (iBuflen <= pData->pFirstpushdata->iRemaining))
         {
           mng_pushdatap pPush  = pData->pFirstpushdata;
           pBuf                 = pPush->pDatanext;
           pPush->pDatanext    += iBuflen;
           pPush->iRemaining   -= iBuflen;
+          pData->iPushsize    -= iBuflen;
           pData->iSuspendpoint = 0;    /* safely reset this here ! */
 
           iRetcode = check_chunk_crc (pData, pBuf, iBuflen);
@@ -1280,13 +1075,14 @@ mng_retcode mng_read_graphic (mng_datap pData)
 {
   mng_uint32  iBuflen;                 /* number of bytes requested */
   mng_uint32  iRead;                   /* number of bytes read */
+  mng_uint8p  pSig;                    /* where the signature ends up */
   mng_retcode iRetcode;                /* temporary error-code */
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_READ_GRAPHIC, MNG_LC_START);
 #endif
-
-  if (!pData->pReadbuf)                /* buffer allocated ? */
+                                       /* buffer allocated ? */
+  if ((!pData->pReadbuf) && (!pData->pMemdata))
   {
     pData->iReadbufsize = 4200;        /* allocate a default read buffer */
     MNG_ALLOC (pData, pData->pReadbuf, pData->iReadbufsize);
@@ -1296,10 +1092,19 @@ mng_retcode mng_read_graphic (mng_datap pData)
   {
     iBuflen = 2 * sizeof (mng_uint32); /* read signature */
 
-    iRetcode = read_databuffer (pData, pData->pReadbuf, &pData->pReadbufnext, iBuflen, &iRead);
+    if (pData->pMemdata)               /* straight from memory ? */
+    {
+      pSig  = pData->pMemdata;
+      iRead = (pData->iMemdatasize < iBuflen) ? pData->iMemdatasize : iBuflen;
+    }
+    else
+    {
+      pSig     = pData->pReadbuf;
+      iRetcode = read_databuffer (pData, pSig, &pData->pReadbufnext, iBuflen, &iRead);
 
-    if (iRetcode)
-      return iRetcode;
+      if (iRetcode)
+        return iRetcode;
+    }
 
     if (pData->bSuspended)             /* input suspension ? */
       pData->iSuspendpoint = 1;
@@ -1308,20 +1113,20 @@ mng_retcode mng_read_graphic (mng_datap pData)
       if (iRead != iBuflen)            /* full signature received ? */
         MNG_ERROR (pData, MNG_UNEXPECTEDEOF);
                                        /* is it a valid signature ? */
-      if (mng_get_uint32 (pData->pReadbuf) == PNG_SIG)
+      if (mng_get_uint32 (pSig) == PNG_SIG)
         pData->eSigtype = mng_it_png;
       else
 #ifdef MNG_INCLUDE_JNG
-      if (mng_get_uint32 (pData->pReadbuf) == JNG_SIG)
+      if (mng_get_uint32 (pSig) == JNG_SIG)
         pData->eSigtype = mng_it_jng;
       else
 #endif
-      if (mng_get_uint32 (pData->pReadbuf) == MNG_SIG)
+      if (mng_get_uint32 (pSig) == MNG_SIG)
         pData->eSigtype = mng_it_mng;
       else
         MNG_ERROR (pData, MNG_INVALIDSIG);
                                        /* all of it ? */
-      if (mng_get_uint32 (pData->pReadbuf+4) != POST_SIG)
+      if (mng_get_uint32 (pSig+4) != POST_SIG)
         MNG_ERROR (pData, MNG_INVALIDSIG);
 
       pData->bHavesig = MNG_TRUE;
@@ -25,6 +25,9 @@
 /* *             1.0.8 - 04/12/2004 - G.Juyn                                * */
 /* *             - added data-push mechanisms for specialized decoders      * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added chunk-index routines for mng_read_memory           * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -42,6 +45,10 @@ mng_retcode mng_release_pushdata  (mng_datap pData);
 
 mng_retcode mng_release_pushchunk (mng_datap pData);
 
+mng_retcode mng_index_memory      (mng_datap pData);
+
+mng_retcode mng_drop_memindex     (mng_datap pData);
+
 mng_retcode mng_read_graphic      (mng_datap pData);
 
 /* ************************************************************************** */
@@ -152,6 +152,24 @@
 /* *             - added support for mPNG proposal                          * */
 /* *             1.0.10 - 07/06/2007 - G.R-P bugfix by Lucas Quintana       * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added trace-codes for getimgdata extraction              * */
+/* *             - added trace-codes for the putimgdata encoder             * */
+/* *             - added trace-codes for the image-object index             * */
+/* *             - added trace-codes for the dirty-rectangle functions      * */
+/* *             - added trace-codes for the memory-pool                    * */
+/* *             - added trace-codes for mng_read_memory                    * */
+/* *             - added trace-codes for restore_rgb16/bgr16                * */
+/* *             - added gray row processing & retrieval                    * */
+/* *             - added init_fusedrow                                      * */
+/* *             - added clear_gammacache                                   * */
+/* *             - added trace-names for the transform cache                * */
+/* *             - added trace-codes for parallel decoding                  * */
+/* *             - added trace-codes for mng_render_frames and the virtual  * */
+/* *               clock                                                    * */
+/* *             - added trace-codes for mng_putframe                       * */
+/* *             - added trace-codes for magnify-on-display                 * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -197,6 +215,8 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_READ_PUSHDATA,             "read_pushdata"},
     {MNG_FN_READ_PUSHSIG,              "read_pushsig"},
     {MNG_FN_READ_PUSHCHUNK,            "read_pushchunk"},
+    {MNG_FN_READ_MEMORY,               "read_memory"},
+    {MNG_FN_RENDER_FRAMES,             "render_frames"},
 
     {MNG_FN_SETCB_MEMALLOC,            "setcb_memalloc"},
     {MNG_FN_SETCB_MEMFREE,             "setcb_memfree"},
@@ -307,6 +327,14 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_SET_CACHEPLAYBACK,         "set_cacheplayback"},
     {MNG_FN_SET_DOPROGRESSIVE,         "set_doprogressive"},
     {MNG_FN_SET_CRCMODE,               "set_crcmode"},
+    {MNG_FN_SET_SIMD,                  "set_simd"},
+    {MNG_FN_SET_KEYFRAMECACHE,         "set_keyframecache"},
+    {MNG_FN_SET_FILTERSELECTION,       "set_filterselection"},
+    {MNG_FN_SET_MEMPOOL,               "set_mempool"},
+    {MNG_FN_SET_CMSCACHE,              "set_cmscache"},
+    {MNG_FN_SET_DECODETHREADS,         "set_decodethreads"},
+    {MNG_FN_SET_VIRTUALCLOCK,          "set_virtualclock"},
+    {MNG_FN_SET_LAZYMAGNIFY,           "set_lazymagnify"},
 
     {MNG_FN_GET_USERDATA,              "get_userdata"},
     {MNG_FN_GET_SIGTYPE,               "get_sigtype"},
@@ -384,6 +412,20 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
 #endif
     {MNG_FN_GET_CRCMODE,               "get_crcmode"},
     {MNG_FN_GET_CURRFRAMDELAY,         "get_currframdelay"},
+    {MNG_FN_GET_SIMD,                  "get_simd"},
+    {MNG_FN_GET_KEYFRAMECOUNT,         "get_keyframecount"},
+    {MNG_FN_GET_KEYFRAMEMEMORY,        "get_keyframememory"},
+    {MNG_FN_GET_FILTERSELECTION,       "get_filterselection"},
+    {MNG_FN_GET_DIRTYRECTCOUNT,        "get_dirtyrectcount"},
+    {MNG_FN_GET_DIRTYRECT,             "get_dirtyrect"},
+    {MNG_FN_GET_MEMPOOL,               "get_mempool"},
+    {MNG_FN_GET_MEMPOOLCURRENT,        "get_mempoolcurrent"},
+    {MNG_FN_GET_MEMPOOLPEAK,           "get_mempoolpeak"},
+    {MNG_FN_GET_CMSCACHEHITS,          "get_cmscachehits"},
+    {MNG_FN_GET_CMSCACHEMISSES,        "get_cmscachemisses"},
+    {MNG_FN_GET_DECODETHREADS,         "get_decodethreads"},
+    {MNG_FN_GET_VIRTUALCLOCK,          "get_virtualclock"},
+    {MNG_FN_GET_LAZYMAGNIFY,           "get_lazymagnify"},
 
     {MNG_FN_STATUS_ERROR,              "status_error"},
     {MNG_FN_STATUS_READING,            "status_reading"},
@@ -676,6 +718,8 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_PUTIMGDATA_DHDR,           "putimgdata_dhdr"},
 #endif
 
+    {MNG_FN_PUTFRAME,                  "putframe"},
+
     {MNG_FN_UPDATEMNGHEADER,           "updatemngheader"},
     {MNG_FN_UPDATEMNGSIMPLICITY,       "updatemngsimplicity"},
 
@@ -712,6 +756,14 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_READ_DATA,                 "read_data"},
     {MNG_FN_READ_CHUNK_CRC,            "read_chunk_crc"},
     {MNG_FN_RELEASE_PUSHCHUNK,         "release_pushchunk"},
+    {MNG_FN_STORE_KEYFRAME,            "store_keyframe"},
+    {MNG_FN_RESTORE_KEYFRAME,          "restore_keyframe"},
+    {MNG_FN_DROP_KEYFRAMES,            "drop_keyframes"},
+    {MNG_FN_DECODE_IMGDATA,            "decode_imgdata"},
+    {MNG_FN_RELEASE_MEMPOOL,           "release_mempool"},
+    {MNG_FN_INDEX_MEMORY,              "index_memory"},
+    {MNG_FN_DROP_CMSCACHE,             "drop_cmscache"},
+    {MNG_FN_ENCODE_BLOCK,              "encode_block"},
 
     {MNG_FN_DISPLAY_RGB8,              "display_rgb8"},
     {MNG_FN_DISPLAY_RGBA8,             "display_rgba8"},
@@ -747,6 +799,7 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_DISPLAY_ARGB8_PM,          "display_argb8_pm"},
     {MNG_FN_DISPLAY_ABGR8_PM,          "display_abgr8_pm"},
     {MNG_FN_DISPLAY_BGR565_A8,         "display_bgr565_a8"},
+    {MNG_FN_DISPLAY_IMGDATA,           "display_imgdata"},
 
     {MNG_FN_INIT_FULL_CMS,             "init_full_cms"},
     {MNG_FN_CORRECT_FULL_CMS,          "correct_full_cms"},
@@ -757,6 +810,7 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_INIT_GAMMA_ONLY_OBJ,       "init_gamma_only_obj"},
     {MNG_FN_INIT_APP_CMS,              "init_app_cms"},
     {MNG_FN_INIT_APP_CMS_OBJ,          "init_app_cms_obj"},
+    {MNG_FN_CLEAR_GAMMACACHE,          "clear_gammacache"},
 
     {MNG_FN_PROCESS_G1,                "process_g1"},
     {MNG_FN_PROCESS_G2,                "process_g2"},
@@ -773,6 +827,11 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_PROCESS_GA16,              "process_ga16"},
     {MNG_FN_PROCESS_RGBA8,             "process_rgba8"},
     {MNG_FN_PROCESS_RGBA16,            "process_rgba16"},
+    {MNG_FN_PROCESS_G124_GRAY,         "process_g124_gray"},
+    {MNG_FN_PROCESS_G8_GRAY,           "process_g8_gray"},
+    {MNG_FN_PROCESS_G16_GRAY,          "process_g16_gray"},
+    {MNG_FN_PROCESS_GA8_GRAY,          "process_ga8_gray"},
+    {MNG_FN_PROCESS_GA16_GRAY,         "process_ga16_gray"},
 
     {MNG_FN_INIT_G1_I,                 "init_g1_i"},
     {MNG_FN_INIT_G2_I,                 "init_g2_i"},
@@ -807,6 +866,8 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_INIT_RGBA16_NI,            "init_rgba16_ni"},
 #endif
 
+    {MNG_FN_INIT_FUSEDROW,             "init_fusedrow"},
+    {MNG_FN_INIT_GRAYROW,              "init_grayrow"},
     {MNG_FN_INIT_ROWPROC,              "init_rowproc"},
     {MNG_FN_NEXT_ROW,                  "next_row"},
     {MNG_FN_CLEANUP_ROWPROC,           "cleanup_rowproc"},
@@ -816,6 +877,7 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_FILTER_UP,                 "filter_up"},
     {MNG_FN_FILTER_AVERAGE,            "filter_average"},
     {MNG_FN_FILTER_PAETH,              "filter_paeth"},
+    {MNG_FN_SELECT_FILTER,             "select_filter"},
 
     {MNG_FN_INIT_ROWDIFFERING,         "init_rowdiffering"},
     {MNG_FN_DIFFER_G1,                 "differ_g1"},
@@ -846,6 +908,8 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_PROMOTE_IMGOBJECT,         "promote_imgobject"},
     {MNG_FN_MAGNIFY_IMGOBJECT,         "magnify_imgobject"},
     {MNG_FN_COLORCORRECT_OBJECT,       "colorcorrect_object"},
+    {MNG_FN_UNINDEX_IMGOBJECT,         "unindex_imgobject"},
+    {MNG_FN_REINDEX_IMGOBJECTS,        "reindex_imgobjects"},
 
     {MNG_FN_STORE_G1,                  "store_g1"},
     {MNG_FN_STORE_G2,                  "store_g2"},
@@ -872,6 +936,11 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_RETRIEVE_GA16,             "retrieve_ga16"},
     {MNG_FN_RETRIEVE_RGBA8,            "retrieve_rgba8"},
     {MNG_FN_RETRIEVE_RGBA16,           "retrieve_rgba16"},
+    {MNG_FN_RETRIEVE_G8_GRAY,          "retrieve_g8_gray"},
+    {MNG_FN_RETRIEVE_G16_GRAY,         "retrieve_g16_gray"},
+    {MNG_FN_RETRIEVE_GA8_GRAY,         "retrieve_ga8_gray"},
+    {MNG_FN_RETRIEVE_GA16_GRAY,        "retrieve_ga16_gray"},
+    {MNG_FN_RETRIEVE_MAGNIFY,          "retrieve_magnify"},
 
 #ifndef MNG_NO_DELTA_PNG
     {MNG_FN_DELTA_G1,                  "delta_g1"},
@@ -1013,6 +1082,8 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_RESTORE_BKGD,              "restore_bkgd"},
     {MNG_FN_RESTORE_BGRX8,             "restore_bgrx8"},
     {MNG_FN_RESTORE_RGB565,            "restore_rgb565"},
+    {MNG_FN_RESTORE_RGB16,             "restore_rgb16"},
+    {MNG_FN_RESTORE_BGR16,             "restore_bgr16"},
 
     {MNG_FN_INIT_IHDR,                 "init_ihdr"},
     {MNG_FN_INIT_PLTE,                 "init_plte"},
@@ -1354,6 +1425,9 @@ MNG_LOCAL mng_trace_entry const trace_table [] =
     {MNG_FN_ZLIB_DEFLATEROWS,          "zlib_deflaterows"},
     {MNG_FN_ZLIB_DEFLATEDATA,          "zlib_deflatedata"},
     {MNG_FN_ZLIB_DEFLATEFREE,          "zlib_deflatefree"},
+    {MNG_FN_ZLIB_DECODESTART,          "zlib_decodestart"},
+    {MNG_FN_ZLIB_DECODESTOP,           "zlib_decodestop"},
+    {MNG_FN_ZLIB_INFLATEJOB,           "zlib_inflatejob"},
 
     {MNG_FN_PROCESS_DISPLAY_IHDR,      "process_display_ihdr"},
     {MNG_FN_PROCESS_DISPLAY_PLTE,      "process_display_plte"},
@@ -155,6 +155,24 @@
 /* *             - added support for mPNG proposal                          * */
 /* *             1.0.10 - 07/06/2007 - G.R-P bugfix by Lucas Quintana       * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added trace-codes for getimgdata extraction              * */
+/* *             - added trace-codes for the putimgdata encoder             * */
+/* *             - added trace-codes for the image-object index             * */
+/* *             - added trace-codes for the dirty-rectangle functions      * */
+/* *             - added trace-codes for the memory-pool                    * */
+/* *             - added trace-codes for mng_read_memory                    * */
+/* *             - added trace-codes for restore_rgb16/bgr16                * */
+/* *             - added gray row processing & retrieval                    * */
+/* *             - added init_fusedrow                                      * */
+/* *             - added MNG_FN_CLEAR_GAMMACACHE                            * */
+/* *             - added trace-codes for the transform cache                * */
+/* *             - added trace-codes for parallel decoding                  * */
+/* *             - added trace-codes for mng_render_frames and the virtual  * */
+/* *               clock                                                    * */
+/* *             - added trace-codes for mng_putframe                       * */
+/* *             - added trace-codes for magnify-on-display                 * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -227,6 +245,8 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_READ_PUSHDATA           18
 #define MNG_FN_READ_PUSHSIG            19
 #define MNG_FN_READ_PUSHCHUNK          20
+#define MNG_FN_READ_MEMORY             21
+#define MNG_FN_RENDER_FRAMES           22
 
 #define MNG_FN_SETCB_MEMALLOC         101
 #define MNG_FN_SETCB_MEMFREE          102
@@ -327,6 +347,14 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_SET_CACHEPLAYBACK      335
 #define MNG_FN_SET_DOPROGRESSIVE      336
 #define MNG_FN_SET_CRCMODE            337
+#define MNG_FN_SET_SIMD               338
+#define MNG_FN_SET_KEYFRAMECACHE      339
+#define MNG_FN_SET_FILTERSELECTION    340
+#define MNG_FN_SET_MEMPOOL            341
+#define MNG_FN_SET_CMSCACHE           342
+#define MNG_FN_SET_DECODETHREADS      343
+#define MNG_FN_SET_VIRTUALCLOCK       344
+#define MNG_FN_SET_LAZYMAGNIFY        345
 
 #define MNG_FN_GET_USERDATA           401
 #define MNG_FN_GET_SIGTYPE            402
@@ -390,6 +418,20 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_GET_TOTALPLAYTIME      460
 #define MNG_FN_GET_CRCMODE            461
 #define MNG_FN_GET_CURRFRAMDELAY      462
+#define MNG_FN_GET_SIMD               463
+#define MNG_FN_GET_KEYFRAMECOUNT      464
+#define MNG_FN_GET_KEYFRAMEMEMORY     465
+#define MNG_FN_GET_FILTERSELECTION    466
+#define MNG_FN_GET_DIRTYRECTCOUNT     467
+#define MNG_FN_GET_DIRTYRECT          468
+#define MNG_FN_GET_MEMPOOL            469
+#define MNG_FN_GET_MEMPOOLCURRENT     470
+#define MNG_FN_GET_MEMPOOLPEAK        471
+#define MNG_FN_GET_CMSCACHEHITS       472
+#define MNG_FN_GET_CMSCACHEMISSES     473
+#define MNG_FN_GET_DECODETHREADS      474
+#define MNG_FN_GET_VIRTUALCLOCK       475
+#define MNG_FN_GET_LAZYMAGNIFY        476
 
 #define MNG_FN_STATUS_ERROR           481
 #define MNG_FN_STATUS_READING         482
@@ -543,6 +585,7 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_PUTIMGDATA_JHDR        952
 #define MNG_FN_PUTIMGDATA_BASI        953
 #define MNG_FN_PUTIMGDATA_DHDR        954
+#define MNG_FN_PUTFRAME               955
 
 #define MNG_FN_UPDATEMNGHEADER        981
 #define MNG_FN_UPDATEMNGSIMPLICITY    982
@@ -580,6 +623,14 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_READ_DATA             1029
 #define MNG_FN_READ_CHUNK_CRC        1030
 #define MNG_FN_RELEASE_PUSHCHUNK     1031
+#define MNG_FN_STORE_KEYFRAME        1032
+#define MNG_FN_RESTORE_KEYFRAME      1033
+#define MNG_FN_DROP_KEYFRAMES        1034
+#define MNG_FN_DECODE_IMGDATA        1035
+#define MNG_FN_RELEASE_MEMPOOL       1036
+#define MNG_FN_INDEX_MEMORY          1037
+#define MNG_FN_DROP_CMSCACHE         1038
+#define MNG_FN_ENCODE_BLOCK          1039
 
 /* ************************************************************************** */
 
@@ -619,6 +670,7 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_DISPLAY_BGR565_A8     1134
 #define MNG_FN_DISPLAY_RGB555        1135
 #define MNG_FN_DISPLAY_BGR555        1136
+#define MNG_FN_DISPLAY_IMGDATA       1137
 
 /* ************************************************************************** */
 
@@ -631,6 +683,7 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_INIT_GAMMA_ONLY_OBJ   1208
 #define MNG_FN_INIT_APP_CMS          1209
 #define MNG_FN_INIT_APP_CMS_OBJ      1210
+#define MNG_FN_CLEAR_GAMMACACHE      1211
 
 /* ************************************************************************** */
 
@@ -649,6 +702,11 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_PROCESS_GA16          1313
 #define MNG_FN_PROCESS_RGBA8         1314
 #define MNG_FN_PROCESS_RGBA16        1315
+#define MNG_FN_PROCESS_G124_GRAY     1316
+#define MNG_FN_PROCESS_G8_GRAY       1317
+#define MNG_FN_PROCESS_G16_GRAY      1318
+#define MNG_FN_PROCESS_GA8_GRAY      1319
+#define MNG_FN_PROCESS_GA16_GRAY     1320
 
 /* ************************************************************************** */
 
@@ -683,6 +741,8 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_INIT_RGBA16_NI        1429
 #define MNG_FN_INIT_RGBA16_I         1430
 
+#define MNG_FN_INIT_FUSEDROW         1495
+#define MNG_FN_INIT_GRAYROW          1496
 #define MNG_FN_INIT_ROWPROC          1497
 #define MNG_FN_NEXT_ROW              1498
 #define MNG_FN_CLEANUP_ROWPROC       1499
@@ -694,6 +754,7 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_FILTER_UP             1503
 #define MNG_FN_FILTER_AVERAGE        1504
 #define MNG_FN_FILTER_PAETH          1505
+#define MNG_FN_SELECT_FILTER         1506
 
 #define MNG_FN_INIT_ROWDIFFERING     1551
 #define MNG_FN_DIFFER_G1             1552
@@ -726,6 +787,8 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_PROMOTE_IMGOBJECT     1610
 #define MNG_FN_MAGNIFY_IMGOBJECT     1611
 #define MNG_FN_COLORCORRECT_OBJECT   1612
+#define MNG_FN_UNINDEX_IMGOBJECT     1613
+#define MNG_FN_REINDEX_IMGOBJECTS    1614
 
 /* ************************************************************************** */
 
@@ -754,6 +817,11 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_RETRIEVE_GA16         1757
 #define MNG_FN_RETRIEVE_RGBA8        1758
 #define MNG_FN_RETRIEVE_RGBA16       1759
+#define MNG_FN_RETRIEVE_G8_GRAY      1760
+#define MNG_FN_RETRIEVE_G16_GRAY     1761
+#define MNG_FN_RETRIEVE_GA8_GRAY     1762
+#define MNG_FN_RETRIEVE_GA16_GRAY    1763
+#define MNG_FN_RETRIEVE_MAGNIFY      1764
 
 #define MNG_FN_DELTA_G1              1771
 #define MNG_FN_DELTA_G2              1772
@@ -884,6 +952,8 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_RESTORE_BGRX8         2107
 #define MNG_FN_RESTORE_RGB565        2108
 #define MNG_FN_RESTORE_BGR565        2109
+#define MNG_FN_RESTORE_RGB16         2110
+#define MNG_FN_RESTORE_BGR16         2111
 
 /* ************************************************************************** */
 
@@ -1187,6 +1257,9 @@ mng_retcode mng_trace (mng_datap  pData,
 #define MNG_FN_ZLIB_DEFLATEROWS      3008
 #define MNG_FN_ZLIB_DEFLATEDATA      3009
 #define MNG_FN_ZLIB_DEFLATEFREE      3010
+#define MNG_FN_ZLIB_DECODESTART      3011
+#define MNG_FN_ZLIB_DECODESTOP       3012
+#define MNG_FN_ZLIB_INFLATEJOB       3013
 
 /* ************************************************************************** */
 
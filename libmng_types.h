@@ -126,6 +126,19 @@
 /* *             1.0.10 - 04/12/2007 - G.Juyn                               * */
 /* *             - added support for ANG proposal                           * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - added default filter-selection                           * */
+/* *             - added size of multi-row inflate buffer                   * */
+/* *             - added MNG_OBJINDEXSIZE                                   * */
+/* *             - added MNG_DIRTYRECTS                                     * */
+/* *             - added memory-pool size-classes                           * */
+/* *             - added MNG_GAMMACACHESIZE                                 * */
+/* *             - added MNG_CMSCACHESIZE                                   * */
+/* *             - added MNG_MAXDECODETHREADS, MNG_DECODEAHEAD and          * */
+/* *               MNG_ZLIB_WORKERMEM                                       * */
+/* *             - added mng_renderframe callback type                      * */
+/* *             - added MNG_PASTBANDSIZE                                   * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #ifndef _libmng_types_h_
@@ -197,6 +210,10 @@
 #include <jpeglib.h>                   /* all that for JPEG support  :-) */
 #endif /* MNG_INCLUDE_IJG6B */
 
+#ifdef MNG_SUPPORT_PARALLEL            /* worker-threads for decoding */
+#include <pthread.h>
+#endif
+
 #if defined(MNG_INTERNAL_MEMMNGMT) || defined(MNG_INCLUDE_FILTERS)
 #include <stdlib.h>                    /* "calloc" & "free" & "abs" */
 #endif
@@ -333,6 +350,33 @@ typedef mng_uint32      mng_uint32arr2[2];
 #define MNG_SUSPENDBUFFERSIZE  32768
 #define MNG_SUSPENDREQUESTSIZE  1024
 
+/* number of buckets for indexing image-objects by id; must be a power of 2 */
+#define MNG_OBJINDEXSIZE         256
+
+/* maximum number of dirty-rectangles collected per refresh */
+#define MNG_DIRTYRECTS            16
+
+/* number of gamma-tables kept per handle, keyed by their exponent */
+#define MNG_GAMMACACHESIZE         4
+
+/* maximum (and default) number of lcms transforms kept per handle */
+#define MNG_CMSCACHESIZE           8
+
+/* maximum number of decode-workers per handle, and how many images each of
+   them may be ahead of the reader */
+#define MNG_MAXDECODETHREADS      16
+#define MNG_DECODEAHEAD            2
+
+/* memory-pool size-classes (in steps of MNG_POOLGRANULE bytes) and the size
+   of the blocks ("slabs") they are carved from; larger requests bypass it */
+#define MNG_POOLGRANULE           16
+#define MNG_POOLCLASSES           32
+#define MNG_POOLSLABSIZE       16384
+
+/* number of target-bytes a PAST pastes all its sources onto in one go, so the
+   rows are still in cache for each next source */
+#define MNG_PASTBANDSIZE       65536
+
 /* ************************************************************************** */
 
 #ifdef MNG_INCLUDE_ZLIB
@@ -340,6 +384,12 @@ typedef mng_uint32      mng_uint32arr2[2];
 /* size of temporary zlib buffer for deflate processing */
 #define MNG_ZLIB_MAXBUF     8192
 
+/* size of the multi-row buffer for inflating non-interlaced images */
+#define MNG_ZLIB_ROWBUF     32768
+
+/* memory for the inflate-stream of each decode-worker (state + window) */
+#define MNG_ZLIB_WORKERMEM  65536
+
 /* default zlib compression parameters for deflateinit2 */
 #define MNG_ZLIB_LEVEL      9                    /* level */
 #define MNG_ZLIB_METHOD     Z_DEFLATED           /* method */
@@ -349,6 +399,8 @@ typedef mng_uint32      mng_uint32arr2[2];
 
 #define MNG_MAX_IDAT_SIZE   4096                 /* maximum size of IDAT data */
 
+#define MNG_ZLIB_FILTERSEL  MNG_FILTERSEL_FULL   /* default filter-selection */
+
 #endif /* MNG_INCLUDE_ZLIB */
 
 /* ************************************************************************** */
@@ -530,6 +582,14 @@ typedef mng_bool   (MNG_DECL *mng_refresh)       (mng_handle  hHandle,
                                                   mng_uint32  iY,
                                                   mng_uint32  iWidth,
                                                   mng_uint32  iHeight);
+typedef mng_bool   (MNG_DECL *mng_renderframe)   (mng_handle  hHandle,
+                                                  mng_ptr     pCanvas,
+                                                  mng_uint32  iRowsize,
+                                                  mng_uint32  iDelay,
+                                                  mng_uint32  iX,
+                                                  mng_uint32  iY,
+                                                  mng_uint32  iWidth,
+                                                  mng_uint32  iHeight);
 
                                        /* timer management callbacks */
 typedef mng_uint32 (MNG_DECL *mng_gettickcount)  (mng_handle  hHandle);
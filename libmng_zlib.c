@@ -50,6 +50,14 @@
 /* *             1.0.9 - 10/09/2004 - G.R-P                                 * */
 /* *             - added MNG_NO_1_2_4BIT_SUPPORT support                    * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - filled the deflaterows routine (streams IDAT chunks)     * */
+/* *             - inflaterows handles non-interlaced images several rows   * */
+/* *               at a time                                                * */
+/* *             - added worker threads that inflate and unfilter the IDAT  * */
+/* *               data of coming images ahead of mng_read_memory           * */
+/* *               (MNG_SUPPORT_PARALLEL)                                   * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #include "libmng.h"
@@ -180,6 +188,246 @@ mng_retcode mngzlib_inflateinit (mng_datap pData)
 
 /* ************************************************************************** */
 
+#ifdef MNG_SUPPORT_DISPLAY
+MNG_LOCAL mng_retcode inflated_row (mng_datap pData)
+{                                      /* handles one row in pWorkrow */
+  mng_retcode iRslt;
+  mng_ptr     pSwap;
+
+#ifdef MNG_NO_1_2_4BIT_SUPPORT
+  if (pData->iPNGdepth == 1)
+  {
+    /* Inflate Workrow to 8-bit */
+    mng_int32  iX;
+    mng_uint8p pSrc = pData->pWorkrow+1;
+    mng_uint8p pDest = pSrc + pData->iRowsize - (pData->iRowsize+7)/8;
+
+    for (iX = ((pData->iRowsize+7)/8) ; iX > 0 ; iX--)
+       *pDest++ = *pSrc++;
+
+    pDest = pData->pWorkrow+1;
+    pSrc = pDest + pData->iRowsize - (pData->iRowsize+7)/8;
+    for (iX = pData->iRowsize; ;)
+    {
+      *pDest++ = (((*pSrc)>>7)&1);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)>>6)&1);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)>>5)&1);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)>>4)&1);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)>>3)&1);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)>>2)&1);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)>>1)&1);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)   )&1);
+      if (iX-- <= 0)
+        break;
+      pSrc++;
+    }
+  }
+  else if (pData->iPNGdepth == 2)
+  {
+    /* Inflate Workrow to 8-bit */
+    mng_int32  iX;
+    mng_uint8p pSrc = pData->pWorkrow+1;
+    mng_uint8p pDest = pSrc + pData->iRowsize - (2*pData->iRowsize+7)/8;
+
+    for (iX = ((2*pData->iRowsize+7)/8) ; iX > 0 ; iX--)
+       *pDest++ = *pSrc++;
+
+    pDest = pData->pWorkrow+1;
+    pSrc = pDest + pData->iRowsize - (2*pData->iRowsize+7)/8;
+    for (iX = pData->iRowsize; ;)
+    {
+      *pDest++ = (((*pSrc)>>6)&3);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)>>4)&3);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)>>2)&3);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)   )&3);
+      if (iX-- <= 0)
+        break;
+      pSrc++;
+    }
+  }
+  else if (pData->iPNGdepth == 4)
+  {
+    /* Inflate Workrow to 8-bit */
+    mng_int32  iX;
+    mng_uint8p pSrc = pData->pWorkrow+1;
+    mng_uint8p pDest = pSrc + pData->iRowsize - (4*pData->iRowsize+7)/8;
+
+    for (iX = ((4*pData->iRowsize+7)/8) ; iX > 0 ; iX--)
+       *pDest++ = *pSrc++;
+
+    pDest = pData->pWorkrow+1;
+    pSrc = pDest + pData->iRowsize - (4*pData->iRowsize+7)/8;
+    for (iX = pData->iRowsize; ;)
+    {
+      *pDest++ = (((*pSrc)>>4)&0x0f);
+      if (iX-- <= 0)
+        break;
+      *pDest++ = (((*pSrc)   )&0x0f);
+      if (iX-- <= 0)
+        break;
+      pSrc++;
+    }
+  }
+  if (pData->iPNGdepth < 8 && pData->iColortype == 0)
+  {
+    /* Expand samples to 8-bit by LBR */
+    mng_int32  iX;
+    mng_uint8p pSrc = pData->pWorkrow+1;
+    mng_uint8 multiplier[]={0,255,85,0,17,0,0,0,1};
+
+    for (iX = pData->iRowsize; iX > 0; iX--)
+        *pSrc++ *= multiplier[pData->iPNGdepth];
+  }
+#endif
+#ifdef MNG_NO_16BIT_SUPPORT
+  if (pData->iPNGdepth > 8)
+  {
+    /* Reduce Workrow to 8-bit */
+    mng_int32  iX;
+    mng_uint8p pSrc = pData->pWorkrow+1;
+    mng_uint8p pDest = pSrc;
+
+    for (iX = pData->iRowsize; iX > 0; iX--)
+    {
+      *pDest = *pSrc;
+      pDest++;
+      pSrc+=2;
+    }
+  }
+#endif
+
+#ifdef FILTER192                       /* has leveling info ? */
+  if (pData->iFilterofs == MNG_FILTER_DIFFERING)
+    iRslt = init_rowdiffering (pData);
+  else
+#endif
+    iRslt = MNG_NOERROR;
+                                       /* filter the row if necessary */
+  if ((!iRslt) && (pData->iFilterofs < pData->iPixelofs  ) &&
+                  (*(pData->pWorkrow + pData->iFilterofs))    )
+    iRslt = mng_filter_a_row (pData);
+  else
+    iRslt = MNG_NOERROR;
+                                       /* additional leveling/differing ? */
+  if ((!iRslt) && (pData->fDifferrow))
+  {
+    iRslt = ((mng_differrow)pData->fDifferrow) (pData);
+
+    pSwap           = pData->pWorkrow;
+    pData->pWorkrow = pData->pPrevrow;
+    pData->pPrevrow = pSwap;           /* make sure we're processing the right data */
+  }
+
+  if (!iRslt)
+  {
+#ifdef MNG_INCLUDE_JNG
+    if (pData->bHasJHDR)               /* is JNG alpha-channel ? */
+    {                                  /* just store in object ? */
+      if ((!iRslt) && (pData->fStorerow))
+        iRslt = ((mng_storerow)pData->fStorerow)     (pData);
+    }
+    else
+#endif /* MNG_INCLUDE_JNG */
+    {                                  /* process this row */
+      if ((!iRslt) && (pData->fProcessrow))
+        iRslt = ((mng_processrow)pData->fProcessrow) (pData);
+                                       /* store in object ? */
+      if ((!iRslt) && (pData->fStorerow))
+        iRslt = ((mng_storerow)pData->fStorerow)     (pData);
+                                       /* color correction ? */
+      if ((!iRslt) && (pData->fCorrectrow))
+        iRslt = ((mng_correctrow)pData->fCorrectrow) (pData);
+                                       /* slap onto canvas ? */
+      if ((!iRslt) && (pData->fDisplayrow))
+      {
+        iRslt = ((mng_displayrow)pData->fDisplayrow) (pData);
+
+        if (!iRslt)                    /* check progressive display refresh */
+          iRslt = mng_display_progressive_check (pData);
+
+      }
+    }
+  }
+
+  return iRslt;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void init_rowbuffer (mng_datap pData)
+{                                      /* can we inflate multiple rows ? */
+  mng_uint32 iRowbytes = pData->iRowsize + pData->iPixelofs;
+  mng_uint32 iRows;
+                                       /* not for interlaced or leveled data;
+                                          nor if the rows get expanded */
+  if ((pData->iPass >= 0) || (pData->iFilterofs) || (pData->fDifferrow) ||
+      (pData->iDataheight < 2) || (iRowbytes > MNG_ZLIB_ROWBUF / 2))
+    return;
+#ifdef MNG_NO_1_2_4BIT_SUPPORT
+  if (pData->iPNGdepth < 8)
+    return;
+#endif
+#ifdef MNG_NO_16BIT_SUPPORT
+  if (pData->iPNGdepth > 8)
+    return;
+#endif
+
+  iRows = MNG_ZLIB_ROWBUF / iRowbytes;
+
+  if (iRows > pData->iDataheight)
+    iRows = pData->iDataheight;
+                                       /* plus one for the first predictor */
+  pData->iZrowbufsize = (iRows + 1) * iRowbytes;
+
+  MNG_ALLOCX (pData, pData->pZrowbuf, pData->iZrowbufsize);
+
+  if (!pData->pZrowbuf)                /* no problem; just do it row by row */
+    pData->iZrowbufsize = 0;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void next_rowbatch (mng_datap  pData,
+                              mng_uint32 iFill)
+{                                      /* room for the remaining rows only, so
+                                          superfluous data is still detected */
+  mng_uint32 iRowbytes = pData->iRowsize + pData->iPixelofs;
+  mng_uint32 iRoom     = pData->iZrowbufsize - iRowbytes;
+  mng_uint32 iRemain   = 0;
+
+  if (pData->iRow < (mng_int32)pData->iDataheight)
+    iRemain = ((mng_uint32)pData->iDataheight - (mng_uint32)pData->iRow) * iRowbytes;
+
+  if (iRoom > iRemain)
+    iRoom = iRemain;
+
+  pData->sZlib.next_out  = pData->pZrowbuf + iRowbytes + iFill;
+  pData->sZlib.avail_out = (uInt)(iRoom > iFill ? iRoom - iFill : 0);
+}
+#endif /* MNG_SUPPORT_DISPLAY */
+
+/* ************************************************************************** */
+
 #ifdef MNG_SUPPORT_DISPLAY
 mng_retcode mngzlib_inflaterows (mng_datap  pData,
                                  mng_uint32 iInlen,
@@ -197,237 +445,133 @@ mng_retcode mngzlib_inflaterows (mng_datap  pData,
   pData->sZlib.avail_in  = (uInt)iInlen;
 
   if (pData->sZlib.next_out == 0)      /* initialize output variables ? */
-  {                                    /* let zlib know where to store stuff */
-    pData->sZlib.next_out  = pData->pWorkrow;
-    pData->sZlib.avail_out = (uInt)(pData->iRowsize + pData->iPixelofs);
-#ifdef MNG_NO_1_2_4BIT_SUPPORT
-    if (pData->iPNGdepth < 8)
-       pData->sZlib.avail_out = (uInt)((pData->iPNGdepth*pData->iRowsize + 7)/8
-           + pData->iPixelofs);
-#endif
-#ifdef MNG_NO_16BIT_SUPPORT
-    if (pData->iPNGdepth > 8)
-       pData->sZlib.avail_out = (uInt)(2*pData->iRowsize + pData->iPixelofs);
-#endif
-  }
+    init_rowbuffer (pData);
 
-  do
-  {                                    /* now inflate a row */
-    iZrslt = inflate (&pData->sZlib, Z_SYNC_FLUSH);
-                                       /* produced a full row ? */
-    if (((iZrslt == Z_OK) || (iZrslt == Z_STREAM_END)) &&
-        (pData->sZlib.avail_out == 0))
-    {                                  /* image not completed yet ? */
-      if (pData->iRow < (mng_int32)pData->iDataheight)
-      {
-#ifdef MNG_NO_1_2_4BIT_SUPPORT
-        if (pData->iPNGdepth == 1)
-        {
-          /* Inflate Workrow to 8-bit */
-          mng_int32  iX;
-          mng_uint8p pSrc = pData->pWorkrow+1;
-          mng_uint8p pDest = pSrc + pData->iRowsize - (pData->iRowsize+7)/8;
+  if (pData->pZrowbuf)                 /* inflating multiple rows at once ? */
+  {
+    mng_uint32 iRowbytes    = pData->iRowsize + pData->iPixelofs;
+    mng_uint8p pFirst       = pData->pZrowbuf + iRowbytes;
+    mng_uint8p pSaveworkrow = pData->pWorkrow;
+    mng_uint8p pSaveprevrow = pData->pPrevrow;
+    mng_uint8p pRow;
+    mng_uint32 iFill;
 
-          for (iX = ((pData->iRowsize+7)/8) ; iX > 0 ; iX--)
-             *pDest++ = *pSrc++;
+    if (pData->sZlib.next_out == 0)
+      next_rowbatch (pData, 0);
 
-          pDest = pData->pWorkrow+1;
-          pSrc = pDest + pData->iRowsize - (pData->iRowsize+7)/8;
-          for (iX = pData->iRowsize; ;)
-          {
-            *pDest++ = (((*pSrc)>>7)&1);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)>>6)&1);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)>>5)&1);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)>>4)&1);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)>>3)&1);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)>>2)&1);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)>>1)&1);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)   )&1);
-            if (iX-- <= 0)
-              break;
-            pSrc++;
-          }
-        }
-        else if (pData->iPNGdepth == 2)
+    do
+    {                                  /* now inflate as many rows as fit */
+      iZrslt = inflate (&pData->sZlib, Z_SYNC_FLUSH);
+
+      if ((iZrslt == Z_OK) || (iZrslt == Z_STREAM_END))
+      {
+        pRow  = pFirst;
+        iFill = (mng_uint32)(pData->sZlib.next_out - pFirst);
+                                       /* process each complete row in place;
+                                          its predecessor is right in front */
+        while ((iFill >= iRowbytes) &&
+               (pData->iRow < (mng_int32)pData->iDataheight))
         {
-          /* Inflate Workrow to 8-bit */
-          mng_int32  iX;
-          mng_uint8p pSrc = pData->pWorkrow+1;
-          mng_uint8p pDest = pSrc + pData->iRowsize - (2*pData->iRowsize+7)/8;
+          pData->pWorkrow = pRow;
+          pData->pPrevrow = pRow - iRowbytes;
 
-          for (iX = ((2*pData->iRowsize+7)/8) ; iX > 0 ; iX--)
-             *pDest++ = *pSrc++;
+          iRslt = inflated_row (pData);
 
-          pDest = pData->pWorkrow+1;
-          pSrc = pDest + pData->iRowsize - (2*pData->iRowsize+7)/8;
-          for (iX = pData->iRowsize; ;)
+          if (!iRslt)                  /* adjust variables for next row */
+            iRslt = mng_next_row (pData);
+
+          if (iRslt)                   /* on error bail out */
           {
-            *pDest++ = (((*pSrc)>>6)&3);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)>>4)&3);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)>>2)&3);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)   )&3);
-            if (iX-- <= 0)
-              break;
-            pSrc++;
+            pData->pWorkrow = pSaveworkrow;
+            pData->pPrevrow = pSaveprevrow;
+            MNG_ERROR (pData, iRslt);
           }
+
+          pRow  += iRowbytes;
+          iFill -= iRowbytes;
         }
-        else if (pData->iPNGdepth == 4)
-        {
-          /* Inflate Workrow to 8-bit */
-          mng_int32  iX;
-          mng_uint8p pSrc = pData->pWorkrow+1;
-          mng_uint8p pDest = pSrc + pData->iRowsize - (4*pData->iRowsize+7)/8;
 
-          for (iX = ((4*pData->iRowsize+7)/8) ; iX > 0 ; iX--)
-             *pDest++ = *pSrc++;
+        pData->pWorkrow = pSaveworkrow;
+        pData->pPrevrow = pSaveprevrow;
 
-          pDest = pData->pWorkrow+1;
-          pSrc = pDest + pData->iRowsize - (4*pData->iRowsize+7)/8;
-          for (iX = pData->iRowsize; ;)
-          {
-            *pDest++ = (((*pSrc)>>4)&0x0f);
-            if (iX-- <= 0)
-              break;
-            *pDest++ = (((*pSrc)   )&0x0f);
-            if (iX-- <= 0)
-              break;
-            pSrc++;
-          }
-        }
-        if (pData->iPNGdepth < 8 && pData->iColortype == 0)
+        if (pRow != pFirst)            /* keep the last row as predictor and
+                                          move a partial row to the front */
         {
-          /* Expand samples to 8-bit by LBR */
-          mng_int32  iX;
-          mng_uint8p pSrc = pData->pWorkrow+1;
-          mng_uint8 multiplier[]={0,255,85,0,17,0,0,0,1};
+          MNG_COPY (pData->pZrowbuf, pRow - iRowbytes, iRowbytes);
 
-          for (iX = pData->iRowsize; iX > 0; iX--)
-              *pSrc++ *= multiplier[pData->iPNGdepth];
+          if (iFill)
+            MNG_COPY (pFirst, pRow, iFill);
         }
-#endif
-#ifdef MNG_NO_16BIT_SUPPORT
-        if (pData->iPNGdepth > 8)
-        {
-          /* Reduce Workrow to 8-bit */
-          mng_int32  iX;
-          mng_uint8p pSrc = pData->pWorkrow+1;
-          mng_uint8p pDest = pSrc;
 
-          for (iX = pData->iRowsize; iX > 0; iX--)
-          {
-            *pDest = *pSrc;
-            pDest++;
-            pSrc+=2;
-          }
-        }
+        next_rowbatch (pData, iFill);
+      }
+    }                                  /* until some error or EOI
+                                          or all pixels received */
+    while ( (iZrslt == Z_OK) && (pData->sZlib.avail_in > 0) &&
+            (pData->iRow < (mng_int32)pData->iDataheight)      );
+  }
+  else
+  {
+    if (pData->sZlib.next_out == 0)    /* initialize output variables ? */
+    {                                  /* let zlib know where to store stuff */
+      pData->sZlib.next_out  = pData->pWorkrow;
+      pData->sZlib.avail_out = (uInt)(pData->iRowsize + pData->iPixelofs);
+#ifdef MNG_NO_1_2_4BIT_SUPPORT
+      if (pData->iPNGdepth < 8)
+         pData->sZlib.avail_out = (uInt)((pData->iPNGdepth*pData->iRowsize + 7)/8
+             + pData->iPixelofs);
 #endif
-
-#ifdef FILTER192                       /* has leveling info ? */
-        if (pData->iFilterofs == MNG_FILTER_DIFFERING)
-          iRslt = init_rowdiffering (pData);
-        else
+#ifdef MNG_NO_16BIT_SUPPORT
+      if (pData->iPNGdepth > 8)
+         pData->sZlib.avail_out = (uInt)(2*pData->iRowsize + pData->iPixelofs);
 #endif
-          iRslt = MNG_NOERROR;
-                                       /* filter the row if necessary */
-        if ((!iRslt) && (pData->iFilterofs < pData->iPixelofs  ) &&
-                        (*(pData->pWorkrow + pData->iFilterofs))    )
-          iRslt = mng_filter_a_row (pData);
-        else
-          iRslt = MNG_NOERROR;
-                                       /* additional leveling/differing ? */
-        if ((!iRslt) && (pData->fDifferrow))
-        {
-          iRslt = ((mng_differrow)pData->fDifferrow) (pData);
-
-          pSwap           = pData->pWorkrow;
-          pData->pWorkrow = pData->pPrevrow;
-          pData->pPrevrow = pSwap;     /* make sure we're processing the right data */
-        }
+    }
 
-        if (!iRslt)
+    do
+    {                                  /* now inflate a row */
+      iZrslt = inflate (&pData->sZlib, Z_SYNC_FLUSH);
+                                       /* produced a full row ? */
+      if (((iZrslt == Z_OK) || (iZrslt == Z_STREAM_END)) &&
+          (pData->sZlib.avail_out == 0))
+      {                                /* image not completed yet ? */
+        if (pData->iRow < (mng_int32)pData->iDataheight)
         {
-#ifdef MNG_INCLUDE_JNG
-          if (pData->bHasJHDR)         /* is JNG alpha-channel ? */
-          {                            /* just store in object ? */
-            if ((!iRslt) && (pData->fStorerow))
-              iRslt = ((mng_storerow)pData->fStorerow)     (pData);
-          }
-          else
-#endif /* MNG_INCLUDE_JNG */
-          {                            /* process this row */
-            if ((!iRslt) && (pData->fProcessrow))
-              iRslt = ((mng_processrow)pData->fProcessrow) (pData);
-                                       /* store in object ? */
-            if ((!iRslt) && (pData->fStorerow))
-              iRslt = ((mng_storerow)pData->fStorerow)     (pData);
-                                       /* color correction ? */
-            if ((!iRslt) && (pData->fCorrectrow))
-              iRslt = ((mng_correctrow)pData->fCorrectrow) (pData);
-                                       /* slap onto canvas ? */
-            if ((!iRslt) && (pData->fDisplayrow))
-            {
-              iRslt = ((mng_displayrow)pData->fDisplayrow) (pData);
+          iRslt = inflated_row (pData);
 
-              if (!iRslt)              /* check progressive display refresh */
-                iRslt = mng_display_progressive_check (pData);
+          if (iRslt)                   /* on error bail out */
+            MNG_ERROR (pData, iRslt);
 
-            }
+          if (!pData->fDifferrow)      /* swap row-pointers */
+          {
+            pSwap           = pData->pWorkrow;
+            pData->pWorkrow = pData->pPrevrow;
+            pData->pPrevrow = pSwap;   /* so prev points to the processed row! */
           }
-        }
 
-        if (iRslt)                     /* on error bail out */
-          MNG_ERROR (pData, iRslt);
+          iRslt = mng_next_row (pData); /* adjust variables for next row */
 
-        if (!pData->fDifferrow)        /* swap row-pointers */
-        {
-          pSwap           = pData->pWorkrow;
-          pData->pWorkrow = pData->pPrevrow;
-          pData->pPrevrow = pSwap;     /* so prev points to the processed row! */
+          if (iRslt)                   /* on error bail out */
+            MNG_ERROR (pData, iRslt);
         }
-
-        iRslt = mng_next_row (pData);  /* adjust variables for next row */
-
-        if (iRslt)                     /* on error bail out */
-          MNG_ERROR (pData, iRslt);
-      }
                                        /* let zlib know where to store next output */
-      pData->sZlib.next_out  = pData->pWorkrow;
-      pData->sZlib.avail_out = (uInt)(pData->iRowsize + pData->iPixelofs);
+        pData->sZlib.next_out  = pData->pWorkrow;
+        pData->sZlib.avail_out = (uInt)(pData->iRowsize + pData->iPixelofs);
 #ifdef MNG_NO_1_2_4BIT_SUPPORT
-    if (pData->iPNGdepth < 8)
-       pData->sZlib.avail_out = (uInt)((pData->iPNGdepth*pData->iRowsize + 7)/8
-           + pData->iPixelofs);
+      if (pData->iPNGdepth < 8)
+         pData->sZlib.avail_out = (uInt)((pData->iPNGdepth*pData->iRowsize + 7)/8
+             + pData->iPixelofs);
 #endif
 #ifdef MNG_NO_16BIT_SUPPORT
-      if (pData->iPNGdepth > 8)
-        pData->sZlib.avail_out = (uInt)(2*pData->iRowsize + pData->iPixelofs);
+        if (pData->iPNGdepth > 8)
+          pData->sZlib.avail_out = (uInt)(2*pData->iRowsize + pData->iPixelofs);
 #endif
-    }
-  }                                    /* until some error or EOI
+      }
+    }                                  /* until some error or EOI
                                           or all pixels received */
-  while ( (iZrslt == Z_OK) && (pData->sZlib.avail_in > 0)      &&
-          ( (pData->iRow < (mng_int32)pData->iDataheight) ||
-            ( (pData->iPass >= 0) && (pData->iPass < 7) )    )    );
+    while ( (iZrslt == Z_OK) && (pData->sZlib.avail_in > 0)      &&
+            ( (pData->iRow < (mng_int32)pData->iDataheight) ||
+              ( (pData->iPass >= 0) && (pData->iPass < 7) )    )    );
+  }
                                        /* on error bail out */
   if ((iZrslt != Z_OK) && (iZrslt != Z_STREAM_END))
     MNG_ERRORZ (pData, (mng_uint32)iZrslt);
@@ -484,6 +628,12 @@ mng_retcode mngzlib_inflatefree (mng_datap pData)
 #endif
 
   pData->bInflating = MNG_FALSE;       /* stopped it */
+#ifdef MNG_SUPPORT_PARALLEL
+  pData->pDecodejob = MNG_NULL;        /* the next image starts afresh */
+#endif
+
+  if (pData->pZrowbuf)                 /* drop the multi-row buffer */
+    MNG_FREE (pData, pData->pZrowbuf, pData->iZrowbufsize);
 
   iZrslt = inflateEnd (&pData->sZlib); /* let zlib cleanup its own stuff */
 
@@ -497,6 +647,605 @@ mng_retcode mngzlib_inflatefree (mng_datap pData)
   return MNG_NOERROR;                  /* done */
 }
 
+/* ************************************************************************** */
+/* *                                                                        * */
+/* * Decode-workers - when reading from memory the complete chunk-index is  * */
+/* * known up front; every IHDR-image in an MNG is a self-contained zlib-   * */
+/* * stream (DHDR, JHDR & BASI blocks don't qualify), so worker-threads can * */
+/* * inflate & unfilter those ahead of the reader; the reader then feeds    * */
+/* * the finished rows through the normal row-processing when it gets to    * */
+/* * the image's first IDAT, and skips its remaining IDATs                  * */
+/* *                                                                        * */
+/* * the workers don't call any callbacks: all memory (including that for   * */
+/* * their zlib-streams) is allocated by the reader; a job that fails for   * */
+/* * whatever reason (bad crc, bad data, too much or too little of it) is   * */
+/* * simply processed by the reader as usual, so errors & warnings are      * */
+/* * reported exactly as before                                             * */
+/* *                                                                        * */
+/* ************************************************************************** */
+
+#ifdef MNG_SUPPORT_PARALLEL
+
+/* ************************************************************************** */
+
+MNG_LOCAL voidpf worker_alloc (voidpf pWorker,
+                               uInt   iCount,
+                               uInt   iSize)
+{                                      /* carve it from the worker's own block */
+  mng_decodeworkerp pMe  = (mng_decodeworkerp)pWorker;
+  mng_uint32        iLen = ((mng_uint32)iCount * (mng_uint32)iSize + 15) & ~15;
+
+  if ((iSize) && (iCount > MNG_ZLIB_WORKERMEM / iSize))
+    return Z_NULL;
+  if (iLen > MNG_ZLIB_WORKERMEM - pMe->iArenaused)
+    return Z_NULL;                     /* zlib reports Z_MEM_ERROR then */
+
+  pMe->iArenaused += iLen;
+
+  return (voidpf)(pMe->pArena + pMe->iArenaused - iLen);
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void worker_free (voidpf pWorker,
+                            voidpf pAddress)
+{                                      /* it's all reused by the next job */
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_uint8 decode_job (mng_decodepoolp   pPool,
+                                mng_decodeworkerp pMe,
+                                mng_decodejobp    pJob)
+{
+  z_stream      sZlib;
+  int           iZrslt;
+  mng_uint32    iChunk;
+  mng_memchunkp pEntry;
+  mng_uint8p    pChunk;
+  mng_uint8p    pRow;
+  mng_uint32    iY;
+
+  sZlib.zalloc    = worker_alloc;
+  sZlib.zfree     = worker_free;
+  sZlib.opaque    = (voidpf)pMe;
+  sZlib.next_in   = Z_NULL;
+  sZlib.avail_in  = 0;
+  pMe->iArenaused = 0;
+
+  if (inflateInit (&sZlib) != Z_OK)
+    return MNG_JOB_FAILED;
+                                       /* straight into the job's rows */
+  sZlib.next_out  = pJob->pRows     + pJob->iRowbytes;
+  sZlib.avail_out = pJob->iRowssize - pJob->iRowbytes;
+  iZrslt          = Z_OK;
+
+  for (iChunk = pJob->iFirstchunk + 1;
+       (iZrslt == Z_OK) && (iChunk < pJob->iLastchunk); iChunk++)
+  {
+    pEntry = pPool->pMemindex + iChunk;
+    pChunk = pPool->pMemdata  + pEntry->iOffset;
+
+    if ((pEntry->iLength) && (mng_get_uint32 (pChunk + 4) == MNG_UINT_IDAT))
+    {                                  /* the reader might discard it */
+      if (crc32 (0, pChunk + 4, pEntry->iLength + 4) !=
+          mng_get_uint32 (pChunk + 8 + pEntry->iLength))
+        iZrslt = Z_DATA_ERROR;
+      else
+      {
+        sZlib.next_in  = pChunk + 8;
+        sZlib.avail_in = (uInt)pEntry->iLength;
+        iZrslt         = inflate (&sZlib, Z_SYNC_FLUSH);
+                                       /* superfluous data gets a warning */
+        if ((iZrslt == Z_OK) && (sZlib.avail_in))
+          iZrslt = Z_BUF_ERROR;
+      }
+    }
+  }
+
+  inflateEnd (&sZlib);
+                                       /* need exactly all the rows */
+  if ((iZrslt != Z_STREAM_END) || (sZlib.avail_out))
+    return MNG_JOB_FAILED;
+
+  pRow = pJob->pRows + pJob->iRowbytes;
+
+  for (iY = 0; iY < pJob->iHeight; iY++)
+  {                                    /* unfilter them in place */
+    if (*pRow)
+    {
+      if (mng_unfilter_row (*pRow, pRow + 1, pRow + 1 - pJob->iRowbytes,
+                            (mng_int32)pJob->iRowbytes - 1, pJob->iFilterbpp,
+                            pPool->iSIMDflags))
+        return MNG_JOB_FAILED;
+
+      *pRow = 0;                       /* so the reader won't do it again */
+    }
+
+    pRow += pJob->iRowbytes;
+  }
+
+  return MNG_JOB_DONE;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void * decode_worker (void * pWorker)
+{
+  mng_decodeworkerp pMe   = (mng_decodeworkerp)pWorker;
+  mng_decodepoolp   pPool = (mng_decodepoolp)pMe->pPool;
+  mng_decodejobp    pJob;
+  mng_uint8         iState;
+
+  pthread_mutex_lock (&pPool->hMutex);
+
+  while (!pPool->bStop)
+  {
+    if (pPool->iJobnext < pPool->iJobready)
+    {                                  /* take the next one */
+      pJob = pPool->pJobs + pPool->iJobnext;
+      pPool->iJobnext++;
+                                       /* unless the reader has got it */
+      if (pJob->iState == MNG_JOB_READY)
+      {
+        pJob->iState = MNG_JOB_RUNNING;
+
+        pthread_mutex_unlock (&pPool->hMutex);
+        iState = decode_job (pPool, pMe, pJob);
+        pthread_mutex_lock (&pPool->hMutex);
+
+        pJob->iState = iState;
+        pthread_cond_broadcast (&pPool->hDone);
+      }
+    }
+    else
+      pthread_cond_wait (&pPool->hWork, &pPool->hMutex);
+  }
+
+  pthread_mutex_unlock (&pPool->hMutex);
+
+  return 0;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_bool init_decodejob (mng_decodejobp pJob,
+                                   mng_uint8p     pIHDR)
+{                                      /* can a worker do this one ? */
+  mng_uint32 iWidth  = mng_get_uint32 (pIHDR);
+  mng_uint32 iHeight = mng_get_uint32 (pIHDR + 4);
+  mng_uint8  iDepth  = *(pIHDR +  8);
+  mng_uint32 iSamples;
+
+  switch (*(pIHDR + 9))                /* color-type */
+  {
+    case 0  : { iSamples = 1; break; }
+    case 2  : { iSamples = 3; break; }
+    case 3  : { iSamples = 1; break; }
+    case 4  : { iSamples = 2; break; }
+    case 6  : { iSamples = 4; break; }
+    default : return MNG_FALSE;
+  }
+
+  if ((iDepth != 1) && (iDepth != 2) && (iDepth != 4) && (iDepth != 8) &&
+      (iDepth != 16))
+    return MNG_FALSE;
+                                       /* not compressed, filtered or
+                                          interlaced the usual way ? */
+  if ((*(pIHDR + 10)) || (*(pIHDR + 11)) || (*(pIHDR + 12)))
+    return MNG_FALSE;
+
+  if ((!iWidth) || (!iHeight) || (iWidth > 0x1FFFFFF / iSamples))
+    return MNG_FALSE;
+
+  pJob->iHeight    = iHeight;
+  pJob->iRowbytes  = (iWidth * iSamples * iDepth + 7) / 8 + 1;
+  pJob->iFilterbpp = (mng_int32)((iSamples * iDepth + 7) / 8);
+                                       /* plus the predictor-row */
+  if (iHeight >= 0x7FFFFFFF / pJob->iRowbytes)
+    return MNG_FALSE;
+
+  pJob->iRowssize  = (iHeight + 1) * pJob->iRowbytes;
+
+  return MNG_TRUE;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL void fill_decodepool (mng_datap       pData,
+                                mng_decodepoolp pPool)
+{                                      /* give the next few jobs a buffer */
+  mng_uint32     iReady = pPool->iJobcurrent + 1 +
+                          pPool->iWorkers * MNG_DECODEAHEAD;
+  mng_uint32     iFirst = pPool->iJobready;
+  mng_uint32     iX;
+  mng_decodejobp pJob;
+
+  if (iFirst < pPool->iJobcurrent)     /* the reader skipped some ? */
+    iFirst = pPool->iJobcurrent;
+
+  if (iReady > pPool->iJobcount)
+    iReady = pPool->iJobcount;
+
+  if (iReady <= iFirst)
+    return;
+
+  for (iX = iFirst; iX < iReady; iX++)
+  {
+    pJob = pPool->pJobs + iX;
+
+    MNG_ALLOCX (pData, pJob->pRows, pJob->iRowssize);
+  }
+
+  pthread_mutex_lock (&pPool->hMutex);
+
+  for (iX = iFirst; iX < iReady; iX++)
+  {
+    pJob = pPool->pJobs + iX;
+
+    if (pJob->pRows)
+      pJob->iState = MNG_JOB_READY;
+    else                               /* no memory; the reader does it then */
+      pJob->iState = MNG_JOB_FAILED;
+  }
+
+  pPool->iJobready = iReady;
+
+  pthread_cond_broadcast (&pPool->hWork);
+  pthread_mutex_unlock (&pPool->hMutex);
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_decodejobp next_decodejob (mng_datap       pData,
+                                         mng_decodepoolp pPool,
+                                         mng_uint32      iChunk)
+{                                      /* find the job for this chunk */
+  mng_decodejobp pJob;
+                                       /* release those the reader has passed */
+  while ((pPool->iJobcurrent < pPool->iJobcount) &&
+         (pPool->pJobs [pPool->iJobcurrent].iLastchunk < iChunk))
+  {
+    pJob = pPool->pJobs + pPool->iJobcurrent;
+
+    pthread_mutex_lock (&pPool->hMutex);
+
+    while (pJob->iState == MNG_JOB_RUNNING)
+      pthread_cond_wait (&pPool->hDone, &pPool->hMutex);
+
+    pJob->iState = MNG_JOB_FAILED;     /* workers may skip it now */
+
+    pthread_mutex_unlock (&pPool->hMutex);
+
+    MNG_FREE (pData, pJob->pRows, pJob->iRowssize);
+
+    pPool->iJobcurrent++;
+  }
+
+  fill_decodepool (pData, pPool);      /* keep the workers busy */
+
+  if (pPool->iJobcurrent < pPool->iJobcount)
+  {
+    pJob = pPool->pJobs + pPool->iJobcurrent;
+
+    if (pJob->iFirstchunk < iChunk)    /* it's in this one ? */
+      return pJob;
+  }
+
+  return MNG_NULL;
+}
+
+/* ************************************************************************** */
+
+MNG_LOCAL mng_uint8 finish_decodejob (mng_decodepoolp pPool,
+                                      mng_decodejobp  pJob)
+{
+  mng_uint8 iState;
+
+  pthread_mutex_lock (&pPool->hMutex);
+
+  if (pJob->iState == MNG_JOB_READY)   /* nobody's started it yet ? */
+  {                                    /* then don't wait; do it here */
+    pJob->iState = MNG_JOB_RUNNING;
+
+    pthread_mutex_unlock (&pPool->hMutex);
+    iState = decode_job (pPool, &pPool->sReader, pJob);
+    pthread_mutex_lock (&pPool->hMutex);
+
+    pJob->iState = iState;
+  }
+  else
+  {
+    while (pJob->iState == MNG_JOB_RUNNING)
+      pthread_cond_wait (&pPool->hDone, &pPool->hMutex);
+  }
+
+  iState = pJob->iState;
+
+  pthread_mutex_unlock (&pPool->hMutex);
+
+  return iState;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mngzlib_decodestart (mng_datap pData)
+{
+  mng_decodepoolp   pPool;
+  mng_decodejobp    pJobs = MNG_NULL;
+  mng_decodeworkerp pWorker;
+  mng_decodejob     sJob;
+  mng_uint8p        pChunk;
+  mng_uint32        iName;
+  mng_uint32        iCount;
+  mng_uint32        iIHDR = 0;
+  mng_bool          bImage;
+  mng_uint32        iPass;
+  mng_uint32        iX;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_ZLIB_DECODESTART, MNG_LC_START);
+#endif
+                                       /* only MNGs have several images */
+  if ((!pData->iMemchunks) ||
+      (mng_get_uint32 (pData->pMemdata + pData->pMemindex->iOffset + 4) != MNG_UINT_MHDR))
+    return MNG_NOERROR;
+                                       /* count them first, then fill them in */
+  for (iPass = 0; iPass < 2; iPass++)
+  {
+    iCount = 0;
+    bImage = MNG_FALSE;
+
+    for (iX = 0; iX < pData->iMemchunks; iX++)
+    {
+      pChunk = pData->pMemdata + pData->pMemindex [iX].iOffset;
+      iName  = mng_get_uint32 (pChunk + 4);
+
+      if (iName == MNG_UINT_IHDR)
+      {
+        iIHDR  = iX;
+        bImage = (mng_bool)((pData->pMemindex [iX].iLength == 13) &&
+                            (init_decodejob (&sJob, pChunk + 8)));
+      }
+      else
+      if (iName == MNG_UINT_IEND)
+      {
+        if ((bImage) && (iX > iIHDR + 1))
+        {
+          if (pJobs)
+          {
+            sJob.iFirstchunk = iIHDR;
+            sJob.iLastchunk  = iX;
+            sJob.iState      = MNG_JOB_IDLE;
+            sJob.pRows       = MNG_NULL;
+            pJobs [iCount]   = sJob;
+          }
+
+          iCount++;
+        }
+
+        bImage = MNG_FALSE;
+      }
+      else                             /* these are never self-contained */
+      if ((iName == MNG_UINT_DHDR) || (iName == MNG_UINT_JHDR) ||
+          (iName == MNG_UINT_BASI) || (iName == MNG_UINT_MEND))
+        bImage = MNG_FALSE;
+    }
+
+    if (iCount < 2)                    /* not worth the trouble */
+      return MNG_NOERROR;
+
+    if (!pJobs)
+    {
+      MNG_ALLOCX (pData, pJobs, iCount * sizeof (mng_decodejob));
+
+      if (!pJobs)                      /* no problem; just do it all here */
+        return MNG_NOERROR;
+    }
+  }
+
+  MNG_ALLOCX (pData, pPool, sizeof (mng_decodepool));
+
+  if (pPool)
+  {
+    MNG_ALLOCX (pData, pPool->pWorkers, pData->iDecodethreads * sizeof (mng_decodeworker));
+    MNG_ALLOCX (pData, pPool->sReader.pArena, MNG_ZLIB_WORKERMEM);
+  }
+
+  if ((!pPool) || (!pPool->pWorkers) || (!pPool->sReader.pArena))
+  {
+    if (pPool)
+    {
+      MNG_FREEX (pData, pPool->pWorkers, pData->iDecodethreads * sizeof (mng_decodeworker));
+      MNG_FREEX (pData, pPool->sReader.pArena, MNG_ZLIB_WORKERMEM);
+      MNG_FREEX (pData, pPool, sizeof (mng_decodepool));
+    }
+
+    MNG_FREEX (pData, pJobs, iCount * sizeof (mng_decodejob));
+
+    return MNG_NOERROR;
+  }
+
+  pPool->bStop         = MNG_FALSE;
+  pPool->pMemdata      = pData->pMemdata;
+  pPool->pMemindex     = pData->pMemindex;
+#ifdef MNG_SUPPORT_SIMD
+  pPool->iSIMDflags    = pData->iSIMDflags;
+#else
+  pPool->iSIMDflags    = 0;
+#endif
+  pPool->pJobs         = pJobs;
+  pPool->iJobcount     = iCount;
+  pPool->iJobnext      = 0;
+  pPool->iJobready     = 0;
+  pPool->iJobcurrent   = 0;
+  pPool->iWorkers      = 0;
+  pPool->sReader.pPool = (mng_ptr)pPool;
+
+  pthread_mutex_init (&pPool->hMutex, MNG_NULL);
+  pthread_cond_init  (&pPool->hWork,  MNG_NULL);
+  pthread_cond_init  (&pPool->hDone,  MNG_NULL);
+
+  pData->pDecodepool = pPool;
+                                       /* now get them going */
+  for (iX = 0; iX < pData->iDecodethreads; iX++)
+  {
+    pWorker        = pPool->pWorkers + iX;
+    pWorker->pPool = (mng_ptr)pPool;
+
+    MNG_ALLOCX (pData, pWorker->pArena, MNG_ZLIB_WORKERMEM);
+
+    if ((!pWorker->pArena) ||
+        (pthread_create (&pWorker->hThread, MNG_NULL, decode_worker, pWorker)))
+    {                                  /* fewer then; the reader helps out anyway */
+      MNG_FREE (pData, pWorker->pArena, MNG_ZLIB_WORKERMEM);
+      break;
+    }
+
+    pPool->iWorkers++;
+  }
+
+  fill_decodepool (pData, pPool);      /* and give them something to do */
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_ZLIB_DECODESTART, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mngzlib_decodestop (mng_datap pData)
+{
+  mng_decodepoolp pPool = pData->pDecodepool;
+  mng_uint32      iX;
+
+  if (!pPool)                          /* nothing running */
+    return MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_ZLIB_DECODESTOP, MNG_LC_START);
+#endif
+
+  pthread_mutex_lock (&pPool->hMutex);
+  pPool->bStop = MNG_TRUE;             /* tell them to quit */
+  pthread_cond_broadcast (&pPool->hWork);
+  pthread_mutex_unlock (&pPool->hMutex);
+
+  for (iX = 0; iX < pPool->iWorkers; iX++)
+  {                                    /* and wait till they have */
+    pthread_join (pPool->pWorkers [iX].hThread, MNG_NULL);
+    MNG_FREEX (pData, pPool->pWorkers [iX].pArena, MNG_ZLIB_WORKERMEM);
+  }
+
+  for (iX = 0; iX < pPool->iJobcount; iX++)
+    MNG_FREEX (pData, pPool->pJobs [iX].pRows, pPool->pJobs [iX].iRowssize);
+
+  pthread_cond_destroy  (&pPool->hDone);
+  pthread_cond_destroy  (&pPool->hWork);
+  pthread_mutex_destroy (&pPool->hMutex);
+
+  MNG_FREEX (pData, pPool->sReader.pArena, MNG_ZLIB_WORKERMEM);
+  MNG_FREEX (pData, pPool->pWorkers, pData->iDecodethreads * sizeof (mng_decodeworker));
+  MNG_FREEX (pData, pPool->pJobs, pPool->iJobcount * sizeof (mng_decodejob));
+  MNG_FREEX (pData, pPool, sizeof (mng_decodepool));
+
+  pData->pDecodepool = MNG_NULL;
+  pData->pDecodejob  = MNG_NULL;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_ZLIB_DECODESTOP, MNG_LC_END);
+#endif
+
+  return MNG_NOERROR;
+}
+
+/* ************************************************************************** */
+
+mng_retcode mngzlib_inflatejob (mng_datap  pData,
+                                mng_uint32 iInlen,
+                                mng_uint8p pIndata)
+{
+  mng_decodejobp pJob;
+  mng_uint8p     pSaveworkrow;
+  mng_uint8p     pSaveprevrow;
+  mng_uint8p     pRow;
+  mng_retcode    iRslt = MNG_NOERROR;
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_ZLIB_INFLATEJOB, MNG_LC_START);
+#endif
+
+  if (pData->pDecodejob)               /* all rows came from a worker ? */
+  {                                    /* then this IDAT was in there too */
+#ifdef MNG_SUPPORT_TRACE
+    MNG_TRACE (pData, MNG_FN_ZLIB_INFLATEJOB, MNG_LC_END);
+#endif
+
+    return MNG_NOERROR;
+  }
+                                       /* first IDAT; any job for it ? */
+  if (pData->sZlib.next_out == 0)
+  {                                    /* (it's the chunk just taken) */
+    pJob = next_decodejob (pData, pData->pDecodepool, pData->iMemchunknext - 1);
+                                       /* the reader sees it the same way ? */
+    if ((pJob) && (pData->iPass < 0) && (pData->iRow == 0) &&
+        (!pData->iFilterofs) && (pData->iPixelofs == 1) && (!pData->fDifferrow) &&
+        ((mng_uint32)pData->iRowsize + 1 == pJob->iRowbytes) &&
+        (pData->iDataheight == pJob->iHeight) &&
+#ifdef MNG_NO_1_2_4BIT_SUPPORT
+        (pData->iPNGdepth >= 8) &&
+#endif
+#ifdef MNG_NO_16BIT_SUPPORT
+        (pData->iPNGdepth <= 8) &&
+#endif
+        (finish_decodejob (pData->pDecodepool, pJob) == MNG_JOB_DONE))
+    {
+      pSaveworkrow = pData->pWorkrow;
+      pSaveprevrow = pData->pPrevrow;
+      pRow         = pJob->pRows + pJob->iRowbytes;
+                                       /* they're unfiltered already, so just
+                                          process them as they are */
+      while ((!iRslt) && (pData->iRow < (mng_int32)pData->iDataheight))
+      {
+        pData->pWorkrow = pRow;
+        pData->pPrevrow = pRow - pJob->iRowbytes;
+
+        iRslt = inflated_row (pData);
+
+        if (!iRslt)
+          iRslt = mng_next_row (pData);
+
+        pRow += pJob->iRowbytes;
+      }
+
+      pData->pWorkrow   = pSaveworkrow;
+      pData->pPrevrow   = pSaveprevrow;
+      pData->pDecodejob = pJob;        /* skip the other IDATs */
+
+      if (iRslt)                       /* on error bail out */
+        MNG_ERROR (pData, iRslt);
+
+#ifdef MNG_SUPPORT_TRACE
+      MNG_TRACE (pData, MNG_FN_ZLIB_INFLATEJOB, MNG_LC_END);
+#endif
+
+      return MNG_NOERROR;
+    }
+  }
+                                       /* just do it the usual way */
+  iRslt = mngzlib_inflaterows (pData, iInlen, pIndata);
+
+#ifdef MNG_SUPPORT_TRACE
+  MNG_TRACE (pData, MNG_FN_ZLIB_INFLATEJOB, MNG_LC_END);
+#endif
+
+  return iRslt;
+}
+
+#endif /* MNG_SUPPORT_PARALLEL */
+
 /* ************************************************************************** */
 
 mng_retcode mngzlib_deflateinit (mng_datap pData)
@@ -525,16 +1274,53 @@ mng_retcode mngzlib_deflateinit (mng_datap pData)
 
 /* ************************************************************************** */
 
+#if defined(MNG_ACCESS_CHUNKS) && defined(MNG_INCLUDE_WRITE_PROCS)
 mng_retcode mngzlib_deflaterows (mng_datap  pData,
                                  mng_uint32 iInlen,
                                  mng_uint8p pIndata)
 {
+  int         iZrslt;
+  int         iFlush;
+  mng_retcode iRetcode;
+
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_ZLIB_DEFLATEROWS, MNG_LC_START);
 #endif
+                                       /* no more rows ? then finish up */
+  iFlush = (pIndata ? Z_NO_FLUSH : Z_FINISH);
 
+  pData->sZlib.next_in  = pIndata;     /* let zlib know where to get stuff */
+  pData->sZlib.avail_in = (uInt)iInlen;
 
+  for (;;)
+  {
+    iZrslt = deflate (&pData->sZlib, iFlush);
+
+    if ((iZrslt != Z_OK) && (iZrslt != Z_STREAM_END) && (iZrslt != Z_BUF_ERROR))
+      MNG_ERRORZ (pData, (mng_uint32)iZrslt);
+                                       /* room left means zlib is done with
+                                          the input (or the stream ended) */
+    if (pData->sZlib.avail_out)
+      break;
+                                       /* otherwise it's a full IDAT */
+    iRetcode = mng_putchunk_idat ((mng_handle)pData, pData->iZoutsize,
+                                  pData->pZoutbuf);
+    if (iRetcode)
+      return iRetcode;
+                                       /* and start a fresh one */
+    pData->sZlib.next_out  = pData->pZoutbuf;
+    pData->sZlib.avail_out = (uInt)pData->iZoutsize;
+  }
 
+                                       /* the remainder is the last IDAT */
+  if ((iFlush == Z_FINISH) && (pData->sZlib.avail_out < pData->iZoutsize))
+  {
+    iRetcode = mng_putchunk_idat ((mng_handle)pData,
+                                  pData->iZoutsize - pData->sZlib.avail_out,
+                                  pData->pZoutbuf);
+    if (iRetcode)
+      return iRetcode;
+  }
 
 #ifdef MNG_SUPPORT_TRACE
   MNG_TRACE (pData, MNG_FN_ZLIB_DEFLATEROWS, MNG_LC_END);
@@ -542,6 +1328,7 @@ mng_retcode mngzlib_deflaterows (mng_datap  pData,
 
   return MNG_NOERROR;
 }
+#endif /* MNG_ACCESS_CHUNKS && MNG_INCLUDE_WRITE_PROCS */
 
 /* ************************************************************************** */
 
@@ -19,6 +19,10 @@
 /* *             0.9.2 - 08/05/2000 - G.Juyn                                * */
 /* *             - changed file-prefixes                                    * */
 /* *                                                                        * */
+/* *             1.0.11 - 10/17/2026                                        * */
+/* *             - filled the deflaterows routine (streams IDAT chunks)     * */
+/* *             - added mngzlib_decodestart/decodestop/inflatejob          * */
+/* *                                                                        * */
 /* ************************************************************************** */
 
 #if defined(__BORLANDC__) && defined(MNG_STRICT_ANSI)
@@ -42,10 +46,25 @@ mng_retcode mngzlib_inflatedata (mng_datap  pData,
                                  mng_uint8p pIndata);
 mng_retcode mngzlib_inflatefree (mng_datap pData);
 
+#ifdef MNG_SUPPORT_PARALLEL
+mng_retcode mngzlib_decodestart (mng_datap  pData);
+mng_retcode mngzlib_decodestop  (mng_datap  pData);
+                                       /* takes the rows from a decode-worker
+                                          if there's a job for this image */
+mng_retcode mngzlib_inflatejob  (mng_datap  pData,
+                                 mng_uint32 iInlen,
+                                 mng_uint8p pIndata);
+#endif
+
 mng_retcode mngzlib_deflateinit (mng_datap pData);
+#if defined(MNG_ACCESS_CHUNKS) && defined(MNG_INCLUDE_WRITE_PROCS)
+                                       /* streams filtered rows into IDAT
+                                          chunks of pZoutbuf/iZoutsize bytes;
+                                          pIndata = NULL finishes the stream */
 mng_retcode mngzlib_deflaterows (mng_datap  pData,
                                  mng_uint32 iInlen,
                                  mng_uint8p pIndata);
+#endif
 mng_retcode mngzlib_deflatedata (mng_datap  pData,
                                  mng_uint32 iInlen,
                                  mng_uint8p pIndata);
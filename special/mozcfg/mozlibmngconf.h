@@ -138,6 +138,18 @@
 #define MNG_SKIPCANVAS_RGBA565
 #define MNG_SKIPCANVAS_BGRA565
 #define MNG_SKIPCANVAS_BGR565_A8
+#define MNG_SKIPCANVAS_RGB16
+#define MNG_SKIPCANVAS_RGBA16
+#define MNG_SKIPCANVAS_ARGB16
+#define MNG_SKIPCANVAS_BGR16
+#define MNG_SKIPCANVAS_BGRA16
+#define MNG_SKIPCANVAS_ABGR16
+#define MNG_SKIPCANVAS_GRAY8
+#define MNG_SKIPCANVAS_GRAYA8
+#define MNG_SKIPCANVAS_AGRAY8
+#define MNG_SKIPCANVAS_GRAY16
+#define MNG_SKIPCANVAS_GRAYA16
+#define MNG_SKIPCANVAS_AGRAY16
 #define MNG_SKIP_MAXCANVAS
 #define MNG_SKIPCHUNK_tEXt
 #define MNG_SKIPCHUNK_zTXt